@@ -10,6 +10,19 @@
 
 namespace BansheeEngine
 {
+	/**
+	 * @brief	Renderer statistics for a single camera, for the last frame it was rendered in.
+	 */
+	struct CameraRenderStats
+	{
+		CameraRenderStats()
+			:numRenderablesCulled(0), numRenderablesUploaded(0)
+		{ }
+
+		UINT32 numRenderablesCulled; /**< Number of renderable elements rejected by the camera frustum test. */
+		UINT32 numRenderablesUploaded; /**< Number of visible renderable elements that had their per-object GPU parameters written to. */
+	};
+
 	/**
 	 * @brief	Contains Camera data used by the Renderer.
 	 */
@@ -30,5 +43,8 @@ namespace BansheeEngine
 		Vector3 worldPosition;
 
 		RenderQueuePtr renderQueue;
+		Vector<UINT8> cullPlaneCache; /**< Used by the renderer for speeding up frustum culling. See ConvexVolume::intersects. */
+
+		CameraRenderStats renderStats; /**< Written by the renderer when the camera is rendered. Core thread only. */
 	};
 }
\ No newline at end of file
@@ -0,0 +1,235 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsAsyncOp.h"
+#include "BsSpinLock.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Header of a single command recorded in a CommandBuffer. The command object itself
+	 *			is stored in the same memory block, directly after the header.
+	 */
+	struct CommandPacket
+	{
+		typedef void(*CommandFunc)(CommandPacket*);
+
+		CommandFunc execute;
+		CommandFunc destroy;
+		UINT32 size; /**< Total size of the packet, including the header. */
+		UINT32 callbackId;
+		bool notifyWhenComplete;
+	};
+
+	/**
+	 * @brief	Records commands as type-erased packets into a list of memory chunks, instead of allocating each
+	 *			command separately. Chunks are kept when the buffer is cleared, so a buffer reused every frame stops
+	 *			allocating once it reaches its working size.
+	 *
+	 * @note	Not thread safe. Buffer may only be recorded on one thread, and then executed on another
+	 *			after recording is done.
+	 */
+	class BS_CORE_EXPORT CommandBuffer
+	{
+		/**
+		 * @brief	Single memory block containing one or multiple command packets.
+		 */
+		struct Chunk
+		{
+			UINT8* memory;
+			UINT8* data; /**< "memory" aligned to packet alignment. */
+			UINT32 size;
+			UINT32 used;
+		};
+
+		/**
+		 * @brief	Command wrapper that provides a command expecting an AsyncOp parameter with its AsyncOp.
+		 */
+		template<class Func>
+		struct ReturnCommand
+		{
+			ReturnCommand(Func&& callback, const AsyncOp& op)
+				:callback(std::move(callback)), op(op)
+			{ }
+
+			void operator()()
+			{
+				callback(op);
+				resolveAsyncOp(op);
+			}
+
+			Func callback;
+			AsyncOp op;
+		};
+
+	public:
+		static const UINT32 PACKET_ALIGNMENT = 16;
+		static const UINT32 DEFAULT_CHUNK_SIZE = 16384;
+
+		/**
+		 * @brief	Constructs a new empty command buffer.
+		 *
+		 * @param	chunkSize	Size of a single memory chunk commands are recorded in. Commands larger than
+		 *						this will be placed in their own chunk.
+		 */
+		CommandBuffer(UINT32 chunkSize = DEFAULT_CHUNK_SIZE);
+		~CommandBuffer();
+
+		/**
+		 * @brief	Records a new command.
+		 *
+		 * @param	command				Callable object with a void() signature. Object is moved into the buffer.
+		 * @param	notifyWhenComplete	If true the notify callback provided to "execute" will be triggered
+		 *								once the command completes.
+		 * @param	callbackId			Identifier that will be passed to the notify callback.
+		 */
+		template<class Func>
+		void record(Func&& command, bool notifyWhenComplete = false, UINT32 callbackId = 0)
+		{
+			typedef typename std::decay<Func>::type CommandType;
+			static_assert(std::alignment_of<CommandType>::value <= PACKET_ALIGNMENT,
+				"Command types with alignment larger than the packet alignment are not supported.");
+
+			UINT32 packetSize = getHeaderSize() + align((UINT32)sizeof(CommandType));
+			CommandPacket* packet = allocPacket(packetSize);
+
+			packet->execute = &executeCommand<CommandType>;
+			packet->destroy = &destroyCommand<CommandType>;
+			packet->size = packetSize;
+			packet->callbackId = callbackId;
+			packet->notifyWhenComplete = notifyWhenComplete;
+
+			new (getPayload(packet)) CommandType(std::forward<Func>(command));
+		}
+
+		/**
+		 * @brief	Records a new command that returns a value through an AsyncOp.
+		 *
+		 * @param	command				Callable object with a void(AsyncOp&) signature. Object is moved into the buffer.
+		 * @param	notifyWhenComplete	If true the notify callback provided to "execute" will be triggered
+		 *								once the command completes.
+		 * @param	callbackId			Identifier that will be passed to the notify callback.
+		 *
+		 * @return	Async operation object that will contain the return value once the command executes.
+		 */
+		template<class Func>
+		AsyncOp recordReturn(Func&& command, bool notifyWhenComplete = false, UINT32 callbackId = 0)
+		{
+			typedef typename std::decay<Func>::type CommandType;
+
+			AsyncOp op;
+			record(ReturnCommand<CommandType>(CommandType(std::forward<Func>(command)), op), notifyWhenComplete, callbackId);
+
+			return op;
+		}
+
+		/**
+		 * @brief	Executes all recorded commands in the order they were recorded and clears the buffer.
+		 *
+		 * @param	notifyCallback	Callback that will be called for commands that have the "notifyWhenComplete" flag set.
+		 *							The callback will receive "callbackId" of the command.
+		 */
+		void execute(std::function<void(UINT32)> notifyCallback = nullptr);
+
+		/**
+		 * @brief	Destroys all recorded commands without executing them. Memory chunks are kept for reuse.
+		 */
+		void clear();
+
+		/**
+		 * @brief	Returns the number of currently recorded commands.
+		 */
+		UINT32 getNumCommands() const { return mNumCommands; }
+
+		/**
+		 * @brief	Returns the number of bytes used by the currently recorded commands.
+		 */
+		UINT32 getNumBytes() const { return mNumBytes; }
+
+		/**
+		 * @brief	Returns true if no commands are recorded.
+		 */
+		bool isEmpty() const { return mNumCommands == 0; }
+
+	private:
+		CommandBuffer(const CommandBuffer& other);
+		CommandBuffer& operator=(const CommandBuffer& other);
+
+		/**
+		 * @brief	Finds room for a packet of the specified size, allocating a new chunk if needed.
+		 */
+		CommandPacket* allocPacket(UINT32 size);
+
+		/**
+		 * @brief	Marks the async operation as completed if the command didn't do so itself.
+		 */
+		static void resolveAsyncOp(AsyncOp& op);
+
+		/**
+		 * @brief	Rounds the size up to packet alignment.
+		 */
+		static UINT32 align(UINT32 size) { return (size + PACKET_ALIGNMENT - 1) & ~(PACKET_ALIGNMENT - 1); }
+
+		/**
+		 * @brief	Returns the size of the packet header, including padding.
+		 */
+		static UINT32 getHeaderSize() { return align((UINT32)sizeof(CommandPacket)); }
+
+		/**
+		 * @brief	Returns the location of the command object stored in the packet.
+		 */
+		static void* getPayload(CommandPacket* packet) { return (UINT8*)packet + getHeaderSize(); }
+
+		template<class T>
+		static void executeCommand(CommandPacket* packet)
+		{
+			(*(T*)getPayload(packet))();
+		}
+
+		template<class T>
+		static void destroyCommand(CommandPacket* packet)
+		{
+			((T*)getPayload(packet))->~T();
+		}
+
+		Vector<Chunk> mChunks;
+		UINT32 mActiveChunk;
+		UINT32 mChunkSize;
+		UINT32 mNumCommands;
+		UINT32 mNumBytes;
+	};
+
+	/**
+	 * @brief	Keeps a set of command buffers that may be reused once their commands were executed.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT CommandBufferPool
+	{
+	public:
+		/**
+		 * @param	chunkSize	Chunk size to initialize newly created command buffers with.
+		 */
+		CommandBufferPool(UINT32 chunkSize = CommandBuffer::DEFAULT_CHUNK_SIZE);
+		~CommandBufferPool();
+
+		/**
+		 * @brief	Returns an empty command buffer, either reused or newly created.
+		 */
+		CommandBuffer* acquire();
+
+		/**
+		 * @brief	Returns a command buffer to the pool. Any commands remaining in the buffer are destroyed.
+		 */
+		void release(CommandBuffer* buffer);
+
+	private:
+		Stack<CommandBuffer*> mFreeBuffers;
+		Vector<CommandBuffer*> mAllBuffers;
+		UINT32 mChunkSize;
+		SpinLock mLock;
+	};
+}
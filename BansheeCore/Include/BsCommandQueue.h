@@ -5,6 +5,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "BsAsyncOp.h"
+#include "BsCommandBuffer.h"
 #include <functional>
 
 namespace BansheeEngine
@@ -61,73 +62,23 @@ namespace BansheeEngine
 	};
 
 	/**
-	 * @brief	Represents a single queued command in the command list. Contains all the data for executing the command
-	 * 			and checking up on the command status.
+	 * @brief	Command queue policy that provides no synchronization, but unlike CommandQueueNoSync
+	 *			allows the queue to be used on any thread. Should be used with command queues that are
+	 *			filled on worker threads, where the caller ensures only one thread accesses the queue at a time.
 	 */
-	struct QueuedCommand
+	class CommandQueueDeferred
 	{
-#if BS_DEBUG_MODE
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callbackWithReturnValue(_callback), debugId(_debugId), returnsValue(true), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(bs_new<AsyncOp>()), ownsData(true)
-		{ }
-
-		QueuedCommand(std::function<void()> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callback(_callback), debugId(_debugId), returnsValue(false), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(nullptr), ownsData(true)
-		{ }
-
-		UINT32 debugId;
-#else
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callbackWithReturnValue(_callback), returnsValue(true), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(bs_new<AsyncOp>()), ownsData(true)
-		{ }
-
-		QueuedCommand(std::function<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:callback(_callback), returnsValue(false), notifyWhenComplete(_notifyWhenComplete), callbackId(_callbackId), asyncOp(nullptr), ownsData(true)
-		{ }
-#endif
-
-		~QueuedCommand()
-		{
-			if(ownsData && asyncOp != nullptr)
-				bs_delete(asyncOp);
-		}
-
-		QueuedCommand(const QueuedCommand& source)
-		{
-			ownsData = true;
-			source.ownsData = false;
-
-			callback = source.callback;
-			callbackWithReturnValue = source.callbackWithReturnValue;
-			asyncOp = source.asyncOp;
-			returnsValue = source.returnsValue;
-			callbackId = source.callbackId;
-			notifyWhenComplete = source.notifyWhenComplete;
-		}
+	public:
+		CommandQueueDeferred() {}
+		virtual ~CommandQueueDeferred() {}
 
-		QueuedCommand& operator=(const QueuedCommand& rhs)
+		bool isValidThread(BS_THREAD_ID_TYPE ownerThread) const
 		{
-			ownsData = true;
-			rhs.ownsData = false;
-
-			callback = rhs.callback;
-			callbackWithReturnValue = rhs.callbackWithReturnValue;
-			asyncOp = rhs.asyncOp;
-			returnsValue = rhs.returnsValue;
-			callbackId = rhs.callbackId;
-			notifyWhenComplete = rhs.notifyWhenComplete;
-			
-			return *this;
+			return true;
 		}
 
-		std::function<void()> callback;
-		std::function<void(AsyncOp&)> callbackWithReturnValue;
-		AsyncOp* asyncOp;
-		bool returnsValue;
-		UINT32 callbackId;
-		bool notifyWhenComplete;
-
-		mutable bool ownsData;
+		void lock() { }
+		void unlock() { }
 	};
 
 	/**
@@ -154,16 +105,18 @@ namespace BansheeEngine
 
 		/**
 		 * @brief	Executes all provided commands one by one in order. To get the commands you should call flush().
+		 *			Command buffer is returned to the queue for reuse once done.
 		 *
 		 * @param	notifyCallback  	Callback that will be called if a command that has "notifyOnComplete" flag set.
 		 * 								The callback will receive "callbackId" of the command.
 		 */
-		void playbackWithNotify(Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback);
+		void playbackWithNotify(CommandBuffer* commands, std::function<void(UINT32)> notifyCallback);
 
 		/**
 		 * @brief	Executes all provided commands one by one in order. To get the commands you should call flush().
+		 *			Command buffer is returned to the queue for reuse once done.
 		 */
-		void playback(Queue<QueuedCommand>* commands);
+		void playback(CommandBuffer* commands);
 
 		/**
 		 * @brief	Allows you to set a breakpoint that will trigger when the specified command is executed.
@@ -197,7 +150,21 @@ namespace BansheeEngine
 		 * 			it completes AsyncOp::isResolved will return true and return data will be valid (if
 		 * 			the callback provided any).
 		 */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class Func>
+		AsyncOp queueReturn(Func&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+#if BS_DEBUG_MODE
+			breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx++);
+#endif
+
+			AsyncOp op = mCommands->recordReturn(std::forward<Func>(commandCallback), _notifyWhenComplete, _callbackId);
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+			playback(flush());
+#endif
+
+			return op;
+		}
 
 		/**
 		 * @brief	Queue up a new command to execute. Make sure the provided function has all of its
@@ -209,13 +176,25 @@ namespace BansheeEngine
 		 * @param	_callbackId		   	(optional) Identifier for the callback so you can then later find
 		 * 								it if needed.
 		 */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class Func>
+		void queue(Func&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+#if BS_DEBUG_MODE
+			breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx++);
+#endif
+
+			mCommands->record(std::forward<Func>(commandCallback), _notifyWhenComplete, _callbackId);
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+			playback(flush());
+#endif
+		}
 
 		/**
 		 * @brief	Returns a copy of all queued commands and makes room for new ones. Must be called from the thread
 		 * 			that created the command queue. Returned commands MUST be passed to "playback" method.
 		 */
-		BansheeEngine::Queue<QueuedCommand>* flush();
+		CommandBuffer* flush();
 
 		/**
 		 * @brief	Cancels all currently queued commands.
@@ -227,6 +206,21 @@ namespace BansheeEngine
 		 */
 		bool isEmpty();
 
+		/**
+		 * @brief	Returns the number of currently queued commands.
+		 */
+		UINT32 getNumCommands() const;
+
+		/**
+		 * @brief	Returns the number of bytes used by the currently queued commands.
+		 */
+		UINT32 getNumBytes() const;
+
+		/**
+		 * @brief	Returns the pool that command buffers returned by "flush" should be released to once executed.
+		 */
+		CommandBufferPool* getBufferPool() { return &mCommandBuffers; }
+
 	protected:
 		/**
 		 * @brief	Helper method that throws an "Invalid thread" exception. Used primarily
@@ -235,8 +229,8 @@ namespace BansheeEngine
 		void throwInvalidThreadException(const String& message) const;
 
 	private:
-		BansheeEngine::Queue<QueuedCommand>* mCommands;
-		Stack<BansheeEngine::Queue<QueuedCommand>*> mEmptyCommandQueues; // List of empty queues for reuse
+		CommandBuffer* mCommands;
+		CommandBufferPool mCommandBuffers; // Buffers are released from the core thread, so the pool must be thread safe
 
 		BS_THREAD_ID_TYPE mMyThreadId;
 
@@ -311,7 +305,8 @@ namespace BansheeEngine
 		/**
 		 * @copydoc CommandQueueBase::queueReturn
 		 */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class Func>
+		AsyncOp queueReturn(Func&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -321,7 +316,7 @@ namespace BansheeEngine
 #endif
 
 			lock();
-			AsyncOp asyncOp = CommandQueueBase::queueReturn(commandCallback, _notifyWhenComplete, _callbackId);
+			AsyncOp asyncOp = CommandQueueBase::queueReturn(std::forward<Func>(commandCallback), _notifyWhenComplete, _callbackId);
 			unlock();
 
 			return asyncOp;
@@ -330,7 +325,8 @@ namespace BansheeEngine
 		/**
 		 * @copydoc CommandQueueBase::queue
 		 */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class Func>
+		void queue(Func&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -340,14 +336,14 @@ namespace BansheeEngine
 #endif
 
 			lock();
-			CommandQueueBase::queue(commandCallback, _notifyWhenComplete, _callbackId);
+			CommandQueueBase::queue(std::forward<Func>(commandCallback), _notifyWhenComplete, _callbackId);
 			unlock();
 		}
 
 		/**
 		 * @copydoc CommandQueueBase::flush
 		 */
-		BansheeEngine::Queue<QueuedCommand>* flush()
+		CommandBuffer* flush()
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -357,7 +353,7 @@ namespace BansheeEngine
 #endif
 
 			lock();
-			BansheeEngine::Queue<QueuedCommand>* commands = CommandQueueBase::flush();
+			CommandBuffer* commands = CommandQueueBase::flush();
 			unlock();
 
 			return commands;
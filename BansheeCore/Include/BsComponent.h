@@ -8,6 +8,18 @@
 
 namespace BansheeEngine
 {
+	/**
+	 * @brief	Determines how is Component::update called for a component.
+	 */
+	enum class ComponentUpdateMode
+	{
+		None, /**< Component doesn't need updating and Component::update is never called. */
+		Serial, /**< Component::update is called on the sim thread, for one component at a time. */
+		Parallel /**< Component::update may be called from worker threads, in parallel with other components of the same type. 
+					  Such components must not access other components or scene objects in a non thread safe way, and must not
+					  add or remove components. */
+	};
+
 	/**
 	 * @brief	Components represent primarily logic elements in the scene. 
 	 *			They are attached to scene objects.
@@ -26,12 +38,17 @@ namespace BansheeEngine
 		HSceneObject SO() const { return sceneObject(); }
 
 		/**
-		 * @brief	Called once per frame on all components.
+		 * @brief	Called once per frame on all components, unless their update mode is ComponentUpdateMode::None.
 		 * 			
 		 * @note	Internal method.
 		 */
 		virtual void update() { }
 
+		/**
+		 * @brief	Returns how is ::update called for this component.
+		 */
+		ComponentUpdateMode getUpdateMode() const { return mUpdateMode; }
+
 		/**
 		 * @brief	Removes the component from parent SceneObject and deletes it. All
 		 * 			the references to this component will be marked as destroyed and you
@@ -41,10 +58,19 @@ namespace BansheeEngine
 
 	protected:
 		friend class SceneObject;
+		friend class CoreSceneManager;
 
 		Component(const HSceneObject& parent);
 		virtual ~Component();
 
+		/**
+		 * @brief	Changes how is ::update called for this component. Components that don't override ::update
+		 *			should set this to ComponentUpdateMode::None so they are skipped entirely.
+		 *
+		 * @note	Must be called from the component constructor, before the component is added to a scene object.
+		 */
+		void setUpdateMode(ComponentUpdateMode mode) { mUpdateMode = mode; }
+
 		/**
 		 * @brief	Called just before the component is destroyed.
 		 */
@@ -55,6 +81,10 @@ namespace BansheeEngine
 	protected:
 		HSceneObject mParent;
 
+	private:
+		ComponentUpdateMode mUpdateMode;
+		UINT32 mUpdateIdx; /**< Index in the array of updated components of the same type, maintained by CoreSceneManager. */
+
 		/************************************************************************/
 		/* 								RTTI		                     		*/
 		/************************************************************************/
@@ -64,6 +94,8 @@ namespace BansheeEngine
 		virtual RTTITypeBase* getRTTI() const;
 
 	protected:
-		Component() {} // Serialization only
+		Component() // Serialization only
+			:mUpdateMode(ComponentUpdateMode::Serial), mUpdateIdx((UINT32)-1)
+		{ }
 	};
 }
\ No newline at end of file
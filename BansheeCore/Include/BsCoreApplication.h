@@ -27,6 +27,22 @@ namespace BansheeEngine
 		Vector<String> importers; /**< A list of importer plugins to load. */
 	};
 
+	/**
+	 * @brief	Timings describing how the sim and core threads are overlapped in the main loop, and how much
+	 *			memory the frames passed between them use. All times are in milliseconds and refer to the last 
+	 *			completed frame.
+	 */
+	struct FramePipelineStats
+	{
+		UINT32 framesInFlight = 0; /**< Number of frames queued for the core thread that it hasn't finished yet. */
+		float simWaitTime = 0.0f; /**< Time the sim thread spent waiting for the core thread to catch up. */
+		float coreWaitTime = 0.0f; /**< Wall clock time the core thread spent blocked waiting for commands from the sim thread. See CoreThread::getIdleTimeLastFrame. */
+		float corePacingTime = 0.0f; /**< Time between the core thread finishing the two most recent frames. */
+		UINT32 frameAllocUsage = 0; /**< Bytes used from the core thread frame allocator by the most recently recycled frame. */
+		UINT32 frameAllocPeakUsage = 0; /**< Largest number of bytes used from the core thread frame allocator in a single frame. */
+		UINT32 frameAllocAverageUsage = 0; /**< Average number of bytes used from the core thread frame allocator per frame. */
+	};
+
 	/**
 	 * @brief	Represents the primary entry point for the core systems. Handles
 	 *			start-up, shutdown, primary loop and allows you to load and unload
@@ -53,6 +69,29 @@ namespace BansheeEngine
 			 */
 			void stopMainLoop();
 
+			/**
+			 * @brief	Sets the maximum number of frames the sim thread may queue for the core thread before it
+			 *			needs to wait for the core thread to finish the oldest one. Higher values allow the threads to
+			 *			overlap better and increase throughput, at the cost of higher input latency.
+			 *
+			 * @param	numFrames	Number of frames in range [1, CoreThread::MAX_FRAMES_IN_FLIGHT]. Default is 1,
+			 *						in which case the sim thread simulates the next frame while the core thread renders 
+			 *						the current one.
+			 */
+			void setMaxFramesInFlight(UINT32 numFrames);
+
+			/**
+			 * @brief	Returns the maximum number of frames the sim thread may queue for the core thread.
+			 *
+			 * @see		setMaxFramesInFlight
+			 */
+			UINT32 getMaxFramesInFlight() const { return mMaxFramesInFlight; }
+
+			/**
+			 * @brief	Returns timings and memory usage that can be used for tuning the number of frames in flight.
+			 */
+			const FramePipelineStats& getFramePipelineStats() const { return mFramePipelineStats; }
+
 			/**
 			 * @brief	
 			 */
@@ -84,9 +123,17 @@ namespace BansheeEngine
 	private:
 		/**
 		 * @brief	Called when the frame finishes rendering.
+		 *
+		 * @note	Core thread.
 		 */
 		void frameRenderingFinishedCallback();
 
+		/**
+		 * @brief	Blocks the sim thread until the number of frames queued for the core thread that
+		 *			haven't finished rendering yet is lower than the provided value.
+		 */
+		void waitUntilFramesFinished(UINT32 maxFramesInFlight);
+
 		/**
 		 * @brief	Called by the core thread to begin profiling.
 		 */
@@ -103,10 +150,18 @@ namespace BansheeEngine
 		DynLib* mSceneManagerPlugin;
 		DynLib* mRendererPlugin;
 
-		bool mIsFrameRenderingFinished;
+		UINT32 mMaxFramesInFlight;
+		UINT32 mNumQueuedFrames; // Sim thread
+		std::atomic<UINT32> mNumFinishedFrames;
+
+		std::atomic<bool> mSimThreadWaiting;
 		BS_MUTEX(mFrameRenderingFinishedMutex);
 		BS_THREAD_SYNCHRONISER(mFrameRenderingFinishedCondition);
 
+		FramePipelineStats mFramePipelineStats; // Sim thread
+		Timer* mCoreFrameTimer; // Core thread
+		std::atomic<UINT32> mCorePacingTime;
+
 		volatile bool mRunMainLoop;
 	};
 
@@ -102,7 +102,7 @@ namespace BansheeEngine
 
 			if(obj->isInitialized())
 			{
-				std::shared_ptr<CoreObject> thisPtr(obj);
+				std::shared_ptr<CoreObject> thisPtr((T*)obj, &bs_delete<MemAlloc, T>, StdAlloc<GenAlloc>());
 				obj->_setThisPtr(thisPtr);
 				obj->destroy();
 			}
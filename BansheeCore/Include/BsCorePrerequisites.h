@@ -145,6 +145,7 @@ namespace BansheeEngine
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class ResourcePackage;
 	class Texture;
 	class Mesh;
 	class MeshBase;
@@ -172,6 +173,8 @@ namespace BansheeEngine
 	class CoreThreadAccessor;
 	class CommandQueueNoSync;
 	class CommandQueueSync;
+	class CommandQueueDeferred;
+	class DeferredAccessorGroup;
 }
 
 /************************************************************************/
@@ -223,12 +226,14 @@ namespace BansheeEngine
 	typedef std::shared_ptr<VertexDataDesc> VertexDataDescPtr;
 	typedef CoreThreadAccessor<CommandQueueNoSync> CoreAccessor;
 	typedef CoreThreadAccessor<CommandQueueSync> SyncedCoreAccessor;
+	typedef CoreThreadAccessor<CommandQueueDeferred> DeferredCoreAccessor;
 	typedef std::shared_ptr<CoreThreadAccessor<CommandQueueNoSync>> CoreAccessorPtr;
 	typedef std::shared_ptr<CoreThreadAccessor<CommandQueueSync>> SyncedCoreAccessorPtr;
 	typedef std::shared_ptr<EventQuery> EventQueryPtr;
 	typedef std::shared_ptr<TimerQuery> TimerQueryPtr;
 	typedef std::shared_ptr<OcclusionQuery> OcclusionQueryPtr;
 	typedef std::shared_ptr<ResourceManifest> ResourceManifestPtr;
+	typedef std::shared_ptr<ResourcePackage> ResourcePackagePtr;
 	typedef std::shared_ptr<VideoModeInfo> VideoModeInfoPtr;
 	typedef std::shared_ptr<DrawList> DrawListPtr;
 	typedef std::shared_ptr<RenderQueue> RenderQueuePtr;
@@ -369,6 +374,8 @@ namespace BansheeEngine
 		static void onThreadEnded(const String& name)
 		{
 			MemStack::endThread();
+			MemoryAllocator<PoolAlloc>::endThread();
+			MemoryAllocator<ScratchAlloc>::endThread();
 		}
 	};
 }
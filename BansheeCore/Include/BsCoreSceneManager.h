@@ -17,6 +17,25 @@ namespace BansheeEngine
 	 */
 	class BS_CORE_EXPORT CoreSceneManager : public Module<CoreSceneManager>
 	{
+		/**
+		 * @brief	Components of a single type that need to be updated every frame.
+		 */
+		struct ComponentBucket
+		{
+			UINT32 typeId;
+			bool isParallel;
+			ProfilerString profilerName;
+
+			Vector<Component*> components; /**< Might contain null entries for components removed during an update. */
+			bool hasRemovedEntries;
+		};
+
+		/**
+		 * @brief	Number of components of a single type processed by one worker task when updating
+		 *			components that allow parallel updates.
+		 */
+		static const UINT32 PARALLEL_UPDATE_GRAIN_SIZE;
+
 	public:
 		CoreSceneManager();
 		virtual ~CoreSceneManager();
@@ -27,7 +46,7 @@ namespace BansheeEngine
 		HSceneObject getRootNode() const { return mRootNode; }
 
 		/**
-		 * @brief	Called every frame.
+		 * @brief	Called every frame. Updates all components in the scene, grouped by their type.
 		 *
 		 * @note	Internal method.
 		 */
@@ -56,8 +75,30 @@ namespace BansheeEngine
 		 */
 		virtual void notifyComponentRemoved(const HComponent& component);
 
+	private:
+		/**
+		 * @brief	Adds a newly added component to the list of components updated every frame, if it needs updating.
+		 */
+		void registerComponentUpdate(Component* component);
+
+		/**
+		 * @brief	Removes a component from the list of components updated every frame.
+		 */
+		void unregisterComponentUpdate(Component* component);
+
+		/**
+		 * @brief	Removes null entries left behind by components removed while updating, preserving
+		 *			the order of the remaining components.
+		 */
+		void compactBucket(ComponentBucket& bucket);
+
 	protected:
 		HSceneObject mRootNode;
+
+	private:
+		Vector<ComponentBucket*> mComponentBuckets;
+		UnorderedMap<UINT64, UINT32> mComponentBucketLookup;
+		bool mIsUpdating;
 	};
 
 	/**
@@ -8,6 +8,7 @@
 #include "BsCommandQueue.h"
 #include "BsCoreThreadAccessor.h"
 #include "BsThreadPool.h"
+#include "BsLockFreeRingBuffer.h"
 
 namespace BansheeEngine
 {
@@ -17,6 +18,7 @@ namespace BansheeEngine
 	 * 			
 	 * @note	How threading works:
 	 * 			 - This class contains a queue which is filled by commands from other threads via queueCommand and queueReturnCommand  
+	 * 			 - Commands are recorded into command buffers, and whole buffers are passed to the core thread through a lock-free queue
 	 * 			 - Commands are executed on the core thread as soon as they are queued (if core thread is not busy with previous commands)  
 	 * 			 - Core thread accessors are helpers for queuing commands. They serve two purposes:  
 	 * 				- They contain helper methods for various common Core thread commands.
@@ -35,7 +37,39 @@ namespace BansheeEngine
 			CoreAccessorPtr accessor;
 		};
 
+		/**
+		 * @brief	Command buffer submitted to the core thread, along with the pool
+		 *			it should be returned to once executed.
+		 */
+		struct CommandBatch
+		{
+			CommandBatch()
+				:commands(nullptr), pool(nullptr)
+			{ }
+
+			CommandBuffer* commands;
+			CommandBufferPool* pool;
+		};
+
+		/**
+		 * @brief	Maximum number of command buffers that may be waiting for execution on the core thread.
+		 *			Submitting threads will wait if the limit is reached.
+		 */
+		static const UINT32 MAX_QUEUED_BATCHES = 1024;
+
+		/**
+		 * @brief	Chunk size of command buffers used for commands queued directly on the core thread. Such buffers
+		 *			usually only hold a single command so there's no need for them to be large.
+		 */
+		static const UINT32 SINGLE_COMMAND_CHUNK_SIZE = 256;
+
 public:
+	/**
+	 * @brief	Maximum number of frames the sim thread is allowed to queue for the core thread before it needs to wait
+	 *			for the core thread to finish the oldest one.
+	 */
+	static const UINT32 MAX_FRAMES_IN_FLIGHT = 3;
+
 	BS_CORE_EXPORT CoreThread();
 	BS_CORE_EXPORT ~CoreThread();
 
@@ -92,6 +126,15 @@ public:
 		*/
 	BS_CORE_EXPORT void queueCommand(std::function<void()> commandCallback, bool blockUntilComplete = false);
 
+	/**
+	 * @brief	Submits a buffer of recorded commands for execution on the core thread. You are allowed to call this from any thread.
+	 *
+	 * @param	commands			Commands to execute. Core thread takes ownership of the buffer until the commands execute.
+	 * @param	pool				Pool to release the command buffer to, once executed.
+	 * @param	blockUntilComplete	If true the thread will be blocked until the commands execute.
+	 */
+	BS_CORE_EXPORT void submitCommands(CommandBuffer* commands, CommandBufferPool* pool, bool blockUntilComplete = false);
+
 	/**
 	 * @brief	Called once every frame.
 	 * 			
@@ -101,18 +144,76 @@ public:
 
 	/**
 	 * @brief	Returns a frame allocator that should be used for allocating temporary data being passed to the
-	 * 			core thread. As the name implies the data only lasts one frame, so you need to be careful not
-	 * 			to use it for longer than that.
+	 * 			core thread. As the name implies the data only lasts until the core thread finishes processing the
+	 * 			frame it was allocated in, so you need to be careful not to use it for longer than that.
 	 * 			
 	 * @note	Sim thread only.
 	 */
 	BS_CORE_EXPORT FrameAlloc* getFrameAlloc() const;
+
+	/**
+	 * @brief	Returns the number of commands submitted to the core thread during the last frame.
+	 */
+	BS_CORE_EXPORT UINT32 getNumCommandsLastFrame() const { return mNumCommandsLastFrame; }
+
+	/**
+	 * @brief	Returns the number of bytes of command data submitted to the core thread during the last frame.
+	 */
+	BS_CORE_EXPORT UINT32 getNumCommandBytesLastFrame() const { return mNumCommandBytesLastFrame; }
+
+	/**
+	 * @brief	Returns the number of command buffers submitted to the core thread during the last frame.
+	 */
+	BS_CORE_EXPORT UINT32 getNumCommandBatchesLastFrame() const { return mNumCommandBatchesLastFrame; }
+
+	/**
+	 * @brief	Returns the wall clock time the core thread spent blocked on the command queue waiting for commands
+	 *			during the last frame, in microseconds.
+	 *
+	 * @note	While blocked the core thread lends its CPU core to an extra task scheduler worker, so this is not
+	 *			necessarily time the core was unused.
+	 */
+	BS_CORE_EXPORT UINT32 getIdleTimeLastFrame() const { return mIdleTimeLastFrame; }
+
+	/**
+	 * @brief	Returns the number of bytes used from the frame allocator by the most recently recycled frame.
+	 *
+	 * @note	Sim thread only.
+	 */
+	BS_CORE_EXPORT UINT32 getFrameAllocUsageLastFrame() const;
+
+	/**
+	 * @brief	Returns the largest number of bytes used from the frame allocator in a single frame.
+	 *
+	 * @note	Sim thread only.
+	 */
+	BS_CORE_EXPORT UINT32 getFrameAllocPeakUsage() const;
+
+	/**
+	 * @brief	Returns the average number of bytes used from the frame allocator per frame.
+	 *
+	 * @note	Sim thread only.
+	 */
+	BS_CORE_EXPORT UINT32 getFrameAllocAverageUsage() const;
+
+	/**
+	 * @brief	Returns the total number of bytes reserved by all frame allocators.
+	 *
+	 * @note	Sim thread only.
+	 */
+	BS_CORE_EXPORT UINT32 getFrameAllocNumBytesReserved() const;
 private:
 	/**
-	 * @brief	Double buffered frame allocators. Means sim thread cannot be more than 1 frame ahead of core thread
-	 *			(If that changes you should be able to easily add more).
+	 * @brief	Number of frame allocators. One per frame that may be in flight, plus one for the frame the
+	 *			sim thread is currently recording.
+	 */
+	static const UINT32 NUM_FRAME_ALLOCS = MAX_FRAMES_IN_FLIGHT + 1;
+
+	/**
+	 * @brief	Frame allocators used in a round robin fashion. Means sim thread cannot be more than 
+	 *			MAX_FRAMES_IN_FLIGHT frames ahead of core thread.
 	 */
-	FrameAlloc* mFrameAllocs[2]; 
+	FrameAlloc* mFrameAllocs[NUM_FRAME_ALLOCS]; 
 	UINT32 mActiveFrameAlloc;
 
 	static BS_THREADLOCAL AccessorContainer* mAccessor;
@@ -128,13 +229,25 @@ private:
 	BS_MUTEX(mCommandNotifyMutex)
 	BS_THREAD_SYNCHRONISER(mCommandCompleteCondition)
 
-	CommandQueue<CommandQueueSync>* mCommandQueue;
+	LockFreeRingBuffer<CommandBatch>* mCommandBatches;
+	CommandBufferPool* mCommandBufferPool; /**< Pool for buffers used by commands queued directly through queueCommand and queueReturnCommand. */
+	std::atomic<bool> mCoreThreadSleeping;
 
-	UINT32 mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
+	std::atomic<UINT32> mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
 	Vector<UINT32> mCommandsCompleted; /**< Completed commands that have notifier callbacks set up */
 
 	SyncedCoreAccessor* mSyncedCoreAccessor;
 
+	std::atomic<UINT32> mNumCommands;
+	std::atomic<UINT32> mNumCommandBytes;
+	std::atomic<UINT32> mNumCommandBatches;
+	UINT32 mNumCommandsLastFrame;
+	UINT32 mNumCommandBytesLastFrame;
+	UINT32 mNumCommandBatchesLastFrame;
+
+	std::atomic<UINT32> mIdleTime;
+	UINT32 mIdleTimeLastFrame;
+
 	/**
 		* @brief	Starts the core thread worker method. Should only be called once.
 		*/
@@ -164,6 +277,17 @@ private:
 		* @param	commandId	Identifier for the command.
 		*/
 	void commandCompletedNotify(UINT32 commandId);
+
+	/**
+		* @brief	Executes all commands in the batch and releases the command buffer back to its pool.
+		*/
+	void executeBatch(const CommandBatch& batch);
+
+	/**
+		* @brief	Command that does nothing. Used for notifying waiting threads when the commands
+		*			before it complete.
+		*/
+	static void emptyCommand() { }
 	};
 
 	/**
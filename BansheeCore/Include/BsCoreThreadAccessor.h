@@ -157,12 +157,20 @@ namespace BansheeEngine
 		/**
 		* @brief	Queues a new generic command that will be added to the command queue.
 		*/
-		AsyncOp queueReturnCommand(std::function<void(AsyncOp&)> commandCallback);
+		template<class Func>
+		AsyncOp queueReturnCommand(Func&& commandCallback)
+		{
+			return mCommandQueue->queueReturn(std::forward<Func>(commandCallback));
+		}
 
 		/**
 		* @brief	Queues a new generic command that will be added to the command queue.
 		*/
-		void queueCommand(std::function<void()> commandCallback);
+		template<class Func>
+		void queueCommand(Func&& commandCallback)
+		{
+			mCommandQueue->queue(std::forward<Func>(commandCallback));
+		}
 
 		/**
 		 * @brief	Makes all the currently queued commands available to the core thread. They will be executed
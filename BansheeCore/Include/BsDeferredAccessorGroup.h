@@ -0,0 +1,68 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsCoreThreadAccessor.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Group of core thread accessors that may be filled in parallel, one accessor per slice of work
+	 *			(e.g. one camera or one range of renderables). When submitted, commands from all slices execute
+	 *			on the core thread in slice index order, regardless of which thread recorded them.
+	 *
+	 * @note	Each slice may be recorded from any thread, but only by one thread at a time. Submission
+	 *			must happen after all slices are done recording.
+	 *
+	 *			Groups are meant to be created once and reused every frame, as this lets accessors reuse their
+	 *			command buffers. Destroying a group blocks until all of its submitted commands finish executing.
+	 */
+	class BS_CORE_EXPORT DeferredAccessorGroup
+	{
+	public:
+		/**
+		 * @brief	Creates a new group with the specified number of slices.
+		 */
+		DeferredAccessorGroup(UINT32 numSlices);
+		~DeferredAccessorGroup();
+
+		/**
+		 * @brief	Returns the accessor for the slice with the specified index.
+		 */
+		DeferredCoreAccessor& getAccessor(UINT32 sliceIdx);
+
+		/**
+		 * @brief	Returns the number of slices in the group.
+		 */
+		UINT32 getNumSlices() const { return mNumSlices; }
+
+		/**
+		 * @brief	Changes the number of slices in the group. Must not be called while slices are being recorded.
+		 */
+		void setNumSlices(UINT32 numSlices);
+
+		/**
+		 * @brief	Submits commands from all slices to the core thread, in slice index order. Commands
+		 *			queued by the calling thread through other accessors that haven't been submitted yet 
+		 *			will execute after the commands in this group.
+		 *
+		 * @param	blockUntilComplete	If true the calling thread will block until all the commands execute.
+		 */
+		void submitToCoreThread(bool blockUntilComplete = false);
+
+		/**
+		 * @brief	Cancels all commands queued in all slices.
+		 */
+		void cancelAll();
+
+	private:
+		DeferredAccessorGroup(const DeferredAccessorGroup& other);
+		DeferredAccessorGroup& operator=(const DeferredAccessorGroup& other);
+
+		Vector<DeferredCoreAccessor*> mAccessors; // Accessors are never freed before the group is, as their commands might still be executing
+		UINT32 mNumSlices;
+		bool mHasSubmitted;
+	};
+}
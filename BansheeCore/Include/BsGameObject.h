@@ -9,7 +9,7 @@
 namespace BansheeEngine
 {
 	/**
-	 * @brief	Contains instance data that is held by all GameObject handles.
+	 * @brief	Contains instance data that is held by GameObject handles that were resolved after creation.
 	 */
 	struct GameObjectInstanceData
 	{
@@ -8,7 +8,8 @@ namespace BansheeEngine
 	class GameObjectManager;
 
 	/**
-	 * @brief	Internal data shared between GameObject handles.
+	 * @brief	Internal data shared between GameObject handles that are resolved after creation
+	 *			(e.g. deserialized handles), so that all copies of the handle get resolved at once.
 	 */
 	struct BS_CORE_EXPORT GameObjectHandleData
 	{
@@ -38,7 +39,10 @@ namespace BansheeEngine
 	 * 			For example one game object should be able to reference another one without the other
 	 * 			one knowing. But if that is the case I also need to handle the case when the other
 	 * 			object we're referencing has been deleted, and that is the main purpose of this class.
-	 * 			
+	 *
+	 *			Handles normally only store the instance ID of the object and look it up in GameObjectManager
+	 *			when accessed, which also checks if the object is still alive. Handles created through RTTI
+	 *			don't know their object until deserialization ends, so they use shared handle data instead.
 	 */
 	class BS_CORE_EXPORT GameObjectHandleBase : public IReflectable
 	{
@@ -48,12 +52,12 @@ namespace BansheeEngine
 		/**
 		 * @brief	Returns true if the object the handle is pointing to has been destroyed.
 		 */
-		bool isDestroyed() const { return mData->mPtr == nullptr || mData->mPtr->object == nullptr; }
+		bool isDestroyed() const { return findObject() == nullptr; }
 
 		/**
 		 * @brief	Returns the instance ID of the object the handle is referencing.
 		 */
-		UINT64 getInstanceId() const { return mData->mInstanceId; }
+		UINT64 getInstanceId() const { return mData != nullptr ? mData->mInstanceId : mInstanceId; }
 
 		/**
 		 * @brief	Returns pointer to the referenced GameObject.
@@ -62,9 +66,7 @@ namespace BansheeEngine
 		 */
 		GameObject* get() const 
 		{ 
-			throwIfDestroyed();
-
-			return mData->mPtr->object.get(); 
+			return getObject()->get(); 
 		}
 
 		/**
@@ -74,9 +76,7 @@ namespace BansheeEngine
 		 */
 		std::shared_ptr<GameObject> getInternalPtr() const
 		{
-			throwIfDestroyed();
-
-			return mData->mPtr->object;
+			return *getObject();
 		}
 
 		/**
@@ -94,7 +94,7 @@ namespace BansheeEngine
 		GameObject& operator*() const { return *get(); }
 
 		/**
-		 * @brief	Returns internal handle data.
+		 * @brief	Returns internal handle data. Null unless the handle was created unresolved.
 		 *
 		 * @note	Internal method.
 		 */
@@ -102,8 +102,9 @@ namespace BansheeEngine
 
 		/**
 		 * @brief	Resolves a handle to a proper GameObject in case it was created uninitialized.
+		 *			All copies of the handle are resolved as well.
 		 *
-		 * @note	Internal method.
+		 * @note	Internal method. Handle must have been created unresolved.
 		 */
 		void _resolve(const GameObjectHandleBase& object);
 
@@ -117,25 +118,17 @@ namespace BansheeEngine
 		GameObjectHandleBase(std::nullptr_t ptr);
 
 		/**
-		 * @brief	Throws an exception if the referenced GameObject has been destroyed.
+		 * @brief	Returns the smart pointer holding the referenced GameObject, or null if the object was destroyed.
 		 */
-		inline void throwIfDestroyed() const;
-		
+		const std::shared_ptr<GameObject>* findObject() const;
+
 		/**
-		 * @brief	Invalidates the handle signifiying the referenced object was destroyed.
+		 * @brief	Returns the smart pointer holding the referenced GameObject.
+		 *			Throws an exception if the referenced GameObject has been destroyed.
 		 */
-		void destroy()
-		{
-			// We need to clear mData->mPtr before we clear mData->mPtr->object,
-			// as this handle could be stored within the "object" and destroyed when
-			// we set it to null 
-			std::shared_ptr<GameObjectInstanceData> instanceData = mData->mPtr;
-			mData->mPtr = nullptr;
-
-			if(instanceData != nullptr)
-				instanceData->object = nullptr;
-		}
+		const std::shared_ptr<GameObject>* getObject() const;
 
+		UINT64 mInstanceId;
 		std::shared_ptr<GameObjectHandleData> mData;
 
 		/************************************************************************/
@@ -162,35 +155,30 @@ namespace BansheeEngine
 		 */
 		GameObjectHandle()
 			:GameObjectHandleBase()
-		{	
-			mData = bs_shared_ptr<GameObjectHandleData, PoolAlloc>();
-		}
+		{ }
 
 		/**
 		 * @brief	Copy constructor from another handle of the same type.
 		 */
 		template <typename T1>
 		GameObjectHandle(const GameObjectHandle<T1>& ptr)
-			:GameObjectHandleBase()
-		{ 	
-			mData = ptr._getHandleData();
-		}
+			:GameObjectHandleBase(ptr)
+		{ }
 
 		/**
 		 * @brief	Copy constructor from another handle of the base type.
 		 */
 		GameObjectHandle(const GameObjectHandleBase& ptr)
-			:GameObjectHandleBase()
-		{ 	
-			mData = ptr._getHandleData();
-		}
+			:GameObjectHandleBase(ptr)
+		{ }
 
 		/**
 		 * @brief	Invalidates the handle.
 		 */
 		inline GameObjectHandle<T>& operator=(std::nullptr_t ptr)
 		{ 	
-			mData = bs_shared_ptr<GameObjectHandleData, PoolAlloc>();
+			mInstanceId = 0;
+			mData = nullptr;
 
 			return *this;
 		}
@@ -200,7 +188,7 @@ namespace BansheeEngine
 		 */
 		inline operator GameObjectHandleBase()
 		{
-			GameObjectHandleBase base(mData);
+			GameObjectHandleBase base(static_cast<const GameObjectHandleBase&>(*this));
 
 			return base;
 		}
@@ -212,9 +200,7 @@ namespace BansheeEngine
 		 */
 		T* get() const 
 		{ 
-			throwIfDestroyed();
-
-			return reinterpret_cast<T*>(mData->mPtr->object.get()); 
+			return reinterpret_cast<T*>(getObject()->get()); 
 		}
 
 		/**
@@ -224,9 +210,7 @@ namespace BansheeEngine
 		 */
 		std::shared_ptr<T> getInternalPtr() const
 		{
-			throwIfDestroyed();
-
-			return std::static_pointer_cast<T>(mData->mPtr->object);
+			return std::static_pointer_cast<T>(*getObject());
 		}
 
 		/**
@@ -257,7 +241,7 @@ namespace BansheeEngine
 		 */
 		operator int Bool_struct<T>::*() const
 		{
-			return (((mData->mPtr != nullptr) && (mData->mPtr->object != nullptr)) ? &Bool_struct<T>::_Member : 0);
+			return (findObject() != nullptr ? &Bool_struct<T>::_Member : 0);
 		}
 
 	private:
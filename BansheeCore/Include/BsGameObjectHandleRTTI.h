@@ -13,7 +13,14 @@ namespace BansheeEngine
 	class BS_CORE_EXPORT GameObjectHandleRTTI : public RTTIType<GameObjectHandleBase, IReflectable, GameObjectHandleRTTI>
 	{
 	private:
-		UINT64& getInstanceId(GameObjectHandleBase* obj) { return obj->mData->mInstanceId; }
+		UINT64& getInstanceId(GameObjectHandleBase* obj) 
+		{ 
+			if(obj->mData != nullptr)
+				return obj->mData->mInstanceId;
+
+			return obj->mInstanceId; 
+		}
+
 		void setInstanceId(GameObjectHandleBase* obj, UINT64& value) { obj->mData->mInstanceId = value; } 
 
 	public:
@@ -42,7 +49,9 @@ namespace BansheeEngine
 
 		virtual std::shared_ptr<IReflectable> newRTTIObject()
 		{
-			std::shared_ptr<GameObjectHandleBase> obj = bs_shared_ptr<GameObjectHandleBase, PoolAlloc>(new (bs_alloc<GameObjectHandleBase, PoolAlloc>()) GameObjectHandleBase());
+			// Deserialized handles get resolved once all objects are created, so they need shared data
+			std::shared_ptr<GameObjectHandleData> handleData = bs_shared_ptr<GameObjectHandleData, PoolAlloc>();
+			std::shared_ptr<GameObjectHandleBase> obj = bs_shared_ptr<GameObjectHandleBase, PoolAlloc>(new (bs_alloc<GameObjectHandleBase, PoolAlloc>()) GameObjectHandleBase(handleData));
 
 			return obj;
 		}
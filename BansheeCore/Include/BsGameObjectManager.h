@@ -13,7 +13,12 @@ namespace BansheeEngine
 	 * @brief	Tracks GameObject creation and destructions. Also resolves
 	 *			GameObject references from GameObject handles.
 	 *
-	 * @note	Sim thread only.
+	 * @note	Objects are stored in a slot map. Instance IDs contain the index of the object's slot in
+	 *			the lower 32 bits and the slot's generation in the upper 32 bits. Generation is increased
+	 *			whenever an object is unregistered, so lookup by ID is a single array access followed by a
+	 *			generation check, and IDs of destroyed objects are never resolved to objects that reuse their slot.
+	 *
+	 *			Sim thread only.
 	 */
 	class BS_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
 	{
@@ -27,7 +32,11 @@ namespace BansheeEngine
 		GameObjectHandleBase registerObject(const std::shared_ptr<GameObject>& object);
 
 		/**
-		 * @brief	Unregisters a GameObject.
+		 * @brief	Unregisters a GameObject. All handles referencing the object are invalidated and 
+		 *			the object is destroyed once no references to it remain.
+		 *
+		 * @note	Object may be destroyed before this method returns, so the provided handle must not
+		 *			be used by the caller afterwards if it is owned by the object itself.
 		 */
 		void unregisterObject(const GameObjectHandleBase& object);
 
@@ -48,6 +57,19 @@ namespace BansheeEngine
 		 */
 		bool objectExists(UINT64 id) const;
 
+		/**
+		 * @brief	Returns the number of currently registered GameObjects.
+		 */
+		UINT32 getNumObjects() const { return mNumObjects; }
+
+		/**
+		 * @brief	Returns the smart pointer holding the object with the specified instance ID, or null 
+		 *			if the ID doesn't belong to a registered object.
+		 *
+		 * @note	Internal method used by GameObject handles.
+		 */
+		const std::shared_ptr<GameObject>* _findObject(UINT64 id) const;
+
 		/************************************************************************/
 		/* 							DESERIALIZATION                      		*/
 		/************************************************************************/
@@ -93,12 +115,36 @@ namespace BansheeEngine
 		void registerOnDeserializationEndCallback(std::function<void()> callback);
 
 	private:
-		UINT64 mNextAvailableID; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
+		/**
+		 * @brief	Entry in the object table. Holds a registered object, or links to the next free slot if empty.
+		 */
+		struct ObjectSlot
+		{
+			std::shared_ptr<GameObject> object;
+			UINT32 generation;
+			UINT32 nextFree;
+		};
+
+		/**
+		 * @brief	Combines a slot index and generation into an instance ID.
+		 */
+		static UINT64 makeId(UINT32 index, UINT32 generation) { return ((UINT64)generation << 32) | index; }
+
+		/**
+		 * @brief	Returns the slot for the object with the specified instance ID, or null if
+		 *			the ID doesn't belong to a registered object.
+		 */
+		const ObjectSlot* findSlot(UINT64 id) const;
+
+		static const UINT32 INVALID_SLOT;
+
+		Vector<ObjectSlot> mSlots;
+		UINT32 mFirstFreeSlot;
+		UINT32 mNumObjects;
 
 		GameObject* mActiveDeserializedObject;
 		bool mIsDeserializationActive;
-		Map<UINT64, UINT64> mIdMapping;
+		UnorderedMap<UINT64, UINT64> mIdMapping;
 		Vector<GameObjectHandleBase> mUnresolvedHandles;
 		Vector<std::function<void()>> mEndCallbacks;
 	};
@@ -90,7 +90,7 @@ namespace BansheeEngine
 			StructData(UINT32 _size)
 				:size(_size)
 			{
-				data = std::shared_ptr<void>(bs_alloc<ScratchAlloc>(_size), &bs_free<ScratchAlloc>);
+				data = std::shared_ptr<void>(bs_alloc<PoolAlloc>(_size), &bs_free<PoolAlloc>);
 			}
 
 			/**
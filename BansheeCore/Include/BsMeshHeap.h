@@ -7,9 +7,20 @@
 #include "BsCoreObject.h"
 #include "BsDrawOps.h"
 #include "BsIndexBuffer.h"
+#include "BsRangeAllocator.h"
 
 namespace BansheeEngine
 {
+	/**
+	 * @brief	Occupancy and fragmentation statistics of a MeshHeap.
+	 */
+	struct MeshHeapStats
+	{
+		RangeAllocatorStats vertices; /**< Statistics of the vertex buffer, in vertices. */
+		RangeAllocatorStats indices; /**< Statistics of the index buffer, in indices. */
+		UINT32 numMeshes = 0; /**< Number of meshes whose data is still held by the heap, including meshes still used by the GPU. */
+	};
+
 	/**
 	 * @brief	Mesh heap allows you to quickly allocate and deallocate a large amounts of temporary 
 	 *			meshes without the large overhead of normal Mesh creation.
@@ -39,21 +50,13 @@ namespace BansheeEngine
 			Free /**< Data chunk was released by both CPU and GPU. */
 		};
 
-		/**
-		 * @brief	Represents a continuous chunk of memory.
-		 */
-		struct ChunkData
-		{
-			UINT32 start, size;
-		};
-
 		/**
 		 * @brief	Represents an allocated piece of data representing a mesh.
 		 */
 		struct AllocatedData
 		{
-			UINT32 vertChunkIdx;
-			UINT32 idxChunkIdx;
+			UINT32 vertBlockId;
+			UINT32 idxBlockId;
 
 			UseFlags useFlags;
 			UINT32 eventQueryIdx;
@@ -87,6 +90,13 @@ namespace BansheeEngine
 		 */
 		void dealloc(const TransientMeshPtr& mesh);
 
+		/**
+		 * @brief	Returns occupancy and fragmentation statistics of the vertex and index buffers.
+		 *
+		 * @note	Core thread.
+		 */
+		MeshHeapStats getStats() const;
+
 		/**
 		 * @brief	Creates a new mesh heap.
 		 *
@@ -135,9 +145,17 @@ namespace BansheeEngine
 		 */
 		void deallocInternal(TransientMeshPtr mesh);
 
+		/**
+		 * @brief	Releases vertex and index buffer ranges used by a mesh, once both CPU
+		 *			and GPU are done with it.
+		 *
+		 * @note	Core thread.
+		 */
+		void freeAllocData(const AllocatedData& allocData);
+
 		/**
 		 * @brief	Resizes the vertex buffers so they max contain the provided
-		 *			number of vertices.
+		 *			number of vertices. Existing data keeps its location.
 		 *
 		 * @note	Core thread.
 		 */
@@ -145,7 +163,7 @@ namespace BansheeEngine
 
 		/**
 		 * @brief	Resizes the index buffer so they max contain the provided
-		 *			number of indices.
+		 *			number of indices. Existing data keeps its location.
 		 *
 		 * @note	Core thread.
 		 */
@@ -200,15 +218,6 @@ namespace BansheeEngine
 		 */
 		static void queryTriggered(MeshHeapPtr thisPtr, UINT32 meshId, UINT32 queryId);
 
-		/**
-		 * @brief	Attempts to reorganize the vertex and index buffer chunks in order to 
-		 *			in order to make free memory contigous.
-		 *
-		 * @note	This will not actually copy any data from index/vertex buffers, and will only
-		 *			modify the chunk descriptors.
-		 */
-		void mergeWithNearbyChunks(UINT32 chunkVertIdx, UINT32 chunkIdxIdx);
-
 	private:
 		UINT32 mNumVertices; // Core thread
 		UINT32 mNumIndices; // Core thread
@@ -219,7 +228,7 @@ namespace BansheeEngine
 		std::shared_ptr<VertexData> mVertexData; // Core thread
 		IndexBufferPtr mIndexBuffer; // Core thread
 
-		Map<UINT32, AllocatedData> mMeshAllocData; // Core thread
+		UnorderedMap<UINT32, AllocatedData> mMeshAllocData; // Core thread
 
 		VertexDataDescPtr mVertexDesc; // Immutable
 		IndexBuffer::IndexType mIndexType; // Immutable
@@ -227,14 +236,8 @@ namespace BansheeEngine
 		Map<UINT32, TransientMeshPtr> mMeshes; // Sim thread
 		UINT32 mNextFreeId; // Sim thread
 
-		Vector<ChunkData> mVertChunks; // Core thread
-		Vector<ChunkData> mIdxChunks; // Core thread
-
-		Stack<UINT32> mEmptyVertChunks; // Core thread
-		Stack<UINT32> mEmptyIdxChunks; // Core thread
-
-		List<UINT32> mFreeVertChunks; // Core thread
-		List<UINT32> mFreeIdxChunks; // Core thread
+		RangeAllocator mVertAllocator; // Core thread
+		RangeAllocator mIdxAllocator; // Core thread
 
 		Vector<QueryData> mEventQueries; // Core thread
 		Stack<UINT32> mFreeEventQueries; // Core thread
@@ -0,0 +1,76 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsPixelData.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Instruction sets pixel conversion kernels can be implemented with,
+	 *			ordered from least to most capable.
+	 */
+	enum class PixelConversionISA
+	{
+		Scalar,
+		SSE2,
+		SSSE3,
+		AVX2
+	};
+
+	/**
+	 * @brief	Converts rows of pixels between uncompressed formats using vectorized kernels.
+	 *
+	 *			Handles all 8-bit per channel, 16-bit float and 32-bit float formats. Conversions between
+	 *			two 8-bit formats are performed as byte shuffles, while all other conversions go through
+	 *			an intermediate RGBA float representation. Results are bit exact with converting each pixel
+	 *			using PixelUtil::unpackColor followed by PixelUtil::packColor.
+	 *
+	 *			Kernels are picked on first use, based on the instruction sets supported by the CPU.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT PixelConversion
+	{
+	public:
+		/**
+		 * @brief	Checks is there a conversion kernel for the provided pair of formats.
+		 *
+		 * @note	PF_R8G8B8X8 and PF_B8G8R8X8 are only supported as destination formats,
+		 *			as their padding byte is reported as an alpha channel with no bits.
+		 */
+		static bool isSupported(PixelFormat srcFormat, PixelFormat dstFormat);
+
+		/**
+		 * @brief	Converts a row of pixels from one format to another. Caller must ensure the
+		 *			conversion is supported (see isSupported), and that source and destination
+		 *			don't overlap.
+		 *
+		 * @param	srcFormat	Format of the source pixels.
+		 * @param	dstFormat	Format of the destination pixels.
+		 * @param	src			Pointer to the first source pixel.
+		 * @param	dst			Pointer to the first destination pixel.
+		 * @param	count		Number of pixels to convert.
+		 */
+		static void convertRow(PixelFormat srcFormat, PixelFormat dstFormat, const UINT8* src, UINT8* dst, UINT32 count);
+
+		/**
+		 * @brief	Returns the instruction set of the kernels currently used for conversion.
+		 */
+		static PixelConversionISA getISA();
+
+		/**
+		 * @brief	Returns the most capable instruction set supported by both the CPU and the build.
+		 */
+		static PixelConversionISA getMaxSupportedISA();
+
+		/**
+		 * @brief	Changes the instruction set of the kernels used for conversion. Clamped to the
+		 *			most capable supported instruction set. Primarily useful for comparing the kernels
+		 *			against each other.
+		 */
+		static void setISA(PixelConversionISA isa);
+	};
+}
@@ -30,13 +30,14 @@ namespace BansheeEngine
 	};
 
 	/**
-	 * @brief	Wrap mode to use when generating mip maps.
+	 * @brief	Wrap mode to use when generating mip maps. Determines which pixels are sampled
+	 *			by filters that reach past the edges of the image.
 	 */
 	enum class MipMapWrapMode
 	{
-		Mirror,
-		Repeat,
-		Clamp
+		Mirror, /**< Image is reflected around its edge pixels. */
+		Repeat, /**< Image is tiled. */
+		Clamp /**< Edge pixels are repeated. */
 	};
 
 	/**
@@ -44,9 +45,9 @@ namespace BansheeEngine
 	 */
 	enum class MipMapFilter
 	{
-		Box,
-		Triangle,
-		Kaiser
+		Box, /**< Averages the source pixels covered by the destination pixel. Fastest, but the most prone to aliasing. */
+		Triangle, /**< Tent filter reaching one destination pixel in each direction. */
+		Kaiser /**< Windowed sinc filter reaching three destination pixels in each direction. Sharpest results, slowest. */
 	};
 
 	/**
@@ -63,13 +64,16 @@ namespace BansheeEngine
 
 	/**
 	 * @brief	Options used to control texture mip map generation.
+	 *
+	 * @note	Filters are evaluated in the source color space, without converting sRGB data to linear first.
+	 *			Kaiser filter always uses the same parameters, which match the NVTT defaults.
 	 */
 	struct MipMapGenOptions
 	{
 		MipMapFilter filter = MipMapFilter::Box;
-		MipMapWrapMode wrapMode = MipMapWrapMode::Mirror;
+		MipMapWrapMode wrapMode = MipMapWrapMode::Mirror; /**< Has no effect with the box filter, as it never reaches past the image edges. */
 		bool isNormalMap = false;
-		bool normalizeMipmaps = false;
+		bool normalizeMipmaps = false; /**< Renormalizes the normals in the first three channels of each level. Only used if ::isNormalMap is true. */
 	};
 
 	/**
@@ -245,7 +249,7 @@ namespace BansheeEngine
 
 		/**
 		 * @brief	Generates mip-maps from the provided source data using the specified compression options.
-		 *			Returned list includes the base level.
+		 *			Returned list includes the base level. Source dimensions don't need to be powers of two.
 		 *
 		 * @returns	A list of calculated mip-map data. First entry is the largest mip and other follow in
 		 *			order from largest to smallest.
@@ -42,6 +42,9 @@ namespace BansheeEngine
 
 		UINT32 numObjectsCreated; /**< How many GPU objects were created. */
 		UINT32 numObjectsDestroyed; /**< How many GPU objects were destroyed. */
+
+		UINT32 numRenderablesCulled; /**< How many renderable elements were rejected by frustum culling. */
+		UINT32 numRenderablesUploaded; /**< How many renderable elements had their per-object parameters uploaded. */
 	};
 
 	/**
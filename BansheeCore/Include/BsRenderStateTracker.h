@@ -0,0 +1,105 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsGpuProgram.h"
+#include "BsDrawOps.h"
+#include "BsRenderSystemCapabilities.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Sits between a renderer and the active render system, remembering which states, programs,
+	 *			parameters and buffers are bound and only forwarding calls that change them.
+	 *
+	 *			Empty pointers are treated as unknown state, so requests to bind an empty object (other than unbinding
+	 *			a program) are always forwarded.
+	 *
+	 * @note	Tracker has no knowledge of calls made on the render system directly, so it must be
+	 *			reset whenever the render system could have been used by someone else. Parameters
+	 *			are compared by object, so they must not be modified while tracked (i.e. between
+	 *			binding them and the next "reset").
+	 *
+	 *			Core thread only.
+	 */
+	class BS_CORE_EXPORT RenderStateTracker
+	{
+	public:
+		RenderStateTracker();
+
+		/**
+		 * @brief	Forgets all tracked state, causing the next call of every type to be forwarded.
+		 */
+		void reset();
+
+		/**
+		 * @brief	Binds the provided GPU program to the specified stage, or unbinds the stage if
+		 *			the handle is not valid.
+		 *
+		 * @see		RenderSystem::bindGpuProgram
+		 */
+		void bindGpuProgram(GpuProgramType type, const HGpuProgram& program);
+
+		/**
+		 * @see		RenderSystem::bindGpuParams
+		 */
+		void bindGpuParams(GpuProgramType type, const GpuParamsPtr& params);
+
+		/**
+		 * @see		RenderSystem::setBlendState
+		 */
+		void setBlendState(const BlendStatePtr& blendState);
+
+		/**
+		 * @see		RenderSystem::setRasterizerState
+		 */
+		void setRasterizerState(const RasterizerStatePtr& rasterizerState);
+
+		/**
+		 * @see		RenderSystem::setDepthStencilState
+		 */
+		void setDepthStencilState(const DepthStencilStatePtr& depthStencilState, UINT32 stencilRefValue);
+
+		/**
+		 * @see		RenderSystem::setVertexDeclaration
+		 */
+		void setVertexDeclaration(const VertexDeclarationPtr& vertexDeclaration);
+
+		/**
+		 * @see		RenderSystem::setVertexBuffers
+		 */
+		void setVertexBuffers(UINT32 index, VertexBufferPtr* buffers, UINT32 numBuffers);
+
+		/**
+		 * @see		RenderSystem::setIndexBuffer
+		 */
+		void setIndexBuffer(const IndexBufferPtr& buffer);
+
+		/**
+		 * @see		RenderSystem::setDrawOperation
+		 */
+		void setDrawOperation(DrawOperationType op);
+
+	private:
+		static const UINT32 NUM_PROGRAM_TYPES = GPT_COMPUTE_PROGRAM + 1;
+
+		HGpuProgram mPrograms[NUM_PROGRAM_TYPES];
+		bool mProgramsValid[NUM_PROGRAM_TYPES];
+		GpuParamsPtr mParams[NUM_PROGRAM_TYPES];
+
+		BlendStatePtr mBlendState;
+		RasterizerStatePtr mRasterizerState;
+		DepthStencilStatePtr mDepthStencilState;
+		UINT32 mStencilRefValue;
+
+		VertexDeclarationPtr mVertexDeclaration;
+		VertexBufferPtr mVertexBuffers[MAX_BOUND_VERTEX_BUFFERS];
+		UINT32 mVertexBufferIndex;
+		UINT32 mNumVertexBuffers;
+		IndexBufferPtr mIndexBuffer;
+		DrawOperationType mDrawOp;
+		bool mDrawOpValid;
+	};
+}
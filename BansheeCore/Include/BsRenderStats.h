@@ -31,7 +31,9 @@ namespace BansheeEngine
 		: numDrawCalls(0), numRenderTargetChanges(0), numPresents(0), numClears(0),
 		  numVertices(0), numPrimitives(0), numBlendStateChanges(0), numRasterizerStateChanges(0), 
 		  numDepthStencilStateChanges(0), numTextureBinds(0), numSamplerBinds(0), numVertexBufferBinds(0), 
-		  numIndexBufferBinds(0), numGpuParamBufferBinds(0), numGpuProgramBinds(0)
+		  numIndexBufferBinds(0), numGpuParamBufferBinds(0), numGpuProgramBinds(0), numResourceWrites(0),
+		  numResourceReads(0), numObjectsCreated(0), numObjectsDestroyed(0), numRenderablesCulled(0),
+		  numRenderablesUploaded(0)
 		{ }
 
 		UINT64 numDrawCalls;
@@ -58,6 +60,9 @@ namespace BansheeEngine
 
 		UINT64 numObjectsCreated; 
 		UINT64 numObjectsDestroyed;
+
+		UINT64 numRenderablesCulled;
+		UINT64 numRenderablesUploaded;
 	};
 
 	/**
@@ -128,6 +133,14 @@ namespace BansheeEngine
 		 *  times was a GPU program bound to the pipeline. */
 		void incNumGpuProgramBinds() { mData.numGpuProgramBinds++; }
 
+		/** Increments culled renderable counter indicating how many
+		 *  renderable elements were rejected by camera frustum tests. */
+		void addNumRenderablesCulled(UINT32 count) { mData.numRenderablesCulled += count; }
+
+		/** Increments uploaded renderable counter indicating how many
+		 *  renderable elements had their per-object GPU parameters written to. */
+		void addNumRenderablesUploaded(UINT32 count) { mData.numRenderablesUploaded += count; }
+
 		/**
 		 * Increments created GPU resource counter. 
 		 *
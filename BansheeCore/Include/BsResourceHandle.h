@@ -66,6 +66,14 @@ namespace BansheeEngine
 		 */
 		void _setHandleData(std::shared_ptr<Resource> ptr, const String& uuid);
 
+		/**
+		 * @brief	Marks the handle as finished loading without assigning it a resource, releasing any
+		 *			threads waiting on it. Handle remains invalid. Used when resource loading is canceled.
+		 *
+		 * @note	Internal method.
+		 */
+		void _abortLoad();
+
 	protected:
 		ResourceHandleBase();
 
@@ -63,6 +63,18 @@ namespace BansheeEngine
 		 */
 		bool filePathExists(const Path& filePath) const;
 
+		/**
+		 * @brief	Records UUIDs of resources referenced by the resource with the provided UUID. This
+		 *			allows the referenced resources to be loaded before, or in parallel with, the resource.
+		 */
+		void registerDependencies(const String& uuid, const Vector<String>& dependencies);
+
+		/**
+		 * @brief	Outputs UUIDs of resources referenced by the resource with the provided UUID.
+		 *			Returns false if no dependencies were registered for the resource.
+		 */
+		bool getDependencies(const String& uuid, Vector<String>& dependencies) const;
+
 		/**
 		 * @brief	Saves the resource manifest to the specified location.
 		 *
@@ -92,6 +104,7 @@ namespace BansheeEngine
 		String mName;
 		UnorderedMap<String, Path> mUUIDToFilePath;
 		UnorderedMap<Path, String> mFilePathToUUID;
+		UnorderedMap<String, Vector<String>> mDependencies;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
@@ -39,11 +39,22 @@ namespace BansheeEngine
 				obj->mFilePathToUUID[entry.second] = entry.first;
 			}
 		} 
+
+		UnorderedMap<String, Vector<String>>& getDependencies(ResourceManifest* obj)
+		{
+			return obj->mDependencies;
+		}
+
+		void setDependencies(ResourceManifest* obj, UnorderedMap<String, Vector<String>>& val)
+		{
+			obj->mDependencies = val;
+		}
 	public:
 		ResourceManifestRTTI()
 		{
 			addPlainField("mName", 0, &ResourceManifestRTTI::getName, &ResourceManifestRTTI::setName);
 			addPlainField("mUUIDToFilePath", 1, &ResourceManifestRTTI::getUUIDMap, &ResourceManifestRTTI::setUUIDMap);
+			addPlainField("mDependencies", 2, &ResourceManifestRTTI::getDependencies, &ResourceManifestRTTI::setDependencies);
 		}
 
 		virtual const String& getRTTIName()
@@ -0,0 +1,177 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Single file archive containing serialized resources, indexed by resource UUID.
+	 *
+	 *			Package is memory mapped when opened, and the index is a hash table that is
+	 *			used directly from the mapped file, so opening a package doesn't require any
+	 *			parsing and finding an entry is a constant time operation. Uncompressed entries
+	 *			are read straight from the mapping, while compressed ones are decompressed
+	 *			into a temporary buffer when opened.
+	 *
+	 * @note	Thread safe. Create packages using ResourcePackageWriter.
+	 */
+	class BS_CORE_EXPORT ResourcePackage
+	{
+	public:
+		ResourcePackage(const MemoryMappedFilePtr& file);
+
+		/**
+		 * @brief	Checks does the package contain a resource with the specified UUID.
+		 */
+		bool contains(const String& uuid) const;
+
+		/**
+		 * @brief	Opens a stream that can be used for reading the serialized data of the
+		 *			resource with the specified UUID. Returns null if the package doesn't
+		 *			contain the resource.
+		 */
+		MemoryDataStreamPtr openEntry(const String& uuid) const;
+
+		/**
+		 * @brief	Returns the size of the serialized data of the resource with the specified UUID,
+		 *			after decompression. Returns 0 if the package doesn't contain the resource.
+		 */
+		UINT32 getEntrySize(const String& uuid) const;
+
+		/**
+		 * @brief	Outputs UUIDs of resources referenced by the resource with the specified UUID.
+		 *			Returns false if the package doesn't contain the resource.
+		 */
+		bool getDependencies(const String& uuid, Vector<String>& dependencies) const;
+
+		/**
+		 * @brief	Returns the number of resources in the package.
+		 */
+		UINT32 getNumEntries() const;
+
+		/**
+		 * @brief	Opens the package at the specified path. Throws an exception if the file
+		 *			isn't a valid package.
+		 */
+		static ResourcePackagePtr open(const Path& filePath);
+
+	private:
+		friend class ResourcePackageWriter;
+
+		/**
+		 * @brief	Package header, located at the start of the file.
+		 */
+		struct Header
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 numEntries;
+			UINT32 numBuckets; /**< Number of buckets in the hash table, always a power of two. */
+			UINT64 tableOffset;
+			UINT64 stringsOffset;
+			UINT64 stringsSize;
+			UINT64 dependenciesOffset;
+			UINT32 numDependencies;
+			UINT32 padding;
+		};
+
+		/**
+		 * @brief	Single bucket of the hash table containing package entries.
+		 */
+		struct Entry
+		{
+			UINT64 uuidHash;
+			UINT64 offset; /**< Offset of entry data from the start of the file. Always aligned to ENTRY_ALIGNMENT. */
+			UINT32 size; /**< Size of the data as stored in the package. */
+			UINT32 uncompressedSize;
+			UINT32 uuidOffset; /**< Offset of the UUID relative to the start of the strings block. */
+			UINT16 uuidLength;
+			UINT16 flags;
+			UINT32 firstDependency; /**< Index of the first dependency in the dependency table. */
+			UINT32 numDependencies;
+		};
+
+		/**
+		 * @brief	Reference to a UUID of a resource dependency.
+		 */
+		struct Dependency
+		{
+			UINT32 uuidOffset; /**< Offset of the UUID relative to the start of the strings block. */
+			UINT32 uuidLength;
+		};
+
+		enum EntryFlags
+		{
+			EF_Used = 0x01,
+			EF_Compressed = 0x02
+		};
+
+		/**
+		 * @brief	Finds the entry for the resource with the specified UUID, or returns null if one doesn't exist.
+		 */
+		const Entry* findEntry(const String& uuid) const;
+
+		/**
+		 * @brief	Generates a hash used for finding entries in the hash table.
+		 */
+		static UINT64 hashUUID(const String& uuid);
+
+		static const UINT32 MAGIC;
+		static const UINT32 VERSION;
+		static const UINT32 ENTRY_ALIGNMENT;
+
+		MemoryMappedFilePtr mFile;
+		const Header* mHeader;
+		const Entry* mEntries;
+		const Dependency* mDependencies;
+		const char* mStrings;
+	};
+
+	/**
+	 * @brief	Builds resource packages that can later be read using ResourcePackage.
+	 */
+	class BS_CORE_EXPORT ResourcePackageWriter
+	{
+	public:
+		ResourcePackageWriter();
+		~ResourcePackageWriter();
+
+		/**
+		 * @brief	Adds serialized resource data to the package. Data is copied internally.
+		 *
+		 * @param	uuid			UUID of the resource the data belongs to.
+		 * @param	data			Serialized resource data.
+		 * @param	size			Size of the data, in bytes.
+		 * @param	dependencies	UUIDs of resources referenced by the resource.
+		 * @param	compress		Should the data be compressed. Data is stored uncompressed regardless
+		 *							if compression doesn't reduce its size.
+		 */
+		void addEntry(const String& uuid, const UINT8* data, UINT32 size, const Vector<String>& dependencies, bool compress);
+
+		/**
+		 * @brief	Writes all added entries into a package at the specified location. Any
+		 *			existing file at the location is overwritten.
+		 */
+		void save(const Path& filePath);
+
+	private:
+		/**
+		 * @brief	Entry added to the writer but not yet saved.
+		 */
+		struct PendingEntry
+		{
+			String uuid;
+			Vector<String> dependencies;
+			UINT8* data;
+			UINT32 size;
+			UINT32 uncompressedSize;
+			bool compressed;
+		};
+
+		Vector<PendingEntry> mEntries;
+		UnorderedMap<String, UINT32> mEntryLookup;
+	};
+}
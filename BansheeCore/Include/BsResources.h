@@ -5,9 +5,23 @@
 
 #include "BsCorePrerequisites.h"
 #include "BsModule.h"
+#include "BsTaskScheduler.h"
+#include "BsEvent.h"
+#include "BsPath.h"
 
 namespace BansheeEngine
 {
+	/**
+	 * @brief	Timing information about a single finished resource load.
+	 */
+	struct ResourceLoadTiming
+	{
+		String uuid;
+		UINT64 size; /**< Size of the serialized resource data, in bytes. */
+		UINT64 queuedTime; /**< Time between the load being requested and it starting, in microseconds. */
+		UINT64 loadTime; /**< Time it took to read and deserialize the resource, in microseconds. */
+	};
+
 	/**
 	 * @brief	Manager for dealing with all engine resources. It allows you to save 
 	 *			new resources and load existing ones.
@@ -15,6 +29,11 @@ namespace BansheeEngine
 	 *			Used for manually dealing with resources but also for automatic resolving of
 	 *			resource handles.
 	 *
+	 *			Asynchronous loads also start loading of all resources the loaded resource depends on, 
+	 *			as recorded in resource manifests and packages when the resource was saved, so the 
+	 *			entire dependency graph is loaded in parallel. Loads are started in priority order, 
+	 *			and only as long as the total size of resources being loaded fits in the load memory budget.
+	 *
 	 * @note	Sim thread only.
 	 */
 	class BS_CORE_EXPORT Resources : public Module<Resources>
@@ -43,19 +62,21 @@ namespace BansheeEngine
 		 *			until resource loading is done.
 		 *
 		 * @param	filePath	Full pathname of the file.
+		 * @param	priority	(optional) Loads with higher priority are started sooner. Priority is
+		 *						inherited by the resources dependencies.
 		 * 						
 		 * @note	You can use returned invalid handle in engine systems as the engine will check for handle 
 		 *			validity before using it.
 		 */
-		HResource loadAsync(const Path& filePath);
+		HResource loadAsync(const Path& filePath, TaskPriority priority = TaskPriority::Normal);
 
 		/**
 		 * @copydoc	loadAsync
 		 */
 		template <class T>
-		ResourceHandle<T> loadAsync(const Path& filePath)
+		ResourceHandle<T> loadAsync(const Path& filePath, TaskPriority priority = TaskPriority::Normal)
 		{
-			return static_resource_cast<T>(loadAsync(filePath));
+			return static_resource_cast<T>(loadAsync(filePath, priority));
 		}
 
 		/**
@@ -68,12 +89,35 @@ namespace BansheeEngine
 		 * @brief	Loads the resource with the given UUID asynchronously. Initially returned resource handle will be invalid
 		 *			until resource loading is done.
 		 *
-		 * @param	uuid	UUID of the resource to load. 
+		 * @param	uuid		UUID of the resource to load. 
+		 * @param	priority	(optional) Loads with higher priority are started sooner. Priority is
+		 *						inherited by the resources dependencies.
 		 *
 		 * @note	You can use returned invalid handle in engine systems as the engine will check for handle
 		 *			validity before using it.
 		 */
-		HResource loadFromUUIDAsync(const String& uuid);
+		HResource loadFromUUIDAsync(const String& uuid, TaskPriority priority = TaskPriority::Normal);
+
+		/**
+		 * @brief	Cancels an asynchronous load of the resource referenced by the handle. Returns false
+		 *			if the resource isn't being loaded or its loading has already started. 
+		 *
+		 * @note	Handle of a canceled resource is never made valid. Loads of resource dependencies
+		 *			are not canceled as they might be shared with other resources.
+		 */
+		bool cancelLoad(const HResource& resource);
+
+		/**
+		 * @brief	Sets the maximum total size of resources, in bytes, that may be loading at once.
+		 *			Loads that don't fit in the budget are delayed until other loads finish. A single
+		 *			resource larger than the budget is still loaded, once nothing else is loading.
+		 */
+		void setLoadMemoryBudget(UINT64 budget);
+
+		/**
+		 * @copydoc	setLoadMemoryBudget
+		 */
+		UINT64 getLoadMemoryBudget() const { return mLoadMemoryBudget; }
 
 		/**
 		 * @brief	Unloads the resource that is referenced by the handle. 
@@ -91,7 +135,8 @@ namespace BansheeEngine
 		void unloadAllUnused();
 
 		/**
-		 * @brief	Saves the resource at the specified location.
+		 * @brief	Saves the resource at the specified location. UUIDs of resources referenced
+		 *			by the resource are recorded in the default manifest.
 		 *
 		 * @param	resource 	Handle to the resource.
 		 * @param	filePath 	Full pathname of the file to save as.
@@ -107,6 +152,20 @@ namespace BansheeEngine
 		 */
 		void save(HResource resource, const Path& filePath, bool overwrite);
 
+		/**
+		 * @brief	Saves a set of resources into a single resource package at the specified location.
+		 *			Any existing file at the location is overwritten. UUIDs of resources referenced
+		 *			by each resource are recorded in the package.
+		 *
+		 * @param	resources	Resources to save. Same restrictions apply as for "save".
+		 * @param	filePath	Location of the package file.
+		 * @param	compress	Should the resource data be compressed. Compressed packages are smaller
+		 *						but resources cannot be read from them without an extra copy.
+		 *
+		 * @see		registerResourcePackage
+		 */
+		void saveToPackage(const Vector<HResource>& resources, const Path& filePath, bool compress);
+
 		/**
 		 * @brief	Creates a new resource handle from a resource pointer. 
 		 *
@@ -136,6 +195,19 @@ namespace BansheeEngine
 		 */
 		ResourceManifestPtr getResourceManifest(const String& name) const;
 
+		/**
+		 * @brief	Registers a resource package. Any resource contained in the package will be
+		 *			loaded from the package instead of from its own file. Packages registered later
+		 *			take priority over earlier ones.
+		 */
+		void registerResourcePackage(const ResourcePackagePtr& package);
+
+		/**
+		 * @brief	Unregisters a previously registered resource package. Already loaded resources
+		 *			are unaffected.
+		 */
+		void unregisterResourcePackage(const ResourcePackagePtr& package);
+
 		/**
 		 * @brief	Attempts to retrieve file path from the provided UUID. Returns true
 		 *			if successful, false otherwise.
@@ -148,11 +220,115 @@ namespace BansheeEngine
 		 */
 		bool getUUIDFromFilePath(const Path& path, String& uuid) const;
 
+		/**
+		 * @brief	Triggered whenever a resource finishes loading. Triggered on the thread that loaded the resource.
+		 */
+		Event<void(const ResourceLoadTiming&)> onResourceLoaded;
+
+		static const UINT64 DEFAULT_LOAD_MEMORY_BUDGET;
+
 	private:
+		struct LoadRequest;
+		typedef std::shared_ptr<LoadRequest> LoadRequestPtr;
+
+		/**
+		 * @brief	Information about a resource that is being loaded.
+		 */
+		struct LoadRequest
+		{
+			HResource resource;
+			Path filePath;
+			ResourcePackagePtr package;
+			TaskPtr task; /**< Null if the resource is being loaded synchronously. */
+			TaskPriority priority;
+			UINT64 size;
+			UINT64 requestTime;
+			UINT64 sequence; /**< Determines load order between requests of the same priority. Dependencies always have a lower sequence. */
+			bool scheduled; /**< True if the load was started and is counted against the memory budget. */
+			Vector<LoadRequestPtr> dependencies;
+		};
+
 		/**
 		 * @brief	Starts resource loading or returns an already loaded resource.
 		 */
-		HResource loadInternal(const Path& filePath, bool synchronous);
+		HResource loadInternal(const Path& filePath, bool synchronous, TaskPriority priority);
+
+		/**
+		 * @brief	Starts loading of the resource with the specified UUID, or returns an already loaded resource.
+		 *			Resource is loaded from a registered package if one contains it, or from the provided file
+		 *			path otherwise.
+		 */
+		HResource loadInternal(const String& uuid, const Path& filePath, bool synchronous, TaskPriority priority);
+
+		/**
+		 * @brief	Creates a load request for the resource and starts asynchronous loads of all its dependencies.
+		 *			Returns null if the resource doesn't exist.
+		 *
+		 * @note	Caller must hold the in progress resources lock.
+		 */
+		LoadRequestPtr createLoadRequest(const String& uuid, const Path& filePath, TaskPriority priority);
+
+		/**
+		 * @brief	Queues an asynchronous load of the resource, or returns an existing request if the
+		 *			resource is already being loaded. Returns null if the resource is already loaded or 
+		 *			doesn't exist.
+		 *
+		 * @note	Caller must hold the in progress resources lock.
+		 */
+		LoadRequestPtr queueAsyncLoad(const String& uuid, const Path& filePath, TaskPriority priority);
+
+		/**
+		 * @brief	Raises the priority of a load request and all of its dependencies.
+		 *
+		 * @note	Caller must hold the in progress resources lock.
+		 */
+		void raisePriority(const LoadRequestPtr& request, TaskPriority priority);
+
+		/**
+		 * @brief	Inserts the request in the pending load queue, ordered by priority.
+		 *
+		 * @note	Caller must hold the in progress resources lock.
+		 */
+		void insertPendingLoad(const LoadRequestPtr& request);
+
+		/**
+		 * @brief	Removes the request from the pending load queue.
+		 *
+		 * @note	Caller must hold the in progress resources lock.
+		 */
+		void removePendingLoad(const LoadRequestPtr& request);
+
+		/**
+		 * @brief	Counts the request against the memory budget and queues its task in the task scheduler.
+		 *
+		 * @note	Caller must hold the in progress resources lock.
+		 */
+		void scheduleLoad(const LoadRequestPtr& request);
+
+		/**
+		 * @brief	Starts the request and all its dependencies that haven't been started yet, regardless of
+		 *			the memory budget.
+		 *
+		 * @note	Caller must hold the in progress resources lock.
+		 */
+		void forceScheduleLoad(const LoadRequestPtr& request);
+
+		/**
+		 * @brief	Starts pending loads in priority order, for as long as they fit in the memory budget.
+		 */
+		void processPendingLoads();
+
+		/**
+		 * @brief	Finds the path of the resource with the specified UUID in the registered manifests.
+		 *			Returns false if no manifest contains the resource.
+		 */
+		bool findFilePath(const String& uuid, Path& filePath) const;
+
+		/**
+		 * @brief	Returns the registered package containing the resource with the specified UUID,
+		 *			or null if no package contains it.
+		 */
+		ResourcePackagePtr findResourcePackage(const String& uuid) const;
 
 		/**
 		 * @brief	Performs actually reading and deserializing of the resource file. 
@@ -160,20 +336,39 @@ namespace BansheeEngine
 		 */
 		ResourcePtr loadFromDiskAndDeserialize(const Path& filePath);
 
+		/**
+		 * @brief	Deserializes a resource directly from the memory of a resource package.
+		 *			Called from various worker threads.
+		 */
+		ResourcePtr loadFromPackageAndDeserialize(const ResourcePackagePtr& package, const String& uuid);
+
 		/**
 		 * @brief	Callback triggered when the task manager is ready to process the loading task.
+		 *			If the request has a package the resource is loaded from it, otherwise it is 
+		 *			loaded from the request file path.
+		 */
+		void loadCallback(const LoadRequestPtr& request);
+
+		/**
+		 * @brief	Removes a request that finished loading, successfully or not, from the in progress resources
+		 *			and releases its memory budget.
 		 */
-		void loadCallback(const Path& filePath, HResource& resource);
+		void releaseLoadRequest(const LoadRequestPtr& request);
 
 	private:
 		Vector<ResourceManifestPtr> mResourceManifests;
 		ResourceManifestPtr mDefaultResourceManifest;
+		Vector<ResourcePackagePtr> mResourcePackages;
 
 		BS_MUTEX(mInProgressResourcesMutex);
 		BS_MUTEX(mLoadedResourceMutex);
 
 		UnorderedMap<String, HResource> mLoadedResources;
-		UnorderedMap<String, HResource> mInProgressResources; // Resources that are being asynchronously loaded
+		UnorderedMap<String, LoadRequestPtr> mInProgressResources; // Resources that are being loaded
+		Vector<LoadRequestPtr> mPendingLoads; // Loads waiting for memory budget, ordered by priority
+		UINT64 mLoadMemoryBudget;
+		UINT64 mLoadMemoryInFlight;
+		UINT64 mNextLoadSequence;
 	};
 
 	/**
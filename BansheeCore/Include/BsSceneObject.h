@@ -56,7 +56,7 @@ namespace BansheeEngine
 		/**
 		 * @brief	Gets the local position of the object.
 		 */
-		const Vector3& getPosition() const { return mPosition; }
+		Vector3 getPosition() const;
 
 		/**
 		 * @brief	Sets the world position of the object.
@@ -68,7 +68,7 @@ namespace BansheeEngine
 		 *
 		 * @note	Performance warning: This might involve updating the transforms if the transform is dirty.
 		 */
-		const Vector3& getWorldPosition() const;
+		Vector3 getWorldPosition() const;
 
 		/**
 		 * @brief	Sets the local rotation of the object.
@@ -78,7 +78,7 @@ namespace BansheeEngine
 		/**
 		 * @brief	Gets the local rotation of the object.
 		 */
-		const Quaternion& getRotation() const { return mRotation; }
+		Quaternion getRotation() const;
 
 		/**
 		 * @brief	Sets the world rotation of the object.
@@ -90,7 +90,7 @@ namespace BansheeEngine
 		 *
 		 * @note	Performance warning: This might involve updating the transforms if the transform is dirty.
 		 */
-		const Quaternion& getWorldRotation() const;
+		Quaternion getWorldRotation() const;
 
 		/**
 		 * @brief	Sets the local scale of the object.
@@ -100,14 +100,14 @@ namespace BansheeEngine
 		/**
 		 * @brief	Gets the local scale of the object.
 		 */
-		const Vector3& getScale() const { return mScale; }
+		Vector3 getScale() const;
 
 		/**
 		 * @brief	Gets world scale of the object.
 		 *
 		 * @note	Performance warning: This might involve updating the transforms if the transform is dirty.
 		 */
-		const Vector3& getWorldScale() const;
+		Vector3 getWorldScale() const;
 
 		/**
 		 * @brief	Orients the object so it is looking at the provided "location" (local space)
@@ -121,12 +121,12 @@ namespace BansheeEngine
 		 *
 		 * @note	Performance warning: This might involve updating the transforms if the transform is dirty.
 		 */
-		const Matrix4& getWorldTfrm() const;
+		Matrix4 getWorldTfrm() const;
 
 		/**
 		 * @brief	Gets the objects local transform matrix.
 		 */
-		const Matrix4& getLocalTfrm() const;
+		Matrix4 getLocalTfrm() const;
 
 		/**
 		 * @brief	Moves the object's position by the vector offset provided along world axes.
@@ -212,49 +212,20 @@ namespace BansheeEngine
 		 * @brief	Checks is the core dirty flag set. This is used by external systems 
 		 *			to know when internal data has changed and core thread potentially needs to be notified.
 		 */
-		bool _isCoreDirty() const { return mIsCoreDirtyFlags != 0; }
+		bool _isCoreDirty() const;
 
 		/**
 		 * @brief	Marks the core dirty flag as clean.
 		 */
-		void _markCoreClean() { mIsCoreDirtyFlags = 0; }
-
-	private:
-		Vector3 mPosition;
-		Quaternion mRotation;
-		Vector3 mScale;
-
-		mutable Vector3 mWorldPosition;
-		mutable Quaternion mWorldRotation;
-		mutable Vector3 mWorldScale;
-
-		mutable Matrix4 mCachedLocalTfrm;
-		mutable bool mIsCachedLocalTfrmUpToDate;
-
-		mutable Matrix4 mCachedWorldTfrm;
-		mutable bool mIsCachedWorldTfrmUpToDate;
-
-		mutable UINT32 mIsCoreDirtyFlags;
-
-		/**
-		 * @brief	Marks the transform as dirty so that we know to update
-		 *			it when the transform is requested.
-		 */
-		void markTfrmDirty() const;
+		void _markCoreClean();
 
 		/**
-		 * @brief	Updates the local transform. Normally just reconstructs the 
-		 *			transform matrix from the position/rotation/scale.
+		 * @brief	Returns the identifier of the object's transform in the TransformManager.
 		 */
-		void updateLocalTfrm() const;
+		UINT32 _getTransformId() const { return mTransformId; }
 
-		/**
-		 * @brief	Updates the world transform. Reconstructs the local transform
-		 *			matrix and multiplies it with any parent transforms.
-		 *
-		 * @note	If parent transforms are dirty they will be updated.
-		 */
-		void updateWorldTfrm() const;
+	private:
+		UINT32 mTransformId;
 
 		/************************************************************************/
 		/* 								Hierarchy	                     		*/
@@ -301,6 +272,9 @@ namespace BansheeEngine
 
 		/**
 		 * @brief	Makes a deep copy of this object.
+		 *
+		 * @note	When making many copies of the same object use SceneObjectPrototype instead, as
+		 *			it avoids serializing the object on every copy.
 		 */
 		HSceneObject clone();
 
@@ -348,6 +322,7 @@ namespace BansheeEngine
 			mComponents.push_back(newComponent);
 
 			gSceneManager().notifyComponentAdded(newComponent);	
+			gSceneManager().registerComponentUpdate(newComponent.get());
 
 			return newComponent;
 		}
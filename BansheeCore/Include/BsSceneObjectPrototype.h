@@ -0,0 +1,155 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsGameObject.h"
+
+namespace BansheeEngine
+{
+	struct RTTIField;
+	struct RTTIReflectableFieldBase;
+
+	/**
+	 * @brief	Flattened copy of a SceneObject hierarchy that can be used for quickly creating
+	 *			many copies of the hierarchy (e.g. projectiles or crowd agents).
+	 *
+	 *			The hierarchy is walked through RTTI once when the prototype is created, recording
+	 *			the type of every object, the values of all plain and data block fields in a single
+	 *			buffer, and references between objects as indices. Game object handles pointing to
+	 *			objects within the hierarchy are stored as indices as well, so new instances can have
+	 *			their handles resolved directly instead of going through GameObjectManager ID mapping.
+	 *
+	 *			Instantiating a prototype produces the same result as SceneObject::clone, but skips
+	 *			encoding and parsing of serialized data.
+	 *
+	 * @note	Prototype is a snapshot and doesn't reflect any changes made to the source hierarchy after
+	 *			it was created. Source hierarchy may be destroyed while the prototype is still in use.
+	 *
+	 *			Sim thread only.
+	 */
+	class BS_CORE_EXPORT SceneObjectPrototype
+	{
+		/**
+		 * @brief	Determines how an object in the prototype is created.
+		 */
+		enum class ObjectKind
+		{
+			Pointer, /**< Object referenced through a shared pointer, created before any fields are assigned. */
+			Value, /**< Object stored by value in a field of another object, created when the field is assigned. */
+			Handle /**< Game object handle, resolved directly instead of through RTTI. */
+		};
+
+		/**
+		 * @brief	Single object recorded in the prototype.
+		 */
+		struct ObjectEntry
+		{
+			ObjectKind kind;
+			RTTITypeBase* type;
+			UINT32 firstClass; /**< Index of the entry for the most derived class of the object. */
+			UINT32 numClasses;
+
+			UINT64 handleId; /**< Instance ID the handle pointed to in the source hierarchy, if the object is a handle. */
+			INT32 handleTarget; /**< Index of the object the handle points to, or -1 if the object is outside of the hierarchy. */
+		};
+
+		/**
+		 * @brief	Fields recorded for one class in the inheritance chain of an object.
+		 */
+		struct ClassEntry
+		{
+			RTTITypeBase* type;
+			UINT32 firstField;
+			UINT32 numFields;
+		};
+
+		/**
+		 * @brief	Recorded value of a single field.
+		 */
+		struct FieldEntry
+		{
+			RTTIField* field;
+			UINT32 numElements; /**< Number of array elements, or size of the data block in bytes. */
+			UINT32 offset; /**< Offset into the data buffer for plain and data block fields, or into reference list otherwise. */
+		};
+
+	public:
+		/**
+		 * @brief	Records the provided hierarchy into a new prototype.
+		 */
+		SceneObjectPrototype(const HSceneObject& root);
+
+		/**
+		 * @brief	Creates a new copy of the recorded hierarchy and returns its root.
+		 */
+		HSceneObject instantiate() const;
+
+		/**
+		 * @brief	Creates multiple copies of the recorded hierarchy at once.
+		 *
+		 * @param	count	Number of copies to create.
+		 * @param	output	Vector that the roots of the new hierarchies will be appended to.
+		 */
+		void instantiate(UINT32 count, Vector<HSceneObject>& output) const;
+
+		/**
+		 * @brief	Returns the number of objects (scene objects, components and any other
+		 *			objects they reference) created per instance.
+		 */
+		UINT32 getNumObjects() const { return (UINT32)mPointerObjects.size(); }
+
+	private:
+		/**
+		 * @brief	Adds a new entry for the provided object, without recording its fields.
+		 */
+		UINT32 addObject(IReflectable* object, ObjectKind kind);
+
+		/**
+		 * @brief	Records an object stored by value in a field of another object, and returns its index.
+		 */
+		UINT32 recordValue(IReflectable& value);
+
+		/**
+		 * @brief	Records values of all fields of the object, including fields of all of its base classes.
+		 */
+		void recordFields(UINT32 objectIdx, IReflectable* object);
+
+		/**
+		 * @brief	Returns the index of an object referenced through a pointer, queuing it
+		 *			for recording if it wasn't encountered before. Returns -1 for null.
+		 */
+		INT32 findOrQueuePointer(const std::shared_ptr<IReflectable>& object);
+
+		/**
+		 * @brief	Creates a single instance of the hierarchy. Objects are output in the
+		 *			provided vector which must be sized to fit all objects in the prototype.
+		 */
+		void instantiateInternal(Vector<std::shared_ptr<IReflectable>>& objects, Vector<bool>& assigned) const;
+
+		/**
+		 * @brief	Assigns all recorded fields to an already created object.
+		 */
+		void assignFields(UINT32 objectIdx, Vector<std::shared_ptr<IReflectable>>& objects, Vector<bool>& assigned) const;
+
+		/**
+		 * @brief	Creates an object to be stored by value in the specified field and assigns its fields.
+		 */
+		std::shared_ptr<IReflectable> createValue(UINT32 objectIdx, RTTIReflectableFieldBase* field,
+			Vector<std::shared_ptr<IReflectable>>& objects, Vector<bool>& assigned) const;
+
+		Vector<ObjectEntry> mObjects;
+		Vector<ClassEntry> mClasses;
+		Vector<FieldEntry> mFields;
+		Vector<INT32> mReferences;
+		Vector<UINT8> mData;
+
+		Vector<UINT32> mPointerObjects; /**< Indices of objects referenced through pointers, starting with the root. */
+
+		// Only used while recording
+		UnorderedMap<IReflectable*, UINT32> mPointerLookup;
+		UnorderedMap<UINT64, UINT32> mGameObjectLookup;
+		Vector<std::shared_ptr<IReflectable>> mRecordQueue;
+	};
+}
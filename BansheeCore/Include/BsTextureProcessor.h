@@ -0,0 +1,65 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsPixelUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Time spent in individual stages of TextureProcessor::process, in milliseconds.
+	 */
+	struct TextureProcessingTimings
+	{
+		float conversion = 0.0f; /**< Converting the source to the working format, and the working format to the output formats. */
+		float mipmapGeneration = 0.0f; /**< Downsampling the working format into lower mip levels. */
+		float compression = 0.0f; /**< Compressing mip levels into block compressed output formats. */
+		float total = 0.0f; /**< Time spent in the entire call, including any work not covered by the stages above. */
+	};
+
+	/**
+	 * @brief	Generates mip maps and converts and compresses pixel data, splitting the work into
+	 *			tiles processed in parallel by TaskScheduler workers.
+	 *
+	 *			Mip levels are generated in an intermediate working format (8-bit BGRA for integer
+	 *			sources, 32-bit float RGBA for float sources), using the filter and the wrap mode from
+	 *			MipMapGenOptions, with support for non power of two sizes. Only two working buffers are
+	 *			allocated regardless of the number of mip levels, as each level is written to the output
+	 *			as soon as it is generated and its buffer then reused for the next level but one.
+	 *
+	 *			Block compressed outputs are compressed in horizontal strips that are four pixel aligned,
+	 *			so the result is the same as compressing the entire level at once.
+	 */
+	class BS_CORE_EXPORT TextureProcessor
+	{
+	public:
+		/**
+		 * @brief	Generates mip levels for the source and writes them into the provided output buffers.
+		 *
+		 * @param	src					Source pixel data. Must be a 2D image in an uncompressed format.
+		 * @param	output				Output buffers, one per mip level starting with the source level itself,
+		 *								each with an allocated buffer. Every level is halved in size (rounded down,
+		 *								at least one) compared to the previous level. Outputs may use any format,
+		 *								including compressed formats supported by PixelUtil::compress.
+		 * @param	mipOptions			Options controlling mip generation.
+		 * @param	compressionOptions	Options used for outputs in a compressed format. Format field is ignored
+		 *								and the format of each individual output is used instead.
+		 * @param	timings				Optional structure that receives time spent in each processing stage.
+		 */
+		static void process(const PixelData& src, const Vector<PixelDataPtr>& output, const MipMapGenOptions& mipOptions,
+			const CompressionOptions& compressionOptions, TextureProcessingTimings* timings = nullptr);
+
+	private:
+		/**
+		 * @brief	Maximum number of rows processed by a single task when converting and downsampling.
+		 */
+		static const UINT32 TILE_HEIGHT;
+
+		/**
+		 * @brief	Maximum number of rows compressed by a single task. Must be a multiple of four.
+		 */
+		static const UINT32 COMPRESSION_STRIP_HEIGHT;
+	};
+}
@@ -0,0 +1,211 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsModule.h"
+#include "BsMatrix4.h"
+#include "BsVector3.h"
+#include "BsQuaternion.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Stores transforms of all scene objects and keeps their world transforms up to date.
+	 *
+	 *			Transform data is stored in contiguous arrays, one per transform property, sorted by
+	 *			depth in the hierarchy so parents always come before their children. This allows all dirty
+	 *			transforms to be updated in a single linear pass, and each depth level to be updated in parallel.
+	 *
+	 *			Transforms are referenced by identifiers that don't change when the arrays are reordered.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_CORE_EXPORT TransformManager : public Module<TransformManager>
+	{
+		/**
+		 * @brief	Hierarchy links of a single transform, indexed by transform identifier.
+		 */
+		struct Node
+		{
+			UINT32 index; /**< Index of the transform in the data arrays. */
+			UINT32 parent;
+			UINT32 firstChild;
+			UINT32 prevSibling;
+			UINT32 nextSibling;
+		};
+
+		/**
+		 * @brief	Flags signaling which parts of a transform need to be recalculated.
+		 */
+		enum DirtyFlags
+		{
+			LocalDirty = 0x01,
+			WorldDirty = 0x02
+		};
+
+	public:
+		static const UINT32 INVALID_ID = 0xFFFFFFFF;
+
+		TransformManager();
+
+		/**
+		 * @brief	Creates a new identity transform at the top of the hierarchy. Returns the transform identifier.
+		 */
+		UINT32 create();
+
+		/**
+		 * @brief	Destroys the transform with the specified identifier. Any children it has are moved
+		 *			to the top of the hierarchy.
+		 */
+		void destroy(UINT32 id);
+
+		/**
+		 * @brief	Changes the parent of the transform. Use INVALID_ID to move the transform to the top of the hierarchy.
+		 */
+		void setParent(UINT32 id, UINT32 parentId);
+
+		/**
+		 * @brief	Sets the local position of the transform.
+		 */
+		void setPosition(UINT32 id, const Vector3& position);
+
+		/**
+		 * @brief	Sets the local rotation of the transform.
+		 */
+		void setRotation(UINT32 id, const Quaternion& rotation);
+
+		/**
+		 * @brief	Sets the local scale of the transform.
+		 */
+		void setScale(UINT32 id, const Vector3& scale);
+
+		/**
+		 * @brief	Returns the local position of the transform.
+		 */
+		const Vector3& getPosition(UINT32 id) const { return mPositions[mNodes[id].index]; }
+
+		/**
+		 * @brief	Returns the local rotation of the transform.
+		 */
+		const Quaternion& getRotation(UINT32 id) const { return mRotations[mNodes[id].index]; }
+
+		/**
+		 * @brief	Returns the local scale of the transform.
+		 */
+		const Vector3& getScale(UINT32 id) const { return mScales[mNodes[id].index]; }
+
+		/**
+		 * @brief	Returns the world position of the transform, updating it first if it is dirty.
+		 */
+		const Vector3& getWorldPosition(UINT32 id);
+
+		/**
+		 * @brief	Returns the world rotation of the transform, updating it first if it is dirty.
+		 */
+		const Quaternion& getWorldRotation(UINT32 id);
+
+		/**
+		 * @brief	Returns the world scale of the transform, updating it first if it is dirty.
+		 */
+		const Vector3& getWorldScale(UINT32 id);
+
+		/**
+		 * @brief	Returns the local transform matrix, updating it first if it is dirty.
+		 */
+		const Matrix4& getLocalTfrm(UINT32 id);
+
+		/**
+		 * @brief	Returns the world transform matrix, updating it first if it is dirty.
+		 */
+		const Matrix4& getWorldTfrm(UINT32 id);
+
+		/**
+		 * @brief	Updates the transform and any of its parents if they are dirty.
+		 */
+		void updateIfDirty(UINT32 id);
+
+		/**
+		 * @brief	Updates all dirty transforms. Depth levels with many transforms are updated in parallel
+		 *			using the task scheduler.
+		 */
+		void updateAll();
+
+		/**
+		 * @brief	Checks if the transform changed since it was last marked as clean using "markCoreClean".
+		 */
+		bool isCoreDirty(UINT32 id) const;
+
+		/**
+		 * @brief	Clears the core dirty flags of the transform.
+		 */
+		void markCoreClean(UINT32 id) { mCoreDirtyFlags[mNodes[id].index] = 0; }
+
+		/**
+		 * @brief	Returns the number of live transforms.
+		 */
+		UINT32 getNumTransforms() const { return (UINT32)mNodes.size() - (UINT32)mFreeIds.size(); }
+
+		/**
+		 * @brief	Returns the number of transforms updated by the last call to "updateAll".
+		 */
+		UINT32 getNumUpdatedLastFrame() const { return mNumUpdatedLastFrame; }
+
+	private:
+		/**
+		 * @brief	Marks the local transform dirty and propagates the world dirty flag to all children.
+		 */
+		void markDirty(UINT32 id, bool localChanged);
+
+		/**
+		 * @brief	Marks the world transform dirty for the transform and all of its children. Children
+		 *			of transforms that are already dirty are guaranteed to be dirty as well.
+		 */
+		void markWorldDirty(UINT32 id);
+
+		/**
+		 * @brief	Recalculates the transform at the specified index, along with any dirty parents.
+		 */
+		void updateRecursive(UINT32 idx);
+
+		/**
+		 * @brief	Recalculates the transform at the specified index. Parent transform must be up to date.
+		 */
+		void updateEntry(UINT32 idx);
+
+		/**
+		 * @brief	Reorders the data arrays so they are sorted by hierarchy depth, and removes entries
+		 *			of destroyed transforms.
+		 */
+		void rebuildOrder();
+
+		/**
+		 * @brief	Removes the transform from its parent's list of children.
+		 */
+		void unlinkFromParent(UINT32 id);
+
+		// Hierarchy, indexed by identifier
+		Vector<Node> mNodes;
+		Vector<UINT32> mFreeIds;
+
+		// Transform data, indexed by depth sorted index
+		Vector<Vector3> mPositions;
+		Vector<Quaternion> mRotations;
+		Vector<Vector3> mScales;
+		Vector<Vector3> mWorldPositions;
+		Vector<Quaternion> mWorldRotations;
+		Vector<Vector3> mWorldScales;
+		Vector<Matrix4> mLocalTfrms;
+		Vector<Matrix4> mWorldTfrms;
+		Vector<UINT32> mParents; /**< Index of the parent, or INVALID_ID. */
+		Vector<UINT32> mIds; /**< Identifier of the transform, or INVALID_ID for destroyed transforms. */
+		Vector<UINT8> mDirtyFlags;
+		Vector<UINT32> mCoreDirtyFlags;
+
+		Vector<UINT32> mLevelOffsets; /**< Index of the first transform of each depth level, followed by the number of transforms. */
+		bool mIsOrderDirty;
+		bool mIsAnyDirty;
+		UINT32 mNumUpdatedLastFrame;
+	};
+}
@@ -0,0 +1,35 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Static class containing various utility methods that do not
+	 *			fit anywhere else.
+	 */
+	class BS_CORE_EXPORT Utility
+	{
+	public:
+		/**
+		 * @brief	Finds UUIDs of all resources referenced by the provided object, by searching
+		 *			through its serializable fields.
+		 *
+		 * @note	Objects contained in the provided object are searched as well, but referenced
+		 *			resources are not, so only direct dependencies are returned.
+		 */
+		static Vector<String> findResourceDependencies(IReflectable& object);
+
+	private:
+		/**
+		 * @brief	Helper method for recursion when finding resource dependencies.
+		 *
+		 * @see		findResourceDependencies
+		 */
+		static void findResourceDependenciesInternal(IReflectable& object, UnorderedSet<std::shared_ptr<IReflectable>>& visitedObjects, 
+			UnorderedSet<String>& dependencies);
+	};
+}
@@ -0,0 +1,152 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsCommandBuffer.h"
+#include "BsDebug.h"
+
+namespace BansheeEngine
+{
+	CommandBuffer::CommandBuffer(UINT32 chunkSize)
+		:mActiveChunk(0), mChunkSize(align(chunkSize)), mNumCommands(0), mNumBytes(0)
+	{ }
+
+	CommandBuffer::~CommandBuffer()
+	{
+		clear();
+
+		for (auto& chunk : mChunks)
+			bs_free(chunk.memory);
+	}
+
+	CommandPacket* CommandBuffer::allocPacket(UINT32 size)
+	{
+		while (mActiveChunk < (UINT32)mChunks.size())
+		{
+			Chunk& chunk = mChunks[mActiveChunk];
+			if ((chunk.size - chunk.used) >= size)
+				break;
+
+			mActiveChunk++;
+		}
+
+		if (mActiveChunk == (UINT32)mChunks.size())
+		{
+			Chunk newChunk;
+			newChunk.size = std::max(size, mChunkSize);
+			newChunk.used = 0;
+			newChunk.memory = (UINT8*)bs_alloc(newChunk.size + PACKET_ALIGNMENT - 1);
+			newChunk.data = (UINT8*)(((UINT64)newChunk.memory + PACKET_ALIGNMENT - 1) & ~(UINT64)(PACKET_ALIGNMENT - 1));
+
+			mChunks.push_back(newChunk);
+		}
+
+		Chunk& chunk = mChunks[mActiveChunk];
+		CommandPacket* packet = (CommandPacket*)(chunk.data + chunk.used);
+		chunk.used += size;
+
+		mNumCommands++;
+		mNumBytes += size;
+
+		return packet;
+	}
+
+	void CommandBuffer::execute(std::function<void(UINT32)> notifyCallback)
+	{
+		for (auto& chunk : mChunks)
+		{
+			UINT32 offset = 0;
+			while (offset < chunk.used)
+			{
+				CommandPacket* packet = (CommandPacket*)(chunk.data + offset);
+				packet->execute(packet);
+
+				if (packet->notifyWhenComplete && notifyCallback != nullptr)
+					notifyCallback(packet->callbackId);
+
+				packet->destroy(packet);
+				offset += packet->size;
+			}
+
+			chunk.used = 0;
+		}
+
+		mActiveChunk = 0;
+		mNumCommands = 0;
+		mNumBytes = 0;
+	}
+
+	void CommandBuffer::clear()
+	{
+		for (auto& chunk : mChunks)
+		{
+			UINT32 offset = 0;
+			while (offset < chunk.used)
+			{
+				CommandPacket* packet = (CommandPacket*)(chunk.data + offset);
+				packet->destroy(packet);
+
+				offset += packet->size;
+			}
+
+			chunk.used = 0;
+		}
+
+		mActiveChunk = 0;
+		mNumCommands = 0;
+		mNumBytes = 0;
+	}
+
+	void CommandBuffer::resolveAsyncOp(AsyncOp& op)
+	{
+		if (!op.hasCompleted())
+		{
+			LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+				"Make sure to complete the operation before returning from the command callback method.");
+			op._completeOperation(nullptr);
+		}
+	}
+
+	CommandBufferPool::CommandBufferPool(UINT32 chunkSize)
+		:mChunkSize(chunkSize)
+	{ }
+
+	CommandBufferPool::~CommandBufferPool()
+	{
+		for (auto& buffer : mAllBuffers)
+			bs_delete(buffer);
+	}
+
+	CommandBuffer* CommandBufferPool::acquire()
+	{
+		mLock.lock();
+
+		CommandBuffer* buffer = nullptr;
+		if (!mFreeBuffers.empty())
+		{
+			buffer = mFreeBuffers.top();
+			mFreeBuffers.pop();
+		}
+
+		mLock.unlock();
+
+		if (buffer == nullptr)
+		{
+			buffer = bs_new<CommandBuffer>(mChunkSize);
+
+			mLock.lock();
+			mAllBuffers.push_back(buffer);
+			mLock.unlock();
+		}
+
+		return buffer;
+	}
+
+	void CommandBufferPool::release(CommandBuffer* buffer)
+	{
+		buffer->clear();
+
+		mLock.lock();
+		mFreeBuffers.push(buffer);
+		mLock.unlock();
+	}
+}
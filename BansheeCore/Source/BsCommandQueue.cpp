@@ -13,7 +13,7 @@ namespace BansheeEngine
 	CommandQueueBase::CommandQueueBase(BS_THREAD_ID_TYPE threadId)
 		:mMyThreadId(threadId), mMaxDebugIdx(0)
 	{
-		mCommands = bs_new<BansheeEngine::Queue<QueuedCommand>, PoolAlloc>();
+		mCommands = mCommandBuffers.acquire();
 
 		{
 			BS_LOCK_MUTEX(CommandQueueBreakpointMutex);
@@ -25,139 +25,63 @@ namespace BansheeEngine
 	CommandQueueBase::CommandQueueBase(BS_THREAD_ID_TYPE threadId)
 		:mMyThreadId(threadId)
 	{
-		mCommands = bs_new<BansheeEngine::Queue<QueuedCommand>, PoolAlloc>();
+		mCommands = mCommandBuffers.acquire();
 	}
 #endif
 
 	CommandQueueBase::~CommandQueueBase()
 	{
 		if(mCommands != nullptr)
-			bs_delete(mCommands);
-
-		while(!mEmptyCommandQueues.empty())
-		{
-			bs_delete(mEmptyCommandQueues.top());
-			mEmptyCommandQueues.pop();
-		}
-	}
-
-	AsyncOp CommandQueueBase::queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
-	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
-
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
-#endif
-
-		mCommands->push(newCommand);
-
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
-
-		return *newCommand.asyncOp;
-	}
-
-	void CommandQueueBase::queue(std::function<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
-	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
-
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
-#endif
-
-		mCommands->push(newCommand);
-
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
+			mCommandBuffers.release(mCommands);
 	}
 
-	BansheeEngine::Queue<QueuedCommand>* CommandQueueBase::flush()
+	CommandBuffer* CommandQueueBase::flush()
 	{
-		BansheeEngine::Queue<QueuedCommand>* oldCommands = mCommands;
-
-		if(!mEmptyCommandQueues.empty())
-		{
-			mCommands = mEmptyCommandQueues.top();
-			mEmptyCommandQueues.pop();
-		}
-		else
-		{
-			mCommands = bs_new<BansheeEngine::Queue<QueuedCommand>, PoolAlloc>();
-		}
+		CommandBuffer* oldCommands = mCommands;
+		mCommands = mCommandBuffers.acquire();
 
 		return oldCommands;
 	}
 
-	void CommandQueueBase::playbackWithNotify(BansheeEngine::Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback)
+	void CommandQueueBase::playbackWithNotify(CommandBuffer* commands, std::function<void(UINT32)> notifyCallback)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
 		if(commands == nullptr)
 			return;
 
-		while(!commands->empty())
-		{
-			QueuedCommand& command = commands->front();
-
-			if(command.returnsValue)
-			{
-				AsyncOp& op = *command.asyncOp;
-				command.callbackWithReturnValue(op);
-
-				if(!command.asyncOp->hasCompleted())
-				{
-					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
-						"Make sure to complete the operation before returning from the command callback method.");
-					command.asyncOp->_completeOperation(nullptr);
-				}
-			}
-			else
-			{
-				command.callback();
-			}
-
-			if(command.notifyWhenComplete && notifyCallback != nullptr)
-			{
-				notifyCallback(command.callbackId);
-			}
-
-			commands->pop();
-		}
-
-		mEmptyCommandQueues.push(commands);
+		commands->execute(notifyCallback);
+		mCommandBuffers.release(commands);
 	}
 
-	void CommandQueueBase::playback(BansheeEngine::Queue<QueuedCommand>* commands)
+	void CommandQueueBase::playback(CommandBuffer* commands)
 	{
 		playbackWithNotify(commands, std::function<void(UINT32)>());
 	}
 
 	void CommandQueueBase::cancelAll()
 	{
-		BansheeEngine::Queue<QueuedCommand>* commands = flush();
-
-		while(!commands->empty())
-			commands->pop();
-
-		mEmptyCommandQueues.push(commands);
+		mCommands->clear();
 	}
 
 	bool CommandQueueBase::isEmpty()
 	{
-		if(mCommands != nullptr && mCommands->size() > 0)
+		if(mCommands != nullptr && !mCommands->isEmpty())
 			return false;
 
 		return true;
 	}
 
+	UINT32 CommandQueueBase::getNumCommands() const
+	{
+		return mCommands->getNumCommands();
+	}
+
+	UINT32 CommandQueueBase::getNumBytes() const
+	{
+		return mCommands->getNumBytes();
+	}
+
 	void CommandQueueBase::throwInvalidThreadException(const String& message) const
 	{
 		BS_EXCEPT(InternalErrorException, message);
@@ -8,7 +8,7 @@
 namespace BansheeEngine
 {
 	Component::Component(const HSceneObject& parent)
-		:mParent(parent)
+		:mParent(parent), mUpdateMode(ComponentUpdateMode::Serial), mUpdateIdx((UINT32)-1)
 	{
 		setName("Component");
 	}
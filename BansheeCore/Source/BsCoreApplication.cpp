@@ -41,6 +41,8 @@
 #include "BsTaskScheduler.h"
 #include "BsUUID.h"
 #include "BsRenderStats.h"
+#include "BsTransformManager.h"
+#include "BsTimer.h"
 
 #include "BsMaterial.h"
 #include "BsShader.h"
@@ -52,9 +54,12 @@
 namespace BansheeEngine
 {
 	CoreApplication::CoreApplication(START_UP_DESC& desc)
-		:mPrimaryWindow(nullptr), mIsFrameRenderingFinished(true), mRunMainLoop(false), 
-		mSceneManagerPlugin(nullptr), mRendererPlugin(nullptr)
+		:mPrimaryWindow(nullptr), mRunMainLoop(false), mSceneManagerPlugin(nullptr), mRendererPlugin(nullptr),
+		mMaxFramesInFlight(1), mNumQueuedFrames(0), mNumFinishedFrames(0), mSimThreadWaiting(false),
+		mCoreFrameTimer(nullptr), mCorePacingTime(0)
 	{
+		mCoreFrameTimer = bs_new<Timer>();
+
 		UINT32 numWorkerThreads = BS_THREAD_HARDWARE_CONCURRENCY - 1; // Number of cores while excluding current thread.
 
 		Platform::_startUp();
@@ -74,6 +79,7 @@ namespace BansheeEngine
 		DynLibManager::startUp();
 		CoreObjectManager::startUp();
 		GameObjectManager::startUp();
+		TransformManager::startUp();
 		Resources::startUp();
 		GpuProgramManager::startUp();
 		RenderSystemManager::startUp();
@@ -122,6 +128,7 @@ namespace BansheeEngine
 
 		GpuProgramManager::shutDown();
 		Resources::shutDown();
+		TransformManager::shutDown();
 		GameObjectManager::shutDown();
 
 		// All CoreObject related modules should be shut down now. They have likely queued CoreObjects for destruction, so
@@ -143,7 +150,11 @@ namespace BansheeEngine
 		ProfilerCPU::shutDown();
 		UUIDGenerator::shutDown();
 
+		bs_delete(mCoreFrameTimer);
+
 		MemStack::endThread();
+		MemoryAllocator<PoolAlloc>::endThread();
+		MemoryAllocator<ScratchAlloc>::endThread();
 		Platform::_shutDown();
 	}
 
@@ -171,27 +182,28 @@ namespace BansheeEngine
 
 			PROFILE_CALL(RendererManager::instance().getActive()->renderAll(), "Render");
 
-			// Core and sim thread run in lockstep. This will result in a larger input latency than if I was 
-			// running just a single thread. Latency becomes worse if the core thread takes longer than sim 
-			// thread, in which case sim thread needs to wait. Optimal solution would be to get an average 
-			// difference between sim/core thread and start the sim thread a bit later so they finish at nearly the same time.
-			{
-				BS_LOCK_MUTEX_NAMED(mFrameRenderingFinishedMutex, lock);
-
-				while(!mIsFrameRenderingFinished)
-				{
-					TaskScheduler::instance().addWorker();
-					BS_THREAD_WAIT(mFrameRenderingFinishedCondition, mFrameRenderingFinishedMutex, lock);
-					TaskScheduler::instance().removeWorker();
-				}
+			// Sim thread may run up to mMaxFramesInFlight frames ahead of the core thread. Each additional frame
+			// in flight adds a frame of input latency, but lets the threads overlap better if the core thread takes 
+			// longer than the sim thread, or if frame times vary.
+			UINT64 waitStart = gTime().getTimePrecise();
+			waitUntilFramesFinished(mMaxFramesInFlight);
+			UINT64 waitEnd = gTime().getTimePrecise();
 
-				mIsFrameRenderingFinished = false;
-			}
+			mFramePipelineStats.simWaitTime = (waitEnd - waitStart) / 1000.0f;
+			mFramePipelineStats.coreWaitTime = gCoreThread().getIdleTimeLastFrame() / 1000.0f;
+			mFramePipelineStats.corePacingTime = mCorePacingTime.load() / 1000.0f;
+			mFramePipelineStats.frameAllocUsage = gCoreThread().getFrameAllocUsageLastFrame();
+			mFramePipelineStats.frameAllocPeakUsage = gCoreThread().getFrameAllocPeakUsage();
+			mFramePipelineStats.frameAllocAverageUsage = gCoreThread().getFrameAllocAverageUsage();
 
 			gCoreThread().queueCommand(&Platform::_coreUpdate);
 			gCoreThread().submitAccessors();
 			gCoreThread().queueCommand(std::bind(&CoreApplication::endCoreProfiling, this));
 			gCoreThread().queueCommand(std::bind(&CoreApplication::frameRenderingFinishedCallback, this));
+			mNumQueuedFrames++;
+
+			// Sampled once the frame is queued so it counts the frame just submitted
+			mFramePipelineStats.framesInFlight = mNumQueuedFrames - mNumFinishedFrames.load();
 
 			gProfilerCPU().endThread();
 			gProfiler()._update();
@@ -209,12 +221,45 @@ namespace BansheeEngine
 		// a race condition we might run the loop one extra iteration which is acceptable
 	}
 
+	void CoreApplication::setMaxFramesInFlight(UINT32 numFrames)
+	{
+		mMaxFramesInFlight = Math::clamp(numFrames, 1U, CoreThread::MAX_FRAMES_IN_FLIGHT);
+	}
+
 	void CoreApplication::frameRenderingFinishedCallback()
 	{
-		BS_LOCK_MUTEX(mFrameRenderingFinishedMutex);
+		mCorePacingTime.store((UINT32)mCoreFrameTimer->getMicroseconds());
+		mCoreFrameTimer->reset();
+
+		mNumFinishedFrames++;
+
+		// Sim thread sets the flag before checking the counter, so only lock and notify when it might be waiting
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(mSimThreadWaiting.load())
+		{
+			BS_LOCK_MUTEX(mFrameRenderingFinishedMutex);
+			BS_THREAD_NOTIFY_ONE(mFrameRenderingFinishedCondition);
+		}
+	}
+
+	void CoreApplication::waitUntilFramesFinished(UINT32 maxFramesInFlight)
+	{
+		if((mNumQueuedFrames - mNumFinishedFrames.load()) < maxFramesInFlight)
+			return;
+
+		BS_LOCK_MUTEX_NAMED(mFrameRenderingFinishedMutex, lock);
+
+		mSimThreadWaiting.store(true);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		while((mNumQueuedFrames - mNumFinishedFrames.load()) >= maxFramesInFlight)
+		{
+			TaskScheduler::instance().addWorker();
+			BS_THREAD_WAIT(mFrameRenderingFinishedCondition, mFrameRenderingFinishedMutex, lock);
+			TaskScheduler::instance().removeWorker();
+		}
 
-		mIsFrameRenderingFinished = true;
-		BS_THREAD_NOTIFY_ONE(mFrameRenderingFinishedCondition);
+		mSimThreadWaiting.store(false);
 	}
 
 	void CoreApplication::beginCoreProfiling()
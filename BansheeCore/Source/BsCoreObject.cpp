@@ -151,7 +151,8 @@ namespace BansheeEngine
 		//  - We re-create the reference to the object by setting mThis pointer
 		//  - We queue the object to be destroyed so all of its GPU resources may be released on the core thread
 		//    - destroy() makes sure it keeps a reference of mThis so object isn't deleted
-		//    - Once the destroy() finishes the reference is removed and the default shared_ptr deleter is called
+		//    - Once the destroy() finishes the reference is removed and the object is deleted using the
+		//      allocator it was created with
 
 #if BS_DEBUG_MODE
 		if(obj->isScheduledToBeInitialized())
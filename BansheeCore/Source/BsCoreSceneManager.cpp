@@ -4,10 +4,15 @@
 #include "BsCoreSceneManager.h"
 #include "BsSceneObject.h"
 #include "BsComponent.h"
+#include "BsProfilerCPU.h"
+#include "BsTaskGroup.h"
 
 namespace BansheeEngine
 {
+	const UINT32 CoreSceneManager::PARALLEL_UPDATE_GRAIN_SIZE = 64;
+
 	CoreSceneManager::CoreSceneManager()
+		:mIsUpdating(false)
 	{
 		mRootNode = SceneObject::createInternal("SceneRoot");
 	}
@@ -16,27 +21,50 @@ namespace BansheeEngine
 	{
 		if(mRootNode != nullptr)
 			mRootNode->destroy();
+
+		for(auto& bucket : mComponentBuckets)
+			bs_delete(bucket);
 	}
 
 	void CoreSceneManager::_update()
 	{
-		Stack<HSceneObject> todo;
-		todo.push(mRootNode);
+		mIsUpdating = true;
 
-		while(!todo.empty())
+		// Components added during the update are appended to the buckets, so sizes are re-checked every iteration
+		for(UINT32 i = 0; i < (UINT32)mComponentBuckets.size(); i++)
 		{
-			HSceneObject currentGO = todo.top();
-			todo.pop();
-			                  
-			const Vector<HComponent>& components = currentGO->getComponents();
+			ComponentBucket* bucket = mComponentBuckets[i];
+
+			gProfilerCPU().beginSample(bucket->profilerName);
 
-			for(auto iter = components.begin(); iter != components.end(); ++iter)
+			if(bucket->isParallel)
+			{
+				parallelFor(0, (UINT32)bucket->components.size(), PARALLEL_UPDATE_GRAIN_SIZE, [&](UINT32 idx)
+				{
+					Component* component = bucket->components[idx];
+					if(component != nullptr)
+						component->update();
+				});
+			}
+			else
 			{
-				(*iter)->update();
+				for(UINT32 j = 0; j < (UINT32)bucket->components.size(); j++)
+				{
+					Component* component = bucket->components[j];
+					if(component != nullptr)
+						component->update();
+				}
 			}
 
-			for(UINT32 i = 0; i < currentGO->getNumChildren(); i++)
-				todo.push(currentGO->getChild(i));
+			gProfilerCPU().endSample(bucket->profilerName);
+		}
+
+		mIsUpdating = false;
+
+		for(auto& bucket : mComponentBuckets)
+		{
+			if(bucket->hasRemovedEntries)
+				compactBucket(*bucket);
 		}
 	}
 
@@ -49,6 +77,89 @@ namespace BansheeEngine
 	void CoreSceneManager::notifyComponentAdded(const HComponent& component) { }
 	void CoreSceneManager::notifyComponentRemoved(const HComponent& component) { }
 
+	void CoreSceneManager::registerComponentUpdate(Component* component)
+	{
+		ComponentUpdateMode updateMode = component->getUpdateMode();
+		if(updateMode == ComponentUpdateMode::None)
+			return;
+
+		UINT32 typeId = component->getRTTI()->getRTTIId();
+		bool isParallel = updateMode == ComponentUpdateMode::Parallel;
+
+		UINT64 bucketKey = ((UINT64)typeId << 1) | (isParallel ? 1 : 0);
+		auto iterFind = mComponentBucketLookup.find(bucketKey);
+
+		ComponentBucket* bucket = nullptr;
+		if(iterFind != mComponentBucketLookup.end())
+			bucket = mComponentBuckets[iterFind->second];
+		else
+		{
+			bucket = bs_new<ComponentBucket>();
+			bucket->typeId = typeId;
+			bucket->isParallel = isParallel;
+			bucket->profilerName = ("Update " + component->getRTTI()->getRTTIName()).c_str();
+			bucket->hasRemovedEntries = false;
+
+			mComponentBucketLookup[bucketKey] = (UINT32)mComponentBuckets.size();
+			mComponentBuckets.push_back(bucket);
+		}
+
+		component->mUpdateIdx = (UINT32)bucket->components.size();
+		bucket->components.push_back(component);
+	}
+
+	void CoreSceneManager::unregisterComponentUpdate(Component* component)
+	{
+		ComponentUpdateMode updateMode = component->getUpdateMode();
+		if(updateMode == ComponentUpdateMode::None)
+			return;
+
+		UINT32 typeId = component->getRTTI()->getRTTIId();
+		bool isParallel = updateMode == ComponentUpdateMode::Parallel;
+
+		UINT64 bucketKey = ((UINT64)typeId << 1) | (isParallel ? 1 : 0);
+		auto iterFind = mComponentBucketLookup.find(bucketKey);
+		assert(iterFind != mComponentBucketLookup.end());
+
+		ComponentBucket* bucket = mComponentBuckets[iterFind->second];
+		UINT32 idx = component->mUpdateIdx;
+		assert(idx < (UINT32)bucket->components.size() && bucket->components[idx] == component);
+
+		component->mUpdateIdx = (UINT32)-1;
+
+		// Can't move other components while they're being iterated over, so leave an empty entry that gets removed after the update
+		if(mIsUpdating)
+		{
+			bucket->components[idx] = nullptr;
+			bucket->hasRemovedEntries = true;
+		}
+		else
+		{
+			Component* lastComponent = bucket->components.back();
+			bucket->components[idx] = lastComponent;
+			bucket->components.pop_back();
+
+			if(lastComponent != component)
+				lastComponent->mUpdateIdx = idx;
+		}
+	}
+
+	void CoreSceneManager::compactBucket(ComponentBucket& bucket)
+	{
+		UINT32 numComponents = 0;
+		for(auto& component : bucket.components)
+		{
+			if(component == nullptr)
+				continue;
+
+			component->mUpdateIdx = numComponents;
+			bucket.components[numComponents++] = component;
+		}
+
+		bucket.components.resize(numComponents);
+		bucket.hasRemovedEntries = false;
+	}
+
 	CoreSceneManager& gSceneManager()
 	{
 		return CoreSceneManager::instance();
@@ -5,6 +5,7 @@
 #include "BsThreadPool.h"
 #include "BsTaskScheduler.h"
 #include "BsFrameAlloc.h"
+#include "BsTimer.h"
 
 using namespace std::placeholders;
 
@@ -14,16 +15,27 @@ namespace BansheeEngine
 
 	CoreThread::CoreThread()
 		: mCoreThreadShutdown(false)
-		, mCommandQueue(nullptr)
+		, mCommandBatches(nullptr)
+		, mCommandBufferPool(nullptr)
+		, mCoreThreadSleeping(false)
 		, mMaxCommandNotifyId(0)
 		, mSyncedCoreAccessor(nullptr)
 		, mActiveFrameAlloc(0)
+		, mNumCommands(0)
+		, mNumCommandBytes(0)
+		, mNumCommandBatches(0)
+		, mNumCommandsLastFrame(0)
+		, mNumCommandBytesLastFrame(0)
+		, mNumCommandBatchesLastFrame(0)
+		, mIdleTime(0)
+		, mIdleTimeLastFrame(0)
 	{
-		mFrameAllocs[0] = bs_new<FrameAlloc>();
-		mFrameAllocs[1] = bs_new<FrameAlloc>();
+		for(UINT32 i = 0; i < NUM_FRAME_ALLOCS; i++)
+			mFrameAllocs[i] = bs_new<FrameAlloc>();
 
 		mCoreThreadId = BS_THREAD_CURRENT_ID;
-		mCommandQueue = bs_new<CommandQueue<CommandQueueSync>>(BS_THREAD_CURRENT_ID);
+		mCommandBatches = bs_new<LockFreeRingBuffer<CommandBatch>>(MAX_QUEUED_BATCHES);
+		mCommandBufferPool = bs_new<CommandBufferPool>(SINGLE_COMMAND_CHUNK_SIZE);
 
 		initCoreThread();
 	}
@@ -44,14 +56,20 @@ namespace BansheeEngine
 			mAccessors.clear();
 		}
 
-		if(mCommandQueue != nullptr)
+		if(mCommandBatches != nullptr)
 		{
-			bs_delete(mCommandQueue);
-			mCommandQueue = nullptr;
+			bs_delete(mCommandBatches);
+			mCommandBatches = nullptr;
 		}
 
-		bs_delete(mFrameAllocs[0]);
-		bs_delete(mFrameAllocs[1]);
+		if(mCommandBufferPool != nullptr)
+		{
+			bs_delete(mCommandBufferPool);
+			mCommandBufferPool = nullptr;
+		}
+
+		for(UINT32 i = 0; i < NUM_FRAME_ALLOCS; i++)
+			bs_delete(mFrameAllocs[i]);
 	}
 
 	void CoreThread::initCoreThread()
@@ -73,32 +91,42 @@ namespace BansheeEngine
 		mCoreThreadId = BS_THREAD_CURRENT_ID;
 		mSyncedCoreAccessor = bs_new<CoreThreadAccessor<CommandQueueSync>>(BS_THREAD_CURRENT_ID);
 
+		Timer idleTimer;
 		while(true)
 		{
-			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
+			CommandBatch batch;
+			if(mCommandBatches->pop(batch))
 			{
-				BS_LOCK_MUTEX_NAMED(mCommandQueueMutex, lock)
+				executeBatch(batch);
+				continue;
+			}
 
-				while(mCommandQueue->isEmpty())
+			// Wait until we get some ready commands
+			BS_LOCK_MUTEX_NAMED(mCommandQueueMutex, lock)
+
+			// Submitting threads check this flag after queuing, and only notify if it is set
+			mCoreThreadSleeping.store(true);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			while(mCommandBatches->isEmpty())
+			{
+				if(mCoreThreadShutdown)
 				{
-					if(mCoreThreadShutdown)
-					{
-						bs_delete(mSyncedCoreAccessor);
-						TaskScheduler::instance().addWorker();
-						return;
-					}
-
-					TaskScheduler::instance().addWorker(); // Do something else while we wait, otherwise this core will be unused
-					BS_THREAD_WAIT(mCommandReadyCondition, mCommandQueueMutex, lock);
-					TaskScheduler::instance().removeWorker();
+					bs_delete(mSyncedCoreAccessor);
+					TaskScheduler::instance().addWorker();
+					return;
 				}
 
-				commands = mCommandQueue->flush();
+				idleTimer.reset();
+
+				TaskScheduler::instance().addWorker(); // Do something else while we wait, otherwise this core will be unused
+				BS_THREAD_WAIT(mCommandReadyCondition, mCommandQueueMutex, lock);
+				TaskScheduler::instance().removeWorker();
+
+				mIdleTime += (UINT32)idleTimer.getMicroseconds();
 			}
 
-			// Play commands
-			mCommandQueue->playbackWithNotify(commands, std::bind(&CoreThread::commandCompletedNotify, this, _1)); 
+			mCoreThreadSleeping.store(false);
 		}
 #endif
 	}
@@ -167,23 +195,10 @@ namespace BansheeEngine
 			return op;
 		}
 
-		UINT32 commandId = -1;
-		{
-			BS_LOCK_MUTEX(mCommandQueueMutex);
+		CommandBuffer* commands = mCommandBufferPool->acquire();
+		op = commands->recordReturn(std::move(commandCallback));
 
-			if(blockUntilComplete)
-			{
-				commandId = mMaxCommandNotifyId++;
-				op = mCommandQueue->queueReturn(commandCallback, true, commandId);
-			}
-			else
-				op = mCommandQueue->queueReturn(commandCallback);
-		}
-
-		BS_THREAD_NOTIFY_ALL(mCommandReadyCondition);
-
-		if(blockUntilComplete)
-			blockUntilCommandCompleted(commandId);
+		submitCommands(commands, mCommandBufferPool, blockUntilComplete);
 
 		return op;
 	}
@@ -196,29 +211,70 @@ namespace BansheeEngine
 			return;
 		}
 
-		UINT32 commandId = -1;
+		CommandBuffer* commands = mCommandBufferPool->acquire();
+		commands->record(std::move(commandCallback));
+
+		submitCommands(commands, mCommandBufferPool, blockUntilComplete);
+	}
+
+	void CoreThread::submitCommands(CommandBuffer* commands, CommandBufferPool* pool, bool blockUntilComplete)
+	{
+		CommandBatch batch;
+		batch.commands = commands;
+		batch.pool = pool;
+
+		if(BS_THREAD_CURRENT_ID == getCoreThreadId())
 		{
-			BS_LOCK_MUTEX(mCommandQueueMutex);
+			executeBatch(batch); // Execute immediately
+			return;
+		}
 
-			if(blockUntilComplete)
-			{
-				commandId = mMaxCommandNotifyId++;
-				mCommandQueue->queue(commandCallback, true, commandId);
-			}
-			else
-				mCommandQueue->queue(commandCallback);
+		UINT32 commandId = -1;
+		if(blockUntilComplete)
+		{
+			// Empty command whose only purpose is to trigger the notify callback once all commands before it execute
+			commandId = mMaxCommandNotifyId++;
+			commands->record(&CoreThread::emptyCommand, true, commandId);
+		}
+		else if(commands->isEmpty())
+		{
+			pool->release(commands);
+			return;
 		}
 
-		BS_THREAD_NOTIFY_ALL(mCommandReadyCondition);
+		mNumCommands += commands->getNumCommands();
+		mNumCommandBytes += commands->getNumBytes();
+		mNumCommandBatches++;
+
+		while(!mCommandBatches->push(batch))
+			BS_THREAD_SLEEP(0); // Core thread is too far behind, wait until it catches up
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(mCoreThreadSleeping.load())
+		{
+			BS_LOCK_MUTEX(mCommandQueueMutex);
+			BS_THREAD_NOTIFY_ALL(mCommandReadyCondition);
+		}
 
 		if(blockUntilComplete)
 			blockUntilCommandCompleted(commandId);
 	}
 
+	void CoreThread::executeBatch(const CommandBatch& batch)
+	{
+		batch.commands->execute(std::bind(&CoreThread::commandCompletedNotify, this, _1));
+		batch.pool->release(batch.commands);
+	}
+
 	void CoreThread::update()
 	{
-		mActiveFrameAlloc = (mActiveFrameAlloc + 1) % 2;
+		mActiveFrameAlloc = (mActiveFrameAlloc + 1) % NUM_FRAME_ALLOCS;
 		mFrameAllocs[mActiveFrameAlloc]->clear();
+
+		mNumCommandsLastFrame = mNumCommands.exchange(0);
+		mNumCommandBytesLastFrame = mNumCommandBytes.exchange(0);
+		mNumCommandBatchesLastFrame = mNumCommandBatches.exchange(0);
+		mIdleTimeLastFrame = mIdleTime.exchange(0);
 	}
 
 	FrameAlloc* CoreThread::getFrameAlloc() const
@@ -226,6 +282,40 @@ namespace BansheeEngine
 		return mFrameAllocs[mActiveFrameAlloc];
 	}
 
+	UINT32 CoreThread::getFrameAllocUsageLastFrame() const
+	{
+		// Active allocator was cleared in the last update(), which recorded the usage of the frame it was last used for
+		return mFrameAllocs[mActiveFrameAlloc]->getLastFrameUsage();
+	}
+
+	UINT32 CoreThread::getFrameAllocPeakUsage() const
+	{
+		UINT32 peakUsage = 0;
+		for (UINT32 i = 0; i < NUM_FRAME_ALLOCS; i++)
+			peakUsage = std::max(peakUsage, mFrameAllocs[i]->getPeakFrameUsage());
+
+		return peakUsage;
+	}
+
+	UINT32 CoreThread::getFrameAllocAverageUsage() const
+	{
+		// Allocators are used in a round robin fashion so each one sees the same number of frames (give or take one)
+		UINT64 totalUsage = 0;
+		for (UINT32 i = 0; i < NUM_FRAME_ALLOCS; i++)
+			totalUsage += mFrameAllocs[i]->getAverageFrameUsage();
+
+		return (UINT32)(totalUsage / NUM_FRAME_ALLOCS);
+	}
+
+	UINT32 CoreThread::getFrameAllocNumBytesReserved() const
+	{
+		UINT32 numBytes = 0;
+		for (UINT32 i = 0; i < NUM_FRAME_ALLOCS; i++)
+			numBytes += mFrameAllocs[i]->getNumBytesReserved();
+
+		return numBytes;
+	}
+
 	void CoreThread::blockUntilCommandCompleted(UINT32 commandId)
 	{
 #if !BS_FORCE_SINGLETHREADED_RENDERING
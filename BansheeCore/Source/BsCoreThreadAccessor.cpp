@@ -204,21 +204,11 @@ namespace BansheeEngine
 		mCommandQueue->queue(std::bind(&RenderWindow::setWindowed, renderWindow.get(), width, height));
 	}
 
-	AsyncOp CoreThreadAccessorBase::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback)
-	{
-		return mCommandQueue->queueReturn(commandCallback);
-	}
-
-	void CoreThreadAccessorBase::queueCommand(std::function<void()> commandCallback)
-	{
-		mCommandQueue->queue(commandCallback);
-	}
-
 	void CoreThreadAccessorBase::submitToCoreThread(bool blockUntilComplete)
 	{
-		Queue<QueuedCommand>* commands = mCommandQueue->flush();
+		CommandBuffer* commands = mCommandQueue->flush();
 
-		gCoreThread().queueCommand(std::bind(&CommandQueueBase::playback, mCommandQueue, commands), blockUntilComplete);
+		gCoreThread().submitCommands(commands, mCommandQueue->getBufferPool(), blockUntilComplete);
 	}
 
 	void CoreThreadAccessorBase::cancelAll()
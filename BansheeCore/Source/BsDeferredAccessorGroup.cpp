@@ -0,0 +1,71 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsDeferredAccessorGroup.h"
+#include "BsCoreThread.h"
+#include "BsException.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Command that does nothing. Used for waiting until all previously submitted commands execute.
+	 */
+	static void emptyCommand() { }
+
+	DeferredAccessorGroup::DeferredAccessorGroup(UINT32 numSlices)
+		:mNumSlices(0), mHasSubmitted(false)
+	{
+		setNumSlices(numSlices);
+	}
+
+	DeferredAccessorGroup::~DeferredAccessorGroup()
+	{
+		// Submitted command buffers are returned to their accessor once executed, so they must be done first
+		if (mHasSubmitted && BS_THREAD_CURRENT_ID != gCoreThread().getCoreThreadId())
+			gCoreThread().queueCommand(&emptyCommand, true);
+
+		for (auto& accessor : mAccessors)
+			bs_delete(accessor);
+	}
+
+	DeferredCoreAccessor& DeferredAccessorGroup::getAccessor(UINT32 sliceIdx)
+	{
+		if (sliceIdx >= mNumSlices)
+		{
+			BS_EXCEPT(InvalidParametersException, "Slice index out of range: " + toString(sliceIdx) + 
+				". Valid range: [0, " + toString(mNumSlices) + ")");
+		}
+
+		return *mAccessors[sliceIdx];
+	}
+
+	void DeferredAccessorGroup::setNumSlices(UINT32 numSlices)
+	{
+		while ((UINT32)mAccessors.size() < numSlices)
+			mAccessors.push_back(bs_new<DeferredCoreAccessor>(BS_THREAD_CURRENT_ID));
+
+		// Commands in slices that are no longer used would never be submitted
+		for (UINT32 i = numSlices; i < mNumSlices; i++)
+			mAccessors[i]->cancelAll();
+
+		mNumSlices = numSlices;
+	}
+
+	void DeferredAccessorGroup::submitToCoreThread(bool blockUntilComplete)
+	{
+		// Core thread queue is FIFO, so submitting slices one after another from this thread keeps them in order
+		for (UINT32 i = 0; i < mNumSlices; i++)
+		{
+			bool isLast = i == (mNumSlices - 1);
+			mAccessors[i]->submitToCoreThread(blockUntilComplete && isLast);
+		}
+
+		mHasSubmitted = true;
+	}
+
+	void DeferredAccessorGroup::cancelAll()
+	{
+		for (UINT32 i = 0; i < mNumSlices; i++)
+			mAccessors[i]->cancelAll();
+	}
+}
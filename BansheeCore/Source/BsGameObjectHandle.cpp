@@ -6,40 +6,69 @@
 #include "BsGameObjectHandle.h"
 #include "BsException.h"
 #include "BsGameObjectHandleRTTI.h"
+#include "BsGameObjectManager.h"
 
 namespace BansheeEngine
 {
 	GameObjectHandleBase::GameObjectHandleBase(const std::shared_ptr<GameObjectHandleData>& data)
-		:mData(data)
+		:mInstanceId(0), mData(data)
 	{ }
 
 	GameObjectHandleBase::GameObjectHandleBase(const std::shared_ptr<GameObject> ptr)
-	{
-		mData = bs_shared_ptr<GameObjectHandleData, PoolAlloc>(ptr->mInstanceData);
-	}
+		:mInstanceId(ptr->getInstanceId())
+	{ }
 
 	GameObjectHandleBase::GameObjectHandleBase(std::nullptr_t ptr)
-	{
-		mData = bs_shared_ptr<GameObjectHandleData, PoolAlloc>(nullptr);
-	}
+		:mInstanceId(0)
+	{ }
 
 	GameObjectHandleBase::GameObjectHandleBase()
-	{
-		mData = bs_shared_ptr<GameObjectHandleData, PoolAlloc>(nullptr);
-	}
+		:mInstanceId(0)
+	{ }
 
 	void GameObjectHandleBase::_resolve(const GameObjectHandleBase& object) 
 	{ 
-		mData->mPtr = object.mData->mPtr;
-		mData->mInstanceId = object.mData->mInstanceId;
+		assert(mData != nullptr);
+
+		const std::shared_ptr<GameObject>* objectPtr = object.findObject();
+		if(objectPtr != nullptr)
+		{
+			mData->mPtr = (*objectPtr)->mInstanceData;
+			mData->mInstanceId = (*objectPtr)->getInstanceId();
+		}
+		else
+		{
+			mData->mPtr = nullptr;
+			mData->mInstanceId = 0;
+		}
 	}
 
-	void GameObjectHandleBase::throwIfDestroyed() const
+	const std::shared_ptr<GameObject>* GameObjectHandleBase::findObject() const
 	{
-		if(isDestroyed()) 
+		if(mData != nullptr)
+		{
+			if(mData->mPtr == nullptr || mData->mPtr->object == nullptr)
+				return nullptr;
+
+			return &mData->mPtr->object;
+		}
+
+		// Handles can outlive the manager (e.g. when held by other modules during shutdown)
+		if(mInstanceId == 0 || !GameObjectManager::isStarted())
+			return nullptr;
+
+		return GameObjectManager::instance()._findObject(mInstanceId);
+	}
+
+	const std::shared_ptr<GameObject>* GameObjectHandleBase::getObject() const
+	{
+		const std::shared_ptr<GameObject>* objectPtr = findObject();
+		if(objectPtr == nullptr) 
 		{
 			BS_EXCEPT(InternalErrorException, "Trying to access an object that has been destroyed.");
 		}
+
+		return objectPtr;
 	}
 
 	RTTITypeBase* GameObjectHandleBase::getRTTIStatic()
@@ -6,8 +6,10 @@
 
 namespace BansheeEngine
 {
+	const UINT32 GameObjectManager::INVALID_SLOT = (UINT32)-1;
+
 	GameObjectManager::GameObjectManager()
-		:mNextAvailableID(1), mIsDeserializationActive(false)
+		:mFirstFreeSlot(INVALID_SLOT), mNumObjects(0), mActiveDeserializedObject(nullptr), mIsDeserializationActive(false)
 	{
 
 	}
@@ -17,21 +19,21 @@ namespace BansheeEngine
 
 	GameObjectHandleBase GameObjectManager::getObject(UINT64 id) const 
 	{ 
-		auto iterFind = mObjects.find(id);
+		GameObjectHandleBase handle;
 
-		if(iterFind != mObjects.end())
-			return iterFind->second;
+		if(findSlot(id) != nullptr)
+			handle.mInstanceId = id;
 		
-		return nullptr;
+		return handle;
 	}
 
 	bool GameObjectManager::tryGetObject(UINT64 id, GameObjectHandleBase& object) const
 	{
-		auto iterFind = mObjects.find(id);
-
-		if(iterFind != mObjects.end())
+		if(findSlot(id) != nullptr)
 		{
-			object = iterFind->second;
+			object = GameObjectHandleBase();
+			object.mInstanceId = id;
+
 			return true;
 		}
 
@@ -40,23 +42,89 @@ namespace BansheeEngine
 
 	bool GameObjectManager::objectExists(UINT64 id) const 
 	{ 
-		return mObjects.find(id) != mObjects.end(); 
+		return findSlot(id) != nullptr;
 	}
 
 	GameObjectHandleBase GameObjectManager::registerObject(const std::shared_ptr<GameObject>& object)
 	{
-		object->initialize(object, mNextAvailableID);
+		UINT32 index;
+		if(mFirstFreeSlot != INVALID_SLOT)
+		{
+			index = mFirstFreeSlot;
+			mFirstFreeSlot = mSlots[index].nextFree;
+		}
+		else
+		{
+			index = (UINT32)mSlots.size();
 
-		GameObjectHandleBase handle(object);
-		mObjects[mNextAvailableID] = handle;
-		mNextAvailableID++;
+			ObjectSlot newSlot;
+			newSlot.generation = 1; // 0 is not a valid ID, so generation of a used slot is never zero
+			newSlot.nextFree = INVALID_SLOT;
 
-		return handle;
+			mSlots.push_back(newSlot);
+		}
+
+		ObjectSlot& slot = mSlots[index];
+		object->initialize(object, makeId(index, slot.generation));
+
+		slot.object = object;
+		mNumObjects++;
+
+		return GameObjectHandleBase(object);
 	}
 
 	void GameObjectManager::unregisterObject(const GameObjectHandleBase& object)
 	{
-		mObjects.erase(object->getInstanceId());
+		UINT64 id = object.getInstanceId();
+		UINT32 index = (UINT32)id;
+		UINT32 generation = (UINT32)(id >> 32);
+
+		if(index >= (UINT32)mSlots.size() || mSlots[index].generation != generation || mSlots[index].object == nullptr)
+			return;
+
+		ObjectSlot& slot = mSlots[index];
+
+		// Keep the object alive until bookkeeping is done, as the provided handle could be stored
+		// within the object and destroyed along with it
+		std::shared_ptr<GameObject> objectPtr = slot.object;
+
+		slot.object = nullptr;
+		slot.generation++;
+		mNumObjects--;
+
+		// Retire the slot once its generation runs out, so an old ID can never alias a new object
+		if(slot.generation != 0)
+		{
+			slot.nextFree = mFirstFreeSlot;
+			mFirstFreeSlot = index;
+		}
+
+		// Invalidate handles that reference the object through shared handle data
+		objectPtr->mInstanceData->object = nullptr;
+	}
+
+	const std::shared_ptr<GameObject>* GameObjectManager::_findObject(UINT64 id) const
+	{
+		const ObjectSlot* slot = findSlot(id);
+		if(slot == nullptr)
+			return nullptr;
+
+		return &slot->object;
+	}
+
+	const GameObjectManager::ObjectSlot* GameObjectManager::findSlot(UINT64 id) const
+	{
+		UINT32 index = (UINT32)id;
+		UINT32 generation = (UINT32)(id >> 32);
+
+		if(index >= (UINT32)mSlots.size())
+			return nullptr;
+
+		const ObjectSlot& slot = mSlots[index];
+		if(slot.generation != generation || slot.object == nullptr)
+			return nullptr;
+
+		return &slot;
 	}
 
 	void GameObjectManager::startDeserialization()
@@ -80,12 +148,10 @@ namespace BansheeEngine
 				instanceId = findIter->second;
 			}
 
-			auto findIterObj = mObjects.find(instanceId);
-
-			if(findIterObj != mObjects.end())
-				unresolvedHandle._resolve(findIterObj->second);	
-			else
-				unresolvedHandle._resolve(nullptr);
+			// IDs not in the mapping reference objects outside of the deserialized data, which were
+			// serialized with their in-engine ID. IDs from data saved before the slot map was introduced
+			// have a zero generation and never match a live object, same as any other stale ID.
+			unresolvedHandle._resolve(getObject(instanceId));
 		}
 
 		for(auto iter = mEndCallbacks.rbegin(); iter != mEndCallbacks.rend(); ++iter)
@@ -13,7 +13,7 @@ namespace BansheeEngine
 		:mDirty(true), mData(nullptr), mSize(size)
 	{
 		if (mSize > 0)
-			mData = (UINT8*)bs_alloc<ScratchAlloc>(mSize);
+			mData = (UINT8*)bs_alloc<PoolAlloc>(mSize);
 
 		memset(mData, 0, mSize);
 	}
@@ -23,7 +23,7 @@ namespace BansheeEngine
 		mSize = otherBlock->mSize;
 
 		if (mSize > 0)
-			mData = (UINT8*)bs_alloc<ScratchAlloc>(mSize);
+			mData = (UINT8*)bs_alloc<PoolAlloc>(mSize);
 		else
 			mData = nullptr;
 
@@ -34,7 +34,7 @@ namespace BansheeEngine
 	GpuParamBlock::~GpuParamBlock()
 	{
 		if(mData != nullptr)
-			bs_free<ScratchAlloc>(mData);
+			bs_free<PoolAlloc>(mData);
 	}
 
 	void GpuParamBlock::write(UINT32 offset, const void* data, UINT32 size)
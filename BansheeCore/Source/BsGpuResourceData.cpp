@@ -65,7 +65,7 @@ namespace BansheeEngine
 
 		freeInternalBuffer();
 
-		mData = (UINT8*)bs_alloc<ScratchAlloc>(size);
+		mData = (UINT8*)bs_alloc<GenAlloc>(size);
 		mOwnsData = true;
 	}
 
@@ -82,7 +82,7 @@ namespace BansheeEngine
 		}
 #endif
 
-		bs_free<ScratchAlloc>(mData);
+		bs_free<GenAlloc>(mData);
 		mData = nullptr;
 	}
 
@@ -290,7 +290,7 @@ namespace BansheeEngine
 		mIndexBuffer = HardwareBufferManager::instance().createIndexBuffer(mIndexType,
 			mNumIndices, mBufferType == MeshBufferType::Dynamic ? GBU_DYNAMIC : GBU_STATIC);
 
-		mVertexData = std::shared_ptr<VertexData>(bs_new<VertexData, PoolAlloc>());
+		mVertexData = bs_shared_ptr<VertexData, PoolAlloc>();
 
 		mVertexData->vertexCount = mNumVertices;
 		mVertexData->vertexDeclaration = mVertexDesc->createDeclaration();
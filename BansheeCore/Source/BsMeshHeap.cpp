@@ -99,152 +99,50 @@ namespace BansheeEngine
 
 	void MeshHeap::allocInternal(TransientMeshPtr mesh, const MeshDataPtr& meshData)
 	{
-		// Find free vertex chunk and grow if needed
-		UINT32 smallestVertFit = 0;
-		UINT32 smallestVertFitIdx = 0;
-
-		while(smallestVertFit == 0)
+		// Find free vertex range and grow if needed
+		UINT32 vertBlockId = mVertAllocator.alloc(meshData->getNumVertices());
+		if(vertBlockId == RangeAllocator::INVALID_BLOCK)
 		{
-			UINT32 curIdx = 0;
-			for(auto& chunkIdx : mFreeVertChunks)
-			{
-				ChunkData& chunk = mVertChunks[chunkIdx];
-
-				if(chunk.size >= meshData->getNumVertices() && (chunk.size < smallestVertFit || smallestVertFit == 0))
-				{
-					smallestVertFit = chunk.size;
-					smallestVertFitIdx = curIdx;
-				}
-
-				curIdx++;
-			}
-
-			if(smallestVertFit > 0)
-				break;
+			// Allocator only searches size classes large enough for the request, so grow by the
+			// rounded up size to ensure the new free range at the end can satisfy it
+			UINT64 requiredVertices = (UINT64)mNumVertices + RangeAllocator::getRequiredFreeSize(meshData->getNumVertices());
 
 			UINT32 newNumVertices = mNumVertices;
-			while(newNumVertices < (mNumVertices + meshData->getNumVertices()))
+			while(newNumVertices < requiredVertices)
 			{
-				newNumVertices = Math::roundToInt(newNumVertices * GrowPercent);
+				newNumVertices = std::max((UINT32)Math::roundToInt(newNumVertices * GrowPercent), newNumVertices + 1);
 			}
 
 			growVertexBuffer(newNumVertices);
+			vertBlockId = mVertAllocator.alloc(meshData->getNumVertices());
+			assert(vertBlockId != RangeAllocator::INVALID_BLOCK);
 		}
 
-		// Find free index chunk and grow if needed
-		UINT32 smallestIdxFit = 0;
-		UINT32 smallestIdxFitIdx = 0;
-
-		while(smallestIdxFit == 0)
+		// Find free index range and grow if needed
+		UINT32 idxBlockId = mIdxAllocator.alloc(meshData->getNumIndices());
+		if(idxBlockId == RangeAllocator::INVALID_BLOCK)
 		{
-			UINT32 curIdx = 0;
-			for(auto& chunkIdx : mFreeIdxChunks)
-			{
-				ChunkData& chunk = mIdxChunks[chunkIdx];
-
-				if(chunk.size >= meshData->getNumIndices() && (chunk.size < smallestIdxFit || smallestIdxFit == 0))
-				{
-					smallestIdxFit = chunk.size;
-					smallestIdxFitIdx = curIdx;
-				}
-
-				curIdx++;
-			}
-
-			if(smallestIdxFit > 0)
-				break;
+			// Allocator only searches size classes large enough for the request, so grow by the
+			// rounded up size to ensure the new free range at the end can satisfy it
+			UINT64 requiredIndices = (UINT64)mNumIndices + RangeAllocator::getRequiredFreeSize(meshData->getNumIndices());
 
 			UINT32 newNumIndices = mNumIndices;
-			while(newNumIndices < (mNumIndices + meshData->getNumIndices()))
+			while(newNumIndices < requiredIndices)
 			{
-				newNumIndices = Math::roundToInt(newNumIndices * GrowPercent);
+				newNumIndices = std::max((UINT32)Math::roundToInt(newNumIndices * GrowPercent), newNumIndices + 1);
 			}
 
 			growIndexBuffer(newNumIndices);
+			idxBlockId = mIdxAllocator.alloc(meshData->getNumIndices());
+			assert(idxBlockId != RangeAllocator::INVALID_BLOCK);
 		}
 
-		UINT32 freeVertChunkIdx = 0;
-		UINT32 freeIdxChunkIdx = 0;
-
-		auto freeVertIter = mFreeVertChunks.begin();
-		freeVertChunkIdx = (*freeVertIter);
-		for(UINT32 i = 0; i < smallestVertFitIdx; i++)
-		{
-			freeVertIter++;
-			freeVertChunkIdx = (*freeVertIter);
-		}
-
-		mFreeVertChunks.erase(freeVertIter);
-		
-		auto freeIdxIter = mFreeIdxChunks.begin();
-		freeIdxChunkIdx = (*freeIdxIter);
-		for(UINT32 i = 0; i < smallestIdxFitIdx; i++)
-		{
-			freeIdxIter++;
-			freeIdxChunkIdx = (*freeIdxIter);
-		}
-
-		mFreeIdxChunks.erase(freeIdxIter);
-
-		ChunkData& vertChunk = mVertChunks[freeVertChunkIdx];
-		ChunkData& idxChunk = mIdxChunks[freeIdxChunkIdx];
-
-		UINT32 vertChunkStart = vertChunk.start;
-		UINT32 idxChunkStart = idxChunk.start;
-
-		UINT32 remainingNumVerts = vertChunk.size - meshData->getNumVertices();
-		UINT32 remainingNumIdx = idxChunk.size - meshData->getNumIndices();
-
-		vertChunk.size = meshData->getNumVertices();
-		idxChunk.size = meshData->getNumIndices();
-
-		if(remainingNumVerts > 0)
-		{
-			if(!mEmptyVertChunks.empty())
-			{
-				UINT32 emptyChunkIdx = mEmptyVertChunks.top();
-				ChunkData& emptyChunk = mVertChunks[emptyChunkIdx];
-				mEmptyVertChunks.pop();
-
-				emptyChunk.start = vertChunkStart + meshData->getNumVertices();
-				emptyChunk.size = remainingNumVerts;
-			}
-			else
-			{
-				ChunkData newChunk;
-				newChunk.size = remainingNumVerts;
-				newChunk.start = vertChunkStart + meshData->getNumVertices();
-
-				mVertChunks.push_back(newChunk);
-				mFreeVertChunks.push_back((UINT32)(mVertChunks.size() - 1));
-			}
-		}
-
-		if(remainingNumIdx > 0)
-		{
-			if(!mEmptyIdxChunks.empty())
-			{
-				UINT32 emptyChunkIdx = mEmptyIdxChunks.top();
-				ChunkData& emptyChunk = mIdxChunks[emptyChunkIdx];
-				mEmptyIdxChunks.pop();
-
-				emptyChunk.start = idxChunkStart + meshData->getNumIndices();
-				emptyChunk.size = remainingNumIdx;
-			}
-			else
-			{
-				ChunkData newChunk;
-				newChunk.size = remainingNumIdx;
-				newChunk.start = idxChunkStart + meshData->getNumIndices();
-
-				mIdxChunks.push_back(newChunk);
-				mFreeIdxChunks.push_back((UINT32)(mIdxChunks.size() - 1));
-			}
-		}
+		UINT32 vertChunkStart = mVertAllocator.getStart(vertBlockId);
+		UINT32 idxChunkStart = mIdxAllocator.getStart(idxBlockId);
 
 		AllocatedData newAllocData;
-		newAllocData.vertChunkIdx = freeVertChunkIdx;
-		newAllocData.idxChunkIdx = freeIdxChunkIdx;
+		newAllocData.vertBlockId = vertBlockId;
+		newAllocData.idxBlockId = idxBlockId;
 		newAllocData.useFlags = UseFlags::GPUFree;
 		newAllocData.eventQueryIdx = createEventQuery();
 		newAllocData.mesh = mesh;
@@ -319,24 +217,27 @@ namespace BansheeEngine
 		AllocatedData& allocData = findIter->second;
 		if(allocData.useFlags == UseFlags::GPUFree)
 		{
-			allocData.useFlags = UseFlags::Free;
-			freeEventQuery(allocData.eventQueryIdx);
-
-			mFreeVertChunks.push_back(allocData.vertChunkIdx);
-			mFreeIdxChunks.push_back(allocData.idxChunkIdx);
-
-			mergeWithNearbyChunks(allocData.vertChunkIdx, allocData.idxChunkIdx);
-
+			freeAllocData(allocData);
 			mMeshAllocData.erase(findIter);
 		}
 		else if(allocData.useFlags == UseFlags::Used)
 			allocData.useFlags = UseFlags::CPUFree;
 	}
 
+	void MeshHeap::freeAllocData(const AllocatedData& allocData)
+	{
+		freeEventQuery(allocData.eventQueryIdx);
+
+		mVertAllocator.free(allocData.vertBlockId);
+		mIdxAllocator.free(allocData.idxBlockId);
+	}
+
 	void MeshHeap::growVertexBuffer(UINT32 numVertices)
 	{
+		UINT32 oldNumVertices = mVertAllocator.getCapacity();
+
 		mNumVertices = numVertices;
-		mVertexData = std::shared_ptr<VertexData>(bs_new<VertexData, PoolAlloc>());
+		mVertexData = bs_shared_ptr<VertexData, PoolAlloc>();
 
 		mVertexData->vertexCount = mNumVertices;
 		mVertexData->vertexDeclaration = mVertexDesc->createDeclaration();
@@ -353,137 +254,53 @@ namespace BansheeEngine
 
 			mVertexData->setBuffer(i, vertexBuffer);
 
-			// Copy all data to the new buffer
+			// Copy all data to the new buffer. Allocated ranges don't move so the old buffer
+			// is copied as a whole, including any free ranges.
 			UINT8* oldBuffer = mCPUVertexData[i];
 			UINT8* buffer = (UINT8*)bs_alloc(vertSize * numVertices);
 
-			UINT32 destOffset = 0;
 			if(oldBuffer != nullptr)
 			{
-				for(auto& allocData : mMeshAllocData)
-				{
-					ChunkData& oldChunk = mVertChunks[allocData.second.vertChunkIdx];
-
-					UINT8* oldData = oldBuffer + oldChunk.start * vertSize;
-					memcpy(buffer + destOffset * vertSize, oldData, oldChunk.size * vertSize);
-
-					destOffset += oldChunk.size;
-				}
-
+				memcpy(buffer, oldBuffer, oldNumVertices * vertSize);
 				bs_free(oldBuffer);
-			}
 
-			if(destOffset > 0)
-				vertexBuffer->writeData(0, destOffset * vertSize, buffer, BufferWriteType::NoOverwrite);
+				if(mMeshAllocData.size() > 0)
+					vertexBuffer->writeData(0, oldNumVertices * vertSize, buffer, BufferWriteType::NoOverwrite);
+			}
 
 			mCPUVertexData[i] = buffer;
 		}
 
-		// Reorder chunks
-		UINT32 destOffset = 0;
-		Vector<ChunkData> newVertChunks;
-		List<UINT32> freeVertChunks;
-
-		for(auto& allocData : mMeshAllocData)
-		{
-			ChunkData& oldChunk = mVertChunks[allocData.second.vertChunkIdx];
-
-			ChunkData newChunk;
-			newChunk.start = destOffset;
-			newChunk.size = oldChunk.size;
-
-			allocData.second.vertChunkIdx = (UINT32)newVertChunks.size();
-			newVertChunks.push_back(newChunk);
-
-			destOffset += oldChunk.size;
-		}
-
-		// Add free chunk
-		if(destOffset != mNumVertices)
-		{
-			ChunkData newChunk;
-			newChunk.start = destOffset;
-			newChunk.size = mNumVertices - destOffset;
-
-			newVertChunks.push_back(newChunk);
-			freeVertChunks.push_back((UINT32)(newVertChunks.size() - 1));
-		}
-
-		mVertChunks = newVertChunks;
-		mFreeVertChunks = freeVertChunks;
-		
-		while(!mEmptyVertChunks.empty())
-			mEmptyVertChunks.pop();
+		mVertAllocator.grow(mNumVertices);
 	}
 
 	void MeshHeap::growIndexBuffer(UINT32 numIndices)
 	{
+		UINT32 oldNumIndices = mIdxAllocator.getCapacity();
+
 		mNumIndices = numIndices;
 
 		mIndexBuffer = HardwareBufferManager::instance().createIndexBuffer(mIndexType, mNumIndices, GBU_DYNAMIC);
 
-		// Copy all data to the new buffer
+		// Copy all data to the new buffer. Allocated ranges don't move so the old buffer
+		// is copied as a whole, including any free ranges.
 		UINT32 idxSize = mIndexBuffer->getIndexSize();
 
 		UINT8* oldBuffer = mCPUIndexData;
 		UINT8* buffer = (UINT8*)bs_alloc(idxSize * numIndices);
 
-		UINT32 destOffset = 0;
 		if(oldBuffer != nullptr)
 		{
-			for(auto& allocData : mMeshAllocData)
-			{
-				ChunkData& oldChunk = mIdxChunks[allocData.second.idxChunkIdx];
-
-				UINT8* oldData = oldBuffer + oldChunk.start * idxSize;
-				memcpy(buffer + destOffset * idxSize, oldData, oldChunk.size * idxSize);
-
-				destOffset += oldChunk.size;
-			}
-
+			memcpy(buffer, oldBuffer, oldNumIndices * idxSize);
 			bs_free(oldBuffer);
-		}
-
-		if(destOffset > 0)
-			mIndexBuffer->writeData(0, destOffset * idxSize, buffer, BufferWriteType::NoOverwrite);
-
-		mCPUIndexData = buffer;
-
-		// Reorder chunks
-		destOffset = 0;
-		Vector<ChunkData> newIdxChunks;
-		List<UINT32> freeIdxChunks;
 
-		for(auto& allocData : mMeshAllocData)
-		{
-			ChunkData& oldChunk = mIdxChunks[allocData.second.idxChunkIdx];
-
-			ChunkData newChunk;
-			newChunk.start = destOffset;
-			newChunk.size = oldChunk.size;
-
-			allocData.second.idxChunkIdx = (UINT32)newIdxChunks.size();
-			newIdxChunks.push_back(newChunk);
-
-			destOffset += oldChunk.size;
+			if(mMeshAllocData.size() > 0)
+				mIndexBuffer->writeData(0, oldNumIndices * idxSize, buffer, BufferWriteType::NoOverwrite);
 		}
 
-		// Add free chunk
-		if(destOffset != mNumIndices)
-		{
-			ChunkData newChunk;
-			newChunk.start = destOffset;
-			newChunk.size = mNumIndices - destOffset;
-
-			newIdxChunks.push_back(newChunk);
-			freeIdxChunks.push_back((UINT32)(newIdxChunks.size() - 1));
-		}
-
-		mIdxChunks = newIdxChunks;
-		mFreeIdxChunks = freeIdxChunks;
+		mCPUIndexData = buffer;
 
-		while(!mEmptyIdxChunks.empty())
-			mEmptyIdxChunks.pop();
+		mIdxAllocator.grow(mNumIndices);
 	}
 
 	UINT32 MeshHeap::createEventQuery()
@@ -514,6 +331,16 @@ namespace BansheeEngine
 		mFreeEventQueries.push(idx);
 	}
 
+	MeshHeapStats MeshHeap::getStats() const
+	{
+		MeshHeapStats stats;
+		stats.vertices = mVertAllocator.getStats();
+		stats.indices = mIdxAllocator.getStats();
+		stats.numMeshes = (UINT32)mMeshAllocData.size();
+
+		return stats;
+	}
+
 	std::shared_ptr<VertexData> MeshHeap::_getVertexData() const
 	{
 		return mVertexData;
@@ -529,8 +356,7 @@ namespace BansheeEngine
 		auto findIter = mMeshAllocData.find(meshId);
 		assert(findIter != mMeshAllocData.end());
 
-		UINT32 chunkIdx = findIter->second.vertChunkIdx;
-		return mVertChunks[chunkIdx].start;
+		return mVertAllocator.getStart(findIter->second.vertBlockId);
 	}
 
 	UINT32 MeshHeap::getIndexOffset(UINT32 meshId) const
@@ -538,8 +364,7 @@ namespace BansheeEngine
 		auto findIter = mMeshAllocData.find(meshId);
 		assert(findIter != mMeshAllocData.end());
 
-		UINT32 chunkIdx = findIter->second.idxChunkIdx;
-		return mIdxChunks[chunkIdx].start;
+		return mIdxAllocator.getStart(findIter->second.idxBlockId);
 	}
 
 	void MeshHeap::notifyUsedOnGPU(UINT32 meshId)
@@ -579,14 +404,7 @@ namespace BansheeEngine
 
 			if(allocData.useFlags == UseFlags::CPUFree)
 			{
-				allocData.useFlags = UseFlags::Free;
-				thisPtr->freeEventQuery(allocData.eventQueryIdx);
-
-				thisPtr->mFreeVertChunks.push_back(allocData.vertChunkIdx);
-				thisPtr->mFreeIdxChunks.push_back(allocData.idxChunkIdx);
-
-				thisPtr->mergeWithNearbyChunks(allocData.vertChunkIdx, allocData.idxChunkIdx);
-
+				thisPtr->freeAllocData(allocData);
 				thisPtr->mMeshAllocData.erase(findIter);
 			}
 			else
@@ -595,79 +413,4 @@ namespace BansheeEngine
 
 		queryData.query->onTriggered.clear();
 	}
-
-	void MeshHeap::mergeWithNearbyChunks(UINT32 chunkVertIdx, UINT32 chunkIdxIdx)
-	{
-		// Merge vertex chunks
-		ChunkData& vertChunk = mVertChunks[chunkVertIdx];
-		for(auto& freeChunkIdx : mFreeVertChunks)
-		{
-			if(chunkVertIdx == freeChunkIdx)
-				continue;
-
-			ChunkData& curChunk = mVertChunks[freeChunkIdx];
-			if(curChunk.size == 0) // Already merged
-				continue;
-
-			bool merged = false;
-			if(curChunk.start == (vertChunk.start + vertChunk.size))
-			{
-				vertChunk.size += curChunk.size;
-
-				merged = true;
-			}
-			else if((curChunk.start + curChunk.size) == vertChunk.start)
-			{
-				vertChunk.start = curChunk.start;
-				vertChunk.size += curChunk.size;
-
-				merged = true;
-			}
-
-			if(merged)
-			{
-				// We can't remove the chunk since that would break the indexing scheme, so 
-				// mark it as empty and set size to 0. It will be reused when needed.
-				curChunk.start = 0;
-				curChunk.size = 0;
-				mEmptyVertChunks.push(freeChunkIdx);
-			}
-		}
-
-		// Merge index chunks
-		ChunkData& idxChunk = mIdxChunks[chunkIdxIdx];
-		for(auto& freeChunkIdx : mFreeIdxChunks)
-		{
-			if(chunkIdxIdx == freeChunkIdx)
-				continue;
-
-			ChunkData& curChunk = mIdxChunks[freeChunkIdx];
-			if(curChunk.size == 0) // Already merged
-				continue;
-
-			bool merged = false;
-			if(curChunk.start == (idxChunk.start + idxChunk.size))
-			{
-				idxChunk.size += curChunk.size;
-
-				merged = true;
-			}
-			else if((curChunk.start + curChunk.size) == idxChunk.start)
-			{
-				idxChunk.start = curChunk.start;
-				idxChunk.size += curChunk.size;
-
-				merged = true;
-			}
-
-			if(merged)
-			{
-				// We can't remove the chunk since that would break the indexing scheme, so 
-				// mark it as empty and set size to 0. It will be reused when needed.
-				curChunk.start = 0;
-				curChunk.size = 0;
-				mEmptyIdxChunks.push(freeChunkIdx);
-			}
-		}
-	}
 }
\ No newline at end of file
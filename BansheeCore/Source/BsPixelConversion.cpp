@@ -0,0 +1,785 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsPixelConversion.h"
+#include "BsBitwise.h"
+
+#if BS_SIMD_SSE2
+#include <immintrin.h>
+
+#if BS_COMPILER == BS_COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// MSVC allows use of any intrinsic regardless of compiler settings, while other compilers
+// need functions using instruction sets not enabled globally to be marked explicitly.
+#if BS_COMPILER == BS_COMPILER_MSVC || BS_COMPILER == BS_COMPILER_INTEL
+#	define BS_TARGET_SSSE3
+#	define BS_TARGET_AVX2
+#else
+#	define BS_TARGET_SSSE3 __attribute__((target("ssse3")))
+#	define BS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Number of pixels converted at once when going through the intermediate float representation.
+	 */
+	static const UINT32 BLOCK_SIZE = 256;
+
+	/**
+	 * @brief	Swizzle source value used for destination bytes that should be set to zero.
+	 */
+	static const INT8 SWIZZLE_ZERO = -1;
+
+	/**
+	 * @brief	Swizzle source value used for destination bytes that should be set to 255.
+	 */
+	static const INT8 SWIZZLE_ONE = -2;
+
+	/**
+	 * @brief	Describes how to build a pixel of one 8-bit format from a pixel of another.
+	 */
+	struct ByteSwizzle
+	{
+		UINT32 srcSize;
+		UINT32 dstSize;
+		INT8 map[4]; /**< Index of the source byte for each destination byte, or one of the SWIZZLE_* constants. */
+	};
+
+	/**
+	 * @brief	Channel layout of a pixel format supported by the conversion kernels.
+	 */
+	struct ConversionFormat
+	{
+		enum Type
+		{
+			Unsupported,
+			Byte,
+			Float16,
+			Float32
+		};
+
+		Type type;
+		UINT8 size; /**< Size of a single pixel in bytes. */
+		UINT8 numChannels; /**< Number of channels stored in a pixel. Only relevant for float formats. */
+		INT8 channels[4]; /**< Byte offset of the red, green, blue and alpha channel, or -1 if not present. Only relevant for byte formats. */
+		bool isSource; /**< Can the format be converted from. */
+	};
+
+	/**
+	 * @brief	Layouts of all pixel formats, indexed by PixelFormat.
+	 *
+	 * @note	Alpha channels of PF_X8R8G8B8 and PF_X8B8G8R8 are ignored, same as in PixelUtil::unpackColor.
+	 *			PF_R8G8B8X8 and PF_B8G8R8X8 aren't supported as sources since their alpha is read with zero bits.
+	 */
+	static const ConversionFormat FORMATS[PF_COUNT] =
+	{
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_UNKNOWN
+		{ ConversionFormat::Byte, 1, 1, { 0, -1, -1, -1 }, true }, // PF_R8
+		{ ConversionFormat::Byte, 2, 2, { 0, 1, -1, -1 }, true }, // PF_R8G8
+		{ ConversionFormat::Byte, 3, 3, { 0, 1, 2, -1 }, true }, // PF_R8G8B8
+		{ ConversionFormat::Byte, 3, 3, { 2, 1, 0, -1 }, true }, // PF_B8G8R8
+		{ ConversionFormat::Byte, 4, 4, { 1, 2, 3, 0 }, true }, // PF_A8R8G8B8
+		{ ConversionFormat::Byte, 4, 4, { 3, 2, 1, 0 }, true }, // PF_A8B8G8R8
+		{ ConversionFormat::Byte, 4, 4, { 2, 1, 0, 3 }, true }, // PF_B8G8R8A8
+		{ ConversionFormat::Byte, 4, 4, { 0, 1, 2, 3 }, true }, // PF_R8G8B8A8
+		{ ConversionFormat::Byte, 4, 3, { 1, 2, 3, -1 }, true }, // PF_X8R8G8B8
+		{ ConversionFormat::Byte, 4, 3, { 3, 2, 1, -1 }, true }, // PF_X8B8G8R8
+		{ ConversionFormat::Byte, 4, 3, { 0, 1, 2, -1 }, false }, // PF_R8G8B8X8
+		{ ConversionFormat::Byte, 4, 3, { 2, 1, 0, -1 }, false }, // PF_B8G8R8X8
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC1
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC1a
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC2
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC3
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC4
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC5
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC6H
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_BC7
+		{ ConversionFormat::Float16, 2, 1, { -1, -1, -1, -1 }, true }, // PF_FLOAT16_R
+		{ ConversionFormat::Float16, 4, 2, { -1, -1, -1, -1 }, true }, // PF_FLOAT16_RG
+		{ ConversionFormat::Float16, 6, 3, { -1, -1, -1, -1 }, true }, // PF_FLOAT16_RGB
+		{ ConversionFormat::Float16, 8, 4, { -1, -1, -1, -1 }, true }, // PF_FLOAT16_RGBA
+		{ ConversionFormat::Float32, 4, 1, { -1, -1, -1, -1 }, true }, // PF_FLOAT32_R
+		{ ConversionFormat::Float32, 8, 2, { -1, -1, -1, -1 }, true }, // PF_FLOAT32_RG
+		{ ConversionFormat::Float32, 12, 3, { -1, -1, -1, -1 }, true }, // PF_FLOAT32_RGB
+		{ ConversionFormat::Float32, 16, 4, { -1, -1, -1, -1 }, true }, // PF_FLOAT32_RGBA
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_D32_S8X24
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_D24S8
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false }, // PF_D32
+		{ ConversionFormat::Unsupported, 0, 0, { -1, -1, -1, -1 }, false } // PF_D16
+	};
+
+	/**
+	 * @brief	Layout of PF_R8G8B8A8, used as the intermediate format when converting between
+	 *			byte and float formats.
+	 */
+	static const ConversionFormat& RGBA8_FORMAT = FORMATS[PF_R8G8B8A8];
+
+	/**
+	 * @brief	Builds a swizzle that converts pixels from one byte format to another. Channels missing in
+	 *			the source are set to zero, except for alpha which is set to 255. Bytes of the destination that
+	 *			don't belong to any channel are set to zero.
+	 */
+	static ByteSwizzle createSwizzle(const ConversionFormat& src, const ConversionFormat& dst)
+	{
+		ByteSwizzle swizzle;
+		swizzle.srcSize = src.size;
+		swizzle.dstSize = dst.size;
+
+		for (UINT32 i = 0; i < 4; i++)
+			swizzle.map[i] = SWIZZLE_ZERO;
+
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (dst.channels[i] < 0)
+				continue;
+
+			if (src.channels[i] >= 0)
+				swizzle.map[dst.channels[i]] = src.channels[i];
+			else
+				swizzle.map[dst.channels[i]] = i == 3 ? SWIZZLE_ONE : SWIZZLE_ZERO;
+		}
+
+		return swizzle;
+	}
+
+	/**
+	 * @brief	Expands pixels with the specified number of float channels into RGBA, replicating
+	 *			the last channel into missing color channels and setting missing alpha to one.
+	 */
+	static void expandChannels(const float* src, UINT32 numChannels, float* dst, UINT32 count)
+	{
+		switch (numChannels)
+		{
+		case 1:
+			for (UINT32 i = 0; i < count; i++, src += 1, dst += 4)
+			{
+				dst[0] = dst[1] = dst[2] = src[0];
+				dst[3] = 1.0f;
+			}
+			break;
+		case 2:
+			for (UINT32 i = 0; i < count; i++, src += 2, dst += 4)
+			{
+				dst[0] = src[0];
+				dst[1] = dst[2] = src[1];
+				dst[3] = 1.0f;
+			}
+			break;
+		case 3:
+			for (UINT32 i = 0; i < count; i++, src += 3, dst += 4)
+			{
+				dst[0] = src[0];
+				dst[1] = src[1];
+				dst[2] = src[2];
+				dst[3] = 1.0f;
+			}
+			break;
+		default:
+			memcpy(dst, src, count * 4 * sizeof(float));
+			break;
+		}
+	}
+
+	/**
+	 * @brief	Outputs the first numChannels channels of RGBA float pixels.
+	 */
+	static void contractChannels(const float* src, UINT32 numChannels, float* dst, UINT32 count)
+	{
+		if (numChannels == 4)
+		{
+			memcpy(dst, src, count * 4 * sizeof(float));
+			return;
+		}
+
+		for (UINT32 i = 0; i < count; i++, src += 4, dst += numChannels)
+		{
+			for (UINT32 j = 0; j < numChannels; j++)
+				dst[j] = src[j];
+		}
+	}
+
+	/************************************************************************/
+	/* 								SCALAR KERNELS							*/
+	/************************************************************************/
+
+	static void swizzle_Scalar(const ByteSwizzle& swizzle, const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++, src += swizzle.srcSize, dst += swizzle.dstSize)
+		{
+			for (UINT32 j = 0; j < swizzle.dstSize; j++)
+			{
+				INT8 srcIdx = swizzle.map[j];
+				if (srcIdx >= 0)
+					dst[j] = src[srcIdx];
+				else
+					dst[j] = srcIdx == SWIZZLE_ONE ? 255 : 0;
+			}
+		}
+	}
+
+	static void bytesToFloats_Scalar(const UINT8* src, float* dst, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++)
+			dst[i] = Bitwise::fixedToFloat(src[i], 8);
+	}
+
+	static void floatsToBytes_Scalar(const float* src, UINT8* dst, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++)
+			dst[i] = (UINT8)Bitwise::floatToFixed(src[i], 8);
+	}
+
+	static void halvesToFloats_Scalar(const UINT16* src, float* dst, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++)
+			dst[i] = Bitwise::halfToFloat(src[i]);
+	}
+
+	static void floatsToHalves_Scalar(const float* src, UINT16* dst, UINT32 count)
+	{
+		for (UINT32 i = 0; i < count; i++)
+			dst[i] = Bitwise::floatToHalf(src[i]);
+	}
+
+#if BS_SIMD_SSE2
+	/************************************************************************/
+	/* 								SSE2 KERNELS							*/
+	/************************************************************************/
+
+	static void bytesToFloats_SSE2(const UINT8* src, float* dst, UINT32 count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 maxValue = _mm_set1_ps(255.0f);
+
+		UINT32 i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i bytes = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i low = _mm_unpacklo_epi8(bytes, zero);
+			__m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+			// Division rather than multiplication by reciprocal, to match Bitwise::fixedToFloat exactly
+			_mm_storeu_ps(dst + i + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), maxValue));
+			_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), maxValue));
+			_mm_storeu_ps(dst + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), maxValue));
+			_mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), maxValue));
+		}
+
+		bytesToFloats_Scalar(src + i, dst + i, count - i);
+	}
+
+	/**
+	 * @brief	Converts four floats to integers in [0, 255] range the same way Bitwise::floatToFixed does.
+	 */
+	static inline __m128i floatsToFixed8_SSE2(__m128 value)
+	{
+		// Max with zero as the second operand also maps NaN to zero
+		__m128 scaled = _mm_max_ps(_mm_mul_ps(value, _mm_set1_ps(256.0f)), _mm_setzero_ps());
+		scaled = _mm_min_ps(scaled, _mm_set1_ps(255.0f));
+
+		return _mm_cvttps_epi32(scaled);
+	}
+
+	static void floatsToBytes_SSE2(const float* src, UINT8* dst, UINT32 count)
+	{
+		UINT32 i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i a = floatsToFixed8_SSE2(_mm_loadu_ps(src + i + 0));
+			__m128i b = floatsToFixed8_SSE2(_mm_loadu_ps(src + i + 4));
+			__m128i c = floatsToFixed8_SSE2(_mm_loadu_ps(src + i + 8));
+			__m128i d = floatsToFixed8_SSE2(_mm_loadu_ps(src + i + 12));
+
+			__m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+			_mm_storeu_si128((__m128i*)(dst + i), bytes);
+		}
+
+		floatsToBytes_Scalar(src + i, dst + i, count - i);
+	}
+
+	/**
+	 * @brief	Converts four halfs stored in the lower 16 bits of each lane to floats, the same way
+	 *			Bitwise::halfToFloatI does.
+	 */
+	static inline __m128i halfToFloat_SSE2(__m128i half)
+	{
+		const __m128i exponentBias = _mm_set1_epi32((127 - 15) << 23);
+
+		__m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+		__m128i value = _mm_and_si128(half, _mm_set1_epi32(0x7FFF));
+
+		__m128i normal = _mm_add_epi32(_mm_slli_epi32(value, 13), exponentBias);
+
+		// Infinity and NaN need their exponent to be all ones, which requires the bias to be applied twice
+		__m128i isInfNaN = _mm_cmpgt_epi32(value, _mm_set1_epi32(0x7BFF));
+		normal = _mm_add_epi32(normal, _mm_and_si128(isInfNaN, exponentBias));
+
+		// Zero and denormals are mantissa * 2^-24, which is always exactly representable
+		__m128i isDenormal = _mm_cmplt_epi32(value, _mm_set1_epi32(0x0400));
+		__m128i denormal = _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(1.0f / 16777216.0f)));
+
+		__m128i result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+		return _mm_or_si128(result, sign);
+	}
+
+	static void halvesToFloats_SSE2(const UINT16* src, float* dst, UINT32 count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		UINT32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i halfs = _mm_loadu_si128((const __m128i*)(src + i));
+
+			_mm_storeu_si128((__m128i*)(dst + i + 0), halfToFloat_SSE2(_mm_unpacklo_epi16(halfs, zero)));
+			_mm_storeu_si128((__m128i*)(dst + i + 4), halfToFloat_SSE2(_mm_unpackhi_epi16(halfs, zero)));
+		}
+
+		halvesToFloats_Scalar(src + i, dst + i, count - i);
+	}
+
+	/**
+	 * @brief	Converts four floats to halfs stored in the lower 16 bits of each lane, the same way
+	 *			Bitwise::floatToHalfI does (rounding towards zero, overflowing to infinity).
+	 */
+	static inline __m128i floatToHalf_SSE2(__m128 value)
+	{
+		__m128i bits = _mm_castps_si128(value);
+
+		__m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+		__m128i biasedExponent = _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xFF));
+		__m128i exponent = _mm_sub_epi32(biasedExponent, _mm_set1_epi32(127 - 15));
+		__m128i mantissa = _mm_srli_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), 13);
+
+		__m128i result = _mm_or_si128(_mm_slli_epi32(exponent, 10), mantissa);
+
+		// Overflow, infinity and NaN. NaN keeps the top of its mantissa, with at least one bit set.
+		__m128i infinity = _mm_set1_epi32(0x7C00);
+		__m128i isNaN = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_setzero_si128()),
+			_mm_cmpeq_epi32(biasedExponent, _mm_set1_epi32(0xFF)));
+		__m128i nan = _mm_or_si128(_mm_or_si128(infinity, mantissa),
+			_mm_and_si128(_mm_cmpeq_epi32(mantissa, _mm_setzero_si128()), _mm_set1_epi32(1)));
+
+		__m128i large = _mm_or_si128(_mm_and_si128(isNaN, nan), _mm_andnot_si128(isNaN, infinity));
+		__m128i isLarge = _mm_cmpgt_epi32(exponent, _mm_set1_epi32(30));
+		result = _mm_or_si128(_mm_and_si128(isLarge, large), _mm_andnot_si128(isLarge, result));
+
+		// Denormals. Truncating |value| * 2^24 is equivalent to shifting the mantissa with the implicit bit.
+		__m128 absValue = _mm_and_ps(value, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+		__m128i denormal = _mm_cvttps_epi32(_mm_mul_ps(absValue, _mm_set1_ps(16777216.0f)));
+		__m128i isDenormal = _mm_cmplt_epi32(exponent, _mm_set1_epi32(1));
+		result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, result));
+
+		// Values too small for a denormal are flushed to positive zero
+		__m128i isZero = _mm_cmplt_epi32(exponent, _mm_set1_epi32(-10));
+		result = _mm_andnot_si128(isZero, _mm_or_si128(result, sign));
+
+		// Sign extend so the value survives signed saturation when packing
+		return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+	}
+
+	static void floatsToHalves_SSE2(const float* src, UINT16* dst, UINT32 count)
+	{
+		UINT32 i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i low = floatToHalf_SSE2(_mm_loadu_ps(src + i + 0));
+			__m128i high = floatToHalf_SSE2(_mm_loadu_ps(src + i + 4));
+
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(low, high));
+		}
+
+		floatsToHalves_Scalar(src + i, dst + i, count - i);
+	}
+
+	/************************************************************************/
+	/* 								SSSE3 KERNELS							*/
+	/************************************************************************/
+
+	/**
+	 * @brief	Builds byte shuffle control and fill masks for a swizzle, covering as many whole pixels
+	 *			as fit in 16 bytes. Returns the number of pixels covered.
+	 */
+	static UINT32 createShuffleMasks(const ByteSwizzle& swizzle, UINT8* control, UINT8* fill)
+	{
+		UINT32 numPixels = 16 / std::max(swizzle.srcSize, swizzle.dstSize);
+
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			control[i] = 0x80; // Zeroes the byte
+			fill[i] = 0;
+		}
+
+		for (UINT32 i = 0; i < numPixels; i++)
+		{
+			for (UINT32 j = 0; j < swizzle.dstSize; j++)
+			{
+				UINT32 dstIdx = i * swizzle.dstSize + j;
+
+				INT8 srcIdx = swizzle.map[j];
+				if (srcIdx >= 0)
+					control[dstIdx] = (UINT8)(i * swizzle.srcSize + srcIdx);
+				else if (srcIdx == SWIZZLE_ONE)
+					fill[dstIdx] = 255;
+			}
+		}
+
+		return numPixels;
+	}
+
+	static BS_TARGET_SSSE3 void swizzle_SSSE3(const ByteSwizzle& swizzle, const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		UINT8 controlData[16];
+		UINT8 fillData[16];
+		UINT32 numPixels = createShuffleMasks(swizzle, controlData, fillData);
+
+		__m128i control = _mm_loadu_si128((const __m128i*)controlData);
+		__m128i fill = _mm_loadu_si128((const __m128i*)fillData);
+
+		// Loads and stores always touch 16 bytes even if fewer belong to whole pixels. Any extra bytes
+		// written are overwritten by the next iteration, but the last iteration must stay within the row.
+		UINT32 minSize = std::min(swizzle.srcSize, swizzle.dstSize);
+
+		UINT32 i = 0;
+		for (; (count - i) * minSize >= 16; i += numPixels)
+		{
+			__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i * swizzle.srcSize));
+			pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, control), fill);
+
+			_mm_storeu_si128((__m128i*)(dst + i * swizzle.dstSize), pixels);
+		}
+
+		swizzle_Scalar(swizzle, src + i * swizzle.srcSize, dst + i * swizzle.dstSize, count - i);
+	}
+
+	/************************************************************************/
+	/* 								AVX2 KERNELS							*/
+	/************************************************************************/
+
+	// Byte shuffles and byte/float conversions are limited by memory bandwidth and shuffle throughput,
+	// and their 256-bit versions were measured slower than 128-bit ones, so only half conversions have
+	// AVX2 versions.
+
+	/**
+	 * @copydoc	halfToFloat_SSE2
+	 */
+	static BS_TARGET_AVX2 inline __m256i halfToFloat_AVX2(__m256i half)
+	{
+		const __m256i exponentBias = _mm256_set1_epi32((127 - 15) << 23);
+
+		__m256i sign = _mm256_slli_epi32(_mm256_and_si256(half, _mm256_set1_epi32(0x8000)), 16);
+		__m256i value = _mm256_and_si256(half, _mm256_set1_epi32(0x7FFF));
+
+		__m256i normal = _mm256_add_epi32(_mm256_slli_epi32(value, 13), exponentBias);
+
+		__m256i isInfNaN = _mm256_cmpgt_epi32(value, _mm256_set1_epi32(0x7BFF));
+		normal = _mm256_add_epi32(normal, _mm256_and_si256(isInfNaN, exponentBias));
+
+		__m256i isDenormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(0x0400), value);
+		__m256i denormal = _mm256_castps_si256(_mm256_mul_ps(_mm256_cvtepi32_ps(value), _mm256_set1_ps(1.0f / 16777216.0f)));
+
+		__m256i result = _mm256_blendv_epi8(normal, denormal, isDenormal);
+		return _mm256_or_si256(result, sign);
+	}
+
+	static BS_TARGET_AVX2 void halvesToFloats_AVX2(const UINT16* src, float* dst, UINT32 count)
+	{
+		UINT32 i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i low = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i + 0)));
+			__m256i high = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i + 8)));
+
+			_mm256_storeu_si256((__m256i*)(dst + i + 0), halfToFloat_AVX2(low));
+			_mm256_storeu_si256((__m256i*)(dst + i + 8), halfToFloat_AVX2(high));
+		}
+
+		halvesToFloats_SSE2(src + i, dst + i, count - i);
+	}
+
+	/**
+	 * @copydoc	floatToHalf_SSE2
+	 */
+	static BS_TARGET_AVX2 inline __m256i floatToHalf_AVX2(__m256 value)
+	{
+		__m256i bits = _mm256_castps_si256(value);
+
+		__m256i sign = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x8000));
+		__m256i biasedExponent = _mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xFF));
+		__m256i exponent = _mm256_sub_epi32(biasedExponent, _mm256_set1_epi32(127 - 15));
+		__m256i fullMantissa = _mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF));
+		__m256i mantissa = _mm256_srli_epi32(fullMantissa, 13);
+
+		__m256i result = _mm256_or_si256(_mm256_slli_epi32(exponent, 10), mantissa);
+
+		__m256i infinity = _mm256_set1_epi32(0x7C00);
+		__m256i isNaN = _mm256_andnot_si256(_mm256_cmpeq_epi32(fullMantissa, _mm256_setzero_si256()),
+			_mm256_cmpeq_epi32(biasedExponent, _mm256_set1_epi32(0xFF)));
+		__m256i nan = _mm256_or_si256(_mm256_or_si256(infinity, mantissa),
+			_mm256_and_si256(_mm256_cmpeq_epi32(mantissa, _mm256_setzero_si256()), _mm256_set1_epi32(1)));
+
+		__m256i large = _mm256_blendv_epi8(infinity, nan, isNaN);
+		result = _mm256_blendv_epi8(result, large, _mm256_cmpgt_epi32(exponent, _mm256_set1_epi32(30)));
+
+		__m256 absValue = _mm256_and_ps(value, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF)));
+		__m256i denormal = _mm256_cvttps_epi32(_mm256_mul_ps(absValue, _mm256_set1_ps(16777216.0f)));
+		result = _mm256_blendv_epi8(result, denormal, _mm256_cmpgt_epi32(_mm256_set1_epi32(1), exponent));
+
+		__m256i isZero = _mm256_cmpgt_epi32(_mm256_set1_epi32(-10), exponent);
+		result = _mm256_andnot_si256(isZero, _mm256_or_si256(result, sign));
+
+		return _mm256_srai_epi32(_mm256_slli_epi32(result, 16), 16);
+	}
+
+	static BS_TARGET_AVX2 void floatsToHalves_AVX2(const float* src, UINT16* dst, UINT32 count)
+	{
+		UINT32 i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i low = floatToHalf_AVX2(_mm256_loadu_ps(src + i + 0));
+			__m256i high = floatToHalf_AVX2(_mm256_loadu_ps(src + i + 8));
+
+			// Packing works within 128-bit lanes, leaving 64-bit groups out of order
+			__m256i halfs = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), _MM_SHUFFLE(3, 1, 2, 0));
+			_mm256_storeu_si256((__m256i*)(dst + i), halfs);
+		}
+
+		floatsToHalves_SSE2(src + i, dst + i, count - i);
+	}
+
+	/**
+	 * @brief	Returns the most capable instruction set supported by the CPU and the OS.
+	 */
+	static PixelConversionISA detectISA()
+	{
+		int info[4];
+
+#if BS_COMPILER == BS_COMPILER_MSVC
+		__cpuid(info, 0);
+#else
+		__cpuid(0, info[0], info[1], info[2], info[3]);
+#endif
+		int maxLeaf = info[0];
+
+#if BS_COMPILER == BS_COMPILER_MSVC
+		__cpuid(info, 1);
+#else
+		__cpuid(1, info[0], info[1], info[2], info[3]);
+#endif
+		bool hasSSSE3 = (info[2] & (1 << 9)) != 0;
+		bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+		bool hasAVX = (info[2] & (1 << 28)) != 0;
+
+		bool hasAVX2 = false;
+		if (maxLeaf >= 7 && hasOSXSAVE && hasAVX)
+		{
+			// OS must save the upper halves of YMM registers on context switch
+#if BS_COMPILER == BS_COMPILER_MSVC
+			UINT64 xcr0 = _xgetbv(0);
+#else
+			UINT32 xcr0Low, xcr0High;
+			__asm__ ("xgetbv" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+			UINT64 xcr0 = ((UINT64)xcr0High << 32) | xcr0Low;
+#endif
+
+			if ((xcr0 & 0x6) == 0x6)
+			{
+#if BS_COMPILER == BS_COMPILER_MSVC
+				__cpuidex(info, 7, 0);
+#else
+				__cpuid_count(7, 0, info[0], info[1], info[2], info[3]);
+#endif
+				hasAVX2 = (info[1] & (1 << 5)) != 0;
+			}
+		}
+
+		if (hasAVX2)
+			return PixelConversionISA::AVX2;
+
+		if (hasSSSE3)
+			return PixelConversionISA::SSSE3;
+
+		return PixelConversionISA::SSE2;
+	}
+#else
+	static PixelConversionISA detectISA()
+	{
+		return PixelConversionISA::Scalar;
+	}
+#endif
+
+	/**
+	 * @brief	Set of kernels implemented using a specific instruction set.
+	 */
+	struct PixelConversionKernels
+	{
+		PixelConversionISA isa;
+
+		void(*swizzle)(const ByteSwizzle&, const UINT8*, UINT8*, UINT32);
+		void(*bytesToFloats)(const UINT8*, float*, UINT32);
+		void(*floatsToBytes)(const float*, UINT8*, UINT32);
+		void(*halvesToFloats)(const UINT16*, float*, UINT32);
+		void(*floatsToHalves)(const float*, UINT16*, UINT32);
+	};
+
+	/**
+	 * @brief	Kernel tables, indexed by PixelConversionISA.
+	 */
+	static const PixelConversionKernels KERNELS[] =
+	{
+		{ PixelConversionISA::Scalar, &swizzle_Scalar, &bytesToFloats_Scalar, &floatsToBytes_Scalar, &halvesToFloats_Scalar, &floatsToHalves_Scalar },
+#if BS_SIMD_SSE2
+		{ PixelConversionISA::SSE2, &swizzle_Scalar, &bytesToFloats_SSE2, &floatsToBytes_SSE2, &halvesToFloats_SSE2, &floatsToHalves_SSE2 },
+		{ PixelConversionISA::SSSE3, &swizzle_SSSE3, &bytesToFloats_SSE2, &floatsToBytes_SSE2, &halvesToFloats_SSE2, &floatsToHalves_SSE2 },
+		{ PixelConversionISA::AVX2, &swizzle_SSSE3, &bytesToFloats_SSE2, &floatsToBytes_SSE2, &halvesToFloats_AVX2, &floatsToHalves_AVX2 }
+#endif
+	};
+
+	/**
+	 * @brief	Currently active kernels, or null if not yet selected.
+	 */
+	static std::atomic<const PixelConversionKernels*> gActiveKernels(nullptr);
+
+	/**
+	 * @brief	Returns the currently active kernels, selecting them if needed.
+	 */
+	static const PixelConversionKernels& getKernels()
+	{
+		const PixelConversionKernels* kernels = gActiveKernels.load(std::memory_order_acquire);
+		if (kernels == nullptr)
+		{
+			// Racing threads pick the same table, so no need to synchronize beyond the atomic
+			kernels = &KERNELS[(UINT32)detectISA()];
+			gActiveKernels.store(kernels, std::memory_order_release);
+		}
+
+		return *kernels;
+	}
+
+	/**
+	 * @brief	Converts pixels of any supported format into RGBA floats. Count must not be larger than BLOCK_SIZE.
+	 */
+	static void unpackBlock(const PixelConversionKernels& kernels, const ConversionFormat& format, const UINT8* src, float* dst, UINT32 count)
+	{
+		switch (format.type)
+		{
+		case ConversionFormat::Byte:
+		{
+			UINT8 rgba[BLOCK_SIZE * 4];
+			kernels.swizzle(createSwizzle(format, RGBA8_FORMAT), src, rgba, count);
+			kernels.bytesToFloats(rgba, dst, count * 4);
+		}
+			break;
+		case ConversionFormat::Float16:
+		{
+			float channels[BLOCK_SIZE * 4];
+			kernels.halvesToFloats((const UINT16*)src, channels, count * format.numChannels);
+			expandChannels(channels, format.numChannels, dst, count);
+		}
+			break;
+		case ConversionFormat::Float32:
+		{
+			float channels[BLOCK_SIZE * 4];
+			memcpy(channels, src, count * format.size);
+			expandChannels(channels, format.numChannels, dst, count);
+		}
+			break;
+		default:
+			break;
+		}
+	}
+
+	/**
+	 * @brief	Converts RGBA floats into pixels of any supported format. Count must not be larger than BLOCK_SIZE.
+	 */
+	static void packBlock(const PixelConversionKernels& kernels, const ConversionFormat& format, const float* src, UINT8* dst, UINT32 count)
+	{
+		switch (format.type)
+		{
+		case ConversionFormat::Byte:
+		{
+			UINT8 rgba[BLOCK_SIZE * 4];
+			kernels.floatsToBytes(src, rgba, count * 4);
+			kernels.swizzle(createSwizzle(RGBA8_FORMAT, format), rgba, dst, count);
+		}
+			break;
+		case ConversionFormat::Float16:
+		{
+			float channels[BLOCK_SIZE * 4];
+			contractChannels(src, format.numChannels, channels, count);
+			kernels.floatsToHalves(channels, (UINT16*)dst, count * format.numChannels);
+		}
+			break;
+		case ConversionFormat::Float32:
+		{
+			float channels[BLOCK_SIZE * 4];
+			contractChannels(src, format.numChannels, channels, count);
+			memcpy(dst, channels, count * format.size);
+		}
+			break;
+		default:
+			break;
+		}
+	}
+
+	bool PixelConversion::isSupported(PixelFormat srcFormat, PixelFormat dstFormat)
+	{
+		if ((UINT32)srcFormat >= PF_COUNT || (UINT32)dstFormat >= PF_COUNT)
+			return false;
+
+		const ConversionFormat& src = FORMATS[srcFormat];
+		const ConversionFormat& dst = FORMATS[dstFormat];
+
+		return src.type != ConversionFormat::Unsupported && src.isSource && dst.type != ConversionFormat::Unsupported;
+	}
+
+	void PixelConversion::convertRow(PixelFormat srcFormat, PixelFormat dstFormat, const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		assert(isSupported(srcFormat, dstFormat));
+
+		const PixelConversionKernels& kernels = getKernels();
+		const ConversionFormat& srcDesc = FORMATS[srcFormat];
+		const ConversionFormat& dstDesc = FORMATS[dstFormat];
+
+		// Byte formats only need their channels moved around, as converting a byte to float and back is lossless
+		if (srcDesc.type == ConversionFormat::Byte && dstDesc.type == ConversionFormat::Byte)
+		{
+			kernels.swizzle(createSwizzle(srcDesc, dstDesc), src, dst, count);
+			return;
+		}
+
+		float rgba[BLOCK_SIZE * 4];
+		for (UINT32 i = 0; i < count; i += BLOCK_SIZE)
+		{
+			UINT32 blockCount = std::min(count - i, BLOCK_SIZE);
+
+			unpackBlock(kernels, srcDesc, src + i * srcDesc.size, rgba, blockCount);
+			packBlock(kernels, dstDesc, rgba, dst + i * dstDesc.size, blockCount);
+		}
+	}
+
+	PixelConversionISA PixelConversion::getISA()
+	{
+		return getKernels().isa;
+	}
+
+	PixelConversionISA PixelConversion::getMaxSupportedISA()
+	{
+		return detectISA();
+	}
+
+	void PixelConversion::setISA(PixelConversionISA isa)
+	{
+		PixelConversionISA maxISA = detectISA();
+		if ((UINT32)isa > (UINT32)maxISA)
+			isa = maxISA;
+
+		gActiveKernels.store(&KERNELS[(UINT32)isa], std::memory_order_release);
+	}
+}
@@ -2,11 +2,12 @@
 //_____________________________________ www.banshee-project.com __________________________________________________//
 //________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
 #include "BsPixelUtil.h"
+#include "BsPixelConversion.h"
+#include "BsTextureProcessor.h"
 #include "BsBitwise.h"
 #include "BsColor.h"
 #include "BsMath.h"
 #include "BsException.h"
-#include "nvtt/nvtt.h"
 
 namespace BansheeEngine 
 {
@@ -809,140 +810,6 @@ namespace BansheeEngine
         return _pixelFormats[ord];
     }
 
-	/**
-	 * @brief	Handles compression output from NVTT library for a single image.
-	 */
-	struct NVTTCompressOutputHandler : public nvtt::OutputHandler
-	{
-		NVTTCompressOutputHandler(UINT8* buffer, UINT32 sizeBytes)
-			:buffer(buffer), bufferWritePos(buffer), bufferEnd(buffer + sizeBytes)
-		{ }
-
-		virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel)
-		{ }
-
-		virtual bool writeData(const void* data, int size)
-		{
-			assert((bufferWritePos + size) <= bufferEnd);
-			memcpy(bufferWritePos, data, size);
-			bufferWritePos += size;
-
-			return true;
-		}
-
-		UINT8* buffer;
-		UINT8* bufferWritePos;
-		UINT8* bufferEnd;
-	};
-
-	/**
-	 * @brief	Handles output from NVTT library for a mip-map chain.
-	 */
-	struct NVTTMipmapOutputHandler : public nvtt::OutputHandler
-	{
-		NVTTMipmapOutputHandler(const Vector<PixelDataPtr>& buffers)
-			:buffers(buffers), bufferWritePos(nullptr), bufferEnd(nullptr)
-		{ }
-
-		virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel)
-		{ 
-			assert(miplevel >= 0 && miplevel < buffers.size());
-			assert(size == buffers[miplevel]->getConsecutiveSize());
-
-			activeBuffer = buffers[miplevel];
-
-			bufferWritePos = activeBuffer->getData();
-			bufferEnd = bufferWritePos + activeBuffer->getConsecutiveSize();
-		}
-
-		virtual bool writeData(const void* data, int size)
-		{
-			assert((bufferWritePos + size) <= bufferEnd);
-			memcpy(bufferWritePos, data, size);
-			bufferWritePos += size;
-
-			return true;
-		}
-
-		Vector<PixelDataPtr> buffers;
-		PixelDataPtr activeBuffer;
-
-		UINT8* bufferWritePos;
-		UINT8* bufferEnd;
-	};
-
-	nvtt::Format toNVTTFormat(PixelFormat format)
-	{
-		switch (format)
-		{
-		case PF_BC1:
-			return nvtt::Format_BC1;
-		case PF_BC1a:
-			return nvtt::Format_BC1a;
-		case PF_BC2:
-			return nvtt::Format_BC2;
-		case PF_BC3:
-			return nvtt::Format_BC3;
-		case PF_BC4:
-			return nvtt::Format_BC4;
-		case PF_BC5:
-			return nvtt::Format_BC5;
-		}
-
-		// Unsupported format
-		return nvtt::Format_BC3;
-	}
-
-	nvtt::Quality toNVTTQuality(CompressionQuality quality)
-	{
-		switch (quality)
-		{
-		case CompressionQuality::Fastest:
-			return nvtt::Quality_Fastest;
-		case CompressionQuality::Highest:
-			return nvtt::Quality_Highest;
-		case CompressionQuality::Normal:
-			return nvtt::Quality_Normal;
-		case CompressionQuality::Production:
-			return nvtt::Quality_Normal;
-		}
-
-		// Unknown quality level
-		return nvtt::Quality_Normal;
-	}
-
-	nvtt::AlphaMode toNVTTAlphaMode(AlphaMode alphaMode)
-	{
-		switch (alphaMode)
-		{
-		case AlphaMode::None:
-			return nvtt::AlphaMode_None;
-		case AlphaMode::Premultiplied:
-			return nvtt::AlphaMode_Premultiplied;
-		case AlphaMode::Transparency:
-			return nvtt::AlphaMode_Transparency;
-		}
-
-		// Unknown alpha mode
-		return nvtt::AlphaMode_None;
-	}
-
-	nvtt::WrapMode toNVTTWrapMode(MipMapWrapMode wrapMode)
-	{
-		switch (wrapMode)
-		{
-		case MipMapWrapMode::Clamp:
-			return nvtt::WrapMode_Clamp;
-		case MipMapWrapMode::Mirror:
-			return nvtt::WrapMode_Mirror;
-		case MipMapWrapMode::Repeat:
-			return nvtt::WrapMode_Repeat;
-		}
-
-		// Unknown alpha mode
-		return nvtt::WrapMode_Mirror;
-	}
-
     UINT32 PixelUtil::getNumElemBytes(PixelFormat format)
     {
         return getDescriptionFor(format).elemBytes;
@@ -1410,6 +1277,39 @@ namespace BansheeEngine
             return;
         }
 
+		// Most formats have vectorized conversion kernels, converting a row at a time
+		if (PixelConversion::isSupported(src.getFormat(), dst.getFormat()))
+		{
+			const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+			const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
+			UINT8 *srcptr = static_cast<UINT8*>(src.getData())
+				+ (src.getLeft() + src.getTop() * src.getRowPitch() + src.getFront() * src.getSlicePitch()) * srcPixelSize;
+			UINT8 *dstptr = static_cast<UINT8*>(dst.getData())
+				+ (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * dstPixelSize;
+
+			const UINT32 srcRowPitchBytes = src.getRowPitch()*srcPixelSize;
+			const UINT32 srcSliceSkipBytes = src.getSliceSkip()*srcPixelSize;
+
+			const UINT32 dstRowPitchBytes = dst.getRowPitch()*dstPixelSize;
+			const UINT32 dstSliceSkipBytes = dst.getSliceSkip()*dstPixelSize;
+
+			for (UINT32 z = src.getFront(); z < src.getBack(); z++)
+			{
+				for (UINT32 y = src.getTop(); y < src.getBottom(); y++)
+				{
+					PixelConversion::convertRow(src.getFormat(), dst.getFormat(), srcptr, dstptr, src.getWidth());
+
+					srcptr += srcRowPitchBytes;
+					dstptr += dstRowPitchBytes;
+				}
+
+				srcptr += srcSliceSkipBytes;
+				dstptr += dstSliceSkipBytes;
+			}
+
+			return;
+		}
+
 		// Converting to PF_X8R8G8B8 is exactly the same as converting to
 		// PF_A8R8G8B8. (same with PF_X8B8G8R8 and PF_A8B8G8R8)
 		if(dst.getFormat() == PF_X8R8G8B8 || dst.getFormat() == PF_X8B8G8R8)
@@ -1628,40 +1528,16 @@ namespace BansheeEngine
 		if (src.getDepth() != 1)
 			BS_EXCEPT(InvalidParametersException, "3D textures are not supported.");
 
-		PixelFormat pf = options.format;
-
 		if (isCompressed(src.getFormat()))
 			BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed.");
 
-		PixelData bgraData(src.getWidth(), src.getHeight(), 1, PF_B8G8R8A8);
-		bgraData.allocateInternalBuffer();
-		bulkPixelConversion(src, bgraData);
-
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapData(bgraData.getData(), src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(false);
-		io.setAlphaMode(toNVTTAlphaMode(options.alphaMode));
-		io.setNormalMap(options.isNormalMap);
-
-		if (options.isSRGB)
-			io.setGamma(2.2f, 2.2f);
-		else
-			io.setGamma(1.0f, 1.0f);
+		PixelDataPtr output = bs_shared_ptr<PixelData>(src.getWidth(), src.getHeight(), 1, options.format);
+		output->setExternalBuffer(dst.getData());
 
-		nvtt::CompressionOptions co;
-		co.setFormat(toNVTTFormat(options.format));
-		co.setQuality(toNVTTQuality(options.quality));
-		
-		NVTTCompressOutputHandler outputHandler(dst.getData(), dst.getConsecutiveSize());
+		Vector<PixelDataPtr> outputs;
+		outputs.push_back(output);
 
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
-		
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
-			BS_EXCEPT(InternalErrorException, "Compressing failed.");
+		TextureProcessor::process(src, outputs, MipMapGenOptions(), options);
 	}
 
 	Vector<PixelDataPtr> PixelUtil::genMipmaps(const PixelData& src, const MipMapGenOptions& options)
@@ -1669,77 +1545,27 @@ namespace BansheeEngine
 		if (src.getDepth() != 1)
 			BS_EXCEPT(InvalidParametersException, "3D textures are not supported.");
 
-		// Note: Add support for floating point mips, no reason they shouldn't be supported other than
-		// nvtt doesn't support them natively
-		if (isCompressed(src.getFormat()) || isFloatingPoint(src.getFormat()))
-			BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed or in floating point format.");
-
-		if (!Math::isPow2(src.getWidth()) || !Math::isPow2(src.getHeight()))
-			BS_EXCEPT(InvalidParametersException, "Texture width & height must be powers of 2.");
-
-		PixelData argbData(src.getWidth(), src.getHeight(), 1, PF_A8R8G8B8);
-		argbData.allocateInternalBuffer();
-		bulkPixelConversion(src, argbData);
-
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapData(argbData.getData(), src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(true);
-		io.setNormalMap(options.isNormalMap);
-		io.setNormalizeMipmaps(options.normalizeMipmaps);
-		io.setWrapMode(toNVTTWrapMode(options.wrapMode));
+		if (isCompressed(src.getFormat()))
+			BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed.");
 
-		nvtt::CompressionOptions co;
-		co.setFormat(nvtt::Format_RGBA);
-		
 		UINT32 numMips = getMaxMipmaps(src.getWidth(), src.getHeight(), 1, src.getFormat());
 
-		Vector<PixelDataPtr> argbMipBuffers;
-
-		// Note: This can be done more effectively without creating so many temp buffers
-		// and working with the original formats directly, but it would complicate the code
-		// too much at the moment.
+		Vector<PixelDataPtr> outputMipBuffers;
 		UINT32 curWidth = src.getWidth();
 		UINT32 curHeight = src.getHeight();
-		for (UINT32 i = 0; i < numMips; i++)
+		for (UINT32 i = 0; i <= numMips; i++)
 		{
-			argbMipBuffers.push_back(bs_shared_ptr<PixelData>(curWidth, curHeight, 1, PF_A8R8G8B8));
-			argbMipBuffers.back()->allocateInternalBuffer();
+			outputMipBuffers.push_back(bs_shared_ptr<PixelData>(curWidth, curHeight, 1, src.getFormat()));
+			outputMipBuffers.back()->allocateInternalBuffer();
 
-			if (curWidth > 1) 
+			if (curWidth > 1)
 				curWidth = curWidth / 2;
 
 			if (curHeight > 1)
 				curHeight = curHeight / 2;
 		}
 
-		argbMipBuffers.push_back(bs_shared_ptr<PixelData>(curWidth, curHeight, 1, PF_A8R8G8B8));
-		argbMipBuffers.back()->allocateInternalBuffer();
-
-		NVTTMipmapOutputHandler outputHandler(argbMipBuffers);
-
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
-
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
-			BS_EXCEPT(InternalErrorException, "Mipmap generation failed.");
-
-		argbData.freeInternalBuffer();
-
-		Vector<PixelDataPtr> outputMipBuffers;
-		for (UINT32 i = 0; i < (UINT32)argbMipBuffers.size(); i++)
-		{
-			PixelDataPtr argbBuffer = argbMipBuffers[i];
-			PixelDataPtr outputBuffer = bs_shared_ptr<PixelData>(argbBuffer->getWidth(), argbBuffer->getHeight(), 1, src.getFormat());
-			outputBuffer->allocateInternalBuffer();
-
-			bulkPixelConversion(*argbBuffer, *outputBuffer);
-			argbBuffer->freeInternalBuffer();
-
-			outputMipBuffers.push_back(outputBuffer);
-		}
+		TextureProcessor::process(src, outputMipBuffers, options, CompressionOptions());
 
 		return outputMipBuffers;
 	}
@@ -164,6 +164,9 @@ namespace BansheeEngine
 		reportSample.numObjectsCreated = (UINT32)(sample.endStats.numObjectsCreated - sample.startStats.numObjectsCreated);
 		reportSample.numObjectsDestroyed = (UINT32)(sample.endStats.numObjectsDestroyed - sample.startStats.numObjectsDestroyed);
 
+		reportSample.numRenderablesCulled = (UINT32)(sample.endStats.numRenderablesCulled - sample.startStats.numRenderablesCulled);
+		reportSample.numRenderablesUploaded = (UINT32)(sample.endStats.numRenderablesUploaded - sample.startStats.numRenderablesUploaded);
+
 		mFreeTimerQueries.push(sample.activeTimeQuery);
 		mFreeOcclusionQueries.push(sample.activeOcclusionQuery);
 	}
@@ -0,0 +1,176 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsRenderStateTracker.h"
+#include "BsRenderSystem.h"
+
+namespace BansheeEngine
+{
+	RenderStateTracker::RenderStateTracker()
+		:mStencilRefValue(0), mVertexBufferIndex(0), mNumVertexBuffers(0), mDrawOp(DOT_TRIANGLE_LIST), mDrawOpValid(false)
+	{
+		for (UINT32 i = 0; i < NUM_PROGRAM_TYPES; i++)
+			mProgramsValid[i] = false;
+	}
+
+	void RenderStateTracker::reset()
+	{
+		for (UINT32 i = 0; i < NUM_PROGRAM_TYPES; i++)
+		{
+			mPrograms[i] = HGpuProgram();
+			mProgramsValid[i] = false;
+			mParams[i] = nullptr;
+		}
+
+		mBlendState = nullptr;
+		mRasterizerState = nullptr;
+		mDepthStencilState = nullptr;
+		mStencilRefValue = 0;
+
+		mVertexDeclaration = nullptr;
+		for (UINT32 i = 0; i < mNumVertexBuffers; i++)
+			mVertexBuffers[i] = nullptr;
+
+		mVertexBufferIndex = 0;
+		mNumVertexBuffers = 0;
+		mIndexBuffer = nullptr;
+		mDrawOpValid = false;
+	}
+
+	void RenderStateTracker::bindGpuProgram(GpuProgramType type, const HGpuProgram& program)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		bool isRequested = program != nullptr;
+		if (mProgramsValid[type])
+		{
+			bool isBound = mPrograms[type] != nullptr;
+			if (isBound == isRequested && (!isRequested || mPrograms[type].get() == program.get()))
+				return;
+		}
+
+		if (isRequested)
+			RenderSystem::instance().bindGpuProgram(program);
+		else
+			RenderSystem::instance().unbindGpuProgram(type);
+
+		mPrograms[type] = program;
+		mProgramsValid[type] = true;
+
+		// Parameters are interpreted according to the bound program, so they must be rebound after it changes
+		mParams[type] = nullptr;
+	}
+
+	void RenderStateTracker::bindGpuParams(GpuProgramType type, const GpuParamsPtr& params)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (params != nullptr && mParams[type] == params)
+			return;
+
+		RenderSystem::instance().bindGpuParams(type, params);
+		mParams[type] = params;
+	}
+
+	void RenderStateTracker::setBlendState(const BlendStatePtr& blendState)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (blendState != nullptr && mBlendState == blendState)
+			return;
+
+		RenderSystem::instance().setBlendState(blendState);
+		mBlendState = blendState;
+	}
+
+	void RenderStateTracker::setRasterizerState(const RasterizerStatePtr& rasterizerState)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (rasterizerState != nullptr && mRasterizerState == rasterizerState)
+			return;
+
+		RenderSystem::instance().setRasterizerState(rasterizerState);
+		mRasterizerState = rasterizerState;
+	}
+
+	void RenderStateTracker::setDepthStencilState(const DepthStencilStatePtr& depthStencilState, UINT32 stencilRefValue)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (depthStencilState != nullptr && mDepthStencilState == depthStencilState && mStencilRefValue == stencilRefValue)
+			return;
+
+		RenderSystem::instance().setDepthStencilState(depthStencilState, stencilRefValue);
+		mDepthStencilState = depthStencilState;
+		mStencilRefValue = stencilRefValue;
+	}
+
+	void RenderStateTracker::setVertexDeclaration(const VertexDeclarationPtr& vertexDeclaration)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (vertexDeclaration != nullptr && mVertexDeclaration == vertexDeclaration)
+			return;
+
+		RenderSystem::instance().setVertexDeclaration(vertexDeclaration);
+		mVertexDeclaration = vertexDeclaration;
+	}
+
+	void RenderStateTracker::setVertexBuffers(UINT32 index, VertexBufferPtr* buffers, UINT32 numBuffers)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		assert(numBuffers <= MAX_BOUND_VERTEX_BUFFERS);
+
+		if (numBuffers > 0 && mVertexBufferIndex == index && mNumVertexBuffers == numBuffers)
+		{
+			bool isSame = true;
+			for (UINT32 i = 0; i < numBuffers; i++)
+			{
+				if (mVertexBuffers[i] != buffers[i])
+				{
+					isSame = false;
+					break;
+				}
+			}
+
+			if (isSame)
+				return;
+		}
+
+		RenderSystem::instance().setVertexBuffers(index, buffers, numBuffers);
+
+		for (UINT32 i = 0; i < numBuffers; i++)
+			mVertexBuffers[i] = buffers[i];
+
+		for (UINT32 i = numBuffers; i < mNumVertexBuffers; i++)
+			mVertexBuffers[i] = nullptr;
+
+		mVertexBufferIndex = index;
+		mNumVertexBuffers = numBuffers;
+	}
+
+	void RenderStateTracker::setIndexBuffer(const IndexBufferPtr& buffer)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (buffer != nullptr && mIndexBuffer == buffer)
+			return;
+
+		RenderSystem::instance().setIndexBuffer(buffer);
+		mIndexBuffer = buffer;
+	}
+
+	void RenderStateTracker::setDrawOperation(DrawOperationType op)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mDrawOpValid && mDrawOp == op)
+			return;
+
+		RenderSystem::instance().setDrawOperation(op);
+		mDrawOp = op;
+		mDrawOpValid = true;
+	}
+}
@@ -41,7 +41,8 @@ namespace BansheeEngine
 			}
 		}
 
-		mData->mPtr->synchronize();
+		if(mData->mPtr != nullptr)
+			mData->mPtr->synchronize();
 	}
 
 	void ResourceHandleBase::_setHandleData(std::shared_ptr<Resource> ptr, const String& uuid)
@@ -64,6 +65,19 @@ namespace BansheeEngine
 		}
 	}
 
+	void ResourceHandleBase::_abortLoad()
+	{
+		if(mData == nullptr || mData->mIsCreated)
+			return;
+
+		BS_LOCK_MUTEX(mResourceCreatedMutex);
+		{
+			mData->mIsCreated = true;
+		}
+
+		BS_THREAD_NOTIFY_ALL(mResourceCreatedCondition);
+	}
+
 	void ResourceHandleBase::throwIfNotLoaded() const
 	{
 		if(!isLoaded()) 
@@ -60,6 +60,32 @@ namespace BansheeEngine
 			mFilePathToUUID.erase(iterFind->second);
 			mUUIDToFilePath.erase(uuid);
 		}
+
+		mDependencies.erase(uuid);
+	}
+
+	void ResourceManifest::registerDependencies(const String& uuid, const Vector<String>& dependencies)
+	{
+		if(dependencies.empty())
+			mDependencies.erase(uuid);
+		else
+			mDependencies[uuid] = dependencies;
+	}
+
+	bool ResourceManifest::getDependencies(const String& uuid, Vector<String>& dependencies) const
+	{
+		auto iterFind = mDependencies.find(uuid);
+
+		if(iterFind != mDependencies.end())
+		{
+			dependencies = iterFind->second;
+			return true;
+		}
+		else
+		{
+			dependencies.clear();
+			return false;
+		}
 	}
 
 	bool ResourceManifest::uuidToFilePath(const String& uuid, Path& filePath) const
@@ -138,6 +164,8 @@ namespace BansheeEngine
 			copy->mUUIDToFilePath[elem.first] = elementRelativePath;
 		}
 
+		copy->mDependencies = manifest->mDependencies;
+
 		FileSerializer fs;
 		fs.encode(copy.get(), path);
 	}
@@ -161,6 +189,8 @@ namespace BansheeEngine
 			copy->mUUIDToFilePath[elem.first] = absPath;
 		}
 
+		copy->mDependencies = manifest->mDependencies;
+
 		return copy;
 	}
 
@@ -0,0 +1,335 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsResourcePackage.h"
+#include "BsMemoryMappedFile.h"
+#include "BsDataStream.h"
+#include "BsFileSystem.h"
+#include "BsCompression.h"
+#include "BsException.h"
+#include "BsPath.h"
+
+namespace BansheeEngine
+{
+	const UINT32 ResourcePackage::MAGIC = 0x4B505342; // "BSPK"
+	const UINT32 ResourcePackage::VERSION = 2;
+	const UINT32 ResourcePackage::ENTRY_ALIGNMENT = 4096;
+
+	ResourcePackage::ResourcePackage(const MemoryMappedFilePtr& file)
+		:mFile(file), mHeader(nullptr), mEntries(nullptr), mDependencies(nullptr), mStrings(nullptr)
+	{
+		UINT64 fileSize = mFile->getSize();
+		const UINT8* data = mFile->getData();
+
+		if (fileSize < sizeof(Header))
+			BS_EXCEPT(InternalErrorException, "Invalid resource package. File is too small.");
+
+		mHeader = (const Header*)data;
+
+		if (mHeader->magic != MAGIC)
+			BS_EXCEPT(InternalErrorException, "Invalid resource package. Unrecognized file format.");
+
+		if (mHeader->version != VERSION)
+			BS_EXCEPT(InternalErrorException, "Unsupported resource package version: " + toString(mHeader->version));
+
+		UINT32 numBuckets = mHeader->numBuckets;
+		if (numBuckets == 0 || (numBuckets & (numBuckets - 1)) != 0 || mHeader->numEntries > numBuckets)
+			BS_EXCEPT(InternalErrorException, "Invalid resource package. Corrupt entry table.");
+
+		UINT64 tableSize = (UINT64)numBuckets * sizeof(Entry);
+		UINT64 dependenciesSize = (UINT64)mHeader->numDependencies * sizeof(Dependency);
+		if (mHeader->tableOffset > fileSize || tableSize > (fileSize - mHeader->tableOffset) ||
+			mHeader->dependenciesOffset > fileSize || dependenciesSize > (fileSize - mHeader->dependenciesOffset) ||
+			mHeader->stringsOffset > fileSize || mHeader->stringsSize > (fileSize - mHeader->stringsOffset))
+		{
+			BS_EXCEPT(InternalErrorException, "Invalid resource package. File is truncated.");
+		}
+
+		mEntries = (const Entry*)(data + mHeader->tableOffset);
+		mDependencies = (const Dependency*)(data + mHeader->dependenciesOffset);
+		mStrings = (const char*)(data + mHeader->stringsOffset);
+	}
+
+	bool ResourcePackage::contains(const String& uuid) const
+	{
+		return findEntry(uuid) != nullptr;
+	}
+
+	MemoryDataStreamPtr ResourcePackage::openEntry(const String& uuid) const
+	{
+		const Entry* entry = findEntry(uuid);
+		if (entry == nullptr)
+			return nullptr;
+
+		UINT64 fileSize = mFile->getSize();
+		if (entry->offset > fileSize || entry->size > (fileSize - entry->offset))
+			BS_EXCEPT(InternalErrorException, "Invalid resource package. Entry \"" + uuid + "\" is out of bounds.");
+
+		if ((entry->flags & EF_Compressed) == 0)
+			return bs_shared_ptr<MemoryMappedDataStream>(mFile, (size_t)entry->offset, (size_t)entry->size);
+
+		UINT8* uncompressedData = (UINT8*)bs_alloc(entry->uncompressedSize);
+		if (!Compression::decompress(mFile->getData() + entry->offset, entry->size, uncompressedData, entry->uncompressedSize))
+		{
+			bs_free(uncompressedData);
+			BS_EXCEPT(InternalErrorException, "Invalid resource package. Entry \"" + uuid + "\" is corrupt.");
+		}
+
+		return bs_shared_ptr<MemoryDataStream>(uncompressedData, (size_t)entry->uncompressedSize, true);
+	}
+
+	UINT32 ResourcePackage::getEntrySize(const String& uuid) const
+	{
+		const Entry* entry = findEntry(uuid);
+		if (entry == nullptr)
+			return 0;
+
+		return entry->uncompressedSize;
+	}
+
+	bool ResourcePackage::getDependencies(const String& uuid, Vector<String>& dependencies) const
+	{
+		dependencies.clear();
+
+		const Entry* entry = findEntry(uuid);
+		if (entry == nullptr)
+			return false;
+
+		if (((UINT64)entry->firstDependency + entry->numDependencies) > mHeader->numDependencies)
+			BS_EXCEPT(InternalErrorException, "Invalid resource package. Entry \"" + uuid + "\" has corrupt dependencies.");
+
+		for (UINT32 i = 0; i < entry->numDependencies; i++)
+		{
+			const Dependency& dependency = mDependencies[entry->firstDependency + i];
+			if (((UINT64)dependency.uuidOffset + dependency.uuidLength) > mHeader->stringsSize)
+				BS_EXCEPT(InternalErrorException, "Invalid resource package. Entry \"" + uuid + "\" has corrupt dependencies.");
+
+			dependencies.push_back(String(mStrings + dependency.uuidOffset, dependency.uuidLength));
+		}
+
+		return true;
+	}
+
+	UINT32 ResourcePackage::getNumEntries() const
+	{
+		return mHeader->numEntries;
+	}
+
+	const ResourcePackage::Entry* ResourcePackage::findEntry(const String& uuid) const
+	{
+		UINT64 hash = hashUUID(uuid);
+		UINT32 mask = mHeader->numBuckets - 1;
+
+		UINT32 bucketIdx = (UINT32)hash & mask;
+		for (UINT32 i = 0; i < mHeader->numBuckets; i++)
+		{
+			const Entry& entry = mEntries[bucketIdx];
+			if ((entry.flags & EF_Used) == 0)
+				return nullptr;
+
+			if (entry.uuidHash == hash && entry.uuidLength == (UINT32)uuid.size() &&
+				((UINT64)entry.uuidOffset + entry.uuidLength) <= mHeader->stringsSize &&
+				memcmp(mStrings + entry.uuidOffset, uuid.data(), entry.uuidLength) == 0)
+			{
+				return &entry;
+			}
+
+			bucketIdx = (bucketIdx + 1) & mask;
+		}
+
+		return nullptr;
+	}
+
+	UINT64 ResourcePackage::hashUUID(const String& uuid)
+	{
+		// FNV-1a
+		UINT64 hash = 14695981039346656037ULL;
+		for (auto& character : uuid)
+		{
+			hash ^= (UINT8)character;
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	ResourcePackagePtr ResourcePackage::open(const Path& filePath)
+	{
+		MemoryMappedFilePtr file = MemoryMappedFile::create(filePath);
+
+		return bs_shared_ptr<ResourcePackage>(file);
+	}
+
+	ResourcePackageWriter::ResourcePackageWriter()
+	{ }
+
+	ResourcePackageWriter::~ResourcePackageWriter()
+	{
+		for (auto& entry : mEntries)
+			bs_free(entry.data);
+	}
+
+	void ResourcePackageWriter::addEntry(const String& uuid, const UINT8* data, UINT32 size, 
+		const Vector<String>& dependencies, bool compress)
+	{
+		if (uuid.size() > std::numeric_limits<UINT16>::max())
+			BS_EXCEPT(InvalidParametersException, "Resource UUID is too long: " + uuid);
+
+		PendingEntry entry;
+		entry.uuid = uuid;
+		entry.dependencies = dependencies;
+		entry.uncompressedSize = size;
+		entry.compressed = false;
+		entry.data = nullptr;
+		entry.size = 0;
+
+		if (compress && size > 0)
+		{
+			UINT32 maxCompressedSize = Compression::getMaxCompressedSize(size);
+			UINT8* compressedData = (UINT8*)bs_alloc(maxCompressedSize);
+
+			UINT32 compressedSize = Compression::compress(data, size, compressedData, maxCompressedSize);
+			if (compressedSize > 0 && compressedSize < size)
+			{
+				entry.data = compressedData;
+				entry.size = compressedSize;
+				entry.compressed = true;
+			}
+			else
+				bs_free(compressedData);
+		}
+
+		if (!entry.compressed)
+		{
+			entry.data = (UINT8*)bs_alloc(std::max(size, 1U));
+			entry.size = size;
+			memcpy(entry.data, data, size);
+		}
+
+		// Replace the existing entry if the resource was already added
+		auto findIter = mEntryLookup.find(uuid);
+		if (findIter != mEntryLookup.end())
+		{
+			PendingEntry& existingEntry = mEntries[findIter->second];
+			bs_free(existingEntry.data);
+			existingEntry = entry;
+
+			return;
+		}
+
+		mEntryLookup[uuid] = (UINT32)mEntries.size();
+		mEntries.push_back(entry);
+	}
+
+	void ResourcePackageWriter::save(const Path& filePath)
+	{
+		typedef ResourcePackage::Header Header;
+		typedef ResourcePackage::Entry Entry;
+		typedef ResourcePackage::Dependency Dependency;
+
+		const UINT32 alignment = ResourcePackage::ENTRY_ALIGNMENT;
+		auto alignOffset = [&](UINT64 offset) { return (offset + alignment - 1) & ~((UINT64)alignment - 1); };
+
+		UINT32 numEntries = (UINT32)mEntries.size();
+		UINT32 numBuckets = 1;
+		while (numBuckets < numEntries * 2)
+			numBuckets <<= 1;
+
+		// Lay out entry data, each entry starting at an aligned offset
+		Vector<Entry> table(numBuckets);
+		memset(table.data(), 0, numBuckets * sizeof(Entry));
+
+		Vector<Dependency> dependencies;
+		String strings;
+		UINT64 offset = alignOffset(sizeof(Header));
+		UINT32 mask = numBuckets - 1;
+
+		for (auto& pendingEntry : mEntries)
+		{
+			UINT64 hash = ResourcePackage::hashUUID(pendingEntry.uuid);
+
+			UINT32 bucketIdx = (UINT32)hash & mask;
+			while ((table[bucketIdx].flags & ResourcePackage::EF_Used) != 0)
+				bucketIdx = (bucketIdx + 1) & mask;
+
+			Entry& entry = table[bucketIdx];
+			entry.uuidHash = hash;
+			entry.offset = offset;
+			entry.size = pendingEntry.size;
+			entry.uncompressedSize = pendingEntry.uncompressedSize;
+			entry.uuidOffset = (UINT32)strings.size();
+			entry.uuidLength = (UINT16)pendingEntry.uuid.size();
+			entry.flags = ResourcePackage::EF_Used;
+			entry.firstDependency = (UINT32)dependencies.size();
+			entry.numDependencies = (UINT32)pendingEntry.dependencies.size();
+
+			if (pendingEntry.compressed)
+				entry.flags |= ResourcePackage::EF_Compressed;
+
+			strings += pendingEntry.uuid;
+
+			for (auto& dependencyUUID : pendingEntry.dependencies)
+			{
+				Dependency dependency;
+				dependency.uuidOffset = (UINT32)strings.size();
+				dependency.uuidLength = (UINT32)dependencyUUID.size();
+
+				dependencies.push_back(dependency);
+				strings += dependencyUUID;
+			}
+			offset = alignOffset(offset + pendingEntry.size);
+		}
+
+		Header header;
+		header.magic = ResourcePackage::MAGIC;
+		header.version = ResourcePackage::VERSION;
+		header.numEntries = numEntries;
+		header.numBuckets = numBuckets;
+		header.tableOffset = offset;
+		header.dependenciesOffset = offset + numBuckets * sizeof(Entry);
+		header.numDependencies = (UINT32)dependencies.size();
+		header.padding = 0;
+		header.stringsOffset = header.dependenciesOffset + dependencies.size() * sizeof(Dependency);
+		header.stringsSize = strings.size();
+
+		if (FileSystem::isFile(filePath))
+			FileSystem::remove(filePath);
+
+		DataStreamPtr stream = FileSystem::createAndOpenFile(filePath);
+
+		Vector<UINT8> padding(alignment, 0);
+		UINT64 writtenBytes = 0;
+		auto writePadding = [&](UINT64 targetOffset)
+		{
+			while (writtenBytes < targetOffset)
+			{
+				UINT32 paddingSize = (UINT32)std::min(targetOffset - writtenBytes, (UINT64)alignment);
+				stream->write(padding.data(), paddingSize);
+				writtenBytes += paddingSize;
+			}
+		};
+
+		stream->write(&header, sizeof(header));
+		writtenBytes += sizeof(header);
+
+		// Entries are written in the order they were added, which matches the offsets assigned above
+		for (auto& pendingEntry : mEntries)
+		{
+			writePadding(alignOffset(writtenBytes));
+
+			stream->write(pendingEntry.data, pendingEntry.size);
+			writtenBytes += pendingEntry.size;
+		}
+
+		writePadding(header.tableOffset);
+
+		stream->write(table.data(), numBuckets * sizeof(Entry));
+
+		if (!dependencies.empty())
+			stream->write(dependencies.data(), dependencies.size() * sizeof(Dependency));
+
+		stream->write(strings.data(), strings.size());
+
+		stream->close();
+	}
+}
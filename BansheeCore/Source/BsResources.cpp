@@ -4,17 +4,26 @@
 #include "BsResources.h"
 #include "BsResource.h"
 #include "BsResourceManifest.h"
+#include "BsResourcePackage.h"
 #include "BsException.h"
 #include "BsFileSerializer.h"
+#include "BsMemorySerializer.h"
+#include "BsBinarySerializer.h"
+#include "BsDataStream.h"
 #include "BsFileSystem.h"
 #include "BsTaskScheduler.h"
+#include "BsUtility.h"
+#include "BsTime.h"
 #include "BsUUID.h"
 #include "BsPath.h"
 #include "BsDebug.h"
 
 namespace BansheeEngine
 {
+	const UINT64 Resources::DEFAULT_LOAD_MEMORY_BUDGET = 256 * 1024 * 1024;
+
 	Resources::Resources()
+		:mLoadMemoryBudget(DEFAULT_LOAD_MEMORY_BUDGET), mLoadMemoryInFlight(0), mNextLoadSequence(0)
 	{
 		mDefaultResourceManifest = ResourceManifest::create("Default");
 		mResourceManifests.push_back(mDefaultResourceManifest);
@@ -22,6 +31,26 @@ namespace BansheeEngine
 
 	Resources::~Resources()
 	{
+		// Cancel loads that haven't started yet
+		Vector<LoadRequestPtr> pendingLoads;
+		{
+			BS_LOCK_MUTEX(mInProgressResourcesMutex);
+			std::swap(pendingLoads, mPendingLoads);
+
+			for (auto& request : pendingLoads)
+			{
+				request->task->cancel();
+				mInProgressResources.erase(request->resource.getUUID());
+			}
+		}
+
+		for (auto& request : pendingLoads)
+		{
+			request->resource._abortLoad();
+			request->task = nullptr;
+			request->dependencies.clear();
+		}
+
 		// Unload and invalidate all resources
 		UnorderedMap<String, HResource> loadedResourcesCopy = mLoadedResources;
 
@@ -36,63 +65,45 @@ namespace BansheeEngine
 
 	HResource Resources::load(const Path& filePath)
 	{
-		return loadInternal(filePath, true);
+		return loadInternal(filePath, true, TaskPriority::Normal);
 	}
 
-	HResource Resources::loadAsync(const Path& filePath)
+	HResource Resources::loadAsync(const Path& filePath, TaskPriority priority)
 	{
-		return loadInternal(filePath, false);
+		return loadInternal(filePath, false, priority);
 	}
 
 	HResource Resources::loadFromUUID(const String& uuid)
 	{
-		Path filePath;
-		bool foundPath = false;
-
-		// Default manifest is at 0th index but all other take priority since Default manifest could
-		// contain obsolete data. 
-		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
-		{
-			if((*iter)->uuidToFilePath(uuid, filePath))
-			{
-				foundPath = true;
-				break;
-			}
-		}
+		if(findResourcePackage(uuid) != nullptr)
+			return loadInternal(uuid, Path::BLANK, true, TaskPriority::Normal);
 
-		if(!foundPath)
+		Path filePath;
+		if(!findFilePath(uuid, filePath))
 		{
 			gDebug().logWarning("Cannot load resource. Resource with UUID '" + uuid + "' doesn't exist.");
 			return HResource();
 		}
 
-		return load(filePath);
+		return loadInternal(uuid, filePath, true, TaskPriority::Normal);
 	}
 
-	HResource Resources::loadFromUUIDAsync(const String& uuid)
+	HResource Resources::loadFromUUIDAsync(const String& uuid, TaskPriority priority)
 	{
-		Path filePath;
-		bool foundPath = false;
-
-		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
-		{
-			if((*iter)->uuidToFilePath(uuid, filePath))
-			{
-				foundPath = true;
-				break;
-			}
-		}
+		if(findResourcePackage(uuid) != nullptr)
+			return loadInternal(uuid, Path::BLANK, false, priority);
 
-		if(!foundPath)
+		Path filePath;
+		if(!findFilePath(uuid, filePath))
 		{
 			gDebug().logWarning("Cannot load resource. Resource with UUID '" + uuid + "' doesn't exist.");
 			return HResource();
 		}
 
-		return loadAsync(filePath);
+		return loadInternal(uuid, filePath, false, priority);
 	}
 
-	HResource Resources::loadInternal(const Path& filePath, bool synchronous)
+	HResource Resources::loadInternal(const Path& filePath, bool synchronous, TaskPriority priority)
 	{
 		String uuid;
 		bool foundUUID = false;
@@ -108,6 +119,11 @@ namespace BansheeEngine
 		if(!foundUUID)
 			uuid = UUIDGenerator::instance().generateRandom();
 
+		return loadInternal(uuid, filePath, synchronous, priority);
+	}
+
+	HResource Resources::loadInternal(const String& uuid, const Path& filePath, bool synchronous, TaskPriority priority)
+	{
 		{
 			BS_LOCK_MUTEX(mLoadedResourceMutex);
 			auto iterFind = mLoadedResources.find(uuid);
@@ -117,59 +133,312 @@ namespace BansheeEngine
 			}
 		}
 
+		LoadRequestPtr request;
+		TaskPtr existingTask;
 		bool resourceLoadingInProgress = false;
-		HResource existingResource;
 
 		{
 			BS_LOCK_MUTEX(mInProgressResourcesMutex);
 			auto iterFind2 = mInProgressResources.find(uuid);
 			if(iterFind2 != mInProgressResources.end()) 
 			{
-				existingResource = iterFind2->second;
+				request = iterFind2->second;
 				resourceLoadingInProgress = true;
+
+				if(synchronous)
+				{
+					// Don't let the memory budget delay a resource someone is waiting on
+					existingTask = request->task;
+					if(existingTask != nullptr)
+						forceScheduleLoad(request);
+				}
+				else
+					raisePriority(request, priority);
+			}
+			else
+			{
+				if(synchronous)
+				{
+					request = createLoadRequest(uuid, filePath, priority);
+					if(request != nullptr)
+					{
+						// Loaded right away on this thread
+						request->scheduled = true;
+						mLoadMemoryInFlight += request->size;
+					}
+				}
+				else
+					request = queueAsyncLoad(uuid, filePath, priority);
 			}
 		}
 
-		if(resourceLoadingInProgress) // We're already loading this resource
+		if(request == nullptr)
 		{
-			if(!synchronous)
-				return existingResource;
-			else
+			// Resource could have finished loading in the meantime
+			BS_LOCK_MUTEX(mLoadedResourceMutex);
+			auto iterFind = mLoadedResources.find(uuid);
+			if(iterFind != mLoadedResources.end())
+				return iterFind->second;
+
+			return HResource();
+		}
+
+		HResource resource = request->resource;
+		if(resourceLoadingInProgress)
+		{
+			if(synchronous) // Previously being loaded as async but now we want it synced, so we wait
 			{
-				// Previously being loaded as async but now we want it synced, so we wait
-				existingResource.synchronize();
+				if(existingTask != nullptr)
+					existingTask->wait();
 
-				return existingResource;
+				resource.synchronize();
 			}
+
+			return resource;
 		}
 
-		if(!FileSystem::isFile(filePath))
+		// Start loading dependencies, and for async loads the resource itself
+		processPendingLoads();
+
+		if(synchronous)
+			loadCallback(request);
+
+		return resource;
+	}
+
+	Resources::LoadRequestPtr Resources::createLoadRequest(const String& uuid, const Path& filePath, TaskPriority priority)
+	{
+		ResourcePackagePtr package = findResourcePackage(uuid);
+		if(package == nullptr && !FileSystem::isFile(filePath))
 		{
 			gDebug().logWarning("Specified file: " + filePath.toString() + " doesn't exist.");
-			return HResource();
+			return nullptr;
 		}
 
-		HResource newResource(uuid);
+		LoadRequestPtr request = bs_shared_ptr<LoadRequest>();
+		request->resource = HResource(uuid);
+		request->filePath = filePath;
+		request->package = package;
+		request->priority = priority;
+		request->requestTime = gTime().getTimePrecise();
+		request->scheduled = false;
 
+		Vector<String> dependencies;
+		if(package != nullptr)
 		{
-			BS_LOCK_MUTEX(mInProgressResourcesMutex);
-			mInProgressResources[uuid] = newResource;
+			request->size = package->getEntrySize(uuid);
+			package->getDependencies(uuid, dependencies);
 		}
+		else
+		{
+			request->size = FileSystem::getFileSize(filePath);
 
-		if(synchronous)
+			for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
+			{
+				if((*iter)->getDependencies(uuid, dependencies))
+					break;
+			}
+		}
+
+		// Register before starting dependency loads so that cyclic references find this request
+		mInProgressResources[uuid] = request;
+
+		for(auto& dependencyUUID : dependencies)
 		{
-			loadCallback(filePath, newResource);
+			{
+				BS_LOCK_MUTEX(mLoadedResourceMutex);
+				if(mLoadedResources.find(dependencyUUID) != mLoadedResources.end())
+					continue;
+			}
+
+			Path dependencyPath;
+			if(findResourcePackage(dependencyUUID) == nullptr && !findFilePath(dependencyUUID, dependencyPath))
+				continue;
+
+			LoadRequestPtr dependency = queueAsyncLoad(dependencyUUID, dependencyPath, priority);
+			if(dependency != nullptr)
+				request->dependencies.push_back(dependency);
 		}
-		else
+
+		// Assigned after dependencies so they are always scheduled before the request. Otherwise the request
+		// could take up the memory budget while blocked on dependencies the budget no longer lets through.
+		// (Dependencies never have lower priority than the request, as priority raises propagate to them.)
+		request->sequence = mNextLoadSequence++;
+
+		return request;
+	}
+
+	Resources::LoadRequestPtr Resources::queueAsyncLoad(const String& uuid, const Path& filePath, TaskPriority priority)
+	{
+		auto iterFind = mInProgressResources.find(uuid);
+		if(iterFind != mInProgressResources.end())
+		{
+			raisePriority(iterFind->second, priority);
+			return iterFind->second;
+		}
+
+		{
+			BS_LOCK_MUTEX(mLoadedResourceMutex);
+			if(mLoadedResources.find(uuid) != mLoadedResources.end())
+				return nullptr;
+		}
+
+		LoadRequestPtr request = createLoadRequest(uuid, filePath, priority);
+		if(request == nullptr)
+			return nullptr;
+
+		// Requests without a task are either loaded synchronously or part of a reference cycle. The latter are 
+		// skipped here and instead loaded when they are referenced during deserialization.
+		Vector<TaskPtr> dependencyTasks;
+		for(auto& dependency : request->dependencies)
 		{
-			String fileName = filePath.getFilename();
-			String taskName = "Resource load: " + fileName;
+			if(dependency->task != nullptr)
+				dependencyTasks.push_back(dependency->task);
+		}
+
+		String fileName = request->package != nullptr ? uuid : filePath.getFilename();
+		String taskName = "Resource load: " + fileName;
+
+		request->task = Task::create(taskName, std::bind(&Resources::loadCallback, this, request), priority, dependencyTasks);
+		insertPendingLoad(request);
+
+		return request;
+	}
+
+	void Resources::raisePriority(const LoadRequestPtr& request, TaskPriority priority)
+	{
+		if((UINT32)priority <= (UINT32)request->priority)
+			return;
 
-			TaskPtr task = Task::create(taskName, std::bind(&Resources::loadCallback, this, filePath, newResource));
-			TaskScheduler::instance().addTask(task);
+		request->priority = priority;
+		if(!request->scheduled && request->task != nullptr)
+		{
+			removePendingLoad(request);
+			insertPendingLoad(request);
 		}
 
-		return newResource;
+		for(auto& dependency : request->dependencies)
+			raisePriority(dependency, priority);
+	}
+
+	void Resources::insertPendingLoad(const LoadRequestPtr& request)
+	{
+		auto iterFind = std::upper_bound(mPendingLoads.begin(), mPendingLoads.end(), request, 
+			[](const LoadRequestPtr& a, const LoadRequestPtr& b)
+		{
+			if(a->priority != b->priority)
+				return (UINT32)a->priority > (UINT32)b->priority;
+
+			return a->sequence < b->sequence;
+		});
+
+		mPendingLoads.insert(iterFind, request);
+	}
+
+	void Resources::removePendingLoad(const LoadRequestPtr& request)
+	{
+		auto iterFind = std::find(mPendingLoads.begin(), mPendingLoads.end(), request);
+		if(iterFind != mPendingLoads.end())
+			mPendingLoads.erase(iterFind);
+	}
+
+	void Resources::scheduleLoad(const LoadRequestPtr& request)
+	{
+		request->scheduled = true;
+		mLoadMemoryInFlight += request->size;
+
+		// Queued while holding the lock, so that a request marked as scheduled always has a queued task
+		TaskScheduler::instance().addTask(request->task);
+	}
+
+	void Resources::forceScheduleLoad(const LoadRequestPtr& request)
+	{
+		if(request->scheduled)
+			return;
+
+		removePendingLoad(request);
+		scheduleLoad(request);
+
+		for(auto& dependency : request->dependencies)
+		{
+			if(dependency->task != nullptr)
+				forceScheduleLoad(dependency);
+		}
+	}
+
+	void Resources::processPendingLoads()
+	{
+		BS_LOCK_MUTEX(mInProgressResourcesMutex);
+		while(!mPendingLoads.empty())
+		{
+			LoadRequestPtr request = mPendingLoads.front();
+
+			// Always allow at least one load in flight, so resources larger than the budget still load
+			if(mLoadMemoryInFlight > 0 && (mLoadMemoryInFlight + request->size) > mLoadMemoryBudget)
+				break;
+
+			mPendingLoads.erase(mPendingLoads.begin());
+			scheduleLoad(request);
+		}
+	}
+
+	bool Resources::cancelLoad(const HResource& resource)
+	{
+		LoadRequestPtr request;
+
+		{
+			BS_LOCK_MUTEX(mInProgressResourcesMutex);
+			auto iterFind = mInProgressResources.find(resource.getUUID());
+			if(iterFind == mInProgressResources.end())
+				return false;
+
+			request = iterFind->second;
+			if(request->task == nullptr) // Being loaded synchronously
+				return false;
+
+			// Cancel also releases any loads depending on this one
+			request->task->cancel();
+			if(!request->task->isCanceled())
+				return false;
+
+			if(request->scheduled)
+				mLoadMemoryInFlight -= request->size;
+			else
+				removePendingLoad(request);
+
+			mInProgressResources.erase(iterFind);
+
+			request->task = nullptr;
+			request->dependencies.clear();
+		}
+
+		request->resource._abortLoad();
+		processPendingLoads();
+
+		return true;
+	}
+
+	void Resources::setLoadMemoryBudget(UINT64 budget)
+	{
+		{
+			BS_LOCK_MUTEX(mInProgressResourcesMutex);
+			mLoadMemoryBudget = budget;
+		}
+
+		processPendingLoads();
+	}
+
+	bool Resources::findFilePath(const String& uuid, Path& filePath) const
+	{
+		// Default manifest is at 0th index but all other take priority since Default manifest could
+		// contain obsolete data. 
+		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
+		{
+			if((*iter)->uuidToFilePath(uuid, filePath))
+				return true;
+		}
+
+		return false;
 	}
 
 	ResourcePtr Resources::loadFromDiskAndDeserialize(const Path& filePath)
@@ -187,6 +456,26 @@ namespace BansheeEngine
 		return resource;
 	}
 
+	ResourcePtr Resources::loadFromPackageAndDeserialize(const ResourcePackagePtr& package, const String& uuid)
+	{
+		MemoryDataStreamPtr stream = package->openEntry(uuid);
+		if(stream == nullptr)
+			BS_EXCEPT(InternalErrorException, "Unable to load resource. Resource package entry is missing.");
+
+		// Decode straight from the stream memory, which for uncompressed entries is the mapped package file
+		BinarySerializer bs;
+		std::shared_ptr<IReflectable> loadedData = bs.decode(stream->getPtr(), (UINT32)stream->size());
+
+		if(loadedData == nullptr)
+			BS_EXCEPT(InternalErrorException, "Unable to load resource.");
+
+		if(!loadedData->isDerivedFrom(Resource::getRTTIStatic()))
+			BS_EXCEPT(InternalErrorException, "Loaded class doesn't derive from Resource.");
+
+		ResourcePtr resource = std::static_pointer_cast<Resource>(loadedData);
+		return resource;
+	}
+
 	void Resources::unload(HResource resource)
 	{
 		if(!resource.isLoaded()) // If it's still loading wait until that finishes
@@ -234,11 +523,33 @@ namespace BansheeEngine
 		}
 
 		mDefaultResourceManifest->registerResource(resource.getUUID(), filePath);
+		mDefaultResourceManifest->registerDependencies(resource.getUUID(), Utility::findResourceDependencies(*resource.get()));
 
 		FileSerializer fs;
 		fs.encode(resource.get(), filePath);
 	}
 
+	void Resources::saveToPackage(const Vector<HResource>& resources, const Path& filePath, bool compress)
+	{
+		ResourcePackageWriter writer;
+		for(auto& resource : resources)
+		{
+			if(!resource.isLoaded())
+				resource.synchronize();
+
+			MemorySerializer ms;
+			UINT32 dataSize = 0;
+			UINT8* data = ms.encode(resource.get(), dataSize);
+
+			Vector<String> dependencies = Utility::findResourceDependencies(*resource.get());
+
+			writer.addEntry(resource.getUUID(), data, dataSize, dependencies, compress);
+			bs_free(data);
+		}
+
+		writer.save(filePath);
+	}
+
 	void Resources::registerResourceManifest(const ResourceManifestPtr& manifest)
 	{
 		if(manifest->getName() == "Default")
@@ -262,6 +573,31 @@ namespace BansheeEngine
 		return nullptr;
 	}
 
+	void Resources::registerResourcePackage(const ResourcePackagePtr& package)
+	{
+		auto findIter = std::find(mResourcePackages.begin(), mResourcePackages.end(), package);
+		if(findIter == mResourcePackages.end())
+			mResourcePackages.push_back(package);
+	}
+
+	void Resources::unregisterResourcePackage(const ResourcePackagePtr& package)
+	{
+		auto findIter = std::find(mResourcePackages.begin(), mResourcePackages.end(), package);
+		if(findIter != mResourcePackages.end())
+			mResourcePackages.erase(findIter);
+	}
+
+	ResourcePackagePtr Resources::findResourcePackage(const String& uuid) const
+	{
+		for(auto iter = mResourcePackages.rbegin(); iter != mResourcePackages.rend(); ++iter)
+		{
+			if((*iter)->contains(uuid))
+				return *iter;
+		}
+
+		return nullptr;
+	}
+
 	HResource Resources::_createResourceHandle(const ResourcePtr& obj)
 	{
 		String uuid = UUIDGenerator::instance().generateRandom();
@@ -298,21 +634,61 @@ namespace BansheeEngine
 		return false;
 	}
 
-	void Resources::loadCallback(const Path& filePath, HResource& resource)
+	void Resources::loadCallback(const LoadRequestPtr& request)
 	{
-		ResourcePtr rawResource = loadFromDiskAndDeserialize(filePath);
+		HResource resource = request->resource;
+		const String& uuid = resource.getUUID();
 
+		UINT64 startTime = gTime().getTimePrecise();
+
+		ResourcePtr rawResource;
+		try
 		{
-			BS_LOCK_MUTEX(mInProgressResourcesMutex);
-			mInProgressResources.erase(resource.getUUID());
+			if(request->package != nullptr)
+				rawResource = loadFromPackageAndDeserialize(request->package, uuid);
+			else
+				rawResource = loadFromDiskAndDeserialize(request->filePath);
+		}
+		catch(...)
+		{
+			// Failed loads must not keep holding the memory budget, or block later attempts to load the resource
+			releaseLoadRequest(request);
+			processPendingLoads();
+
+			throw;
 		}
 
-		resource._setHandleData(rawResource, resource.getUUID());
+		UINT64 endTime = gTime().getTimePrecise();
+
+		releaseLoadRequest(request);
+
+		resource._setHandleData(rawResource, uuid);
 
 		{
 			BS_LOCK_MUTEX(mLoadedResourceMutex);
-			mLoadedResources[resource.getUUID()] = resource;
+			mLoadedResources[uuid] = resource;
 		}
+
+		ResourceLoadTiming timing;
+		timing.uuid = uuid;
+		timing.size = request->size;
+		timing.queuedTime = startTime - request->requestTime;
+		timing.loadTime = endTime - startTime;
+
+		onResourceLoaded(timing);
+
+		processPendingLoads();
+	}
+
+	void Resources::releaseLoadRequest(const LoadRequestPtr& request)
+	{
+		BS_LOCK_MUTEX(mInProgressResourcesMutex);
+		mInProgressResources.erase(request->resource.getUUID());
+		mLoadMemoryInFlight -= request->size;
+
+		// Break reference cycles between the request, its task and its dependencies
+		request->task = nullptr;
+		request->dependencies.clear();
 	}
 
 	BS_CORE_EXPORT Resources& gResources()
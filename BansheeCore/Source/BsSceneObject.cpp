@@ -9,14 +9,12 @@
 #include "BsSceneObjectRTTI.h"
 #include "BsMemorySerializer.h"
 #include "BsGameObjectManager.h"
+#include "BsTransformManager.h"
 
 namespace BansheeEngine
 {
 	SceneObject::SceneObject(const String& name)
-		:GameObject(), mPosition(Vector3::ZERO), mRotation(Quaternion::IDENTITY), mScale(Vector3::ONE),
-		mWorldPosition(Vector3::ZERO), mWorldRotation(Quaternion::IDENTITY), mWorldScale(Vector3::ONE),
-		mCachedLocalTfrm(Matrix4::IDENTITY), mIsCachedLocalTfrmUpToDate(false),
-		mCachedWorldTfrm(Matrix4::IDENTITY), mIsCachedWorldTfrmUpToDate(false), mIsCoreDirtyFlags(0xFFFFFFFF)
+		:GameObject(), mTransformId(TransformManager::instance().create())
 	{
 		setName(name);
 	}
@@ -72,15 +70,18 @@ namespace BansheeEngine
 
 		for(auto iter = mComponents.begin(); iter != mComponents.end(); ++iter)
 		{
+			gSceneManager().unregisterComponentUpdate((*iter).get());
 			gSceneManager().notifyComponentRemoved((*iter));
 			GameObjectManager::instance().unregisterObject(*iter);
-			(*iter).destroy();
 		}
 
 		mComponents.clear();
 
+		if (TransformManager::isStarted())
+			TransformManager::instance().destroy(mTransformId);
+
+		// Must be last, as this object is destroyed once unregistered
 		GameObjectManager::instance().unregisterObject(mThisHandle);
-		mThisHandle.destroy();
 	}
 
 	/************************************************************************/
@@ -89,20 +90,17 @@ namespace BansheeEngine
 
 	void SceneObject::setPosition(const Vector3& position)
 	{
-		mPosition = position;
-		markTfrmDirty();
+		TransformManager::instance().setPosition(mTransformId, position);
 	}
 
 	void SceneObject::setRotation(const Quaternion& rotation)
 	{
-		mRotation = rotation;
-		markTfrmDirty();
+		TransformManager::instance().setRotation(mTransformId, rotation);
 	}
 
 	void SceneObject::setScale(const Vector3& scale)
 	{
-		mScale = scale;
-		markTfrmDirty();
+		TransformManager::instance().setScale(mTransformId, scale);
 	}
 
 	void SceneObject::setWorldPosition(const Vector3& position)
@@ -116,12 +114,10 @@ namespace BansheeEngine
 
 			Quaternion invRotation = mParent->getWorldRotation().inverse();
 
-			mPosition = invRotation.rotate(position - mParent->getWorldPosition()) *  invScale;
+			setPosition(invRotation.rotate(position - mParent->getWorldPosition()) *  invScale);
 		}
 		else
-			mPosition = position;
-
-		markTfrmDirty();
+			setPosition(position);
 	}
 
 	void SceneObject::setWorldRotation(const Quaternion& rotation)
@@ -130,41 +126,45 @@ namespace BansheeEngine
 		{
 			Quaternion invRotation = mParent->getWorldRotation().inverse();
 
-			mRotation = invRotation * rotation;
+			setRotation(invRotation * rotation);
 		}
 		else
-			mRotation = rotation;
+			setRotation(rotation);
+	}
 
-		markTfrmDirty();
+	Vector3 SceneObject::getPosition() const
+	{
+		return TransformManager::instance().getPosition(mTransformId);
 	}
 
-	const Vector3& SceneObject::getWorldPosition() const
-	{ 
-		if(!mIsCachedWorldTfrmUpToDate)
-			updateWorldTfrm();
+	Quaternion SceneObject::getRotation() const
+	{
+		return TransformManager::instance().getRotation(mTransformId);
+	}
 
-		return mWorldPosition; 
+	Vector3 SceneObject::getScale() const
+	{
+		return TransformManager::instance().getScale(mTransformId);
 	}
 
-	const Quaternion& SceneObject::getWorldRotation() const 
+	Vector3 SceneObject::getWorldPosition() const
 	{ 
-		if(!mIsCachedWorldTfrmUpToDate)
-			updateWorldTfrm();
-
-		return mWorldRotation; 
+		return TransformManager::instance().getWorldPosition(mTransformId);
 	}
 
-	const Vector3& SceneObject::getWorldScale() const 
+	Quaternion SceneObject::getWorldRotation() const 
 	{ 
-		if(!mIsCachedWorldTfrmUpToDate)
-			updateWorldTfrm();
+		return TransformManager::instance().getWorldRotation(mTransformId);
+	}
 
-		return mWorldScale; 
+	Vector3 SceneObject::getWorldScale() const 
+	{ 
+		return TransformManager::instance().getWorldScale(mTransformId);
 	}
 
 	void SceneObject::lookAt(const Vector3& location, const Vector3& up)
 	{
-		Vector3 forward = location - mPosition;
+		Vector3 forward = location - getPosition();
 		forward.normalize();
 
 		setForward(forward);
@@ -173,33 +173,27 @@ namespace BansheeEngine
 		setRotation(getRotation() * upRot);
 	}
 
-	const Matrix4& SceneObject::getWorldTfrm() const
+	Matrix4 SceneObject::getWorldTfrm() const
 	{
-		if(!mIsCachedWorldTfrmUpToDate)
-			updateWorldTfrm();
-
-		return mCachedWorldTfrm;
+		return TransformManager::instance().getWorldTfrm(mTransformId);
 	}
 
-	const Matrix4& SceneObject::getLocalTfrm() const
+	Matrix4 SceneObject::getLocalTfrm() const
 	{
-		if(!mIsCachedLocalTfrmUpToDate)
-			updateLocalTfrm();
-
-		return mCachedLocalTfrm;
+		return TransformManager::instance().getLocalTfrm(mTransformId);
 	}
 
 	void SceneObject::move(const Vector3& vec)
 	{
-		setPosition(mPosition + vec);
+		setPosition(getPosition() + vec);
 	}
 
 	void SceneObject::moveRelative(const Vector3& vec)
 	{
 		// Transform the axes of the relative vector by camera's local axes
-		Vector3 trans = mRotation.rotate(vec);
+		Vector3 trans = getRotation().rotate(vec);
 
-		setPosition(mPosition + trans);
+		setPosition(getPosition() + trans);
 	}
 
 	void SceneObject::rotate(const Vector3& axis, const Radian& angle)
@@ -216,26 +210,26 @@ namespace BansheeEngine
 		// Normalize the quat to avoid cumulative problems with precision
 		Quaternion qnorm = q;
 		qnorm.normalize();
-		setRotation(qnorm * mRotation);
+		setRotation(qnorm * getRotation());
 	}
 
 	void SceneObject::roll(const Radian& angle)
 	{
 		// Rotate around local Z axis
-		Vector3 zAxis = mRotation.rotate(Vector3::UNIT_Z);
+		Vector3 zAxis = getRotation().rotate(Vector3::UNIT_Z);
 		rotate(zAxis, angle);
 	}
 
 	void SceneObject::yaw(const Radian& angle)
 	{
-		Vector3 yAxis = mRotation.rotate(Vector3::UNIT_Y);
+		Vector3 yAxis = getRotation().rotate(Vector3::UNIT_Y);
 		rotate(yAxis, angle);
 	}
 
 	void SceneObject::pitch(const Radian& angle)
 	{
 		// Rotate around local X axis
-		Vector3 xAxis = mRotation.rotate(Vector3::UNIT_X);
+		Vector3 xAxis = getRotation().rotate(Vector3::UNIT_X);
 		rotate(xAxis, angle);
 	}
 
@@ -267,64 +261,17 @@ namespace BansheeEngine
 
 	void SceneObject::updateTransformsIfDirty()
 	{
-		if (!mIsCachedLocalTfrmUpToDate)
-			updateLocalTfrm();
-
-		if (!mIsCachedWorldTfrmUpToDate)
-			updateWorldTfrm();
-	}
-
-	void SceneObject::markTfrmDirty() const
-	{
-		mIsCachedLocalTfrmUpToDate = false;
-		mIsCachedWorldTfrmUpToDate = false;
-		mIsCoreDirtyFlags = 0xFFFFFFFF;
-
-		for(auto iter = mChildren.begin(); iter != mChildren.end(); ++iter)
-		{
-			(*iter)->markTfrmDirty();
-		}
+		TransformManager::instance().updateIfDirty(mTransformId);
 	}
 
-	void SceneObject::updateWorldTfrm() const
+	bool SceneObject::_isCoreDirty() const
 	{
-		if(mParent != nullptr)
-		{
-			mCachedWorldTfrm = getLocalTfrm() * mParent->getWorldTfrm();
-
-			// Update orientation
-			const Quaternion& parentOrientation = mParent->getWorldRotation();
-			mWorldRotation = parentOrientation * mRotation;
-
-			// Update scale
-			const Vector3& parentScale = mParent->getWorldScale();
-			// Scale own position by parent scale, just combine
-			// as equivalent axes, no shearing
-			mWorldScale = parentScale * mScale;
-
-			// Change position vector based on parent's orientation & scale
-			mWorldPosition = parentOrientation.rotate(parentScale * mPosition);
-
-			// Add altered position vector to parents
-			mWorldPosition += mParent->getWorldPosition();
-		}
-		else
-		{
-			mCachedWorldTfrm = getLocalTfrm();
-
-			mWorldRotation = mRotation;
-			mWorldPosition = mPosition;
-			mWorldScale = mScale;
-		}
-
-		mIsCachedWorldTfrmUpToDate = true;
+		return TransformManager::instance().isCoreDirty(mTransformId);
 	}
 
-	void SceneObject::updateLocalTfrm() const
+	void SceneObject::_markCoreClean()
 	{
-		mCachedLocalTfrm.setTRS(mPosition, mRotation, mScale);
-
-		mIsCachedLocalTfrmUpToDate = true;
+		TransformManager::instance().markCoreClean(mTransformId);
 	}
 
 	/************************************************************************/
@@ -345,10 +292,14 @@ namespace BansheeEngine
 				mParent->removeChild(mThisHandle);
 
 			if(parent != nullptr)
+			{
 				parent->addChild(mThisHandle);
+				TransformManager::instance().setParent(mTransformId, parent->mTransformId);
+			}
+			else
+				TransformManager::instance().setParent(mTransformId, TransformManager::INVALID_ID);
 
 			mParent = parent;
-			markTfrmDirty();
 		}
 	}
 
@@ -429,11 +380,11 @@ namespace BansheeEngine
 
 		if(iter != mComponents.end())
 		{
+			gSceneManager().unregisterComponentUpdate((*iter).get());
 			gSceneManager().notifyComponentRemoved((*iter));
-			GameObjectManager::instance().unregisterObject(component);
-
 			(*iter)->onDestroyed();
-			(*iter).destroy();
+
+			GameObjectManager::instance().unregisterObject(component);
 			mComponents.erase(iter);
 		}
 		else
@@ -448,7 +399,7 @@ namespace BansheeEngine
 			if(x.isDestroyed())
 				return false;
 
-			return x._getHandleData()->mPtr->object.get() == component; }
+			return x.get() == component; }
 		);
 
 		if(iterFind != mComponents.end())
@@ -464,6 +415,7 @@ namespace BansheeEngine
 		mComponents.push_back(newComponent);
 
 		gSceneManager().notifyComponentAdded(newComponent);
+		gSceneManager().registerComponentUpdate(newComponent.get());
 	}
 
 	RTTITypeBase* SceneObject::getRTTIStatic()
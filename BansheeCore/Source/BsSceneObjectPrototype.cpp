@@ -0,0 +1,438 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsSceneObjectPrototype.h"
+#include "BsSceneObject.h"
+#include "BsGameObjectManager.h"
+#include "BsRTTIType.h"
+#include "BsRTTIPlainField.h"
+#include "BsRTTIReflectableField.h"
+#include "BsRTTIReflectablePtrField.h"
+#include "BsRTTIManagedDataBlockField.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Unique ID of the GameObject instance ID field, as registered by GameObjectRTTI.
+	 */
+	static const UINT16 GAME_OBJECT_INSTANCE_ID_FIELD = 0;
+
+	/**
+	 * @brief	Starts game object deserialization unless it is already active, and ends it on
+	 *			destruction, including when an exception is thrown.
+	 */
+	class GameObjectDeserializationScope
+	{
+	public:
+		GameObjectDeserializationScope(GameObjectManager& gameObjectManager)
+			:mGameObjectManager(gameObjectManager), mStartedDeserialization(!gameObjectManager.isGameObjectDeserializationActive())
+		{
+			if(mStartedDeserialization)
+				mGameObjectManager.startDeserialization();
+		}
+
+		~GameObjectDeserializationScope()
+		{
+			if(mStartedDeserialization)
+				mGameObjectManager.endDeserialization();
+		}
+
+	private:
+		GameObjectManager& mGameObjectManager;
+		bool mStartedDeserialization;
+	};
+
+	SceneObjectPrototype::SceneObjectPrototype(const HSceneObject& root)
+	{
+		findOrQueuePointer(root.getInternalPtr());
+
+		// Objects referenced by pointers get queued as they are encountered, so the queue may grow while iterating
+		for(UINT32 i = 0; i < (UINT32)mRecordQueue.size(); i++)
+			recordFields(mPointerObjects[i], mRecordQueue[i].get());
+
+		// Handles can only be mapped once all game objects in the hierarchy were recorded
+		for(auto& entry : mObjects)
+		{
+			if(entry.kind != ObjectKind::Handle)
+				continue;
+
+			auto findIter = mGameObjectLookup.find(entry.handleId);
+			if(findIter != mGameObjectLookup.end())
+				entry.handleTarget = (INT32)findIter->second;
+		}
+
+		// Release references to the source hierarchy, they're only needed while recording
+		mPointerLookup.clear();
+		mGameObjectLookup.clear();
+		mRecordQueue.clear();
+	}
+
+	HSceneObject SceneObjectPrototype::instantiate() const
+	{
+		Vector<HSceneObject> output;
+		instantiate(1, output);
+
+		return output[0];
+	}
+
+	void SceneObjectPrototype::instantiate(UINT32 count, Vector<HSceneObject>& output) const
+	{
+		GameObjectManager& gameObjectManager = GameObjectManager::instance();
+
+		// Keep the same environment as regular deserialization for any RTTI callbacks that rely on it
+		GameObjectDeserializationScope deserializationScope(gameObjectManager);
+
+		Vector<std::shared_ptr<IReflectable>> objects(mObjects.size());
+		Vector<bool> assigned(mObjects.size());
+
+		output.reserve(output.size() + count);
+		for(UINT32 i = 0; i < count; i++)
+		{
+			instantiateInternal(objects, assigned);
+
+			GameObject* root = static_cast<GameObject*>(objects[mPointerObjects[0]].get());
+			output.push_back(gameObjectManager.getObject(root->getInstanceId()));
+		}
+	}
+
+	INT32 SceneObjectPrototype::findOrQueuePointer(const std::shared_ptr<IReflectable>& object)
+	{
+		if(object == nullptr)
+			return -1;
+
+		auto findIter = mPointerLookup.find(object.get());
+		if(findIter != mPointerLookup.end())
+			return (INT32)findIter->second;
+
+		UINT32 idx = addObject(object.get(), ObjectKind::Pointer);
+
+		mPointerLookup[object.get()] = idx;
+		mPointerObjects.push_back(idx);
+		mRecordQueue.push_back(object);
+
+		return (INT32)idx;
+	}
+
+	UINT32 SceneObjectPrototype::addObject(IReflectable* object, ObjectKind kind)
+	{
+		ObjectEntry entry;
+		entry.kind = kind;
+		entry.type = object->getRTTI();
+		entry.firstClass = 0;
+		entry.numClasses = 0;
+		entry.handleId = 0;
+		entry.handleTarget = -1;
+
+		if(kind == ObjectKind::Handle)
+			entry.handleId = static_cast<GameObjectHandleBase*>(object)->getInstanceId();
+
+		mObjects.push_back(entry);
+		return (UINT32)mObjects.size() - 1;
+	}
+
+	UINT32 SceneObjectPrototype::recordValue(IReflectable& value)
+	{
+		if(value.getRTTI()->getRTTIId() == TID_GameObjectHandleBase)
+			return addObject(&value, ObjectKind::Handle);
+
+		UINT32 idx = addObject(&value, ObjectKind::Value);
+		recordFields(idx, &value);
+
+		return idx;
+	}
+
+	void SceneObjectPrototype::recordFields(UINT32 objectIdx, IReflectable* object)
+	{
+		// Value objects are recorded recursively as they are encountered, so entries for this object are
+		// collected locally and only appended once all of its fields are done, to keep them contiguous
+		Vector<ClassEntry> classes;
+
+		RTTITypeBase* si = object->getRTTI();
+		while(si != nullptr)
+		{
+			bool isGameObject = si->getRTTIId() == TID_GameObject;
+			if(isGameObject)
+				mGameObjectLookup[static_cast<GameObject*>(object)->getInstanceId()] = objectIdx;
+
+			si->onSerializationStarted(object);
+
+			Vector<FieldEntry> fields;
+			UINT32 numFields = si->getNumFields();
+			for(UINT32 i = 0; i < numFields; i++)
+			{
+				RTTIField* curGenericField = si->getField(i);
+
+				// Only used for mapping serialized IDs to new ones, which is unnecessary as handles are mapped directly
+				if(isGameObject && curGenericField->mUniqueId == GAME_OBJECT_INSTANCE_ID_FIELD)
+					continue;
+
+				FieldEntry fieldEntry;
+				fieldEntry.field = curGenericField;
+				fieldEntry.numElements = 1;
+				fieldEntry.offset = 0;
+
+				switch(curGenericField->mType)
+				{
+				case SerializableFT_Plain:
+					{
+						RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+						fieldEntry.offset = (UINT32)mData.size();
+						if(curField->mIsVectorType)
+						{
+							fieldEntry.numElements = curField->getArraySize(object);
+							for(UINT32 j = 0; j < fieldEntry.numElements; j++)
+							{
+								UINT32 typeSize = curField->hasDynamicSize() ? curField->getArrayElemDynamicSize(object, j) : curField->getTypeSize();
+
+								UINT32 elemOffset = (UINT32)mData.size();
+								mData.resize(elemOffset + typeSize);
+								curField->arrayElemToBuffer(object, j, &mData[elemOffset]);
+							}
+						}
+						else
+						{
+							UINT32 typeSize = curField->hasDynamicSize() ? curField->getDynamicSize(object) : curField->getTypeSize();
+
+							mData.resize(fieldEntry.offset + typeSize);
+							curField->toBuffer(object, &mData[fieldEntry.offset]);
+						}
+
+						break;
+					}
+				case SerializableFT_DataBlock:
+					{
+						RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
+						ManagedDataBlock value = curField->getValue(object);
+
+						fieldEntry.offset = (UINT32)mData.size();
+						fieldEntry.numElements = value.getSize();
+
+						if(fieldEntry.numElements > 0)
+						{
+							mData.resize(fieldEntry.offset + fieldEntry.numElements);
+							memcpy(&mData[fieldEntry.offset], value.getData(), fieldEntry.numElements);
+						}
+
+						break;
+					}
+				case SerializableFT_Reflectable:
+					{
+						RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+						Vector<INT32> references;
+						if(curField->mIsVectorType)
+						{
+							fieldEntry.numElements = curField->getArraySize(object);
+							for(UINT32 j = 0; j < fieldEntry.numElements; j++)
+								references.push_back((INT32)recordValue(curField->getArrayValue(object, j)));
+						}
+						else
+							references.push_back((INT32)recordValue(curField->getValue(object)));
+
+						fieldEntry.offset = (UINT32)mReferences.size();
+						mReferences.insert(mReferences.end(), references.begin(), references.end());
+
+						break;
+					}
+				case SerializableFT_ReflectablePtr:
+					{
+						RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+						fieldEntry.offset = (UINT32)mReferences.size();
+						if(curField->mIsVectorType)
+						{
+							fieldEntry.numElements = curField->getArraySize(object);
+							for(UINT32 j = 0; j < fieldEntry.numElements; j++)
+								mReferences.push_back(findOrQueuePointer(curField->getArrayValue(object, j)));
+						}
+						else
+							mReferences.push_back(findOrQueuePointer(curField->getValue(object)));
+
+						break;
+					}
+				}
+
+				fields.push_back(fieldEntry);
+			}
+
+			si->onSerializationEnded(object);
+
+			ClassEntry classEntry;
+			classEntry.type = si;
+			classEntry.firstField = (UINT32)mFields.size();
+			classEntry.numFields = (UINT32)fields.size();
+
+			mFields.insert(mFields.end(), fields.begin(), fields.end());
+			classes.push_back(classEntry);
+
+			si = si->getBaseClass();
+		}
+
+		mObjects[objectIdx].firstClass = (UINT32)mClasses.size();
+		mObjects[objectIdx].numClasses = (UINT32)classes.size();
+		mClasses.insert(mClasses.end(), classes.begin(), classes.end());
+	}
+
+	void SceneObjectPrototype::instantiateInternal(Vector<std::shared_ptr<IReflectable>>& objects, Vector<bool>& assigned) const
+	{
+		// Create all objects referenced by pointers first, so the game objects are registered and can be
+		// referenced by handles before any fields are assigned
+		for(auto& idx : mPointerObjects)
+		{
+			objects[idx] = mObjects[idx].type->newRTTIObject();
+			assigned[idx] = false;
+		}
+
+		for(auto& idx : mPointerObjects)
+		{
+			if(!assigned[idx])
+				assignFields(idx, objects, assigned);
+		}
+	}
+
+	void SceneObjectPrototype::assignFields(UINT32 objectIdx, Vector<std::shared_ptr<IReflectable>>& objects, Vector<bool>& assigned) const
+	{
+		assigned[objectIdx] = true;
+
+		const ObjectEntry& entry = mObjects[objectIdx];
+		IReflectable* object = objects[objectIdx].get();
+
+		for(UINT32 i = 0; i < entry.numClasses; i++)
+		{
+			const ClassEntry& classEntry = mClasses[entry.firstClass + i];
+			classEntry.type->onDeserializationStarted(object);
+
+			for(UINT32 j = 0; j < classEntry.numFields; j++)
+			{
+				const FieldEntry& fieldEntry = mFields[classEntry.firstField + j];
+				RTTIField* curGenericField = fieldEntry.field;
+
+				switch(curGenericField->mType)
+				{
+				case SerializableFT_Plain:
+					{
+						RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+						// Values are only read from, even though the field interface expects a non-const buffer
+						UINT8* data = const_cast<UINT8*>(mData.data()) + fieldEntry.offset;
+						if(curField->mIsVectorType)
+						{
+							curField->setArraySize(object, fieldEntry.numElements);
+
+							for(UINT32 k = 0; k < fieldEntry.numElements; k++)
+							{
+								UINT32 typeSize = curField->getTypeSize();
+								if(curField->hasDynamicSize())
+									memcpy(&typeSize, data, sizeof(UINT32));
+
+								curField->arrayElemFromBuffer(object, k, data);
+								data += typeSize;
+							}
+						}
+						else
+							curField->fromBuffer(object, data);
+
+						break;
+					}
+				case SerializableFT_DataBlock:
+					{
+						RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
+
+						UINT8* dataCopy = curField->allocate(object, fieldEntry.numElements);
+						if(fieldEntry.numElements > 0)
+							memcpy(dataCopy, &mData[fieldEntry.offset], fieldEntry.numElements);
+
+						ManagedDataBlock value(dataCopy, fieldEntry.numElements); // Not managed, owner decides whether to keep the data
+						curField->setValue(object, value);
+
+						break;
+					}
+				case SerializableFT_Reflectable:
+					{
+						RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+						if(curField->mIsVectorType)
+						{
+							curField->setArraySize(object, fieldEntry.numElements);
+
+							for(UINT32 k = 0; k < fieldEntry.numElements; k++)
+							{
+								std::shared_ptr<IReflectable> value = createValue(mReferences[fieldEntry.offset + k], curField, objects, assigned);
+								curField->setArrayValue(object, k, *value);
+							}
+						}
+						else
+						{
+							std::shared_ptr<IReflectable> value = createValue(mReferences[fieldEntry.offset], curField, objects, assigned);
+							curField->setValue(object, *value);
+						}
+
+						break;
+					}
+				case SerializableFT_ReflectablePtr:
+					{
+						RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+						// Same as when deserializing, referenced objects are fully assigned before being set, unless the reference is weak
+						bool isWeak = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
+
+						if(curField->mIsVectorType)
+							curField->setArraySize(object, fieldEntry.numElements);
+
+						for(UINT32 k = 0; k < fieldEntry.numElements; k++)
+						{
+							INT32 refIdx = mReferences[fieldEntry.offset + k];
+
+							std::shared_ptr<IReflectable> value;
+							if(refIdx != -1)
+							{
+								if(!isWeak && !assigned[refIdx])
+									assignFields((UINT32)refIdx, objects, assigned);
+
+								value = objects[refIdx];
+							}
+
+							if(curField->mIsVectorType)
+								curField->setArrayValue(object, k, value);
+							else
+								curField->setValue(object, value);
+						}
+
+						break;
+					}
+				}
+			}
+		}
+
+		// Finish in reverse order from the one deserialization was started in
+		for(UINT32 i = entry.numClasses; i > 0; i--)
+			mClasses[entry.firstClass + i - 1].type->onDeserializationEnded(object);
+	}
+
+	std::shared_ptr<IReflectable> SceneObjectPrototype::createValue(UINT32 objectIdx, RTTIReflectableFieldBase* field,
+		Vector<std::shared_ptr<IReflectable>>& objects, Vector<bool>& assigned) const
+	{
+		const ObjectEntry& entry = mObjects[objectIdx];
+		std::shared_ptr<IReflectable> value = field->newObject();
+
+		if(entry.kind == ObjectKind::Handle)
+		{
+			GameObjectHandleBase* handle = static_cast<GameObjectHandleBase*>(value.get());
+
+			UINT64 targetId = entry.handleId;
+			if(entry.handleTarget != -1)
+				targetId = static_cast<GameObject*>(objects[entry.handleTarget].get())->getInstanceId();
+
+			handle->_resolve(GameObjectManager::instance().getObject(targetId));
+		}
+		else
+		{
+			objects[objectIdx] = value;
+			assignFields(objectIdx, objects, assigned);
+			objects[objectIdx] = nullptr;
+		}
+
+		return value;
+	}
+}
@@ -0,0 +1,606 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsTextureProcessor.h"
+#include "BsTaskGroup.h"
+#include "BsTimer.h"
+#include "BsException.h"
+#include "BsMath.h"
+#include "nvtt/nvtt.h"
+
+namespace BansheeEngine
+{
+	const UINT32 TextureProcessor::TILE_HEIGHT = 32;
+	const UINT32 TextureProcessor::COMPRESSION_STRIP_HEIGHT = 64;
+
+	namespace
+	{
+		/**
+		 * @brief	Handles output from NVTT library for a single image.
+		 */
+		struct NVTTCompressOutputHandler : public nvtt::OutputHandler
+		{
+			NVTTCompressOutputHandler(UINT8* buffer, UINT32 sizeBytes)
+				:buffer(buffer), bufferWritePos(buffer), bufferEnd(buffer + sizeBytes)
+			{ }
+
+			virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel)
+			{ }
+
+			virtual bool writeData(const void* data, int size)
+			{
+				assert((bufferWritePos + size) <= bufferEnd);
+				memcpy(bufferWritePos, data, size);
+				bufferWritePos += size;
+
+				return true;
+			}
+
+			UINT8* buffer;
+			UINT8* bufferWritePos;
+			UINT8* bufferEnd;
+		};
+
+		nvtt::Format toNVTTFormat(PixelFormat format)
+		{
+			switch (format)
+			{
+			case PF_BC1:
+				return nvtt::Format_BC1;
+			case PF_BC1a:
+				return nvtt::Format_BC1a;
+			case PF_BC2:
+				return nvtt::Format_BC2;
+			case PF_BC3:
+				return nvtt::Format_BC3;
+			case PF_BC4:
+				return nvtt::Format_BC4;
+			case PF_BC5:
+				return nvtt::Format_BC5;
+			}
+
+			// Unsupported format
+			return nvtt::Format_BC3;
+		}
+
+		nvtt::Quality toNVTTQuality(CompressionQuality quality)
+		{
+			switch (quality)
+			{
+			case CompressionQuality::Fastest:
+				return nvtt::Quality_Fastest;
+			case CompressionQuality::Highest:
+				return nvtt::Quality_Highest;
+			case CompressionQuality::Normal:
+				return nvtt::Quality_Normal;
+			case CompressionQuality::Production:
+				return nvtt::Quality_Normal;
+			}
+
+			// Unknown quality level
+			return nvtt::Quality_Normal;
+		}
+
+		nvtt::AlphaMode toNVTTAlphaMode(AlphaMode alphaMode)
+		{
+			switch (alphaMode)
+			{
+			case AlphaMode::None:
+				return nvtt::AlphaMode_None;
+			case AlphaMode::Premultiplied:
+				return nvtt::AlphaMode_Premultiplied;
+			case AlphaMode::Transparency:
+				return nvtt::AlphaMode_Transparency;
+			}
+
+			// Unknown alpha mode
+			return nvtt::AlphaMode_None;
+		}
+	}
+
+	/**
+	 * @brief	Source pixels and their weights contributing to each pixel of a downsampled mip level,
+	 *			along one axis.
+	 */
+	struct FilterTaps
+	{
+		Vector<UINT32> offsets; /**< Index of the first tap of each destination pixel, followed by the total number of taps. */
+		Vector<UINT32> sources; /**< Index of the source pixel of each tap, with the wrap mode already applied. */
+		Vector<float> weights;
+	};
+
+	/**
+	 * @brief	Distance from the destination pixel center at which the filter reaches zero, in destination pixels.
+	 *			Same widths NVTT uses for its mip map filters.
+	 */
+	float getFilterWidth(MipMapFilter filter)
+	{
+		switch (filter)
+		{
+		case MipMapFilter::Triangle:
+			return 1.0f;
+		case MipMapFilter::Kaiser:
+			return 3.0f;
+		default:
+			return 0.5f;
+		}
+	}
+
+	/**
+	 * @brief	Evaluates the zero order modified Bessel function of the first kind.
+	 */
+	float bessel0(float x)
+	{
+		const float EPSILON = 1e-6f;
+
+		float halfX = x * 0.5f;
+		float sum = 1.0f;
+		float term = 1.0f;
+		float contribution = 1.0f;
+
+		for (UINT32 k = 1; contribution > sum * EPSILON; k++)
+		{
+			term *= halfX / k;
+			contribution = term * term;
+			sum += contribution;
+		}
+
+		return sum;
+	}
+
+	/**
+	 * @brief	Evaluates a triangle or a Kaiser filter at the specified distance from the destination pixel
+	 *			center, in destination pixels. Kaiser filter uses the same alpha and stretch NVTT uses by default.
+	 */
+	float evaluateFilter(MipMapFilter filter, float x)
+	{
+		const float KAISER_ALPHA = 4.0f;
+		const float KAISER_STRETCH = 1.0f;
+
+		x = fabs(x);
+		float width = getFilterWidth(filter);
+		if (x >= width)
+			return 0.0f;
+
+		if (filter == MipMapFilter::Triangle)
+			return 1.0f - x;
+
+		float sinc = 1.0f;
+		if (x > 0.0f)
+		{
+			float angle = Math::PI * x * KAISER_STRETCH;
+			sinc = sin(angle) / angle;
+		}
+
+		float t = x / width;
+		return sinc * bessel0(KAISER_ALPHA * sqrt(1.0f - t * t)) / bessel0(KAISER_ALPHA);
+	}
+
+	/**
+	 * @brief	Maps a pixel index that may be outside of an axis of the specified size into the axis.
+	 */
+	UINT32 wrapIndex(INT32 idx, UINT32 size, MipMapWrapMode wrapMode)
+	{
+		INT32 signedSize = (INT32)size;
+
+		switch (wrapMode)
+		{
+		case MipMapWrapMode::Clamp:
+			return (UINT32)std::min(std::max(idx, 0), signedSize - 1);
+		case MipMapWrapMode::Repeat:
+			return (UINT32)(((idx % signedSize) + signedSize) % signedSize);
+		default:
+			{
+				// Reflect around the edge pixels, without repeating them
+				if (size == 1)
+					return 0;
+
+				idx = abs(idx);
+				while (idx >= signedSize)
+					idx = abs(2 * signedSize - idx - 2);
+
+				return (UINT32)idx;
+			}
+		}
+	}
+
+	/**
+	 * @brief	Calculates filter taps for downsampling an axis of the specified size to half of it,
+	 *			rounded down but at least one.
+	 */
+	void calcFilterTaps(UINT32 srcSize, const MipMapGenOptions& options, FilterTaps& taps)
+	{
+		UINT32 dstSize = std::max(srcSize / 2, 1U);
+
+		taps.offsets.clear();
+		taps.sources.clear();
+		taps.weights.clear();
+
+		for (UINT32 i = 0; i < dstSize; i++)
+		{
+			taps.offsets.push_back((UINT32)taps.sources.size());
+
+			if (srcSize == 1)
+			{
+				taps.sources.push_back(0);
+				taps.weights.push_back(1.0f);
+			}
+			else if (options.filter == MipMapFilter::Box)
+			{
+				// Box never reaches outside of the source axis, so the wrap mode doesn't apply
+				if ((srcSize & 1) == 0)
+				{
+					taps.sources.push_back(i * 2);
+					taps.sources.push_back(i * 2 + 1);
+					taps.weights.push_back(0.5f);
+					taps.weights.push_back(0.5f);
+				}
+				else
+				{
+					// Odd sizes use a three tap filter with weights picked so every source pixel contributes equally
+					float invSrcSize = 1.0f / srcSize;
+
+					taps.sources.push_back(i * 2);
+					taps.sources.push_back(i * 2 + 1);
+					taps.sources.push_back(i * 2 + 2);
+					taps.weights.push_back((dstSize - i) * invSrcSize);
+					taps.weights.push_back(dstSize * invSrcSize);
+					taps.weights.push_back((i + 1) * invSrcSize);
+				}
+			}
+			else
+			{
+				// Filter is scaled to the destination pixel size and sampled at source pixel centers
+				float scale = srcSize / (float)dstSize;
+				float center = (i + 0.5f) * scale;
+				float radius = getFilterWidth(options.filter) * scale;
+
+				INT32 first = (INT32)floor(center - radius);
+				INT32 last = (INT32)ceil(center + radius);
+
+				UINT32 firstTap = (UINT32)taps.weights.size();
+				float totalWeight = 0.0f;
+				for (INT32 j = first; j <= last; j++)
+				{
+					float weight = evaluateFilter(options.filter, (j + 0.5f - center) / scale);
+					if (weight == 0.0f)
+						continue;
+
+					taps.sources.push_back(wrapIndex(j, srcSize, options.wrapMode));
+					taps.weights.push_back(weight);
+					totalWeight += weight;
+				}
+
+				for (UINT32 j = firstTap; j < (UINT32)taps.weights.size(); j++)
+					taps.weights[j] /= totalWeight;
+			}
+		}
+
+		taps.offsets.push_back((UINT32)taps.sources.size());
+	}
+
+	/**
+	 * @brief	Value of a fully saturated channel in a working format with the specified channel type.
+	 */
+	template<class T> float getChannelMax();
+	template<> float getChannelMax<UINT8>() { return 255.0f; }
+	template<> float getChannelMax<float>() { return 1.0f; }
+
+	/**
+	 * @brief	Writes a filtered channel value into a working format with the specified channel type.
+	 */
+	inline void storeChannel(float value, UINT8& dst) { dst = (UINT8)std::max(std::min(value + 0.5f, 255.0f), 0.0f); }
+	inline void storeChannel(float value, float& dst) { dst = value; }
+
+	/**
+	 * @brief	Downsamples a range of rows of a mip level in a four channel working format. Allows any
+	 *			source size.
+	 *
+	 * @param	src			Pixels of the source level.
+	 * @param	srcWidth	Width of the source level, in pixels.
+	 * @param	dst			Pixels of the destination level.
+	 * @param	dstWidth	Width of the destination level, in pixels.
+	 * @param	tapsX		Horizontal filter taps for each destination column.
+	 * @param	tapsY		Vertical filter taps for each destination row.
+	 * @param	rowStart	First destination row to generate.
+	 * @param	rowEnd		One past the last destination row to generate.
+	 * @param	normalize	If true, first three channels are treated as a normal in [0, 1] range and renormalized.
+	 */
+	template<class T>
+	void downsampleRows(const T* src, UINT32 srcWidth, T* dst, UINT32 dstWidth, const FilterTaps& tapsX,
+		const FilterTaps& tapsY, UINT32 rowStart, UINT32 rowEnd, bool normalize)
+	{
+		const float channelMax = getChannelMax<T>();
+
+		for (UINT32 y = rowStart; y < rowEnd; y++)
+		{
+			T* dstPixel = dst + y * dstWidth * 4;
+
+			for (UINT32 x = 0; x < dstWidth; x++, dstPixel += 4)
+			{
+				float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				for (UINT32 i = tapsY.offsets[y]; i < tapsY.offsets[y + 1]; i++)
+				{
+					const T* srcRow = src + tapsY.sources[i] * srcWidth * 4;
+					for (UINT32 j = tapsX.offsets[x]; j < tapsX.offsets[x + 1]; j++)
+					{
+						const T* srcPixel = srcRow + tapsX.sources[j] * 4;
+						float weight = tapsY.weights[i] * tapsX.weights[j];
+
+						accum[0] += srcPixel[0] * weight;
+						accum[1] += srcPixel[1] * weight;
+						accum[2] += srcPixel[2] * weight;
+						accum[3] += srcPixel[3] * weight;
+					}
+				}
+
+				if (normalize)
+				{
+					float normal[3];
+					for (UINT32 i = 0; i < 3; i++)
+						normal[i] = (accum[i] / channelMax) * 2.0f - 1.0f;
+
+					float length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+					if (length > 0.0f)
+					{
+						for (UINT32 i = 0; i < 3; i++)
+							accum[i] = ((normal[i] / length) * 0.5f + 0.5f) * channelMax;
+					}
+				}
+
+				for (UINT32 i = 0; i < 4; i++)
+					storeChannel(accum[i], dstPixel[i]);
+			}
+		}
+	}
+
+	/**
+	 * @brief	Downsamples a range of rows of a mip level in an 8-bit four channel working format, for the
+	 *			common case when the source level has even width and height and the box filter is used.
+	 *			Performs the same operation as downsampleRows, using integer math.
+	 */
+	void downsampleRowsEven(const UINT8* src, UINT32 srcWidth, UINT8* dst, UINT32 dstWidth, UINT32 rowStart, UINT32 rowEnd)
+	{
+		UINT32 srcRowPitch = srcWidth * 4;
+		for (UINT32 y = rowStart; y < rowEnd; y++)
+		{
+			const UINT8* srcTop = src + y * 2 * srcRowPitch;
+			const UINT8* srcBottom = srcTop + srcRowPitch;
+			UINT8* dstPixel = dst + y * dstWidth * 4;
+
+			for (UINT32 x = 0; x < dstWidth * 4; x += 4, srcTop += 8, srcBottom += 8)
+			{
+				for (UINT32 i = 0; i < 4; i++)
+					dstPixel[x + i] = (UINT8)((srcTop[i] + srcTop[i + 4] + srcBottom[i] + srcBottom[i + 4] + 2) >> 2);
+			}
+		}
+	}
+
+	/**
+	 * @brief	Returns a view of the specified range of rows of a 2D pixel buffer.
+	 */
+	PixelData getRows(const PixelData& data, UINT32 rowStart, UINT32 rowEnd)
+	{
+		return data.getSubVolume(PixelVolume(data.getLeft(), data.getTop() + rowStart, data.getRight(), data.getTop() + rowEnd));
+	}
+
+	/**
+	 * @brief	Converts pixels from one uncompressed buffer into another, splitting the work into tiles of
+	 *			the specified number of rows executed in parallel.
+	 */
+	void convertParallel(const PixelData& src, PixelData& dst, UINT32 tileHeight)
+	{
+		UINT32 height = src.getHeight();
+		UINT32 numTiles = (height + tileHeight - 1) / tileHeight;
+
+		parallelFor(0, numTiles, 1, [&](UINT32 tileIdx)
+		{
+			UINT32 rowStart = tileIdx * tileHeight;
+			UINT32 rowEnd = std::min(rowStart + tileHeight, height);
+
+			PixelData srcRows = getRows(src, rowStart, rowEnd);
+			PixelData dstRows = getRows(dst, rowStart, rowEnd);
+
+			PixelUtil::bulkPixelConversion(srcRows, dstRows);
+		});
+	}
+
+	void TextureProcessor::process(const PixelData& src, const Vector<PixelDataPtr>& output, const MipMapGenOptions& mipOptions,
+		const CompressionOptions& compressionOptions, TextureProcessingTimings* timings)
+	{
+		Timer totalTimer;
+
+		if (src.getDepth() != 1)
+			BS_EXCEPT(InvalidParametersException, "3D textures are not supported.");
+
+		if (PixelUtil::isCompressed(src.getFormat()))
+			BS_EXCEPT(InvalidParametersException, "Source data cannot be compressed.");
+
+		UINT32 numLevels = (UINT32)output.size();
+		UINT32 levelWidth = src.getWidth();
+		UINT32 levelHeight = src.getHeight();
+		for (UINT32 i = 0; i < numLevels; i++)
+		{
+			const PixelDataPtr& levelOutput = output[i];
+			if (levelOutput->getWidth() != levelWidth || levelOutput->getHeight() != levelHeight || levelOutput->getDepth() != 1)
+				BS_EXCEPT(InvalidParametersException, "Output buffer doesn't match the size of mip level " + toString(i) + ".");
+
+			// Note: NVTT site has implementations for these two formats for when I decide to add them
+			if (levelOutput->getFormat() == PF_BC6H || levelOutput->getFormat() == PF_BC7)
+				BS_EXCEPT(InvalidParametersException, "Specified formats are not yet supported.");
+
+			levelWidth = std::max(levelWidth / 2, 1U);
+			levelHeight = std::max(levelHeight / 2, 1U);
+		}
+
+		TextureProcessingTimings stageTimings;
+		Timer stageTimer;
+
+		// Integer formats are processed as 8-bit BGRA, which NVTT can also compress directly
+		PixelFormat workFormat = PixelUtil::isFloatingPoint(src.getFormat()) ? PF_FLOAT32_RGBA : PF_B8G8R8A8;
+		bool normalize = mipOptions.isNormalMap && mipOptions.normalizeMipmaps;
+
+		// Top level can be read directly from the source if it's already in the working format
+		PixelData topLevelBuffer;
+		PixelData curLevel;
+		if (src.getFormat() == workFormat && src.isConsecutive())
+			curLevel = src;
+		else
+		{
+			topLevelBuffer = PixelData(src.getWidth(), src.getHeight(), 1, workFormat);
+			topLevelBuffer.allocateInternalBuffer();
+
+			stageTimer.reset();
+			convertParallel(src, topLevelBuffer, TILE_HEIGHT);
+			stageTimings.conversion += stageTimer.getMicroseconds() / 1000.0f;
+
+			curLevel = topLevelBuffer;
+		}
+
+		// Lower levels alternate between two buffers large enough for the second level
+		PixelData levelBuffers[2];
+		if (numLevels > 1)
+		{
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				levelBuffers[i] = PixelData(std::max(src.getWidth() / 2, 1U), std::max(src.getHeight() / 2, 1U), 1, workFormat);
+				levelBuffers[i].allocateInternalBuffer();
+			}
+		}
+
+		// Float levels need to be converted before compression, into a buffer reused for all levels
+		PixelData compressionBuffer;
+
+		FilterTaps tapsX;
+		FilterTaps tapsY;
+		for (UINT32 i = 0; i < numLevels; i++)
+		{
+			PixelData& levelOutput = *output[i];
+			UINT32 width = curLevel.getWidth();
+			UINT32 height = curLevel.getHeight();
+
+			if (PixelUtil::isCompressed(levelOutput.getFormat()))
+			{
+				PixelData bgraLevel;
+				if (workFormat == PF_B8G8R8A8)
+					bgraLevel = curLevel;
+				else
+				{
+					if (compressionBuffer.getData() == nullptr)
+					{
+						compressionBuffer = PixelData(src.getWidth(), src.getHeight(), 1, PF_B8G8R8A8);
+						compressionBuffer.allocateInternalBuffer();
+					}
+
+					bgraLevel = PixelData(width, height, 1, PF_B8G8R8A8);
+					bgraLevel.setExternalBuffer(compressionBuffer.getData());
+
+					stageTimer.reset();
+					convertParallel(curLevel, bgraLevel, TILE_HEIGHT);
+					stageTimings.conversion += stageTimer.getMicroseconds() / 1000.0f;
+				}
+
+				stageTimer.reset();
+
+				// Blocks are compressed independently, so four pixel aligned strips can be compressed separately
+				UINT32 numStrips = (height + COMPRESSION_STRIP_HEIGHT - 1) / COMPRESSION_STRIP_HEIGHT;
+				PixelFormat format = levelOutput.getFormat();
+				std::atomic<bool> failed(false);
+
+				parallelFor(0, numStrips, 1, [&](UINT32 stripIdx)
+				{
+					UINT32 rowStart = stripIdx * COMPRESSION_STRIP_HEIGHT;
+					UINT32 stripHeight = std::min(COMPRESSION_STRIP_HEIGHT, height - rowStart);
+
+					nvtt::InputOptions io;
+					io.setTextureLayout(nvtt::TextureType_2D, width, stripHeight);
+					io.setMipmapData(bgraLevel.getData() + rowStart * width * 4, width, stripHeight);
+					io.setMipmapGeneration(false);
+					io.setAlphaMode(toNVTTAlphaMode(compressionOptions.alphaMode));
+					io.setNormalMap(compressionOptions.isNormalMap);
+
+					if (compressionOptions.isSRGB)
+						io.setGamma(2.2f, 2.2f);
+					else
+						io.setGamma(1.0f, 1.0f);
+
+					nvtt::CompressionOptions co;
+					co.setFormat(toNVTTFormat(format));
+					co.setQuality(toNVTTQuality(compressionOptions.quality));
+
+					UINT32 offset = PixelUtil::getMemorySize(width, rowStart, 1, format);
+					UINT32 size = PixelUtil::getMemorySize(width, stripHeight, 1, format);
+					NVTTCompressOutputHandler outputHandler(levelOutput.getData() + offset, size);
+
+					nvtt::OutputOptions oo;
+					oo.setOutputHeader(false);
+					oo.setOutputHandler(&outputHandler);
+
+					nvtt::Compressor compressor;
+					if (!compressor.process(io, co, oo))
+						failed = true;
+				});
+
+				stageTimings.compression += stageTimer.getMicroseconds() / 1000.0f;
+
+				if (failed)
+					BS_EXCEPT(InternalErrorException, "Compressing failed.");
+			}
+			else
+			{
+				stageTimer.reset();
+				convertParallel(curLevel, levelOutput, TILE_HEIGHT);
+				stageTimings.conversion += stageTimer.getMicroseconds() / 1000.0f;
+			}
+
+			if ((i + 1) == numLevels)
+				break;
+
+			stageTimer.reset();
+
+			PixelData& nextLevelBuffer = levelBuffers[i % 2];
+			PixelData nextLevel(std::max(width / 2, 1U), std::max(height / 2, 1U), 1, workFormat);
+			nextLevel.setExternalBuffer(nextLevelBuffer.getData());
+
+			UINT32 nextWidth = nextLevel.getWidth();
+			UINT32 nextHeight = nextLevel.getHeight();
+			UINT32 numTiles = (nextHeight + TILE_HEIGHT - 1) / TILE_HEIGHT;
+
+			calcFilterTaps(width, mipOptions, tapsX);
+			calcFilterTaps(height, mipOptions, tapsY);
+
+			bool isEven = (width % 2) == 0 && (height % 2) == 0 && mipOptions.filter == MipMapFilter::Box;
+			parallelFor(0, numTiles, 1, [&](UINT32 tileIdx)
+			{
+				UINT32 rowStart = tileIdx * TILE_HEIGHT;
+				UINT32 rowEnd = std::min(rowStart + TILE_HEIGHT, nextHeight);
+
+				if (workFormat == PF_B8G8R8A8)
+				{
+					if (isEven && !normalize)
+						downsampleRowsEven(curLevel.getData(), width, nextLevel.getData(), nextWidth, rowStart, rowEnd);
+					else
+					{
+						downsampleRows<UINT8>(curLevel.getData(), width, nextLevel.getData(), nextWidth,
+							tapsX, tapsY, rowStart, rowEnd, normalize);
+					}
+				}
+				else
+				{
+					downsampleRows<float>((const float*)curLevel.getData(), width, (float*)nextLevel.getData(), nextWidth,
+						tapsX, tapsY, rowStart, rowEnd, normalize);
+				}
+			});
+
+			stageTimings.mipmapGeneration += stageTimer.getMicroseconds() / 1000.0f;
+
+			curLevel = nextLevel;
+		}
+
+		if (timings != nullptr)
+		{
+			*timings = stageTimings;
+			timings->total = totalTimer.getMicroseconds() / 1000.0f;
+		}
+	}
+}
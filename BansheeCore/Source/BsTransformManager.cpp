@@ -0,0 +1,432 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsTransformManager.h"
+#include "BsTaskGroup.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Minimum number of dirty transforms in a depth level before the level is updated in parallel.
+	 */
+	static const UINT32 PARALLEL_UPDATE_THRESHOLD = 2048;
+
+	/**
+	 * @brief	Number of transforms updated serially by a single task, when updating in parallel.
+	 */
+	static const UINT32 PARALLEL_UPDATE_GRAIN_SIZE = 512;
+
+	TransformManager::TransformManager()
+		:mIsOrderDirty(false), mIsAnyDirty(false), mNumUpdatedLastFrame(0)
+	{ }
+
+	UINT32 TransformManager::create()
+	{
+		UINT32 id = 0;
+		if (!mFreeIds.empty())
+		{
+			id = mFreeIds.back();
+			mFreeIds.pop_back();
+		}
+		else
+		{
+			id = (UINT32)mNodes.size();
+			mNodes.push_back(Node());
+		}
+
+		UINT32 idx = (UINT32)mIds.size();
+
+		Node& node = mNodes[id];
+		node.index = idx;
+		node.parent = INVALID_ID;
+		node.firstChild = INVALID_ID;
+		node.prevSibling = INVALID_ID;
+		node.nextSibling = INVALID_ID;
+
+		mPositions.push_back(Vector3::ZERO);
+		mRotations.push_back(Quaternion::IDENTITY);
+		mScales.push_back(Vector3::ONE);
+		mWorldPositions.push_back(Vector3::ZERO);
+		mWorldRotations.push_back(Quaternion::IDENTITY);
+		mWorldScales.push_back(Vector3::ONE);
+		mLocalTfrms.push_back(Matrix4::IDENTITY);
+		mWorldTfrms.push_back(Matrix4::IDENTITY);
+		mParents.push_back((UINT32)INVALID_ID);
+		mIds.push_back(id);
+		mDirtyFlags.push_back(LocalDirty | WorldDirty);
+		mCoreDirtyFlags.push_back(0xFFFFFFFF);
+
+		mIsOrderDirty = true;
+		mIsAnyDirty = true;
+
+		return id;
+	}
+
+	void TransformManager::destroy(UINT32 id)
+	{
+		UINT32 childId = mNodes[id].firstChild;
+		while (childId != INVALID_ID)
+		{
+			UINT32 nextChildId = mNodes[childId].nextSibling;
+			setParent(childId, INVALID_ID);
+
+			childId = nextChildId;
+		}
+
+		unlinkFromParent(id);
+
+		// Entry stays in the arrays until the next reorder, so indices of other transforms remain valid
+		UINT32 idx = mNodes[id].index;
+		mIds[idx] = INVALID_ID;
+		mParents[idx] = INVALID_ID;
+		mDirtyFlags[idx] = 0;
+
+		mNodes[id].index = INVALID_ID;
+		mFreeIds.push_back(id);
+
+		mIsOrderDirty = true;
+	}
+
+	void TransformManager::setParent(UINT32 id, UINT32 parentId)
+	{
+		Node& node = mNodes[id];
+		if (node.parent == parentId)
+			return;
+
+		unlinkFromParent(id);
+
+		if (parentId != INVALID_ID)
+		{
+			Node& parentNode = mNodes[parentId];
+
+			node.parent = parentId;
+			node.prevSibling = INVALID_ID;
+			node.nextSibling = parentNode.firstChild;
+
+			if (parentNode.firstChild != INVALID_ID)
+				mNodes[parentNode.firstChild].prevSibling = id;
+
+			parentNode.firstChild = id;
+			mParents[node.index] = parentNode.index;
+		}
+
+		mIsOrderDirty = true;
+		markDirty(id, false);
+	}
+
+	void TransformManager::setPosition(UINT32 id, const Vector3& position)
+	{
+		mPositions[mNodes[id].index] = position;
+		markDirty(id, true);
+	}
+
+	void TransformManager::setRotation(UINT32 id, const Quaternion& rotation)
+	{
+		mRotations[mNodes[id].index] = rotation;
+		markDirty(id, true);
+	}
+
+	void TransformManager::setScale(UINT32 id, const Vector3& scale)
+	{
+		mScales[mNodes[id].index] = scale;
+		markDirty(id, true);
+	}
+
+	const Vector3& TransformManager::getWorldPosition(UINT32 id)
+	{
+		UINT32 idx = mNodes[id].index;
+		if ((mDirtyFlags[idx] & WorldDirty) != 0)
+			updateRecursive(idx);
+
+		return mWorldPositions[idx];
+	}
+
+	const Quaternion& TransformManager::getWorldRotation(UINT32 id)
+	{
+		UINT32 idx = mNodes[id].index;
+		if ((mDirtyFlags[idx] & WorldDirty) != 0)
+			updateRecursive(idx);
+
+		return mWorldRotations[idx];
+	}
+
+	const Vector3& TransformManager::getWorldScale(UINT32 id)
+	{
+		UINT32 idx = mNodes[id].index;
+		if ((mDirtyFlags[idx] & WorldDirty) != 0)
+			updateRecursive(idx);
+
+		return mWorldScales[idx];
+	}
+
+	const Matrix4& TransformManager::getLocalTfrm(UINT32 id)
+	{
+		UINT32 idx = mNodes[id].index;
+		if ((mDirtyFlags[idx] & LocalDirty) != 0)
+		{
+			mLocalTfrms[idx].setTRS(mPositions[idx], mRotations[idx], mScales[idx]);
+			mDirtyFlags[idx] &= ~LocalDirty;
+		}
+
+		return mLocalTfrms[idx];
+	}
+
+	const Matrix4& TransformManager::getWorldTfrm(UINT32 id)
+	{
+		UINT32 idx = mNodes[id].index;
+		if ((mDirtyFlags[idx] & WorldDirty) != 0)
+			updateRecursive(idx);
+
+		return mWorldTfrms[idx];
+	}
+
+	void TransformManager::updateIfDirty(UINT32 id)
+	{
+		UINT32 idx = mNodes[id].index;
+		if ((mDirtyFlags[idx] & WorldDirty) != 0)
+			updateRecursive(idx);
+	}
+
+	bool TransformManager::isCoreDirty(UINT32 id) const
+	{
+		UINT32 idx = mNodes[id].index;
+
+		// Dirty world transforms will set the core dirty flags once they are updated
+		return mCoreDirtyFlags[idx] != 0 || (mDirtyFlags[idx] & WorldDirty) != 0;
+	}
+
+	void TransformManager::updateAll()
+	{
+		mNumUpdatedLastFrame = 0;
+
+		if (!mIsAnyDirty)
+			return;
+
+		if (mIsOrderDirty)
+			rebuildOrder();
+
+		UINT32 numLevels = (UINT32)mLevelOffsets.size() - 1;
+		for (UINT32 i = 0; i < numLevels; i++)
+		{
+			UINT32 levelStart = mLevelOffsets[i];
+			UINT32 levelEnd = mLevelOffsets[i + 1];
+
+			UINT32 numDirty = 0;
+			for (UINT32 j = levelStart; j < levelEnd; j++)
+				numDirty += (mDirtyFlags[j] & WorldDirty) >> 1;
+
+			if (numDirty == 0)
+				continue;
+
+			// Parents are all in previous levels, so transforms in the same level can be updated in any order
+			if (numDirty >= PARALLEL_UPDATE_THRESHOLD)
+			{
+				parallelFor(levelStart, levelEnd, PARALLEL_UPDATE_GRAIN_SIZE, [this](UINT32 idx)
+				{
+					if ((mDirtyFlags[idx] & WorldDirty) != 0)
+						updateEntry(idx);
+				});
+			}
+			else
+			{
+				for (UINT32 j = levelStart; j < levelEnd; j++)
+				{
+					if ((mDirtyFlags[j] & WorldDirty) != 0)
+						updateEntry(j);
+				}
+			}
+
+			mNumUpdatedLastFrame += numDirty;
+		}
+
+		mIsAnyDirty = false;
+	}
+
+	void TransformManager::markDirty(UINT32 id, bool localChanged)
+	{
+		UINT32 idx = mNodes[id].index;
+
+		if (localChanged)
+			mDirtyFlags[idx] |= LocalDirty;
+
+		mCoreDirtyFlags[idx] = 0xFFFFFFFF;
+		markWorldDirty(id);
+	}
+
+	void TransformManager::markWorldDirty(UINT32 id)
+	{
+		UINT32 idx = mNodes[id].index;
+		if ((mDirtyFlags[idx] & WorldDirty) != 0)
+			return;
+
+		mDirtyFlags[idx] |= WorldDirty;
+		mIsAnyDirty = true;
+
+		UINT32 childId = mNodes[id].firstChild;
+		while (childId != INVALID_ID)
+		{
+			markWorldDirty(childId);
+			childId = mNodes[childId].nextSibling;
+		}
+	}
+
+	void TransformManager::updateRecursive(UINT32 idx)
+	{
+		UINT32 parentIdx = mParents[idx];
+		if (parentIdx != INVALID_ID && (mDirtyFlags[parentIdx] & WorldDirty) != 0)
+			updateRecursive(parentIdx);
+
+		updateEntry(idx);
+	}
+
+	void TransformManager::updateEntry(UINT32 idx)
+	{
+		if ((mDirtyFlags[idx] & LocalDirty) != 0)
+			mLocalTfrms[idx].setTRS(mPositions[idx], mRotations[idx], mScales[idx]);
+
+		UINT32 parentIdx = mParents[idx];
+		if (parentIdx != INVALID_ID)
+		{
+			mWorldTfrms[idx] = mLocalTfrms[idx] * mWorldTfrms[parentIdx];
+
+			// Update orientation
+			const Quaternion& parentOrientation = mWorldRotations[parentIdx];
+			mWorldRotations[idx] = parentOrientation * mRotations[idx];
+
+			// Update scale
+			const Vector3& parentScale = mWorldScales[parentIdx];
+			// Scale own position by parent scale, just combine
+			// as equivalent axes, no shearing
+			mWorldScales[idx] = parentScale * mScales[idx];
+
+			// Change position vector based on parent's orientation & scale
+			mWorldPositions[idx] = parentOrientation.rotate(parentScale * mPositions[idx]);
+
+			// Add altered position vector to parents
+			mWorldPositions[idx] += mWorldPositions[parentIdx];
+		}
+		else
+		{
+			mWorldTfrms[idx] = mLocalTfrms[idx];
+
+			mWorldRotations[idx] = mRotations[idx];
+			mWorldPositions[idx] = mPositions[idx];
+			mWorldScales[idx] = mScales[idx];
+		}
+
+		mDirtyFlags[idx] = 0;
+		mCoreDirtyFlags[idx] = 0xFFFFFFFF;
+	}
+
+	void TransformManager::rebuildOrder()
+	{
+		// Breadth first traversal from all top level transforms yields identifiers sorted by depth
+		Vector<UINT32> order;
+		order.reserve(mNodes.size() - mFreeIds.size());
+
+		for (auto& id : mIds)
+		{
+			if (id != INVALID_ID && mNodes[id].parent == INVALID_ID)
+				order.push_back(id);
+		}
+
+		mLevelOffsets.clear();
+		mLevelOffsets.push_back(0);
+
+		UINT32 levelEnd = (UINT32)order.size();
+		for (UINT32 i = 0; i < (UINT32)order.size(); i++)
+		{
+			UINT32 childId = mNodes[order[i]].firstChild;
+			while (childId != INVALID_ID)
+			{
+				order.push_back(childId);
+				childId = mNodes[childId].nextSibling;
+			}
+
+			if ((i + 1) == levelEnd)
+			{
+				mLevelOffsets.push_back(levelEnd);
+				levelEnd = (UINT32)order.size();
+			}
+		}
+
+		UINT32 numEntries = (UINT32)order.size();
+
+		Vector<Vector3> positions(numEntries);
+		Vector<Quaternion> rotations(numEntries);
+		Vector<Vector3> scales(numEntries);
+		Vector<Vector3> worldPositions(numEntries);
+		Vector<Quaternion> worldRotations(numEntries);
+		Vector<Vector3> worldScales(numEntries);
+		Vector<Matrix4> localTfrms(numEntries);
+		Vector<Matrix4> worldTfrms(numEntries);
+		Vector<UINT32> parents(numEntries);
+		Vector<UINT8> dirtyFlags(numEntries);
+		Vector<UINT32> coreDirtyFlags(numEntries);
+
+		for (UINT32 i = 0; i < numEntries; i++)
+		{
+			UINT32 oldIdx = mNodes[order[i]].index;
+
+			positions[i] = mPositions[oldIdx];
+			rotations[i] = mRotations[oldIdx];
+			scales[i] = mScales[oldIdx];
+			worldPositions[i] = mWorldPositions[oldIdx];
+			worldRotations[i] = mWorldRotations[oldIdx];
+			worldScales[i] = mWorldScales[oldIdx];
+			localTfrms[i] = mLocalTfrms[oldIdx];
+			worldTfrms[i] = mWorldTfrms[oldIdx];
+			dirtyFlags[i] = mDirtyFlags[oldIdx];
+			coreDirtyFlags[i] = mCoreDirtyFlags[oldIdx];
+		}
+
+		// Parents are always reordered before their children, so their new indices are known at this point
+		for (UINT32 i = 0; i < numEntries; i++)
+		{
+			Node& node = mNodes[order[i]];
+			node.index = i;
+
+			if (node.parent != INVALID_ID)
+				parents[i] = mNodes[node.parent].index;
+			else
+				parents[i] = INVALID_ID;
+		}
+
+		mPositions.swap(positions);
+		mRotations.swap(rotations);
+		mScales.swap(scales);
+		mWorldPositions.swap(worldPositions);
+		mWorldRotations.swap(worldRotations);
+		mWorldScales.swap(worldScales);
+		mLocalTfrms.swap(localTfrms);
+		mWorldTfrms.swap(worldTfrms);
+		mParents.swap(parents);
+		mIds.swap(order);
+		mDirtyFlags.swap(dirtyFlags);
+		mCoreDirtyFlags.swap(coreDirtyFlags);
+
+		mIsOrderDirty = false;
+	}
+
+	void TransformManager::unlinkFromParent(UINT32 id)
+	{
+		Node& node = mNodes[id];
+		if (node.parent == INVALID_ID)
+			return;
+
+		if (node.prevSibling != INVALID_ID)
+			mNodes[node.prevSibling].nextSibling = node.nextSibling;
+		else
+			mNodes[node.parent].firstChild = node.nextSibling;
+
+		if (node.nextSibling != INVALID_ID)
+			mNodes[node.nextSibling].prevSibling = node.prevSibling;
+
+		node.parent = INVALID_ID;
+		node.prevSibling = INVALID_ID;
+		node.nextSibling = INVALID_ID;
+
+		if (node.index != INVALID_ID)
+			mParents[node.index] = INVALID_ID;
+	}
+}
@@ -0,0 +1,87 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsUtility.h"
+#include "BsRTTIType.h"
+#include "BsResourceHandle.h"
+
+namespace BansheeEngine
+{
+	Vector<String> Utility::findResourceDependencies(IReflectable& object)
+	{
+		UnorderedSet<std::shared_ptr<IReflectable>> visitedObjects;
+		UnorderedSet<String> dependencies;
+		findResourceDependenciesInternal(object, visitedObjects, dependencies);
+
+		Vector<String> dependencyList(dependencies.begin(), dependencies.end());
+		return dependencyList;
+	}
+
+	void Utility::findResourceDependenciesInternal(IReflectable& object, UnorderedSet<std::shared_ptr<IReflectable>>& visitedObjects, 
+		UnorderedSet<String>& dependencies)
+	{
+		if(object.isDerivedFrom(ResourceHandleBase::getRTTIStatic()))
+		{
+			ResourceHandleBase& handle = static_cast<ResourceHandleBase&>(object);
+			if(!handle.getUUID().empty())
+				dependencies.insert(handle.getUUID());
+
+			return;
+		}
+
+		RTTITypeBase* rtti = object.getRTTI();
+
+		// If an object has base classes, we need to iterate through all of them
+		do
+		{
+			rtti->onSerializationStarted(&object);
+
+			UINT32 numFields = rtti->getNumFields();
+			for(UINT32 i = 0; i < numFields; i++)
+			{
+				RTTIField* field = rtti->getField(i);
+
+				if(field->isReflectableType())
+				{
+					RTTIReflectableFieldBase* reflectableField = static_cast<RTTIReflectableFieldBase*>(field);
+
+					if(reflectableField->mIsVectorType)
+					{
+						UINT32 numElements = reflectableField->getArraySize(&object);
+						for(UINT32 j = 0; j < numElements; j++)
+							findResourceDependenciesInternal(reflectableField->getArrayValue(&object, j), visitedObjects, dependencies);
+					}
+					else
+						findResourceDependenciesInternal(reflectableField->getValue(&object), visitedObjects, dependencies);
+				}
+				else if(field->isReflectablePtrType())
+				{
+					RTTIReflectablePtrFieldBase* reflectablePtrField = static_cast<RTTIReflectablePtrFieldBase*>(field);
+
+					if(reflectablePtrField->mIsVectorType)
+					{
+						UINT32 numElements = reflectablePtrField->getArraySize(&object);
+						for(UINT32 j = 0; j < numElements; j++)
+						{
+							std::shared_ptr<IReflectable> childObject = reflectablePtrField->getArrayValue(&object, j);
+
+							if(childObject != nullptr && visitedObjects.insert(childObject).second)
+								findResourceDependenciesInternal(*childObject, visitedObjects, dependencies);
+						}
+					}
+					else
+					{
+						std::shared_ptr<IReflectable> childObject = reflectablePtrField->getValue(&object);
+
+						if(childObject != nullptr && visitedObjects.insert(childObject).second)
+							findResourceDependenciesInternal(*childObject, visitedObjects, dependencies);
+					}
+				}
+			}
+
+			rtti->onSerializationEnded(&object);
+			rtti = rtti->getBaseClass();
+
+		} while(rtti != nullptr);
+	}
+}
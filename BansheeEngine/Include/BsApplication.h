@@ -16,7 +16,8 @@ namespace BansheeEngine
 	{
 		DX11,
 		DX9,
-		OpenGL
+		OpenGL,
+		Null /**< Doesn't render anything. Used for measuring CPU side cost without a GPU. */
 	};
 
 	/**
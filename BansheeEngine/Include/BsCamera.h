@@ -405,6 +405,6 @@ namespace BansheeEngine
 		virtual RTTITypeBase* getRTTI() const;
 
 	protected:
-		Camera() {} // Serialization only
+		Camera() { setUpdateMode(ComponentUpdateMode::None); } // Serialization only
      };
 }
\ No newline at end of file
@@ -45,6 +45,11 @@ namespace BansheeEngine
 		HMaterial createDummyMaterial() const;
 
 	protected:
+		/**
+		 * @brief	Returns the name of the render system the shader techniques are created for.
+		 */
+		virtual const String& getTechniqueRenderSystem() const;
+
 		/**
 		 * @brief	Loads an compiles a shader for text rendering.
 		 */
@@ -13,6 +13,7 @@
 #include "BsColor.h"
 #include "BsInput.h"
 #include "BsEvent.h"
+#include "BsRectI.h"
 
 namespace BansheeEngine
 {
@@ -43,6 +44,67 @@ namespace BansheeEngine
 			Dragging
 		};
 
+		/**
+		 * @brief	Single render element of a GUI element, as stored in a GUI mesh group.
+		 */
+		struct GUIGroupElement
+		{
+			GUIGroupElement()
+			{ }
+
+			GUIGroupElement(GUIElement* _element, UINT32 _renderElement, UINT32 _numQuads)
+				:element(_element), renderElement(_renderElement), quadOffset(0), numQuads(_numQuads)
+			{ }
+
+			GUIElement* element;
+			UINT32 renderElement;
+			UINT32 quadOffset; /**< Index of the first quad of the render element in the group mesh. */
+			UINT32 numQuads;
+		};
+
+		/**
+		 * @brief	Group of render elements that share the same material and are rendered using a single mesh.
+		 */
+		struct GUIMeshGroup
+		{
+			GUIMeshGroup()
+				:widget(nullptr), materialId(0), depth(0), numQuads(0), isDirty(true)
+			{ }
+
+			GUIMaterialInfo matInfo;
+			GUIWidget* widget;
+			UINT64 materialId;
+			UINT32 depth;
+			RectI bounds;
+			UINT32 numQuads;
+			Vector<GUIGroupElement> elements;
+
+			MeshDataPtr meshData; /**< CPU copy of the mesh contents, allowing the mesh to be partially rebuilt. */
+			TransientMeshPtr mesh;
+			bool isDirty;
+		};
+
+		/**
+		 * @brief	Layout information about a single render element, as it was when the mesh groups were last built.
+		 */
+		struct GUICachedRenderElement
+		{
+			UINT64 materialId;
+			UINT32 depth;
+			UINT32 numQuads;
+			UINT32 groupIdx;
+		};
+
+		/**
+		 * @brief	Layout information about a GUI element, as it was when the mesh groups were last built.
+		 */
+		struct GUICachedElement
+		{
+			RectI bounds;
+			UINT32 firstRenderElement; /**< Index into GUIRenderData::cachedRenderElements. */
+			UINT32 numRenderElements;
+		};
+
 		/**
 		 * @brief	GUI render data for a single viewport.
 		 */
@@ -52,9 +114,9 @@ namespace BansheeEngine
 				:isDirty(true)
 			{ }
 
-			Vector<TransientMeshPtr> cachedMeshes;
-			Vector<GUIMaterialInfo> cachedMaterials;
-			Vector<GUIWidget*> cachedWidgetsPerMesh;
+			Vector<GUIMeshGroup> cachedGroups; /**< Sorted from farthest to nearest. */
+			UnorderedMap<const GUIElement*, GUICachedElement> cachedElements;
+			Vector<GUICachedRenderElement> cachedRenderElements;
 			Vector<GUIWidget*> widgets;
 			bool isDirty;
 		};
@@ -192,6 +254,31 @@ namespace BansheeEngine
 		 */
 		void updateMeshes();
 
+		/**
+		 * @brief	Checks if the render elements of the provided element still have the same size, depth and material
+		 *			as when the mesh groups were last built, in which case the element can be updated without regrouping.
+		 */
+		bool isElementLayoutCached(const GUIRenderData& renderData, GUIElement* element) const;
+
+		/**
+		 * @brief	Sorts and groups all render elements in the provided render data into mesh groups. Groups
+		 *			that end up with the same elements as before keep their meshes.
+		 *
+		 * @note	Group size is a trade-off. A group is drawn with a single draw call, but when any element in it
+		 *			changes the whole group mesh is uploaded again (see updateGroupMesh). Larger groups mean fewer
+		 *			draw calls but more data uploaded for small changes, e.g. a single blinking caret.
+		 */
+		void updateMeshGroups(GUIRenderData& renderData);
+
+		/**
+		 * @brief	Rebuilds the mesh of the provided group. If the group already has a mesh of the same size
+		 *			only the quads belonging to dirty elements are refilled.
+		 *
+		 * @param	group			Group whose mesh to rebuild.
+		 * @param	dirtyElements	Sorted list of elements whose contents changed since the last rebuild.
+		 */
+		void updateGroupMesh(GUIMeshGroup& group, const Vector<GUIElement*>& dirtyElements);
+
 		/**
 		 * @brief	Recreates the input caret texture.
 		 */
@@ -337,12 +424,14 @@ namespace BansheeEngine
 
 		static const UINT32 MESH_HEAP_INITIAL_NUM_VERTS;
 		static const UINT32 MESH_HEAP_INITIAL_NUM_INDICES;
+		static const INT32 MESH_GROUP_GRID_CELL_SIZE;
 
 		Vector<WidgetInfo> mWidgets;
 		UnorderedMap<const Viewport*, GUIRenderData> mCachedGUIData;
 		MeshHeapPtr mMeshHeap;
 
 		VertexDataDescPtr mVertexDesc;
+		Vector<GUIElement*> mDirtyElements;
 
 		Stack<GUIElement*> mScheduledForDestruction;
 
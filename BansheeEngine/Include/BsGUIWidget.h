@@ -67,6 +67,17 @@ namespace BansheeEngine
 		 */
 		bool isDirty(bool cleanIfDirty);
 
+		/**
+		 * @brief	Updates all dirty elements and marks the widget as clean. Unlike "isDirty" this reports
+		 *			which elements changed, so their meshes can be updated individually.
+		 *
+		 * @param	dirtyElements	List that elements whose meshes need to be rebuilt will be appended to.
+		 *
+		 * @return	True if the widget itself was dirty (e.g. it was moved, or elements were added or removed),
+		 *			in which case all of its elements need to be rebuilt.
+		 */
+		bool _cleanDirtyElements(Vector<GUIElement*>& dirtyElements);
+
 		/**
 		 * @brief	Returns the viewport that this widget will be rendered on.
 		 */
@@ -160,6 +171,15 @@ namespace BansheeEngine
 	private:
 		GUIWidget(const GUIWidget& other) { }
 
+		/**
+		 * @brief	Updates all dirty elements and marks the widget as clean.
+		 *
+		 * @param	dirtyElements	Optional list that updated elements will be appended to.
+		 *
+		 * @return	True if the widget or any of its elements were dirty.
+		 */
+		bool cleanElements(Vector<GUIElement*>* dirtyElements);
+
 		/**
 		 * @brief	Calculates widget bounds using the bounds of all child elements.
 		 */
@@ -0,0 +1,25 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "BsD3D11BuiltinMaterialFactory.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Provides builtin materials for the null render system. Reuses the DirectX 11 shaders since the null render
+	 *			system accepts HLSL programs.
+	 */
+	class NullBuiltinMaterialFactory : public D3D11BuiltinMaterialFactory
+	{
+	public:
+		/** @copydoc BuiltinMaterialFactory::getSupportedRenderSystem */
+		const String& getSupportedRenderSystem() const;
+
+	protected:
+		/** @copydoc D3D11BuiltinMaterialFactory::getTechniqueRenderSystem */
+		const String& getTechniqueRenderSystem() const;
+	};
+}
\ No newline at end of file
@@ -14,6 +14,9 @@ namespace BansheeEngine
 	 * 			to a Viewport and used for rendering 2D graphics. Any overlay components will be 
 	 *			rendered after any other scene objects, so these components are usually used for 
 	 *			GUI elements and full screen effects.
+	 *
+	 * @note	Overlays are skipped during component updates by default. Derived overlays that
+	 *			need per-frame updates should change their update mode.
 	 */
 	class BS_EXPORT Overlay : public Component
 	{
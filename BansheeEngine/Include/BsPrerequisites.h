@@ -29,6 +29,7 @@ namespace BansheeEngine
 	static const String RenderSystemDX9 = "D3D9RenderSystem";
 	static const String RenderSystemDX11 = "D3D11RenderSystem";
 	static const String RenderSystemOpenGL = "GLRenderSystem";
+	static const String RenderSystemNull = "NullRenderSystem";
 	static const String RendererDefault = "BansheeRenderer";
 
 	class VirtualButton;
@@ -10,16 +10,18 @@ namespace BansheeEngine
 {
 	/**
 	 * @brief	Contains data needed for performing a single rendering pass.
+	 *
+	 * @note	Material and mesh are only guaranteed to be valid until the parent render queue is cleared.
 	 */
 	struct BS_EXPORT RenderQueueElement
 	{
 		RenderQueueElement()
-			:passIdx(0)
+			:renderElem(nullptr), material(nullptr), mesh(nullptr), passIdx(0)
 		{ }
 
 		RenderableElement* renderElem;
-		MaterialProxyPtr material;
-		MeshProxyPtr mesh;
+		MaterialProxy* material;
+		MeshProxy* mesh;
 		UINT32 passIdx;
 	};
 
@@ -27,21 +29,44 @@ namespace BansheeEngine
 	 * @brief	Render objects determines rendering order of objects contained within it. Rendering order 
 	 *			is determined by object material, and can influence rendering of transparent or opaque objects,
 	 * 			or be used to improve performance by grouping similar objects together.
+	 *
+	 *			Each queued pass is assigned a 64-bit key made out of (from most to least significant bits)
+	 *			queue priority, sort type, quantized distance from camera, pass index, material and mesh.
+	 *			Keys are sorted using a stable radix sort, so elements that don't require sorting keep
+	 *			the order they were added in.
+	 *
+	 * @note	All internal arrays are kept between frames so a queue that is reused doesn't allocate
+	 *			once it reaches its peak size.
 	 */
 	class BS_EXPORT RenderQueue
 	{
 		/**
-		 * @brief	Data used for renderable elemnt sorting.
+		 * @brief	Data about a single object added to the queue.
 		 */
-		struct SortData
+		struct QueueEntry
 		{
-			RenderQueueElement element;
-			QueueSortType sortType;
-			UINT32 seqIdx;
-			UINT32 priority;
+			RenderableElement* renderElem;
+			MaterialProxy* material;
+			MeshProxy* mesh;
 			float distFromCamera;
 		};
 
+		/**
+		 * @brief	Sort key of a pass of a queued object. If the object doesn't allow its
+		 *			passes to be separated a single key is used for all of its passes.
+		 */
+		struct SortElement
+		{
+			UINT64 key;
+			UINT32 entryIdx;
+			UINT32 passIdx;
+		};
+
+		/**
+		 * @brief	Pass index of sort elements that represent all passes of their object.
+		 */
+		static const UINT32 ALL_PASSES = 0xFFFFFFFF;
+
 	public:
 		RenderQueue();
 
@@ -85,11 +110,35 @@ namespace BansheeEngine
 
 	protected:
 		/**
-		 * @brief	Callback used for sorting elements.
+		 * @brief	Adds a new entry to the render queue, without taking ownership of the material or the mesh.
+		 */
+		void addInternal(RenderableElement* element, MaterialProxy* material, MeshProxy* mesh, float distFromCamera);
+
+		/**
+		 * @brief	Generates a sort key for the specified pass of a queued object.
+		 *
+		 * @param	entry		Object to generate the key for.
+		 * @param	passIdx		Index of the pass, or zero if the key represents all object passes.
 		 */
-		static bool elementSorter(const SortData&, const SortData&);
+		static UINT64 createSortKey(const QueueEntry& entry, UINT32 passIdx);
+
+		/**
+		 * @brief	Stable sort of the provided elements by their keys, in increasing order.
+		 *
+		 * @param	elements	Elements to sort.
+		 * @param	buffer		Temporary buffer at least as large as the elements array.
+		 * @param	count		Number of elements to sort.
+		 *
+		 * @return	Either "elements" or "buffer", depending on which one ended up holding the sorted elements.
+		 */
+		static SortElement* radixSort(SortElement* elements, SortElement* buffer, UINT32 count);
+
+		Vector<QueueEntry> mEntries;
+		Vector<MaterialProxyPtr> mMaterials; /**< Materials of entries added without a renderable element, keeping them alive. */
+		Vector<MeshProxyPtr> mMeshes; /**< Meshes of entries added without a renderable element, keeping them alive. */
 
-		Set<SortData, std::function<bool(const SortData&, const SortData&)>> mRenderElements;
+		Vector<SortElement> mSortElements;
+		Vector<SortElement> mSortBuffer;
 		Vector<RenderQueueElement> mSortedRenderElements;
 	};
-}
\ No newline at end of file
+}
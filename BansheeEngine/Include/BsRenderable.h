@@ -43,6 +43,11 @@ namespace BansheeEngine
 		 */
 		void setMesh(HMesh mesh);
 
+		/**
+		 * @brief	Returns the mesh to render, if any.
+		 */
+		HMesh getMesh() const { return mMeshData.mesh; }
+
 		/**
 		 * @brief	Sets a material that will be used for rendering a sub-mesh with
 		 *			the specified index. If a sub-mesh doesn't have a specific material set
@@ -155,6 +160,6 @@ namespace BansheeEngine
 		virtual RTTITypeBase* getRTTI() const;
 
 	protected:
-		Renderable() {} // Serialization only
+		Renderable() { setUpdateMode(ComponentUpdateMode::None); } // Serialization only
 	};
-}
\ No newline at end of file
+}
\ No newline at end of file
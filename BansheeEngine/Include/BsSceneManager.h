@@ -29,10 +29,40 @@ namespace BansheeEngine
 		virtual const Vector<HRenderable>& getAllRenderables() const = 0;
 
 		/**
-		 * @brief	Updates dirty transforms on any scene objects with a Renderable component.
+		 * @brief	Updates dirty transforms of all scene objects, including those with a Renderable component.
 		 */
 		virtual void updateRenderableTransforms() = 0;
 
+		/**
+		 * @brief	Finds all renderables whose world bounds intersect the provided convex volume (e.g. a camera frustum).
+		 *
+		 * @param	volume	Volume to test against.
+		 * @param	output	Array to append the found renderables to.
+		 *
+		 * @note	Renderable bounds are only refreshed in "updateRenderableTransforms", and results may contain
+		 *			renderables whose bounds are just outside of the volume.
+		 */
+		virtual void findRenderables(const ConvexVolume& volume, Vector<HRenderable>& output) const = 0;
+
+		/**
+		 * @brief	Finds all renderables whose world bounds intersect the provided axis aligned box.
+		 *			Found renderables are appended to the output array.
+		 */
+		virtual void findRenderables(const AABox& box, Vector<HRenderable>& output) const = 0;
+
+		/**
+		 * @brief	Finds all renderables whose world bounds intersect the provided sphere.
+		 *			Found renderables are appended to the output array.
+		 */
+		virtual void findRenderables(const Sphere& sphere, Vector<HRenderable>& output) const = 0;
+
+		/**
+		 * @brief	Finds all renderables whose world bounds are hit by the provided ray, closer than
+		 *			the specified distance. Renderables are returned in no particular order.
+		 *			Found renderables are appended to the output array.
+		 */
+		virtual void findRenderables(const Ray& ray, float maxDistance, Vector<HRenderable>& output) const = 0;
+
 		/**
 		 * @brief	Triggered whenever a renderable is removed from a SceneObject.
 		 */
@@ -48,4 +78,4 @@ namespace BansheeEngine
 	 * @copydoc	SceneManager
 	 */
 	BS_EXPORT SceneManager& gBsSceneManager();
-}
\ No newline at end of file
+}
\ No newline at end of file
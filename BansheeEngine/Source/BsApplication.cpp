@@ -11,6 +11,7 @@
 #include "BsD3D9BuiltinMaterialFactory.h"
 #include "BsD3D11BuiltinMaterialFactory.h"
 #include "BsGLBuiltinMaterialFactory.h"
+#include "BsNullBuiltinMaterialFactory.h"
 #include "BsBuiltinResources.h"
 #include "BsScriptManager.h"
 #include "BsProfilingManager.h"
@@ -49,6 +50,7 @@ namespace BansheeEngine
 		BuiltinMaterialManager::instance().addFactory(bs_new<D3D9BuiltinMaterialFactory>());
 		BuiltinMaterialManager::instance().addFactory(bs_new<D3D11BuiltinMaterialFactory>());
 		BuiltinMaterialManager::instance().addFactory(bs_new<GLBuiltinMaterialFactory>());
+		BuiltinMaterialManager::instance().addFactory(bs_new<NullBuiltinMaterialFactory>());
 		BuiltinMaterialManager::instance().setActive(getLibNameForRenderSystem(renderSystem));
 
 		DrawHelper2D::startUp();
@@ -120,6 +122,7 @@ namespace BansheeEngine
 		static String DX11Name = "BansheeD3D11RenderSystem";
 		static String DX9Name = "BansheeD3D9RenderSystem";
 		static String OpenGLName = "BansheeGLRenderSystem";
+		static String NullName = "BansheeNullRenderSystem";
 
 		switch (plugin)
 		{
@@ -129,6 +132,8 @@ namespace BansheeEngine
 			return DX9Name;
 		case RenderSystemPlugin::OpenGL:
 			return OpenGLName;
+		case RenderSystemPlugin::Null:
+			return NullName;
 		}
 
 		return StringUtil::BLANK;
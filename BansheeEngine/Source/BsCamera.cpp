@@ -26,6 +26,7 @@ namespace BansheeEngine
 		mPriority(0), mLayers(0xFFFFFFFFFFFFFFFF), mCoreDirtyFlags(0xFFFFFFFF)
     {
 		setName("Camera");
+		setUpdateMode(ComponentUpdateMode::None);
 
 		mViewMatrix = Matrix4::ZERO;
 		mProjMatrixRS = Matrix4::ZERO;
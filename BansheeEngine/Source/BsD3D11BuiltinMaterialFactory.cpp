@@ -49,6 +49,11 @@ namespace BansheeEngine
 		return renderSystem;
 	}
 
+	const String& D3D11BuiltinMaterialFactory::getTechniqueRenderSystem() const
+	{
+		return RenderSystemDX11;
+	}
+
 	HMaterial D3D11BuiltinMaterialFactory::createSpriteTextMaterial() const
 	{
 		HMaterial newMaterial = Material::create(mSpriteTextShader);
@@ -139,7 +144,7 @@ namespace BansheeEngine
 		mSpriteTextShader->addParameter("mainTexture", "mainTexture", GPOT_TEXTURE2D);
 		mSpriteTextShader->addParameter("tint", "tint", GPDT_FLOAT4);
 
-		TechniquePtr newTechnique = mSpriteTextShader->addTechnique("D3D11RenderSystem", RendererManager::getCoreRendererName()); 
+		TechniquePtr newTechnique = mSpriteTextShader->addTechnique(getTechniqueRenderSystem(), RendererManager::getCoreRendererName()); 
 		PassPtr newPass = newTechnique->addPass();
 		newPass->setVertexProgram(vsProgram);
 		newPass->setFragmentProgram(psProgram);
@@ -211,7 +216,7 @@ namespace BansheeEngine
 		mSpriteImageShader->addParameter("mainTexture", "mainTexture", GPOT_TEXTURE2D);
 		mSpriteImageShader->addParameter("tint", "tint", GPDT_FLOAT4);
 
-		TechniquePtr newTechnique = mSpriteImageShader->addTechnique("D3D11RenderSystem", RendererManager::getCoreRendererName()); 
+		TechniquePtr newTechnique = mSpriteImageShader->addTechnique(getTechniqueRenderSystem(), RendererManager::getCoreRendererName()); 
 		PassPtr newPass = newTechnique->addPass();
 		newPass->setVertexProgram(vsProgram);
 		newPass->setFragmentProgram(psProgram);
@@ -262,7 +267,7 @@ namespace BansheeEngine
 
 		mDebugDraw2DClipSpaceShader = Shader::create("DebugDraw2DClipSpaceShader");
 
-		TechniquePtr newTechnique = mDebugDraw2DClipSpaceShader->addTechnique("D3D11RenderSystem", RendererManager::getCoreRendererName()); 
+		TechniquePtr newTechnique = mDebugDraw2DClipSpaceShader->addTechnique(getTechniqueRenderSystem(), RendererManager::getCoreRendererName()); 
 		PassPtr newPass = newTechnique->addPass();
 		newPass->setVertexProgram(vsProgram);
 		newPass->setFragmentProgram(psProgram);
@@ -321,7 +326,7 @@ namespace BansheeEngine
 		mDebugDraw2DScreenSpaceShader->addParameter("invViewportWidth", "invViewportWidth", GPDT_FLOAT1);
 		mDebugDraw2DScreenSpaceShader->addParameter("invViewportHeight", "invViewportHeight", GPDT_FLOAT1);
 
-		TechniquePtr newTechnique = mDebugDraw2DScreenSpaceShader->addTechnique("D3D11RenderSystem", RendererManager::getCoreRendererName()); 
+		TechniquePtr newTechnique = mDebugDraw2DScreenSpaceShader->addTechnique(getTechniqueRenderSystem(), RendererManager::getCoreRendererName()); 
 		PassPtr newPass = newTechnique->addPass();
 		newPass->setVertexProgram(vsProgram);
 		newPass->setFragmentProgram(psProgram);
@@ -374,7 +379,7 @@ namespace BansheeEngine
 
 		mDebugDraw3DShader->addParameter("matViewProj", "matViewProj", GPDT_MATRIX_4X4);
 
-		TechniquePtr newTechnique = mDebugDraw3DShader->addTechnique("D3D11RenderSystem", RendererManager::getCoreRendererName()); 
+		TechniquePtr newTechnique = mDebugDraw3DShader->addTechnique(getTechniqueRenderSystem(), RendererManager::getCoreRendererName()); 
 		PassPtr newPass = newTechnique->addPass();
 		newPass->setVertexProgram(vsProgram);
 		newPass->setFragmentProgram(psProgram);
@@ -440,7 +445,7 @@ namespace BansheeEngine
 		mDockDropOverlayShader->addParameter("highlightColor", "highlightColor", GPDT_FLOAT4);
 		mDockDropOverlayShader->addParameter("highlightActive", "highlightActive", GPDT_FLOAT4);
 
-		TechniquePtr newTechnique = mDockDropOverlayShader->addTechnique("D3D11RenderSystem", RendererManager::getCoreRendererName()); 
+		TechniquePtr newTechnique = mDockDropOverlayShader->addTechnique(getTechniqueRenderSystem(), RendererManager::getCoreRendererName()); 
 		PassPtr newPass = newTechnique->addPass();
 		newPass->setVertexProgram(vsProgram);
 		newPass->setFragmentProgram(psProgram);
@@ -488,7 +493,7 @@ namespace BansheeEngine
 
 		mDummyShader->addParameter("matWorldViewProj", "matWorldViewProj", GPDT_MATRIX_4X4);
 
-		TechniquePtr newTechnique = mDummyShader->addTechnique("D3D11RenderSystem", RendererManager::getCoreRendererName());
+		TechniquePtr newTechnique = mDummyShader->addTechnique(getTechniqueRenderSystem(), RendererManager::getCoreRendererName());
 		PassPtr newPass = newTechnique->addPass();
 		newPass->setVertexProgram(vsProgram);
 		newPass->setFragmentProgram(psProgram);
@@ -42,31 +42,143 @@ using namespace std::placeholders;
 
 namespace BansheeEngine
 {
-	struct GUIGroupElement
+	/**
+	 * @brief	Uniform grid that allows quick lookup of mesh groups whose bounds might overlap a certain area.
+	 */
+	class GUIMeshGroupGrid
 	{
-		GUIGroupElement()
+	public:
+		GUIMeshGroupGrid(INT32 cellSize)
+			:mCellSize(cellSize), mQueryStamp(0)
 		{ }
 
-		GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
-			:element(_element), renderElement(_renderElement)
-		{ }
+		/**
+		 * @brief	Registers a group with all the cells covered by "bounds" that aren't also covered by "oldBounds".
+		 */
+		void add(UINT32 groupIdx, const RectI& bounds, const RectI& oldBounds)
+		{
+			if(groupIdx >= (UINT32)mQueryStamps.size())
+				mQueryStamps.resize(groupIdx + 1, 0);
 
-		GUIElement* element;
-		UINT32 renderElement;
-	};
+			INT32 minX, minY, maxX, maxY;
+			if(!getCellRange(bounds, minX, minY, maxX, maxY))
+				return;
 
-	struct GUIMaterialGroup
-	{
-		GUIMaterialInfo matInfo;
-		UINT32 numQuads;
-		UINT32 depth;
-		RectI bounds;
-		Vector<GUIGroupElement> elements;
+			INT32 oldMinX, oldMinY, oldMaxX, oldMaxY;
+			bool hasOldRange = getCellRange(oldBounds, oldMinX, oldMinY, oldMaxX, oldMaxY);
+
+			for(INT32 y = minY; y <= maxY; y++)
+			{
+				for(INT32 x = minX; x <= maxX; x++)
+				{
+					if(hasOldRange && x >= oldMinX && x <= oldMaxX && y >= oldMinY && y <= oldMaxY)
+						continue;
+
+					mCells[getCellKey(x, y)].push_back(groupIdx);
+				}
+			}
+		}
+
+		/**
+		 * @brief	Calls the predicate for every group registered in the cells covered by "area", until it returns true.
+		 *			If the area covers more cells than there are groups, all groups are checked directly instead.
+		 *
+		 * @param	area		Area to look for groups in.
+		 * @param	numGroups	Total number of groups registered with the grid.
+		 * @param	predicate	Predicate that accepts a group index.
+		 *
+		 * @return	True if the predicate returned true for any of the groups.
+		 */
+		template<class T>
+		bool findAny(const RectI& area, UINT32 numGroups, T predicate)
+		{
+			INT32 minX, minY, maxX, maxY;
+			if(!getCellRange(area, minX, minY, maxX, maxY))
+				return false;
+
+			UINT64 numCells = (UINT64)(maxX - minX + 1) * (UINT64)(maxY - minY + 1);
+			if(numCells > numGroups)
+			{
+				for(UINT32 i = 0; i < numGroups; i++)
+				{
+					if(predicate(i))
+						return true;
+				}
+
+				return false;
+			}
+
+			mQueryStamp++;
+			for(INT32 y = minY; y <= maxY; y++)
+			{
+				for(INT32 x = minX; x <= maxX; x++)
+				{
+					auto findIter = mCells.find(getCellKey(x, y));
+					if(findIter == mCells.end())
+						continue;
+
+					for(auto& groupIdx : findIter->second)
+					{
+						// Groups covering multiple cells only need to be checked once
+						if(mQueryStamps[groupIdx] == mQueryStamp)
+							continue;
+
+						mQueryStamps[groupIdx] = mQueryStamp;
+						if(predicate(groupIdx))
+							return true;
+					}
+				}
+			}
+
+			return false;
+		}
+
+	private:
+		/**
+		 * @brief	Finds the range of cells covered by the provided bounds. Returns false if the bounds are empty.
+		 */
+		bool getCellRange(const RectI& bounds, INT32& minX, INT32& minY, INT32& maxX, INT32& maxY) const
+		{
+			if(bounds.width <= 0 || bounds.height <= 0)
+				return false;
+
+			minX = toCell(bounds.x);
+			minY = toCell(bounds.y);
+			maxX = toCell(bounds.x + bounds.width - 1);
+			maxY = toCell(bounds.y + bounds.height - 1);
+
+			return true;
+		}
+
+		/**
+		 * @brief	Converts a coordinate into a cell index, rounding towards negative infinity.
+		 */
+		INT32 toCell(INT32 coord) const
+		{
+			if(coord >= 0)
+				return coord / mCellSize;
+
+			return -((-coord + mCellSize - 1) / mCellSize);
+		}
+
+		/**
+		 * @brief	Packs cell coordinates into a single key.
+		 */
+		UINT64 getCellKey(INT32 x, INT32 y) const
+		{
+			return ((UINT64)(UINT32)x << 32) | (UINT64)(UINT32)y;
+		}
+
+		INT32 mCellSize;
+		UnorderedMap<UINT64, Vector<UINT32>> mCells;
+		Vector<UINT32> mQueryStamps;
+		UINT32 mQueryStamp;
 	};
 
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
 	const UINT32 GUIManager::MESH_HEAP_INITIAL_NUM_VERTS = 16384;
 	const UINT32 GUIManager::MESH_HEAP_INITIAL_NUM_INDICES = 49152;
+	const INT32 GUIManager::MESH_GROUP_GRID_CELL_SIZE = 128;
 
 	GUIManager::GUIManager()
 		:mSeparateMeshesByWidget(true), mActiveMouseButton(GUIMouseButton::Left),
@@ -176,10 +288,10 @@ namespace BansheeEngine
 
 		if(renderData.widgets.size() == 0)
 		{
-			for (auto& mesh : renderData.cachedMeshes)
+			for (auto& group : renderData.cachedGroups)
 			{
-				if (mesh != nullptr)
-					mMeshHeap->dealloc(mesh);
+				if (group.mesh != nullptr)
+					mMeshHeap->dealloc(group.mesh);
 			}
 
 			mCachedGUIData.erase(renderTarget);
@@ -308,31 +420,21 @@ namespace BansheeEngine
 			float invViewportWidth = 1.0f / (target->getWidth() * 0.5f);
 			float invViewportHeight = 1.0f / (target->getHeight() * 0.5f);
 
-			UINT32 meshIdx = 0;
-			for(auto& mesh : renderData.cachedMeshes)
+			for(auto& group : renderData.cachedGroups)
 			{
-				GUIMaterialInfo materialInfo = renderData.cachedMaterials[meshIdx];
-				GUIWidget* widget = renderData.cachedWidgetsPerMesh[meshIdx];
+				GUIMaterialInfo materialInfo = group.matInfo;
 
 				if(materialInfo.material == nullptr || !materialInfo.material.isLoaded())
-				{
-					meshIdx++;
 					continue;
-				}
 
-				if(mesh == nullptr)
-				{
-					meshIdx++;
+				if(group.mesh == nullptr)
 					continue;
-				}
 
 				materialInfo.invViewportWidth.set(invViewportWidth);
 				materialInfo.invViewportHeight.set(invViewportHeight);
-				materialInfo.worldTransform.set(widget->SO()->getWorldTfrm());
+				materialInfo.worldTransform.set(group.widget->SO()->getWorldTfrm());
 
-				drawList.add(materialInfo.material.getInternalPtr(), mesh, 0, Vector3::ZERO);
-
-				meshIdx++;
+				drawList.add(materialInfo.material.getInternalPtr(), group.mesh, 0, Vector3::ZERO);
 			}
 		}
 		else
@@ -353,239 +455,358 @@ namespace BansheeEngine
 			GUIRenderData& renderData = cachedMeshData.second;
 
 			// Check if anything is dirty. If nothing is we can skip the update
-			bool isDirty = renderData.isDirty;
+			bool regroup = renderData.isDirty;
 			renderData.isDirty = false;
 
+			mDirtyElements.clear();
 			for(auto& widget : renderData.widgets)
 			{
-				if(widget->isDirty(true))
-				{
-					isDirty = true;
-				}
+				if(widget->_cleanDirtyElements(mDirtyElements))
+					regroup = true;
 			}
 
-			if(!isDirty)
+			if(!regroup && mDirtyElements.empty())
 				continue;
 
-			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-			auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+			// If elements were only redrawn, without changing their bounds, depth, material or number of quads, the
+			// existing groups remain valid and only the quads belonging to those elements need to be refilled
+			if(!regroup)
 			{
-				UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-				UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
-
-				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-				// requires all elements to be unique
-				return (aDepth > bDepth) || 
-					(aDepth == bDepth && a.element > b.element) || 
-					(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-			};
-
-			Set<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
-
-			for(auto& widget : renderData.widgets)
-			{
-				const Vector<GUIElement*>& elements = widget->getElements();
-
-				for(auto& element : elements)
+				for(auto& element : mDirtyElements)
 				{
-					if(element->_isDisabled())
-						continue;
-
-					UINT32 numRenderElems = element->getNumRenderElements();
-					for(UINT32 i = 0; i < numRenderElems; i++)
+					if(!isElementLayoutCached(renderData, element))
 					{
-						allElements.insert(GUIGroupElement(element, i));
+						regroup = true;
+						break;
 					}
 				}
 			}
 
-			// Group the elements in such a way so that we end up with a smallest amount of
-			// meshes, without breaking back to front rendering order
-			UnorderedMap<UINT64, Vector<GUIMaterialGroup>> materialGroups;
-			for(auto& elem : allElements)
+			std::sort(mDirtyElements.begin(), mDirtyElements.end());
+
+			if(regroup)
+				updateMeshGroups(renderData);
+			else
 			{
-				GUIElement* guiElem = elem.element;
-				UINT32 renderElemIdx = elem.renderElement;
-				UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
-
-				RectI tfrmedBounds = guiElem->_getClippedBounds();
-				tfrmedBounds.transform(guiElem->_getParentWidget()->SO()->getWorldTfrm());
-
-				const GUIMaterialInfo& matInfo = guiElem->getMaterial(renderElemIdx);
-
-				UINT64 materialId = matInfo.material->getInternalID(); // TODO - I group based on material ID. So if two widgets used exact copies of the same material
-				// this system won't detect it. Find a better way of determining material similarity?
-
-				// If this is a new material, add a new list of groups
-				auto findIterMaterial = materialGroups.find(materialId);
-				if(findIterMaterial == end(materialGroups))
-					materialGroups[materialId] = Vector<GUIMaterialGroup>();
-
-				// Try to find a group this material will fit in:
-				//  - Group that has a depth value same or one below elements depth will always be a match
-				//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-				//    overlap the current elements bounds.
-				Vector<GUIMaterialGroup>& allGroups = materialGroups[materialId];
-				GUIMaterialGroup* foundGroup = nullptr;
-				for(auto groupIter = allGroups.rbegin(); groupIter != allGroups.rend(); ++groupIter)
+				for(auto& element : mDirtyElements)
 				{
-					// If we separate meshes by widget, ignore any groups with widget parents other than mine
-					if(mSeparateMeshesByWidget)
+					const GUICachedElement& cachedElement = renderData.cachedElements[element];
+					for(UINT32 i = 0; i < cachedElement.numRenderElements; i++)
 					{
-						if(groupIter->elements.size() > 0)
-						{
-							GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-							if(otherElem->_getParentWidget() != guiElem->_getParentWidget())
-								continue;
-						}
+						const GUICachedRenderElement& cachedRenderElem = renderData.cachedRenderElements[cachedElement.firstRenderElement + i];
+						renderData.cachedGroups[cachedRenderElem.groupIdx].isDirty = true;
 					}
+				}
+			}
 
-					GUIMaterialGroup& group = *groupIter;
+			for(auto& group : renderData.cachedGroups)
+			{
+				if(group.isDirty)
+					updateGroupMesh(group, mDirtyElements);
+			}
+		}
+	}
 
-					if(group.depth == elemDepth || group.depth == (elemDepth - 1))
-					{
-						foundGroup = &group;
-						break;
-					}
-					else
-					{
-						UINT32 startDepth = elemDepth;
-						UINT32 endDepth = group.depth;
+	bool GUIManager::isElementLayoutCached(const GUIRenderData& renderData, GUIElement* element) const
+	{
+		auto findIter = renderData.cachedElements.find(element);
+		if(findIter == renderData.cachedElements.end())
+			return false;
 
-						RectI potentialGroupBounds = group.bounds;
-						potentialGroupBounds.encapsulate(tfrmedBounds);
+		const GUICachedElement& cachedElement = findIter->second;
+		UINT32 numRenderElems = element->_isDisabled() ? 0 : element->getNumRenderElements();
 
-						bool foundOverlap = false;
-						for(auto& material : materialGroups)
-						{
-							for(auto& matGroup : material.second)
-							{
-								if(&matGroup == &group)
-									continue;
-
-								if(matGroup.depth > startDepth && matGroup.depth < endDepth)
-								{
-									if(matGroup.bounds.overlaps(potentialGroupBounds))
-									{
-										foundOverlap = true;
-										break;
-									}
-								}
-							}
-						}
+		if(cachedElement.numRenderElements != numRenderElems)
+			return false;
 
-						if(!foundOverlap)
-						{
-							foundGroup = &group;
-							break;
-						}
-					}
+		if(cachedElement.bounds != element->_getClippedBounds())
+			return false;
+
+		for(UINT32 i = 0; i < numRenderElems; i++)
+		{
+			const GUICachedRenderElement& cachedRenderElem = renderData.cachedRenderElements[cachedElement.firstRenderElement + i];
+
+			if(cachedRenderElem.depth != element->_getRenderElementDepth(i))
+				return false;
+
+			if(cachedRenderElem.numQuads != element->getNumQuads(i))
+				return false;
+
+			if(cachedRenderElem.materialId != element->getMaterial(i).material->getInternalID())
+				return false;
+		}
+
+		return true;
+	}
+
+	void GUIManager::updateMeshGroups(GUIRenderData& renderData)
+	{
+		renderData.cachedElements.clear();
+		renderData.cachedRenderElements.clear();
+
+		// Make a list of all render elements and remember their layout, so we can later tell if an element can
+		// be updated without regrouping
+		Vector<GUIGroupElement> allElements;
+		for(auto& widget : renderData.widgets)
+		{
+			const Vector<GUIElement*>& elements = widget->getElements();
+
+			for(auto& element : elements)
+			{
+				GUICachedElement& cachedElement = renderData.cachedElements[element];
+				cachedElement.bounds = element->_getClippedBounds();
+				cachedElement.firstRenderElement = (UINT32)renderData.cachedRenderElements.size();
+				cachedElement.numRenderElements = element->_isDisabled() ? 0 : element->getNumRenderElements();
+
+				for(UINT32 i = 0; i < cachedElement.numRenderElements; i++)
+				{
+					GUICachedRenderElement cachedRenderElem;
+					cachedRenderElem.materialId = element->getMaterial(i).material->getInternalID(); // TODO - I group based on material ID. So if two widgets used exact copies of the same material
+					// this system won't detect it. Find a better way of determining material similarity?
+					cachedRenderElem.depth = element->_getRenderElementDepth(i);
+					cachedRenderElem.numQuads = element->getNumQuads(i);
+					cachedRenderElem.groupIdx = 0;
+
+					renderData.cachedRenderElements.push_back(cachedRenderElem);
+					allElements.push_back(GUIGroupElement(element, i, cachedRenderElem.numQuads));
 				}
+			}
+		}
+
+		// Sort the render elements from farthest to nearest (highest depth to lowest)
+		UINT32 numElements = (UINT32)allElements.size();
+		Vector<UINT32> sortedElements(numElements);
+		for(UINT32 i = 0; i < numElements; i++)
+			sortedElements[i] = i;
+
+		auto elemComp = [&](UINT32 a, UINT32 b)
+		{
+			UINT32 aDepth = renderData.cachedRenderElements[a].depth;
+			UINT32 bDepth = renderData.cachedRenderElements[b].depth;
+			const GUIGroupElement& aElem = allElements[a];
+			const GUIGroupElement& bElem = allElements[b];
+
+			// Compare pointers just to get a deterministic order between two elements with the same depth, their order doesn't really matter
+			return (aDepth > bDepth) ||
+				(aDepth == bDepth && aElem.element > bElem.element) ||
+				(aDepth == bDepth && aElem.element == bElem.element && aElem.renderElement > bElem.renderElement);
+		};
+
+		std::sort(sortedElements.begin(), sortedElements.end(), elemComp);
+
+		// Group the elements in such a way so that we end up with a smallest amount of
+		// meshes, without breaking back to front rendering order
+		Vector<GUIMeshGroup> groups;
+		UnorderedMap<UINT64, Vector<UINT32>> materialGroups;
+		GUIMeshGroupGrid groupGrid(MESH_GROUP_GRID_CELL_SIZE);
+
+		for(auto& elemIdx : sortedElements)
+		{
+			const GUIGroupElement& elem = allElements[elemIdx];
+			const GUICachedRenderElement& cachedRenderElem = renderData.cachedRenderElements[elemIdx];
+
+			GUIElement* guiElem = elem.element;
+			GUIWidget* widget = guiElem->_getParentWidget();
+			UINT32 elemDepth = cachedRenderElem.depth;
+
+			RectI tfrmedBounds = guiElem->_getClippedBounds();
+			tfrmedBounds.transform(widget->SO()->getWorldTfrm());
+
+			// Try to find a group this material will fit in:
+			//  - Group that has a depth value same or one below elements depth will always be a match
+			//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
+			//    overlap the current elements bounds.
+			Vector<UINT32>& allGroups = materialGroups[cachedRenderElem.materialId];
+			INT32 foundGroupIdx = -1;
+			for(auto groupIter = allGroups.rbegin(); groupIter != allGroups.rend(); ++groupIter)
+			{
+				UINT32 groupIdx = *groupIter;
+				GUIMeshGroup& group = groups[groupIdx];
+
+				// If we separate meshes by widget, ignore any groups with widget parents other than mine
+				if(mSeparateMeshesByWidget && group.widget != widget)
+					continue;
 
-				if(foundGroup == nullptr)
+				if(group.depth == elemDepth || group.depth == (elemDepth - 1))
 				{
-					allGroups.push_back(GUIMaterialGroup());
-					foundGroup = &allGroups[allGroups.size() - 1];
-
-					foundGroup->depth = elemDepth;
-					foundGroup->bounds = tfrmedBounds;
-					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-					foundGroup->matInfo = matInfo;
-					foundGroup->numQuads = guiElem->getNumQuads(renderElemIdx);
+					foundGroupIdx = (INT32)groupIdx;
+					break;
 				}
 				else
 				{
-					foundGroup->bounds.encapsulate(tfrmedBounds);
-					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-					foundGroup->depth = std::min(foundGroup->depth, elemDepth);
-					foundGroup->numQuads += guiElem->getNumQuads(renderElemIdx);
+					UINT32 startDepth = elemDepth;
+					UINT32 endDepth = group.depth;
+
+					RectI potentialGroupBounds = group.bounds;
+					potentialGroupBounds.encapsulate(tfrmedBounds);
+
+					bool foundOverlap = groupGrid.findAny(potentialGroupBounds, (UINT32)groups.size(),
+						[&](UINT32 otherGroupIdx)
+					{
+						if(otherGroupIdx == groupIdx)
+							return false;
+
+						const GUIMeshGroup& otherGroup = groups[otherGroupIdx];
+						return otherGroup.depth > startDepth && otherGroup.depth < endDepth &&
+							otherGroup.bounds.overlaps(potentialGroupBounds);
+					});
+
+					if(!foundOverlap)
+					{
+						foundGroupIdx = (INT32)groupIdx;
+						break;
+					}
 				}
 			}
 
-			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-			auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			if(foundGroupIdx == -1)
 			{
-				return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-				// requires all elements to be unique
-			};
-
-			Set<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-			for(auto& material : materialGroups)
-			{
-				for(auto& group : material.second)
-				{
-					sortedGroups.insert(&group);
-				}
+				foundGroupIdx = (INT32)groups.size();
+				allGroups.push_back((UINT32)foundGroupIdx);
+				groups.push_back(GUIMeshGroup());
+
+				GUIMeshGroup& newGroup = groups.back();
+				newGroup.matInfo = guiElem->getMaterial(elem.renderElement);
+				newGroup.widget = widget;
+				newGroup.materialId = cachedRenderElem.materialId;
+				newGroup.depth = elemDepth;
+				newGroup.bounds = tfrmedBounds;
+
+				groupGrid.add((UINT32)foundGroupIdx, newGroup.bounds, RectI());
 			}
+			else
+			{
+				GUIMeshGroup& foundGroup = groups[foundGroupIdx];
 
-			UINT32 numMeshes = (UINT32)sortedGroups.size();
-			UINT32 oldNumMeshes = (UINT32)renderData.cachedMeshes.size();
+				RectI oldBounds = foundGroup.bounds;
+				foundGroup.bounds.encapsulate(tfrmedBounds);
+				foundGroup.depth = std::min(foundGroup.depth, elemDepth);
 
-			if(numMeshes < oldNumMeshes)
-			{
-				renderData.cachedMeshes.resize(numMeshes);
+				groupGrid.add((UINT32)foundGroupIdx, foundGroup.bounds, oldBounds);
 			}
 
-			renderData.cachedMaterials.resize(numMeshes);
+			GUIMeshGroup& group = groups[foundGroupIdx];
+			group.elements.push_back(elem);
+			group.elements.back().quadOffset = group.numQuads;
+			group.numQuads += elem.numQuads;
+		}
+
+		// Sort the groups from farthest to nearest (highest depth to lowest)
+		std::stable_sort(groups.begin(), groups.end(),
+			[](const GUIMeshGroup& a, const GUIMeshGroup& b) { return a.depth > b.depth; });
+
+		// Groups that contain exactly the same render elements as before can keep their meshes, and only
+		// need to be updated if any of their elements changed
+		UnorderedMultimap<const GUIElement*, UINT32> oldGroupsByFirstElement;
+		for(UINT32 i = 0; i < (UINT32)renderData.cachedGroups.size(); i++)
+		{
+			const GUIMeshGroup& oldGroup = renderData.cachedGroups[i];
+			if(oldGroup.mesh != nullptr && oldGroup.elements.size() > 0)
+				oldGroupsByFirstElement.insert(std::make_pair(oldGroup.elements[0].element, i));
+		}
 
-			if(mSeparateMeshesByWidget)
-				renderData.cachedWidgetsPerMesh.resize(numMeshes);
+		for(auto& group : groups)
+		{
+			group.isDirty = true;
 
-			// Fill buffers for each group and update their meshes
-			UINT32 groupIdx = 0;
-			for(auto& group : sortedGroups)
+			auto range = oldGroupsByFirstElement.equal_range(group.elements[0].element);
+			for(auto iter = range.first; iter != range.second; ++iter)
 			{
-				renderData.cachedMaterials[groupIdx] = group->matInfo;
+				GUIMeshGroup& oldGroup = renderData.cachedGroups[iter->second];
 
-				if(mSeparateMeshesByWidget)
+				if(oldGroup.mesh == nullptr || oldGroup.materialId != group.materialId ||
+					oldGroup.widget != group.widget || oldGroup.numQuads != group.numQuads ||
+					oldGroup.elements.size() != group.elements.size())
 				{
-					if(group->elements.size() == 0)
-						renderData.cachedWidgetsPerMesh[groupIdx] = nullptr;
-					else
+					continue;
+				}
+
+				bool sameElements = true;
+				bool anyElementDirty = false;
+				for(UINT32 i = 0; i < (UINT32)group.elements.size(); i++)
+				{
+					const GUIGroupElement& elem = group.elements[i];
+					const GUIGroupElement& oldElem = oldGroup.elements[i];
+
+					if(elem.element != oldElem.element || elem.renderElement != oldElem.renderElement || elem.numQuads != oldElem.numQuads)
 					{
-						GUIElement* elem = group->elements.begin()->element;
-						renderData.cachedWidgetsPerMesh[groupIdx] = elem->_getParentWidget();
+						sameElements = false;
+						break;
 					}
+
+					if(std::binary_search(mDirtyElements.begin(), mDirtyElements.end(), elem.element))
+						anyElementDirty = true;
 				}
 
-				MeshDataPtr meshData = bs_shared_ptr<MeshData, PoolAlloc>(group->numQuads * 4, group->numQuads * 6, mVertexDesc);
+				if(!sameElements)
+					continue;
 
-				UINT8* vertices = meshData->getElementData(VES_POSITION);
-				UINT8* uvs = meshData->getElementData(VES_TEXCOORD);
-				UINT32* indices = meshData->getIndices32();
-				UINT32 vertexStride = meshData->getVertexDesc()->getVertexStride();
-				UINT32 indexStride = meshData->getIndexElementSize();
+				group.mesh = oldGroup.mesh;
+				group.meshData = oldGroup.meshData;
+				group.isDirty = anyElementDirty;
 
-				UINT32 quadOffset = 0;
-				for(auto& matElement : group->elements)
-				{
-					matElement.element->fillBuffer(vertices, uvs, indices, quadOffset, group->numQuads, vertexStride, indexStride, matElement.renderElement);
+				oldGroup.mesh = nullptr;
+				oldGroup.meshData = nullptr;
+				break;
+			}
+		}
+
+		for(auto& oldGroup : renderData.cachedGroups)
+		{
+			if(oldGroup.mesh != nullptr)
+				mMeshHeap->dealloc(oldGroup.mesh);
+		}
 
-					UINT32 numQuads = matElement.element->getNumQuads(matElement.renderElement);
-					UINT32 indexStart = quadOffset * 6;
-					UINT32 indexEnd = indexStart + numQuads * 6;
-					UINT32 vertOffset = quadOffset * 4;
+		// Remember which group each render element ended up in
+		for(UINT32 i = 0; i < (UINT32)groups.size(); i++)
+		{
+			for(auto& elem : groups[i].elements)
+			{
+				const GUICachedElement& cachedElement = renderData.cachedElements[elem.element];
+				renderData.cachedRenderElements[cachedElement.firstRenderElement + elem.renderElement].groupIdx = i;
+			}
+		}
 
-					for(UINT32 i = indexStart; i < indexEnd; i++)
-						indices[i] += vertOffset;
+		renderData.cachedGroups.swap(groups);
+	}
 
-					quadOffset += numQuads;
-				}
+	void GUIManager::updateGroupMesh(GUIMeshGroup& group, const Vector<GUIElement*>& dirtyElements)
+	{
+		MeshDataPtr meshData = bs_shared_ptr<MeshData, PoolAlloc>(group.numQuads * 4, group.numQuads * 6, mVertexDesc);
 
-				if(groupIdx < (UINT32)renderData.cachedMeshes.size())
-				{
-					mMeshHeap->dealloc(renderData.cachedMeshes[groupIdx]);
-					renderData.cachedMeshes[groupIdx] = mMeshHeap->alloc(meshData);
-				}
-				else
-				{
-					renderData.cachedMeshes.push_back(mMeshHeap->alloc(meshData));
-				}
+		UINT8* vertices = meshData->getElementData(VES_POSITION);
+		UINT8* uvs = meshData->getElementData(VES_TEXCOORD);
+		UINT32* indices = meshData->getIndices32();
+		UINT32 vertexStride = meshData->getVertexDesc()->getVertexStride();
+		UINT32 indexStride = meshData->getIndexElementSize();
 
-				groupIdx++;
-			}
+		// The old mesh data was already passed to the mesh heap and might still be read by the core thread,
+		// so instead of modifying it we start from a copy and only refill the quads of dirty elements
+		bool partialUpdate = group.meshData != nullptr;
+		if(partialUpdate)
+			memcpy(meshData->getData(), group.meshData->getData(), meshData->getInternalBufferSize());
+
+		for(auto& matElement : group.elements)
+		{
+			if(partialUpdate && !std::binary_search(dirtyElements.begin(), dirtyElements.end(), matElement.element))
+				continue;
+
+			matElement.element->fillBuffer(vertices, uvs, indices, matElement.quadOffset, group.numQuads, vertexStride, indexStride, matElement.renderElement);
+
+			UINT32 indexStart = matElement.quadOffset * 6;
+			UINT32 indexEnd = indexStart + matElement.numQuads * 6;
+			UINT32 vertOffset = matElement.quadOffset * 4;
+
+			for(UINT32 i = indexStart; i < indexEnd; i++)
+				indices[i] += vertOffset;
 		}
+
+		if(group.mesh != nullptr)
+			mMeshHeap->dealloc(group.mesh);
+
+		group.mesh = mMeshHeap->alloc(meshData);
+		group.meshData = meshData;
+		group.isDirty = false;
 	}
 
 	void GUIManager::updateCaretTexture()
@@ -198,30 +198,7 @@ namespace BansheeEngine
 	bool GUIWidget::isDirty(bool cleanIfDirty)
 	{
 		if(cleanIfDirty)
-		{
-			bool dirty = mWidgetIsDirty;
-			mWidgetIsDirty = false;
-
-			for(auto& elem : mElements)
-			{
-				if(elem->_isContentDirty())
-				{
-					dirty = true;
-					elem->updateRenderElements();
-				}
-
-				if(elem->_isMeshDirty())
-				{
-					dirty = true;
-					elem->_markAsClean();
-				}
-			}
-
-			if(dirty)
-				updateBounds();
-
-			return dirty;
-		}
+			return cleanElements(nullptr);
 		else
 		{
 			if(mWidgetIsDirty)
@@ -239,6 +216,51 @@ namespace BansheeEngine
 		}
 	}
 
+	bool GUIWidget::_cleanDirtyElements(Vector<GUIElement*>& dirtyElements)
+	{
+		bool widgetDirty = mWidgetIsDirty;
+		cleanElements(&dirtyElements);
+
+		return widgetDirty;
+	}
+
+	bool GUIWidget::cleanElements(Vector<GUIElement*>* dirtyElements)
+	{
+		bool widgetDirty = mWidgetIsDirty;
+		mWidgetIsDirty = false;
+
+		bool anyElementDirty = false;
+		for(auto& elem : mElements)
+		{
+			bool elemDirty = false;
+			if(elem->_isContentDirty())
+			{
+				elemDirty = true;
+				elem->updateRenderElements();
+			}
+
+			if(elem->_isMeshDirty())
+			{
+				elemDirty = true;
+				elem->_markAsClean();
+			}
+
+			if(elemDirty)
+			{
+				if(dirtyElements != nullptr)
+					dirtyElements->push_back(elem);
+
+				anyElementDirty = true;
+			}
+		}
+
+		bool dirty = widgetDirty || anyElementDirty;
+		if(dirty)
+			updateBounds();
+
+		return dirty;
+	}
+
 	bool GUIWidget::inBounds(const Vector2I& position) const
 	{
 		// Technically GUI widget bounds can be larger than the viewport, so make sure we clip to viewport first
@@ -0,0 +1,19 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullBuiltinMaterialFactory.h"
+
+namespace BansheeEngine
+{
+	const String& NullBuiltinMaterialFactory::getSupportedRenderSystem() const
+	{
+		static String renderSystem = "BansheeNullRenderSystem";
+
+		return renderSystem;
+	}
+
+	const String& NullBuiltinMaterialFactory::getTechniqueRenderSystem() const
+	{
+		return RenderSystemNull;
+	}
+}
\ No newline at end of file
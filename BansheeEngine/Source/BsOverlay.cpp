@@ -10,6 +10,7 @@ namespace BansheeEngine
 		:Component(parent), mRenderTarget(nullptr), mDepth(0)
 	{
 		setName("Overlay");
+		setUpdateMode(ComponentUpdateMode::None);
 
 		if(mRenderTarget != nullptr)
 			OverlayManager::instance().detachOverlay(mRenderTarget, this);
@@ -10,105 +10,210 @@
 namespace BansheeEngine
 {
 	RenderQueue::RenderQueue()
-		:mRenderElements(&elementSorter)
 	{
 
 	}
 
 	void RenderQueue::clear()
 	{
-		mRenderElements.clear();
+		mEntries.clear();
+		mMaterials.clear();
+		mMeshes.clear();
+		mSortElements.clear();
 		mSortedRenderElements.clear();
 	}
 
 	void RenderQueue::add(RenderableElement* element, float distFromCamera)
 	{
-		SortData sortData;
-
-		RenderQueueElement& renderOp = sortData.element;
-		renderOp.renderElem = element;
-		renderOp.material = element->material;
-		renderOp.mesh = element->mesh;
-
-		sortData.distFromCamera = distFromCamera;
-		sortData.priority = element->material->shader->queuePriority;
-		sortData.sortType = element->material->shader->queueSortType;
-		sortData.seqIdx = (UINT32)mRenderElements.size();
-
-		// TODO - Make sure elements are cached so we dont allocate memory for them every frame
-		mRenderElements.insert(sortData);
+		// Renderable element keeps its material and mesh alive until it is removed, which can't happen
+		// before the queue is rendered and cleared, so there's no need to hold a reference
+		addInternal(element, element->material.get(), element->mesh.get(), distFromCamera);
 	}
 
 	void RenderQueue::add(const MaterialProxyPtr& material, const MeshProxyPtr& mesh, float distFromCamera)
 	{
-		SortData sortData;
-
-		RenderQueueElement& renderOp = sortData.element;
-		renderOp.renderElem = nullptr;
-		renderOp.material = material;
-		renderOp.mesh = mesh;
+		mMaterials.push_back(material);
+		mMeshes.push_back(mesh);
 
-		sortData.distFromCamera = distFromCamera;
-		sortData.priority = material->shader->queuePriority;
-		sortData.sortType = material->shader->queueSortType;
-		sortData.seqIdx = (UINT32)mRenderElements.size();
-
-		// TODO - Make sure elements are cached so we dont allocate memory for them every frame
-		mRenderElements.insert(sortData);
+		addInternal(nullptr, material.get(), mesh.get(), distFromCamera);
 	}
 
 	void RenderQueue::add(const RenderQueue& renderQueue)
 	{
-		for (auto& elem : renderQueue.mRenderElements)
+		UINT32 ownedIdx = 0;
+		for (auto& entry : renderQueue.mEntries)
 		{
-			if (elem.element.renderElem != nullptr)
-				add(elem.element.renderElem, elem.distFromCamera);
+			if (entry.renderElem != nullptr)
+				add(entry.renderElem, entry.distFromCamera);
 			else
-				add(elem.element.material, elem.element.mesh, elem.distFromCamera);
+			{
+				add(renderQueue.mMaterials[ownedIdx], renderQueue.mMeshes[ownedIdx], entry.distFromCamera);
+				ownedIdx++;
+			}
 		}
 	}
 
+	void RenderQueue::addInternal(RenderableElement* element, MaterialProxy* material, MeshProxy* mesh, float distFromCamera)
+	{
+		mEntries.push_back(QueueEntry());
+
+		QueueEntry& entry = mEntries.back();
+		entry.renderElem = element;
+		entry.material = material;
+		entry.mesh = mesh;
+		entry.distFromCamera = distFromCamera;
+	}
+
 	void RenderQueue::sort()
 	{
-		// TODO - I'm ignoring "separate pass" material parameter.
-		for (auto& sortData : mRenderElements)
+		mSortElements.clear();
+		mSortedRenderElements.clear();
+
+		UINT32 numEntries = (UINT32)mEntries.size();
+		for (UINT32 i = 0; i < numEntries; i++)
 		{
-			const RenderQueueElement& renderElem = sortData.element;
-			UINT32 numPasses = (UINT32)renderElem.material->passes.size();
-			for (UINT32 i = 0; i < numPasses; i++)
+			const QueueEntry& entry = mEntries[i];
+			UINT32 numPasses = (UINT32)entry.material->passes.size();
+
+			// Passes of separable shaders are sorted individually, so passes of other objects may end up between them
+			if (entry.material->shader->separablePasses && numPasses > 1)
+			{
+				for (UINT32 j = 0; j < numPasses; j++)
+				{
+					SortElement sortElem;
+					sortElem.key = createSortKey(entry, j);
+					sortElem.entryIdx = i;
+					sortElem.passIdx = j;
+
+					mSortElements.push_back(sortElem);
+				}
+			}
+			else
+			{
+				SortElement sortElem;
+				sortElem.key = createSortKey(entry, 0);
+				sortElem.entryIdx = i;
+				sortElem.passIdx = ALL_PASSES;
+
+				mSortElements.push_back(sortElem);
+			}
+		}
+
+		UINT32 numSortElements = (UINT32)mSortElements.size();
+		if (numSortElements == 0)
+			return;
+
+		mSortBuffer.resize(numSortElements);
+		SortElement* sortedElements = radixSort(mSortElements.data(), mSortBuffer.data(), numSortElements);
+
+		for (UINT32 i = 0; i < numSortElements; i++)
+		{
+			const SortElement& sortElem = sortedElements[i];
+			const QueueEntry& entry = mEntries[sortElem.entryIdx];
+
+			UINT32 firstPass = sortElem.passIdx;
+			UINT32 endPass = sortElem.passIdx + 1;
+			if (sortElem.passIdx == ALL_PASSES)
+			{
+				firstPass = 0;
+				endPass = (UINT32)entry.material->passes.size();
+			}
+
+			for (UINT32 j = firstPass; j < endPass; j++)
 			{
 				mSortedRenderElements.push_back(RenderQueueElement());
 
 				RenderQueueElement& sortedElem = mSortedRenderElements.back();
-				sortedElem.renderElem = renderElem.renderElem;
-				sortedElem.material = renderElem.material;
-				sortedElem.mesh = renderElem.mesh;
-				sortedElem.passIdx = i;
+				sortedElem.renderElem = entry.renderElem;
+				sortedElem.material = entry.material;
+				sortedElem.mesh = entry.mesh;
+				sortedElem.passIdx = j;
 			}
 		}
 	}
 
-	bool RenderQueue::elementSorter(const SortData& a, const SortData& b)
+	UINT64 RenderQueue::createSortKey(const QueueEntry& entry, UINT32 passIdx)
+	{
+		const ShaderProxy& shader = *entry.material->shader;
+
+		// Higher priority gets rendered first, so invert it. 18 bits are enough to keep all of the
+		// built-in QueuePriority values distinct.
+		UINT64 priority = 0x3FFFF - std::min(shader.queuePriority, (UINT32)0x3FFFF);
+		UINT64 sortType = (UINT64)shader.queueSortType;
+
+		UINT64 key = (priority << 46) | (sortType << 44);
+
+		// Unsorted elements keep the order they were added in, thanks to the sort being stable
+		if (shader.queueSortType == QueueSortType::None)
+			return key;
+
+		// Bits of non-negative floats compare the same as the floats themselves, so the top bits after
+		// the sign bit provide a logarithmic quantization that works for any distance range
+		float distance = entry.distFromCamera > 0.0f ? entry.distFromCamera : 0.0f;
+
+		UINT32 distanceBits;
+		memcpy(&distanceBits, &distance, sizeof(distance));
+
+		UINT64 depth = distanceBits >> 15;
+		if (shader.queueSortType == QueueSortType::BackToFront)
+			depth = 0xFFFF - depth;
+
+		// Material and mesh only need to be unique enough to group identical ones together
+		UINT64 pass = std::min(passIdx, (UINT32)0xF);
+		UINT64 materialId = (((size_t)entry.material >> 4) ^ ((size_t)entry.material >> 16)) & 0xFFF;
+		UINT64 meshId = (((size_t)entry.mesh >> 4) ^ ((size_t)entry.mesh >> 16)) & 0xFFF;
+
+		return key | (depth << 28) | (pass << 24) | (materialId << 12) | meshId;
+	}
+
+	RenderQueue::SortElement* RenderQueue::radixSort(SortElement* elements, SortElement* buffer, UINT32 count)
 	{
-		if (a.priority == b.priority)
+		static const UINT32 NUM_DIGITS = 8;
+		static const UINT32 NUM_BUCKETS = 256;
+
+		// Histograms of all digits are built in a single pass over the keys
+		UINT32 histograms[NUM_DIGITS][NUM_BUCKETS];
+		memset(histograms, 0, sizeof(histograms));
+
+		for (UINT32 i = 0; i < count; i++)
 		{
-			if (a.sortType == QueueSortType::None || a.sortType != b.sortType)
-				return a.seqIdx < b.seqIdx;
+			UINT64 key = elements[i].key;
+			for (UINT32 j = 0; j < NUM_DIGITS; j++)
+				histograms[j][(key >> (j * 8)) & 0xFF]++;
+		}
 
-			if (a.distFromCamera == b.distFromCamera)
-				return a.seqIdx < b.seqIdx;
+		SortElement* src = elements;
+		SortElement* dst = buffer;
+		for (UINT32 i = 0; i < NUM_DIGITS; i++)
+		{
+			UINT32* histogram = histograms[i];
 
-			if (a.sortType == QueueSortType::FrontToBack)
-				return a.distFromCamera < b.distFromCamera;
-			else
-				return a.distFromCamera > b.distFromCamera;
+			// Skip digits that are the same for all keys, which is common since unused key fields are zero
+			if (histogram[(src[0].key >> (i * 8)) & 0xFF] == count)
+				continue;
+
+			UINT32 offset = 0;
+			for (UINT32 j = 0; j < NUM_BUCKETS; j++)
+			{
+				UINT32 bucketSize = histogram[j];
+				histogram[j] = offset;
+				offset += bucketSize;
+			}
+
+			for (UINT32 j = 0; j < count; j++)
+			{
+				UINT32 bucket = (src[j].key >> (i * 8)) & 0xFF;
+				dst[histogram[bucket]++] = src[j];
+			}
+
+			std::swap(src, dst);
 		}
 
-		return a.priority > b.priority;
+		return src;
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
 	{
 		return mSortedRenderElements;
 	}
-}
\ No newline at end of file
+}
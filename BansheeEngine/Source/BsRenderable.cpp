@@ -27,6 +27,7 @@ namespace BansheeEngine
 		:Component(parent), mLayer(1), mCoreDirtyFlags(0xFFFFFFFF), mActiveProxy(nullptr)
 	{
 		setName("Renderable");
+		setUpdateMode(ComponentUpdateMode::None);
 
 		mMaterialData.resize(1);
 	}
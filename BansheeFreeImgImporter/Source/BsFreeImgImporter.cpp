@@ -9,6 +9,7 @@
 #include "BsTextureManager.h"
 #include "BsTexture.h"
 #include "BsTextureImportOptions.h"
+#include "BsTextureProcessor.h"
 #include "BsFileSystem.h"
 #include "BsCoreApplication.h"
 #include "BsCoreThread.h"
@@ -155,19 +156,22 @@ namespace BansheeEngine
 		TexturePtr newTexture = Texture::_createPtr(TEX_TYPE_2D, 
 			imgData->getWidth(), imgData->getHeight(), numMips, textureImportOptions->getFormat());
 
-		Vector<PixelDataPtr> mipLevels;
-		if (numMips > 0)
-			mipLevels = PixelUtil::genMipmaps(*imgData, MipMapGenOptions());
-		else
-			mipLevels.insert(mipLevels.begin(), imgData);
-
 		newTexture->synchronize(); // TODO - Required due to a bug in allocateSubresourceBuffer
-		for (UINT32 mip = 0; mip < (UINT32)mipLevels.size(); ++mip)
+
+		Vector<PixelDataPtr> mipLevels;
+		for (UINT32 mip = 0; mip <= numMips; ++mip)
 		{
 			UINT32 subresourceIdx = newTexture->mapToSubresourceIdx(0, mip);
-			PixelDataPtr dst = newTexture->allocateSubresourceBuffer(subresourceIdx);
+			mipLevels.push_back(newTexture->allocateSubresourceBuffer(subresourceIdx));
+		}
+
+		// Mip levels are generated, converted and compressed directly into the subresource buffers
+		TextureProcessor::process(*imgData, mipLevels, MipMapGenOptions(), CompressionOptions());
 
-			PixelUtil::bulkPixelConversion(*mipLevels[mip], *dst);
+		for (UINT32 mip = 0; mip <= numMips; ++mip)
+		{
+			UINT32 subresourceIdx = newTexture->mapToSubresourceIdx(0, mip);
+			PixelDataPtr dst = mipLevels[mip];
 
 			dst->_lock();
 			gCoreThread().queueReturnCommand(std::bind(&RenderSystem::writeSubresource, RenderSystem::instancePtr(), newTexture, subresourceIdx, dst, false, _1));
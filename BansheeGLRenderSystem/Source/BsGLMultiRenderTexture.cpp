@@ -20,7 +20,7 @@ namespace BansheeEngine
 	void GLMultiRenderTexture::initialize_internal()
 	{
 		if(mFB != nullptr)
-			bs_delete(mFB);
+			bs_delete<PoolAlloc>(mFB);
 
 		mFB = bs_new<GLFrameBufferObject, PoolAlloc>();
 
@@ -66,7 +66,7 @@ namespace BansheeEngine
 	void GLMultiRenderTexture::destroy_internal()
 	{
 		if(mFB != nullptr)
-			bs_delete(mFB);
+			bs_delete<PoolAlloc>(mFB);
 
 		MultiRenderTexture::destroy_internal();
 	}
@@ -0,0 +1,101 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Types of render system calls recorded by the null render system.
+	 */
+	enum class NullCommandType
+	{
+		SetSamplerState,
+		SetBlendState,
+		SetRasterizerState,
+		SetDepthStencilState,
+		SetTexture,
+		BeginFrame,
+		EndFrame,
+		SetViewport,
+		SetVertexBuffers,
+		SetIndexBuffer,
+		SetVertexDeclaration,
+		SetDrawOperation,
+		Draw,
+		DrawIndexed,
+		BindGpuProgram,
+		UnbindGpuProgram,
+		BindGpuParams,
+		SetScissorRect,
+		ClearRenderTarget,
+		ClearViewport,
+		SetRenderTarget,
+		SwapBuffers,
+		Count // Keep at end
+	};
+
+	/**
+	 * @brief	Records render system calls issued to the null render system, so they can be inspected
+	 *			or replayed later against any render system (e.g. to measure only the submission cost of a
+	 *			previously captured frame).
+	 *
+	 * @note	Commands keep references to the objects they were called with, not copies of them. GPU parameters
+	 *			replayed after they were modified will use their current values.
+	 *
+	 *			Core thread only.
+	 */
+	class BS_NULL_EXPORT NullCommandLog
+	{
+	public:
+		/**
+		 * @brief	A single recorded render system call.
+		 */
+		struct Command
+		{
+			NullCommandType type;
+			std::function<void(RenderSystem&)> execute;
+		};
+
+		NullCommandLog();
+
+		/**
+		 * @brief	Appends a new command to the end of the log.
+		 *
+		 * @param	type	Type of the recorded call.
+		 * @param	execute	Callback that issues the same call on the provided render system.
+		 */
+		void record(NullCommandType type, std::function<void(RenderSystem&)> execute);
+
+		/**
+		 * @brief	Issues all recorded commands, in recording order, on the provided render system.
+		 */
+		void replay(RenderSystem& renderSystem) const;
+
+		/**
+		 * @brief	Removes all recorded commands.
+		 */
+		void clear();
+
+		/**
+		 * @brief	Returns all recorded commands, in recording order.
+		 */
+		const Vector<Command>& getCommands() const { return mCommands; }
+
+		/**
+		 * @brief	Returns the number of recorded commands of the specified type.
+		 */
+		UINT32 getNumCommands(NullCommandType type) const { return mCounts[(UINT32)type]; }
+
+		/**
+		 * @brief	Returns a readable name of the specified command type.
+		 */
+		static const char* getName(NullCommandType type);
+
+	private:
+		Vector<Command> mCommands;
+		UINT32 mCounts[(UINT32)NullCommandType::Count];
+	};
+}
@@ -0,0 +1,30 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsEventQuery.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Event query that completes immediately, as the null render system has no GPU work to wait on.
+	 */
+	class BS_NULL_EXPORT NullEventQuery : public EventQuery
+	{
+	public:
+		NullEventQuery();
+		~NullEventQuery();
+
+		/**
+		 * @copydoc EventQuery::begin
+		 */
+		virtual void begin();
+
+		/**
+		 * @copydoc EventQuery::isReady
+		 */
+		virtual bool isReady() const;
+	};
+}
@@ -0,0 +1,74 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsGpuBuffer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Generic GPU buffer backed by system memory.
+	 */
+	class BS_NULL_EXPORT NullGpuBuffer : public GpuBuffer
+	{
+	public:
+		~NullGpuBuffer();
+
+		/**
+		 * @copydoc GpuBuffer::lock
+		 */
+		void* lock(UINT32 offset, UINT32 length, GpuLockOptions options);
+
+		/**
+		 * @copydoc GpuBuffer::unlock
+		 */
+		void unlock();
+
+		/**
+		 * @copydoc GpuBuffer::readData
+		 */
+		void readData(UINT32 offset, UINT32 length, void* pDest);
+
+		/**
+		 * @copydoc GpuBuffer::writeData
+		 */
+		void writeData(UINT32 offset, UINT32 length, const void* pSource, BufferWriteType writeFlags = BufferWriteType::Normal);
+
+		/**
+		 * @copydoc GpuBuffer::copyData
+		 */
+		void copyData(GpuBuffer& srcBuffer, UINT32 srcOffset,
+			UINT32 dstOffset, UINT32 length, bool discardWholeBuffer = false);
+
+	protected:
+		friend class NullHardwareBufferManager;
+
+		NullGpuBuffer(UINT32 elementCount, UINT32 elementSize, GpuBufferType type, GpuBufferUsage usage,
+			bool randomGpuWrite = false, bool useCounter = false);
+
+		/**
+		 * @copydoc GpuBuffer::createView
+		 */
+		GpuBufferView* createView();
+
+		/**
+		 * @copydoc GpuBuffer::destroyView
+		 */
+		void destroyView(GpuBufferView* view);
+
+		/**
+		 * @copydoc GpuBuffer::initialize_internal
+		 */
+		void initialize_internal();
+
+		/**
+		 * @copydoc GpuBuffer::destroy_internal
+		 */
+		void destroy_internal();
+
+	private:
+		UINT8* mData;
+	};
+}
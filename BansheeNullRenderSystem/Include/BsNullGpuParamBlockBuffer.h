@@ -0,0 +1,39 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsGpuParamBlockBuffer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	GPU parameter block buffer backed by system memory. Same as GenericGpuParamBlockBuffer
+	 *			but also tracks its usage in render statistics.
+	 */
+	class BS_NULL_EXPORT NullGpuParamBlockBuffer : public GenericGpuParamBlockBuffer
+	{
+	public:
+		/**
+		 * @copydoc GpuParamBlockBuffer::writeData
+		 */
+		void writeData(const UINT8* data);
+
+		/**
+		 * @copydoc GpuParamBlockBuffer::readData
+		 */
+		void readData(UINT8* data) const;
+
+	protected:
+		/**
+		 * @copydoc GpuParamBlockBuffer::initialize_internal
+		 */
+		void initialize_internal();
+
+		/**
+		 * @copydoc GpuParamBlockBuffer::destroy_internal
+		 */
+		void destroy_internal();
+	};
+}
@@ -0,0 +1,54 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsGpuProgram.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	HLSL GPU program that is never compiled. Its parameters are parsed directly from the source so the
+	 *			same GPU parameter layout is available as with a real HLSL program.
+	 */
+	class BS_NULL_EXPORT NullGpuProgram : public GpuProgram
+	{
+	public:
+		virtual ~NullGpuProgram();
+
+		/**
+		 * @copydoc	GpuProgram::getLanguage
+		 */
+		const String& getLanguage() const;
+
+		/**
+		 * @copydoc	GpuProgram::createParameters
+		 */
+		GpuParamsPtr createParameters();
+
+		/**
+		 * @copydoc	GpuProgram::requiresMatrixTranspose
+		 */
+		virtual bool requiresMatrixTranspose() const { return true; }
+
+	protected:
+		friend class NullHLSLProgramFactory;
+
+		/**
+		 * @copydoc	GpuProgram::GpuProgram
+		 */
+		NullGpuProgram(const String& source, const String& entryPoint, GpuProgramType gptype, 
+			GpuProgramProfile profile, const Vector<HGpuProgInclude>* includes, bool isAdjacencyInfoRequired);
+
+		/**
+		 * @copydoc GpuProgram::initialize_internal
+		 */
+		void initialize_internal();
+
+		/**
+		 * @copydoc GpuProgram::destroy_internal
+		 */
+		void destroy_internal();
+	};
+}
@@ -0,0 +1,107 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Extracts GPU program parameter descriptions directly from HLSL source, without compiling it.
+	 *
+	 * @note	Only top level declarations are inspected. Constant buffer members are packed following the
+	 *			HLSL packing rules, so offsets match the ones the DirectX compiler would report. Unlike the
+	 *			compiler this doesn't eliminate unused parameters, and struct members are not supported.
+	 */
+	class NullHLSLParamParser
+	{
+	public:
+		/**
+		 * @brief	Parses the provided HLSL source and outputs descriptions of all parameters it declares.
+		 *
+		 * @param	source	HLSL source code to parse.
+		 * @param	desc	Output object that will contain parameter descriptions.
+		 */
+		void parse(const String& source, GpuParamDesc& desc);
+
+	private:
+		/**
+		 * @brief	Describes a single declaration parsed from the source.
+		 */
+		struct Declaration
+		{
+			String type;
+			String name;
+			UINT32 arraySize;
+			bool rowMajor;
+			char registerType; /**< Register class provided with the register keyword, or 0 if not provided. */
+			UINT32 registerIdx;
+			INT32 packOffset; /**< Offset provided with the packoffset keyword in multiples of 4 bytes, or -1 if not provided. */
+		};
+
+		/**
+		 * @brief	Describes a constant buffer and all of its members parsed from the source.
+		 */
+		struct ConstantBuffer
+		{
+			String name;
+			bool hasRegister;
+			UINT32 registerIdx;
+			Vector<Declaration> members;
+		};
+
+		/**
+		 * @brief	Splits the source into tokens, ignoring comments and preprocessor directives.
+		 */
+		void tokenize(const String& source, Vector<String>& tokens);
+
+		/**
+		 * @brief	Parses a single statement starting at the provided token and outputs any variable declarations
+		 *			it contains. Function definitions are skipped.
+		 *
+		 * @return	Index of the first token after the statement.
+		 */
+		UINT32 parseStatement(const Vector<String>& tokens, UINT32 idx, Vector<Declaration>& output);
+
+		/**
+		 * @brief	Parses a constant buffer whose name is located at the provided token.
+		 *
+		 * @return	Index of the first token after the constant buffer.
+		 */
+		UINT32 parseConstantBuffer(const Vector<String>& tokens, UINT32 idx, Vector<ConstantBuffer>& output);
+
+		/**
+		 * @brief	Parses variable declarations from the provided range of tokens, making up a single statement.
+		 */
+		void parseDeclarations(const Vector<String>& tokens, UINT32 begin, UINT32 end, Vector<Declaration>& output);
+
+		/**
+		 * @brief	Skips tokens up to and including the closing brace matching the opening brace at the provided index.
+		 *
+		 * @return	Index of the first token after the closing brace.
+		 */
+		UINT32 skipBraces(const Vector<String>& tokens, UINT32 idx);
+
+		/**
+		 * @brief	Adds all members of the constant buffer to the parameter description and calculates their offsets.
+		 */
+		void packConstantBuffer(const ConstantBuffer& buffer, GpuParamBlockDesc& blockDesc, GpuParamDesc& desc);
+
+		/**
+		 * @brief	Finds the data type and size (in multiples of 4 bytes) of a single element of a data parameter
+		 *			with the provided type name.
+		 *
+		 * @return	False if the type is not a supported data type.
+		 */
+		bool getDataType(const String& type, bool rowMajor, GpuParamDataType& dataType, UINT32& size, bool& isMatrix);
+
+		/**
+		 * @brief	Finds the object type, and register class that the object binds to, for an object parameter with
+		 *			the provided type name.
+		 *
+		 * @return	False if the type is not a supported object type.
+		 */
+		bool getObjectType(const String& type, GpuParamObjectType& objectType, char& registerType);
+	};
+}
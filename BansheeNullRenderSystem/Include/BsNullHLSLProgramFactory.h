@@ -0,0 +1,40 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsGpuProgramManager.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Handles creation of HLSL GPU programs for the null render system.
+	 */
+	class BS_NULL_EXPORT NullHLSLProgramFactory : public GpuProgramFactory
+	{
+	public:
+		NullHLSLProgramFactory();
+		~NullHLSLProgramFactory();
+
+		/**
+		 * @copydoc	GpuProgramFactory::getLanguage
+		 */
+		const String& getLanguage() const;
+
+		/**
+		 * @copydoc	GpuProgramFactory::create(const String&, const String&, GpuProgramType,
+		 *			GpuProgramProfile, const Vector<HGpuProgInclude>*, bool)
+		 */
+		GpuProgramPtr create(const String& source, const String& entryPoint, GpuProgramType gptype, 
+			GpuProgramProfile profile, const Vector<HGpuProgInclude>* includes, bool requireAdjacencyInfo);
+
+		/**
+		 * @copydoc	GpuProgramFactory::create(GpuProgramType)
+		 */
+		GpuProgramPtr create(GpuProgramType type);
+
+	protected:
+		static const String LANGUAGE_NAME;
+	};
+}
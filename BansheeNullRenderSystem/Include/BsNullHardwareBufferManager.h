@@ -0,0 +1,42 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsHardwareBufferManager.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Handles creation of null render system hardware buffers.
+	 */
+	class BS_NULL_EXPORT NullHardwareBufferManager : public HardwareBufferManager
+	{
+	public:
+		NullHardwareBufferManager();
+		~NullHardwareBufferManager();
+
+	protected:
+		/**
+		 * @copydoc HardwareBufferManager::createVertexBufferImpl
+		 */
+		VertexBufferPtr createVertexBufferImpl(UINT32 vertexSize, UINT32 numVerts, GpuBufferUsage usage, bool streamOut = false);
+
+		/**
+		 * @copydoc HardwareBufferManager::createIndexBufferImpl
+		 */
+		IndexBufferPtr createIndexBufferImpl(IndexBuffer::IndexType itype, UINT32 numIndexes, GpuBufferUsage usage);
+
+		/**
+		 * @copydoc HardwareBufferManager::createGpuParamBlockBufferImpl
+		 */
+		GpuParamBlockBufferPtr createGpuParamBlockBufferImpl();
+
+		/**
+		 * @copydoc HardwareBufferManager::createGpuBufferImpl
+		 */
+		GpuBufferPtr createGpuBufferImpl(UINT32 elementCount, UINT32 elementSize,
+			GpuBufferType type, GpuBufferUsage usage, bool randomGpuWrite = false, bool useCounter = false);
+	};
+}
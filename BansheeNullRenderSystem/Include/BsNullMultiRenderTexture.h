@@ -0,0 +1,30 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsMultiRenderTexture.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Null render system implementation of a render texture with multiple color surfaces. 
+	 *			Rendering into it has no effect.
+	 */
+	class BS_NULL_EXPORT NullMultiRenderTexture : public MultiRenderTexture
+	{
+	public:
+		virtual ~NullMultiRenderTexture() { }
+
+		/**
+		 * @copydoc	MultiRenderTexture::requiresTextureFlipping
+		 */
+		bool requiresTextureFlipping() const { return false; }
+
+	protected:
+		friend class NullTextureManager;
+
+		NullMultiRenderTexture() { }
+	};
+}
@@ -0,0 +1,43 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsOcclusionQuery.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Occlusion query that never counts any samples, as the null render system doesn't rasterize.
+	 */
+	class BS_NULL_EXPORT NullOcclusionQuery : public OcclusionQuery
+	{
+	public:
+		NullOcclusionQuery(bool binary);
+		~NullOcclusionQuery();
+
+		/**
+		 * @copydoc OcclusionQuery::begin
+		 */
+		virtual void begin();
+
+		/**
+		 * @copydoc OcclusionQuery::end
+		 */
+		virtual void end();
+
+		/**
+		 * @copydoc OcclusionQuery::isReady
+		 */
+		virtual bool isReady() const;
+
+		/**
+		 * @copydoc OcclusionQuery::getNumSamples
+		 */
+		virtual UINT32 getNumSamples();
+
+	private:
+		bool mQueryEndCalled;
+	};
+}
@@ -0,0 +1,47 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace BansheeEngine
+{
+	class NullRenderSystem;
+	class NullRenderWindow;
+	class NullRenderWindowManager;
+	class NullTexture;
+	class NullTextureManager;
+	class NullRenderTexture;
+	class NullMultiRenderTexture;
+	class NullHardwareBufferManager;
+	class NullVertexBuffer;
+	class NullIndexBuffer;
+	class NullGpuBuffer;
+	class NullGpuParamBlockBuffer;
+	class NullGpuProgram;
+	class NullHLSLProgramFactory;
+	class NullQueryManager;
+	class NullEventQuery;
+	class NullTimerQuery;
+	class NullOcclusionQuery;
+	class NullHLSLParamParser;
+	class NullCommandLog;
+
+	typedef std::shared_ptr<NullRenderWindow> NullRenderWindowPtr;
+	typedef std::shared_ptr<NullGpuProgram> NullGpuProgramPtr;
+
+#if (BS_PLATFORM == BS_PLATFORM_WIN32) && !defined(BS_STATIC_LIB)
+#	ifdef BS_RSNULL_EXPORTS
+#		define BS_NULL_EXPORT __declspec(dllexport)
+#	else
+#       if defined( __MINGW32__ )
+#           define BS_NULL_EXPORT
+#       else
+#    		define BS_NULL_EXPORT __declspec(dllimport)
+#       endif
+#	endif
+#else
+#	define BS_NULL_EXPORT
+#endif
+}
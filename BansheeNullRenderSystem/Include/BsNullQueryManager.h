@@ -0,0 +1,32 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsQueryManager.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Handles creation of null render system queries.
+	 */
+	class BS_NULL_EXPORT NullQueryManager : public QueryManager
+	{
+	public:
+		/**
+		 * @copydoc		QueryManager::createEventQuery
+		 */
+		EventQueryPtr createEventQuery() const;
+
+		/**
+		 * @copydoc		QueryManager::createTimerQuery
+		 */
+		TimerQueryPtr createTimerQuery() const;
+
+		/**
+		 * @copydoc		QueryManager::createOcclusionQuery
+		 */
+		OcclusionQueryPtr createOcclusionQuery(bool binary) const;
+	};
+}
@@ -0,0 +1,216 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsRenderSystem.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Render system that doesn't use a GPU. All resources are backed by system memory and all
+	 *			rendering calls are only validated and counted in RenderStats.
+	 *
+	 *			Meant for measuring CPU side frame cost (e.g. for benchmarks and regression tests on machines
+	 *			without a GPU). Optionally records all calls into a command log that can be replayed later.
+	 */
+	class BS_NULL_EXPORT NullRenderSystem : public RenderSystem
+	{
+	public:
+		NullRenderSystem();
+		~NullRenderSystem();
+
+		/**
+		 * @copydoc RenderSystem::getName
+		 */
+		const String& getName() const;
+
+		/**
+		 * @copydoc RenderSystem::getShadingLanguageName
+		 */
+		const String& getShadingLanguageName() const;
+
+		/**
+		 * @copydoc	RenderSystem::setBlendState
+		 */
+		void setBlendState(const BlendStatePtr& blendState);
+
+		/**
+		 * @copydoc	RenderSystem::setRasterizerState
+		 */
+		void setRasterizerState(const RasterizerStatePtr& rasterizerState);
+
+		/**
+		 * @copydoc	RenderSystem::setDepthStencilState
+		 */
+		void setDepthStencilState(const DepthStencilStatePtr& depthStencilState, UINT32 stencilRefValue);
+
+		/**
+		 * @copydoc	RenderSystem::setSamplerState
+		 */
+		void setSamplerState(GpuProgramType gptype, UINT16 texUnit, const SamplerStatePtr& samplerState);
+
+		/**
+		 * @copydoc	RenderSystem::setTexture
+		 */
+		void setTexture(GpuProgramType gptype, UINT16 unit, bool enabled, const TexturePtr& texPtr);
+
+		/**
+		 * @copydoc	RenderSystem::beginFrame
+		 */
+		void beginFrame();
+
+		/**
+		 * @copydoc	RenderSystem::endFrame
+		 */
+		void endFrame();
+
+		/**
+		 * @copydoc	RenderSystem::clearRenderTarget
+		 */
+		void clearRenderTarget(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f, UINT16 stencil = 0);
+
+		/**
+		 * @copydoc	RenderSystem::clearViewport
+		 */
+		void clearViewport(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f, UINT16 stencil = 0);
+
+		/**
+		 * @copydoc	RenderSystem::setRenderTarget
+		 */
+		void setRenderTarget(RenderTargetPtr target);
+
+		/**
+		 * @copydoc	RenderSystem::setViewport
+		 */
+		void setViewport(Viewport vp);
+
+		/**
+		 * @copydoc	RenderSystem::setScissorRect
+		 */
+		void setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom);
+
+		/**
+		 * @copydoc	RenderSystem::setVertexBuffers
+		 */
+		void setVertexBuffers(UINT32 index, VertexBufferPtr* buffers, UINT32 numBuffers);
+
+		/**
+		 * @copydoc	RenderSystem::setIndexBuffer
+		 */
+		void setIndexBuffer(const IndexBufferPtr& buffer);
+
+		/**
+		 * @copydoc	RenderSystem::setVertexDeclaration
+		 */
+		void setVertexDeclaration(VertexDeclarationPtr vertexDeclaration);
+
+		/**
+		 * @copydoc	RenderSystem::setDrawOperation
+		 */
+		void setDrawOperation(DrawOperationType op);
+
+		/**
+		 * @copydoc	RenderSystem::draw
+		 */
+		void draw(UINT32 vertexOffset, UINT32 vertexCount);
+
+		/**
+		 * @copydoc	RenderSystem::drawIndexed
+		 */
+		void drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount);
+
+		/**
+		 * @copydoc	RenderSystem::swapBuffers
+		 */
+		void swapBuffers(RenderTargetPtr target);
+
+		/**
+		 * @copydoc	RenderSystem::bindGpuProgram
+		 */
+		void bindGpuProgram(HGpuProgram prg);
+
+		/**
+		 * @copydoc	RenderSystem::unbindGpuProgram
+		 */
+		void unbindGpuProgram(GpuProgramType gptype);
+
+		/**
+		 * @copydoc	RenderSystem::bindGpuParams
+		 */
+		void bindGpuParams(GpuProgramType gptype, GpuParamsPtr params);
+
+		/**
+		 * @copydoc	RenderSystem::convertProjectionMatrix
+		 */
+		void convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest, bool forGpuProgram = false);
+
+		/**
+		 * @copydoc	RenderSystem::getColorVertexElementType
+		 */
+		VertexElementType getColorVertexElementType() const;
+
+		/**
+		 * @copydoc	RenderSystem::getHorizontalTexelOffset
+		 */
+		float getHorizontalTexelOffset();
+
+		/**
+		 * @copydoc	RenderSystem::getVerticalTexelOffset
+		 */
+		float getVerticalTexelOffset();
+
+		/**
+		 * @copydoc	RenderSystem::getMinimumDepthInputValue
+		 */
+		float getMinimumDepthInputValue();
+
+		/**
+		 * @copydoc	RenderSystem::getMaximumDepthInputValue
+		 */
+		float getMaximumDepthInputValue();
+
+		/**
+		 * @brief	Enables or disables recording of render system calls into the command log.
+		 *			Disabling recording clears the log.
+		 */
+		void setCommandLogEnabled(bool enabled);
+
+		/**
+		 * @brief	Returns the log of recorded render system calls, or null if recording is disabled.
+		 */
+		NullCommandLog* getCommandLog() const { return mCommandLog; }
+
+	protected:
+		friend class NullRenderSystemFactory;
+
+		/**
+		 * @copydoc	RenderSystem::initialize_internal
+		 */
+		void initialize_internal(AsyncOp& asyncOp);
+
+		/**
+		 * @copydoc	RenderSystem::destroy_internal
+		 */
+		void destroy_internal();
+
+		/**
+		 * @copydoc	RenderSystem::setClipPlanesImpl
+		 */
+		void setClipPlanesImpl(const PlaneList& clipPlanes);
+
+		/**
+		 * @brief	Creates and populates a set of render system capabilities describing which functionality
+		 *			is available.
+		 */
+		RenderSystemCapabilities* createRenderSystemCapabilities() const;
+
+	private:
+		NullHLSLProgramFactory* mHLSLFactory;
+		NullCommandLog* mCommandLog;
+
+		RectI mViewportRect;
+		DrawOperationType mActiveDrawOp;
+	};
+}
@@ -0,0 +1,29 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsRenderTexture.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Null render system implementation of a render texture. Rendering into it has no effect.
+	 */
+	class BS_NULL_EXPORT NullRenderTexture : public RenderTexture
+	{
+	public:
+		virtual ~NullRenderTexture() { }
+
+		/**
+		 * @copydoc	RenderTexture::requiresTextureFlipping
+		 */
+		bool requiresTextureFlipping() const { return false; }
+
+	protected:
+		friend class NullTextureManager;
+
+		NullRenderTexture() { }
+	};
+}
@@ -0,0 +1,83 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsRenderWindow.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Render window that isn't backed by an OS window or a swap chain. Keeps track of its size
+	 *			and position so code querying it behaves as if a real window existed.
+	 */
+	class BS_NULL_EXPORT NullRenderWindow : public RenderWindow
+	{
+	public:
+		~NullRenderWindow();
+
+		/**
+		 * @copydoc RenderWindow::move
+		 */
+		void move(INT32 left, INT32 top);
+
+		/**
+		 * @copydoc RenderWindow::resize
+		 */
+		void resize(UINT32 width, UINT32 height);
+
+		/**
+		 * @copydoc RenderWindow::setHidden
+		 */
+		void setHidden(bool hidden);
+
+		/**
+		 * @copydoc RenderWindow::copyToMemory
+		 */
+		void copyToMemory(PixelData &dst, FrameBuffer buffer);
+
+		/**
+		 * @copydoc RenderWindow::isClosed
+		 */
+		bool isClosed() const { return false; }
+
+		/**
+		 * @copydoc RenderWindow::isHidden
+		 */
+		bool isHidden() const { return mHidden; }
+
+		/**
+		 * @copydoc RenderWindow::screenToWindowPos
+		 */
+		Vector2I screenToWindowPos(const Vector2I& screenPos) const;
+
+		/**
+		 * @copydoc RenderWindow::windowToScreenPos
+		 */
+		Vector2I windowToScreenPos(const Vector2I& windowPos) const;
+
+		/**
+		 * @copydoc RenderWindow::getCustomAttribute
+		 */
+		void getCustomAttribute(const String& name, void* pData) const;
+
+		/**
+		 * @copydoc RenderWindow::requiresTextureFlipping
+		 */
+		bool requiresTextureFlipping() const { return false; }
+
+	protected:
+		friend class NullRenderWindowManager;
+
+		/**
+		 * @copydoc	RenderWindow::RenderWindow
+		 */
+		NullRenderWindow(const RENDER_WINDOW_DESC& desc);
+
+		/**
+		 * @copydoc RenderWindow::initialize_internal
+		 */
+		void initialize_internal();
+	};
+}
@@ -0,0 +1,22 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsRenderWindowManager.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @copydoc	RenderWindowManager
+	 */
+	class BS_NULL_EXPORT NullRenderWindowManager : public RenderWindowManager
+	{
+	protected:
+		/**
+		 * @copydoc RenderWindowManager::createImpl
+		 */
+		RenderWindowPtr createImpl(RENDER_WINDOW_DESC& desc, RenderWindowPtr parentWindow);
+	};
+}
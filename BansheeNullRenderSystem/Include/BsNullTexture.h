@@ -0,0 +1,68 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsTexture.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Texture backed by system memory. Each face and mip level is stored in a separate buffer.
+	 */
+	class BS_NULL_EXPORT NullTexture : public Texture
+	{
+	public:
+		~NullTexture();
+
+	protected:
+		friend class NullTextureManager;
+
+		NullTexture();
+
+		/**
+		 * @copydoc Texture::initialize_internal
+		 */
+		void initialize_internal();
+
+		/**
+		 * @copydoc Texture::destroy_internal
+		 */
+		void destroy_internal();
+
+		/**
+		 * @copydoc Texture::lockImpl
+		 */
+		PixelData lockImpl(GpuLockOptions options, UINT32 mipLevel = 0, UINT32 face = 0);
+
+		/**
+		 * @copydoc Texture::unlockImpl
+		 */
+		void unlockImpl();
+
+		/**
+		 * @copydoc Texture::copyImpl
+		 */
+		void copyImpl(TexturePtr& target);
+
+		/**
+		 * @copydoc Texture::readData
+		 */
+		void readData(PixelData& dest, UINT32 mipLevel = 0, UINT32 face = 0);
+
+		/**
+		 * @copydoc Texture::writeData
+		 */
+		void writeData(const PixelData& src, UINT32 mipLevel = 0, UINT32 face = 0, bool discardWholeBuffer = false);
+
+		/**
+		 * @brief	Returns a pixel data object describing the specified face and mip level,
+		 *			pointing to its system memory buffer.
+		 */
+		PixelData getSurface(UINT32 mipLevel, UINT32 face) const;
+
+	protected:
+		Vector<UINT8*> mSurfaces;
+	};
+}
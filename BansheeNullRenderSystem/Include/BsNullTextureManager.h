@@ -0,0 +1,41 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsTextureManager.h"
+
+namespace BansheeEngine 
+{
+	/**
+	 * @brief	Handles creation of system memory textures used by the null render system.
+	 */
+	class BS_NULL_EXPORT NullTextureManager : public TextureManager
+	{
+	public:
+		NullTextureManager();
+		~NullTextureManager();
+
+		/**
+		 * @copydoc	TextureManager::getNativeFormat
+		 */
+		PixelFormat getNativeFormat(TextureType ttype, PixelFormat format, int usage, bool hwGamma);
+
+	protected:		
+		/**
+		 * @copydoc	TextureManager::createTextureImpl
+		 */
+		TexturePtr createTextureImpl();
+
+		/**
+		 * @copydoc	TextureManager::createRenderTextureImpl
+		 */
+		RenderTexturePtr createRenderTextureImpl();
+
+		/**
+		 * @copydoc	TextureManager::createMultiRenderTextureImpl
+		 */
+		MultiRenderTexturePtr createMultiRenderTextureImpl();
+	};
+}
@@ -0,0 +1,47 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsTimerQuery.h"
+#include "BsTimer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Timer query that measures CPU time elapsed between its begin and end calls. Since the null
+	 *			render system does all of its work on the CPU this is the time spent submitting the commands.
+	 */
+	class BS_NULL_EXPORT NullTimerQuery : public TimerQuery
+	{
+	public:
+		NullTimerQuery();
+		~NullTimerQuery();
+
+		/**
+		 * @copydoc TimerQuery::begin
+		 */
+		virtual void begin();
+
+		/**
+		 * @copydoc TimerQuery::end
+		 */
+		virtual void end();
+
+		/**
+		 * @copydoc TimerQuery::isReady
+		 */
+		virtual bool isReady() const;
+
+		/**
+		 * @copydoc TimerQuery::getTimeMs
+		 */
+		virtual float getTimeMs();
+
+	private:
+		Timer mTimer;
+		bool mQueryEndCalled;
+		float mTimeDelta;
+	};
+}
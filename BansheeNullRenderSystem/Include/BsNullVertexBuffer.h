@@ -0,0 +1,56 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsVertexBuffer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Vertex buffer backed by system memory.
+	 */
+	class BS_NULL_EXPORT NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		~NullVertexBuffer();
+
+		/**
+		 * @copydoc HardwareBuffer::readData
+		 */
+		void readData(UINT32 offset, UINT32 length, void* pDest);
+
+		/**
+		 * @copydoc HardwareBuffer::writeData
+		 */
+		void writeData(UINT32 offset, UINT32 length, const void* pSource, BufferWriteType writeFlags = BufferWriteType::Normal);
+
+	protected:
+		friend class NullHardwareBufferManager;
+
+		NullVertexBuffer(UINT32 vertexSize, UINT32 numVertices, GpuBufferUsage usage);
+
+		/**
+		 * @copydoc HardwareBuffer::lockImpl
+		 */
+		void* lockImpl(UINT32 offset, UINT32 length, GpuLockOptions options);
+
+		/**
+		 * @copydoc HardwareBuffer::unlockImpl
+		 */
+		void unlockImpl();
+
+		/**
+		 * @copydoc VertexBuffer::initialize_internal
+		 */
+		void initialize_internal();
+
+		/**
+		 * @copydoc VertexBuffer::destroy_internal
+		 */
+		void destroy_internal();
+
+		UINT8* mData;
+	};
+}
@@ -0,0 +1,38 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "BsVideoModeInfo.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @copydoc	VideoMode
+	 */
+	class BS_NULL_EXPORT NullVideoMode : public VideoMode
+	{
+	public:
+		NullVideoMode(UINT32 width, UINT32 height, float refreshRate, UINT32 outputIdx);
+	};
+
+	/**
+	 * @brief	Describes a single imaginary output the null render system renders to.
+	 */
+	class BS_NULL_EXPORT NullVideoOutputInfo : public VideoOutputInfo
+	{
+	public:
+		NullVideoOutputInfo();
+	};
+
+	/**
+	 * @brief	Video mode information for the null render system. Reports a single
+	 *			output with a single 1920x1080 video mode.
+	 */
+	class BS_NULL_EXPORT NullVideoModeInfo : public VideoModeInfo
+	{
+	public:
+		NullVideoModeInfo();
+	};
+}
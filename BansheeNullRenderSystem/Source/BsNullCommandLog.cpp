@@ -0,0 +1,68 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullCommandLog.h"
+#include "BsRenderSystem.h"
+
+namespace BansheeEngine
+{
+	NullCommandLog::NullCommandLog()
+	{
+		memset(mCounts, 0, sizeof(mCounts));
+	}
+
+	void NullCommandLog::record(NullCommandType type, std::function<void(RenderSystem&)> execute)
+	{
+		Command command;
+		command.type = type;
+		command.execute = std::move(execute);
+
+		mCommands.push_back(std::move(command));
+		mCounts[(UINT32)type]++;
+	}
+
+	void NullCommandLog::replay(RenderSystem& renderSystem) const
+	{
+		for (auto& command : mCommands)
+			command.execute(renderSystem);
+	}
+
+	void NullCommandLog::clear()
+	{
+		mCommands.clear();
+		memset(mCounts, 0, sizeof(mCounts));
+	}
+
+	const char* NullCommandLog::getName(NullCommandType type)
+	{
+		static const char* names[] =
+		{
+			"SetSamplerState",
+			"SetBlendState",
+			"SetRasterizerState",
+			"SetDepthStencilState",
+			"SetTexture",
+			"BeginFrame",
+			"EndFrame",
+			"SetViewport",
+			"SetVertexBuffers",
+			"SetIndexBuffer",
+			"SetVertexDeclaration",
+			"SetDrawOperation",
+			"Draw",
+			"DrawIndexed",
+			"BindGpuProgram",
+			"UnbindGpuProgram",
+			"BindGpuParams",
+			"SetScissorRect",
+			"ClearRenderTarget",
+			"ClearViewport",
+			"SetRenderTarget",
+			"SwapBuffers"
+		};
+
+		static_assert(sizeof(names) / sizeof(names[0]) == (UINT32)NullCommandType::Count, "Command name list out of date.");
+
+		return names[(UINT32)type];
+	}
+}
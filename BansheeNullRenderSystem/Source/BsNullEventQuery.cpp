@@ -0,0 +1,28 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullEventQuery.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	NullEventQuery::NullEventQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullEventQuery::~NullEventQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullEventQuery::begin()
+	{
+		setActive(true);
+	}
+
+	bool NullEventQuery::isReady() const
+	{
+		return true;
+	}
+}
@@ -0,0 +1,94 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullGpuBuffer.h"
+#include "BsGpuBufferView.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	NullGpuBuffer::NullGpuBuffer(UINT32 elementCount, UINT32 elementSize, GpuBufferType type, GpuBufferUsage usage, bool randomGpuWrite, bool useCounter)
+		: GpuBuffer(elementCount, elementSize, type, usage, randomGpuWrite, useCounter), mData(nullptr)
+	{ }
+
+	NullGpuBuffer::~NullGpuBuffer()
+	{ }
+
+	void NullGpuBuffer::initialize_internal()
+	{
+		UINT32 size = mElementCount * mElementSize;
+
+		mData = (UINT8*)bs_alloc(size);
+		memset(mData, 0, size);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuBuffer);
+
+		GpuBuffer::initialize_internal();
+	}
+
+	void NullGpuBuffer::destroy_internal()
+	{
+		if (mData != nullptr)
+		{
+			bs_free(mData);
+			mData = nullptr;
+		}
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuBuffer);
+
+		GpuBuffer::destroy_internal();
+	}
+
+	void* NullGpuBuffer::lock(UINT32 offset, UINT32 length, GpuLockOptions options)
+	{
+#if BS_PROFILING_ENABLED
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_GpuBuffer);
+		}
+
+		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuBuffer);
+		}
+#endif
+
+		return mData + offset;
+	}
+
+	void NullGpuBuffer::unlock()
+	{ }
+
+	void NullGpuBuffer::readData(UINT32 offset, UINT32 length, void* pDest)
+	{
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_GpuBuffer);
+
+		memcpy(pDest, mData + offset, length);
+	}
+
+	void NullGpuBuffer::writeData(UINT32 offset, UINT32 length, const void* pSource, BufferWriteType writeFlags)
+	{
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuBuffer);
+
+		memcpy(mData + offset, pSource, length);
+	}
+
+	void NullGpuBuffer::copyData(GpuBuffer& srcBuffer, UINT32 srcOffset,
+		UINT32 dstOffset, UINT32 length, bool discardWholeBuffer)
+	{
+		NullGpuBuffer* nullSrcBuffer = static_cast<NullGpuBuffer*>(&srcBuffer);
+
+		memcpy(mData + dstOffset, nullSrcBuffer->mData + srcOffset, length);
+	}
+
+	GpuBufferView* NullGpuBuffer::createView()
+	{
+		return bs_new<GpuBufferView, PoolAlloc>();
+	}
+
+	void NullGpuBuffer::destroyView(GpuBufferView* view)
+	{
+		if(view != nullptr)
+			bs_delete<PoolAlloc>(view);
+	}
+}
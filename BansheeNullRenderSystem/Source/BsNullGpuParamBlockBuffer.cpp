@@ -0,0 +1,36 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullGpuParamBlockBuffer.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	void NullGpuParamBlockBuffer::writeData(const UINT8* data)
+	{
+		GenericGpuParamBlockBuffer::writeData(data);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+	}
+
+	void NullGpuParamBlockBuffer::readData(UINT8* data) const
+	{
+		GenericGpuParamBlockBuffer::readData(data);
+
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_GpuParamBuffer);
+	}
+
+	void NullGpuParamBlockBuffer::initialize_internal()
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuParamBuffer);
+
+		GenericGpuParamBlockBuffer::initialize_internal();
+	}
+
+	void NullGpuParamBlockBuffer::destroy_internal()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuParamBuffer);
+
+		GenericGpuParamBlockBuffer::destroy_internal();
+	}
+}
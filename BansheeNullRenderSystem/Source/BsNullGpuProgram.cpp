@@ -0,0 +1,60 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullGpuProgram.h"
+#include "BsNullHLSLParamParser.h"
+#include "BsGpuParams.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	NullGpuProgram::NullGpuProgram(const String& source, const String& entryPoint, GpuProgramType gptype, 
+		GpuProgramProfile profile, const Vector<HGpuProgInclude>* includes, bool isAdjacencyInfoRequired)
+		: GpuProgram(source, entryPoint, gptype, profile, includes, isAdjacencyInfoRequired)
+	{ }
+
+	NullGpuProgram::~NullGpuProgram()
+	{ }
+
+	void NullGpuProgram::initialize_internal()
+	{
+		if (!isSupported())
+		{
+			mIsCompiled = false;
+			mCompileError = "Specified program is not supported by the current render system.";
+
+			GpuProgram::initialize_internal();
+			return;
+		}
+
+		NullHLSLParamParser parser;
+		parser.parse(mSource, *mParametersDesc);
+
+		mIsCompiled = true;
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuProgram);
+
+		GpuProgram::initialize_internal();
+	}
+
+	void NullGpuProgram::destroy_internal()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuProgram);
+
+		GpuProgram::destroy_internal();
+	}
+
+	GpuParamsPtr NullGpuProgram::createParameters()
+	{
+		// Matches the column major layout used by the DirectX 11 render system
+		GpuParamsPtr params = bs_shared_ptr<GpuParams, PoolAlloc>(mParametersDesc, true);
+		return params;
+	}
+
+	const String& NullGpuProgram::getLanguage() const
+	{
+		static String name = "hlsl";
+
+		return name;
+	}
+}
@@ -0,0 +1,707 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullHLSLParamParser.h"
+#include "BsGpuParamDesc.h"
+#include "BsDebug.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Keeps track of used slots for a single register class and finds free ones for parameters
+	 *			without an explicitly assigned register.
+	 */
+	class NullRegisterAllocator
+	{
+	public:
+		void reserve(UINT32 slot, UINT32 count)
+		{
+			if (mUsed.size() < slot + count)
+				mUsed.resize(slot + count, false);
+
+			for (UINT32 i = 0; i < count; i++)
+				mUsed[slot + i] = true;
+		}
+
+		UINT32 allocate(UINT32 count)
+		{
+			UINT32 slot = 0;
+			while (true)
+			{
+				bool free = true;
+				for (UINT32 i = 0; i < count; i++)
+				{
+					if ((slot + i) < mUsed.size() && mUsed[slot + i])
+					{
+						free = false;
+						break;
+					}
+				}
+
+				if (free)
+					break;
+
+				slot++;
+			}
+
+			reserve(slot, count);
+			return slot;
+		}
+
+	private:
+		Vector<bool> mUsed;
+	};
+
+	static bool isIdentifierStart(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+	}
+
+	static bool isDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	void NullHLSLParamParser::parse(const String& source, GpuParamDesc& desc)
+	{
+		Vector<String> tokens;
+		tokenize(source, tokens);
+
+		Vector<Declaration> globals;
+		Vector<ConstantBuffer> buffers;
+
+		UINT32 idx = 0;
+		while (idx < (UINT32)tokens.size())
+		{
+			const String& token = tokens[idx];
+
+			if (token == "cbuffer" || token == "tbuffer")
+				idx = parseConstantBuffer(tokens, idx + 1, buffers);
+			else if (token == ";")
+				idx++;
+			else
+				idx = parseStatement(tokens, idx, globals);
+		}
+
+		// Split globals into objects and data parameters, which end up in the implicit global constant buffer
+		ConstantBuffer globalBuffer;
+		globalBuffer.name = "$Globals";
+		globalBuffer.hasRegister = false;
+		globalBuffer.registerIdx = 0;
+
+		struct ObjectDeclaration
+		{
+			const Declaration* decl;
+			GpuParamObjectType type;
+			char registerType;
+		};
+
+		Vector<ObjectDeclaration> objects;
+		for (auto& decl : globals)
+		{
+			ObjectDeclaration object;
+			object.decl = &decl;
+
+			if (getObjectType(decl.type, object.type, object.registerType))
+			{
+				if (object.type != GPOT_UNKNOWN)
+					objects.push_back(object);
+			}
+			else
+				globalBuffer.members.push_back(decl);
+		}
+
+		if (!globalBuffer.members.empty())
+			buffers.insert(buffers.begin(), globalBuffer);
+
+		// Assign explicitly provided registers first, then fill in the rest
+		NullRegisterAllocator textureRegisters;
+		NullRegisterAllocator samplerRegisters;
+		NullRegisterAllocator uavRegisters;
+		NullRegisterAllocator bufferRegisters;
+
+		auto getAllocator = [&](char registerType) -> NullRegisterAllocator&
+		{
+			switch (registerType)
+			{
+			case 's':
+				return samplerRegisters;
+			case 'u':
+				return uavRegisters;
+			default:
+				return textureRegisters;
+			}
+		};
+
+		for (auto& object : objects)
+		{
+			if (object.decl->registerType != 0)
+				getAllocator(object.registerType).reserve(object.decl->registerIdx, object.decl->arraySize);
+		}
+
+		for (auto& buffer : buffers)
+		{
+			if (buffer.hasRegister)
+				bufferRegisters.reserve(buffer.registerIdx, 1);
+		}
+
+		for (auto& object : objects)
+		{
+			GpuParamObjectDesc memberDesc;
+			memberDesc.name = object.decl->name;
+			memberDesc.type = object.type;
+
+			if (object.decl->registerType != 0)
+				memberDesc.slot = object.decl->registerIdx;
+			else
+				memberDesc.slot = getAllocator(object.registerType).allocate(object.decl->arraySize);
+
+			if (object.registerType == 's')
+				desc.samplers.insert(std::make_pair(memberDesc.name, memberDesc));
+			else if (memberDesc.type >= GPOT_TEXTURE1D && memberDesc.type <= GPOT_TEXTURECUBE)
+				desc.textures.insert(std::make_pair(memberDesc.name, memberDesc));
+			else
+				desc.buffers.insert(std::make_pair(memberDesc.name, memberDesc));
+		}
+
+		for (auto& buffer : buffers)
+		{
+			GpuParamBlockDesc blockDesc;
+			blockDesc.name = buffer.name;
+			blockDesc.slot = buffer.hasRegister ? buffer.registerIdx : bufferRegisters.allocate(1);
+			blockDesc.blockSize = 0;
+			blockDesc.isShareable = buffer.name != "$Globals";
+
+			packConstantBuffer(buffer, blockDesc, desc);
+			desc.paramBlocks.insert(std::make_pair(blockDesc.name, blockDesc));
+		}
+	}
+
+	void NullHLSLParamParser::tokenize(const String& source, Vector<String>& tokens)
+	{
+		UINT32 length = (UINT32)source.size();
+		UINT32 idx = 0;
+		bool lineStart = true;
+
+		while (idx < length)
+		{
+			char c = source[idx];
+
+			if (c == '\n')
+			{
+				lineStart = true;
+				idx++;
+				continue;
+			}
+
+			if (c == ' ' || c == '\t' || c == '\r')
+			{
+				idx++;
+				continue;
+			}
+
+			if (c == '/' && (idx + 1) < length && source[idx + 1] == '/')
+			{
+				while (idx < length && source[idx] != '\n')
+					idx++;
+
+				continue;
+			}
+
+			if (c == '/' && (idx + 1) < length && source[idx + 1] == '*')
+			{
+				idx += 2;
+				while ((idx + 1) < length && !(source[idx] == '*' && source[idx + 1] == '/'))
+					idx++;
+
+				idx += 2;
+				continue;
+			}
+
+			// Preprocessor directives are ignored, including any line continuations
+			if (c == '#' && lineStart)
+			{
+				while (idx < length && source[idx] != '\n')
+				{
+					if (source[idx] == '\\' && (idx + 1) < length && source[idx + 1] == '\n')
+						idx++;
+
+					idx++;
+				}
+
+				continue;
+			}
+
+			lineStart = false;
+
+			if (c == '"')
+			{
+				idx++;
+				while (idx < length && source[idx] != '"')
+					idx++;
+
+				idx++;
+				continue;
+			}
+
+			UINT32 start = idx;
+			if (isIdentifierStart(c) || isDigit(c))
+			{
+				while (idx < length && (isIdentifierStart(source[idx]) || isDigit(source[idx]) || (isDigit(c) && source[idx] == '.')))
+					idx++;
+			}
+			else
+				idx++;
+
+			tokens.push_back(source.substr(start, idx - start));
+		}
+	}
+
+	UINT32 NullHLSLParamParser::skipBraces(const Vector<String>& tokens, UINT32 idx)
+	{
+		UINT32 depth = 0;
+		UINT32 numTokens = (UINT32)tokens.size();
+
+		for (; idx < numTokens; idx++)
+		{
+			if (tokens[idx] == "{")
+				depth++;
+			else if (tokens[idx] == "}")
+			{
+				depth--;
+
+				if (depth == 0)
+					return idx + 1;
+			}
+		}
+
+		return numTokens;
+	}
+
+	UINT32 NullHLSLParamParser::parseStatement(const Vector<String>& tokens, UINT32 idx, Vector<Declaration>& output)
+	{
+		UINT32 numTokens = (UINT32)tokens.size();
+
+		// Struct definitions, possibly followed by a variable declaration of that type
+		if (tokens[idx] == "struct")
+		{
+			while (idx < numTokens && tokens[idx] != "{" && tokens[idx] != ";")
+				idx++;
+
+			if (idx < numTokens && tokens[idx] == "{")
+				idx = skipBraces(tokens, idx);
+
+			UINT32 declStart = idx;
+			while (idx < numTokens && tokens[idx] != ";")
+				idx++;
+
+			if (idx > declStart)
+				LOGWRN("Null HLSL parsing: Skipping variable because it has unsupported type: " + tokens[declStart]);
+
+			return idx + 1;
+		}
+
+		UINT32 start = idx;
+		UINT32 parenDepth = 0;
+		bool hasInitializer = false;
+
+		for (; idx < numTokens; idx++)
+		{
+			const String& token = tokens[idx];
+
+			if (token == "(")
+				parenDepth++;
+			else if (token == ")")
+				parenDepth--;
+			else if (token == "=")
+				hasInitializer = true;
+			else if (token == "{" && parenDepth == 0)
+			{
+				// Either a function body or an initializer list
+				if (!hasInitializer)
+					return skipBraces(tokens, idx);
+
+				idx = skipBraces(tokens, idx) - 1;
+			}
+			else if (token == "}" && parenDepth == 0)
+			{
+				// End of an enclosing block, let the caller handle it
+				parseDeclarations(tokens, start, idx, output);
+				return idx;
+			}
+			else if (token == ";" && parenDepth == 0)
+			{
+				parseDeclarations(tokens, start, idx, output);
+				return idx + 1;
+			}
+		}
+
+		return numTokens;
+	}
+
+	UINT32 NullHLSLParamParser::parseConstantBuffer(const Vector<String>& tokens, UINT32 idx, Vector<ConstantBuffer>& output)
+	{
+		UINT32 numTokens = (UINT32)tokens.size();
+
+		ConstantBuffer buffer;
+		buffer.hasRegister = false;
+		buffer.registerIdx = 0;
+
+		if (idx < numTokens)
+			buffer.name = tokens[idx++];
+
+		while (idx < numTokens && tokens[idx] != "{")
+		{
+			if (tokens[idx] == "register" && (idx + 2) < numTokens)
+			{
+				const String& reg = tokens[idx + 2];
+				if (reg.size() > 1 && (reg[0] == 'b' || reg[0] == 'B'))
+				{
+					buffer.hasRegister = true;
+					buffer.registerIdx = parseUnsignedInt(reg.substr(1));
+				}
+			}
+
+			idx++;
+		}
+
+		idx++; // Skip the opening brace
+		while (idx < numTokens && tokens[idx] != "}")
+		{
+			if (tokens[idx] == ";")
+				idx++;
+			else
+				idx = parseStatement(tokens, idx, buffer.members);
+		}
+
+		idx++; // Skip the closing brace
+		if (idx < numTokens && tokens[idx] == ";")
+			idx++;
+
+		output.push_back(buffer);
+		return idx;
+	}
+
+	void NullHLSLParamParser::parseDeclarations(const Vector<String>& tokens, UINT32 begin, UINT32 end, Vector<Declaration>& output)
+	{
+		UINT32 idx = begin;
+		bool rowMajor = false;
+
+		// Modifiers
+		for (; idx < end; idx++)
+		{
+			const String& token = tokens[idx];
+
+			// Not visible to the application
+			if (token == "static" || token == "groupshared" || token == "typedef")
+				return;
+
+			if (token == "row_major")
+				rowMajor = true;
+			else if (token == "column_major")
+				rowMajor = false;
+			else if (token != "uniform" && token != "const" && token != "extern" && token != "precise" && 
+				token != "volatile" && token != "shared" && token != "nointerpolation")
+			{
+				break;
+			}
+		}
+
+		if (idx >= end || !isIdentifierStart(tokens[idx][0]))
+			return;
+
+		String type = tokens[idx++];
+
+		// Template arguments don't matter, the type name alone determines the parameter type
+		if (idx < end && tokens[idx] == "<")
+		{
+			while (idx < end && tokens[idx] != ">")
+				idx++;
+
+			idx++;
+		}
+
+		while (idx < end)
+		{
+			Declaration decl;
+			decl.type = type;
+			decl.arraySize = 1;
+			decl.rowMajor = rowMajor;
+			decl.registerType = 0;
+			decl.registerIdx = 0;
+			decl.packOffset = -1;
+
+			if (!isIdentifierStart(tokens[idx][0]))
+				return;
+
+			decl.name = tokens[idx++];
+
+			while (idx < end && tokens[idx] == "[")
+			{
+				idx++;
+
+				if (idx < end && isDigit(tokens[idx][0]))
+					decl.arraySize *= parseUnsignedInt(tokens[idx]);
+				else
+					LOGWRN("Null HLSL parsing: Unable to determine array size of variable: " + decl.name);
+
+				while (idx < end && tokens[idx] != "]")
+					idx++;
+
+				idx++;
+			}
+
+			while (idx < end && tokens[idx] == ":")
+			{
+				idx++;
+				if (idx >= end)
+					break;
+
+				if (tokens[idx] == "register" && (idx + 2) < end)
+				{
+					const String& reg = tokens[idx + 2];
+					if (reg.size() > 1)
+					{
+						decl.registerType = (char)tolower(reg[0]);
+						decl.registerIdx = parseUnsignedInt(reg.substr(1));
+					}
+
+					while (idx < end && tokens[idx] != ")")
+						idx++;
+				}
+				else if (tokens[idx] == "packoffset" && (idx + 2) < end)
+				{
+					const String& reg = tokens[idx + 2];
+					if (reg.size() > 1)
+					{
+						decl.packOffset = parseUnsignedInt(reg.substr(1)) * 4;
+
+						if ((idx + 4) < end && tokens[idx + 3] == ".")
+						{
+							char component = tokens[idx + 4][0];
+							switch (component)
+							{
+							case 'y': case 'g':
+								decl.packOffset += 1;
+								break;
+							case 'z': case 'b':
+								decl.packOffset += 2;
+								break;
+							case 'w': case 'a':
+								decl.packOffset += 3;
+								break;
+							}
+						}
+					}
+
+					while (idx < end && tokens[idx] != ")")
+						idx++;
+				}
+
+				idx++; // Skip the semantic, or the closing parenthesis
+			}
+
+			// Skip the initializer
+			UINT32 parenDepth = 0;
+			while (idx < end && !(tokens[idx] == "," && parenDepth == 0))
+			{
+				if (tokens[idx] == "(")
+					parenDepth++;
+				else if (tokens[idx] == ")")
+					parenDepth--;
+
+				idx++;
+			}
+
+			output.push_back(decl);
+
+			if (idx < end && tokens[idx] == ",")
+				idx++;
+		}
+	}
+
+	void NullHLSLParamParser::packConstantBuffer(const ConstantBuffer& buffer, GpuParamBlockDesc& blockDesc, GpuParamDesc& desc)
+	{
+		// All values in multiples of 4 bytes. Constant buffers are made of 16 byte registers, and a single
+		// element is not allowed to cross a register boundary. Matrices and arrays always start at a new register,
+		// and each array element is aligned to a register.
+		UINT32 offset = 0;
+		UINT32 end = 0;
+
+		for (auto& member : buffer.members)
+		{
+			GpuParamDataDesc memberDesc;
+			memberDesc.name = member.name;
+			memberDesc.paramBlockSlot = blockDesc.slot;
+			memberDesc.arraySize = member.arraySize;
+
+			bool isMatrix = false;
+			if (!getDataType(member.type, member.rowMajor, memberDesc.type, memberDesc.elementSize, isMatrix))
+			{
+				LOGWRN("Null HLSL parsing: Skipping variable because it has unsupported type: " + member.type);
+				continue;
+			}
+
+			UINT32 size;
+			if (member.arraySize > 1)
+			{
+				memberDesc.arrayElementStride = ((memberDesc.elementSize + 3) / 4) * 4;
+				size = memberDesc.arrayElementStride * (member.arraySize - 1) + memberDesc.elementSize;
+			}
+			else
+			{
+				memberDesc.arrayElementStride = memberDesc.elementSize;
+				size = memberDesc.elementSize;
+			}
+
+			if (member.packOffset >= 0)
+				offset = (UINT32)member.packOffset;
+			else
+			{
+				bool crossesRegister = (offset % 4) + size > 4;
+				if (member.arraySize > 1 || isMatrix || crossesRegister)
+					offset = ((offset + 3) / 4) * 4;
+			}
+
+			memberDesc.gpuMemOffset = offset;
+			memberDesc.cpuMemOffset = offset;
+
+			offset += size;
+			end = std::max(end, offset);
+
+			desc.params.insert(std::make_pair(memberDesc.name, memberDesc));
+		}
+
+		blockDesc.blockSize = ((end + 3) / 4) * 4;
+	}
+
+	bool NullHLSLParamParser::getDataType(const String& type, bool rowMajor, GpuParamDataType& dataType, UINT32& size, bool& isMatrix)
+	{
+		String baseType;
+		String dimensions;
+
+		if (type == "matrix")
+		{
+			baseType = "float";
+			dimensions = "4x4";
+		}
+		else
+		{
+			UINT32 dimStart = 0;
+			while (dimStart < (UINT32)type.size() && !isDigit(type[dimStart]))
+				dimStart++;
+
+			baseType = type.substr(0, dimStart);
+			dimensions = type.substr(dimStart);
+		}
+
+		bool isFloat = baseType == "float" || baseType == "half";
+		bool isInt = baseType == "int" || baseType == "uint" || baseType == "dword";
+		bool isBool = baseType == "bool";
+
+		if (!isFloat && !isInt && !isBool)
+			return false;
+
+		isMatrix = false;
+		if (dimensions.empty())
+		{
+			dataType = isFloat ? GPDT_FLOAT1 : (isInt ? GPDT_INT1 : GPDT_BOOL);
+			size = 1;
+
+			return true;
+		}
+
+		if (dimensions.size() == 1)
+		{
+			UINT32 numComponents = dimensions[0] - '0';
+			if (numComponents < 1 || numComponents > 4)
+				return false;
+
+			// Bool vectors have the same layout as int vectors
+			UINT32 baseTypeIdx = isFloat ? GPDT_FLOAT1 : GPDT_INT1;
+			dataType = (GpuParamDataType)(baseTypeIdx + numComponents - 1);
+			size = numComponents;
+
+			return true;
+		}
+
+		if (dimensions.size() == 3 && dimensions[1] == 'x' && isFloat)
+		{
+			UINT32 numRows = dimensions[0] - '0';
+			UINT32 numColumns = dimensions[2] - '0';
+
+			if (numRows < 2 || numRows > 4 || numColumns < 2 || numColumns > 4)
+				return false;
+
+			dataType = (GpuParamDataType)(GPDT_MATRIX_2X2 + (numRows - 2) * 3 + (numColumns - 2));
+			isMatrix = true;
+
+			// Matrices take up one register per column (or row, if row major). The last one doesn't need to be full.
+			if (rowMajor)
+				size = (numRows - 1) * 4 + numColumns;
+			else
+				size = (numColumns - 1) * 4 + numRows;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool NullHLSLParamParser::getObjectType(const String& type, GpuParamObjectType& objectType, char& registerType)
+	{
+		registerType = 't';
+
+		if (type == "SamplerState" || type == "SamplerComparisonState" || type == "sampler")
+		{
+			objectType = GPOT_SAMPLER2D; // Actual dimension of the sampler doesn't matter
+			registerType = 's';
+		}
+		else if (type == "Texture1D")
+			objectType = GPOT_TEXTURE1D;
+		else if (type == "Texture2D")
+			objectType = GPOT_TEXTURE2D;
+		else if (type == "Texture3D")
+			objectType = GPOT_TEXTURE3D;
+		else if (type == "TextureCube")
+			objectType = GPOT_TEXTURECUBE;
+		else if (type == "StructuredBuffer")
+			objectType = GPOT_STRUCTURED_BUFFER;
+		else if (type == "ByteAddressBuffer")
+			objectType = GPOT_BYTE_BUFFER;
+		else if (type == "RWTexture1D" || type == "RWTexture2D" || type == "RWTexture3D" || type == "RWBuffer")
+		{
+			objectType = GPOT_RWTYPED_BUFFER;
+			registerType = 'u';
+		}
+		else if (type == "RWStructuredBuffer")
+		{
+			objectType = GPOT_RWSTRUCTURED_BUFFER;
+			registerType = 'u';
+		}
+		else if (type == "RWByteAddressBuffer")
+		{
+			objectType = GPOT_RWBYTE_BUFFER;
+			registerType = 'u';
+		}
+		else if (type == "AppendStructuredBuffer")
+		{
+			objectType = GPOT_RWAPPEND_BUFFER;
+			registerType = 'u';
+		}
+		else if (type == "ConsumeStructuredBuffer")
+		{
+			objectType = GPOT_RWCONSUME_BUFFER;
+			registerType = 'u';
+		}
+		else if (type.compare(0, 7, "Texture") == 0 || type == "Buffer")
+		{
+			LOGWRN("Null HLSL parsing: Skipping texture because it has unsupported type: " + type);
+			objectType = GPOT_UNKNOWN;
+		}
+		else
+			return false;
+
+		return true;
+	}
+}
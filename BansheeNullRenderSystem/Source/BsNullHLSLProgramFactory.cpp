@@ -0,0 +1,38 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullHLSLProgramFactory.h"
+#include "BsNullGpuProgram.h"
+
+namespace BansheeEngine
+{
+	const String NullHLSLProgramFactory::LANGUAGE_NAME = "hlsl";
+
+	NullHLSLProgramFactory::NullHLSLProgramFactory()
+	{ }
+
+	NullHLSLProgramFactory::~NullHLSLProgramFactory()
+	{ }
+
+	const String& NullHLSLProgramFactory::getLanguage() const
+	{
+		return LANGUAGE_NAME;
+	}
+
+	GpuProgramPtr NullHLSLProgramFactory::create(const String& source, const String& entryPoint, 
+		GpuProgramType gptype, GpuProgramProfile profile, const Vector<HGpuProgInclude>* includes, bool requireAdjacencyInfo)
+	{
+		NullGpuProgram* program = new (bs_alloc<NullGpuProgram, PoolAlloc>()) 
+			NullGpuProgram(source, entryPoint, gptype, profile, includes, requireAdjacencyInfo);
+
+		return bs_core_ptr<NullGpuProgram, PoolAlloc>(program);
+	}
+
+	GpuProgramPtr NullHLSLProgramFactory::create(GpuProgramType type)
+	{
+		NullGpuProgram* program = new (bs_alloc<NullGpuProgram, PoolAlloc>()) 
+			NullGpuProgram("", "", type, GPP_NONE, nullptr, false);
+
+		return bs_core_ptr<NullGpuProgram, PoolAlloc>(program);
+	}
+}
@@ -0,0 +1,48 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullVertexBuffer.h"
+#include "BsNullIndexBuffer.h"
+#include "BsNullGpuBuffer.h"
+#include "BsNullGpuParamBlockBuffer.h"
+
+namespace BansheeEngine
+{
+	NullHardwareBufferManager::NullHardwareBufferManager()
+	{ }
+
+	NullHardwareBufferManager::~NullHardwareBufferManager()
+	{ }
+
+	VertexBufferPtr NullHardwareBufferManager::createVertexBufferImpl(UINT32 vertexSize,
+		UINT32 numVerts, GpuBufferUsage usage, bool streamOut)
+	{
+		NullVertexBuffer* buffer = new (bs_alloc<NullVertexBuffer, PoolAlloc>()) NullVertexBuffer(vertexSize, numVerts, usage);
+
+		return bs_core_ptr<NullVertexBuffer, PoolAlloc>(buffer);
+	}
+
+	IndexBufferPtr NullHardwareBufferManager::createIndexBufferImpl(IndexBuffer::IndexType itype,
+		UINT32 numIndexes, GpuBufferUsage usage)
+	{
+		NullIndexBuffer* buffer = new (bs_alloc<NullIndexBuffer, PoolAlloc>()) NullIndexBuffer(itype, numIndexes, usage);
+
+		return bs_core_ptr<NullIndexBuffer, PoolAlloc>(buffer);
+	}
+
+	GpuParamBlockBufferPtr NullHardwareBufferManager::createGpuParamBlockBufferImpl()
+	{
+		NullGpuParamBlockBuffer* paramBlockBuffer = new (bs_alloc<NullGpuParamBlockBuffer, PoolAlloc>()) NullGpuParamBlockBuffer();
+
+		return bs_core_ptr<NullGpuParamBlockBuffer, PoolAlloc>(paramBlockBuffer);
+	}
+
+	GpuBufferPtr NullHardwareBufferManager::createGpuBufferImpl(UINT32 elementCount, UINT32 elementSize,
+		GpuBufferType type, GpuBufferUsage usage, bool randomGpuWrite, bool useCounter)
+	{
+		NullGpuBuffer* buffer = new (bs_alloc<NullGpuBuffer, PoolAlloc>()) NullGpuBuffer(elementCount, elementSize, type, usage, randomGpuWrite, useCounter);
+
+		return bs_core_ptr<NullGpuBuffer, PoolAlloc>(buffer);
+	}
+}
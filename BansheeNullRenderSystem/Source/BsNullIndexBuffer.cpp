@@ -0,0 +1,68 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullIndexBuffer.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	NullIndexBuffer::NullIndexBuffer(IndexType idxType, UINT32 numIndexes, GpuBufferUsage usage)
+		:IndexBuffer(idxType, numIndexes, usage, true), mData(nullptr)
+	{ }
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{ }
+
+	void* NullIndexBuffer::lockImpl(UINT32 offset, UINT32 length, GpuLockOptions options)
+	{
+#if BS_PROFILING_ENABLED
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_IndexBuffer);
+		}
+
+		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_IndexBuffer);
+		}
+#endif
+
+		return mData + offset;
+	}
+
+	void NullIndexBuffer::unlockImpl()
+	{ }
+
+	void NullIndexBuffer::readData(UINT32 offset, UINT32 length, void* dest)
+	{
+		memcpy(dest, mData + offset, length);
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_IndexBuffer);
+	}
+
+	void NullIndexBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags)
+	{
+		memcpy(mData + offset, source, length);
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_IndexBuffer);
+	}
+
+	void NullIndexBuffer::initialize_internal()
+	{
+		mData = (UINT8*)bs_alloc(mSizeInBytes);
+		memset(mData, 0, mSizeInBytes);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_IndexBuffer);
+		IndexBuffer::initialize_internal();
+	}
+
+	void NullIndexBuffer::destroy_internal()
+	{
+		if(mData != nullptr)
+		{
+			bs_free(mData);
+			mData = nullptr;
+		}
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_IndexBuffer);
+		IndexBuffer::destroy_internal();
+	}
+}
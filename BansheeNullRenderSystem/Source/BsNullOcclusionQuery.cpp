@@ -0,0 +1,40 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullOcclusionQuery.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	NullOcclusionQuery::NullOcclusionQuery(bool binary)
+		:OcclusionQuery(binary), mQueryEndCalled(false)
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullOcclusionQuery::~NullOcclusionQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullOcclusionQuery::begin()
+	{
+		mQueryEndCalled = false;
+		setActive(true);
+	}
+
+	void NullOcclusionQuery::end()
+	{
+		mQueryEndCalled = true;
+	}
+
+	bool NullOcclusionQuery::isReady() const
+	{
+		return mQueryEndCalled;
+	}
+
+	UINT32 NullOcclusionQuery::getNumSamples()
+	{
+		return 0;
+	}
+}
@@ -0,0 +1,13 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullPrerequisites.h"
+#include "BsNullRenderSystemFactory.h"
+
+namespace BansheeEngine
+{
+	extern "C" BS_NULL_EXPORT const String& getPluginName()
+	{
+		return SystemName;
+	}
+}
@@ -0,0 +1,34 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullQueryManager.h"
+#include "BsNullEventQuery.h"
+#include "BsNullTimerQuery.h"
+#include "BsNullOcclusionQuery.h"
+
+namespace BansheeEngine
+{
+	EventQueryPtr NullQueryManager::createEventQuery() const
+	{
+		EventQueryPtr query = std::shared_ptr<NullEventQuery>(bs_new<NullEventQuery>(), &QueryManager::deleteEventQuery, StdAlloc<GenAlloc>());  
+		mEventQueries.push_back(query.get());
+
+		return query;
+	}
+
+	TimerQueryPtr NullQueryManager::createTimerQuery() const
+	{
+		TimerQueryPtr query = std::shared_ptr<NullTimerQuery>(bs_new<NullTimerQuery>(), &QueryManager::deleteTimerQuery, StdAlloc<GenAlloc>());  
+		mTimerQueries.push_back(query.get());
+
+		return query;
+	}
+
+	OcclusionQueryPtr NullQueryManager::createOcclusionQuery(bool binary) const
+	{
+		OcclusionQueryPtr query = std::shared_ptr<NullOcclusionQuery>(bs_new<NullOcclusionQuery>(binary), &QueryManager::deleteOcclusionQuery, StdAlloc<GenAlloc>());
+		mOcclusionQueries.push_back(query.get());
+
+		return query;
+	}
+}
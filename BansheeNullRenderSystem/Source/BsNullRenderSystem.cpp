@@ -0,0 +1,582 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullRenderSystem.h"
+#include "BsNullVideoModeInfo.h"
+#include "BsNullTextureManager.h"
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullRenderWindowManager.h"
+#include "BsNullHLSLProgramFactory.h"
+#include "BsNullQueryManager.h"
+#include "BsNullCommandLog.h"
+#include "BsRenderStateManager.h"
+#include "BsGpuProgramManager.h"
+#include "BsSamplerState.h"
+#include "BsGpuParams.h"
+#include "BsGpuParamDesc.h"
+#include "BsVertexBuffer.h"
+#include "BsIndexBuffer.h"
+#include "BsRenderTarget.h"
+#include "BsViewport.h"
+#include "BsCoreThread.h"
+#include "BsAsyncOp.h"
+#include "BsException.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Detaches the command log for the lifetime of the object, and restores it
+	 *			on destruction, including when an exception is thrown.
+	 */
+	class NullCommandLogSuspender
+	{
+	public:
+		NullCommandLogSuspender(NullCommandLog*& commandLog)
+			:mCommandLog(commandLog), mSuspendedLog(commandLog)
+		{
+			mCommandLog = nullptr;
+		}
+
+		~NullCommandLogSuspender()
+		{
+			mCommandLog = mSuspendedLog;
+		}
+
+	private:
+		NullCommandLog*& mCommandLog;
+		NullCommandLog* mSuspendedLog;
+	};
+
+	NullRenderSystem::NullRenderSystem()
+		:mHLSLFactory(nullptr), mCommandLog(nullptr), mActiveDrawOp(DOT_TRIANGLE_LIST)
+	{ }
+
+	NullRenderSystem::~NullRenderSystem()
+	{ }
+
+	const String& NullRenderSystem::getName() const
+	{
+		static String strName("NullRenderSystem");
+		return strName;
+	}
+
+	const String& NullRenderSystem::getShadingLanguageName() const
+	{
+		static String strName("hlsl");
+		return strName;
+	}
+
+	void NullRenderSystem::initialize_internal(AsyncOp& asyncOp)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mVideoModeInfo = bs_shared_ptr<NullVideoModeInfo>();
+
+		TextureManager::startUp<NullTextureManager>();
+		HardwareBufferManager::startUp<NullHardwareBufferManager>();
+		RenderWindowManager::startUp<NullRenderWindowManager>();
+		RenderStateManager::startUp();
+
+		mHLSLFactory = bs_new<NullHLSLProgramFactory>();
+
+		mCurrentCapabilities = createRenderSystemCapabilities();
+
+		mCurrentCapabilities->addShaderProfile("hlsl");
+		GpuProgramManager::instance().addFactory(mHLSLFactory);
+
+		RenderWindowPtr primaryWindow = RenderWindow::create(mPrimaryWindowDesc);
+
+		QueryManager::startUp<NullQueryManager>();
+
+		RenderSystem::initialize_internal(asyncOp);
+
+		asyncOp._completeOperation(primaryWindow);
+	}
+
+	void NullRenderSystem::destroy_internal()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		setCommandLogEnabled(false);
+
+		QueryManager::shutDown();
+
+		if(mHLSLFactory != nullptr)
+		{
+			GpuProgramManager::instance().removeFactory(mHLSLFactory);
+
+			bs_delete(mHLSLFactory);
+			mHLSLFactory = nullptr;
+		}
+
+		RenderStateManager::shutDown();
+		RenderWindowManager::shutDown();
+		HardwareBufferManager::shutDown();
+		TextureManager::shutDown();
+
+		RenderSystem::destroy_internal();
+	}
+
+	void NullRenderSystem::setCommandLogEnabled(bool enabled)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (enabled && mCommandLog == nullptr)
+			mCommandLog = bs_new<NullCommandLog>();
+		else if (!enabled && mCommandLog != nullptr)
+		{
+			bs_delete(mCommandLog);
+			mCommandLog = nullptr;
+		}
+	}
+
+	void NullRenderSystem::setSamplerState(GpuProgramType gptype, UINT16 texUnit, const SamplerStatePtr& samplerState)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (texUnit >= mCurrentCapabilities->getNumTextureUnits(gptype))
+			BS_EXCEPT(InvalidParametersException, "Invalid sampler unit: " + toString(texUnit));
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::SetSamplerState,
+				[=](RenderSystem& rs) { rs.setSamplerState(gptype, texUnit, samplerState); });
+		}
+
+		BS_INC_RENDER_STAT(NumSamplerBinds);
+	}
+
+	void NullRenderSystem::setBlendState(const BlendStatePtr& blendState)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::SetBlendState,
+				[=](RenderSystem& rs) { rs.setBlendState(blendState); });
+		}
+
+		BS_INC_RENDER_STAT(NumBlendStateChanges);
+	}
+
+	void NullRenderSystem::setRasterizerState(const RasterizerStatePtr& rasterizerState)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::SetRasterizerState,
+				[=](RenderSystem& rs) { rs.setRasterizerState(rasterizerState); });
+		}
+
+		BS_INC_RENDER_STAT(NumRasterizerStateChanges);
+	}
+
+	void NullRenderSystem::setDepthStencilState(const DepthStencilStatePtr& depthStencilState, UINT32 stencilRefValue)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::SetDepthStencilState,
+				[=](RenderSystem& rs) { rs.setDepthStencilState(depthStencilState, stencilRefValue); });
+		}
+
+		BS_INC_RENDER_STAT(NumDepthStencilStateChanges);
+	}
+
+	void NullRenderSystem::setTexture(GpuProgramType gptype, UINT16 unit, bool enabled, const TexturePtr& texPtr)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (unit >= mCurrentCapabilities->getNumTextureUnits(gptype))
+			BS_EXCEPT(InvalidParametersException, "Invalid texture unit: " + toString(unit));
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::SetTexture,
+				[=](RenderSystem& rs) { rs.setTexture(gptype, unit, enabled, texPtr); });
+		}
+
+		BS_INC_RENDER_STAT(NumTextureBinds);
+	}
+
+	void NullRenderSystem::beginFrame()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::BeginFrame, [](RenderSystem& rs) { rs.beginFrame(); });
+	}
+
+	void NullRenderSystem::endFrame()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::EndFrame, [](RenderSystem& rs) { rs.endFrame(); });
+	}
+
+	void NullRenderSystem::setViewport(Viewport vp)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		RenderTargetPtr target = vp.getTarget();
+		setRenderTarget(target);
+
+		mViewportRect = RectI(vp.getX(), vp.getY(), vp.getWidth(), vp.getHeight());
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::SetViewport, [=](RenderSystem& rs) { rs.setViewport(vp); });
+	}
+
+	void NullRenderSystem::setVertexBuffers(UINT32 index, VertexBufferPtr* buffers, UINT32 numBuffers)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		UINT32 maxBoundVertexBuffers = mCurrentCapabilities->getMaxBoundVertexBuffers();
+		if((index + numBuffers) >= maxBoundVertexBuffers)
+			BS_EXCEPT(InvalidParametersException, "Invalid vertex index: " + toString(index) + ". Valid range is 0 .. " + toString(maxBoundVertexBuffers - 1));
+
+		if (mCommandLog != nullptr)
+		{
+			Vector<VertexBufferPtr> boundBuffers(buffers, buffers + numBuffers);
+			mCommandLog->record(NullCommandType::SetVertexBuffers,
+				[=](RenderSystem& rs) mutable { rs.setVertexBuffers(index, boundBuffers.data(), numBuffers); });
+		}
+
+		BS_INC_RENDER_STAT(NumVertexBufferBinds);
+	}
+
+	void NullRenderSystem::setIndexBuffer(const IndexBufferPtr& buffer)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if(buffer->getType() != IndexBuffer::IT_16BIT && buffer->getType() != IndexBuffer::IT_32BIT)
+			BS_EXCEPT(InternalErrorException, "Unsupported index format: " + toString(buffer->getType()));
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::SetIndexBuffer, [=](RenderSystem& rs) { rs.setIndexBuffer(buffer); });
+
+		BS_INC_RENDER_STAT(NumIndexBufferBinds);
+	}
+
+	void NullRenderSystem::setVertexDeclaration(VertexDeclarationPtr vertexDeclaration)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::SetVertexDeclaration,
+				[=](RenderSystem& rs) { rs.setVertexDeclaration(vertexDeclaration); });
+		}
+	}
+
+	void NullRenderSystem::setDrawOperation(DrawOperationType op)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mActiveDrawOp = op;
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::SetDrawOperation, [=](RenderSystem& rs) { rs.setDrawOperation(op); });
+	}
+
+	void NullRenderSystem::bindGpuProgram(HGpuProgram prg)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if(!prg.isLoaded())
+			return;
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::BindGpuProgram, [=](RenderSystem& rs) { rs.bindGpuProgram(prg); });
+
+		RenderSystem::bindGpuProgram(prg);
+
+		BS_INC_RENDER_STAT(NumGpuProgramBinds);
+	}
+
+	void NullRenderSystem::unbindGpuProgram(GpuProgramType gptype)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::UnbindGpuProgram, [=](RenderSystem& rs) { rs.unbindGpuProgram(gptype); });
+
+		RenderSystem::unbindGpuProgram(gptype);
+
+		BS_INC_RENDER_STAT(NumGpuProgramBinds);
+	}
+
+	void NullRenderSystem::bindGpuParams(GpuProgramType gptype, GpuParamsPtr bindableParams)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::BindGpuParams,
+				[=](RenderSystem& rs) { rs.bindGpuParams(gptype, bindableParams); });
+		}
+
+		const GpuParamDesc& paramDesc = bindableParams->getParamDesc();
+
+		// Individual binds below are not recorded, replaying the call above repeats them
+		{
+			NullCommandLogSuspender suspendLog(mCommandLog);
+
+			bindableParams->updateHardwareBuffers();
+
+			for(auto iter = paramDesc.samplers.begin(); iter != paramDesc.samplers.end(); ++iter)
+			{
+				HSamplerState& samplerState = bindableParams->getSamplerState(iter->second.slot);
+
+				if(samplerState == nullptr)
+					setSamplerState(gptype, iter->second.slot, SamplerState::getDefault());
+				else
+					setSamplerState(gptype, iter->second.slot, samplerState.getInternalPtr());
+			}
+
+			for(auto iter = paramDesc.textures.begin(); iter != paramDesc.textures.end(); ++iter)
+			{
+				HTexture texture = bindableParams->getTexture(iter->second.slot);
+
+				if(!texture.isLoaded())
+					setTexture(gptype, iter->second.slot, false, nullptr);
+				else
+					setTexture(gptype, iter->second.slot, true, texture.getInternalPtr());
+			}
+		}
+
+		for(auto iter = paramDesc.paramBlocks.begin(); iter != paramDesc.paramBlocks.end(); ++iter)
+		{
+			if (iter->second.slot >= mCurrentCapabilities->getNumGpuParamBlockBuffers(gptype))
+				BS_EXCEPT(InvalidParametersException, "Invalid param block slot: " + toString(iter->second.slot));
+
+			BS_INC_RENDER_STAT(NumGpuParamBufferBinds);
+		}
+	}
+
+	void NullRenderSystem::draw(UINT32 vertexOffset, UINT32 vertexCount)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::Draw,
+				[=](RenderSystem& rs) { rs.draw(vertexOffset, vertexCount); });
+		}
+
+		UINT32 primCount = vertexCountToPrimCount(mActiveDrawOp, vertexCount);
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount);
+	}
+
+	void NullRenderSystem::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::DrawIndexed,
+				[=](RenderSystem& rs) { rs.drawIndexed(startIndex, indexCount, vertexOffset, vertexCount); });
+		}
+
+		UINT32 primCount = vertexCountToPrimCount(mActiveDrawOp, vertexCount);
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount);
+	}
+
+	void NullRenderSystem::swapBuffers(RenderTargetPtr target)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::SwapBuffers, [=](RenderSystem& rs) { rs.swapBuffers(target); });
+
+		RenderSystem::swapBuffers(target);
+	}
+
+	void NullRenderSystem::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::SetScissorRect,
+				[=](RenderSystem& rs) { rs.setScissorRect(left, top, right, bottom); });
+		}
+	}
+
+	void NullRenderSystem::clearViewport(UINT32 buffers, const Color& color, float depth, UINT16 stencil)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if(mActiveRenderTarget == nullptr)
+			return;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::ClearViewport,
+				[=](RenderSystem& rs) { rs.clearViewport(buffers, color, depth, stencil); });
+		}
+
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderSystem::clearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if(mActiveRenderTarget == nullptr)
+			return;
+
+		if (mCommandLog != nullptr)
+		{
+			mCommandLog->record(NullCommandType::ClearRenderTarget,
+				[=](RenderSystem& rs) { rs.clearRenderTarget(buffers, color, depth, stencil); });
+		}
+
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderSystem::setRenderTarget(RenderTargetPtr target)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mActiveRenderTarget = target;
+
+		if (mCommandLog != nullptr)
+			mCommandLog->record(NullCommandType::SetRenderTarget, [=](RenderSystem& rs) { rs.setRenderTarget(target); });
+
+		BS_INC_RENDER_STAT(NumRenderTargetChanges);
+	}
+
+	void NullRenderSystem::setClipPlanesImpl(const PlaneList& clipPlanes)
+	{
+		// Nothing to set, clip planes are only stored by the base class
+	}
+
+	RenderSystemCapabilities* NullRenderSystem::createRenderSystemCapabilities() const
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		RenderSystemCapabilities* rsc = bs_new<RenderSystemCapabilities>();
+
+		rsc->setDriverVersion(mDriverVersion);
+		rsc->setDeviceName("Null device");
+		rsc->setRenderSystemName(getName());
+		rsc->setVendor(GPU_UNKNOWN);
+
+		rsc->setStencilBufferBitDepth(8);
+
+		rsc->setCapability(RSC_ANISOTROPY);
+		rsc->setCapability(RSC_AUTOMIPMAP);
+		rsc->setCapability(RSC_CUBEMAPPING);
+		rsc->setCapability(RSC_TEXTURE_COMPRESSION);
+		rsc->setCapability(RSC_TEXTURE_COMPRESSION_DXT);
+		rsc->setCapability(RSC_TWO_SIDED_STENCIL);
+		rsc->setCapability(RSC_STENCIL_WRAP);
+		rsc->setCapability(RSC_HWOCCLUSION);
+		rsc->setCapability(RSC_HWOCCLUSION_ASYNCHRONOUS);
+		rsc->setCapability(RSC_SHADER_SUBROUTINE);
+		rsc->setCapability(RSC_USER_CLIP_PLANES);
+		rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+		rsc->setCapability(RSC_INFINITE_FAR_PLANE);
+		rsc->setCapability(RSC_TEXTURE_3D);
+		rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
+		rsc->setCapability(RSC_HWRENDER_TO_TEXTURE);
+		rsc->setCapability(RSC_TEXTURE_FLOAT);
+		rsc->setCapability(RSC_MRT_DIFFERENT_BIT_DEPTHS);
+		rsc->setCapability(RSC_POINT_SPRITES);
+		rsc->setCapability(RSC_POINT_EXTENDED_PARAMETERS);
+		rsc->setCapability(RSC_VERTEX_TEXTURE_FETCH);
+		rsc->setCapability(RSC_MIPMAP_LOD_BIAS);
+		rsc->setCapability(RSC_PERSTAGECONSTANT);
+
+		rsc->setMaxBoundVertexBuffers(32);
+		rsc->setNumMultiRenderTargets(8);
+		rsc->setMaxPointSize(256);
+
+		// Accept the same profiles as the DX11 render system, so its shaders can be used unchanged
+		const char* profiles[] = { "ps_4_0", "vs_4_0", "gs_4_0", "ps_4_1", "vs_4_1", "gs_4_1",
+			"ps_5_0", "vs_5_0", "gs_5_0", "cs_5_0", "hs_5_0", "ds_5_0" };
+
+		GpuProgramProfile gpuProfiles[] = { GPP_PS_4_0, GPP_VS_4_0, GPP_GS_4_0, GPP_PS_4_1, GPP_VS_4_1, GPP_GS_4_1,
+			GPP_PS_5_0, GPP_VS_5_0, GPP_GS_5_0, GPP_CS_5_0, GPP_HS_5_0, GPP_DS_5_0 };
+
+		for (UINT32 i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++)
+		{
+			rsc->addShaderProfile(profiles[i]);
+			rsc->addGpuProgramProfile(gpuProfiles[i], profiles[i]);
+		}
+
+		const UINT16 NUM_TEXTURE_UNITS = 128;
+		const UINT16 NUM_PARAM_BLOCK_BUFFERS = 14;
+
+		GpuProgramType programTypes[] = { GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM, GPT_GEOMETRY_PROGRAM,
+			GPT_HULL_PROGRAM, GPT_DOMAIN_PROGRAM, GPT_COMPUTE_PROGRAM };
+
+		UINT32 numProgramTypes = sizeof(programTypes) / sizeof(programTypes[0]);
+		for (UINT32 i = 0; i < numProgramTypes; i++)
+		{
+			rsc->setNumTextureUnits(programTypes[i], NUM_TEXTURE_UNITS);
+			rsc->setNumGpuParamBlockBuffers(programTypes[i], NUM_PARAM_BLOCK_BUFFERS);
+		}
+
+		rsc->setNumCombinedTextureUnits(NUM_TEXTURE_UNITS * numProgramTypes);
+		rsc->setNumCombinedGpuParamBlockBuffers(NUM_PARAM_BLOCK_BUFFERS * numProgramTypes);
+
+		return rsc;
+	}
+
+	VertexElementType NullRenderSystem::getColorVertexElementType() const
+	{
+		return VET_COLOR_ABGR;
+	}
+
+	void NullRenderSystem::convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest, bool forGpuProgram)
+	{
+		dest = matrix;
+
+		// Convert depth range from [-1,+1] to [0,1], same as DX11
+		dest[2][0] = (dest[2][0] + dest[3][0]) / 2;
+		dest[2][1] = (dest[2][1] + dest[3][1]) / 2;
+		dest[2][2] = (dest[2][2] + dest[3][2]) / 2;
+		dest[2][3] = (dest[2][3] + dest[3][3]) / 2;
+
+		if (!forGpuProgram)
+		{
+			// Convert right-handed to left-handed
+			dest[0][2] = -dest[0][2];
+			dest[1][2] = -dest[1][2];
+			dest[2][2] = -dest[2][2];
+			dest[3][2] = -dest[3][2];
+		}
+	}
+
+	float NullRenderSystem::getHorizontalTexelOffset()
+	{
+		return 0.0f;
+	}
+
+	float NullRenderSystem::getVerticalTexelOffset()
+	{
+		return 0.0f;
+	}
+
+	float NullRenderSystem::getMinimumDepthInputValue()
+	{
+		return 0.0f;
+	}
+
+	float NullRenderSystem::getMaximumDepthInputValue()
+	{
+		return -1.0f;
+	}
+}
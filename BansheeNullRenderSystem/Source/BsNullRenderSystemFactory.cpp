@@ -0,0 +1,15 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullRenderSystemFactory.h"
+#include "BsRenderSystem.h"
+
+namespace BansheeEngine
+{
+	void NullRenderSystemFactory::create()
+	{
+		RenderSystem::startUp<NullRenderSystem>();
+	}
+
+	NullRenderSystemFactory::InitOnStart NullRenderSystemFactory::initOnStart;
+}
@@ -0,0 +1,98 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullRenderWindow.h"
+#include "BsPixelData.h"
+#include "BsCoreThread.h"
+
+namespace BansheeEngine
+{
+	NullRenderWindow::NullRenderWindow(const RENDER_WINDOW_DESC& desc)
+		:RenderWindow(desc)
+	{ }
+
+	NullRenderWindow::~NullRenderWindow()
+	{ }
+
+	void NullRenderWindow::initialize_internal()
+	{
+		mName = mDesc.title;
+		mIsFullScreen = mDesc.fullscreen;
+		mWidth = mDesc.videoMode.getWidth();
+		mHeight = mDesc.videoMode.getHeight();
+		mLeft = std::max(0, mDesc.left);
+		mTop = std::max(0, mDesc.top);
+		mColorDepth = 32;
+		mHidden = mDesc.hidden;
+		mVSync = mDesc.vsync;
+		mMultisampleCount = mDesc.multisampleCount;
+		mMultisampleHint = mDesc.multisampleHint;
+		mHwGamma = mDesc.gamma;
+		mActive = true;
+
+		RenderWindow::initialize_internal();
+	}
+
+	void NullRenderWindow::move(INT32 left, INT32 top)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (!mIsFullScreen)
+		{
+			mLeft = left;
+			mTop = top;
+
+			_windowMovedOrResized();
+		}
+	}
+
+	void NullRenderWindow::resize(UINT32 width, UINT32 height)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (!mIsFullScreen)
+		{
+			mWidth = width;
+			mHeight = height;
+
+			_windowMovedOrResized();
+		}
+	}
+
+	void NullRenderWindow::setHidden(bool hidden)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mHidden = hidden;
+	}
+
+	void NullRenderWindow::copyToMemory(PixelData &dst, FrameBuffer buffer)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		// Nothing is ever rendered, so the contents are always cleared
+		memset(dst.getData(), 0, dst.getConsecutiveSize());
+	}
+
+	Vector2I NullRenderWindow::screenToWindowPos(const Vector2I& screenPos) const
+	{
+		return Vector2I(screenPos.x - mLeft, screenPos.y - mTop);
+	}
+
+	Vector2I NullRenderWindow::windowToScreenPos(const Vector2I& windowPos) const
+	{
+		return Vector2I(windowPos.x + mLeft, windowPos.y + mTop);
+	}
+
+	void NullRenderWindow::getCustomAttribute(const String& name, void* pData) const
+	{
+		if(name == "WINDOW")
+		{
+			void** window = (void**)pData;
+			*window = nullptr;
+			return;
+		}
+
+		RenderWindow::getCustomAttribute(name, pData);
+	}
+}
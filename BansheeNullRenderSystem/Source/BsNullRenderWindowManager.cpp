@@ -0,0 +1,14 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullRenderWindowManager.h"
+#include "BsNullRenderWindow.h"
+
+namespace BansheeEngine
+{
+	RenderWindowPtr NullRenderWindowManager::createImpl(RENDER_WINDOW_DESC& desc, RenderWindowPtr parentWindow)
+	{
+		NullRenderWindow* renderWindow = new (bs_alloc<NullRenderWindow, PoolAlloc>()) NullRenderWindow(desc);
+		return bs_core_ptr<NullRenderWindow, PoolAlloc>(renderWindow);
+	}
+}
@@ -0,0 +1,144 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullTexture.h"
+#include "BsPixelUtil.h"
+#include "BsException.h"
+#include "BsRenderStats.h"
+#include "BsCoreThread.h"
+
+namespace BansheeEngine
+{
+	NullTexture::NullTexture()
+		: Texture()
+	{ }
+
+	NullTexture::~NullTexture()
+	{ }
+
+	void NullTexture::initialize_internal()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (getTextureType() == TEX_TYPE_3D && getNumFaces() > 1)
+			BS_EXCEPT(RenderingAPIException, "3D textures cannot have multiple faces.");
+
+		UINT32 numFaces = getNumFaces();
+		UINT32 numMips = getNumMipmaps() + 1;
+
+		mSurfaces.resize(numFaces * numMips);
+		for (UINT32 face = 0; face < numFaces; face++)
+		{
+			for (UINT32 mip = 0; mip < numMips; mip++)
+			{
+				PixelData surface = getSurface(mip, face);
+				UINT32 size = surface.getConsecutiveSize();
+
+				UINT8* data = (UINT8*)bs_alloc(size);
+				memset(data, 0, size);
+
+				mSurfaces[face * numMips + mip] = data;
+			}
+		}
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Texture);
+		Texture::initialize_internal();
+	}
+
+	void NullTexture::destroy_internal()
+	{
+		for (auto& surface : mSurfaces)
+			bs_free(surface);
+
+		mSurfaces.clear();
+
+		clearBufferViews();
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Texture);
+		Texture::destroy_internal();
+	}
+
+	PixelData NullTexture::getSurface(UINT32 mipLevel, UINT32 face) const
+	{
+		UINT32 mipWidth = std::max(1U, mWidth >> mipLevel);
+		UINT32 mipHeight = std::max(1U, mHeight >> mipLevel);
+		UINT32 mipDepth = std::max(1U, mDepth >> mipLevel);
+
+		PixelData surface(mipWidth, mipHeight, mipDepth, mFormat);
+
+		UINT32 surfaceIdx = face * (getNumMipmaps() + 1) + mipLevel;
+		if (surfaceIdx < (UINT32)mSurfaces.size())
+			surface.setExternalBuffer(mSurfaces[surfaceIdx]);
+
+		return surface;
+	}
+
+	PixelData NullTexture::lockImpl(GpuLockOptions options, UINT32 mipLevel, UINT32 face)
+	{
+#if BS_PROFILING_ENABLED
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+		}
+
+		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+		}
+#endif
+
+		if (mipLevel > getNumMipmaps() || face >= getNumFaces())
+			BS_EXCEPT(InvalidParametersException, "Invalid mip level or face index.");
+
+		return getSurface(mipLevel, face);
+	}
+
+	void NullTexture::unlockImpl()
+	{ }
+
+	void NullTexture::copyImpl(TexturePtr& target)
+	{
+		NullTexture* other = static_cast<NullTexture*>(target.get());
+
+		if (other->mSurfaces.size() != mSurfaces.size())
+			BS_EXCEPT(InvalidParametersException, "Source and destination textures must have the same layout.");
+
+		UINT32 numFaces = getNumFaces();
+		UINT32 numMips = getNumMipmaps() + 1;
+
+		for (UINT32 face = 0; face < numFaces; face++)
+		{
+			for (UINT32 mip = 0; mip < numMips; mip++)
+			{
+				PixelData src = getSurface(mip, face);
+				PixelData dst = other->getSurface(mip, face);
+
+				PixelUtil::bulkPixelConversion(src, dst);
+			}
+		}
+	}
+
+	void NullTexture::readData(PixelData& dest, UINT32 mipLevel, UINT32 face)
+	{
+		PixelData myData = lock(GBL_READ_ONLY, mipLevel, face);
+
+#if BS_DEBUG_MODE
+		if(dest.getConsecutiveSize() != myData.getConsecutiveSize())
+		{
+			unlock();
+			BS_EXCEPT(InternalErrorException, "Buffer sizes don't match");
+		}
+#endif
+
+		PixelUtil::bulkPixelConversion(myData, dest);
+
+		unlock();
+	}
+
+	void NullTexture::writeData(const PixelData& src, UINT32 mipLevel, UINT32 face, bool discardWholeBuffer)
+	{
+		PixelData myData = lock(discardWholeBuffer ? GBL_WRITE_ONLY_DISCARD : GBL_WRITE_ONLY, mipLevel, face);
+		PixelUtil::bulkPixelConversion(src, myData);
+		unlock();
+	}
+}
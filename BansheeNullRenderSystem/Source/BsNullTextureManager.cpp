@@ -0,0 +1,44 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullTextureManager.h"
+#include "BsNullTexture.h"
+#include "BsNullRenderTexture.h"
+#include "BsNullMultiRenderTexture.h"
+
+namespace BansheeEngine
+{
+	NullTextureManager::NullTextureManager() 
+		:TextureManager()
+	{ }
+
+	NullTextureManager::~NullTextureManager()
+	{ }
+
+	TexturePtr NullTextureManager::createTextureImpl()
+	{
+		NullTexture* tex = new (bs_alloc<NullTexture, PoolAlloc>()) NullTexture(); 
+
+		return bs_core_ptr<NullTexture, PoolAlloc>(tex);
+	}
+
+	RenderTexturePtr NullTextureManager::createRenderTextureImpl()
+	{
+		NullRenderTexture* tex = new (bs_alloc<NullRenderTexture, PoolAlloc>()) NullRenderTexture();
+
+		return bs_core_ptr<NullRenderTexture, PoolAlloc>(tex);
+	}
+
+	MultiRenderTexturePtr NullTextureManager::createMultiRenderTextureImpl()
+	{
+		NullMultiRenderTexture* tex = new (bs_alloc<NullMultiRenderTexture, PoolAlloc>()) NullMultiRenderTexture();
+
+		return bs_core_ptr<NullMultiRenderTexture, PoolAlloc>(tex);
+	}
+
+	PixelFormat NullTextureManager::getNativeFormat(TextureType ttype, PixelFormat format, int usage, bool hwGamma)
+	{
+		// System memory can hold any format
+		return format;
+	}
+}
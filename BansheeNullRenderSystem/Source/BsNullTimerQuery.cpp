@@ -0,0 +1,44 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullTimerQuery.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	NullTimerQuery::NullTimerQuery()
+		:mQueryEndCalled(false), mTimeDelta(0.0f)
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullTimerQuery::~NullTimerQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullTimerQuery::begin()
+	{
+		mQueryEndCalled = false;
+		mTimeDelta = 0.0f;
+		mTimer.reset();
+
+		setActive(true);
+	}
+
+	void NullTimerQuery::end()
+	{
+		mTimeDelta = mTimer.getMicroseconds() / 1000.0f;
+		mQueryEndCalled = true;
+	}
+
+	bool NullTimerQuery::isReady() const
+	{
+		return mQueryEndCalled;
+	}
+
+	float NullTimerQuery::getTimeMs()
+	{
+		return mTimeDelta;
+	}
+}
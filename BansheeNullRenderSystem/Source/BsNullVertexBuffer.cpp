@@ -0,0 +1,68 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullVertexBuffer.h"
+#include "BsRenderStats.h"
+
+namespace BansheeEngine
+{
+	NullVertexBuffer::NullVertexBuffer(UINT32 vertexSize, UINT32 numVertices, GpuBufferUsage usage)
+		:VertexBuffer(vertexSize, numVertices, usage, true), mData(nullptr)
+	{ }
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{ }
+
+	void* NullVertexBuffer::lockImpl(UINT32 offset, UINT32 length, GpuLockOptions options)
+	{
+#if BS_PROFILING_ENABLED
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_VertexBuffer);
+		}
+
+		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_VertexBuffer);
+		}
+#endif
+
+		return mData + offset;
+	}
+
+	void NullVertexBuffer::unlockImpl()
+	{ }
+
+	void NullVertexBuffer::readData(UINT32 offset, UINT32 length, void* dest)
+	{
+		memcpy(dest, mData + offset, length);
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_VertexBuffer);
+	}
+
+	void NullVertexBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags)
+	{
+		memcpy(mData + offset, source, length);
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_VertexBuffer);
+	}
+
+	void NullVertexBuffer::initialize_internal()
+	{
+		mData = (UINT8*)bs_alloc(mSizeInBytes);
+		memset(mData, 0, mSizeInBytes);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_VertexBuffer);
+		VertexBuffer::initialize_internal();
+	}
+
+	void NullVertexBuffer::destroy_internal()
+	{
+		if(mData != nullptr)
+		{
+			bs_free(mData);
+			mData = nullptr;
+		}
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_VertexBuffer);
+		VertexBuffer::destroy_internal();
+	}
+}
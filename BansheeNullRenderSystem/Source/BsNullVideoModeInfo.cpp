@@ -0,0 +1,27 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsNullVideoModeInfo.h"
+
+namespace BansheeEngine
+{
+	NullVideoModeInfo::NullVideoModeInfo()
+	{
+		mOutputs.push_back(bs_new<NullVideoOutputInfo>());
+	}
+
+	NullVideoOutputInfo::NullVideoOutputInfo()
+	{
+		mName = "Null output";
+
+		NullVideoMode* videoMode = bs_new<NullVideoMode>(1920, 1080, 60.0f, 0);
+		mVideoModes.push_back(videoMode);
+		mDesktopVideoMode = bs_new<NullVideoMode>(1920, 1080, 60.0f, 0);
+	}
+
+	NullVideoMode::NullVideoMode(UINT32 width, UINT32 height, float refreshRate, UINT32 outputIdx)
+		:VideoMode(width, height, refreshRate, outputIdx)
+	{
+		mIsCustom = false;
+	}
+}
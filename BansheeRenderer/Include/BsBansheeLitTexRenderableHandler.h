@@ -31,6 +31,9 @@ namespace BansheeEngine
 			bool hasWVPParam = false;
 			GpuParamMat4 wvpParam;
 
+			bool hasLastWVP = false;
+			Matrix4 lastWVP; /**< World-view-projection matrix last written to the per-object buffer. */
+
 			Vector<MaterialProxy::BufferBindInfo> perObjectBuffers;
 		};
 
@@ -54,9 +57,12 @@ namespace BansheeEngine
 
 		/**
 		 * @brief	Updates object specific parameter buffers with new values.
-		 *			To be called whenever object specific values change.
+		 *			To be called whenever object specific values change. Buffers are
+		 *			only written to if the values differ from the ones last written.
+		 *
+		 * @return	True if the per-object buffer was written to.
 		 */
-		void updatePerObjectBuffers(RenderableElement* element, const Matrix4& wvpMatrix);
+		bool updatePerObjectBuffers(RenderableElement* element, const Matrix4& wvpMatrix);
 
 	protected:
 		/**
@@ -6,7 +6,8 @@
 #include "BsBansheeRendererPrerequisites.h"
 #include "BsRenderer.h"
 #include "BsMaterialProxy.h"
-#include "BsBounds.h"
+#include "BsBoundsArray.h"
+#include "BsRenderStateTracker.h"
 
 namespace BansheeEngine
 {
@@ -153,7 +154,7 @@ namespace BansheeEngine
 		 *
 		 * @note	Core thread only.
 		 */
-		virtual void render(const CameraProxy& cameraProxy, const RenderQueuePtr& renderQueue);
+		virtual void render(CameraProxy& cameraProxy, const RenderQueuePtr& renderQueue);
 
 		/**
 		 * @brief	Activates the specified pass on the pipeline.
@@ -163,7 +164,7 @@ namespace BansheeEngine
 		 *
 		 * @note	Core thread only.
 		 */
-		void setPass(const MaterialProxyPtr& material, UINT32 passIdx);
+		void setPass(const MaterialProxy& material, UINT32 passIdx);
 
 		/**
 		 * @brief	Draws the specified mesh proxy with last set pass.
@@ -184,17 +185,30 @@ namespace BansheeEngine
 		 */
 		void cameraRemoved(const HCamera& camera);
 
+		/**
+		 * @brief	Maximum number of renderable transform updates recorded by a single slice of the
+		 *			transform update accessor group.
+		 */
+		static const UINT32 TRANSFORM_UPDATES_PER_SLICE;
+
 		Vector<RenderableProxyPtr> mDeletedRenderableProxies;
 		Vector<CameraProxyPtr> mDeletedCameraProxies;
 
+		Vector<HRenderable> mMovedRenderables; /**< Renderables whose only change this frame is their transform. */
+		DeferredAccessorGroup* mTransformUpdateGroup;
+
 		UnorderedMap<UINT64, CameraProxyPtr> mCameraProxies;
 		Vector<RenderTargetData> mRenderTargets;
 
 		Vector<RenderableElement*> mRenderableElements;
 		Vector<Matrix4> mWorldTransforms;
-		Vector<Bounds> mWorldBounds;
+		BoundsArray mWorldBounds;
+		Vector<UINT32> mVisibility; /**< Bitmask with a bit per renderable element, set if visible by the camera being rendered. */
+		Vector<UINT32> mVisibleElements; /**< Indices of elements visible by the camera being rendered. */
+		Vector<Matrix4> mVisibleWVPTransforms; /**< World-view-projection matrices of visible elements, in the same order as mVisibleElements. */
 
 		LitTexRenderableHandler* mLitTexHandler;
+		RenderStateTracker mStateTracker;
 
 		HEvent mRenderableRemovedConn;
 		HEvent mCameraRemovedConn;
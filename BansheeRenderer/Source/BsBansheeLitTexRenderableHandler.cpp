@@ -255,19 +255,32 @@ namespace BansheeEngine
 		perFrameParams->updateHardwareBuffers();
 	}
 
-	void LitTexRenderableHandler::updatePerObjectBuffers(RenderableElement* element, const Matrix4& wvpMatrix)
+	bool LitTexRenderableHandler::updatePerObjectBuffers(RenderableElement* element, const Matrix4& wvpMatrix)
 	{
 		PerObjectData* rendererData = any_cast_unsafe<PerObjectData>(&element->rendererData);
 
+		// Buffer still holds the same matrix (e.g. static object seen by a single static camera), no need to touch it
 		if (rendererData->hasWVPParam)
-			rendererData->wvpParam.set(wvpMatrix);
+		{
+			if (!rendererData->hasLastWVP || rendererData->lastWVP != wvpMatrix)
+			{
+				rendererData->wvpParam.set(wvpMatrix);
+				rendererData->lastWVP = wvpMatrix;
+				rendererData->hasLastWVP = true;
+			}
+		}
 
 		if (rendererData->perObjectParamBuffer != nullptr)
 		{
 			GpuParamBlockPtr paramBlock = rendererData->perObjectParamBuffer->getParamBlock();
 			if (paramBlock->isDirty())
+			{
 				paramBlock->uploadToBuffer(rendererData->perObjectParamBuffer);
+				return true;
+			}
 		}
+
+		return false;
 	}
 
 	ShaderPtr LitTexRenderableHandler::createDefaultShader()
@@ -277,7 +290,7 @@ namespace BansheeEngine
 		HGpuProgram vsProgram;
 		HGpuProgram psProgram;
 
-		if (rsName == RenderSystemDX11)
+		if (rsName == RenderSystemDX11 || rsName == RenderSystemNull)
 		{
 			String vsCode = R"(
 			cbuffer PerFrame
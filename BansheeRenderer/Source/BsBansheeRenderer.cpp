@@ -32,12 +32,18 @@
 #include "BsShaderProxy.h"
 #include "BsBansheeLitTexRenderableHandler.h"
 #include "BsTime.h"
+#include "BsRenderStats.h"
+#include "BsDeferredAccessorGroup.h"
+#include "BsTaskGroup.h"
 
 using namespace std::placeholders;
 
 namespace BansheeEngine
 {
+	const UINT32 BansheeRenderer::TRANSFORM_UPDATES_PER_SLICE = 256;
+
 	BansheeRenderer::BansheeRenderer()
+		:mTransformUpdateGroup(nullptr)
 	{
 		mRenderableRemovedConn = gBsSceneManager().onRenderableRemoved.connect(std::bind(&BansheeRenderer::renderableRemoved, this, _1));
 		mCameraRemovedConn = gBsSceneManager().onCameraRemoved.connect(std::bind(&BansheeRenderer::cameraRemoved, this, _1));
@@ -47,6 +53,9 @@ namespace BansheeEngine
 	{
 		mRenderableRemovedConn.disconnect();
 		mCameraRemovedConn.disconnect();
+
+		if (mTransformUpdateGroup != nullptr)
+			bs_delete(mTransformUpdateGroup);
 	}
 
 	const String& BansheeRenderer::getName() const
@@ -76,7 +85,7 @@ namespace BansheeEngine
 		{
 			mRenderableElements.push_back(element);
 			mWorldTransforms.push_back(element->worldTransform);
-			mWorldBounds.push_back(element->calculateWorldBounds());
+			mWorldBounds.add(element->calculateWorldBounds());
 
 			element->renderableType = proxy->renderableType;
 			if (proxy->renderableType == RenType_LitTextured)
@@ -97,15 +106,19 @@ namespace BansheeEngine
 		{
 			assert(mRenderableElements.size() > element->id && element->id >= 0);
 
-			if (mRenderableElements.size() == 0)
-				mRenderableElements.erase(mRenderableElements.begin());
-			else
+			// Move the last element in place of the removed one, along with its transform and bounds
+			UINT32 lastIdx = (UINT32)mRenderableElements.size() - 1;
+			if (element->id != lastIdx)
 			{
-				std::swap(mRenderableElements[element->id], mRenderableElements.back());
-				mRenderableElements.erase(mRenderableElements.end() - 1);
+				mRenderableElements[element->id] = mRenderableElements[lastIdx];
+				mWorldTransforms[element->id] = mWorldTransforms[lastIdx];
 
 				mRenderableElements[element->id]->id = element->id;
 			}
+
+			mRenderableElements.erase(mRenderableElements.end() - 1);
+			mWorldTransforms.erase(mWorldTransforms.end() - 1);
+			mWorldBounds.remove(element->id);
 		}
 	}
 
@@ -116,7 +129,7 @@ namespace BansheeEngine
 			element->worldTransform = localToWorld;
 
 			mWorldTransforms[element->id] = localToWorld;
-			mWorldBounds[element->id] = element->calculateWorldBounds();
+			mWorldBounds.set(element->id, element->calculateWorldBounds());
 		}
 	}
 
@@ -238,8 +251,7 @@ namespace BansheeEngine
 			{
 				assert(proxy != nullptr);
 
-				gCoreAccessor().queueCommand(std::bind(&BansheeRenderer::updateRenderableProxy, this, proxy, renderable->SO()->getWorldTfrm()));
-
+				mMovedRenderables.push_back(renderable);
 				dirtySceneObjects.push_back(renderable->SO());
 			}
 
@@ -257,6 +269,37 @@ namespace BansheeEngine
 			}
 		}
 
+		// Record transform updates in parallel, one accessor slice per range of renderables. World transforms
+		// were all updated at the start of the frame, so reading them doesn't modify any shared state.
+		if (!mMovedRenderables.empty())
+		{
+			// Slices are submitted as a separate batch, so anything recorded before them must be submitted first
+			gCoreAccessor().submitToCoreThread();
+
+			if (mTransformUpdateGroup == nullptr)
+				mTransformUpdateGroup = bs_new<DeferredAccessorGroup>(0);
+
+			UINT32 numMoved = (UINT32)mMovedRenderables.size();
+			UINT32 numSlices = (numMoved + TRANSFORM_UPDATES_PER_SLICE - 1) / TRANSFORM_UPDATES_PER_SLICE;
+			mTransformUpdateGroup->setNumSlices(numSlices);
+
+			parallelFor(0, numSlices, 1, [&](UINT32 sliceIdx)
+			{
+				DeferredCoreAccessor& accessor = mTransformUpdateGroup->getAccessor(sliceIdx);
+
+				UINT32 end = std::min((sliceIdx + 1) * TRANSFORM_UPDATES_PER_SLICE, numMoved);
+				for (UINT32 i = sliceIdx * TRANSFORM_UPDATES_PER_SLICE; i < end; i++)
+				{
+					const HRenderable& renderable = mMovedRenderables[i];
+					accessor.queueCommand(std::bind(&BansheeRenderer::updateRenderableProxy, this, 
+						renderable->_getActiveProxy(), renderable->SO()->getWorldTfrm()));
+				}
+			});
+
+			mTransformUpdateGroup->submitToCoreThread();
+			mMovedRenderables.clear();
+		}
+
 		// Mark all renderables as clean (needs to be done after all proxies are updated as
 		// this will also clean materials & meshes which may be shared, so we don't want to clean them
 		// too early.
@@ -416,7 +459,7 @@ namespace BansheeEngine
 		}
 	}
 
-	void BansheeRenderer::render(const CameraProxy& cameraProxy, const RenderQueuePtr& renderQueue) 
+	void BansheeRenderer::render(CameraProxy& cameraProxy, const RenderQueuePtr& renderQueue) 
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
@@ -427,18 +470,51 @@ namespace BansheeEngine
 
 		Matrix4 viewProjMatrix = projMatrixCstm * viewMatrixCstm;
 
+		cameraProxy.renderStats = CameraRenderStats();
 		if (!cameraProxy.ignoreSceneRenderables)
 		{
-			// Update per-object param buffers and queue render elements
-			for (auto& renderElem : mRenderableElements)
+			// Cull: find visible elements
+			UINT32 numElements = (UINT32)mRenderableElements.size();
+
+			mVisibility.resize((mWorldBounds.size() + 31) / 32);
+			cameraProxy.cullPlaneCache.resize(mWorldBounds.getNumGroups(), 0);
+			cameraProxy.worldFrustum.intersects(mWorldBounds, mVisibility.data(), cameraProxy.cullPlaneCache.data());
+
+			// Gather: collect visible elements and calculate their per-object data
+			mVisibleElements.clear();
+			for (UINT32 i = 0; i < (UINT32)mVisibility.size(); i++)
 			{
+				UINT32 mask = mVisibility[i];
+				if (mask == 0)
+					continue;
+
+				UINT32 end = std::min(i * 32 + 32, numElements);
+				for (UINT32 id = i * 32; id < end; id++)
+				{
+					if ((mask & (1 << (id % 32))) != 0)
+						mVisibleElements.push_back(id);
+				}
+			}
+
+			UINT32 numVisible = (UINT32)mVisibleElements.size();
+			mVisibleWVPTransforms.resize(numVisible);
+			for (UINT32 i = 0; i < numVisible; i++)
+				mVisibleWVPTransforms[i] = viewProjMatrix * mWorldTransforms[mVisibleElements[i]];
+
+			// Upload: update per-object param buffers of visible elements and queue them for rendering
+			UINT32 numUploaded = 0;
+			for (UINT32 i = 0; i < numVisible; i++)
+			{
+				UINT32 id = mVisibleElements[i];
+				RenderableElement* renderElem = mRenderableElements[id];
+
 				if (renderElem->handler != nullptr)
 					renderElem->handler->bindPerObjectBuffers(renderElem);
 
 				if (renderElem->renderableType == RenType_LitTextured)
 				{
-					Matrix4 worldViewProjMatrix = viewProjMatrix * mWorldTransforms[renderElem->id];;
-					mLitTexHandler->updatePerObjectBuffers(renderElem, worldViewProjMatrix);
+					if (mLitTexHandler->updatePerObjectBuffers(renderElem, mVisibleWVPTransforms[i]))
+						numUploaded++;
 				}
 
 				for (auto& param : renderElem->material->params)
@@ -446,111 +522,81 @@ namespace BansheeEngine
 					param->updateHardwareBuffers();
 				}
 
-				// Do frustum culling
-				// TODO - This is bound to be a bottleneck at some point. When it is ensure that intersect
-				// methods use vector operations, as it is trivial to update them.
-				const Sphere& boundingSphere = mWorldBounds[renderElem->id].getSphere();
-				if (cameraProxy.worldFrustum.intersects(boundingSphere))
-				{
-					// More precise with the box
-					const AABox& boundingBox = mWorldBounds[renderElem->id].getBox();
+				float distanceToCamera = (cameraProxy.worldPosition - mWorldBounds.getBoxCenter(id)).length();
+				renderQueue->add(renderElem, distanceToCamera);
+			}
 
-					if (cameraProxy.worldFrustum.intersects(boundingBox))
-					{
-						float distanceToCamera = (cameraProxy.worldPosition - boundingBox.getCenter()).length();
+			cameraProxy.renderStats.numRenderablesCulled = numElements - numVisible;
+			cameraProxy.renderStats.numRenderablesUploaded = numUploaded;
 
-						renderQueue->add(renderElem, distanceToCamera);
-					}
-				}
-			}
+			BS_ADD_RENDER_STAT(NumRenderablesCulled, numElements - numVisible);
+			BS_ADD_RENDER_STAT(NumRenderablesUploaded, numUploaded);
 		}
 
 		renderQueue->sort();
 		const Vector<RenderQueueElement>& sortedRenderElements = renderQueue->getSortedElements();
 
-		for(auto iter = sortedRenderElements.begin(); iter != sortedRenderElements.end(); ++iter)
+		// Render system may have been used by others since the last camera was rendered
+		mStateTracker.reset();
+
+		UINT32 numSortedElements = (UINT32)sortedRenderElements.size();
+		for (UINT32 i = 0; i < numSortedElements; i++)
 		{
-			MaterialProxyPtr materialProxy = iter->material;
+			const RenderQueueElement& renderElem = sortedRenderElements[i];
 
-			setPass(materialProxy, iter->passIdx);
-			draw(*iter->mesh);
+			setPass(*renderElem.material, renderElem.passIdx);
+			draw(*renderElem.mesh);
 		}
 
 		renderQueue->clear();
 	}
 
-	void BansheeRenderer::setPass(const MaterialProxyPtr& material, UINT32 passIdx)
+	void BansheeRenderer::setPass(const MaterialProxy& material, UINT32 passIdx)
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
-		RenderSystem& rs = RenderSystem::instance();
+		// State tracker skips any bindings that are the same as the ones made by the previous pass
+		const MaterialProxyPass& pass = material.passes[passIdx];
 
-		const MaterialProxyPass& pass = material->passes[passIdx];
+		mStateTracker.bindGpuProgram(GPT_VERTEX_PROGRAM, pass.vertexProg);
 		if (pass.vertexProg)
-		{
-			rs.bindGpuProgram(pass.vertexProg);
-			rs.bindGpuParams(GPT_VERTEX_PROGRAM, material->params[pass.vertexProgParamsIdx]);
-		}
-		else
-			rs.unbindGpuProgram(GPT_VERTEX_PROGRAM);
+			mStateTracker.bindGpuParams(GPT_VERTEX_PROGRAM, material.params[pass.vertexProgParamsIdx]);
 
+		mStateTracker.bindGpuProgram(GPT_FRAGMENT_PROGRAM, pass.fragmentProg);
 		if (pass.fragmentProg)
-		{
-			rs.bindGpuProgram(pass.fragmentProg);
-			rs.bindGpuParams(GPT_FRAGMENT_PROGRAM, material->params[pass.fragmentProgParamsIdx]);
-		}
-		else
-			rs.unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
+			mStateTracker.bindGpuParams(GPT_FRAGMENT_PROGRAM, material.params[pass.fragmentProgParamsIdx]);
 
+		mStateTracker.bindGpuProgram(GPT_GEOMETRY_PROGRAM, pass.geometryProg);
 		if (pass.geometryProg)
-		{
-			rs.bindGpuProgram(pass.geometryProg);
-			rs.bindGpuParams(GPT_GEOMETRY_PROGRAM, material->params[pass.geometryProgParamsIdx]);
-		}
-		else
-			rs.unbindGpuProgram(GPT_GEOMETRY_PROGRAM);
+			mStateTracker.bindGpuParams(GPT_GEOMETRY_PROGRAM, material.params[pass.geometryProgParamsIdx]);
 
+		mStateTracker.bindGpuProgram(GPT_HULL_PROGRAM, pass.hullProg);
 		if (pass.hullProg)
-		{
-			rs.bindGpuProgram(pass.hullProg);
-			rs.bindGpuParams(GPT_HULL_PROGRAM, material->params[pass.hullProgParamsIdx]);
-		}
-		else
-			rs.unbindGpuProgram(GPT_HULL_PROGRAM);
+			mStateTracker.bindGpuParams(GPT_HULL_PROGRAM, material.params[pass.hullProgParamsIdx]);
 
+		mStateTracker.bindGpuProgram(GPT_DOMAIN_PROGRAM, pass.domainProg);
 		if (pass.domainProg)
-		{
-			rs.bindGpuProgram(pass.domainProg);
-			rs.bindGpuParams(GPT_DOMAIN_PROGRAM, material->params[pass.domainProgParamsIdx]);
-		}
-		else
-			rs.unbindGpuProgram(GPT_DOMAIN_PROGRAM);
+			mStateTracker.bindGpuParams(GPT_DOMAIN_PROGRAM, material.params[pass.domainProgParamsIdx]);
 
+		mStateTracker.bindGpuProgram(GPT_COMPUTE_PROGRAM, pass.computeProg);
 		if (pass.computeProg)
-		{
-			rs.bindGpuProgram(pass.computeProg);
-			rs.bindGpuParams(GPT_COMPUTE_PROGRAM, material->params[pass.computeProgParamsIdx]);
-		}
-		else
-			rs.unbindGpuProgram(GPT_COMPUTE_PROGRAM);
-
-		// TODO - Try to limit amount of state changes, if previous state is already the same
+			mStateTracker.bindGpuParams(GPT_COMPUTE_PROGRAM, material.params[pass.computeProgParamsIdx]);
 
 		// Set up non-texture related pass settings
 		if (pass.blendState != nullptr)
-			rs.setBlendState(pass.blendState.getInternalPtr());
+			mStateTracker.setBlendState(pass.blendState.getInternalPtr());
 		else
-			rs.setBlendState(BlendState::getDefault());
+			mStateTracker.setBlendState(BlendState::getDefault());
 
 		if (pass.depthStencilState != nullptr)
-			rs.setDepthStencilState(pass.depthStencilState.getInternalPtr(), pass.stencilRefValue);
+			mStateTracker.setDepthStencilState(pass.depthStencilState.getInternalPtr(), pass.stencilRefValue);
 		else
-			rs.setDepthStencilState(DepthStencilState::getDefault(), pass.stencilRefValue);
+			mStateTracker.setDepthStencilState(DepthStencilState::getDefault(), pass.stencilRefValue);
 
 		if (pass.rasterizerState != nullptr)
-			rs.setRasterizerState(pass.rasterizerState.getInternalPtr());
+			mStateTracker.setRasterizerState(pass.rasterizerState.getInternalPtr());
 		else
-			rs.setRasterizerState(RasterizerState::getDefault());
+			mStateTracker.setRasterizerState(RasterizerState::getDefault());
 	}
 
 	void BansheeRenderer::draw(const MeshProxy& meshProxy)
@@ -567,8 +613,8 @@ namespace BansheeEngine
 
 		std::shared_ptr<VertexData> vertexData = mesh->_getVertexData();
 
-		rs.setVertexDeclaration(vertexData->vertexDeclaration);
-		auto vertexBuffers = vertexData->getBuffers();
+		mStateTracker.setVertexDeclaration(vertexData->vertexDeclaration);
+		const auto& vertexBuffers = vertexData->getBuffers();
 
 		if (vertexBuffers.size() > 0)
 		{
@@ -590,11 +636,11 @@ namespace BansheeEngine
 				buffers[iter->first - startSlot] = iter->second;
 			}
 
-			rs.setVertexBuffers(startSlot, buffers, endSlot - startSlot + 1);
+			mStateTracker.setVertexBuffers(startSlot, buffers, endSlot - startSlot + 1);
 		}
 
 		SubMesh subMesh = meshProxy.subMesh;
-		rs.setDrawOperation(subMesh.drawOp);
+		mStateTracker.setDrawOperation(subMesh.drawOp);
 
 		IndexBufferPtr indexBuffer = mesh->_getIndexBuffer();
 
@@ -602,7 +648,7 @@ namespace BansheeEngine
 		if (indexCount == 0)
 			indexCount = indexBuffer->getNumIndices();
 
-		rs.setIndexBuffer(indexBuffer);
+		mStateTracker.setIndexBuffer(indexBuffer);
 		rs.drawIndexed(subMesh.indexOffset + mesh->_getIndexOffset(), indexCount, mesh->_getVertexOffset(), vertexData->vertexCount);
 
 		mesh->_notifyUsedOnGPU();
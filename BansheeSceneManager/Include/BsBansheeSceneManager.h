@@ -5,6 +5,7 @@
 
 #include "BsBansheeSMPrerequisites.h"
 #include "BsSceneManager.h"
+#include "BsAABBTree.h"
 
 namespace BansheeEngine
 {
@@ -12,12 +13,21 @@ namespace BansheeEngine
 	 * @brief	Default scene manager implementation. Allows you to query
 	 *			the scene graph for various uses.
 	 *
-	 * TODO - Update doc when I implement this properly
+	 *			World bounds of all renderables are kept in a dynamic AABB tree. Spatial queries use the
+	 *			tree so they only need to test renderables near the query volume. Changes to renderables
+	 *			and their transforms are only recorded every frame, and the tree is refit when a query
+	 *			is made, so it costs nothing if no spatial queries are used.
+	 *
+	 * @note	The tree is not used for rendering yet. Nothing in the engine calls ::findRenderables at the moment,
+	 *			and the renderer culls on the core thread against its own bounds arrays, since the tree is sim
+	 *			thread only. The queries are meant for gameplay and editor code (e.g. picking or trigger volumes).
 	 */
 	class BS_SM_EXPORT BansheeSceneManager : public SceneManager
 	{
 	public:
-		BansheeSceneManager() {}
+		BansheeSceneManager()
+			:mNumDirtyBounds(0)
+		{ }
 		~BansheeSceneManager() {}
 
 		/**
@@ -31,10 +41,32 @@ namespace BansheeEngine
 		const Vector<HRenderable>& getAllRenderables() const { return mRenderables; }
 
 		/**
-		 * @copydoc	SceneManager
+		 * @copydoc	SceneManager::updateRenderableTransforms
+		 *
+		 * @note	Also marks world bounds of any renderables that changed as dirty.
 		 */
 		void updateRenderableTransforms();
 
+		/**
+		 * @copydoc	SceneManager::findRenderables(const ConvexVolume&, Vector<HRenderable>&) const
+		 */
+		void findRenderables(const ConvexVolume& volume, Vector<HRenderable>& output) const;
+
+		/**
+		 * @copydoc	SceneManager::findRenderables(const AABox&, Vector<HRenderable>&) const
+		 */
+		void findRenderables(const AABox& box, Vector<HRenderable>& output) const;
+
+		/**
+		 * @copydoc	SceneManager::findRenderables(const Sphere&, Vector<HRenderable>&) const
+		 */
+		void findRenderables(const Sphere& sphere, Vector<HRenderable>& output) const;
+
+		/**
+		 * @copydoc	SceneManager::findRenderables(const Ray&, float, Vector<HRenderable>&) const
+		 */
+		void findRenderables(const Ray& ray, float maxDistance, Vector<HRenderable>& output) const;
+
 	private:
 		/**
 		 * @brief	Called by scene objects whenever a new component is added to the scene.
@@ -46,7 +78,30 @@ namespace BansheeEngine
 		 */
 		void notifyComponentRemoved(const HComponent& component);
 
+		/**
+		 * @brief	Marks the bounds of the renderable at the specified index as needing an update
+		 *			before the next spatial query.
+		 */
+		void markBoundsDirty(UINT32 idx);
+
+		/**
+		 * @brief	Updates the bounds tree entries of all renderables marked as dirty.
+		 */
+		void updateDirtyBounds() const;
+
+		/**
+		 * @brief	Inserts, refits or removes the renderable at the specified index in the bounds tree,
+		 *			depending on whether it currently has a mesh.
+		 */
+		void updateRenderableBounds(UINT32 idx) const;
+
 		Vector<HCamera> mCachedCameras;
 		Vector<HRenderable> mRenderables;
+
+		// Bounds tree is updated lazily from the query methods
+		mutable Vector<UINT32> mRenderableProxies; /**< Bounds tree proxy of each entry in mRenderables, or AABBTree::INVALID_ID. */
+		mutable Vector<bool> mDirtyBounds; /**< True for each entry in mRenderables whose bounds changed since the last query. */
+		mutable UINT32 mNumDirtyBounds;
+		mutable AABBTree mRenderableTree; /**< Contains indices into mRenderables. */
 	};
 }
\ No newline at end of file
@@ -5,25 +5,102 @@
 #include "BsComponent.h"
 #include "BsException.h"
 #include "BsSceneObject.h"
+#include "BsTransformManager.h"
 #include "BsRenderable.h"
 #include "BsCamera.h"
+#include "BsMesh.h"
+#include "BsBounds.h"
 
 namespace BansheeEngine
 {
 	void BansheeSceneManager::updateRenderableTransforms()
 	{
-		// TODO - Consider a way to make the update faster. Either do it concurrently or
-		// consider organizing renderable matrices in an array for quicker updates
-		//   - I could keep everything in a sequential array but deal with dynamic elements
-		//     but putting them in a slow, normal array. Once the number of dynamic elements
-		//	   goes over some number the hierarchy is re-optimized.
+		TransformManager::instance().updateAll();
 
-		for(auto& iter : mRenderables)
+		for (UINT32 i = 0; i < (UINT32)mRenderables.size(); i++)
 		{
-			iter->SO()->updateTransformsIfDirty();
+			const HRenderable& renderable = mRenderables[i];
+			if (renderable->SO()->_isCoreDirty() || renderable->_isCoreDirty())
+				markBoundsDirty(i);
 		}
 	}
 
+	void BansheeSceneManager::findRenderables(const ConvexVolume& volume, Vector<HRenderable>& output) const
+	{
+		updateDirtyBounds();
+		mRenderableTree.query(volume, [&](UINT32 idx) { output.push_back(mRenderables[idx]); });
+	}
+
+	void BansheeSceneManager::findRenderables(const AABox& box, Vector<HRenderable>& output) const
+	{
+		updateDirtyBounds();
+		mRenderableTree.query(box, [&](UINT32 idx) { output.push_back(mRenderables[idx]); });
+	}
+
+	void BansheeSceneManager::findRenderables(const Sphere& sphere, Vector<HRenderable>& output) const
+	{
+		updateDirtyBounds();
+		mRenderableTree.query(sphere, [&](UINT32 idx) { output.push_back(mRenderables[idx]); });
+	}
+
+	void BansheeSceneManager::findRenderables(const Ray& ray, float maxDistance, Vector<HRenderable>& output) const
+	{
+		updateDirtyBounds();
+		mRenderableTree.query(ray, maxDistance, [&](UINT32 idx) { output.push_back(mRenderables[idx]); });
+	}
+
+	void BansheeSceneManager::markBoundsDirty(UINT32 idx)
+	{
+		if (mDirtyBounds[idx])
+			return;
+
+		mDirtyBounds[idx] = true;
+		mNumDirtyBounds++;
+	}
+
+	void BansheeSceneManager::updateDirtyBounds() const
+	{
+		if (mNumDirtyBounds == 0)
+			return;
+
+		for (UINT32 i = 0; i < (UINT32)mRenderables.size(); i++)
+		{
+			if (!mDirtyBounds[i])
+				continue;
+
+			updateRenderableBounds(i);
+			mDirtyBounds[i] = false;
+		}
+
+		mNumDirtyBounds = 0;
+	}
+
+	void BansheeSceneManager::updateRenderableBounds(UINT32 idx) const
+	{
+		const HRenderable& renderable = mRenderables[idx];
+		UINT32& proxyId = mRenderableProxies[idx];
+
+		HMesh mesh = renderable->getMesh();
+		if (mesh == nullptr || !mesh.isLoaded())
+		{
+			if (proxyId != AABBTree::INVALID_ID)
+			{
+				mRenderableTree.remove(proxyId);
+				proxyId = AABBTree::INVALID_ID;
+			}
+
+			return;
+		}
+
+		Bounds bounds = mesh->getBounds();
+		bounds.transformAffine(renderable->SO()->getWorldTfrm());
+
+		if (proxyId == AABBTree::INVALID_ID)
+			proxyId = mRenderableTree.insert(bounds.getBox(), idx);
+		else
+			mRenderableTree.update(proxyId, bounds.getBox());
+	}
+
 	void BansheeSceneManager::notifyComponentAdded(const HComponent& component)
 	{
 		if(component->getTypeId() == TID_Camera)
@@ -42,6 +119,10 @@ namespace BansheeEngine
 		{
 			HRenderable renderable = static_object_cast<Renderable>(component);
 			mRenderables.push_back(renderable);
+			mRenderableProxies.push_back((UINT32)AABBTree::INVALID_ID);
+			mDirtyBounds.push_back(false);
+
+			markBoundsDirty((UINT32)mRenderables.size() - 1);
 		}
 	}
 
@@ -68,7 +149,31 @@ namespace BansheeEngine
 			// TODO - I should probably use some for of a hash set because searching through possibly thousands of renderables will be slow
 			auto findIter = std::find(mRenderables.begin(), mRenderables.end(), renderable);
 			if(findIter != mRenderables.end())
-				mRenderables.erase(findIter);
+			{
+				UINT32 idx = (UINT32)(findIter - mRenderables.begin());
+				UINT32 lastIdx = (UINT32)mRenderables.size() - 1;
+
+				if (mRenderableProxies[idx] != AABBTree::INVALID_ID)
+					mRenderableTree.remove(mRenderableProxies[idx]);
+
+				if (mDirtyBounds[idx])
+					mNumDirtyBounds--;
+
+				// Move the last renderable in place of the removed one, so indices stored in the tree stay valid
+				if (idx != lastIdx)
+				{
+					mRenderables[idx] = mRenderables[lastIdx];
+					mRenderableProxies[idx] = mRenderableProxies[lastIdx];
+					mDirtyBounds[idx] = mDirtyBounds[lastIdx];
+
+					if (mRenderableProxies[idx] != AABBTree::INVALID_ID)
+						mRenderableTree.setUserData(mRenderableProxies[idx], idx);
+				}
+
+				mRenderables.pop_back();
+				mRenderableProxies.pop_back();
+				mDirtyBounds.pop_back();
+			}
 
 			onRenderableRemoved(renderable);
 		}
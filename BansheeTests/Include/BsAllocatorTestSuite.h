@@ -0,0 +1,43 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Tests correctness and thread safety of PoolAlloc and ScratchAlloc, checks that core objects
+	 *			created through PoolAlloc are freed through it, and compares the allocators' performance against
+	 *			the general purpose allocator.
+	 */
+	class AllocatorTestSuite : public TestSuite
+	{
+	public:
+		AllocatorTestSuite();
+
+	private:
+		void testPoolAllocSizes();
+		void testScratchAllocSizes();
+		void testPoolAllocCrossThread();
+		void testScratchAllocCrossThread();
+		void testPoolAllocReuse();
+		void testScratchAllocReuse();
+		void testPoolAllocCoreObject();
+		void benchmarkAllocators();
+
+		/**
+		 * @brief	Allocates blocks of many different sizes through the allocator, fills each with a unique
+		 *			pattern while all of them are alive and checks that no block overwrote another.
+		 */
+		template<class Alloc>
+		void testSizes(UINT32 maxSize);
+
+		/**
+		 * @brief	Allocates on worker threads and frees on the calling thread, and vice versa.
+		 */
+		template<class Alloc>
+		void testCrossThread();
+	};
+}
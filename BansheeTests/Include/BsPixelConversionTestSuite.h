@@ -0,0 +1,27 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Checks that PixelConversion kernels of every instruction set supported by the CPU produce results
+	 *			identical to per-pixel conversion through PixelUtil, and measures their performance.
+	 */
+	class PixelConversionTestSuite : public TestSuite
+	{
+	public:
+		PixelConversionTestSuite();
+
+	protected:
+		void shutDown();
+
+	private:
+		void testISASelection();
+		void testConformance();
+		void benchmarkConversion();
+	};
+}
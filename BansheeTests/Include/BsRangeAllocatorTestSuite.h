@@ -0,0 +1,28 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Tests block bookkeeping, merging, growing and statistics of RangeAllocator, and measures
+	 *			its performance under allocation patterns typical for transient GUI meshes.
+	 */
+	class RangeAllocatorTestSuite : public TestSuite
+	{
+	public:
+		RangeAllocatorTestSuite();
+
+	private:
+		void testAllocFree();
+		void testMerge();
+		void testFull();
+		void testGrow();
+		void testStats();
+		void testRandom();
+		void benchmarkGUIChurn();
+	};
+}
@@ -0,0 +1,34 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsTestSuite.h"
+#include "BsPrerequisites.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Tests ordering of elements produced by RenderQueue sorting, and measures sorting performance.
+	 */
+	class RenderQueueTestSuite : public TestSuite
+	{
+	public:
+		RenderQueueTestSuite();
+
+	private:
+		void testPriority();
+		void testFrontToBack();
+		void testBackToFront();
+		void testUnsorted();
+		void testSeparablePasses();
+		void testMaterialGrouping();
+		void testReuse();
+		void benchmarkSort();
+
+		/**
+		 * @brief	Creates a material proxy with a new shader proxy using the provided sorting options.
+		 */
+		static MaterialProxyPtr createMaterial(QueueSortType sortType, UINT32 priority, UINT32 numPasses = 1, bool separablePasses = false);
+	};
+}
@@ -0,0 +1,38 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Type IDs of reflectable objects used only by the scene object prototype tests. Continue
+	 *			after the ones used by SerializationTestSuite.
+	 */
+	enum TypeID_PrototypeTests
+	{
+		TID_PrototypeTestComponent = 90003
+	};
+
+	/**
+	 * @brief	Tests that hierarchies created by SceneObjectPrototype match the ones created by
+	 *			SceneObject::clone, and that a failed instantiation doesn't leave game object
+	 *			deserialization active.
+	 */
+	class SceneObjectPrototypeTestSuite : public TestSuite
+	{
+	public:
+		SceneObjectPrototypeTestSuite();
+
+	protected:
+		void startUp();
+		void shutDown();
+
+	private:
+		void testMatchesClone();
+		void testMultipleInstances();
+		void testFailedInstantiate();
+	};
+}
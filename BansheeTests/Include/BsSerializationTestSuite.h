@@ -0,0 +1,36 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Type IDs of reflectable objects used only by the tests.
+	 */
+	enum TypeID_Tests
+	{
+		TID_SerializationTestObject = 90000,
+		TID_SerializationTestChild = 90001,
+		TID_SerializationTestLegacyObject = 90002
+	};
+
+	/**
+	 * @brief	Tests encoding and decoding of objects through BinarySerializer, including
+	 *			the RTTISchema fast paths, and measures their performance.
+	 */
+	class SerializationTestSuite : public TestSuite
+	{
+	public:
+		SerializationTestSuite();
+
+	private:
+		void testRoundTrip();
+		void testSmallBuffer();
+		void testStreamDecode();
+		void testChangedFields();
+		void benchmarkSerialization();
+	};
+}
@@ -0,0 +1,30 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Tests task dependencies, TaskGroup and parallelFor running on the TaskScheduler.
+	 */
+	class TaskSchedulerTestSuite : public TestSuite
+	{
+	public:
+		TaskSchedulerTestSuite();
+
+	protected:
+		void startUp();
+		void shutDown();
+
+	private:
+		void testDependencies();
+		void testCancel();
+		void testTaskGroup();
+		void testParallelForRange();
+		void testNestedParallelFor();
+		void benchmarkParallelFor();
+	};
+}
@@ -0,0 +1,143 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+#define BS_TEST_ASSERT(expr) assertment((expr), "", __FILE__, __LINE__)
+#define BS_TEST_ASSERT_MSG(expr, msg) assertment((expr), msg, __FILE__, __LINE__)
+#define BS_ADD_TEST(func) addTest(static_cast<Func>(&func), #func)
+
+namespace BansheeEngine
+{
+	class TestOutput;
+
+	/**
+	 * @brief	Primary class for unit testing. Override and register unit tests in the
+	 *			constructor using BS_ADD_TEST, then run the suite with the desired output.
+	 *
+	 *			Tests report failures through BS_TEST_ASSERT and BS_TEST_ASSERT_MSG, and
+	 *			may report benchmark timings through ::reportTiming.
+	 */
+	class TestSuite
+	{
+	public:
+		typedef void(TestSuite::*Func)();
+
+	private:
+		/**
+		 * @brief	Contains data about a single unit test.
+		 */
+		struct TestEntry
+		{
+			TestEntry(Func test, const String& name)
+				:test(test), name(name)
+			{ }
+
+			Func test;
+			String name;
+		};
+
+	public:
+		virtual ~TestSuite() {}
+
+		/**
+		 * @brief	Runs all the tests in the suite. Results are reported to the provided output.
+		 *
+		 * @returns	Number of failed assertions.
+		 */
+		UINT32 run(TestOutput& output);
+
+		/**
+		 * @brief	Creates a new test suite of the specified type.
+		 */
+		template <class T>
+		static std::shared_ptr<TestSuite> create()
+		{
+			return bs_shared_ptr<T>();
+		}
+
+	protected:
+		TestSuite();
+
+		/**
+		 * @brief	Called before any of the tests in the suite are ran.
+		 */
+		virtual void startUp() {}
+
+		/**
+		 * @brief	Called after all the tests in the suite have ran.
+		 */
+		virtual void shutDown() {}
+
+		/**
+		 * @brief	Registers a new unit test.
+		 *
+		 * @param	test	Member function of the suite that runs the test.
+		 * @param	name	Name of the test, used when reporting results.
+		 */
+		void addTest(Func test, const String& name);
+
+		/**
+		 * @brief	Reports a failure to the output if "success" is false.
+		 */
+		void assertment(bool success, const String& desc, const String& file, long line);
+
+		/**
+		 * @brief	Reports a benchmark result of the currently running test.
+		 */
+		void reportTiming(const String& desc, double timeMs);
+
+		Vector<TestEntry> mTests;
+
+		TestOutput* mOutput;
+		String mActiveTestName;
+		UINT32 mNumFailures;
+	};
+
+	/**
+	 * @brief	Abstract interface used for outputting unit test results.
+	 */
+	class TestOutput
+	{
+	public:
+		virtual ~TestOutput() {}
+
+		/**
+		 * @brief	Triggered when a unit test assertion fails.
+		 *
+		 * @param	desc		Reason why the assertion failed.
+		 * @param	function	Name of the test that failed.
+		 * @param	file		File in which the assertion failed.
+		 * @param	line		Line on which the assertion failed.
+		 */
+		virtual void outputFail(const String& desc, const String& function, const String& file, long line) = 0;
+
+		/**
+		 * @brief	Triggered when a test reports a benchmark result.
+		 *
+		 * @param	desc		Description of what was measured.
+		 * @param	function	Name of the test that made the measurement.
+		 * @param	timeMs		Measured time in milliseconds.
+		 */
+		virtual void outputTiming(const String& desc, const String& function, double timeMs) = 0;
+	};
+
+	/**
+	 * @brief	Outputs unit test results to the standard output.
+	 */
+	class ConsoleTestOutput : public TestOutput
+	{
+	public:
+		/**
+		 * @copydoc	TestOutput::outputFail
+		 */
+		void outputFail(const String& desc, const String& function, const String& file, long line);
+
+		/**
+		 * @copydoc	TestOutput::outputTiming
+		 */
+		void outputTiming(const String& desc, const String& function, double timeMs);
+	};
+}
@@ -0,0 +1,39 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsTestSuite.h"
+#include "BsTaskSchedulerTestSuite.h"
+#include "BsAllocatorTestSuite.h"
+#include "BsRenderQueueTestSuite.h"
+#include "BsSerializationTestSuite.h"
+#include "BsPixelConversionTestSuite.h"
+#include "BsRangeAllocatorTestSuite.h"
+#include "BsSceneObjectPrototypeTestSuite.h"
+#include <iostream>
+
+using namespace BansheeEngine;
+
+int main()
+{
+	Vector<std::shared_ptr<TestSuite>> suites;
+	suites.push_back(TestSuite::create<TaskSchedulerTestSuite>());
+	suites.push_back(TestSuite::create<AllocatorTestSuite>());
+	suites.push_back(TestSuite::create<RenderQueueTestSuite>());
+	suites.push_back(TestSuite::create<SerializationTestSuite>());
+	suites.push_back(TestSuite::create<PixelConversionTestSuite>());
+	suites.push_back(TestSuite::create<RangeAllocatorTestSuite>());
+	suites.push_back(TestSuite::create<SceneObjectPrototypeTestSuite>());
+
+	ConsoleTestOutput output;
+
+	UINT32 numFailures = 0;
+	for (auto& suite : suites)
+		numFailures += suite->run(output);
+
+	if (numFailures > 0)
+		std::cout << numFailures << " assertion(s) failed." << std::endl;
+	else
+		std::cout << "All tests passed." << std::endl;
+
+	return numFailures > 0 ? 1 : 0;
+}
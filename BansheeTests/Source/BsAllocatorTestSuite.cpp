@@ -0,0 +1,363 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsAllocatorTestSuite.h"
+#include "BsCoreObject.h"
+#include "BsCoreObjectManager.h"
+#include "BsTimer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Fills the memory with a pattern unique to the provided seed.
+	 */
+	static void fillPattern(void* ptr, UINT32 size, UINT32 seed)
+	{
+		UINT8* data = (UINT8*)ptr;
+		for (UINT32 i = 0; i < size; i++)
+			data[i] = (UINT8)(seed * 31 + i);
+	}
+
+	/**
+	 * @brief	Checks that the memory contains the pattern written by ::fillPattern.
+	 */
+	static bool checkPattern(void* ptr, UINT32 size, UINT32 seed)
+	{
+		UINT8* data = (UINT8*)ptr;
+		for (UINT32 i = 0; i < size; i++)
+		{
+			if (data[i] != (UINT8)(seed * 31 + i))
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief	Core object initialized on the caller thread that reports when it gets deleted.
+	 */
+	class AllocatorTestCoreObject : public CoreObject
+	{
+	public:
+		AllocatorTestCoreObject(bool& deleted)
+			:CoreObject(false), mDeleted(deleted)
+		{ }
+
+		~AllocatorTestCoreObject()
+		{
+			mDeleted = true;
+		}
+
+	private:
+		bool& mDeleted;
+	};
+
+	AllocatorTestSuite::AllocatorTestSuite()
+	{
+		BS_ADD_TEST(AllocatorTestSuite::testPoolAllocSizes);
+		BS_ADD_TEST(AllocatorTestSuite::testScratchAllocSizes);
+		BS_ADD_TEST(AllocatorTestSuite::testPoolAllocCrossThread);
+		BS_ADD_TEST(AllocatorTestSuite::testScratchAllocCrossThread);
+		BS_ADD_TEST(AllocatorTestSuite::testPoolAllocReuse);
+		BS_ADD_TEST(AllocatorTestSuite::testScratchAllocReuse);
+		BS_ADD_TEST(AllocatorTestSuite::testPoolAllocCoreObject);
+		BS_ADD_TEST(AllocatorTestSuite::benchmarkAllocators);
+	}
+
+	template<class Alloc>
+	void AllocatorTestSuite::testSizes(UINT32 maxSize)
+	{
+		struct Allocation
+		{
+			void* ptr;
+			UINT32 size;
+		};
+
+		Vector<Allocation> allocations;
+		bool allAligned = true;
+
+		// Sizes around every 16 byte boundary so every size class and its edges get used, including 
+		// sizes large enough to be passed to malloc
+		for (UINT32 size = 1; size <= maxSize; size += (size < 1100 ? 1 : 509))
+		{
+			void* ptr = bs_alloc<Alloc>(size);
+			allAligned &= ((UINT64)ptr & 15) == 0;
+
+			fillPattern(ptr, size, (UINT32)allocations.size());
+			allocations.push_back({ ptr, size });
+		}
+
+		BS_TEST_ASSERT_MSG(allAligned, "Allocations must be 16 byte aligned.");
+
+		bool allIntact = true;
+		for (UINT32 i = 0; i < (UINT32)allocations.size(); i++)
+			allIntact &= checkPattern(allocations[i].ptr, allocations[i].size, i);
+
+		BS_TEST_ASSERT_MSG(allIntact, "Live allocations must not overlap.");
+
+		// Free every other allocation, then allocate the same sizes again to make sure reused blocks don't overlap
+		for (UINT32 i = 0; i < (UINT32)allocations.size(); i += 2)
+		{
+			bs_free<Alloc>(allocations[i].ptr);
+
+			allocations[i].ptr = bs_alloc<Alloc>(allocations[i].size);
+			fillPattern(allocations[i].ptr, allocations[i].size, i);
+		}
+
+		allIntact = true;
+		for (UINT32 i = 0; i < (UINT32)allocations.size(); i++)
+			allIntact &= checkPattern(allocations[i].ptr, allocations[i].size, i);
+
+		BS_TEST_ASSERT_MSG(allIntact, "Reused allocations must not overlap live ones.");
+
+		// Free in reverse order
+		for (auto iter = allocations.rbegin(); iter != allocations.rend(); ++iter)
+			bs_free<Alloc>(iter->ptr);
+
+		MemoryAllocator<Alloc>::endThread();
+	}
+
+	template<class Alloc>
+	void AllocatorTestSuite::testCrossThread()
+	{
+		static const UINT32 NUM_THREADS = 4;
+		static const UINT32 NUM_ALLOCS = 20000;
+
+		Vector<Vector<void*>> threadAllocs(NUM_THREADS);
+		Vector<BS_THREAD_TYPE*> threads(NUM_THREADS);
+
+		// Allocate on workers, free on this thread
+		for (UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			Vector<void*>& allocs = threadAllocs[i];
+			BS_THREAD_CREATE(thread, ([&allocs, i]()
+			{
+				for (UINT32 j = 0; j < NUM_ALLOCS; j++)
+				{
+					UINT32 size = 8 + (j * 7) % 600;
+					void* ptr = bs_alloc<Alloc>(size);
+					fillPattern(ptr, size, i * NUM_ALLOCS + j);
+
+					allocs.push_back(ptr);
+				}
+
+				MemoryAllocator<Alloc>::endThread();
+			}));
+
+			threads[i] = thread;
+		}
+
+		for (auto& thread : threads)
+		{
+			BS_THREAD_JOIN((*thread));
+			BS_THREAD_DESTROY(thread);
+		}
+
+		bool allIntact = true;
+		for (UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			for (UINT32 j = 0; j < NUM_ALLOCS; j++)
+			{
+				UINT32 size = 8 + (j * 7) % 600;
+				allIntact &= checkPattern(threadAllocs[i][j], size, i * NUM_ALLOCS + j);
+
+				bs_free<Alloc>(threadAllocs[i][j]);
+			}
+
+			threadAllocs[i].clear();
+		}
+
+		BS_TEST_ASSERT_MSG(allIntact, "Allocations made on worker threads must not overlap.");
+
+		// Allocate on this thread, free on workers while they also allocate and free their own memory
+		Vector<void*> mainAllocs;
+		for (UINT32 i = 0; i < NUM_THREADS * NUM_ALLOCS; i++)
+			mainAllocs.push_back(bs_alloc<Alloc>(8 + (i * 13) % 600));
+
+		std::atomic<UINT32> numCorrupted(0);
+		for (UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			BS_THREAD_CREATE(thread, ([&mainAllocs, &numCorrupted, i]()
+			{
+				for (UINT32 j = 0; j < NUM_ALLOCS; j++)
+				{
+					bs_free<Alloc>(mainAllocs[i * NUM_ALLOCS + j]);
+
+					UINT32 size = 8 + (j * 3) % 300;
+					void* ptr = bs_alloc<Alloc>(size);
+					fillPattern(ptr, size, i + j);
+
+					if (!checkPattern(ptr, size, i + j))
+						numCorrupted++;
+
+					bs_free<Alloc>(ptr);
+				}
+
+				MemoryAllocator<Alloc>::endThread();
+			}));
+
+			threads[i] = thread;
+		}
+
+		for (auto& thread : threads)
+		{
+			BS_THREAD_JOIN((*thread));
+			BS_THREAD_DESTROY(thread);
+		}
+
+		BS_TEST_ASSERT(numCorrupted == 0);
+
+		// Memory freed by the workers must be usable from this thread
+		void* ptr = bs_alloc<Alloc>(64);
+		fillPattern(ptr, 64, 0);
+		BS_TEST_ASSERT(checkPattern(ptr, 64, 0));
+		bs_free<Alloc>(ptr);
+
+		MemoryAllocator<Alloc>::endThread();
+	}
+
+	void AllocatorTestSuite::testPoolAllocSizes()
+	{
+		testSizes<PoolAlloc>(4096);
+	}
+
+	void AllocatorTestSuite::testScratchAllocSizes()
+	{
+		testSizes<ScratchAlloc>(32768);
+	}
+
+	void AllocatorTestSuite::testPoolAllocCrossThread()
+	{
+		testCrossThread<PoolAlloc>();
+	}
+
+	void AllocatorTestSuite::testScratchAllocCrossThread()
+	{
+		testCrossThread<ScratchAlloc>();
+	}
+
+	void AllocatorTestSuite::testPoolAllocReuse()
+	{
+		static const UINT32 NUM_ALLOCS = 10000;
+
+		Vector<void*> allocs(NUM_ALLOCS);
+		auto allocAndFree = [&]()
+		{
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+				allocs[i] = bs_alloc<PoolAlloc>(16 + (i % 64) * 8);
+
+			for (UINT32 i = 0; i < NUM_ALLOCS; i++)
+				bs_free<PoolAlloc>(allocs[i]);
+		};
+
+		allocAndFree();
+		UINT64 reservedAfterFirst = MemAllocProfiler::getPoolAllocStats().numBytesReserved;
+
+		for (UINT32 i = 0; i < 10; i++)
+			allocAndFree();
+
+		UINT64 reservedAfterAll = MemAllocProfiler::getPoolAllocStats().numBytesReserved;
+		BS_TEST_ASSERT_MSG(reservedAfterAll == reservedAfterFirst, "Freed blocks must be reused instead of reserving new memory.");
+
+		MemoryAllocator<PoolAlloc>::endThread();
+	}
+
+	void AllocatorTestSuite::testScratchAllocReuse()
+	{
+		static const UINT32 NUM_ALLOCS = 64;
+
+		UINT64 reservedAtStart = MemAllocProfiler::getScratchAllocStats().numBytesReserved;
+
+		// Typical scratch usage: a few temporary allocations released before the next batch. The block
+		// should get reset once empty instead of new ones being allocated
+		void* allocs[NUM_ALLOCS];
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			for (UINT32 j = 0; j < NUM_ALLOCS; j++)
+				allocs[j] = bs_alloc<ScratchAlloc>(16 + j * 8);
+
+			for (UINT32 j = 0; j < NUM_ALLOCS; j++)
+				bs_free<ScratchAlloc>(allocs[j]);
+		}
+
+		UINT64 reservedAfterLoop = MemAllocProfiler::getScratchAllocStats().numBytesReserved;
+		BS_TEST_ASSERT_MSG(reservedAfterLoop <= reservedAtStart + 64 * 1024, "Empty scratch block must be reused.");
+
+		// A long lived allocation keeps its block alive, but blocks must be released once it is freed
+		void* longLived = bs_alloc<ScratchAlloc>(32);
+		for (UINT32 i = 0; i < 1000; i++)
+			bs_free<ScratchAlloc>(bs_alloc<ScratchAlloc>(1024));
+
+		bs_free<ScratchAlloc>(longLived);
+		MemoryAllocator<ScratchAlloc>::endThread();
+
+		UINT64 reservedAtEnd = MemAllocProfiler::getScratchAllocStats().numBytesReserved;
+		BS_TEST_ASSERT_MSG(reservedAtEnd <= reservedAtStart, "Scratch blocks must be freed once they have no live allocations.");
+	}
+
+	void AllocatorTestSuite::testPoolAllocCoreObject()
+	{
+		bool startedManager = !CoreObjectManager::isStarted();
+		if (startedManager)
+			CoreObjectManager::startUp();
+
+		UINT64 numFreesAtStart = MemAllocProfiler::getPoolAllocStats().numFrees;
+
+		// Initialized objects are deleted by the temporary shared pointer CoreObject::_deleteDelayed creates to destroy them
+		bool initializedDeleted = false;
+		std::shared_ptr<AllocatorTestCoreObject> object = bs_core_ptr<AllocatorTestCoreObject, PoolAlloc>(initializedDeleted);
+		object->_setThisPtr(object);
+		object->initialize();
+
+		BS_TEST_ASSERT(object->isInitialized());
+		object = nullptr;
+
+		BS_TEST_ASSERT_MSG(initializedDeleted, "Initialized core object must be deleted once its last reference is released.");
+
+		// Uninitialized objects are deleted right away
+		bool uninitializedDeleted = false;
+		object = bs_core_ptr<AllocatorTestCoreObject, PoolAlloc>(uninitializedDeleted);
+		object->_setThisPtr(object);
+		object = nullptr;
+
+		BS_TEST_ASSERT_MSG(uninitializedDeleted, "Uninitialized core object must be deleted once its last reference is released.");
+
+		UINT64 numFreesAtEnd = MemAllocProfiler::getPoolAllocStats().numFrees;
+		BS_TEST_ASSERT_MSG(numFreesAtEnd >= numFreesAtStart + 2, "Core objects must be freed through the allocator they were created with.");
+
+		MemoryAllocator<PoolAlloc>::endThread();
+
+		if (startedManager)
+			CoreObjectManager::shutDown();
+	}
+
+	void AllocatorTestSuite::benchmarkAllocators()
+	{
+		static const UINT32 NUM_ALLOCS = 1000;
+		static const UINT32 NUM_ITERATIONS = 1000;
+
+		void* allocs[NUM_ALLOCS];
+
+		auto benchmark = [&](const String& name, void*(*allocFunc)(size_t), void(*freeFunc)(void*))
+		{
+			Timer timer;
+			for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				for (UINT32 j = 0; j < NUM_ALLOCS; j++)
+					allocs[j] = allocFunc(16 + (j % 32) * 8);
+
+				for (UINT32 j = 0; j < NUM_ALLOCS; j++)
+					freeFunc(allocs[j]);
+			}
+
+			reportTiming(name + ": " + toString(NUM_ALLOCS * NUM_ITERATIONS) + " allocations", timer.getMicroseconds() / 1000.0);
+		};
+
+		benchmark("GenAlloc", &MemoryAllocator<GenAlloc>::allocate, &MemoryAllocator<GenAlloc>::free);
+		benchmark("PoolAlloc", &MemoryAllocator<PoolAlloc>::allocate, &MemoryAllocator<PoolAlloc>::free);
+		benchmark("ScratchAlloc", &MemoryAllocator<ScratchAlloc>::allocate, &MemoryAllocator<ScratchAlloc>::free);
+
+		MemoryAllocator<PoolAlloc>::endThread();
+		MemoryAllocator<ScratchAlloc>::endThread();
+	}
+}
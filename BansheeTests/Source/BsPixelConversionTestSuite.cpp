@@ -0,0 +1,257 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsPixelConversionTestSuite.h"
+#include "BsPixelConversion.h"
+#include "BsPixelUtil.h"
+#include "BsColor.h"
+#include "BsTimer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Channel values used when generating floating point source pixels, covering exact byte values, 
+	 *			values halfway between them, values outside of the [0, 1] range and values that have no exact 
+	 *			half precision representation.
+	 */
+	static const float SPECIAL_VALUES[] = { 0.0f, -0.0f, 1.0f, 0.5f, 0.25f, 1.0f / 255.0f, 0.5f / 255.0f, 1.5f / 255.0f,
+		254.5f / 255.0f, 0.33333f, -0.5f, -1.0f, 1.5f, 2.0f, 100.0f, 65504.0f, 70000.0f, 1.0e6f, 6.0e-8f, 1.0e-5f };
+
+	static const UINT32 NUM_SPECIAL_VALUES = sizeof(SPECIAL_VALUES) / sizeof(SPECIAL_VALUES[0]);
+
+	/**
+	 * @brief	Returns a readable name of the instruction set.
+	 */
+	static String getISAName(PixelConversionISA isa)
+	{
+		switch (isa)
+		{
+		case PixelConversionISA::Scalar:
+			return "Scalar";
+		case PixelConversionISA::SSE2:
+			return "SSE2";
+		case PixelConversionISA::SSSE3:
+			return "SSSE3";
+		case PixelConversionISA::AVX2:
+			return "AVX2";
+		}
+
+		return "Unknown";
+	}
+
+	/**
+	 * @brief	Simple deterministic random number generator, so failures are reproducible.
+	 */
+	static UINT32 nextRandom(UINT32& state)
+	{
+		state = state * 1664525 + 1013904223;
+		return state >> 8;
+	}
+
+	/**
+	 * @brief	Fills the buffer with pixels of the specified format. Byte formats get random bytes, while floating
+	 *			point formats get a mix of special and random values, packed using PixelUtil.
+	 */
+	static void generatePixels(PixelFormat format, UINT8* dst, UINT32 count, UINT32 seed)
+	{
+		UINT32 state = seed;
+		UINT32 pixelSize = PixelUtil::getNumElemBytes(format);
+
+		if (!PixelUtil::isFloatingPoint(format))
+		{
+			for (UINT32 i = 0; i < count * pixelSize; i++)
+				dst[i] = (UINT8)nextRandom(state);
+
+			return;
+		}
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			float channels[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				UINT32 random = nextRandom(state);
+				if ((random & 1) == 0)
+					channels[j] = SPECIAL_VALUES[(random >> 1) % NUM_SPECIAL_VALUES];
+				else
+					channels[j] = ((random >> 1) % 10000) / 10000.0f * 1.5f - 0.25f;
+			}
+
+			PixelUtil::packColor(channels[0], channels[1], channels[2], channels[3], format, dst + i * pixelSize);
+		}
+	}
+
+	PixelConversionTestSuite::PixelConversionTestSuite()
+	{
+		BS_ADD_TEST(PixelConversionTestSuite::testISASelection);
+		BS_ADD_TEST(PixelConversionTestSuite::testConformance);
+		BS_ADD_TEST(PixelConversionTestSuite::benchmarkConversion);
+	}
+
+	void PixelConversionTestSuite::shutDown()
+	{
+		PixelConversion::setISA(PixelConversion::getMaxSupportedISA());
+	}
+
+	void PixelConversionTestSuite::testISASelection()
+	{
+		PixelConversionISA maxISA = PixelConversion::getMaxSupportedISA();
+
+		for (UINT32 i = 0; i <= (UINT32)PixelConversionISA::AVX2; i++)
+		{
+			PixelConversion::setISA((PixelConversionISA)i);
+
+			PixelConversionISA expectedISA = i <= (UINT32)maxISA ? (PixelConversionISA)i : maxISA;
+			BS_TEST_ASSERT_MSG(PixelConversion::getISA() == expectedISA, "Unexpected ISA after setting " + getISAName((PixelConversionISA)i));
+		}
+
+		PixelConversion::setISA(maxISA);
+		BS_TEST_ASSERT(PixelConversion::getISA() == maxISA);
+
+		BS_TEST_ASSERT(!PixelConversion::isSupported(PF_UNKNOWN, PF_R8G8B8A8));
+		BS_TEST_ASSERT(!PixelConversion::isSupported(PF_R8G8B8A8, PF_BC1));
+		BS_TEST_ASSERT(!PixelConversion::isSupported(PF_R8G8B8X8, PF_R8G8B8A8));
+		BS_TEST_ASSERT(PixelConversion::isSupported(PF_R8G8B8A8, PF_R8G8B8X8));
+		BS_TEST_ASSERT(!PixelConversion::isSupported(PF_R8G8B8A8, PF_COUNT));
+	}
+
+	void PixelConversionTestSuite::testConformance()
+	{
+		// Row lengths that hit the vector loops, their tails, and conversions split into multiple blocks
+		static const UINT32 ROW_LENGTHS[] = { 1, 3, 7, 33, 255, 257, 601 };
+		static const UINT32 MAX_ROW_LENGTH = 601;
+		static const UINT32 MAX_PIXEL_SIZE = 16;
+		static const UINT32 GUARD_SIZE = 64;
+		static const UINT8 GUARD_VALUE = 0xCD;
+
+		PixelConversionISA maxISA = PixelConversion::getMaxSupportedISA();
+
+		// Offset by one byte so kernels can't rely on aligned buffers
+		Vector<UINT8> srcBuffer(MAX_ROW_LENGTH * MAX_PIXEL_SIZE + 1);
+		Vector<UINT8> expected(MAX_ROW_LENGTH * MAX_PIXEL_SIZE);
+		Vector<UINT8> dstBuffer(MAX_ROW_LENGTH * MAX_PIXEL_SIZE + GUARD_SIZE + 1);
+
+		UINT8* src = srcBuffer.data() + 1;
+		UINT8* dst = dstBuffer.data() + 1;
+
+		UINT32 numPairs = 0;
+		for (UINT32 srcIdx = 0; srcIdx < PF_COUNT; srcIdx++)
+		{
+			for (UINT32 dstIdx = 0; dstIdx < PF_COUNT; dstIdx++)
+			{
+				PixelFormat srcFormat = (PixelFormat)srcIdx;
+				PixelFormat dstFormat = (PixelFormat)dstIdx;
+
+				if (!PixelConversion::isSupported(srcFormat, dstFormat))
+					continue;
+
+				numPairs++;
+
+				UINT32 srcPixelSize = PixelUtil::getNumElemBytes(srcFormat);
+				UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dstFormat);
+
+				for (auto& rowLength : ROW_LENGTHS)
+				{
+					generatePixels(srcFormat, src, rowLength, srcIdx * 7919 + dstIdx * 31 + rowLength);
+
+					for (UINT32 i = 0; i < rowLength; i++)
+					{
+						Color color;
+						PixelUtil::unpackColor(&color, srcFormat, src + i * srcPixelSize);
+						PixelUtil::packColor(color, dstFormat, expected.data() + i * dstPixelSize);
+					}
+
+					UINT32 dstSize = rowLength * dstPixelSize;
+					for (UINT32 isaIdx = 0; isaIdx <= (UINT32)maxISA; isaIdx++)
+					{
+						PixelConversionISA isa = (PixelConversionISA)isaIdx;
+						PixelConversion::setISA(isa);
+
+						memset(dst, GUARD_VALUE, dstSize + GUARD_SIZE);
+						PixelConversion::convertRow(srcFormat, dstFormat, src, dst, rowLength);
+
+						String desc = PixelUtil::getFormatName(srcFormat) + " -> " + PixelUtil::getFormatName(dstFormat) +
+							", " + getISAName(isa) + ", " + toString(rowLength) + " pixels";
+
+						if (memcmp(dst, expected.data(), dstSize) != 0)
+						{
+							UINT32 firstMismatch = 0;
+							while (dst[firstMismatch] == expected[firstMismatch])
+								firstMismatch++;
+
+							BS_TEST_ASSERT_MSG(false, "Result differs from PixelUtil: " + desc + ", first mismatch at pixel " + 
+								toString(firstMismatch / dstPixelSize));
+						}
+
+						bool guardIntact = true;
+						for (UINT32 i = 0; i < GUARD_SIZE; i++)
+							guardIntact &= dst[dstSize + i] == GUARD_VALUE;
+
+						BS_TEST_ASSERT_MSG(guardIntact, "Conversion wrote past the end of the row: " + desc);
+					}
+				}
+			}
+		}
+
+		PixelConversion::setISA(maxISA);
+
+		BS_TEST_ASSERT_MSG(numPairs > 0, "No supported format pairs found.");
+	}
+
+	void PixelConversionTestSuite::benchmarkConversion()
+	{
+		static const UINT32 NUM_PIXELS = 1024 * 1024;
+
+		struct FormatPair
+		{
+			PixelFormat src;
+			PixelFormat dst;
+		};
+
+		FormatPair pairs[] = 
+		{
+			{ PF_R8G8B8A8, PF_B8G8R8A8 },
+			{ PF_R8G8B8, PF_B8G8R8A8 },
+			{ PF_R8G8B8A8, PF_FLOAT32_RGBA },
+			{ PF_FLOAT32_RGBA, PF_R8G8B8A8 },
+			{ PF_FLOAT16_RGBA, PF_FLOAT32_RGBA },
+			{ PF_FLOAT32_RGBA, PF_FLOAT16_RGBA }
+		};
+
+		PixelConversionISA maxISA = PixelConversion::getMaxSupportedISA();
+
+		Vector<UINT8> src(NUM_PIXELS * 16);
+		Vector<UINT8> dst(NUM_PIXELS * 16);
+
+		for (auto& pair : pairs)
+		{
+			generatePixels(pair.src, src.data(), NUM_PIXELS, 1);
+
+			UINT32 srcPixelSize = PixelUtil::getNumElemBytes(pair.src);
+			UINT32 dstPixelSize = PixelUtil::getNumElemBytes(pair.dst);
+			String pairName = PixelUtil::getFormatName(pair.src) + " -> " + PixelUtil::getFormatName(pair.dst);
+
+			Timer timer;
+			for (UINT32 i = 0; i < NUM_PIXELS; i++)
+			{
+				Color color;
+				PixelUtil::unpackColor(&color, pair.src, src.data() + i * srcPixelSize);
+				PixelUtil::packColor(color, pair.dst, dst.data() + i * dstPixelSize);
+			}
+
+			reportTiming(pairName + ", PixelUtil per pixel", timer.getMicroseconds() / 1000.0);
+
+			for (UINT32 isaIdx = 0; isaIdx <= (UINT32)maxISA; isaIdx++)
+			{
+				PixelConversion::setISA((PixelConversionISA)isaIdx);
+
+				timer.reset();
+				PixelConversion::convertRow(pair.src, pair.dst, src.data(), dst.data(), NUM_PIXELS);
+
+				reportTiming(pairName + ", " + getISAName((PixelConversionISA)isaIdx), timer.getMicroseconds() / 1000.0);
+			}
+		}
+
+		PixelConversion::setISA(maxISA);
+	}
+}
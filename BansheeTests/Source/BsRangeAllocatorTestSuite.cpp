@@ -0,0 +1,412 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsRangeAllocatorTestSuite.h"
+#include "BsRangeAllocator.h"
+#include "BsMath.h"
+#include "BsTimer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Simple linear congruential generator, so test runs are repeatable on all platforms.
+	 */
+	static UINT32 nextRandom(UINT32& state)
+	{
+		state = state * 1664525 + 1013904223;
+		return state >> 8;
+	}
+
+	/**
+	 * @brief	Allocates a block, growing the allocator by the minimal amount that guarantees success if
+	 *			there is no free range large enough. Mirrors how MeshHeap grows its buffers.
+	 */
+	static UINT32 allocOrGrow(RangeAllocator& allocator, UINT32 size)
+	{
+		UINT32 blockId = allocator.alloc(size);
+		if (blockId == RangeAllocator::INVALID_BLOCK)
+		{
+			UINT64 newCapacity = (UINT64)allocator.getCapacity() + RangeAllocator::getRequiredFreeSize(size);
+			allocator.grow((UINT32)std::max(newCapacity, (UINT64)allocator.getCapacity() * 3 / 2));
+
+			blockId = allocator.alloc(size);
+		}
+
+		return blockId;
+	}
+
+	RangeAllocatorTestSuite::RangeAllocatorTestSuite()
+	{
+		BS_ADD_TEST(RangeAllocatorTestSuite::testAllocFree);
+		BS_ADD_TEST(RangeAllocatorTestSuite::testMerge);
+		BS_ADD_TEST(RangeAllocatorTestSuite::testFull);
+		BS_ADD_TEST(RangeAllocatorTestSuite::testGrow);
+		BS_ADD_TEST(RangeAllocatorTestSuite::testStats);
+		BS_ADD_TEST(RangeAllocatorTestSuite::testRandom);
+		BS_ADD_TEST(RangeAllocatorTestSuite::benchmarkGUIChurn);
+	}
+
+	void RangeAllocatorTestSuite::testAllocFree()
+	{
+		RangeAllocator allocator(1000);
+
+		UINT32 a = allocator.alloc(100);
+		UINT32 b = allocator.alloc(50);
+		UINT32 c = allocator.alloc(0);
+
+		BS_TEST_ASSERT(a != RangeAllocator::INVALID_BLOCK && b != RangeAllocator::INVALID_BLOCK && c != RangeAllocator::INVALID_BLOCK);
+		BS_TEST_ASSERT(a != b && b != c && a != c);
+
+		// Blocks are split from the start of the free range
+		BS_TEST_ASSERT(allocator.getStart(a) == 0 && allocator.getSize(a) == 100);
+		BS_TEST_ASSERT(allocator.getStart(b) == 100 && allocator.getSize(b) == 50);
+		BS_TEST_ASSERT_MSG(allocator.getStart(c) == 150 && allocator.getSize(c) == 1, "Zero sized allocations must take a single element.");
+
+		allocator.free(b);
+		allocator.free(a);
+		allocator.free(c);
+
+		RangeAllocatorStats stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.numUsedBlocks == 0 && stats.usedSize == 0);
+		BS_TEST_ASSERT_MSG(stats.numFreeBlocks == 1 && stats.largestFreeBlock == 1000, "Freeing all blocks must restore a single free range.");
+
+		// Freed block identifiers get reused
+		UINT32 d = allocator.alloc(10);
+		BS_TEST_ASSERT(d == a || d == b || d == c);
+		BS_TEST_ASSERT(allocator.getStart(d) == 0);
+	}
+
+	void RangeAllocatorTestSuite::testMerge()
+	{
+		RangeAllocator allocator(1000);
+
+		UINT32 blocks[4];
+		for (UINT32 i = 0; i < 4; i++)
+			blocks[i] = allocator.alloc(100);
+
+		// Non-adjacent frees stay separate: two holes plus the free tail
+		allocator.free(blocks[0]);
+		allocator.free(blocks[2]);
+		BS_TEST_ASSERT(allocator.getStats().numFreeBlocks == 3);
+
+		// Freeing the block between the holes merges with both neighbors
+		allocator.free(blocks[1]);
+
+		RangeAllocatorStats stats = allocator.getStats();
+		BS_TEST_ASSERT_MSG(stats.numFreeBlocks == 2, "Freed block must be merged with both adjacent free blocks.");
+		BS_TEST_ASSERT(stats.largestFreeBlock == 600);
+
+		// Merged range must be usable as a whole. It is in a smaller size class than the tail so it is picked first.
+		UINT32 merged = allocator.alloc(250);
+		BS_TEST_ASSERT(allocator.getStart(merged) == 0);
+
+		allocator.free(merged);
+
+		// Freeing the last used block merges with the free ranges on both sides
+		allocator.free(blocks[3]);
+
+		stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.numFreeBlocks == 1 && stats.largestFreeBlock == 1000);
+	}
+
+	void RangeAllocatorTestSuite::testFull()
+	{
+		RangeAllocator allocator(256);
+
+		// Sizes below the second level count map to exact size classes, so the whole space can be filled
+		Vector<UINT32> blocks;
+		for (UINT32 i = 0; i < 16; i++)
+			blocks.push_back(allocator.alloc(16));
+
+		bool allValid = true;
+		for (auto& blockId : blocks)
+			allValid &= blockId != RangeAllocator::INVALID_BLOCK;
+
+		BS_TEST_ASSERT(allValid);
+		BS_TEST_ASSERT(allocator.getStats().freeSize == 0 && allocator.getStats().numFreeBlocks == 0);
+
+		BS_TEST_ASSERT_MSG(allocator.alloc(1) == RangeAllocator::INVALID_BLOCK, "Allocation must fail when there is no free space.");
+		BS_TEST_ASSERT(allocator.alloc(std::numeric_limits<UINT32>::max()) == RangeAllocator::INVALID_BLOCK);
+
+		UINT32 start = allocator.getStart(blocks[5]);
+		allocator.free(blocks[5]);
+
+		UINT32 blockId = allocator.alloc(16);
+		BS_TEST_ASSERT(blockId != RangeAllocator::INVALID_BLOCK && allocator.getStart(blockId) == start);
+
+		// Empty allocator can't allocate anything until it grows
+		RangeAllocator empty;
+		BS_TEST_ASSERT(empty.getCapacity() == 0);
+		BS_TEST_ASSERT(empty.alloc(1) == RangeAllocator::INVALID_BLOCK);
+	}
+
+	void RangeAllocatorTestSuite::testGrow()
+	{
+		static const UINT32 SIZES[] = { 1, 5, 15, 16, 17, 31, 100, 1000, 1023, 1025, 12345, 70000 };
+
+		for (auto& size : SIZES)
+		{
+			// Fill the allocator with a used block so only the newly grown range is free
+			RangeAllocator allocator(16);
+			UINT32 fillId = allocator.alloc(16);
+
+			allocator.grow(16 + (UINT32)RangeAllocator::getRequiredFreeSize(size));
+
+			UINT32 blockId = allocator.alloc(size);
+			BS_TEST_ASSERT_MSG(blockId != RangeAllocator::INVALID_BLOCK, "Growing by the required free size must guarantee the allocation succeeds (size " + toString(size) + ").");
+			if (blockId == RangeAllocator::INVALID_BLOCK)
+				continue;
+
+			BS_TEST_ASSERT(allocator.getStart(fillId) == 0 && allocator.getSize(fillId) == 16);
+			BS_TEST_ASSERT(allocator.getStart(blockId) == 16 && allocator.getSize(blockId) == size);
+		}
+
+		// Growing while the last range is free extends it instead of adding a new one
+		RangeAllocator allocator(100);
+		UINT32 a = allocator.alloc(50);
+
+		allocator.grow(200);
+		BS_TEST_ASSERT(allocator.getCapacity() == 200);
+
+		RangeAllocatorStats stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.numFreeBlocks == 1 && stats.largestFreeBlock == 150);
+
+		// Shrinking is ignored
+		allocator.grow(10);
+		BS_TEST_ASSERT(allocator.getCapacity() == 200);
+
+		allocator.free(a);
+
+		stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.numFreeBlocks == 1 && stats.largestFreeBlock == 200);
+	}
+
+	void RangeAllocatorTestSuite::testStats()
+	{
+		RangeAllocator allocator(1000);
+
+		UINT32 blocks[9];
+		for (UINT32 i = 0; i < 9; i++)
+			blocks[i] = allocator.alloc(100);
+
+		allocator.free(blocks[1]);
+		allocator.free(blocks[3]);
+		allocator.free(blocks[5]);
+
+		// Three holes of 100 plus the tail of 100
+		RangeAllocatorStats stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.capacity == 1000);
+		BS_TEST_ASSERT(stats.usedSize == 600 && stats.freeSize == 400);
+		BS_TEST_ASSERT(stats.numUsedBlocks == 6 && stats.numFreeBlocks == 4);
+		BS_TEST_ASSERT(stats.largestFreeBlock == 100);
+		BS_TEST_ASSERT(Math::approxEquals(stats.getOccupancy(), 0.6f, 0.0001f));
+		BS_TEST_ASSERT(Math::approxEquals(stats.getFragmentation(), 0.75f, 0.0001f));
+
+		allocator.free(blocks[2]);
+
+		stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.numUsedBlocks == 5 && stats.numFreeBlocks == 3);
+		BS_TEST_ASSERT(stats.largestFreeBlock == 300);
+		BS_TEST_ASSERT(Math::approxEquals(stats.getFragmentation(), 1.0f - 300.0f / 500.0f, 0.0001f));
+
+		for (UINT32 i = 0; i < 9; i++)
+		{
+			if (i < 1 || i > 5 || i == 4)
+				allocator.free(blocks[i]);
+		}
+
+		stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.usedSize == 0 && Math::approxEquals(stats.getOccupancy(), 0.0f, 0.0001f));
+		BS_TEST_ASSERT(Math::approxEquals(stats.getFragmentation(), 0.0f, 0.0001f));
+	}
+
+	void RangeAllocatorTestSuite::testRandom()
+	{
+		static const UINT32 NUM_ITERATIONS = 50000;
+		static const UINT32 NO_OWNER = (UINT32)-1;
+
+		RangeAllocator allocator(4096);
+
+		// Owning block of every element, used to detect overlaps and to count free ranges independently
+		Vector<UINT32> owners(allocator.getCapacity(), NO_OWNER);
+		Vector<UINT32> liveBlocks;
+		UINT32 usedSize = 0;
+
+		bool inBounds = true;
+		bool noOverlap = true;
+		bool statsMatch = true;
+
+		UINT32 state = 12345;
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			bool shouldFree = !liveBlocks.empty() && (nextRandom(state) % 100) < 48;
+			if (shouldFree)
+			{
+				UINT32 idx = nextRandom(state) % (UINT32)liveBlocks.size();
+				UINT32 blockId = liveBlocks[idx];
+
+				UINT32 start = allocator.getStart(blockId);
+				UINT32 size = allocator.getSize(blockId);
+				for (UINT32 j = start; j < start + size; j++)
+					owners[j] = NO_OWNER;
+
+				usedSize -= size;
+				allocator.free(blockId);
+
+				liveBlocks[idx] = liveBlocks.back();
+				liveBlocks.pop_back();
+			}
+			else
+			{
+				// Mostly small blocks with an occasional large one
+				UINT32 size = (nextRandom(state) % 8) == 0 ? nextRandom(state) % 2048 : nextRandom(state) % 64;
+
+				UINT32 blockId = allocOrGrow(allocator, size);
+				if (blockId == RangeAllocator::INVALID_BLOCK)
+				{
+					BS_TEST_ASSERT_MSG(false, "Allocation must succeed after growing.");
+					return;
+				}
+
+				owners.resize(allocator.getCapacity(), NO_OWNER);
+
+				UINT32 start = allocator.getStart(blockId);
+				UINT32 allocSize = allocator.getSize(blockId);
+
+				inBounds &= allocSize == std::max(size, 1U);
+				inBounds &= (UINT64)start + allocSize <= allocator.getCapacity();
+
+				for (UINT32 j = start; j < start + allocSize; j++)
+				{
+					noOverlap &= owners[j] == NO_OWNER;
+					owners[j] = blockId;
+				}
+
+				usedSize += allocSize;
+				liveBlocks.push_back(blockId);
+			}
+
+			if ((i % 1000) == 0 || i == (NUM_ITERATIONS - 1))
+			{
+				// Adjacent free blocks are always merged, so free blocks must match maximal free runs exactly
+				UINT32 numFreeRuns = 0;
+				UINT32 longestFreeRun = 0;
+				UINT32 runLength = 0;
+				for (auto& owner : owners)
+				{
+					if (owner == NO_OWNER)
+					{
+						if (runLength == 0)
+							numFreeRuns++;
+
+						runLength++;
+						longestFreeRun = std::max(longestFreeRun, runLength);
+					}
+					else
+						runLength = 0;
+				}
+
+				RangeAllocatorStats stats = allocator.getStats();
+				statsMatch &= stats.capacity == (UINT32)owners.size();
+				statsMatch &= stats.usedSize == usedSize;
+				statsMatch &= stats.numUsedBlocks == (UINT32)liveBlocks.size();
+				statsMatch &= stats.numFreeBlocks == numFreeRuns;
+				statsMatch &= stats.largestFreeBlock == longestFreeRun;
+			}
+		}
+
+		BS_TEST_ASSERT_MSG(inBounds, "Allocated blocks must have the requested size and be within capacity.");
+		BS_TEST_ASSERT_MSG(noOverlap, "Allocated blocks must not overlap.");
+		BS_TEST_ASSERT_MSG(statsMatch, "Statistics must match the actual layout of allocated and free blocks.");
+
+		for (auto& blockId : liveBlocks)
+			allocator.free(blockId);
+
+		RangeAllocatorStats stats = allocator.getStats();
+		BS_TEST_ASSERT(stats.usedSize == 0 && stats.numFreeBlocks == 1 && stats.largestFreeBlock == stats.capacity);
+	}
+
+	void RangeAllocatorTestSuite::benchmarkGUIChurn()
+	{
+		static const UINT32 NUM_FRAMES = 1000;
+		static const UINT32 NUM_TRANSIENT = 500;
+		static const UINT32 NUM_PERSISTENT = 200;
+		static const UINT32 NUM_REPLACED = 10;
+
+		// Every GUI element is a batch of quads: four vertices and six indices per quad. Persistent elements
+		// live across frames and a few get rebuilt every frame, while transient ones (e.g. debug draw, text
+		// being edited) are recreated every frame.
+		RangeAllocator vertAllocator(4096);
+		RangeAllocator idxAllocator(6144);
+
+		struct Element
+		{
+			UINT32 vertBlock;
+			UINT32 idxBlock;
+		};
+
+		UINT32 state = 54321;
+		auto allocElement = [&]()
+		{
+			UINT32 numQuads = 1 + nextRandom(state) % 64;
+
+			Element element;
+			element.vertBlock = allocOrGrow(vertAllocator, numQuads * 4);
+			element.idxBlock = allocOrGrow(idxAllocator, numQuads * 6);
+
+			return element;
+		};
+
+		auto freeElement = [&](const Element& element)
+		{
+			vertAllocator.free(element.vertBlock);
+			idxAllocator.free(element.idxBlock);
+		};
+
+		Vector<Element> persistent;
+		for (UINT32 i = 0; i < NUM_PERSISTENT; i++)
+			persistent.push_back(allocElement());
+
+		Vector<Element> transient;
+		transient.reserve(NUM_TRANSIENT);
+
+		float maxFragmentation = 0.0f;
+
+		Timer timer;
+		for (UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+		{
+			for (UINT32 i = 0; i < NUM_REPLACED; i++)
+			{
+				UINT32 idx = nextRandom(state) % NUM_PERSISTENT;
+				freeElement(persistent[idx]);
+				persistent[idx] = allocElement();
+			}
+
+			for (UINT32 i = 0; i < NUM_TRANSIENT; i++)
+				transient.push_back(allocElement());
+
+			// Meshes are released out of allocation order, as their GPU usage completes
+			while (!transient.empty())
+			{
+				UINT32 idx = nextRandom(state) % (UINT32)transient.size();
+				freeElement(transient[idx]);
+
+				transient[idx] = transient.back();
+				transient.pop_back();
+			}
+
+			if ((frame % 100) == 0)
+				maxFragmentation = std::max(maxFragmentation, vertAllocator.getStats().getFragmentation());
+		}
+
+		double timeMs = timer.getMicroseconds() / 1000.0;
+
+		RangeAllocatorStats vertStats = vertAllocator.getStats();
+		BS_TEST_ASSERT(vertStats.numUsedBlocks == NUM_PERSISTENT);
+		BS_TEST_ASSERT(idxAllocator.getStats().numUsedBlocks == NUM_PERSISTENT);
+
+		UINT32 numAllocs = NUM_FRAMES * (NUM_TRANSIENT + NUM_REPLACED) * 2;
+		reportTiming("RangeAllocator GUI churn: " + toString(numAllocs) + " allocations, " + toString(vertStats.capacity) +
+			" vertices reserved, " + toString(maxFragmentation * 100.0f, 3) + "% max fragmentation", timeMs);
+	}
+}
@@ -0,0 +1,312 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsRenderQueueTestSuite.h"
+#include "BsRenderQueue.h"
+#include "BsMaterialProxy.h"
+#include "BsShaderProxy.h"
+#include "BsMeshProxy.h"
+#include "BsTimer.h"
+
+namespace BansheeEngine
+{
+	RenderQueueTestSuite::RenderQueueTestSuite()
+	{
+		BS_ADD_TEST(RenderQueueTestSuite::testPriority);
+		BS_ADD_TEST(RenderQueueTestSuite::testFrontToBack);
+		BS_ADD_TEST(RenderQueueTestSuite::testBackToFront);
+		BS_ADD_TEST(RenderQueueTestSuite::testUnsorted);
+		BS_ADD_TEST(RenderQueueTestSuite::testSeparablePasses);
+		BS_ADD_TEST(RenderQueueTestSuite::testMaterialGrouping);
+		BS_ADD_TEST(RenderQueueTestSuite::testReuse);
+		BS_ADD_TEST(RenderQueueTestSuite::benchmarkSort);
+	}
+
+	MaterialProxyPtr RenderQueueTestSuite::createMaterial(QueueSortType sortType, UINT32 priority, UINT32 numPasses, bool separablePasses)
+	{
+		ShaderProxyPtr shader = bs_shared_ptr<ShaderProxy>();
+		shader->queueSortType = sortType;
+		shader->queuePriority = priority;
+		shader->separablePasses = separablePasses;
+
+		MaterialProxyPtr material = bs_shared_ptr<MaterialProxy>();
+		material->shader = shader;
+		material->passes.resize(numPasses);
+
+		return material;
+	}
+
+	void RenderQueueTestSuite::testPriority()
+	{
+		UINT32 priorities[] = { 0, (UINT32)QueuePriority::Overlay, (UINT32)QueuePriority::Opaque, 50, 
+			(UINT32)QueuePriority::Transparent, (UINT32)QueuePriority::Skybox, 51 };
+		UINT32 numPriorities = sizeof(priorities) / sizeof(priorities[0]);
+
+		RenderQueue queue;
+		Map<MaterialProxy*, UINT32> materialPriorities;
+
+		// Distances go against priority, to make sure priority takes precedence
+		for (UINT32 i = 0; i < numPriorities; i++)
+		{
+			MaterialProxyPtr material = createMaterial(QueueSortType::FrontToBack, priorities[i]);
+			materialPriorities[material.get()] = priorities[i];
+
+			queue.add(material, bs_shared_ptr<MeshProxy>(), (float)priorities[i]);
+		}
+
+		queue.sort();
+
+		const Vector<RenderQueueElement>& elements = queue.getSortedElements();
+		BS_TEST_ASSERT(elements.size() == numPriorities);
+
+		bool sorted = true;
+		for (UINT32 i = 1; i < (UINT32)elements.size(); i++)
+			sorted &= materialPriorities[elements[i - 1].material] > materialPriorities[elements[i].material];
+
+		BS_TEST_ASSERT_MSG(sorted, "Elements must be ordered from highest to lowest priority.");
+	}
+
+	void RenderQueueTestSuite::testFrontToBack()
+	{
+		static const UINT32 NUM_ELEMENTS = 256;
+
+		RenderQueue queue;
+		MaterialProxyPtr material = createMaterial(QueueSortType::FrontToBack, 0);
+
+		// Distances that differ by at least one quantization step, added in scrambled order
+		Map<MeshProxy*, float> meshDistances;
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			float distance = (float)((i * 97) % NUM_ELEMENTS) + 1.0f;
+
+			MeshProxyPtr mesh = bs_shared_ptr<MeshProxy>();
+			meshDistances[mesh.get()] = distance;
+
+			queue.add(material, mesh, distance);
+		}
+
+		// Negative distances are treated as zero
+		MeshProxyPtr behindMesh = bs_shared_ptr<MeshProxy>();
+		meshDistances[behindMesh.get()] = 0.0f;
+		queue.add(material, behindMesh, -10.0f);
+
+		queue.sort();
+
+		const Vector<RenderQueueElement>& elements = queue.getSortedElements();
+		BS_TEST_ASSERT(elements.size() == NUM_ELEMENTS + 1);
+
+		bool sorted = true;
+		for (UINT32 i = 1; i < (UINT32)elements.size(); i++)
+			sorted &= meshDistances[elements[i - 1].mesh] < meshDistances[elements[i].mesh];
+
+		BS_TEST_ASSERT_MSG(sorted, "Elements must be ordered from nearest to farthest.");
+	}
+
+	void RenderQueueTestSuite::testBackToFront()
+	{
+		static const UINT32 NUM_ELEMENTS = 256;
+
+		RenderQueue queue;
+		MaterialProxyPtr material = createMaterial(QueueSortType::BackToFront, 0);
+
+		// Large and small distances, to make sure quantization covers a wide range
+		Map<MeshProxy*, float> meshDistances;
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			float distance = ((i * 61) % NUM_ELEMENTS) * 1000.0f + 0.01f;
+
+			MeshProxyPtr mesh = bs_shared_ptr<MeshProxy>();
+			meshDistances[mesh.get()] = distance;
+
+			queue.add(material, mesh, distance);
+		}
+
+		queue.sort();
+
+		const Vector<RenderQueueElement>& elements = queue.getSortedElements();
+		BS_TEST_ASSERT(elements.size() == NUM_ELEMENTS);
+
+		bool sorted = true;
+		for (UINT32 i = 1; i < (UINT32)elements.size(); i++)
+			sorted &= meshDistances[elements[i - 1].mesh] > meshDistances[elements[i].mesh];
+
+		BS_TEST_ASSERT_MSG(sorted, "Elements must be ordered from farthest to nearest.");
+	}
+
+	void RenderQueueTestSuite::testUnsorted()
+	{
+		static const UINT32 NUM_ELEMENTS = 1000;
+
+		RenderQueue queue;
+		Vector<MaterialProxyPtr> materials;
+		for (UINT32 i = 0; i < 4; i++)
+			materials.push_back(createMaterial(QueueSortType::None, 10));
+
+		Vector<MeshProxy*> addOrder;
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			MeshProxyPtr mesh = bs_shared_ptr<MeshProxy>();
+			addOrder.push_back(mesh.get());
+
+			queue.add(materials[i % materials.size()], mesh, (float)((i * 31) % 100));
+		}
+
+		queue.sort();
+
+		const Vector<RenderQueueElement>& elements = queue.getSortedElements();
+		BS_TEST_ASSERT(elements.size() == NUM_ELEMENTS);
+
+		bool inOrder = true;
+		for (UINT32 i = 0; i < (UINT32)elements.size(); i++)
+			inOrder &= elements[i].mesh == addOrder[i];
+
+		BS_TEST_ASSERT_MSG(inOrder, "Unsorted elements must keep the order they were added in.");
+	}
+
+	void RenderQueueTestSuite::testSeparablePasses()
+	{
+		MaterialProxyPtr separable = createMaterial(QueueSortType::FrontToBack, 0, 3, true);
+		MaterialProxyPtr nonSeparable = createMaterial(QueueSortType::FrontToBack, 0, 3, false);
+
+		// Separable passes of objects at the same distance get grouped by pass
+		{
+			RenderQueue queue;
+			queue.add(separable, bs_shared_ptr<MeshProxy>(), 5.0f);
+			queue.add(separable, bs_shared_ptr<MeshProxy>(), 5.0f);
+			queue.sort();
+
+			const Vector<RenderQueueElement>& elements = queue.getSortedElements();
+			BS_TEST_ASSERT(elements.size() == 6);
+
+			bool groupedByPass = true;
+			for (UINT32 i = 0; i < (UINT32)elements.size(); i++)
+				groupedByPass &= elements[i].passIdx == i / 2;
+
+			BS_TEST_ASSERT(groupedByPass);
+		}
+
+		// Passes of non-separable objects must always be kept together and in order
+		{
+			RenderQueue queue;
+			queue.add(nonSeparable, bs_shared_ptr<MeshProxy>(), 5.0f);
+			queue.add(nonSeparable, bs_shared_ptr<MeshProxy>(), 5.0f);
+			queue.add(nonSeparable, bs_shared_ptr<MeshProxy>(), 1.0f);
+			queue.sort();
+
+			const Vector<RenderQueueElement>& elements = queue.getSortedElements();
+			BS_TEST_ASSERT(elements.size() == 9);
+
+			bool keptTogether = true;
+			for (UINT32 i = 0; i < (UINT32)elements.size(); i++)
+			{
+				keptTogether &= elements[i].passIdx == i % 3;
+				keptTogether &= elements[i].mesh == elements[i - i % 3].mesh;
+			}
+
+			BS_TEST_ASSERT(keptTogether);
+		}
+	}
+
+	void RenderQueueTestSuite::testMaterialGrouping()
+	{
+		static const UINT32 NUM_ELEMENTS = 300;
+
+		RenderQueue queue;
+		MaterialProxyPtr materials[] = { createMaterial(QueueSortType::FrontToBack, 0),
+			createMaterial(QueueSortType::FrontToBack, 0), createMaterial(QueueSortType::FrontToBack, 0) };
+
+		MeshProxyPtr mesh = bs_shared_ptr<MeshProxy>();
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			queue.add(materials[i % 3], mesh, 10.0f);
+
+		queue.sort();
+
+		const Vector<RenderQueueElement>& elements = queue.getSortedElements();
+		BS_TEST_ASSERT(elements.size() == NUM_ELEMENTS);
+
+		UINT32 numMaterialChanges = 0;
+		for (UINT32 i = 1; i < (UINT32)elements.size(); i++)
+		{
+			if (elements[i - 1].material != elements[i].material)
+				numMaterialChanges++;
+		}
+
+		BS_TEST_ASSERT_MSG(numMaterialChanges == 2, "Elements at the same distance must be grouped by material.");
+	}
+
+	void RenderQueueTestSuite::testReuse()
+	{
+		static const UINT32 NUM_ELEMENTS = 100;
+
+		MaterialProxyPtr material = createMaterial(QueueSortType::FrontToBack, 0);
+
+		RenderQueue queueA;
+		RenderQueue queueB;
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			queueA.add(material, bs_shared_ptr<MeshProxy>(), (float)(NUM_ELEMENTS - i));
+			queueB.add(material, bs_shared_ptr<MeshProxy>(), (float)(NUM_ELEMENTS * 2 - i));
+		}
+
+		queueA.sort();
+		Vector<RenderQueueElement> firstSort = queueA.getSortedElements();
+
+		// Sorting again must produce the same result
+		queueA.sort();
+		const Vector<RenderQueueElement>& secondSort = queueA.getSortedElements();
+
+		bool sameResult = firstSort.size() == secondSort.size();
+		for (UINT32 i = 0; sameResult && i < (UINT32)firstSort.size(); i++)
+			sameResult &= firstSort[i].mesh == secondSort[i].mesh && firstSort[i].passIdx == secondSort[i].passIdx;
+
+		BS_TEST_ASSERT(sameResult);
+
+		// Merged queue keeps the meshes of the source queue alive and sorts them together with its own
+		queueA.add(queueB);
+		queueB.clear();
+		queueA.sort();
+
+		const Vector<RenderQueueElement>& merged = queueA.getSortedElements();
+		BS_TEST_ASSERT(merged.size() == NUM_ELEMENTS * 2);
+
+		if (merged.size() == NUM_ELEMENTS * 2)
+			BS_TEST_ASSERT_MSG(merged[NUM_ELEMENTS - 1].mesh == firstSort.back().mesh, "Farthest element of the first queue must come before all elements of the second.");
+
+		queueA.clear();
+		queueA.sort();
+		BS_TEST_ASSERT(queueA.getSortedElements().empty());
+	}
+
+	void RenderQueueTestSuite::benchmarkSort()
+	{
+		static const UINT32 NUM_ELEMENTS = 100000;
+		static const UINT32 NUM_MATERIALS = 64;
+		static const UINT32 NUM_ITERATIONS = 10;
+
+		Vector<MaterialProxyPtr> materials;
+		for (UINT32 i = 0; i < NUM_MATERIALS; i++)
+		{
+			QueueSortType sortType = (i % 4) == 0 ? QueueSortType::BackToFront : QueueSortType::FrontToBack;
+			UINT32 priority = (i % 4) == 0 ? (UINT32)QueuePriority::Transparent : (UINT32)QueuePriority::Opaque;
+
+			materials.push_back(createMaterial(sortType, priority, 1 + i % 2, (i % 8) == 1));
+		}
+
+		Vector<MeshProxyPtr> meshes;
+		for (UINT32 i = 0; i < 256; i++)
+			meshes.push_back(bs_shared_ptr<MeshProxy>());
+
+		RenderQueue queue;
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			float distance = ((i * 7919) % 10000) * 0.1f;
+			queue.add(materials[(i * 13) % NUM_MATERIALS], meshes[(i * 17) % meshes.size()], distance);
+		}
+
+		Timer timer;
+		for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			queue.sort();
+
+		reportTiming("Sort of " + toString(NUM_ELEMENTS) + " elements", timer.getMicroseconds() / 1000.0 / NUM_ITERATIONS);
+	}
+}
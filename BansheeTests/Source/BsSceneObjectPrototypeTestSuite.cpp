@@ -0,0 +1,397 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsSceneObjectPrototypeTestSuite.h"
+#include "BsSceneObjectPrototype.h"
+#include "BsSceneObject.h"
+#include "BsComponent.h"
+#include "BsGameObjectRTTI.h"
+#include "BsGameObjectManager.h"
+#include "BsTransformManager.h"
+#include "BsCoreSceneManager.h"
+#include "BsRTTIType.h"
+#include "BsManagedDataBlock.h"
+#include "BsMemStack.h"
+#include "BsException.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Component containing every kind of field SceneObjectPrototype records differently: a plain field,
+	 *			a plain array with dynamically sized elements, a data block, and handles to game objects
+	 *			both inside and outside of the recorded hierarchy.
+	 */
+	class PrototypeTestComponent : public Component
+	{
+	public:
+		PrototypeTestComponent(const HSceneObject& parent)
+			:Component(parent), value(0)
+		{
+			setUpdateMode(ComponentUpdateMode::None);
+		}
+
+		UINT32 value;
+		Vector<String> names;
+		Vector<UINT8> data;
+
+		HSceneObject internalObject;
+		HComponent internalComponent;
+		HSceneObject externalObject;
+
+		static bool sThrowOnAssign; /**< When true assigning the plain field throws, in order to simulate a failing setter. */
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class SceneObject;
+		friend class PrototypeTestComponentRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		virtual RTTITypeBase* getRTTI() const;
+
+	protected:
+		PrototypeTestComponent() // Serialization only
+			:value(0)
+		{
+			setUpdateMode(ComponentUpdateMode::None);
+		}
+	};
+
+	bool PrototypeTestComponent::sThrowOnAssign = false;
+
+	class PrototypeTestComponentRTTI : public RTTIType<PrototypeTestComponent, Component, PrototypeTestComponentRTTI>
+	{
+	private:
+		UINT32& getValue(PrototypeTestComponent* obj) { return obj->value; }
+		void setValue(PrototypeTestComponent* obj, UINT32& value)
+		{
+			if(PrototypeTestComponent::sThrowOnAssign)
+				BS_EXCEPT(InternalErrorException, "Failing setter requested by the test.");
+
+			obj->value = value;
+		}
+
+		String& getName(PrototypeTestComponent* obj, UINT32 idx) { return obj->names[idx]; }
+		void setName(PrototypeTestComponent* obj, UINT32 idx, String& value) { obj->names[idx] = value; }
+		UINT32 getNumNames(PrototypeTestComponent* obj) { return (UINT32)obj->names.size(); }
+		void setNumNames(PrototypeTestComponent* obj, UINT32 size) { obj->names.resize(size); }
+
+		ManagedDataBlock getData(PrototypeTestComponent* obj)
+		{
+			ManagedDataBlock dataBlock(obj->data.data(), (UINT32)obj->data.size());
+			return dataBlock;
+		}
+
+		void setData(PrototypeTestComponent* obj, ManagedDataBlock value)
+		{
+			obj->data.assign(value.getData(), value.getData() + value.getSize());
+		}
+
+		GameObjectHandleBase& getInternalObject(PrototypeTestComponent* obj) { return obj->internalObject; }
+		void setInternalObject(PrototypeTestComponent* obj, GameObjectHandleBase& value) { obj->internalObject = value; }
+
+		GameObjectHandleBase& getInternalComponent(PrototypeTestComponent* obj) { return obj->internalComponent; }
+		void setInternalComponent(PrototypeTestComponent* obj, GameObjectHandleBase& value) { obj->internalComponent = value; }
+
+		GameObjectHandleBase& getExternalObject(PrototypeTestComponent* obj) { return obj->externalObject; }
+		void setExternalObject(PrototypeTestComponent* obj, GameObjectHandleBase& value) { obj->externalObject = value; }
+
+	public:
+		PrototypeTestComponentRTTI()
+		{
+			addPlainField("value", 0, &PrototypeTestComponentRTTI::getValue, &PrototypeTestComponentRTTI::setValue);
+			addPlainArrayField("names", 1, &PrototypeTestComponentRTTI::getName, &PrototypeTestComponentRTTI::getNumNames,
+				&PrototypeTestComponentRTTI::setName, &PrototypeTestComponentRTTI::setNumNames);
+			addDataBlockField("data", 2, &PrototypeTestComponentRTTI::getData, &PrototypeTestComponentRTTI::setData);
+			addReflectableField("internalObject", 3, &PrototypeTestComponentRTTI::getInternalObject, &PrototypeTestComponentRTTI::setInternalObject);
+			addReflectableField("internalComponent", 4, &PrototypeTestComponentRTTI::getInternalComponent, &PrototypeTestComponentRTTI::setInternalComponent);
+			addReflectableField("externalObject", 5, &PrototypeTestComponentRTTI::getExternalObject, &PrototypeTestComponentRTTI::setExternalObject);
+		}
+
+		virtual const String& getRTTIName()
+		{
+			static String name = "PrototypeTestComponent";
+			return name;
+		}
+
+		virtual UINT32 getRTTIId()
+		{
+			return TID_PrototypeTestComponent;
+		}
+
+		virtual std::shared_ptr<IReflectable> newRTTIObject()
+		{
+			return GameObjectRTTI::createGameObject<PrototypeTestComponent>();
+		}
+	};
+
+	RTTITypeBase* PrototypeTestComponent::getRTTIStatic()
+	{
+		return PrototypeTestComponentRTTI::instance();
+	}
+
+	RTTITypeBase* PrototypeTestComponent::getRTTI() const
+	{
+		return PrototypeTestComponent::getRTTIStatic();
+	}
+
+	/**
+	 * @brief	Creates a hierarchy of three scene objects, each with a test component. Components reference
+	 *			other objects and components within the hierarchy, and the provided external object.
+	 */
+	static HSceneObject createTestHierarchy(const HSceneObject& external)
+	{
+		HSceneObject root = SceneObject::create("Root");
+		HSceneObject child = SceneObject::create("Child");
+		HSceneObject grandChild = SceneObject::create("GrandChild");
+
+		child->setParent(root);
+		grandChild->setParent(child);
+
+		GameObjectHandle<PrototypeTestComponent> rootComponent = root->addComponent<PrototypeTestComponent>();
+		GameObjectHandle<PrototypeTestComponent> childComponent = child->addComponent<PrototypeTestComponent>();
+		GameObjectHandle<PrototypeTestComponent> grandChildComponent = grandChild->addComponent<PrototypeTestComponent>();
+
+		rootComponent->value = 7;
+		rootComponent->names.push_back("First");
+		rootComponent->names.push_back("");
+		rootComponent->names.push_back("A considerably longer name than the others");
+		for(UINT32 i = 0; i < 100; i++)
+			rootComponent->data.push_back((UINT8)(i * 3));
+
+		rootComponent->internalObject = grandChild;
+		rootComponent->internalComponent = childComponent;
+		rootComponent->externalObject = external;
+
+		childComponent->value = 13;
+		childComponent->internalObject = root;
+		childComponent->internalComponent = grandChildComponent;
+
+		// Leaves the array and the data block empty
+		grandChildComponent->value = 21;
+		grandChildComponent->internalComponent = rootComponent;
+		grandChildComponent->externalObject = external;
+
+		return root;
+	}
+
+	/**
+	 * @brief	Records a path relative to the provided root for every object and component in the hierarchy.
+	 */
+	static void findObjectPaths(const HSceneObject& so, const String& path, Map<UINT64, String>& paths)
+	{
+		paths[so->getInstanceId()] = path;
+
+		const Vector<HComponent>& components = so->getComponents();
+		for(UINT32 i = 0; i < (UINT32)components.size(); i++)
+			paths[components[i]->getInstanceId()] = path + "/component" + toString(i);
+
+		for(UINT32 i = 0; i < so->getNumChildren(); i++)
+			findObjectPaths(so->getChild(i), path + "/" + toString(i), paths);
+	}
+
+	/**
+	 * @brief	Describes the object the handle points to, as a path within the hierarchy, or using its
+	 *			instance ID if the object is outside of the hierarchy.
+	 */
+	static String describeHandle(const GameObjectHandleBase& handle, const Map<UINT64, String>& paths)
+	{
+		if(handle.isDestroyed())
+			return "null";
+
+		auto findIter = paths.find(handle.getInstanceId());
+		if(findIter != paths.end())
+			return findIter->second;
+
+		return "external " + toString(handle.getInstanceId());
+	}
+
+	/**
+	 * @brief	Compares two scene object hierarchies including all of their test components. Handles are equal if
+	 *			they point to objects at the same location within their own hierarchy, or to the same external object.
+	 */
+	static bool compareHierarchy(const HSceneObject& a, const HSceneObject& b,
+		const Map<UINT64, String>& pathsA, const Map<UINT64, String>& pathsB)
+	{
+		if(a->getName() != b->getName() || a->getNumChildren() != b->getNumChildren())
+			return false;
+
+		const Vector<HComponent>& componentsA = a->getComponents();
+		const Vector<HComponent>& componentsB = b->getComponents();
+
+		if(componentsA.size() != componentsB.size())
+			return false;
+
+		for(UINT32 i = 0; i < (UINT32)componentsA.size(); i++)
+		{
+			if(componentsA[i]->getRTTI()->getRTTIId() != TID_PrototypeTestComponent ||
+				componentsB[i]->getRTTI()->getRTTIId() != TID_PrototypeTestComponent)
+			{
+				return false;
+			}
+
+			PrototypeTestComponent* componentA = static_cast<PrototypeTestComponent*>(componentsA[i].get());
+			PrototypeTestComponent* componentB = static_cast<PrototypeTestComponent*>(componentsB[i].get());
+
+			if(componentA->value != componentB->value || componentA->names != componentB->names || componentA->data != componentB->data)
+				return false;
+
+			if(componentB->SO() != b)
+				return false;
+
+			if(describeHandle(componentA->internalObject, pathsA) != describeHandle(componentB->internalObject, pathsB) ||
+				describeHandle(componentA->internalComponent, pathsA) != describeHandle(componentB->internalComponent, pathsB) ||
+				describeHandle(componentA->externalObject, pathsA) != describeHandle(componentB->externalObject, pathsB))
+			{
+				return false;
+			}
+		}
+
+		for(UINT32 i = 0; i < a->getNumChildren(); i++)
+		{
+			if(b->getChild(i)->getParent() != b)
+				return false;
+
+			if(!compareHierarchy(a->getChild(i), b->getChild(i), pathsA, pathsB))
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @copydoc	compareHierarchy
+	 */
+	static bool compareHierarchy(const HSceneObject& a, const HSceneObject& b)
+	{
+		Map<UINT64, String> pathsA;
+		Map<UINT64, String> pathsB;
+
+		findObjectPaths(a, "", pathsA);
+		findObjectPaths(b, "", pathsB);
+
+		return compareHierarchy(a, b, pathsA, pathsB);
+	}
+
+	SceneObjectPrototypeTestSuite::SceneObjectPrototypeTestSuite()
+	{
+		BS_ADD_TEST(SceneObjectPrototypeTestSuite::testMatchesClone);
+		BS_ADD_TEST(SceneObjectPrototypeTestSuite::testMultipleInstances);
+		BS_ADD_TEST(SceneObjectPrototypeTestSuite::testFailedInstantiate);
+	}
+
+	void SceneObjectPrototypeTestSuite::startUp()
+	{
+		// Used by the serializer when cloning
+		MemStack::beginThread();
+
+		GameObjectManager::startUp();
+		TransformManager::startUp();
+		CoreSceneManager::startUp();
+	}
+
+	void SceneObjectPrototypeTestSuite::shutDown()
+	{
+		CoreSceneManager::shutDown();
+		TransformManager::shutDown();
+		GameObjectManager::shutDown();
+
+		MemStack::endThread();
+	}
+
+	void SceneObjectPrototypeTestSuite::testMatchesClone()
+	{
+		HSceneObject external = SceneObject::create("External");
+		HSceneObject original = createTestHierarchy(external);
+
+		HSceneObject clone = original->clone();
+
+		SceneObjectPrototype prototype(original);
+		HSceneObject instance = prototype.instantiate();
+
+		BS_TEST_ASSERT_MSG(compareHierarchy(original, clone), "Cloned hierarchy doesn't match the original.");
+		BS_TEST_ASSERT_MSG(compareHierarchy(clone, instance), "Instantiated hierarchy doesn't match the cloned one.");
+		BS_TEST_ASSERT(!GameObjectManager::instance().isGameObjectDeserializationActive());
+
+		// Prototype is a snapshot, so changing or destroying the source must not affect new instances
+		GameObjectHandle<PrototypeTestComponent> rootComponent = original->getComponent<PrototypeTestComponent>();
+		rootComponent->value = 1000;
+		rootComponent->names.clear();
+		original->destroy();
+
+		HSceneObject laterInstance = prototype.instantiate();
+		BS_TEST_ASSERT_MSG(compareHierarchy(clone, laterInstance), "Prototype changed after its source was destroyed.");
+
+		clone->destroy();
+		instance->destroy();
+		laterInstance->destroy();
+		external->destroy();
+	}
+
+	void SceneObjectPrototypeTestSuite::testMultipleInstances()
+	{
+		static const UINT32 NUM_INSTANCES = 5;
+
+		HSceneObject external = SceneObject::create("External");
+		HSceneObject original = createTestHierarchy(external);
+
+		HSceneObject clone = original->clone();
+		SceneObjectPrototype prototype(original);
+
+		Vector<HSceneObject> instances;
+		prototype.instantiate(NUM_INSTANCES, instances);
+
+		BS_TEST_ASSERT(instances.size() == NUM_INSTANCES);
+		for(UINT32 i = 0; i < (UINT32)instances.size(); i++)
+		{
+			BS_TEST_ASSERT_MSG(compareHierarchy(clone, instances[i]), "Instance " + toString(i) + " doesn't match the cloned hierarchy.");
+
+			for(UINT32 j = 0; j < i; j++)
+				BS_TEST_ASSERT(instances[i]->getInstanceId() != instances[j]->getInstanceId());
+		}
+
+		BS_TEST_ASSERT(!GameObjectManager::instance().isGameObjectDeserializationActive());
+
+		for(auto& instance : instances)
+			instance->destroy();
+
+		original->destroy();
+		clone->destroy();
+		external->destroy();
+	}
+
+	void SceneObjectPrototypeTestSuite::testFailedInstantiate()
+	{
+		HSceneObject external = SceneObject::create("External");
+		HSceneObject original = createTestHierarchy(external);
+
+		SceneObjectPrototype prototype(original);
+
+		bool caughtException = false;
+		PrototypeTestComponent::sThrowOnAssign = true;
+		try
+		{
+			prototype.instantiate();
+		}
+		catch(const InternalErrorException&)
+		{
+			caughtException = true;
+		}
+		PrototypeTestComponent::sThrowOnAssign = false;
+
+		BS_TEST_ASSERT(caughtException);
+		BS_TEST_ASSERT_MSG(!GameObjectManager::instance().isGameObjectDeserializationActive(),
+			"Game object deserialization still active after a failed instantiation.");
+
+		// Both instantiation and regular deserialization must still work
+		HSceneObject instance = prototype.instantiate();
+		HSceneObject clone = original->clone();
+
+		BS_TEST_ASSERT(compareHierarchy(clone, instance));
+
+		instance->destroy();
+		clone->destroy();
+		original->destroy();
+		external->destroy();
+	}
+}
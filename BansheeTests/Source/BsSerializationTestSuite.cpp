@@ -0,0 +1,606 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsSerializationTestSuite.h"
+#include "BsIReflectable.h"
+#include "BsRTTIType.h"
+#include "BsBinarySerializer.h"
+#include "BsDataStream.h"
+#include "BsTimer.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Plain structure serialized by copying its memory.
+	 */
+	struct SerializationTestElement
+	{
+		UINT32 id;
+		float weight;
+		float position[3];
+
+		bool operator==(const SerializationTestElement& rhs) const
+		{
+			return memcmp(this, &rhs, sizeof(*this)) == 0;
+		}
+	};
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(SerializationTestElement);
+
+	/**
+	 * @brief	Object referenced through pointers from SerializationTestObject.
+	 */
+	class SerializationTestChild : public IReflectable
+	{
+	public:
+		SerializationTestChild()
+			:id(0), weight(0.0f)
+		{ }
+
+		UINT32 id;
+		float weight;
+		String name;
+		Vector<SerializationTestElement> elements;
+
+		static RTTITypeBase* getRTTIStatic();
+		virtual RTTITypeBase* getRTTI() const;
+	};
+
+	class SerializationTestChildRTTI : public RTTIType<SerializationTestChild, IReflectable, SerializationTestChildRTTI>
+	{
+	private:
+		UINT32& getId(SerializationTestChild* obj) { return obj->id; }
+		void setId(SerializationTestChild* obj, UINT32& value) { obj->id = value; }
+
+		float& getWeight(SerializationTestChild* obj) { return obj->weight; }
+		void setWeight(SerializationTestChild* obj, float& value) { obj->weight = value; }
+
+		String& getName(SerializationTestChild* obj) { return obj->name; }
+		void setName(SerializationTestChild* obj, String& value) { obj->name = value; }
+
+		SerializationTestElement& getElement(SerializationTestChild* obj, UINT32 idx) { return obj->elements[idx]; }
+		void setElement(SerializationTestChild* obj, UINT32 idx, SerializationTestElement& value) { obj->elements[idx] = value; }
+		UINT32 getNumElements(SerializationTestChild* obj) { return (UINT32)obj->elements.size(); }
+		void setNumElements(SerializationTestChild* obj, UINT32 size) { obj->elements.resize(size); }
+
+	public:
+		SerializationTestChildRTTI()
+		{
+			addPlainField("id", 0, &SerializationTestChildRTTI::getId, &SerializationTestChildRTTI::setId);
+			addPlainField("weight", 1, &SerializationTestChildRTTI::getWeight, &SerializationTestChildRTTI::setWeight);
+			addPlainField("name", 2, &SerializationTestChildRTTI::getName, &SerializationTestChildRTTI::setName);
+			addPlainArrayField("elements", 3, &SerializationTestChildRTTI::getElement, &SerializationTestChildRTTI::getNumElements, 
+				&SerializationTestChildRTTI::setElement, &SerializationTestChildRTTI::setNumElements);
+		}
+
+		virtual const String& getRTTIName()
+		{
+			static String name = "SerializationTestChild";
+			return name;
+		}
+
+		virtual UINT32 getRTTIId()
+		{
+			return TID_SerializationTestChild;
+		}
+
+		virtual std::shared_ptr<IReflectable> newRTTIObject()
+		{
+			return bs_shared_ptr<SerializationTestChild>();
+		}
+	};
+
+	RTTITypeBase* SerializationTestChild::getRTTIStatic()
+	{
+		return SerializationTestChildRTTI::instance();
+	}
+
+	RTTITypeBase* SerializationTestChild::getRTTI() const
+	{
+		return SerializationTestChild::getRTTIStatic();
+	}
+
+	/**
+	 * @brief	Object containing every kind of field handled differently by the serializer schema: runs of
+	 *			fixed size plain fields, dynamically sized plain fields, plain arrays of fixed and dynamic size, 
+	 *			and reflectable pointers that may be shared or null.
+	 */
+	class SerializationTestObject : public IReflectable
+	{
+	public:
+		SerializationTestObject()
+			:intValue(0), floatValue(0.0f), boolValue(false), longValue(0), valueAfterString(0)
+		{ }
+
+		INT32 intValue;
+		float floatValue;
+		bool boolValue;
+		UINT64 longValue;
+		String name;
+		UINT32 valueAfterString;
+
+		Vector<UINT32> indices;
+		Vector<String> names;
+		Vector<SerializationTestElement> elements;
+
+		std::shared_ptr<SerializationTestChild> child;
+		std::shared_ptr<SerializationTestChild> sharedChild;
+		std::shared_ptr<SerializationTestChild> nullChild;
+		Vector<std::shared_ptr<SerializationTestChild>> children;
+
+		static RTTITypeBase* getRTTIStatic();
+		virtual RTTITypeBase* getRTTI() const;
+	};
+
+	class SerializationTestObjectRTTI : public RTTIType<SerializationTestObject, IReflectable, SerializationTestObjectRTTI>
+	{
+	private:
+		INT32& getIntValue(SerializationTestObject* obj) { return obj->intValue; }
+		void setIntValue(SerializationTestObject* obj, INT32& value) { obj->intValue = value; }
+
+		float& getFloatValue(SerializationTestObject* obj) { return obj->floatValue; }
+		void setFloatValue(SerializationTestObject* obj, float& value) { obj->floatValue = value; }
+
+		bool& getBoolValue(SerializationTestObject* obj) { return obj->boolValue; }
+		void setBoolValue(SerializationTestObject* obj, bool& value) { obj->boolValue = value; }
+
+		UINT64& getLongValue(SerializationTestObject* obj) { return obj->longValue; }
+		void setLongValue(SerializationTestObject* obj, UINT64& value) { obj->longValue = value; }
+
+		String& getName(SerializationTestObject* obj) { return obj->name; }
+		void setName(SerializationTestObject* obj, String& value) { obj->name = value; }
+
+		UINT32& getValueAfterString(SerializationTestObject* obj) { return obj->valueAfterString; }
+		void setValueAfterString(SerializationTestObject* obj, UINT32& value) { obj->valueAfterString = value; }
+
+		UINT32& getIndex(SerializationTestObject* obj, UINT32 idx) { return obj->indices[idx]; }
+		void setIndex(SerializationTestObject* obj, UINT32 idx, UINT32& value) { obj->indices[idx] = value; }
+		UINT32 getNumIndices(SerializationTestObject* obj) { return (UINT32)obj->indices.size(); }
+		void setNumIndices(SerializationTestObject* obj, UINT32 size) { obj->indices.resize(size); }
+
+		String& getArrayName(SerializationTestObject* obj, UINT32 idx) { return obj->names[idx]; }
+		void setArrayName(SerializationTestObject* obj, UINT32 idx, String& value) { obj->names[idx] = value; }
+		UINT32 getNumNames(SerializationTestObject* obj) { return (UINT32)obj->names.size(); }
+		void setNumNames(SerializationTestObject* obj, UINT32 size) { obj->names.resize(size); }
+
+		SerializationTestElement& getElement(SerializationTestObject* obj, UINT32 idx) { return obj->elements[idx]; }
+		void setElement(SerializationTestObject* obj, UINT32 idx, SerializationTestElement& value) { obj->elements[idx] = value; }
+		UINT32 getNumElements(SerializationTestObject* obj) { return (UINT32)obj->elements.size(); }
+		void setNumElements(SerializationTestObject* obj, UINT32 size) { obj->elements.resize(size); }
+
+		std::shared_ptr<SerializationTestChild> getChild(SerializationTestObject* obj) { return obj->child; }
+		void setChild(SerializationTestObject* obj, std::shared_ptr<SerializationTestChild> value) { obj->child = value; }
+
+		std::shared_ptr<SerializationTestChild> getSharedChild(SerializationTestObject* obj) { return obj->sharedChild; }
+		void setSharedChild(SerializationTestObject* obj, std::shared_ptr<SerializationTestChild> value) { obj->sharedChild = value; }
+
+		std::shared_ptr<SerializationTestChild> getNullChild(SerializationTestObject* obj) { return obj->nullChild; }
+		void setNullChild(SerializationTestObject* obj, std::shared_ptr<SerializationTestChild> value) { obj->nullChild = value; }
+
+		std::shared_ptr<SerializationTestChild> getArrayChild(SerializationTestObject* obj, UINT32 idx) { return obj->children[idx]; }
+		void setArrayChild(SerializationTestObject* obj, UINT32 idx, std::shared_ptr<SerializationTestChild> value) { obj->children[idx] = value; }
+		UINT32 getNumChildren(SerializationTestObject* obj) { return (UINT32)obj->children.size(); }
+		void setNumChildren(SerializationTestObject* obj, UINT32 size) { obj->children.resize(size); }
+
+	public:
+		SerializationTestObjectRTTI()
+		{
+			addPlainField("intValue", 0, &SerializationTestObjectRTTI::getIntValue, &SerializationTestObjectRTTI::setIntValue);
+			addPlainField("floatValue", 1, &SerializationTestObjectRTTI::getFloatValue, &SerializationTestObjectRTTI::setFloatValue);
+			addPlainField("longValue", 3, &SerializationTestObjectRTTI::getLongValue, &SerializationTestObjectRTTI::setLongValue);
+			addPlainField("boolValue", 4, &SerializationTestObjectRTTI::getBoolValue, &SerializationTestObjectRTTI::setBoolValue);
+			addPlainField("name", 5, &SerializationTestObjectRTTI::getName, &SerializationTestObjectRTTI::setName);
+			addPlainField("valueAfterString", 6, &SerializationTestObjectRTTI::getValueAfterString, &SerializationTestObjectRTTI::setValueAfterString);
+
+			addPlainArrayField("indices", 7, &SerializationTestObjectRTTI::getIndex, &SerializationTestObjectRTTI::getNumIndices, 
+				&SerializationTestObjectRTTI::setIndex, &SerializationTestObjectRTTI::setNumIndices);
+			addPlainArrayField("names", 8, &SerializationTestObjectRTTI::getArrayName, &SerializationTestObjectRTTI::getNumNames, 
+				&SerializationTestObjectRTTI::setArrayName, &SerializationTestObjectRTTI::setNumNames);
+			addPlainArrayField("elements", 9, &SerializationTestObjectRTTI::getElement, &SerializationTestObjectRTTI::getNumElements, 
+				&SerializationTestObjectRTTI::setElement, &SerializationTestObjectRTTI::setNumElements);
+
+			addReflectablePtrField("child", 10, &SerializationTestObjectRTTI::getChild, &SerializationTestObjectRTTI::setChild);
+			addReflectablePtrField("sharedChild", 11, &SerializationTestObjectRTTI::getSharedChild, &SerializationTestObjectRTTI::setSharedChild);
+			addReflectablePtrField("nullChild", 12, &SerializationTestObjectRTTI::getNullChild, &SerializationTestObjectRTTI::setNullChild);
+			addReflectablePtrArrayField("children", 13, &SerializationTestObjectRTTI::getArrayChild, &SerializationTestObjectRTTI::getNumChildren, 
+				&SerializationTestObjectRTTI::setArrayChild, &SerializationTestObjectRTTI::setNumChildren);
+		}
+
+		virtual const String& getRTTIName()
+		{
+			static String name = "SerializationTestObject";
+			return name;
+		}
+
+		virtual UINT32 getRTTIId()
+		{
+			return TID_SerializationTestObject;
+		}
+
+		virtual std::shared_ptr<IReflectable> newRTTIObject()
+		{
+			return bs_shared_ptr<SerializationTestObject>();
+		}
+	};
+
+	RTTITypeBase* SerializationTestObject::getRTTIStatic()
+	{
+		return SerializationTestObjectRTTI::instance();
+	}
+
+	RTTITypeBase* SerializationTestObject::getRTTI() const
+	{
+		return SerializationTestObject::getRTTIStatic();
+	}
+
+	/**
+	 * @brief	Older version of SerializationTestObject, with a field in the middle of its first plain 
+	 *			run that no longer exists, and without some of the fields that were added later.
+	 */
+	class SerializationTestLegacyObject : public IReflectable
+	{
+	public:
+		SerializationTestLegacyObject()
+			:intValue(0), floatValue(0.0f), removedValue(0), longValue(0)
+		{ }
+
+		INT32 intValue;
+		float floatValue;
+		UINT32 removedValue;
+		UINT64 longValue;
+		String name;
+
+		static RTTITypeBase* getRTTIStatic();
+		virtual RTTITypeBase* getRTTI() const;
+	};
+
+	class SerializationTestLegacyObjectRTTI : public RTTIType<SerializationTestLegacyObject, IReflectable, SerializationTestLegacyObjectRTTI>
+	{
+	private:
+		INT32& getIntValue(SerializationTestLegacyObject* obj) { return obj->intValue; }
+		void setIntValue(SerializationTestLegacyObject* obj, INT32& value) { obj->intValue = value; }
+
+		float& getFloatValue(SerializationTestLegacyObject* obj) { return obj->floatValue; }
+		void setFloatValue(SerializationTestLegacyObject* obj, float& value) { obj->floatValue = value; }
+
+		UINT32& getRemovedValue(SerializationTestLegacyObject* obj) { return obj->removedValue; }
+		void setRemovedValue(SerializationTestLegacyObject* obj, UINT32& value) { obj->removedValue = value; }
+
+		UINT64& getLongValue(SerializationTestLegacyObject* obj) { return obj->longValue; }
+		void setLongValue(SerializationTestLegacyObject* obj, UINT64& value) { obj->longValue = value; }
+
+		String& getName(SerializationTestLegacyObject* obj) { return obj->name; }
+		void setName(SerializationTestLegacyObject* obj, String& value) { obj->name = value; }
+
+	public:
+		SerializationTestLegacyObjectRTTI()
+		{
+			addPlainField("intValue", 0, &SerializationTestLegacyObjectRTTI::getIntValue, &SerializationTestLegacyObjectRTTI::setIntValue);
+			addPlainField("floatValue", 1, &SerializationTestLegacyObjectRTTI::getFloatValue, &SerializationTestLegacyObjectRTTI::setFloatValue);
+			addPlainField("removedValue", 2, &SerializationTestLegacyObjectRTTI::getRemovedValue, &SerializationTestLegacyObjectRTTI::setRemovedValue);
+			addPlainField("longValue", 3, &SerializationTestLegacyObjectRTTI::getLongValue, &SerializationTestLegacyObjectRTTI::setLongValue);
+			addPlainField("name", 5, &SerializationTestLegacyObjectRTTI::getName, &SerializationTestLegacyObjectRTTI::setName);
+		}
+
+		virtual const String& getRTTIName()
+		{
+			static String name = "SerializationTestLegacyObject";
+			return name;
+		}
+
+		virtual UINT32 getRTTIId()
+		{
+			return TID_SerializationTestLegacyObject;
+		}
+
+		virtual std::shared_ptr<IReflectable> newRTTIObject()
+		{
+			return bs_shared_ptr<SerializationTestLegacyObject>();
+		}
+	};
+
+	RTTITypeBase* SerializationTestLegacyObject::getRTTIStatic()
+	{
+		return SerializationTestLegacyObjectRTTI::instance();
+	}
+
+	RTTITypeBase* SerializationTestLegacyObject::getRTTI() const
+	{
+		return SerializationTestLegacyObject::getRTTIStatic();
+	}
+
+	/**
+	 * @brief	Encodes the object using a buffer of the provided size, flushing each filled buffer
+	 *			into the returned data.
+	 */
+	static Vector<UINT8> encodeObject(IReflectable* object, UINT32 bufferSize)
+	{
+		Vector<UINT8> output;
+		Vector<UINT8> buffer(bufferSize);
+
+		BinarySerializer serializer;
+		int bytesWritten = 0;
+		serializer.encode(object, buffer.data(), bufferSize, &bytesWritten, 
+			[&](UINT8* data, int numBytes, UINT32& newBufferSize)
+		{
+			output.insert(output.end(), data, data + numBytes);
+
+			newBufferSize = bufferSize;
+			return buffer.data();
+		});
+
+		return output;
+	}
+
+	/**
+	 * @brief	Decodes an object of the specified type from the provided data.
+	 */
+	template<class T>
+	static std::shared_ptr<T> decodeObject(Vector<UINT8>& data)
+	{
+		BinarySerializer serializer;
+		std::shared_ptr<IReflectable> object = serializer.decode(data.data(), (UINT32)data.size());
+
+		if (object == nullptr || object->getRTTI()->getRTTIId() != T::getRTTIStatic()->getRTTIId())
+			return nullptr;
+
+		return std::static_pointer_cast<T>(object);
+	}
+
+	/**
+	 * @brief	Creates an array of elements with values derived from the seed.
+	 */
+	static Vector<SerializationTestElement> createElements(UINT32 seed, UINT32 numElements)
+	{
+		Vector<SerializationTestElement> elements(numElements);
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			elements[i].id = seed + i;
+			elements[i].weight = i * 0.25f;
+			elements[i].position[0] = (float)i;
+			elements[i].position[1] = (float)seed;
+			elements[i].position[2] = -(float)i;
+		}
+
+		return elements;
+	}
+
+	/**
+	 * @brief	Creates a child object with all of its fields set to values derived from the seed.
+	 */
+	static std::shared_ptr<SerializationTestChild> createTestChild(UINT32 seed, UINT32 numElements)
+	{
+		std::shared_ptr<SerializationTestChild> child = bs_shared_ptr<SerializationTestChild>();
+		child->id = seed;
+		child->weight = seed * 0.75f;
+		child->name = "Child " + toString(seed);
+		child->elements = createElements(seed, numElements);
+
+		return child;
+	}
+
+	/**
+	 * @brief	Creates a root object with all of its fields set, including every kind of pointer field.
+	 */
+	static std::shared_ptr<SerializationTestObject> createTestObject(UINT32 numChildren, UINT32 numElements)
+	{
+		std::shared_ptr<SerializationTestObject> object = bs_shared_ptr<SerializationTestObject>();
+		object->intValue = -3;
+		object->floatValue = 0.5f;
+		object->boolValue = true;
+		object->longValue = 0x123456789ULL;
+		object->name = "Root object";
+		object->valueAfterString = 7;
+		object->elements = createElements(1, numElements);
+
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			object->indices.push_back(i * 3);
+			object->names.push_back(String(i % 20, 'a' + (char)(i % 26)));
+		}
+
+		object->child = createTestChild(2, numElements);
+		object->sharedChild = object->child;
+
+		for (UINT32 i = 0; i < numChildren; i++)
+			object->children.push_back(createTestChild(100 + i, i % 8));
+
+		// Same object referenced from multiple places, and a null array entry
+		if (numChildren > 2)
+		{
+			object->children[1] = object->child;
+			object->children[2] = nullptr;
+		}
+
+		return object;
+	}
+
+	/**
+	 * @brief	Compares all fields of two child objects.
+	 */
+	static bool compareChild(const std::shared_ptr<SerializationTestChild>& a, const std::shared_ptr<SerializationTestChild>& b)
+	{
+		if (a == nullptr || b == nullptr)
+			return a == b;
+
+		return a->id == b->id && a->weight == b->weight && a->name == b->name && a->elements == b->elements;
+	}
+
+	/**
+	 * @brief	Compares all plain fields and arrays of two root objects, ignoring pointer fields.
+	 */
+	static bool compareValues(const SerializationTestObject& a, const SerializationTestObject& b)
+	{
+		return a.intValue == b.intValue && a.floatValue == b.floatValue && a.boolValue == b.boolValue &&
+			a.longValue == b.longValue && a.name == b.name && a.valueAfterString == b.valueAfterString &&
+			a.indices == b.indices && a.names == b.names && a.elements == b.elements;
+	}
+
+	/**
+	 * @brief	Checks that a decoded object created with ::createTestObject matches the original, 
+	 *			including the pointer fields.
+	 */
+	static bool compareObject(const SerializationTestObject& original, const SerializationTestObject& decoded)
+	{
+		if (!compareValues(original, decoded))
+			return false;
+
+		if (decoded.child == nullptr || !compareChild(original.child, decoded.child))
+			return false;
+
+		if (decoded.sharedChild != decoded.child || decoded.nullChild != nullptr)
+			return false;
+
+		if (original.children.size() != decoded.children.size())
+			return false;
+
+		for (UINT32 i = 0; i < (UINT32)original.children.size(); i++)
+		{
+			if (!compareChild(original.children[i], decoded.children[i]))
+				return false;
+		}
+
+		if (original.children.size() > 2 && decoded.children[1] != decoded.child)
+			return false;
+
+		return true;
+	}
+
+	SerializationTestSuite::SerializationTestSuite()
+	{
+		BS_ADD_TEST(SerializationTestSuite::testRoundTrip);
+		BS_ADD_TEST(SerializationTestSuite::testSmallBuffer);
+		BS_ADD_TEST(SerializationTestSuite::testStreamDecode);
+		BS_ADD_TEST(SerializationTestSuite::testChangedFields);
+		BS_ADD_TEST(SerializationTestSuite::benchmarkSerialization);
+	}
+
+	void SerializationTestSuite::testRoundTrip()
+	{
+		std::shared_ptr<SerializationTestObject> original = createTestObject(20, 50);
+
+		Vector<UINT8> data = encodeObject(original.get(), 4096);
+		std::shared_ptr<SerializationTestObject> decoded = decodeObject<SerializationTestObject>(data);
+
+		BS_TEST_ASSERT(decoded != nullptr);
+		if (decoded != nullptr)
+		{
+			BS_TEST_ASSERT_MSG(compareObject(*original, *decoded), "Decoded object doesn't match the original.");
+
+			// Encoding the decoded object must produce the same data
+			BS_TEST_ASSERT(encodeObject(decoded.get(), 4096) == data);
+		}
+
+		// Empty arrays and default values
+		std::shared_ptr<SerializationTestObject> empty = bs_shared_ptr<SerializationTestObject>();
+		Vector<UINT8> emptyData = encodeObject(empty.get(), 4096);
+		std::shared_ptr<SerializationTestObject> emptyDecoded = decodeObject<SerializationTestObject>(emptyData);
+
+		BS_TEST_ASSERT(emptyDecoded != nullptr && compareValues(*empty, *emptyDecoded) && emptyDecoded->child == nullptr);
+	}
+
+	void SerializationTestSuite::testSmallBuffer()
+	{
+		std::shared_ptr<SerializationTestObject> original = createTestObject(20, 50);
+		Vector<UINT8> referenceData = encodeObject(original.get(), 64 * 1024);
+
+		// Buffers smaller than a plain run must fall back to writing fields one by one, and array
+		// batches must be split across buffers, while still producing the same data
+		UINT32 bufferSizes[] = { 32, 33, 40, 57, 64, 100, 1000 };
+		for (auto& bufferSize : bufferSizes)
+		{
+			Vector<UINT8> data = encodeObject(original.get(), bufferSize);
+			BS_TEST_ASSERT_MSG(data == referenceData, "Encoded data differs with buffer size: " + toString(bufferSize));
+		}
+
+		std::shared_ptr<SerializationTestObject> decoded = decodeObject<SerializationTestObject>(referenceData);
+		BS_TEST_ASSERT(decoded != nullptr && compareObject(*original, *decoded));
+	}
+
+	void SerializationTestSuite::testStreamDecode()
+	{
+		// Enough data to require multiple chunks when decoding from a stream
+		std::shared_ptr<SerializationTestObject> original = createTestObject(500, 2000);
+		Vector<UINT8> data = encodeObject(original.get(), 4096);
+
+		DataStreamPtr stream = bs_shared_ptr<MemoryDataStream, PoolAlloc>(data.data(), data.size(), false);
+
+		BinarySerializer serializer;
+		std::shared_ptr<IReflectable> object = serializer.decode(stream);
+
+		BS_TEST_ASSERT(object != nullptr && object->getRTTI()->getRTTIId() == TID_SerializationTestObject);
+		if (object != nullptr && object->getRTTI()->getRTTIId() == TID_SerializationTestObject)
+		{
+			std::shared_ptr<SerializationTestObject> decoded = std::static_pointer_cast<SerializationTestObject>(object);
+			BS_TEST_ASSERT_MSG(compareObject(*original, *decoded), "Object decoded from a stream doesn't match the original.");
+		}
+	}
+
+	void SerializationTestSuite::testChangedFields()
+	{
+		SerializationTestLegacyObject legacy;
+		legacy.intValue = -42;
+		legacy.floatValue = 3.5f;
+		legacy.removedValue = 0xDEADBEEF;
+		legacy.longValue = 0xABCDEF0123ULL;
+		legacy.name = "Legacy";
+
+		Vector<UINT8> data = encodeObject(&legacy, 4096);
+
+		// Pretend the data was written by an older version of the current type, by replacing 
+		// the type ID that follows the object ID in the root object meta-data
+		UINT32 typeId = TID_SerializationTestObject;
+		memcpy(&data[sizeof(UINT32)], &typeId, sizeof(typeId));
+
+		// Layout of the first plain run doesn't match the new type, so the decoder must fall back to per field
+		// decoding, skipping the removed field and leaving the new ones at defaults
+		std::shared_ptr<SerializationTestObject> decoded = decodeObject<SerializationTestObject>(data);
+
+		BS_TEST_ASSERT(decoded != nullptr);
+		if (decoded != nullptr)
+		{
+			BS_TEST_ASSERT(decoded->intValue == legacy.intValue);
+			BS_TEST_ASSERT(decoded->floatValue == legacy.floatValue);
+			BS_TEST_ASSERT(decoded->longValue == legacy.longValue);
+			BS_TEST_ASSERT(decoded->name == legacy.name);
+			BS_TEST_ASSERT(decoded->boolValue == false);
+			BS_TEST_ASSERT(decoded->valueAfterString == 0);
+			BS_TEST_ASSERT(decoded->indices.empty());
+		}
+	}
+
+	void SerializationTestSuite::benchmarkSerialization()
+	{
+		static const UINT32 NUM_ITERATIONS = 10;
+
+		// Many small objects, similar to sub-meshes or vertex element descriptions
+		std::shared_ptr<SerializationTestObject> manyObjects = createTestObject(20000, 4);
+
+		// Few objects with large plain arrays, similar to mesh and animation data
+		std::shared_ptr<SerializationTestObject> largeArrays = createTestObject(4, 200000);
+
+		auto benchmark = [&](const String& name, const std::shared_ptr<SerializationTestObject>& object)
+		{
+			Vector<UINT8> data;
+
+			Timer timer;
+			for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				data = encodeObject(object.get(), 64 * 1024);
+
+			reportTiming("Encode " + name + " (" + toString((UINT32)data.size()) + " bytes)", timer.getMicroseconds() / 1000.0 / NUM_ITERATIONS);
+
+			std::shared_ptr<SerializationTestObject> decoded;
+
+			timer.reset();
+			for (UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				decoded = decodeObject<SerializationTestObject>(data);
+
+			reportTiming("Decode " + name, timer.getMicroseconds() / 1000.0 / NUM_ITERATIONS);
+
+			BS_TEST_ASSERT(decoded != nullptr && compareObject(*object, *decoded));
+		};
+
+		benchmark("many small objects", manyObjects);
+		benchmark("large plain arrays", largeArrays);
+	}
+}
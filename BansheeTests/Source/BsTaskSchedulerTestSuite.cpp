@@ -0,0 +1,205 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsTaskSchedulerTestSuite.h"
+#include "BsTaskScheduler.h"
+#include "BsTaskGroup.h"
+#include "BsThreadPool.h"
+#include "BsTimer.h"
+#include "BsMath.h"
+
+namespace BansheeEngine
+{
+	TaskSchedulerTestSuite::TaskSchedulerTestSuite()
+	{
+		BS_ADD_TEST(TaskSchedulerTestSuite::testDependencies);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testCancel);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testTaskGroup);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testParallelForRange);
+		BS_ADD_TEST(TaskSchedulerTestSuite::testNestedParallelFor);
+		BS_ADD_TEST(TaskSchedulerTestSuite::benchmarkParallelFor);
+	}
+
+	void TaskSchedulerTestSuite::startUp()
+	{
+		UINT32 numThreads = BS_THREAD_HARDWARE_CONCURRENCY;
+		ThreadPool::startUp<TThreadPool<>>(numThreads, std::max(numThreads + 1, 16U));
+		TaskScheduler::startUp();
+	}
+
+	void TaskSchedulerTestSuite::shutDown()
+	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+
+	void TaskSchedulerTestSuite::testDependencies()
+	{
+		static const UINT32 NUM_TASKS = 1000;
+
+		for (UINT32 iter = 0; iter < 20; iter++)
+		{
+			std::atomic<UINT32> numExecuted(0);
+			std::atomic<UINT32> numExecutedBeforeJoin(0);
+
+			Vector<TaskPtr> tasks;
+			for (UINT32 i = 0; i < NUM_TASKS; i++)
+			{
+				TaskPriority priority = (TaskPriority)((UINT32)TaskPriority::VeryLow + i % 5);
+				tasks.push_back(Task::create("Test", [&]() { numExecuted++; }, priority));
+			}
+
+			TaskPtr join = Task::create("Join", [&]() { numExecutedBeforeJoin = numExecuted.load(); }, 
+				TaskPriority::Normal, tasks);
+
+			// Dependent task is queued first, so it must wait for the dependencies queued after it
+			TaskScheduler::instance().addTask(join);
+			for (auto& task : tasks)
+				TaskScheduler::instance().addTask(task);
+
+			join->wait();
+
+			BS_TEST_ASSERT(join->isComplete());
+			BS_TEST_ASSERT(numExecutedBeforeJoin == NUM_TASKS);
+		}
+	}
+
+	void TaskSchedulerTestSuite::testCancel()
+	{
+		bool canceledExecuted = false;
+		bool dependentExecuted = false;
+
+		TaskPtr canceled = Task::create("Canceled", [&]() { canceledExecuted = true; });
+		TaskPtr dependent = Task::create("Dependent", [&]() { dependentExecuted = true; }, TaskPriority::Normal, canceled);
+
+		TaskScheduler::instance().addTask(dependent);
+		canceled->cancel();
+		TaskScheduler::instance().addTask(canceled);
+
+		dependent->wait();
+
+		BS_TEST_ASSERT(canceled->isCanceled());
+		BS_TEST_ASSERT(!canceledExecuted);
+		BS_TEST_ASSERT_MSG(dependentExecuted, "Canceled dependency must not block its dependents.");
+	}
+
+	void TaskSchedulerTestSuite::testTaskGroup()
+	{
+		static const UINT32 NUM_TASKS = 1000;
+
+		std::atomic<UINT32> numExecuted(0);
+
+		{
+			TaskGroup group;
+			for (UINT32 i = 0; i < NUM_TASKS; i++)
+				group.spawn([&]() { numExecuted++; });
+
+			group.wait();
+			BS_TEST_ASSERT(numExecuted == NUM_TASKS);
+
+			// Group must be reusable after a wait
+			for (UINT32 i = 0; i < NUM_TASKS; i++)
+				group.spawn([&]() { numExecuted++; });
+		}
+
+		BS_TEST_ASSERT_MSG(numExecuted == NUM_TASKS * 2, "Group must wait for its tasks when destroyed.");
+	}
+
+	void TaskSchedulerTestSuite::testParallelForRange()
+	{
+		static const UINT32 NUM_ELEMENTS = 10000;
+		UINT32 grainSizes[] = { 0, 1, 7, 256, NUM_ELEMENTS, NUM_ELEMENTS * 2 };
+
+		Vector<std::atomic<UINT32>> visits(NUM_ELEMENTS);
+		for (auto& grainSize : grainSizes)
+		{
+			for (auto& entry : visits)
+				entry = 0;
+
+			parallelFor(0, NUM_ELEMENTS, grainSize, [&](UINT32 idx) { visits[idx]++; });
+
+			bool allVisitedOnce = true;
+			for (auto& entry : visits)
+				allVisitedOnce &= entry == 1;
+
+			BS_TEST_ASSERT_MSG(allVisitedOnce, "Every index must be visited exactly once, grain size: " + toString(grainSize));
+		}
+
+		// Offset range must not touch indexes outside of it
+		for (auto& entry : visits)
+			entry = 0;
+
+		parallelFor(100, 200, 3, [&](UINT32 idx) { visits[idx]++; });
+
+		bool onlyRangeVisited = true;
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			onlyRangeVisited &= visits[i] == ((i >= 100 && i < 200) ? 1U : 0U);
+
+		BS_TEST_ASSERT(onlyRangeVisited);
+
+		// Empty ranges
+		std::atomic<UINT32> numCalls(0);
+		parallelFor(10, 10, 0, [&](UINT32 idx) { numCalls++; });
+		parallelFor(10, 5, 0, [&](UINT32 idx) { numCalls++; });
+
+		BS_TEST_ASSERT(numCalls == 0);
+	}
+
+	void TaskSchedulerTestSuite::testNestedParallelFor()
+	{
+		static const UINT32 NUM_OUTER = 64;
+		static const UINT32 NUM_INNER = 1000;
+
+		// Outer iterations block waiting on inner ones from within worker threads, so this
+		// checks that waiting workers keep executing tasks instead of deadlocking
+		std::atomic<UINT32> numExecuted(0);
+		parallelFor(0, NUM_OUTER, 1, [&](UINT32 i)
+		{
+			parallelFor(0, NUM_INNER, 16, [&](UINT32 j) { numExecuted++; });
+		});
+
+		BS_TEST_ASSERT(numExecuted == NUM_OUTER * NUM_INNER);
+	}
+
+	void TaskSchedulerTestSuite::benchmarkParallelFor()
+	{
+		// Small ranges are dominated by grain size selection and scheduling overhead, large ones by throughput.
+		// Each case performs the same total amount of work so their timings can be compared directly.
+		static const UINT32 TOTAL_ELEMENTS = 1000000;
+		UINT32 rangeSizes[] = { 1000, TOTAL_ELEMENTS };
+
+		auto work = [](float value, UINT32 idx) 
+		{ 
+			for (UINT32 i = 0; i < 16; i++)
+				value = Math::sqrt(value * 3.0f + idx);
+
+			return value;
+		};
+
+		for (auto& numElements : rangeSizes)
+		{
+			UINT32 numIterations = TOTAL_ELEMENTS / numElements;
+			String desc = toString(numElements) + " elements" + (numIterations > 1 ? " x " + toString(numIterations) : "");
+
+			Vector<float> serialData(numElements, 1.0f);
+			Vector<float> parallelData(numElements, 1.0f);
+
+			Timer timer;
+			for (UINT32 iter = 0; iter < numIterations; iter++)
+			{
+				for (UINT32 i = 0; i < numElements; i++)
+					serialData[i] = work(serialData[i], i);
+			}
+
+			reportTiming("Serial loop over " + desc, timer.getMicroseconds() / 1000.0);
+
+			timer.reset();
+			for (UINT32 iter = 0; iter < numIterations; iter++)
+				parallelFor(0, numElements, 0, [&](UINT32 idx) { parallelData[idx] = work(parallelData[idx], idx); });
+
+			reportTiming("parallelFor over " + desc, timer.getMicroseconds() / 1000.0);
+
+			BS_TEST_ASSERT(serialData == parallelData);
+		}
+	}
+}
@@ -0,0 +1,67 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsTestSuite.h"
+#include <iostream>
+
+namespace BansheeEngine
+{
+	TestSuite::TestSuite()
+		:mOutput(nullptr), mNumFailures(0)
+	{ }
+
+	UINT32 TestSuite::run(TestOutput& output)
+	{
+		mOutput = &output;
+		mNumFailures = 0;
+
+		startUp();
+
+		for (auto& testEntry : mTests)
+		{
+			mActiveTestName = testEntry.name;
+
+			(this->*(testEntry.test))();
+		}
+
+		shutDown();
+
+		mActiveTestName = "";
+		mOutput = nullptr;
+
+		return mNumFailures;
+	}
+
+	void TestSuite::addTest(Func test, const String& name)
+	{
+		mTests.push_back(TestEntry(test, name));
+	}
+
+	void TestSuite::assertment(bool success, const String& desc, const String& file, long line)
+	{
+		if (success)
+			return;
+
+		mNumFailures++;
+		mOutput->outputFail(desc, mActiveTestName, file, line);
+	}
+
+	void TestSuite::reportTiming(const String& desc, double timeMs)
+	{
+		mOutput->outputTiming(desc, mActiveTestName, timeMs);
+	}
+
+	void ConsoleTestOutput::outputFail(const String& desc, const String& function, const String& file, long line)
+	{
+		std::cout << file << "(" << line << "): Test \"" << function << "\" failed";
+		if (!desc.empty())
+			std::cout << ": " << desc;
+
+		std::cout << std::endl;
+	}
+
+	void ConsoleTestOutput::outputTiming(const String& desc, const String& function, double timeMs)
+	{
+		std::cout << function << ": " << desc << " - " << timeMs << "ms" << std::endl;
+	}
+}
@@ -0,0 +1,289 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+#include "BsAABox.h"
+#include "BsSphere.h"
+#include "BsRay.h"
+#include "BsConvexVolume.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Dynamic bounding volume hierarchy of axis aligned boxes. Each leaf holds a single
+	 *			proxy with a user provided value, and each internal node holds a box enclosing both of its children.
+	 *
+	 *			Leaves store "fat" boxes which are larger than the provided bounds by a margin. As long as the
+	 *			bounds of a proxy stay inside its fat box updating it is free, otherwise the proxy is reinserted.
+	 *			Tree is kept balanced using rotations so queries stay logarithmic as proxies move around.
+	 *
+	 *			Queries test the tree top-down and skip entire subtrees whose bounds don't overlap the query.
+	 *			Frustum queries additionally accept entire subtrees fully inside the frustum without testing them.
+	 *
+	 * @note	Queries report proxies whose fat bounds pass the test, so they can return some false positives.
+	 */
+	class BS_UTILITY_EXPORT AABBTree
+	{
+		/**
+		 * @brief	A single node in the tree. Leaf nodes have no children.
+		 */
+		struct Node
+		{
+			bool isLeaf() const { return child1 == INVALID_ID; }
+
+			AABox bounds;
+			UINT32 parent; /**< Parent node, or next free node if the node is unused. */
+			UINT32 child1;
+			UINT32 child2;
+			INT32 height; /**< Zero for leaves, -1 for unused nodes. */
+			UINT32 userData;
+		};
+
+		/**
+		 * @brief	Maximum depth of the traversal stack. Balancing keeps the tree height
+		 *			logarithmic, so this is enough for any number of proxies that fits in memory.
+		 */
+		static const UINT32 MAX_STACK_SIZE = 128;
+
+		/**
+		 * @brief	Flag set on node indices in the traversal stack, signaling the node is fully inside the query volume.
+		 */
+		static const UINT32 INSIDE_FLAG = 0x80000000;
+
+	public:
+		static const UINT32 INVALID_ID = 0xFFFFFFFF;
+
+		/**
+		 * @brief	Constructs a new empty tree.
+		 *
+		 * @param	margin	Distance by which the fat bounds of a proxy are extended in each direction. Larger values
+		 *					mean proxies need to be reinserted less often when they move, but queries return more
+		 *					false positives.
+		 */
+		AABBTree(float margin = 0.1f);
+
+		/**
+		 * @brief	Inserts a new proxy with the specified bounds and a user value that will be reported by
+		 *			queries. Returns an identifier of the proxy that remains valid until the proxy is removed.
+		 */
+		UINT32 insert(const AABox& bounds, UINT32 userData);
+
+		/**
+		 * @brief	Removes a proxy previously created with "insert".
+		 */
+		void remove(UINT32 proxyId);
+
+		/**
+		 * @brief	Updates the bounds of an existing proxy. Proxy is only reinserted if the new bounds
+		 *			leave its fat bounds, or if they became much smaller than the fat bounds.
+		 *
+		 * @return	True if the proxy was reinserted.
+		 */
+		bool update(UINT32 proxyId, const AABox& bounds);
+
+		/**
+		 * @brief	Changes the user value reported by queries for the specified proxy.
+		 */
+		void setUserData(UINT32 proxyId, UINT32 userData) { mNodes[proxyId].userData = userData; }
+
+		/**
+		 * @brief	Returns the user value of the specified proxy.
+		 */
+		UINT32 getUserData(UINT32 proxyId) const { return mNodes[proxyId].userData; }
+
+		/**
+		 * @brief	Returns the fat bounds of the specified proxy.
+		 */
+		const AABox& getFatBounds(UINT32 proxyId) const { return mNodes[proxyId].bounds; }
+
+		/**
+		 * @brief	Returns the number of proxies in the tree.
+		 */
+		UINT32 getNumProxies() const { return mNumProxies; }
+
+		/**
+		 * @brief	Returns the height of the tree. Empty tree and a tree with a single proxy have height zero.
+		 */
+		UINT32 getHeight() const { return mRoot == INVALID_ID ? 0 : (UINT32)mNodes[mRoot].height; }
+
+		/**
+		 * @brief	Removes all proxies from the tree.
+		 */
+		void clear();
+
+		/**
+		 * @brief	Finds all proxies whose bounds intersect the provided convex volume (e.g. a camera frustum).
+		 *			Subtrees whose bounds are fully inside the volume are reported without testing the
+		 *			individual proxies.
+		 *
+		 * @param	volume		Volume to test against.
+		 * @param	callback	Callable with signature void(UINT32 userData) called for every found proxy.
+		 */
+		template<class Callback>
+		void query(const ConvexVolume& volume, Callback callback) const
+		{
+			if (mRoot == INVALID_ID)
+				return;
+
+			UINT32 stack[MAX_STACK_SIZE];
+			UINT32 stackSize = 0;
+			stack[stackSize++] = mRoot;
+
+			while (stackSize > 0)
+			{
+				UINT32 entry = stack[--stackSize];
+				UINT32 nodeIdx = entry & ~INSIDE_FLAG;
+				const Node& node = mNodes[nodeIdx];
+
+				UINT32 insideFlag = entry & INSIDE_FLAG;
+				if (insideFlag == 0)
+				{
+					if (!volume.intersects(node.bounds))
+						continue;
+
+					if (volume.contains(node.bounds))
+						insideFlag = INSIDE_FLAG;
+				}
+
+				if (node.isLeaf())
+					callback(node.userData);
+				else
+				{
+					assert((stackSize + 2) <= MAX_STACK_SIZE);
+
+					stack[stackSize++] = node.child1 | insideFlag;
+					stack[stackSize++] = node.child2 | insideFlag;
+				}
+			}
+		}
+
+		/**
+		 * @brief	Finds all proxies whose bounds intersect the provided axis aligned box.
+		 *
+		 * @param	box			Box to test against.
+		 * @param	callback	Callable with signature void(UINT32 userData) called for every found proxy.
+		 */
+		template<class Callback>
+		void query(const AABox& box, Callback callback) const
+		{
+			queryInternal([&](const AABox& bounds) { return bounds.intersects(box); }, callback);
+		}
+
+		/**
+		 * @brief	Finds all proxies whose bounds intersect the provided sphere.
+		 *
+		 * @param	sphere		Sphere to test against.
+		 * @param	callback	Callable with signature void(UINT32 userData) called for every found proxy.
+		 */
+		template<class Callback>
+		void query(const Sphere& sphere, Callback callback) const
+		{
+			queryInternal([&](const AABox& bounds) { return bounds.intersects(sphere); }, callback);
+		}
+
+		/**
+		 * @brief	Finds all proxies whose bounds are hit by the provided ray, closer than the specified distance.
+		 *			Proxies are reported in no particular order.
+		 *
+		 * @param	ray			Ray to test against.
+		 * @param	maxDistance	Maximum distance along the ray at which the bounds may be hit.
+		 * @param	callback	Callable with signature void(UINT32 userData) called for every found proxy.
+		 */
+		template<class Callback>
+		void query(const Ray& ray, float maxDistance, Callback callback) const
+		{
+			queryInternal([&](const AABox& bounds)
+			{
+				std::pair<bool, float> result = bounds.intersects(ray);
+				return result.first && result.second <= maxDistance;
+			}, callback);
+		}
+
+	private:
+		/**
+		 * @brief	Reports all proxies for which the test passes for their bounds and the bounds of all their parents.
+		 */
+		template<class Test, class Callback>
+		void queryInternal(Test test, Callback& callback) const
+		{
+			if (mRoot == INVALID_ID)
+				return;
+
+			UINT32 stack[MAX_STACK_SIZE];
+			UINT32 stackSize = 0;
+			stack[stackSize++] = mRoot;
+
+			while (stackSize > 0)
+			{
+				const Node& node = mNodes[stack[--stackSize]];
+				if (!test(node.bounds))
+					continue;
+
+				if (node.isLeaf())
+					callback(node.userData);
+				else
+				{
+					assert((stackSize + 2) <= MAX_STACK_SIZE);
+
+					stack[stackSize++] = node.child1;
+					stack[stackSize++] = node.child2;
+				}
+			}
+		}
+
+		/**
+		 * @brief	Returns an unused node, allocating a new one if needed.
+		 */
+		UINT32 allocNode();
+
+		/**
+		 * @brief	Returns the node to the free list.
+		 */
+		void freeNode(UINT32 nodeIdx);
+
+		/**
+		 * @brief	Inserts an allocated leaf node into the hierarchy.
+		 */
+		void insertLeaf(UINT32 leafIdx);
+
+		/**
+		 * @brief	Removes the leaf node from the hierarchy, but doesn't free it.
+		 */
+		void removeLeaf(UINT32 leafIdx);
+
+		/**
+		 * @brief	Walks from the provided node up to the root, recalculating bounds and heights and rebalancing
+		 *			the nodes along the way.
+		 */
+		void refitUpwards(UINT32 nodeIdx);
+
+		/**
+		 * @brief	Performs a rotation at the specified node if its children heights differ by more than one.
+		 *			Returns the index of the node that now occupies its place in the hierarchy.
+		 */
+		UINT32 balance(UINT32 nodeIdx);
+
+		/**
+		 * @brief	Returns the provided bounds extended by the margin in each direction.
+		 */
+		AABox expandBounds(const AABox& bounds) const;
+
+		/**
+		 * @brief	Returns the box enclosing both of the provided boxes.
+		 */
+		static AABox merge(const AABox& a, const AABox& b);
+
+		/**
+		 * @brief	Returns half of the surface area of the box, used as the insertion cost metric.
+		 */
+		static float getCost(const AABox& box);
+
+		Vector<Node> mNodes;
+		UINT32 mRoot;
+		UINT32 mFreeList;
+		UINT32 mNumProxies;
+		float mMargin;
+	};
+}
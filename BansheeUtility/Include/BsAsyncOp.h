@@ -34,7 +34,7 @@ namespace BansheeEngine
 
 	public:
 		AsyncOp()
-			:mData(bs_shared_ptr<AsyncOpData, ScratchAlloc>())
+			:mData(bs_shared_ptr<AsyncOpData, PoolAlloc>())
 		{
 #if BS_ARCH_TYPE != BS_ARCHITECTURE_x86_32 && BS_ARCH_TYPE != BS_ARCHITECTURE_x86_64
 			static_assert(false, "You will likely need to add locks for mIsCompleted on architectures other than x86.");
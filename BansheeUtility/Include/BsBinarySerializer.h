@@ -16,8 +16,6 @@ namespace BansheeEngine
 
 	// TODO - Low priority. I will probably want to extract a generalized Serializer class so we can re-use the code
 	// in text or other serializers
-	// TODO - Low priority. Encode does a chunk-based encode so that we don't need to know the buffer size in advance,
-	// and don't have to use a lot of memory for the buffer. Consider doing something similar for decode.
 	// TODO - Low priority. Add a simple encode method that doesn't require a callback, instead it calls the callback internally
 	// and creates the buffer internally.
 	/**
@@ -67,7 +65,20 @@ namespace BansheeEngine
 		 */
 		std::shared_ptr<IReflectable> decode(UINT8* data, UINT32 dataLength);
 
+		/**
+		 * @brief	Decodes an object from binary data read from a stream, starting at the current stream position
+		 *			and ending at the end of the stream. Data is read in chunks so the entire serialized data never 
+		 *			needs to be in memory at once, and data block fields are read directly into their final buffers.
+		 *
+		 * @param 	stream	Stream to read the data from. Must support seeking.
+		 */
+		std::shared_ptr<IReflectable> decode(const DataStreamPtr& stream);
+
 	private:
+		friend class RTTISchema;
+
+		class DecodeStream;
+
 		struct ObjectToEncode
 		{
 			ObjectToEncode(UINT32 _objectId, std::shared_ptr<IReflectable> _object)
@@ -80,14 +91,13 @@ namespace BansheeEngine
 
 		struct ObjectToDecode
 		{
-			ObjectToDecode(UINT32 _objectId, std::shared_ptr<IReflectable> _object, UINT8* _locationInBuffer, UINT32 _locationInFile)
-				:objectId(_objectId), object(_object), locationInBuffer(_locationInBuffer), locationInFile(_locationInFile), isDecoded(false)
+			ObjectToDecode(UINT32 _objectId, std::shared_ptr<IReflectable> _object, UINT64 _locationInFile)
+				:objectId(_objectId), object(_object), locationInFile(_locationInFile), isDecoded(false)
 			{ }
 
 			UINT32 objectId;
 			std::shared_ptr<IReflectable> object;
-			UINT8* locationInBuffer;
-			UINT32 locationInFile;
+			UINT64 locationInFile;
 			bool isDecoded;
 		};
 
@@ -102,7 +112,8 @@ namespace BansheeEngine
 		Vector<ObjectToEncode> mObjectsToEncode;
 		int mTotalBytesWritten;
 
-		Map<UINT32, ObjectToDecode> mObjectMap;
+		Vector<ObjectToDecode> mObjectsToDecode;
+		UnorderedMap<UINT32, UINT32> mObjectIdToDecodeIdx;
 
 		/**
 		 * @brief	Parses the entire object and calculates total size required for
@@ -117,14 +128,20 @@ namespace BansheeEngine
 			std::function<UINT8*(UINT8* buffer, int bytesWritten, UINT32& newBufferSize)> flushBufferCallback);
 
 		/**
-		 * @brief	Decodes a single IReflectable object.
+		 * @brief	Decodes all objects in the provided stream and returns the root object.
+		 */
+		std::shared_ptr<IReflectable> decodeObjects(DecodeStream& stream);
+
+		/**
+		 * @brief	Decodes a single IReflectable object starting at the current stream position. Data past
+		 *			"dataEnd" is not read. Returns true if another object follows the decoded one.
 		 */
-		bool decodeInternal(std::shared_ptr<IReflectable> object, UINT8* data, UINT32 dataLength, UINT32& bytesRead);
+		bool decodeInternal(std::shared_ptr<IReflectable> object, DecodeStream& stream, UINT64 dataEnd);
 
 		/**
 		* @brief	Encodes data required for representing a serialized field, into 4 bytes.
 		*/
-		UINT32 encodeFieldMetaData(UINT16 id, UINT8 size, bool array, SerializableFieldType type, bool hasDynamicSize);
+		static UINT32 encodeFieldMetaData(UINT16 id, UINT8 size, bool array, SerializableFieldType type, bool hasDynamicSize);
 
 		/**
 		* @brief	Decode meta field that was encoded using encodeFieldMetaData.
@@ -159,9 +176,9 @@ namespace BansheeEngine
 			std::function<UINT8*(UINT8* buffer, int bytesWritten, UINT32& newBufferSize)> flushBufferCallback);
 
 		/**
-		 * @brief	Helper method for decoding a complex object from the provided data buffer.
+		 * @brief	Helper method for decoding a complex object starting at the current stream position.
 		 */
-		std::shared_ptr<IReflectable> complexTypeFromBuffer(RTTIReflectableFieldBase* field, UINT8* data, int* complexTypeSize);
+		std::shared_ptr<IReflectable> complexTypeFromBuffer(RTTIReflectableFieldBase* field, DecodeStream& stream);
 
 		/**
 		 * @brief	Finds an existing, or creates a unique unique identifier for the specified object. 
@@ -0,0 +1,116 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+#include "BsBounds.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Stores a list of bounds (box and sphere) with each component in a separate array, so that
+	 *			many bounds can be processed at once using SIMD instructions.
+	 *
+	 *			Arrays are aligned to 32 bytes and padded to a multiple of GROUP_SIZE entries. Padding
+	 *			entries are zero.
+	 */
+	class BS_UTILITY_EXPORT BoundsArray
+	{
+	public:
+		/**
+		 * @brief	Identifiers of the arrays holding individual bounds components.
+		 */
+		enum Component
+		{
+			SphereCenterX,
+			SphereCenterY,
+			SphereCenterZ,
+			SphereRadius,
+			BoxCenterX,
+			BoxCenterY,
+			BoxCenterZ,
+			BoxExtentX,
+			BoxExtentY,
+			BoxExtentZ,
+			NumComponents
+		};
+
+		/**
+		 * @brief	Number of entries processed together by batch operations.
+		 */
+		static const UINT32 GROUP_SIZE = 8;
+
+		BoundsArray();
+		~BoundsArray();
+
+		BoundsArray(const BoundsArray&) = delete; // Make non-copyable
+		BoundsArray& operator=(const BoundsArray&) = delete; // Make non-copyable
+
+		/**
+		 * @brief	Appends new bounds to the end of the array and returns their index.
+		 */
+		UINT32 add(const Bounds& bounds);
+
+		/**
+		 * @brief	Replaces the bounds at the specified index.
+		 */
+		void set(UINT32 idx, const Bounds& bounds);
+
+		/**
+		 * @brief	Removes the bounds at the specified index by moving the last entry in its place.
+		 */
+		void remove(UINT32 idx);
+
+		/**
+		 * @brief	Removes all entries.
+		 */
+		void clear();
+
+		/**
+		 * @brief	Returns the number of entries.
+		 */
+		UINT32 size() const { return mSize; }
+
+		/**
+		 * @brief	Returns the number of entry groups, rounded up so the last group may be partially filled.
+		 */
+		UINT32 getNumGroups() const { return (mSize + GROUP_SIZE - 1) / GROUP_SIZE; }
+
+		/**
+		 * @brief	Returns the array holding the specified component of all entries.
+		 */
+		const float* getData(Component component) const { return mData + component * mCapacity; }
+
+		/**
+		 * @brief	Returns the center of the box of the entry at the specified index.
+		 */
+		Vector3 getBoxCenter(UINT32 idx) const;
+
+		/**
+		 * @brief	Returns the box of the entry at the specified index.
+		 */
+		AABox getBox(UINT32 idx) const;
+
+		/**
+		 * @brief	Returns the sphere of the entry at the specified index.
+		 */
+		Sphere getSphere(UINT32 idx) const;
+
+	private:
+		/**
+		 * @brief	Returns the array holding the specified component of all entries.
+		 */
+		float* getData(Component component) { return mData + component * mCapacity; }
+
+		/**
+		 * @brief	Grows the arrays so they can hold at least the specified number of entries.
+		 */
+		void reserve(UINT32 capacity);
+
+		UINT8* mBuffer;
+		float* mData;
+		UINT32 mSize;
+		UINT32 mCapacity;
+	};
+}
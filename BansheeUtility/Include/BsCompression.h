@@ -0,0 +1,49 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Provides methods for compressing and decompressing blocks of data.
+	 *
+	 * @note	Compressed data uses the LZ4 block format, which is fast enough to decompress
+	 *			that it is usable while loading resources.
+	 */
+	class BS_UTILITY_EXPORT Compression
+	{
+	public:
+		/**
+		 * @brief	Returns the size of the buffer large enough to hold compressed data in the worst
+		 *			case, for input data of the specified size.
+		 */
+		static UINT32 getMaxCompressedSize(UINT32 srcSize);
+
+		/**
+		 * @brief	Compresses a block of data.
+		 *
+		 * @param	src			Data to compress.
+		 * @param	srcSize		Size of the data to compress, in bytes.
+		 * @param	dst			Buffer to output the compressed data to.
+		 * @param	dstSize		Size of the output buffer, in bytes.
+		 *
+		 * @return	Size of the compressed data, or 0 if it doesn't fit in the output buffer.
+		 */
+		static UINT32 compress(const UINT8* src, UINT32 srcSize, UINT8* dst, UINT32 dstSize);
+
+		/**
+		 * @brief	Decompresses a block of data compressed with "compress".
+		 *
+		 * @param	src			Compressed data.
+		 * @param	srcSize		Size of the compressed data, in bytes.
+		 * @param	dst			Buffer to output the decompressed data to.
+		 * @param	dstSize		Exact size of the decompressed data, in bytes.
+		 *
+		 * @return	True if the data was successfully decompressed, false if the data is corrupt.
+		 */
+		static bool decompress(const UINT8* src, UINT32 srcSize, UINT8* dst, UINT32 dstSize);
+	};
+}
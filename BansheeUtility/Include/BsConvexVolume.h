@@ -30,6 +30,26 @@ namespace BansheeEngine
 		 */
 		bool intersects(const Sphere& sphere) const;
 
+		/**
+		 * @brief	Checks is the provided axis aligned box fully inside the volume.
+		 */
+		bool contains(const AABox& box) const;
+
+		/**
+		 * @brief	Checks which of the provided bounds intersect the volume. Both the box and the sphere of an
+		 *			entry must intersect the volume for the entry to be considered intersecting. Bounds are
+		 *			tested in groups using SIMD instructions where available.
+		 *
+		 * @param	bounds		Bounds to test.
+		 * @param	visibility	Output bitmask with one bit per entry in "bounds", set if the entry intersects the
+		 *						volume. Must have room for at least (bounds.size() + 31) / 32 values.
+		 * @param	planeCache	(optional) Array with one entry per group of bounds (see BoundsArray::getNumGroups),
+		 *						initialized to zero. Stores the plane that rejected the group during the last call, which
+		 *						is then tested first. Speeds up culling when the volume is tested against similar bounds
+		 *						every frame, as most groups can be rejected by a single plane test.
+		 */
+		void intersects(const BoundsArray& bounds, UINT32* visibility, UINT8* planeCache = nullptr) const;
+
 		/**
 		 * @brief	Returns the internal set of planes that represent the volume.
 		 */
@@ -140,8 +140,9 @@ namespace BansheeEngine
 		 *
 		 * @param 	memory		Memory to wrap the data stream around.
 		 * @param	size		Size of the memory chunk in bytes.
+		 * @param	freeOnClose	Should the memory be freed (using bs_free) once the stream is closed.
 		 */
-		MemoryDataStream(void* memory, size_t size);
+		MemoryDataStream(void* memory, size_t size, bool freeOnClose = true);
 		
 		/**
 		 * @brief	Create a stream which pre-buffers the contents of another stream. Data
@@ -214,6 +215,39 @@ namespace BansheeEngine
 		bool mFreeOnClose;
 	};
 
+	/**
+	 * @brief	Read-only data stream over a region of a memory mapped file. Data is read directly
+	 *			from the mapping, without being copied to an intermediate buffer.
+	 */
+	class BS_UTILITY_EXPORT MemoryMappedDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * @brief	Creates a stream over a region of a memory mapped file. The file will be kept
+		 *			mapped for as long as the stream is open.
+		 *
+		 * @param	file	Mapped file to read the data from.
+		 * @param	offset	Offset to the start of the region, in bytes.
+		 * @param	size	Size of the region, in bytes.
+		 */
+		MemoryMappedDataStream(const MemoryMappedFilePtr& file, size_t offset, size_t size);
+
+		~MemoryMappedDataStream();
+
+        /** 
+		 * @copydoc DataStream::write
+         */
+		size_t write(const void* buf, size_t count);
+
+        /** 
+		 * @copydoc DataStream::close
+         */
+        void close();
+
+	protected:
+		MemoryMappedFilePtr mFile;
+	};
+
 	/**
 	 * @brief	Data stream for handling data from standard streams.
 	 */
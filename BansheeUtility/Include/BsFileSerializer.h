@@ -35,8 +35,6 @@ namespace BansheeEngine
 		std::ofstream mOutputStream;
 		UINT8* mWriteBuffer;
 
-		std::ifstream mInputStream;
-
 		/**
 		 * @brief	Called by the binary serializer whenever the buffer gets full.
 		 */
@@ -10,39 +10,47 @@ namespace BansheeEngine
 	/**
 	 * @brief	Frame allocator. Performs very fast allocations but can only free all of its memory at once.
 	 * 			Perfect for allocations that last just a single frame.
-	 * 			
-	 * @note	Not thread safe with an exception. "alloc" and "clear" methods need to be called from the same thread.
-	 * 			"dealloc" is thread safe and can be called from any thread.
+	 *
+	 * @note	Each thread allocates from its own chunk of memory, and grabs a new chunk from the shared memory blocks
+	 *			using an atomic bump pointer when its chunk runs out. A lock is only taken when a memory block is exhausted.
+	 *			Memory blocks are kept when the allocator is cleared and reused in the next frame.
+	 *
+	 *			"alloc" and "dealloc" are thread safe and can be called from any thread. "clear" is not thread safe and must
+	 *			not be called while any other thread is using the allocator.
 	 */
 	class BS_UTILITY_EXPORT FrameAlloc
 	{
 	private:
-		class MemBlock
+		struct MemBlock
 		{
-		public:
-			MemBlock(UINT32 size);
-			~MemBlock();
-
-			UINT8* alloc(UINT8 amount);
-			void clear();
-
-			UINT8* mData;
-			UINT32 mFreePtr;
-			UINT32 mSize;
+			UINT8* data;
+			UINT32 size;
+			std::atomic<UINT32> freePtr;
 		};
 
 	public:
-		FrameAlloc(UINT32 blockSize = 1024 * 1024);
+		static const UINT32 DEFAULT_ALIGNMENT = 16;
+
+		/**
+		 * @brief	Constructs a new frame allocator.
+		 *
+		 * @param	blockSize	Size of a single memory block memory is allocated from. Larger allocations
+		 *						will be given their own block.
+		 * @param	chunkSize	Size of the chunk each thread reserves from the current memory block. Allocations
+		 *						larger than a quarter of the chunk are allocated directly from the memory block.
+		 */
+		FrameAlloc(UINT32 blockSize = 1024 * 1024, UINT32 chunkSize = 16 * 1024);
 		~FrameAlloc();
 
 		/**
 		 * @brief	Allocates a new block of memory of the specified size.
 		 *
-		 * @param	amount	Amount of memory to allocate, in bytes.
+		 * @param	amount		Amount of memory to allocate, in bytes.
+		 * @param	alignment	Alignment of the returned memory, in bytes. Must be a power of two.
 		 * 					
-		 * @note	Not thread safe.
+		 * @note	Thread safe.
 		 */
-		UINT8* alloc(UINT32 amount);
+		UINT8* alloc(UINT32 amount, UINT32 alignment = DEFAULT_ALIGNMENT);
 
 		/**
 		 * @brief	Deallocates a previously allocated block of memory.
@@ -55,20 +63,70 @@ namespace BansheeEngine
 		void dealloc(UINT8* data);
 
 		/**
-		 * @brief	Deallocates all allocated memory.
+		 * @brief	Deallocates all allocated memory. Memory blocks are kept for use in the next frame.
 		 * 			
 		 * @note	Not thread safe.
 		 */
 		void clear();
 
+		/**
+		 * @brief	Returns the number of bytes used between the two most recent calls to "clear". Includes
+		 *			unused space at the end of per-thread chunks.
+		 */
+		UINT32 getLastFrameUsage() const { return mLastFrameUsage; }
+
+		/**
+		 * @brief	Returns the largest number of bytes used in a single frame.
+		 */
+		UINT32 getPeakFrameUsage() const { return mPeakFrameUsage; }
+
+		/**
+		 * @brief	Returns the average number of bytes used per frame.
+		 */
+		UINT32 getAverageFrameUsage() const;
+
+		/**
+		 * @brief	Returns the total size of all memory blocks owned by the allocator.
+		 */
+		UINT32 getNumBytesReserved() const { return mNumBytesReserved; }
+
 	private:
-		UINT32 mBlockSize;
-		Vector<MemBlock*> mBlocks;
-		MemBlock* mFreeBlock;
-		std::atomic<UINT32> mTotalAllocBytes;
+		FrameAlloc(const FrameAlloc& other);
+		FrameAlloc& operator=(const FrameAlloc& other);
+
+		/**
+		 * @brief	Allocates memory from the shared memory blocks. Size must be a multiple of 16.
+		 *
+		 * @note	Thread safe.
+		 */
+		UINT8* allocFromBlocks(UINT32 size);
+
+		/**
+		 * @brief	Makes the block after "block" current, ensuring it can fit an allocation of "size" bytes.
+		 *			Does nothing if some other thread already moved on from "block".
+		 */
+		void advanceBlock(MemBlock* block, UINT32 size);
 
 		MemBlock* allocBlock(UINT32 wantedSize);
 		void deallocBlock(MemBlock* block);
+
+		UINT64 mId;
+		UINT64 mFrameIdx;
+		UINT32 mBlockSize;
+		UINT32 mChunkSize;
+
+		Vector<MemBlock*> mBlocks;
+		UINT32 mCurrentBlockIdx;
+		std::atomic<MemBlock*> mCurrentBlock;
+		BS_MUTEX(mBlockMutex);
+
+		UINT32 mNumBytesReserved;
+		UINT32 mLastFrameUsage;
+		UINT32 mPeakFrameUsage;
+		UINT64 mTotalFrameUsage;
+		UINT64 mNumFrames;
+
+		std::atomic<UINT32> mTotalAllocBytes;
 	};
 
 	/**
@@ -105,11 +163,13 @@ namespace BansheeEngine
 			:mFrameAlloc(frameAlloc)
 		{ }
 
-		StdFrameAlloc(const StdFrameAlloc&) throw()
+		StdFrameAlloc(const StdFrameAlloc& other) throw()
+			:mFrameAlloc(other.mFrameAlloc)
 		{ }
 
 		template <class U>
-		StdFrameAlloc(const StdFrameAlloc<U>&) throw()
+		StdFrameAlloc(const StdFrameAlloc<U>& other) throw()
+			:mFrameAlloc(other._getFrameAlloc())
 		{ }
 
 		~StdFrameAlloc() throw()
@@ -144,7 +204,7 @@ namespace BansheeEngine
 		 */
 		pointer allocate(size_type num, const void* = 0)
 		{
-			pointer ret = (pointer)(mFrameAlloc->alloc((UINT32)num*sizeof(T)));
+			pointer ret = (pointer)(mFrameAlloc->alloc((UINT32)(num*sizeof(T)), (UINT32)std::alignment_of<T>::value));
 			return ret;
 		}
 
@@ -172,6 +232,11 @@ namespace BansheeEngine
 			mFrameAlloc->dealloc((UINT8*)p);
 		}
 
+		/**
+		 * @brief	Returns the frame allocator memory is allocated from.
+		 */
+		FrameAlloc* _getFrameAlloc() const { return mFrameAlloc; }
+
 	private:
 		FrameAlloc* mFrameAlloc;
 	};
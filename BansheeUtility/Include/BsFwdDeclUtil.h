@@ -23,6 +23,8 @@ namespace BansheeEngine
 
 	class Angle;
 	class AABox;
+	class BoundsArray;
+	class ConvexVolume;
 	class Degree;
 	class Math;
 	class Matrix3;
@@ -44,6 +46,8 @@ namespace BansheeEngine
 	class DataStream;
 	class MemoryDataStream;
 	class FileDataStream;
+	class MemoryMappedDataStream;
+	class MemoryMappedFile;
 	class MeshData;
 	class FileSystem;
 	class Timer;
@@ -65,6 +69,8 @@ namespace BansheeEngine
 	typedef std::shared_ptr<DataStream> DataStreamPtr;
 	typedef std::shared_ptr<MemoryDataStream> MemoryDataStreamPtr;
 	typedef std::shared_ptr<FileDataStream> FileDataStreamPtr;
+	typedef std::shared_ptr<MemoryMappedDataStream> MemoryMappedDataStreamPtr;
+	typedef std::shared_ptr<MemoryMappedFile> MemoryMappedFilePtr;
 	typedef std::shared_ptr<MeshData> MeshDataPtr;
 	typedef std::shared_ptr<PixelData> PixelDataPtr;
 	typedef std::shared_ptr<GpuResourceData> GpuResourceDataPtr;
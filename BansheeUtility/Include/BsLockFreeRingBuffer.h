@@ -0,0 +1,134 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Fixed size lock-free queue that supports multiple producers and multiple consumers. Each
+	 *			slot carries a sequence number which tells producers and consumers whose turn it is to
+	 *			access it, so threads only ever contend on a single atomic index.
+	 *
+	 * @note	Thread safe.
+	 *
+	 *			Elements must be default constructible and copyable.
+	 */
+	template <class T>
+	class LockFreeRingBuffer
+	{
+		/**
+		 * @brief	Single element in the ring buffer.
+		 */
+		struct Slot
+		{
+			std::atomic<UINT64> sequence;
+			T value;
+		};
+
+	public:
+		/**
+		 * @brief	Constructs a new ring buffer.
+		 *
+		 * @param	capacity	Maximum number of elements the buffer can hold. Must be a power of two.
+		 */
+		LockFreeRingBuffer(UINT32 capacity)
+			:mCapacity(capacity), mMask(capacity - 1), mWriteIdx(0), mReadIdx(0)
+		{
+			assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+			mSlots = bs_newN<Slot>(capacity);
+			for (UINT32 i = 0; i < capacity; i++)
+				mSlots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		~LockFreeRingBuffer()
+		{
+			bs_deleteN(mSlots, mCapacity);
+		}
+
+		/**
+		 * @brief	Attempts to add a new element to the back of the queue. Returns false if the queue is full.
+		 */
+		bool push(const T& value)
+		{
+			Slot* slot = nullptr;
+			UINT64 writeIdx = mWriteIdx.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				slot = &mSlots[writeIdx & mMask];
+				UINT64 sequence = slot->sequence.load(std::memory_order_acquire);
+				INT64 diff = (INT64)sequence - (INT64)writeIdx;
+
+				if (diff == 0)
+				{
+					if (mWriteIdx.compare_exchange_weak(writeIdx, writeIdx + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0) // Full
+					return false;
+				else
+					writeIdx = mWriteIdx.load(std::memory_order_relaxed);
+			}
+
+			slot->value = value;
+			slot->sequence.store(writeIdx + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		/**
+		 * @brief	Attempts to remove an element from the front of the queue. Returns false if the queue is empty.
+		 */
+		bool pop(T& value)
+		{
+			Slot* slot = nullptr;
+			UINT64 readIdx = mReadIdx.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				slot = &mSlots[readIdx & mMask];
+				UINT64 sequence = slot->sequence.load(std::memory_order_acquire);
+				INT64 diff = (INT64)sequence - (INT64)(readIdx + 1);
+
+				if (diff == 0)
+				{
+					if (mReadIdx.compare_exchange_weak(readIdx, readIdx + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0) // Empty
+					return false;
+				else
+					readIdx = mReadIdx.load(std::memory_order_relaxed);
+			}
+
+			value = slot->value;
+			slot->value = T();
+			slot->sequence.store(readIdx + mMask + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		/**
+		 * @brief	Checks if the queue is empty. Result is only a hint if other threads are modifying the queue.
+		 */
+		bool isEmpty() const
+		{
+			UINT64 readIdx = mReadIdx.load(std::memory_order_acquire);
+			const Slot& slot = mSlots[readIdx & mMask];
+
+			return slot.sequence.load(std::memory_order_acquire) != (readIdx + 1);
+		}
+
+	private:
+		Slot* mSlots;
+		UINT32 mCapacity;
+		UINT64 mMask;
+
+		std::atomic<UINT64> mWriteIdx;
+		std::atomic<UINT64> mReadIdx;
+	};
+}
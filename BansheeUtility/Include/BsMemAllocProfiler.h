@@ -53,4 +53,38 @@ namespace BansheeEngine
 			::free(ptr);
 		}
 	};
+
+	/**
+	 * @brief	Statistics about memory allocated through a specific allocator category.
+	 */
+	struct MemAllocStats
+	{
+		MemAllocStats()
+			:numAllocs(0), numFrees(0), numBytesInUse(0), numBytesReserved(0)
+		{ }
+
+		UINT64 numAllocs; /**< Total number of allocations made. */
+		UINT64 numFrees; /**< Total number of frees made. */
+		UINT64 numBytesInUse; /**< Number of bytes in currently live allocations, including allocator overhead. */
+		UINT64 numBytesReserved; /**< Number of bytes the allocator is currently holding, either in use or cached for reuse. */
+	};
+
+	/**
+	 * @brief	Provides statistics for allocator categories that track them.
+	 *
+	 * @note	Allocation and free counts are only tracked if profiling is enabled.
+	 */
+	class BS_UTILITY_EXPORT MemAllocProfiler
+	{
+	public:
+		/**
+		 * @brief	Returns statistics for allocations made through PoolAlloc.
+		 */
+		static MemAllocStats getPoolAllocStats();
+
+		/**
+		 * @brief	Returns statistics for allocations made through ScratchAlloc.
+		 */
+		static MemAllocStats getScratchAllocStats();
+	};
 }
\ No newline at end of file
@@ -106,24 +106,6 @@ namespace BansheeEngine
 	class GenAlloc
 	{ };
 
-	/**
-	 * @brief	Allocator used for allocating small amounts of temporary memory that
-	 * 			used and then quickly released
-	 * 			
-	 * @note	Currently not used.
-	 */
-	class ScratchAlloc
-	{ };
-
-	/**
-	 * @brief	Pool allocator that is only suited for allocating one specific type of data. Most useful when you are
-	 * 			often allocating one certain data type, with no specific allocation or deallocation order.
-	 * 			
-	 * @note	Currently not used.
-	 */
-	class PoolAlloc
-	{ };
-
 	/**
 	 * @brief	Allocates the specified number of bytes.
 	 */
@@ -407,4 +389,6 @@ namespace BansheeEngine
 }
 
 #include "BsMemStack.h"
-#include "BsMemAllocProfiler.h"
\ No newline at end of file
+#include "BsMemAllocProfiler.h"
+#include "BsPoolAlloc.h"
+#include "BsScratchAlloc.h"
\ No newline at end of file
@@ -0,0 +1,50 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Read-only view of a file mapped into the address space of the process. File
+	 *			contents are paged in by the OS as they are accessed.
+	 */
+	class BS_UTILITY_EXPORT MemoryMappedFile
+	{
+	public:
+		/**
+		 * @brief	Maps the file at the specified path. Throws an exception if the file
+		 *			cannot be opened or mapped.
+		 */
+		MemoryMappedFile(const Path& fullPath);
+		~MemoryMappedFile();
+
+		/**
+		 * @brief	Returns a pointer to the start of the mapped file contents.
+		 */
+		const UINT8* getData() const { return mData; }
+
+		/**
+		 * @brief	Returns the size of the mapped file, in bytes.
+		 */
+		UINT64 getSize() const { return mSize; }
+
+		/**
+		 * @brief	Maps the file at the specified path and returns an object that keeps it
+		 *			mapped for as long as it is referenced.
+		 */
+		static MemoryMappedFilePtr create(const Path& fullPath);
+
+	private:
+		MemoryMappedFile(const MemoryMappedFile& other);
+		MemoryMappedFile& operator=(const MemoryMappedFile& other);
+
+		const UINT8* mData;
+		UINT64 mSize;
+
+		void* mFileHandle;
+		void* mMappingHandle;
+	};
+}
@@ -74,6 +74,19 @@
 #   define BS_ARCH_TYPE BS_ARCHITECTURE_x86_32
 #endif
 
+// Find supported SIMD instruction sets. AVX must be explicitly enabled in compiler settings.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define BS_SIMD_SSE2 1
+#else
+#	define BS_SIMD_SSE2 0
+#endif
+
+#if defined(__AVX__)
+#	define BS_SIMD_AVX 1
+#else
+#	define BS_SIMD_AVX 0
+#endif
+
 // Windows Settings
 #if BS_PLATFORM == BS_PLATFORM_WIN32
 
@@ -0,0 +1,68 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Pool allocator best suited for small objects that are often allocated and freed, 
+	 *			with no specific allocation or deallocation order.
+	 *
+	 * @see		MemoryAllocator<PoolAlloc>
+	 */
+	class PoolAlloc
+	{ };
+
+	/**
+	 * @brief	Specialized memory allocator that allocates small objects from fixed size blocks.
+	 *
+	 * @note	Allocations are rounded up to one of the block size classes. Each thread keeps a cache of free blocks
+	 *			for each size class so most allocations and frees don't require any synchronization. Threads exchange 
+	 *			blocks in batches through a shared free list. Allocations too large for any size class are passed to malloc.
+	 *			
+	 *			Memory may be freed on a different thread than the one that allocated it. Memory used for blocks is never
+	 *			returned to the system, but is reused for later allocations.
+	 *
+	 *			Each allocation comes with a 16 byte overhead.
+	 *
+	 *			Thread safe.
+	 */
+	template<>
+	class MemoryAllocator<PoolAlloc> : public MemoryAllocatorBase
+	{
+	public:
+		/**
+		 * @brief	Allocates the given number of bytes.
+		 */
+		static BS_UTILITY_EXPORT void* allocate(size_t bytes);
+
+		/**
+		 * @brief	Allocates the given a number of objects, each of the given number of bytes.
+		 */
+		static inline void* allocateArray(size_t bytes, UINT32 count)
+		{
+			return allocate(bytes * count);
+		}
+
+		/**
+		 * @brief	Frees memory previously allocated with "allocate".
+		 */
+		static BS_UTILITY_EXPORT void free(void* ptr);
+
+		/**
+		 * @brief	Frees memory previously allocated with "allocateArray". "count" must match the
+		 * 			original value when array was allocated.
+		 */
+		static inline void freeArray(void* ptr, UINT32 count)
+		{
+			free(ptr);
+		}
+
+		/**
+		 * @brief	Returns blocks cached by the current thread to the shared free list. Should be called 
+		 *			before a thread that used the allocator exits, otherwise its cached blocks will be lost.
+		 */
+		static BS_UTILITY_EXPORT void endThread();
+	};
+}
@@ -0,0 +1,88 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	class RTTITypeBase;
+	struct RTTIField;
+
+	/**
+	 * @brief	Layout of the fields of a single RTTI type, compiled once per type and used by
+	 *			BinarySerializer to avoid per field overhead when encoding and decoding objects.
+	 *
+	 *			Consecutive plain fields of fixed size are grouped into runs. Since the serialized
+	 *			layout of a run is always the same, headers of all fields in a run are written with
+	 *			a single copy from a pre-built template, and validated all at once when decoding.
+	 *
+	 * @note	Thread safe after construction. Retrieve using RTTITypeBase::_getSchema.
+	 */
+	class BS_UTILITY_EXPORT RTTISchema
+	{
+	public:
+		/**
+		 * @brief	Information about a single field of the type.
+		 */
+		struct Field
+		{
+			RTTIField* field;
+			UINT32 header; /**< Field header as written by BinarySerializer. */
+			UINT32 typeSize; /**< Size of a single value of the field, or 0 if it has dynamic size. */
+			INT32 runIdx; /**< Index of the run starting at this field, or -1 if a run doesn't start here. */
+			bool isFixedPlainArray; /**< True if the field is an array of plain values of fixed size. */
+		};
+
+		/**
+		 * @brief	Sequence of consecutive plain, non-array fields of fixed size.
+		 */
+		struct PlainRun
+		{
+			UINT32 firstField;
+			UINT32 numFields;
+			UINT32 size; /**< Size of all the fields in the run, including their headers. */
+			UINT8* layout; /**< Serialized run with all field values set to zero. */
+			Vector<UINT32> valueOffsets; /**< Offsets of field values relative to the start of the run. */
+		};
+
+		RTTISchema(RTTITypeBase* type);
+		~RTTISchema();
+
+		/**
+		 * @brief	Returns the number of fields of the type.
+		 */
+		UINT32 getNumFields() const { return (UINT32)mFields.size(); }
+
+		/**
+		 * @brief	Returns information about a field, in the order the fields were registered.
+		 */
+		const Field& getField(UINT32 idx) const { return mFields[idx]; }
+
+		/**
+		 * @brief	Returns information about a run of plain fields.
+		 */
+		const PlainRun& getRun(UINT32 idx) const { return mRuns[idx]; }
+
+		/**
+		 * @brief	Finds the index of the field with the specified unique ID. Returns -1 if the
+		 *			type doesn't have such a field.
+		 */
+		INT32 findField(UINT16 uniqueId) const
+		{
+			if(uniqueId >= mFieldLookup.size())
+				return -1;
+
+			return mFieldLookup[uniqueId];
+		}
+
+	private:
+		RTTISchema(const RTTISchema& other);
+		RTTISchema& operator=(const RTTISchema& other);
+
+		Vector<Field> mFields;
+		Vector<PlainRun> mRuns;
+		Vector<INT32> mFieldLookup;
+	};
+}
@@ -15,6 +15,7 @@
 #include "BsRTTIReflectablePtrField.h"
 #include "BsRTTIManagedDataBlockField.h"
 #include "BsIReflectable.h"
+#include "BsRTTISchema.h"
 
 namespace BansheeEngine
 {
@@ -435,6 +436,14 @@ namespace BansheeEngine
 		 */
 		RTTIField* findField(int uniqueFieldId);
 
+		/**
+		 * @brief	Returns the compiled layout of the fields of this type. Built the first time it is
+		 *			requested, so all fields must be registered by then.
+		 *
+		 * @note	Internal method used by the serializers. Thread safe.
+		 */
+		const RTTISchema& _getSchema();
+
 	protected:
 		/**
 		 * @brief	Tries to add a new field to the fields array, and throws an exception
@@ -480,6 +489,9 @@ namespace BansheeEngine
 
 	private:
 		Vector<RTTIField*> mFields;
+		std::atomic<RTTISchema*> mSchema;
+
+		BS_STATIC_MUTEX(mSchemaMutex)
 	};
 
 	/**
@@ -0,0 +1,176 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Occupancy and fragmentation statistics of a RangeAllocator.
+	 */
+	struct RangeAllocatorStats
+	{
+		UINT32 capacity = 0; /**< Total number of elements managed by the allocator. */
+		UINT32 usedSize = 0; /**< Number of elements in allocated blocks. */
+		UINT32 freeSize = 0; /**< Number of elements in free blocks. */
+		UINT32 numUsedBlocks = 0; /**< Number of allocated blocks. */
+		UINT32 numFreeBlocks = 0; /**< Number of free blocks. Adjacent free blocks are always merged. */
+		UINT32 largestFreeBlock = 0; /**< Size of the largest free block, in elements. */
+
+		/**
+		 * @brief	Returns the portion of the capacity in allocated blocks, in [0, 1] range.
+		 */
+		float getOccupancy() const { return capacity > 0 ? usedSize / (float)capacity : 0.0f; }
+
+		/**
+		 * @brief	Returns the portion of free elements that are not part of the largest free block, in [0, 1] range.
+		 *			Zero means all free space is contiguous.
+		 */
+		float getFragmentation() const { return freeSize > 0 ? 1.0f - largestFreeBlock / (float)freeSize : 0.0f; }
+	};
+
+	/**
+	 * @brief	Manages allocation of ranges of elements from a linear space (e.g. a region of a GPU buffer).
+	 *			Allocator only performs bookkeeping and doesn't own any memory itself.
+	 *
+	 * @note	Uses a two level segregated fit (TLSF) scheme: free blocks are kept in lists per size class,
+	 *			and bitmaps of non-empty lists are used to find a suitable block, so both allocation and
+	 *			freeing are constant time. Freed blocks are immediately merged with adjacent free blocks.
+	 *
+	 *			Not thread safe.
+	 */
+	class BS_UTILITY_EXPORT RangeAllocator
+	{
+		/**
+		 * @brief	A continuous range of elements, either free or allocated.
+		 */
+		struct Block
+		{
+			UINT32 start;
+			UINT32 size;
+
+			UINT32 prevPhysical; /**< Block directly preceding this one in the managed space. */
+			UINT32 nextPhysical; /**< Block directly following this one in the managed space. */
+
+			UINT32 prevFree; /**< Previous block in the same free list. */
+			UINT32 nextFree; /**< Next block in the same free list, or next unused block if the block is not in use. */
+
+			bool isFree;
+		};
+
+		static const UINT32 SL_COUNT_LOG2 = 4;
+		static const UINT32 SL_COUNT = 1 << SL_COUNT_LOG2;
+		static const UINT32 FL_COUNT = 32 - SL_COUNT_LOG2 + 1;
+
+	public:
+		/**
+		 * @brief	Identifier of a block that represents no block.
+		 */
+		static const UINT32 INVALID_BLOCK;
+
+		/**
+		 * @brief	Constructs a new allocator.
+		 *
+		 * @param	capacity	Number of elements available for allocation initially. Can be
+		 *						increased later with ::grow.
+		 */
+		RangeAllocator(UINT32 capacity = 0);
+
+		/**
+		 * @brief	Allocates a range of elements.
+		 *
+		 * @param	size	Number of elements to allocate. Zero sized allocations are rounded up to a single element.
+		 *
+		 * @returns	Identifier of the allocated block, or INVALID_BLOCK if there is no free range large enough.
+		 *			The identifier stays valid until the block is freed.
+		 */
+		UINT32 alloc(UINT32 size);
+
+		/**
+		 * @brief	Frees a block previously allocated with ::alloc, making its range available for
+		 *			future allocations.
+		 */
+		void free(UINT32 blockId);
+
+		/**
+		 * @brief	Increases the number of managed elements. New elements are appended to the end
+		 *			of the managed space and existing blocks are not moved.
+		 */
+		void grow(UINT32 newCapacity);
+
+		/**
+		 * @brief	Returns the number of free elements required to guarantee that an allocation of the
+		 *			provided size succeeds. Larger than the size itself since allocations only search free
+		 *			lists whose every block is large enough. Growing the allocator by at least this many
+		 *			elements ensures the following ::alloc call with the same size succeeds.
+		 */
+		static UINT64 getRequiredFreeSize(UINT32 size);
+
+		/**
+		 * @brief	Returns the offset of the first element of an allocated block.
+		 */
+		UINT32 getStart(UINT32 blockId) const { return mBlocks[blockId].start; }
+
+		/**
+		 * @brief	Returns the number of elements in an allocated block.
+		 */
+		UINT32 getSize(UINT32 blockId) const { return mBlocks[blockId].size; }
+
+		/**
+		 * @brief	Returns the total number of managed elements.
+		 */
+		UINT32 getCapacity() const { return mCapacity; }
+
+		/**
+		 * @brief	Calculates occupancy and fragmentation statistics.
+		 */
+		RangeAllocatorStats getStats() const;
+
+	private:
+		/**
+		 * @brief	Finds the free list that blocks of the provided size belong to.
+		 */
+		static void mapSize(UINT32 size, UINT32& fl, UINT32& sl);
+
+		/**
+		 * @brief	Returns a new unused block, reusing an old one if available.
+		 */
+		UINT32 createBlock();
+
+		/**
+		 * @brief	Marks a block as unused so it may be reused by ::createBlock.
+		 */
+		void destroyBlock(UINT32 blockId);
+
+		/**
+		 * @brief	Adds a block to the free list for its size.
+		 */
+		void insertFree(UINT32 blockId);
+
+		/**
+		 * @brief	Removes a block from the free list it is in.
+		 */
+		void removeFree(UINT32 blockId);
+
+		/**
+		 * @brief	Merges a block with the block physically following it, and destroys the following block.
+		 *			Neither block may be in a free list.
+		 */
+		void mergeWithNext(UINT32 blockId);
+
+		Vector<Block> mBlocks;
+		UINT32 mNextUnusedBlock;
+		UINT32 mLastBlock;
+		UINT32 mCapacity;
+
+		UINT32 mFLBitmap;
+		UINT32 mSLBitmap[FL_COUNT];
+		UINT32 mFreeLists[FL_COUNT][SL_COUNT];
+
+		UINT32 mUsedSize;
+		UINT32 mNumUsedBlocks;
+		UINT32 mNumFreeBlocks;
+	};
+}
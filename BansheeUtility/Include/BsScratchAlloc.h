@@ -0,0 +1,73 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Allocator used for allocating small amounts of temporary memory that
+	 * 			is used and then quickly released.
+	 *
+	 * @note	Only use for data released within the same frame. Data that may stay alive longer (resource
+	 *			data, material parameters, async operations) belongs on PoolAlloc or GenAlloc.
+	 *
+	 * @see		MemoryAllocator<ScratchAlloc>
+	 */
+	class ScratchAlloc
+	{ };
+
+	/**
+	 * @brief	Specialized memory allocator that allocates by bumping a pointer in a thread local memory block.
+	 *
+	 * @note	Each block counts its live allocations. When the block a thread is allocating from has no live allocations
+	 *			left it is reused from the start, and blocks the thread moved on from are freed once their last allocation is.
+	 *			This makes allocations that are released soon after they are made very cheap, while an allocation that is kept 
+	 *			around keeps its entire block alive, so prefer other allocators for long lived data.
+	 *
+	 *			Allocations larger than a fraction of the block size are passed to malloc.
+	 *
+	 *			Memory may be freed on a different thread than the one that allocated it.
+	 *
+	 *			Each allocation comes with a 16 byte overhead.
+	 *
+	 *			Thread safe.
+	 */
+	template<>
+	class MemoryAllocator<ScratchAlloc> : public MemoryAllocatorBase
+	{
+	public:
+		/**
+		 * @brief	Allocates the given number of bytes.
+		 */
+		static BS_UTILITY_EXPORT void* allocate(size_t bytes);
+
+		/**
+		 * @brief	Allocates the given a number of objects, each of the given number of bytes.
+		 */
+		static inline void* allocateArray(size_t bytes, UINT32 count)
+		{
+			return allocate(bytes * count);
+		}
+
+		/**
+		 * @brief	Frees memory previously allocated with "allocate".
+		 */
+		static BS_UTILITY_EXPORT void free(void* ptr);
+
+		/**
+		 * @brief	Frees memory previously allocated with "allocateArray". "count" must match the
+		 * 			original value when array was allocated.
+		 */
+		static inline void freeArray(void* ptr, UINT32 count)
+		{
+			free(ptr);
+		}
+
+		/**
+		 * @brief	Releases the block the current thread is allocating from. Should be called before a 
+		 *			thread that used the allocator exits, otherwise the block will never be freed.
+		 */
+		static BS_UTILITY_EXPORT void endThread();
+	};
+}
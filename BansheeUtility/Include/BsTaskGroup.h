@@ -0,0 +1,110 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+#include "BsTaskScheduler.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Group of tasks that can be waited upon together. Tasks are executed on the TaskScheduler.
+	 *
+	 * @note	Not thread safe. Tasks may only be spawned and waited upon from the thread that
+	 *			created the group. Group waits for all of its tasks to complete when destroyed.
+	 */
+	class BS_UTILITY_EXPORT TaskGroup
+	{
+	public:
+		/**
+		 * @brief	Creates a new task group.
+		 *
+		 * @param	priority	Priority to assign to all tasks spawned by this group.
+		 */
+		TaskGroup(TaskPriority priority = TaskPriority::Normal);
+		~TaskGroup();
+
+		/**
+		 * @brief	Queues a new task in the group. If the TaskScheduler is not running the
+		 *			task is executed immediately on the calling thread.
+		 */
+		void spawn(std::function<void()> taskWorker);
+
+		/**
+		 * @brief	Blocks until all tasks spawned in the group complete. Calling thread executes
+		 *			queued tasks while it waits.
+		 */
+		void wait();
+
+	private:
+		TaskGroup(const TaskGroup& other);
+		TaskGroup& operator=(const TaskGroup& other);
+
+		Vector<TaskPtr> mTasks;
+		TaskPriority mPriority;
+	};
+
+	/**
+	 * @brief	Executes the provided function for every index in range [begin, end), using all available
+	 *			TaskScheduler workers. Range is recursively split in halves until each part contains no more
+	 *			than "grainSize" elements. Split parts are queued as tasks, allowing idle workers to steal
+	 *			and further split them.
+	 *
+	 * @param	begin		First index in the range.
+	 * @param	end			One past the last index in the range.
+	 * @param	grainSize	Maximum number of elements to process serially in a single task. Ranges
+	 *						this small or smaller are executed inline without involving the scheduler. 
+	 *						If zero a grain size is picked based on the number of workers.
+	 * @param	func		Function with signature void(UINT32 idx) to execute for each index. Must be
+	 *						safe to call from multiple threads at once.
+	 * @param	priority	Priority of the queued tasks.
+	 *
+	 * @note	Blocks until all indexes have been processed. Calling thread takes part in the work.
+	 */
+	template<class Func>
+	void parallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, const Func& func, 
+		TaskPriority priority = TaskPriority::Normal)
+	{
+		if (end <= begin)
+			return;
+
+		if (!TaskScheduler::isStarted())
+		{
+			for (UINT32 i = begin; i < end; i++)
+				func(i);
+
+			return;
+		}
+
+		if (grainSize == 0)
+		{
+			// Aim for a few tasks per worker so idle workers have something to steal
+			UINT32 numParts = (TaskScheduler::instance().getNumWorkers() + 1) * 4;
+			grainSize = std::max((end - begin) / numParts, 1U);
+		}
+
+		if ((end - begin) <= grainSize)
+		{
+			for (UINT32 i = begin; i < end; i++)
+				func(i);
+
+			return;
+		}
+
+		TaskGroup group(priority);
+		while ((end - begin) > grainSize)
+		{
+			UINT32 middle = begin + (end - begin) / 2;
+			UINT32 partEnd = end;
+
+			group.spawn([=, &func]() { parallelFor(middle, partEnd, grainSize, func, priority); });
+			end = middle;
+		}
+
+		for (UINT32 i = begin; i < end; i++)
+			func(i);
+
+		group.wait();
+	}
+}
@@ -6,6 +6,8 @@
 #include "BsPrerequisitesUtil.h"
 #include "BsModule.h"
 #include "BsThreadPool.h"
+#include "BsSpinLock.h"
+#include "BsWorkStealingQueue.h"
 
 namespace BansheeEngine
 {
@@ -32,7 +34,7 @@ namespace BansheeEngine
 
 	public:
 		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
-			TaskPriority priority, TaskPtr dependency);
+			TaskPriority priority, const Vector<TaskPtr>& dependencies);
 
 		/**
 		 * @brief	Creates a new task. Task should be provided to TaskScheduler in order for it
@@ -47,6 +49,18 @@ namespace BansheeEngine
 		static TaskPtr create(const String& name, std::function<void()> taskWorker, TaskPriority priority = TaskPriority::Normal, 
 			TaskPtr dependency = nullptr);
 
+		/**
+		 * @brief	Creates a new task that depends on multiple other tasks. Task should be provided to 
+		 *			TaskScheduler in order for it to start.
+		 *
+		 * @param	name			Name you can use to more easily identify the task.
+		 * @param	taskWorker		Worker method that does all of the work in the task.
+		 * @param	priority  		Higher priority means the tasks will be executed sooner.
+		 * @param	dependencies	Tasks that need to complete before this task is allowed to execute.
+		 */
+		static TaskPtr create(const String& name, std::function<void()> taskWorker, TaskPriority priority, 
+			const Vector<TaskPtr>& dependencies);
+
 		/**
 		 * @brief	Returns true if the task has completed.
 		 */
@@ -60,25 +74,40 @@ namespace BansheeEngine
 		/**
 		 * @brief	Blocks the current thread until the task has completed. 
 		 * 			
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	While waiting the calling thread executes other queued tasks, so that its core isn't wasted.
 		 */
 		void wait();
 
 		/**
-		 * @brief	Cancels the task and removes it from the TaskSchedulers queue.
+		 * @brief	Cancels the task and removes it from the TaskSchedulers queue. Has no effect
+		 *			if the task already started executing.
+		 *
+		 * @note	Canceled tasks count as resolved dependencies, so any tasks depending on
+		 *			this task will be allowed to run.
 		 */
 		void cancel();
 
 	private:
 		friend class TaskScheduler;
 
+		/**
+		 * @brief	Notifies all tasks depending on this task that the dependency has been resolved. 
+		 *			Only has effect the first time it is called.
+		 */
+		void releaseDependents();
+
 		String mName;
 		TaskPriority mPriority;
-		UINT32 mTaskId;
 		std::function<void()> mTaskWorker;
-		TaskPtr mTaskDependency;
+		Vector<TaskPtr> mDependencies;
 		std::atomic<UINT32> mState; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
+		std::atomic<UINT32> mNumPendingDependencies;
+		Vector<Task*> mDependents;
+		bool mDependentsReleased;
+		SpinLock mDependentsLock;
+
+		TaskPtr mSelf; /**< Keeps the task alive while it is owned by the scheduler. */
 		TaskScheduler* mParent;
 	};
 
@@ -89,21 +118,49 @@ namespace BansheeEngine
 	 * 			
 	 * @note	Thread safe.
 	 * 			
-	 *			This type of task scheduler uses a global queue and is best used for coarse granularity of tasks.
-	 *			(Number of tasks in the order of hundreds. Higher number of tasks might require different queuing and
-	 *			locking mechanism, potentially at the cost of flexibility.)
+	 *			Each worker thread owns a set of lock-free queues, one per task priority. Workers execute tasks from 
+	 *			their own queues first, and steal tasks from other workers when they run out. Tasks queued from 
+	 *			threads that are not scheduler workers go into a shared queue that all workers pull from.
+	 *			This makes the scheduler suitable for large numbers of small tasks.
 	 *			
 	 *			By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
-	 *			threads using addWorker/removeWorker methods.
+	 *			threads using addWorker/removeWorker methods. Worker threads are created on demand and persist until
+	 *			the scheduler is shut down.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
+		static const UINT32 NUM_PRIORITY_LANES = 5;
+		static const UINT32 MAX_WORKERS = 64;
+
+		/**
+		 * @brief	Persistent worker thread and its queues.
+		 */
+		struct Worker
+		{
+			WorkStealingQueue<Task*> lanes[NUM_PRIORITY_LANES];
+			HThread thread;
+		};
+
+		/**
+		 * @brief	Queue used for tasks submitted from threads that aren't scheduler workers.
+		 */
+		struct InjectionLane
+		{
+			InjectionLane()
+				:numTasks(0)
+			{ }
+
+			Queue<Task*> tasks;
+			std::atomic<UINT32> numTasks;
+			SpinLock lock;
+		};
+
 	public:
 		TaskScheduler();
 		~TaskScheduler();
 
 		/**
-		 * @brief	Queues a new task.
+		 * @brief	Queues a new task. Task will be executed once all of its dependencies complete.
 		 */
 		void addTask(const TaskPtr& task);
 
@@ -117,41 +174,88 @@ namespace BansheeEngine
 		 */
 		void removeWorker();
 
+		/**
+		 * @brief	Returns the number of worker threads currently allowed to execute tasks.
+		 */
+		UINT32 getNumWorkers() const;
+
 	protected:
 		friend class Task;
 
 		/**
-		 * @brief	Main task scheduler method that dispatches tasks to other threads.
+		 * @brief	Main method of a worker thread. Executes tasks until the scheduler is shut down.
 		 */
-		void runMain();
+		void runWorker(UINT32 workerIdx);
 
 		/**
-		 * @brief	Worker method that runs a single task.
+		 * @brief	Finds a single queued task and executes it. Returns false if no task was found.
+		 *
+		 * @param	worker	Worker executing the task, or null if called from a thread that isn't a
+		 *					scheduler worker.
 		 */
-		void runTask(TaskPtr task);
+		bool tryRunTask(Worker* worker);
 
 		/**
-		 * @brief	Blocks the calling thread until the specified task has completed.
+		 * @brief	Retrieves the highest priority queued task, first checking the workers own queues, then
+		 *			the shared queue and finally stealing from other workers. Returns null if no task was found.
+		 */
+		Task* findTask(Worker* worker);
+
+		/**
+		 * @brief	Executes a task previously removed from a queue and releases any tasks depending on it.
+		 *			Task must already be counted as running, and stops being counted once dependents are released.
+		 */
+		void executeTask(Task* task);
+
+		/**
+		 * @brief	Pushes a task whose dependencies have all been resolved on the calling threads queue.
+		 */
+		void enqueue(Task* task);
+
+		/**
+		 * @brief	Called when a single dependency of the provided task has been resolved. Queues the task
+		 *			when it is its last dependency.
+		 */
+		void dependencyResolved(Task* task);
+
+		/**
+		 * @brief	Blocks the calling thread until the specified task has completed. Executes other
+		 *			queued tasks while waiting.
 		 */
 		void waitUntilComplete(const Task* task);
 
 		/**
-		 * @brief	Method used for sorting tasks.
+		 * @brief	Starts a new worker thread if the number of active workers allows it.
 		 */
-		static bool taskCompare(const TaskPtr& lhs, const TaskPtr& rhs);
+		void spawnWorkerIfNeeded();
+
+		/**
+		 * @brief	Wakes up all sleeping workers and waiting threads, if there are any.
+		 */
+		void wakeSleepers();
+
+		/**
+		 * @brief	Returns the worker that owns the calling thread, or null if the calling thread is not a worker.
+		 */
+		Worker* getCurrentWorker() const;
+
+		/**
+		 * @brief	Maps task priority to queue lane index. Higher priorities map to lower indexes.
+		 */
+		static UINT32 getLaneIdx(TaskPriority priority);
+
+		Worker* mWorkers[MAX_WORKERS];
+		InjectionLane mInjectionLanes[NUM_PRIORITY_LANES];
 
-		HThread mTaskSchedulerThread;
-		Set<TaskPtr, std::function<bool(const TaskPtr&, const TaskPtr&)>> mTaskQueue;
-		Vector<TaskPtr> mActiveTasks;
-		UINT32 mNumActiveTasks;
-		UINT32 mMaxActiveTasks;
-		UINT32 mNextTaskId;
-		bool mShutdown;
+		std::atomic<UINT32> mNumWorkers;
+		std::atomic<INT32> mMaxActiveWorkers;
+		std::atomic<UINT32> mNumQueuedTasks;
+		std::atomic<UINT32> mNumRunningTasks;
+		std::atomic<UINT32> mNumSleeping;
+		std::atomic<bool> mShutdown;
 
-		BS_MUTEX(mReadyMutex);
-		BS_MUTEX(mCompleteMutex);
-		BS_MUTEX(mActiveTaskMutex);
-		BS_THREAD_SYNCHRONISER(mTaskReadyCond);
-		BS_THREAD_SYNCHRONISER(mTaskCompleteCond);
+		BS_MUTEX(mWorkerMutex);
+		BS_MUTEX(mSleepMutex);
+		BS_THREAD_SYNCHRONISER(mSleepCond);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Lock-free double ended queue (Chase-Lev) that is owned by a single thread. Owner thread
+	 *			pushes and pops from the bottom end in LIFO order, while any other thread may steal from the
+	 *			top end in FIFO order.
+	 *
+	 * @note	push() and pop() may only be called from the owner thread. steal() and isEmpty() are thread safe.
+	 *
+	 *			Only usable with pointer types. Queue does not take ownership of the pointed to objects.
+	 */
+	template <class T>
+	class WorkStealingQueue
+	{
+		static_assert(std::is_pointer<T>::value, "WorkStealingQueue can only hold pointer types.");
+
+		/**
+		 * @brief	Circular array holding the queue elements. Indexes wrap around array size.
+		 */
+		struct Buffer
+		{
+			Buffer(INT64 size)
+				:size(size), mask(size - 1)
+			{
+				elements = (std::atomic<T>*)bs_alloc(sizeof(std::atomic<T>) * (UINT32)size);
+
+				for (INT64 i = 0; i < size; i++)
+					new (&elements[i]) std::atomic<T>(nullptr);
+			}
+
+			~Buffer()
+			{
+				bs_free(elements);
+			}
+
+			T get(INT64 idx) const
+			{
+				return elements[idx & mask].load(std::memory_order_relaxed);
+			}
+
+			void put(INT64 idx, T value)
+			{
+				elements[idx & mask].store(value, std::memory_order_relaxed);
+			}
+
+			INT64 size;
+			INT64 mask;
+			std::atomic<T>* elements;
+		};
+
+	public:
+		/**
+		 * @brief	Constructs a new queue.
+		 *
+		 * @param	initialCapacity	Number of elements the queue can hold before it needs to grow. Must be a power of two.
+		 */
+		WorkStealingQueue(UINT32 initialCapacity = 256)
+			:mTop(0), mBottom(0)
+		{
+			assert((initialCapacity & (initialCapacity - 1)) == 0);
+
+			Buffer* buffer = bs_new<Buffer>(initialCapacity);
+			mBuffer.store(buffer, std::memory_order_relaxed);
+			mRetiredBuffers.push_back(buffer);
+		}
+
+		~WorkStealingQueue()
+		{
+			for (auto& buffer : mRetiredBuffers)
+				bs_delete(buffer);
+		}
+
+		/**
+		 * @brief	Pushes a new element on the bottom of the queue.
+		 *
+		 * @note	Owner thread only.
+		 */
+		void push(T value)
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			INT64 top = mTop.load(std::memory_order_acquire);
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+
+			if ((bottom - top) > (buffer->size - 1))
+				buffer = grow(buffer, top, bottom);
+
+			buffer->put(bottom, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief	Removes the most recently pushed element from the bottom of the queue. Returns null if the
+		 *			queue is empty.
+		 *
+		 * @note	Owner thread only.
+		 */
+		T pop()
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 top = mTop.load(std::memory_order_relaxed);
+
+			if (top > bottom) // Empty
+			{
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T value = buffer->get(bottom);
+			if (top == bottom) // Last element, compete with thieves
+			{
+				if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					value = nullptr;
+
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return value;
+		}
+
+		/**
+		 * @brief	Attempts to remove the oldest element from the top of the queue. Returns null if the queue is
+		 *			empty or if another thread won the race for the element.
+		 *
+		 * @note	Thread safe.
+		 */
+		T steal()
+		{
+			INT64 top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			Buffer* buffer = mBuffer.load(std::memory_order_acquire);
+			T value = buffer->get(top);
+
+			if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return value;
+		}
+
+		/**
+		 * @brief	Checks if the queue is empty. Result is only a hint if other threads are modifying the queue.
+		 *
+		 * @note	Thread safe.
+		 */
+		bool isEmpty() const
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			INT64 top = mTop.load(std::memory_order_relaxed);
+
+			return bottom <= top;
+		}
+
+	private:
+		/**
+		 * @brief	Creates a new buffer with twice the size and copies all live elements to it. Old buffer
+		 *			is kept alive until the queue is destroyed since thieves might still be reading from it.
+		 */
+		Buffer* grow(Buffer* oldBuffer, INT64 top, INT64 bottom)
+		{
+			Buffer* newBuffer = bs_new<Buffer>(oldBuffer->size * 2);
+			for (INT64 i = top; i < bottom; i++)
+				newBuffer->put(i, oldBuffer->get(i));
+
+			mRetiredBuffers.push_back(newBuffer);
+			mBuffer.store(newBuffer, std::memory_order_release);
+
+			return newBuffer;
+		}
+
+		std::atomic<INT64> mTop;
+		std::atomic<INT64> mBottom;
+		std::atomic<Buffer*> mBuffer;
+		Vector<Buffer*> mRetiredBuffers;
+	};
+}
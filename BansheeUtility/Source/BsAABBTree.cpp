@@ -0,0 +1,306 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsAABBTree.h"
+
+namespace BansheeEngine
+{
+	AABBTree::AABBTree(float margin)
+		:mRoot(INVALID_ID), mFreeList(INVALID_ID), mNumProxies(0), mMargin(margin)
+	{ }
+
+	UINT32 AABBTree::insert(const AABox& bounds, UINT32 userData)
+	{
+		UINT32 leafIdx = allocNode();
+
+		Node& leaf = mNodes[leafIdx];
+		leaf.bounds = expandBounds(bounds);
+		leaf.userData = userData;
+		leaf.height = 0;
+
+		insertLeaf(leafIdx);
+		mNumProxies++;
+
+		return leafIdx;
+	}
+
+	void AABBTree::remove(UINT32 proxyId)
+	{
+		assert(proxyId < (UINT32)mNodes.size() && mNodes[proxyId].isLeaf());
+
+		removeLeaf(proxyId);
+		freeNode(proxyId);
+		mNumProxies--;
+	}
+
+	bool AABBTree::update(UINT32 proxyId, const AABox& bounds)
+	{
+		assert(proxyId < (UINT32)mNodes.size() && mNodes[proxyId].isLeaf());
+
+		const AABox& fatBounds = mNodes[proxyId].bounds;
+		if (fatBounds.contains(bounds))
+		{
+			// Also reinsert if the bounds shrunk a lot, otherwise the proxy would keep reporting false positives
+			Vector3 slack = fatBounds.getSize() - bounds.getSize();
+			float maxSlack = mMargin * 4.0f;
+
+			if (slack.x <= maxSlack && slack.y <= maxSlack && slack.z <= maxSlack)
+				return false;
+		}
+
+		removeLeaf(proxyId);
+		mNodes[proxyId].bounds = expandBounds(bounds);
+		insertLeaf(proxyId);
+
+		return true;
+	}
+
+	void AABBTree::clear()
+	{
+		mNodes.clear();
+		mRoot = INVALID_ID;
+		mFreeList = INVALID_ID;
+		mNumProxies = 0;
+	}
+
+	UINT32 AABBTree::allocNode()
+	{
+		UINT32 nodeIdx;
+		if (mFreeList != INVALID_ID)
+		{
+			nodeIdx = mFreeList;
+			mFreeList = mNodes[nodeIdx].parent;
+		}
+		else
+		{
+			nodeIdx = (UINT32)mNodes.size();
+			mNodes.push_back(Node());
+		}
+
+		Node& node = mNodes[nodeIdx];
+		node.parent = INVALID_ID;
+		node.child1 = INVALID_ID;
+		node.child2 = INVALID_ID;
+		node.height = 0;
+		node.userData = 0;
+
+		return nodeIdx;
+	}
+
+	void AABBTree::freeNode(UINT32 nodeIdx)
+	{
+		Node& node = mNodes[nodeIdx];
+		node.parent = mFreeList;
+		node.height = -1;
+
+		mFreeList = nodeIdx;
+	}
+
+	void AABBTree::insertLeaf(UINT32 leafIdx)
+	{
+		if (mRoot == INVALID_ID)
+		{
+			mRoot = leafIdx;
+			mNodes[leafIdx].parent = INVALID_ID;
+			return;
+		}
+
+		// Find the best sibling, descending towards the child which increases the total surface area the least
+		AABox leafBounds = mNodes[leafIdx].bounds;
+		UINT32 siblingIdx = mRoot;
+		while (!mNodes[siblingIdx].isLeaf())
+		{
+			const Node& node = mNodes[siblingIdx];
+
+			float area = getCost(node.bounds);
+			float combinedArea = getCost(merge(node.bounds, leafBounds));
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			float childCosts[2];
+			UINT32 children[2] = { node.child1, node.child2 };
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				const Node& child = mNodes[children[i]];
+
+				float childArea = getCost(merge(child.bounds, leafBounds));
+				if (!child.isLeaf())
+					childArea -= getCost(child.bounds);
+
+				childCosts[i] = childArea + inheritanceCost;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+				break;
+
+			siblingIdx = childCosts[0] < childCosts[1] ? children[0] : children[1];
+		}
+
+		// Create a new parent for the sibling and the leaf
+		UINT32 oldParentIdx = mNodes[siblingIdx].parent;
+		UINT32 newParentIdx = allocNode();
+
+		Node& newParent = mNodes[newParentIdx];
+		newParent.parent = oldParentIdx;
+		newParent.bounds = merge(leafBounds, mNodes[siblingIdx].bounds);
+		newParent.height = mNodes[siblingIdx].height + 1;
+		newParent.child1 = siblingIdx;
+		newParent.child2 = leafIdx;
+
+		if (oldParentIdx != INVALID_ID)
+		{
+			Node& oldParent = mNodes[oldParentIdx];
+			if (oldParent.child1 == siblingIdx)
+				oldParent.child1 = newParentIdx;
+			else
+				oldParent.child2 = newParentIdx;
+		}
+		else
+			mRoot = newParentIdx;
+
+		mNodes[siblingIdx].parent = newParentIdx;
+		mNodes[leafIdx].parent = newParentIdx;
+
+		refitUpwards(mNodes[leafIdx].parent);
+	}
+
+	void AABBTree::removeLeaf(UINT32 leafIdx)
+	{
+		if (leafIdx == mRoot)
+		{
+			mRoot = INVALID_ID;
+			return;
+		}
+
+		// Replace the parent with the sibling of the leaf
+		UINT32 parentIdx = mNodes[leafIdx].parent;
+		UINT32 grandParentIdx = mNodes[parentIdx].parent;
+		UINT32 siblingIdx = mNodes[parentIdx].child1 == leafIdx ? mNodes[parentIdx].child2 : mNodes[parentIdx].child1;
+
+		if (grandParentIdx != INVALID_ID)
+		{
+			Node& grandParent = mNodes[grandParentIdx];
+			if (grandParent.child1 == parentIdx)
+				grandParent.child1 = siblingIdx;
+			else
+				grandParent.child2 = siblingIdx;
+
+			mNodes[siblingIdx].parent = grandParentIdx;
+			freeNode(parentIdx);
+
+			refitUpwards(grandParentIdx);
+		}
+		else
+		{
+			mRoot = siblingIdx;
+			mNodes[siblingIdx].parent = INVALID_ID;
+			freeNode(parentIdx);
+		}
+
+		mNodes[leafIdx].parent = INVALID_ID;
+	}
+
+	void AABBTree::refitUpwards(UINT32 nodeIdx)
+	{
+		while (nodeIdx != INVALID_ID)
+		{
+			nodeIdx = balance(nodeIdx);
+
+			Node& node = mNodes[nodeIdx];
+			const Node& child1 = mNodes[node.child1];
+			const Node& child2 = mNodes[node.child2];
+
+			node.height = 1 + std::max(child1.height, child2.height);
+			node.bounds = merge(child1.bounds, child2.bounds);
+
+			nodeIdx = node.parent;
+		}
+	}
+
+	UINT32 AABBTree::balance(UINT32 aIdx)
+	{
+		Node& a = mNodes[aIdx];
+		if (a.isLeaf() || a.height < 2)
+			return aIdx;
+
+		UINT32 bIdx = a.child1;
+		UINT32 cIdx = a.child2;
+		INT32 heightDiff = mNodes[cIdx].height - mNodes[bIdx].height;
+
+		if (heightDiff >= -1 && heightDiff <= 1)
+			return aIdx;
+
+		// Rotate the taller child up, putting "a" in its place, and move the taller
+		// grandchild under the taller child and the shorter grandchild under "a"
+		UINT32 upIdx = heightDiff > 1 ? cIdx : bIdx;
+		UINT32 otherIdx = heightDiff > 1 ? bIdx : cIdx;
+
+		Node& up = mNodes[upIdx];
+		UINT32 fIdx = up.child1;
+		UINT32 gIdx = up.child2;
+
+		up.child1 = aIdx;
+		up.parent = a.parent;
+		a.parent = upIdx;
+
+		if (up.parent != INVALID_ID)
+		{
+			Node& upParent = mNodes[up.parent];
+			if (upParent.child1 == aIdx)
+				upParent.child1 = upIdx;
+			else
+				upParent.child2 = upIdx;
+		}
+		else
+			mRoot = upIdx;
+
+		UINT32 tallIdx = fIdx;
+		UINT32 shortIdx = gIdx;
+		if (mNodes[fIdx].height < mNodes[gIdx].height)
+			std::swap(tallIdx, shortIdx);
+
+		up.child2 = tallIdx;
+
+		a.child1 = otherIdx;
+		a.child2 = shortIdx;
+		mNodes[shortIdx].parent = aIdx;
+
+		const Node& other = mNodes[otherIdx];
+		const Node& shortNode = mNodes[shortIdx];
+		const Node& tallNode = mNodes[tallIdx];
+
+		a.bounds = merge(other.bounds, shortNode.bounds);
+		a.height = 1 + std::max(other.height, shortNode.height);
+
+		up.bounds = merge(a.bounds, tallNode.bounds);
+		up.height = 1 + std::max(a.height, tallNode.height);
+
+		return upIdx;
+	}
+
+	AABox AABBTree::expandBounds(const AABox& bounds) const
+	{
+		Vector3 margin(mMargin, mMargin, mMargin);
+		return AABox(bounds.getMin() - margin, bounds.getMax() + margin);
+	}
+
+	AABox AABBTree::merge(const AABox& a, const AABox& b)
+	{
+		Vector3 min = a.getMin();
+		Vector3 max = a.getMax();
+		min.floor(b.getMin());
+		max.ceil(b.getMax());
+
+		return AABox(min, max);
+	}
+
+	float AABBTree::getCost(const AABox& box)
+	{
+		Vector3 size = box.getSize();
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+}
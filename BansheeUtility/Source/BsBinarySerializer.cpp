@@ -12,6 +12,8 @@
 #include "BsRTTIReflectableField.h"
 #include "BsRTTIReflectablePtrField.h"
 #include "BsRTTIManagedDataBlockField.h"
+#include "BsRTTISchema.h"
+#include "BsDataStream.h"
 
 #include <unordered_set>
 
@@ -41,6 +43,203 @@ buffer += size##;														\
 
 namespace BansheeEngine
 {
+	/**
+	 * @brief	Provides sequential and random access to the data being decoded. Data is either accessed directly
+	 *			in memory, or read from a data stream in bounded chunks.
+	 */
+	class BinarySerializer::DecodeStream
+	{
+	public:
+		/**
+		 * @brief	Creates a decode stream that reads directly from memory.
+		 */
+		DecodeStream(const UINT8* data, UINT64 size)
+			:mMemory(data), mSize(size), mPosition(0), mStreamStart(0), mChunk(nullptr), mChunkStart(0), 
+			mChunkSize(0), mScratch(nullptr), mScratchSize(0)
+		{ }
+
+		/**
+		 * @brief	Creates a decode stream that reads from the provided data stream, starting at its
+		 *			current position.
+		 */
+		DecodeStream(const DataStreamPtr& stream)
+			:mMemory(nullptr), mStream(stream), mPosition(0), mChunkStart(0), mChunkSize(0), mScratch(nullptr), mScratchSize(0)
+		{
+			mStreamStart = (UINT64)stream->tell();
+			mSize = (UINT64)stream->size() - mStreamStart;
+
+			mChunk = (UINT8*)bs_alloc<ScratchAlloc>(CHUNK_SIZE);
+		}
+
+		~DecodeStream()
+		{
+			if(mScratch != nullptr)
+				bs_free<ScratchAlloc>(mScratch);
+
+			if(mChunk != nullptr)
+				bs_free<ScratchAlloc>(mChunk);
+		}
+
+		/**
+		 * @brief	Returns the current read position, relative to the start of the data.
+		 */
+		UINT64 tell() const { return mPosition; }
+
+		/**
+		 * @brief	Returns the total size of the data.
+		 */
+		UINT64 size() const { return mSize; }
+
+		/**
+		 * @brief	Moves the read position to the specified location, relative to the start of the data.
+		 */
+		void seek(UINT64 position)
+		{
+			if(position > mSize)
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+
+			mPosition = position;
+		}
+
+		/**
+		 * @brief	Moves the read position forward by the specified number of bytes.
+		 */
+		void skip(UINT64 count)
+		{
+			seek(mPosition + count);
+		}
+
+		/**
+		 * @brief	Reads the specified number of bytes into the provided buffer and advances the read position.
+		 *			Large reads from a data stream go directly into the provided buffer.
+		 */
+		void read(void* dest, UINT64 count)
+		{
+			if(count > (mSize - mPosition))
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+
+			if(mMemory != nullptr)
+			{
+				memcpy(dest, mMemory + mPosition, (size_t)count);
+				mPosition += count;
+				return;
+			}
+
+			UINT8* destPtr = (UINT8*)dest;
+			while(count > 0)
+			{
+				if(mPosition >= mChunkStart && mPosition < (mChunkStart + mChunkSize))
+				{
+					UINT64 offset = mPosition - mChunkStart;
+					UINT64 numBytes = std::min(count, mChunkSize - offset);
+
+					memcpy(destPtr, mChunk + offset, (size_t)numBytes);
+					destPtr += numBytes;
+					mPosition += numBytes;
+					count -= numBytes;
+				}
+				else if(count >= CHUNK_SIZE)
+				{
+					mStream->seek((size_t)(mStreamStart + mPosition));
+					if(mStream->read(destPtr, (size_t)count) != (size_t)count)
+						BS_EXCEPT(InternalErrorException, "Error decoding data. Unexpected end of stream.");
+
+					mPosition += count;
+					count = 0;
+				}
+				else
+					readChunk(mPosition);
+			}
+		}
+
+		/**
+		 * @brief	Reads the specified number of bytes without advancing the read position.
+		 */
+		void peek(void* dest, UINT32 count)
+		{
+			UINT64 position = mPosition;
+			read(dest, count);
+			mPosition = position;
+		}
+
+		/**
+		 * @brief	Advances the read position by the specified number of bytes and returns a pointer
+		 *			to the contiguous data that was skipped over. Returned pointer is only valid until
+		 *			the next read from the stream.
+		 */
+		const UINT8* readContiguous(UINT32 count)
+		{
+			if(count > (mSize - mPosition))
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+
+			if(mMemory != nullptr)
+			{
+				const UINT8* data = mMemory + mPosition;
+				mPosition += count;
+
+				return data;
+			}
+
+			bool inChunk = mPosition >= mChunkStart && (mPosition + count) <= (mChunkStart + mChunkSize);
+			if(!inChunk && count <= CHUNK_SIZE)
+			{
+				readChunk(mPosition);
+				inChunk = true;
+			}
+
+			if(inChunk)
+			{
+				const UINT8* data = mChunk + (mPosition - mChunkStart);
+				mPosition += count;
+
+				return data;
+			}
+
+			if(count > mScratchSize)
+			{
+				if(mScratch != nullptr)
+					bs_free<ScratchAlloc>(mScratch);
+
+				mScratch = (UINT8*)bs_alloc<ScratchAlloc>(count);
+				mScratchSize = count;
+			}
+
+			read(mScratch, count);
+			return mScratch;
+		}
+
+	private:
+		/**
+		 * @brief	Reads a chunk of data from the data stream, starting at the specified location.
+		 */
+		void readChunk(UINT64 position)
+		{
+			UINT64 numBytes = std::min((UINT64)CHUNK_SIZE, mSize - position);
+
+			mStream->seek((size_t)(mStreamStart + position));
+			if(mStream->read(mChunk, (size_t)numBytes) != (size_t)numBytes)
+				BS_EXCEPT(InternalErrorException, "Error decoding data. Unexpected end of stream.");
+
+			mChunkStart = position;
+			mChunkSize = numBytes;
+		}
+
+		static const UINT32 CHUNK_SIZE = 64 * 1024;
+
+		const UINT8* mMemory;
+		DataStreamPtr mStream;
+		UINT64 mSize;
+		UINT64 mPosition;
+		UINT64 mStreamStart;
+
+		UINT8* mChunk;
+		UINT64 mChunkStart;
+		UINT64 mChunkSize;
+
+		UINT8* mScratch;
+		UINT32 mScratchSize;
+	};
+
 	BinarySerializer::BinarySerializer()
 		:mLastUsedObjectId(1)
 	{
@@ -65,36 +264,19 @@ namespace BansheeEngine
 				"Destination buffer is null or not large enough.");
 		}
 
-		// Encode pointed to objects and their value types
-		UnorderedSet<UINT32> serializedObjects;
-		while(true)
+		// Encode pointed to objects and their value types. Each object is registered only once, and encoding
+		// an object may register new ones at the end of the list.
+		for(UINT32 i = 0; i < (UINT32)mObjectsToEncode.size(); i++)
 		{
-			auto iter = mObjectsToEncode.begin();
-			bool foundObjectToProcess = false;
-			for(iter; iter != mObjectsToEncode.end(); ++iter)
-			{
-				auto foundExisting = serializedObjects.find(iter->objectId);
-				if(foundExisting != serializedObjects.end())
-					continue; // Already processed
+			std::shared_ptr<IReflectable> curObject = mObjectsToEncode[i].object;
+			UINT32 curObjectid = mObjectsToEncode[i].objectId;
 
-				std::shared_ptr<IReflectable> curObject = iter->object;
-				UINT32 curObjectid = iter->objectId;
-				serializedObjects.insert(curObjectid);
-				mObjectsToEncode.erase(iter);
-
-				buffer = encodeInternal(curObject.get(), curObjectid, buffer, bufferLength, bytesWritten, flushBufferCallback);
-				if(buffer == nullptr)
-				{
-					BS_EXCEPT(InternalErrorException, 
-						"Destination buffer is null or not large enough.");
-				}
-
-				foundObjectToProcess = true;
-				break; // Need to start over as mObjectsToSerialize was possibly modified
+			buffer = encodeInternal(curObject.get(), curObjectid, buffer, bufferLength, bytesWritten, flushBufferCallback);
+			if(buffer == nullptr)
+			{
+				BS_EXCEPT(InternalErrorException, 
+					"Destination buffer is null or not large enough.");
 			}
-
-			if(!foundObjectToProcess) // We're done
-				break;
 		}
 
 		// Final flush
@@ -112,26 +294,31 @@ namespace BansheeEngine
 
 	std::shared_ptr<IReflectable> BinarySerializer::decode(UINT8* data, UINT32 dataLength)
 	{
-		mObjectMap.clear();
+		DecodeStream stream(data, dataLength);
+		return decodeObjects(stream);
+	}
+
+	std::shared_ptr<IReflectable> BinarySerializer::decode(const DataStreamPtr& stream)
+	{
+		DecodeStream decodeStream(stream);
+		return decodeObjects(decodeStream);
+	}
+
+	std::shared_ptr<IReflectable> BinarySerializer::decodeObjects(DecodeStream& stream)
+	{
+		mObjectsToDecode.clear();
+		mObjectIdToDecodeIdx.clear();
 
 		// Create empty instances of all ptr objects
-		UINT32 bytesRead = 0;
-		UINT8* dataIter = nullptr;
 		std::shared_ptr<IReflectable> rootObject = nullptr;
 		do 
 		{
-			dataIter = data + bytesRead;
-
-			if(sizeof(UINT32) > dataLength)
-			{
-				BS_EXCEPT(InternalErrorException, 
-					"Error decoding data.");
-			}
+			UINT64 objectLocation = stream.tell();
 
 			ObjectMetaData objectMetaData;
 			objectMetaData.objectMeta = 0;
 			objectMetaData.typeId = 0;
-			memcpy(&objectMetaData, dataIter, sizeof(ObjectMetaData));
+			stream.peek(&objectMetaData, sizeof(ObjectMetaData));
 
 			UINT32 objectId = 0;
 			UINT32 objectTypeId = 0;
@@ -145,26 +332,28 @@ namespace BansheeEngine
 			}
 
 			std::shared_ptr<IReflectable> object = IReflectable::createInstanceFromTypeId(objectTypeId);
-			mObjectMap.insert(std::make_pair(objectId, ObjectToDecode(objectId, object, dataIter, bytesRead)));
+
+			mObjectIdToDecodeIdx[objectId] = (UINT32)mObjectsToDecode.size();
+			mObjectsToDecode.push_back(ObjectToDecode(objectId, object, objectLocation));
 
 			if(rootObject == nullptr)
 				rootObject = object;
 
-		} while (decodeInternal(nullptr, dataIter, dataLength, bytesRead));
+		} while (decodeInternal(nullptr, stream, stream.size()));
 
 		// Now go through all of the objects and actually decode them
-		for(auto iter = mObjectMap.begin(); iter != mObjectMap.end(); ++iter)
+		for(auto& objToDecode : mObjectsToDecode)
 		{
-			ObjectToDecode& objToDecode = iter->second;
 
 			if(objToDecode.isDecoded)
 				continue;
 
-			UINT32 objectBytesRead = objToDecode.locationInFile;
-			decodeInternal(objToDecode.object, objToDecode.locationInBuffer, dataLength, objectBytesRead);
+			stream.seek(objToDecode.locationInFile);
+			decodeInternal(objToDecode.object, stream, stream.size());
 		}
 
-		mObjectMap.clear();
+		mObjectsToDecode.clear();
+		mObjectIdToDecodeIdx.clear();
 
 		return rootObject;
 	}
@@ -188,14 +377,54 @@ namespace BansheeEngine
 			ObjectMetaData objectMetaData = encodeObjectMetaData(objectId, si->getRTTIId(), isBaseClass);
 			COPY_TO_BUFFER(&objectMetaData, sizeof(ObjectMetaData))
 
-			int numFields = si->getNumFields();
-			for(int i = 0; i < numFields; i++)
+			const RTTISchema& schema = si->_getSchema();
+
+			UINT32 numFields = schema.getNumFields();
+			for(UINT32 i = 0; i < numFields; i++)
 			{
-				RTTIField* curGenericField = si->getField(i);
+				const RTTISchema::Field& schemaField = schema.getField(i);
+				RTTIField* curGenericField = schemaField.field;
+
+				// Runs of fixed size plain fields are written from a pre-built layout that already contains
+				// field meta-data, so only the values need to be filled in
+				if(schemaField.runIdx != -1)
+				{
+					const RTTISchema::PlainRun& run = schema.getRun(schemaField.runIdx);
+
+					if((*bytesWritten + run.size) > bufferLength)
+					{
+						mTotalBytesWritten += *bytesWritten;
+						buffer = flushBufferCallback(buffer - *bytesWritten, *bytesWritten, bufferLength);
+						if(buffer == nullptr)
+						{
+							si->onSerializationEnded(object);
+							return nullptr;
+						}
+
+						*bytesWritten = 0;
+					}
+
+					// If the buffer can't fit the entire run, fall through and write the fields one by one
+					if(run.size <= bufferLength)
+					{
+						memcpy(buffer, run.layout, run.size);
+
+						for(UINT32 j = 0; j < run.numFields; j++)
+						{
+							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(schema.getField(run.firstField + j).field);
+							curField->toBuffer(object, buffer + run.valueOffsets[j]);
+						}
+
+						buffer += run.size;
+						*bytesWritten += run.size;
+
+						i += run.numFields - 1;
+						continue;
+					}
+				}
 
 				// Copy field ID & other meta-data like field size and type
-				int metaData = encodeFieldMetaData(curGenericField->mUniqueId, curGenericField->getTypeSize(), 
-					curGenericField->mIsVectorType, curGenericField->mType, curGenericField->hasDynamicSize());
+				UINT32 metaData = schemaField.header;
 				COPY_TO_BUFFER(&metaData, META_SIZE)
 
 				if(curGenericField->mIsVectorType)
@@ -243,6 +472,42 @@ namespace BansheeEngine
 						{
 							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+							// Elements of fixed size are written in batches, with a single buffer check per batch
+							if(schemaField.isFixedPlainArray)
+							{
+								UINT32 typeSize = schemaField.typeSize;
+
+								UINT32 arrIdx = 0;
+								while(arrIdx < arrayNumElems)
+								{
+									UINT32 numElemsToWrite = std::min((bufferLength - *bytesWritten) / typeSize, arrayNumElems - arrIdx);
+									if(numElemsToWrite == 0)
+									{
+										mTotalBytesWritten += *bytesWritten;
+										buffer = flushBufferCallback(buffer - *bytesWritten, *bytesWritten, bufferLength);
+										if(buffer == nullptr || bufferLength < typeSize)
+										{
+											si->onSerializationEnded(object);
+											return nullptr;
+										}
+
+										*bytesWritten = 0;
+										continue;
+									}
+
+									for(UINT32 j = 0; j < numElemsToWrite; j++)
+									{
+										curField->arrayElemToBuffer(object, arrIdx + j, buffer);
+										buffer += typeSize;
+									}
+
+									*bytesWritten += numElemsToWrite * typeSize;
+									arrIdx += numElemsToWrite;
+								}
+
+								break;
+							}
+
 							for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
 							{
 								UINT32 typeSize = 0;
@@ -394,25 +659,32 @@ namespace BansheeEngine
 		return buffer;
 	}
 
-	bool BinarySerializer::decodeInternal(std::shared_ptr<IReflectable> object, UINT8* data, UINT32 dataLength, UINT32& bytesRead)
+	bool BinarySerializer::decodeInternal(std::shared_ptr<IReflectable> object, DecodeStream& stream, UINT64 dataEnd)
 	{
 		static const int META_SIZE = 4; // Meta field size
 		static const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
 		static const int DATA_BLOCK_TYPE_FIELD_SIZE = 4;
+		static const UINT32 PLAIN_ARRAY_BATCH_SIZE = 32 * 1024; // Max size of plain array elements to read at once
 
 		bool moreObjectsToProcess = false;
 
 		RTTITypeBase* si = nullptr;
+		const RTTISchema* schema = nullptr;
+		UINT32 nextFieldIdx = 0; // Index of the field expected next, if the data matches the current type layout
+
 		if(object != nullptr)
 		{
 			si = object->getRTTI();
 
 			if(si != nullptr)
+			{
 				si->onDeserializationStarted(object.get());
+				schema = &si->_getSchema();
+			}
 		}
 
-		if((bytesRead + sizeof(ObjectMetaData)) > dataLength)
+		if((stream.tell() + sizeof(ObjectMetaData)) > dataEnd)
 		{
 			BS_EXCEPT(InternalErrorException, 
 				"Error decoding data.");
@@ -421,30 +693,28 @@ namespace BansheeEngine
 		ObjectMetaData objectMetaData;
 		objectMetaData.objectMeta = 0;
 		objectMetaData.typeId = 0;
-		memcpy(&objectMetaData, data, sizeof(ObjectMetaData));
-		data += sizeof(ObjectMetaData);
-		bytesRead += sizeof(ObjectMetaData);
+		stream.read(&objectMetaData, sizeof(ObjectMetaData));
 
 		UINT32 objectId = 0;
 		UINT32 objectTypeId = 0;
 		bool objectIsBaseClass = false;
 		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
 
-		while(bytesRead < dataLength)
+		while(stream.tell() < dataEnd)
 		{
 			int metaData = -1;
 
-			if((bytesRead + META_SIZE) > dataLength)
+			if((stream.tell() + META_SIZE) > dataEnd)
 			{
 				BS_EXCEPT(InternalErrorException, 
 					"Error decoding data.");
 			}
 
-			memcpy((void*)&metaData, data, META_SIZE);
+			stream.peek((void*)&metaData, META_SIZE);
 
 			if(isObjectMetaData(metaData)) // We've reached a new object
 			{
-				if((bytesRead + sizeof(ObjectMetaData)) > dataLength)
+				if((stream.tell() + sizeof(ObjectMetaData)) > dataEnd)
 				{
 					BS_EXCEPT(InternalErrorException, 
 						"Error decoding data.");
@@ -453,7 +723,7 @@ namespace BansheeEngine
 				ObjectMetaData objMetaData;
 				objMetaData.objectMeta = 0;
 				objMetaData.typeId = 0;
-				memcpy(&objMetaData, data, sizeof(ObjectMetaData));
+				stream.peek(&objMetaData, sizeof(ObjectMetaData));
 
 				UINT32 objId = 0;
 				UINT32 objTypeId = 0;
@@ -475,10 +745,14 @@ namespace BansheeEngine
 					if(si != nullptr)
 					{
 						si->onDeserializationStarted(object.get());
+						schema = &si->_getSchema();
 					}
+					else
+						schema = nullptr;
 
-					data += sizeof(ObjectMetaData);
-					bytesRead += sizeof(ObjectMetaData);
+					nextFieldIdx = 0;
+
+					stream.skip(sizeof(ObjectMetaData));
 					continue;
 				}
 				else
@@ -495,8 +769,48 @@ namespace BansheeEngine
 				}
 			}
 
-			data += META_SIZE;
-			bytesRead += META_SIZE;
+			// Fast path for runs of fixed size plain fields. If the serialized fields match the layout of the
+			// run, all values can be read directly without looking up fields one by one.
+			if(schema != nullptr && nextFieldIdx < schema->getNumFields())
+			{
+				const RTTISchema::Field& expectedField = schema->getField(nextFieldIdx);
+				if(expectedField.runIdx != -1 && expectedField.header == (UINT32)metaData)
+				{
+					const RTTISchema::PlainRun& run = schema->getRun(expectedField.runIdx);
+					if((stream.tell() + run.size) <= dataEnd)
+					{
+						UINT64 runStart = stream.tell();
+						const UINT8* data = stream.readContiguous(run.size);
+
+						bool layoutMatches = true;
+						for(UINT32 i = 0; i < run.numFields; i++)
+						{
+							UINT32 headerOffset = run.valueOffsets[i] - META_SIZE;
+							if(memcmp(data + headerOffset, run.layout + headerOffset, META_SIZE) != 0)
+							{
+								layoutMatches = false;
+								break;
+							}
+						}
+
+						if(layoutMatches)
+						{
+							for(UINT32 i = 0; i < run.numFields; i++)
+							{
+								RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(schema->getField(run.firstField + i).field);
+								curField->fromBuffer(object.get(), (void*)(data + run.valueOffsets[i]));
+							}
+
+							nextFieldIdx = run.firstField + run.numFields;
+							continue;
+						}
+
+						stream.seek(runStart);
+					}
+				}
+			}
+
+			stream.skip(META_SIZE);
 
 			bool isArray;
 			SerializableFieldType fieldType;
@@ -507,8 +821,15 @@ namespace BansheeEngine
 			
 			RTTIField* curGenericField = nullptr;
 			
-			if(si != nullptr)
-				curGenericField = si->findField(fieldId);
+			if(schema != nullptr)
+			{
+				INT32 fieldIdx = schema->findField(fieldId);
+				if(fieldIdx != -1)
+				{
+					curGenericField = schema->getField(fieldIdx).field;
+					nextFieldIdx = (UINT32)fieldIdx + 1;
+				}
+			}
 
 			if(curGenericField != nullptr)
 			{
@@ -535,15 +856,13 @@ namespace BansheeEngine
 			int arrayNumElems = 1;
 			if(isArray)
 			{
-				if((bytesRead + NUM_ELEM_FIELD_SIZE) > dataLength)
+				if((stream.tell() + NUM_ELEM_FIELD_SIZE) > dataEnd)
 				{
 					BS_EXCEPT(InternalErrorException, 
 						"Error decoding data.");
 				}
 
-				memcpy((void*)&arrayNumElems, data, NUM_ELEM_FIELD_SIZE);
-				data += NUM_ELEM_FIELD_SIZE;
-				bytesRead += NUM_ELEM_FIELD_SIZE;
+				stream.read((void*)&arrayNumElems, NUM_ELEM_FIELD_SIZE);
 
 				if(curGenericField != nullptr)
 					curGenericField->setArraySize(object.get(), arrayNumElems);
@@ -556,22 +875,20 @@ namespace BansheeEngine
 
 						for(int i = 0; i < arrayNumElems; i++)
 						{
-							if((bytesRead + COMPLEX_TYPE_FIELD_SIZE) > dataLength)
+							if((stream.tell() + COMPLEX_TYPE_FIELD_SIZE) > dataEnd)
 							{
 								BS_EXCEPT(InternalErrorException, 
 									"Error decoding data.");
 							}
 
 							int objectId = 0;
-							memcpy(&objectId, data, COMPLEX_TYPE_FIELD_SIZE);
-							data += COMPLEX_TYPE_FIELD_SIZE;
-							bytesRead += COMPLEX_TYPE_FIELD_SIZE;
+							stream.read(&objectId, COMPLEX_TYPE_FIELD_SIZE);
 
 							if(curField != nullptr)
 							{
-								auto findObj = mObjectMap.find(objectId);
+								auto findObj = mObjectIdToDecodeIdx.find(objectId);
 
-								if(findObj == mObjectMap.end())
+								if(findObj == mObjectIdToDecodeIdx.end())
 								{
 									if(objectId != 0)
 										LOGWRN("When deserializing, object ID: " + toString(objectId) + " was found but no such object was contained in the file.");
@@ -580,13 +897,16 @@ namespace BansheeEngine
 								}
 								else
 								{
-									ObjectToDecode& objToDecode = findObj->second;
+									ObjectToDecode& objToDecode = mObjectsToDecode[findObj->second];
 
 									bool needsDecoding = (curField->getFlags() & RTTI_Flag_WeakRef) == 0 && !objToDecode.isDecoded;
 									if(needsDecoding)
 									{
-										UINT32 objectBytesRead = objToDecode.locationInFile;
-										decodeInternal(objToDecode.object, objToDecode.locationInBuffer, dataLength, objectBytesRead);
+										UINT64 returnLocation = stream.tell();
+
+										stream.seek(objToDecode.locationInFile);
+										decodeInternal(objToDecode.object, stream, stream.size());
+										stream.seek(returnLocation);
 
 										objToDecode.isDecoded = true;
 									}
@@ -604,26 +924,23 @@ namespace BansheeEngine
 
 						for(int i = 0; i < arrayNumElems; i++)
 						{
-							if((bytesRead + COMPLEX_TYPE_FIELD_SIZE) > dataLength)
+							if((stream.tell() + COMPLEX_TYPE_FIELD_SIZE) > dataEnd)
 							{
 								BS_EXCEPT(InternalErrorException, 
 									"Error decoding data.");
 							}
 
-							int complexTypeSize = 0;
 							if(curField != nullptr)
 							{
-								std::shared_ptr<IReflectable> complexType = complexTypeFromBuffer(curField, data, &complexTypeSize);
+								std::shared_ptr<IReflectable> complexType = complexTypeFromBuffer(curField, stream);
 								curField->setArrayValue(object.get(), i, *complexType);
 							}
 							else
 							{
-								memcpy(&complexTypeSize, data, COMPLEX_TYPE_FIELD_SIZE);
-								complexTypeSize += COMPLEX_TYPE_FIELD_SIZE;
+								int complexTypeSize = 0;
+								stream.read(&complexTypeSize, COMPLEX_TYPE_FIELD_SIZE);
+								stream.skip(complexTypeSize);
 							}
-
-							data += complexTypeSize;
-							bytesRead += complexTypeSize;
 						}
 						break;
 					}
@@ -631,17 +948,41 @@ namespace BansheeEngine
 					{
 						RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+						// Elements of fixed size are stored contiguously, so read them in batches
+						if(!hasDynamicSize)
+						{
+							if(curField == nullptr)
+							{
+								stream.skip((UINT64)arrayNumElems * fieldSize);
+								break;
+							}
+
+							UINT32 maxBatchSize = std::max(1U, PLAIN_ARRAY_BATCH_SIZE / std::max((UINT32)fieldSize, 1U));
+
+							int i = 0;
+							while(i < arrayNumElems)
+							{
+								UINT32 batchSize = std::min(maxBatchSize, (UINT32)(arrayNumElems - i));
+								const UINT8* data = stream.readContiguous(batchSize * fieldSize);
+
+								for(UINT32 j = 0; j < batchSize; j++)
+									curField->arrayElemFromBuffer(object.get(), i + j, (void*)(data + j * fieldSize));
+
+								i += batchSize;
+							}
+
+							break;
+						}
+
 						for(int i = 0; i < arrayNumElems; i++)
 						{
 							UINT32 typeSize = fieldSize;
 							if(hasDynamicSize)
-								memcpy(&typeSize, data, sizeof(UINT32));
+								stream.peek(&typeSize, sizeof(UINT32));
 
+							const UINT8* data = stream.readContiguous(typeSize);
 							if(curField != nullptr)
-								curField->arrayElemFromBuffer(object.get(), i, data);
-
-							data += typeSize;
-							bytesRead += typeSize;
+								curField->arrayElemFromBuffer(object.get(), i, (void*)data);
 						}
 						break;
 					}
@@ -659,22 +1000,20 @@ namespace BansheeEngine
 					{
 						RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
 
-						if((bytesRead + COMPLEX_TYPE_FIELD_SIZE) > dataLength)
+						if((stream.tell() + COMPLEX_TYPE_FIELD_SIZE) > dataEnd)
 						{
 							BS_EXCEPT(InternalErrorException, 
 								"Error decoding data.");
 						}
 
 						int objectId = 0;
-						memcpy(&objectId, data, COMPLEX_TYPE_FIELD_SIZE);
-						data += COMPLEX_TYPE_FIELD_SIZE;
-						bytesRead += COMPLEX_TYPE_FIELD_SIZE;
+						stream.read(&objectId, COMPLEX_TYPE_FIELD_SIZE);
 
 						if(curField != nullptr)
 						{
-							auto findObj = mObjectMap.find(objectId);
+							auto findObj = mObjectIdToDecodeIdx.find(objectId);
 
-							if(findObj == mObjectMap.end())
+							if(findObj == mObjectIdToDecodeIdx.end())
 							{
 								if(objectId != 0)
 									LOGWRN("When deserializing, object ID: " + toString(objectId) + " was found but no such object was contained in the file.");
@@ -683,13 +1022,16 @@ namespace BansheeEngine
 							}
 							else
 							{
-								ObjectToDecode& objToDecode = findObj->second;
+								ObjectToDecode& objToDecode = mObjectsToDecode[findObj->second];
 
 								bool needsDecoding = (curField->getFlags() & RTTI_Flag_WeakRef) == 0 && !objToDecode.isDecoded;
 								if(needsDecoding)
 								{
-									UINT32 objectBytesRead = objToDecode.locationInFile;
-									decodeInternal(objToDecode.object, objToDecode.locationInBuffer, dataLength, objectBytesRead);
+									UINT64 returnLocation = stream.tell();
+
+									stream.seek(objToDecode.locationInFile);
+									decodeInternal(objToDecode.object, stream, stream.size());
+									stream.seek(returnLocation);
 
 									objToDecode.isDecoded = true;
 								}
@@ -704,27 +1046,24 @@ namespace BansheeEngine
 					{
 						RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
 
-						if((bytesRead + COMPLEX_TYPE_FIELD_SIZE) > dataLength)
+						if((stream.tell() + COMPLEX_TYPE_FIELD_SIZE) > dataEnd)
 						{
 							BS_EXCEPT(InternalErrorException, 
 								"Error decoding data.");
 						}
 
-						int complexTypeSize = 0;
 						if(curField != nullptr)
 						{
-							std::shared_ptr<IReflectable> complexType = complexTypeFromBuffer(curField, data, &complexTypeSize);
+							std::shared_ptr<IReflectable> complexType = complexTypeFromBuffer(curField, stream);
 							curField->setValue(object.get(), *complexType);
 						}
 						else
 						{
-							memcpy(&complexTypeSize, data, COMPLEX_TYPE_FIELD_SIZE);
-							complexTypeSize += COMPLEX_TYPE_FIELD_SIZE;
+							int complexTypeSize = 0;
+							stream.read(&complexTypeSize, COMPLEX_TYPE_FIELD_SIZE);
+							stream.skip(complexTypeSize);
 						}
 
-						data += complexTypeSize;
-						bytesRead += complexTypeSize;
-
 						break;
 					}
 				case SerializableFT_Plain:
@@ -733,20 +1072,19 @@ namespace BansheeEngine
 
 						UINT32 typeSize = fieldSize;
 						if(hasDynamicSize)
-							memcpy(&typeSize, data, sizeof(UINT32));
+							stream.peek(&typeSize, sizeof(UINT32));
 
+						const UINT8* data = stream.readContiguous(typeSize);
 						if(curField != nullptr)
-							curField->fromBuffer(object.get(), data);
+							curField->fromBuffer(object.get(), (void*)data);
 
-						data += typeSize;
-						bytesRead += typeSize;
 						break;
 					}
 				case SerializableFT_DataBlock:
 					{
 						RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
 
-						if((bytesRead + DATA_BLOCK_TYPE_FIELD_SIZE) > dataLength)
+						if((stream.tell() + DATA_BLOCK_TYPE_FIELD_SIZE) > dataEnd)
 						{
 							BS_EXCEPT(InternalErrorException, 
 								"Error decoding data.");
@@ -754,28 +1092,26 @@ namespace BansheeEngine
 
 						// Data block size
 						UINT32 dataBlockSize = 0;
-						memcpy(&dataBlockSize, data, DATA_BLOCK_TYPE_FIELD_SIZE);
-						data += DATA_BLOCK_TYPE_FIELD_SIZE;
-						bytesRead += DATA_BLOCK_TYPE_FIELD_SIZE;
+						stream.read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE);
 
-						if((bytesRead + dataBlockSize) > dataLength)
+						if((stream.tell() + dataBlockSize) > dataEnd)
 						{
 							BS_EXCEPT(InternalErrorException, 
 								"Error decoding data.");
 						}
 
-						// Data block data
+						// Data block data, read directly into its final location
 						if(curField != nullptr)
 						{
-							UINT8* dataCopy = curField->allocate(object.get(), dataBlockSize); // TODO - Low priority. I need to read files better, so I
-							memcpy(dataCopy, data, dataBlockSize);		//    can just pass the buffer pointer directly without copying (possibly large amounts of data)
+							UINT8* dataCopy = curField->allocate(object.get(), dataBlockSize);
+							if(dataBlockSize > 0)
+								stream.read(dataCopy, dataBlockSize);
 
 							ManagedDataBlock value(dataCopy, dataBlockSize); // Not managed because I assume the owner class will decide whether to delete the data or keep it
 							curField->setValue(object.get(), value);
 						}
-
-						data += dataBlockSize;
-						bytesRead += dataBlockSize;
+						else
+							stream.skip(dataBlockSize);
 
 						break;
 					}
@@ -1043,22 +1379,23 @@ exit:
 		return buffer;
 	}
 
-	std::shared_ptr<IReflectable> BinarySerializer::complexTypeFromBuffer(RTTIReflectableFieldBase* field, UINT8* data, int* complexTypeSize)
+	std::shared_ptr<IReflectable> BinarySerializer::complexTypeFromBuffer(RTTIReflectableFieldBase* field, DecodeStream& stream)
 	{
 		static const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
 
-		memcpy(complexTypeSize, data, COMPLEX_TYPE_FIELD_SIZE);
-		data += COMPLEX_TYPE_FIELD_SIZE;
+		int complexTypeSize = 0;
+		stream.read(&complexTypeSize, COMPLEX_TYPE_FIELD_SIZE);
 
 		std::shared_ptr<IReflectable> emptyObject = nullptr;
-		if(*complexTypeSize > 0)
+		if(complexTypeSize > 0)
 		{
+			UINT64 complexTypeEnd = stream.tell() + complexTypeSize;
+
 			emptyObject = field->newObject();
-			UINT32 dummy = 0;
-			decodeInternal(emptyObject, data, *complexTypeSize, dummy);
-		}
+			decodeInternal(emptyObject, stream, complexTypeEnd);
 
-		*complexTypeSize += COMPLEX_TYPE_FIELD_SIZE;
+			stream.seek(complexTypeEnd);
+		}
 
 		return emptyObject;
 	}
@@ -1082,20 +1419,14 @@ exit:
 		if(object == nullptr)
 			return 0;
 
-		void* ptrAddress = (void*)object.get();
-
-		auto iterFind = mObjectAddrToId.find(ptrAddress);
-		if(iterFind == mObjectAddrToId.end())
+		auto insertResult = mObjectAddrToId.insert(std::make_pair((void*)object.get(), mLastUsedObjectId));
+		if(insertResult.second)
 		{
-			UINT32 objId = findOrCreatePersistentId(object.get());
-
-			mObjectsToEncode.push_back(ObjectToEncode(objId, object));
-			mObjectAddrToId.insert(std::make_pair(ptrAddress, objId));
-
-			return objId;
+			mLastUsedObjectId++;
+			mObjectsToEncode.push_back(ObjectToEncode(insertResult.first->second, object));
 		}
 
-		return iterFind->second;
+		return insertResult.first->second;
 	}
 }
 
@@ -0,0 +1,121 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsBoundsArray.h"
+
+namespace BansheeEngine
+{
+	BoundsArray::BoundsArray()
+		:mBuffer(nullptr), mData(nullptr), mSize(0), mCapacity(0)
+	{ }
+
+	BoundsArray::~BoundsArray()
+	{
+		if (mBuffer != nullptr)
+			bs_free(mBuffer);
+	}
+
+	UINT32 BoundsArray::add(const Bounds& bounds)
+	{
+		if (mSize == mCapacity)
+			reserve(std::max(mCapacity * 2, GROUP_SIZE * 8));
+
+		UINT32 idx = mSize++;
+		set(idx, bounds);
+
+		return idx;
+	}
+
+	void BoundsArray::set(UINT32 idx, const Bounds& bounds)
+	{
+		assert(idx < mSize);
+
+		const Sphere& sphere = bounds.getSphere();
+		const AABox& box = bounds.getBox();
+
+		Vector3 sphereCenter = sphere.getCenter();
+		Vector3 boxCenter = box.getCenter();
+		Vector3 boxExtents = box.getHalfSize();
+
+		getData(SphereCenterX)[idx] = sphereCenter.x;
+		getData(SphereCenterY)[idx] = sphereCenter.y;
+		getData(SphereCenterZ)[idx] = sphereCenter.z;
+		getData(SphereRadius)[idx] = sphere.getRadius();
+		getData(BoxCenterX)[idx] = boxCenter.x;
+		getData(BoxCenterY)[idx] = boxCenter.y;
+		getData(BoxCenterZ)[idx] = boxCenter.z;
+		getData(BoxExtentX)[idx] = Math::abs(boxExtents.x);
+		getData(BoxExtentY)[idx] = Math::abs(boxExtents.y);
+		getData(BoxExtentZ)[idx] = Math::abs(boxExtents.z);
+	}
+
+	void BoundsArray::remove(UINT32 idx)
+	{
+		assert(idx < mSize);
+
+		UINT32 lastIdx = mSize - 1;
+		for (UINT32 i = 0; i < NumComponents; i++)
+		{
+			float* data = getData((Component)i);
+
+			data[idx] = data[lastIdx];
+			data[lastIdx] = 0.0f;
+		}
+
+		mSize--;
+	}
+
+	void BoundsArray::clear()
+	{
+		if (mData != nullptr)
+			memset(mData, 0, mCapacity * NumComponents * sizeof(float));
+
+		mSize = 0;
+	}
+
+	Vector3 BoundsArray::getBoxCenter(UINT32 idx) const
+	{
+		return Vector3(getData(BoxCenterX)[idx], getData(BoxCenterY)[idx], getData(BoxCenterZ)[idx]);
+	}
+
+	AABox BoundsArray::getBox(UINT32 idx) const
+	{
+		Vector3 center = getBoxCenter(idx);
+		Vector3 extents(getData(BoxExtentX)[idx], getData(BoxExtentY)[idx], getData(BoxExtentZ)[idx]);
+
+		return AABox(center - extents, center + extents);
+	}
+
+	Sphere BoundsArray::getSphere(UINT32 idx) const
+	{
+		Vector3 center(getData(SphereCenterX)[idx], getData(SphereCenterY)[idx], getData(SphereCenterZ)[idx]);
+
+		return Sphere(center, getData(SphereRadius)[idx]);
+	}
+
+	void BoundsArray::reserve(UINT32 capacity)
+	{
+		// Keep every array a multiple of the group size, so each array stays aligned and groups never straddle arrays
+		capacity = (capacity + GROUP_SIZE - 1) & ~(GROUP_SIZE - 1);
+		if (capacity <= mCapacity)
+			return;
+
+		// Allocating extra so data can be 32 byte aligned regardless of what bs_alloc returns
+		UINT32 dataSize = capacity * NumComponents * sizeof(float);
+		UINT8* buffer = (UINT8*)bs_alloc(dataSize + 31);
+		float* data = (float*)(((size_t)buffer + 31) & ~(size_t)31);
+		memset(data, 0, dataSize);
+
+		if (mData != nullptr)
+		{
+			for (UINT32 i = 0; i < NumComponents; i++)
+				memcpy(data + i * capacity, mData + i * mCapacity, mSize * sizeof(float));
+
+			bs_free(mBuffer);
+		}
+
+		mBuffer = buffer;
+		mData = data;
+		mCapacity = capacity;
+	}
+}
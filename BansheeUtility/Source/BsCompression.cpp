@@ -0,0 +1,224 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsCompression.h"
+
+namespace BansheeEngine
+{
+	static const UINT32 LZ4_MIN_MATCH = 4;
+	static const UINT32 LZ4_LAST_LITERALS = 5; // Last bytes of a block must always be literals
+	static const UINT32 LZ4_MATCH_FIND_LIMIT = 12; // Last match must start at least this many bytes before the end of a block
+	static const UINT32 LZ4_MAX_OFFSET = 65535;
+	static const UINT32 LZ4_HASH_BITS = 12;
+
+	static UINT32 lz4_read32(const UINT8* data)
+	{
+		UINT32 value;
+		memcpy(&value, data, sizeof(value));
+
+		return value;
+	}
+
+	static UINT32 lz4_hash(UINT32 sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - LZ4_HASH_BITS);
+	}
+
+	/**
+	 * @brief	Writes the remainder of a literal or match length that doesn't fit in the sequence token.
+	 */
+	static bool lz4_writeLength(UINT8*& dst, const UINT8* dstEnd, UINT32 length)
+	{
+		while (length >= 255)
+		{
+			if (dst >= dstEnd)
+				return false;
+
+			*dst++ = 255;
+			length -= 255;
+		}
+
+		if (dst >= dstEnd)
+			return false;
+
+		*dst++ = (UINT8)length;
+		return true;
+	}
+
+	/**
+	 * @brief	Reads the remainder of a literal or match length that didn't fit in the sequence token.
+	 */
+	static bool lz4_readLength(const UINT8*& src, const UINT8* srcEnd, UINT32& length)
+	{
+		UINT8 value;
+		do
+		{
+			if (src >= srcEnd)
+				return false;
+
+			value = *src++;
+			length += value;
+		} while (value == 255);
+
+		return true;
+	}
+
+	/**
+	 * @brief	Writes a single sequence, consisting of a number of literals optionally followed by a match.
+	 *			Provide zero match length for the last sequence in the block.
+	 */
+	static bool lz4_writeSequence(UINT8*& dst, const UINT8* dstEnd, const UINT8* literals, UINT32 numLiterals,
+		UINT32 matchOffset, UINT32 matchLength)
+	{
+		if (dst >= dstEnd)
+			return false;
+
+		UINT8* token = dst++;
+		*token = (UINT8)(std::min(numLiterals, 15U) << 4);
+
+		if (numLiterals >= 15)
+		{
+			if (!lz4_writeLength(dst, dstEnd, numLiterals - 15))
+				return false;
+		}
+
+		if ((UINT32)(dstEnd - dst) < numLiterals)
+			return false;
+
+		if (numLiterals > 0)
+		{
+			memcpy(dst, literals, numLiterals);
+			dst += numLiterals;
+		}
+
+		if (matchLength == 0)
+			return true;
+
+		if ((UINT32)(dstEnd - dst) < 2)
+			return false;
+
+		*dst++ = (UINT8)(matchOffset & 0xFF);
+		*dst++ = (UINT8)(matchOffset >> 8);
+
+		UINT32 encodedMatchLength = matchLength - LZ4_MIN_MATCH;
+		*token |= (UINT8)std::min(encodedMatchLength, 15U);
+
+		if (encodedMatchLength >= 15)
+			return lz4_writeLength(dst, dstEnd, encodedMatchLength - 15);
+
+		return true;
+	}
+
+	UINT32 Compression::getMaxCompressedSize(UINT32 srcSize)
+	{
+		return srcSize + srcSize / 255 + 16;
+	}
+
+	UINT32 Compression::compress(const UINT8* src, UINT32 srcSize, UINT8* dst, UINT32 dstSize)
+	{
+		UINT8* dstPtr = dst;
+		const UINT8* dstEnd = dst + dstSize;
+
+		UINT32 anchor = 0;
+		if (srcSize > LZ4_MATCH_FIND_LIMIT)
+		{
+			// Positions are offset by one so that zero can mark an empty entry
+			UINT32 hashTable[1 << LZ4_HASH_BITS];
+			memset(hashTable, 0, sizeof(hashTable));
+
+			UINT32 matchEndLimit = srcSize - LZ4_LAST_LITERALS;
+			UINT32 matchStartLimit = srcSize - LZ4_MATCH_FIND_LIMIT;
+
+			UINT32 pos = 0;
+			while (pos < matchStartLimit)
+			{
+				UINT32 sequence = lz4_read32(src + pos);
+				UINT32 hash = lz4_hash(sequence);
+
+				UINT32 candidate = hashTable[hash];
+				hashTable[hash] = pos + 1;
+
+				if (candidate == 0 || (pos - (candidate - 1)) > LZ4_MAX_OFFSET || lz4_read32(src + candidate - 1) != sequence)
+				{
+					pos++;
+					continue;
+				}
+
+				UINT32 matchPos = candidate - 1;
+				UINT32 matchLength = LZ4_MIN_MATCH;
+				while ((pos + matchLength) < matchEndLimit && src[matchPos + matchLength] == src[pos + matchLength])
+					matchLength++;
+
+				if (!lz4_writeSequence(dstPtr, dstEnd, src + anchor, pos - anchor, pos - matchPos, matchLength))
+					return 0;
+
+				pos += matchLength;
+				anchor = pos;
+			}
+		}
+
+		if (!lz4_writeSequence(dstPtr, dstEnd, src + anchor, srcSize - anchor, 0, 0))
+			return 0;
+
+		return (UINT32)(dstPtr - dst);
+	}
+
+	bool Compression::decompress(const UINT8* src, UINT32 srcSize, UINT8* dst, UINT32 dstSize)
+	{
+		const UINT8* srcEnd = src + srcSize;
+		UINT8* dstPtr = dst;
+		UINT8* dstEnd = dst + dstSize;
+
+		while (src < srcEnd)
+		{
+			UINT8 token = *src++;
+
+			UINT32 numLiterals = token >> 4;
+			if (numLiterals == 15)
+			{
+				if (!lz4_readLength(src, srcEnd, numLiterals))
+					return false;
+			}
+
+			if ((UINT32)(srcEnd - src) < numLiterals || (UINT32)(dstEnd - dstPtr) < numLiterals)
+				return false;
+
+			memcpy(dstPtr, src, numLiterals);
+			src += numLiterals;
+			dstPtr += numLiterals;
+
+			// Last sequence has no match
+			if (src == srcEnd)
+				break;
+
+			if ((UINT32)(srcEnd - src) < 2)
+				return false;
+
+			UINT32 matchOffset = src[0] | (src[1] << 8);
+			src += 2;
+
+			if (matchOffset == 0 || matchOffset > (UINT32)(dstPtr - dst))
+				return false;
+
+			UINT32 matchLength = token & 0x0F;
+			if (matchLength == 15)
+			{
+				if (!lz4_readLength(src, srcEnd, matchLength))
+					return false;
+			}
+
+			matchLength += LZ4_MIN_MATCH;
+			if ((UINT32)(dstEnd - dstPtr) < matchLength)
+				return false;
+
+			// Match may overlap the output being written, so copy byte by byte
+			const UINT8* match = dstPtr - matchOffset;
+			for (UINT32 i = 0; i < matchLength; i++)
+				dstPtr[i] = match[i];
+
+			dstPtr += matchLength;
+		}
+
+		return dstPtr == dstEnd;
+	}
+}
@@ -5,9 +5,144 @@
 #include "BsAABox.h"
 #include "BsSphere.h"
 #include "BsPlane.h"
+#include "BsBoundsArray.h"
+
+#if BS_SIMD_AVX
+#include <immintrin.h>
+#elif BS_SIMD_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace BansheeEngine
 {
+	/**
+	 * @brief	Plane data used by the batch intersection test.
+	 */
+	struct CullPlane
+	{
+		float normalX, normalY, normalZ, d;
+		float absNormalX, absNormalY, absNormalZ;
+	};
+
+	/**
+	 * @brief	Tests spheres of a group of BoundsArray::GROUP_SIZE bounds starting at the specified offset against a
+	 *			single plane. Returns the provided mask with bits cleared for entries fully behind the plane.
+	 */
+	static UINT32 testSpheres(const CullPlane& plane, const float* const* data, UINT32 offset, UINT32 mask)
+	{
+#if BS_SIMD_AVX
+		__m256 dist = _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::SphereCenterX] + offset), _mm256_broadcast_ss(&plane.normalX));
+		dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::SphereCenterY] + offset), _mm256_broadcast_ss(&plane.normalY)));
+		dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::SphereCenterZ] + offset), _mm256_broadcast_ss(&plane.normalZ)));
+		dist = _mm256_add_ps(dist, _mm256_load_ps(data[BoundsArray::SphereRadius] + offset));
+
+		__m256 visible = _mm256_cmp_ps(dist, _mm256_broadcast_ss(&plane.d), _CMP_GE_OQ);
+		return mask & (UINT32)_mm256_movemask_ps(visible);
+#elif BS_SIMD_SSE2
+		__m128 normalX = _mm_set1_ps(plane.normalX);
+		__m128 normalY = _mm_set1_ps(plane.normalY);
+		__m128 normalZ = _mm_set1_ps(plane.normalZ);
+		__m128 d = _mm_set1_ps(plane.d);
+
+		UINT32 visibleMask = 0;
+		for (UINT32 i = 0; i < BoundsArray::GROUP_SIZE; i += 4)
+		{
+			UINT32 idx = offset + i;
+
+			__m128 dist = _mm_mul_ps(_mm_load_ps(data[BoundsArray::SphereCenterX] + idx), normalX);
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(data[BoundsArray::SphereCenterY] + idx), normalY));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(data[BoundsArray::SphereCenterZ] + idx), normalZ));
+			dist = _mm_add_ps(dist, _mm_load_ps(data[BoundsArray::SphereRadius] + idx));
+
+			visibleMask |= (UINT32)_mm_movemask_ps(_mm_cmpge_ps(dist, d)) << i;
+		}
+
+		return mask & visibleMask;
+#else
+		for (UINT32 i = 0; i < BoundsArray::GROUP_SIZE; i++)
+		{
+			if ((mask & (1 << i)) == 0)
+				continue;
+
+			UINT32 idx = offset + i;
+
+			float dist = data[BoundsArray::SphereCenterX][idx] * plane.normalX;
+			dist += data[BoundsArray::SphereCenterY][idx] * plane.normalY;
+			dist += data[BoundsArray::SphereCenterZ][idx] * plane.normalZ;
+			dist += data[BoundsArray::SphereRadius][idx];
+
+			if (dist < plane.d)
+				mask &= ~(1 << i);
+		}
+
+		return mask;
+#endif
+	}
+
+	/**
+	 * @brief	Tests boxes of a group of BoundsArray::GROUP_SIZE bounds starting at the specified offset against a
+	 *			single plane. Returns the provided mask with bits cleared for entries fully behind the plane.
+	 */
+	static UINT32 testBoxes(const CullPlane& plane, const float* const* data, UINT32 offset, UINT32 mask)
+	{
+#if BS_SIMD_AVX
+		__m256 dist = _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::BoxCenterX] + offset), _mm256_broadcast_ss(&plane.normalX));
+		dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::BoxCenterY] + offset), _mm256_broadcast_ss(&plane.normalY)));
+		dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::BoxCenterZ] + offset), _mm256_broadcast_ss(&plane.normalZ)));
+		dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::BoxExtentX] + offset), _mm256_broadcast_ss(&plane.absNormalX)));
+		dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::BoxExtentY] + offset), _mm256_broadcast_ss(&plane.absNormalY)));
+		dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_load_ps(data[BoundsArray::BoxExtentZ] + offset), _mm256_broadcast_ss(&plane.absNormalZ)));
+
+		__m256 visible = _mm256_cmp_ps(dist, _mm256_broadcast_ss(&plane.d), _CMP_GE_OQ);
+		return mask & (UINT32)_mm256_movemask_ps(visible);
+#elif BS_SIMD_SSE2
+		__m128 normalX = _mm_set1_ps(plane.normalX);
+		__m128 normalY = _mm_set1_ps(plane.normalY);
+		__m128 normalZ = _mm_set1_ps(plane.normalZ);
+		__m128 absNormalX = _mm_set1_ps(plane.absNormalX);
+		__m128 absNormalY = _mm_set1_ps(plane.absNormalY);
+		__m128 absNormalZ = _mm_set1_ps(plane.absNormalZ);
+		__m128 d = _mm_set1_ps(plane.d);
+
+		UINT32 visibleMask = 0;
+		for (UINT32 i = 0; i < BoundsArray::GROUP_SIZE; i += 4)
+		{
+			UINT32 idx = offset + i;
+
+			__m128 dist = _mm_mul_ps(_mm_load_ps(data[BoundsArray::BoxCenterX] + idx), normalX);
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(data[BoundsArray::BoxCenterY] + idx), normalY));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(data[BoundsArray::BoxCenterZ] + idx), normalZ));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(data[BoundsArray::BoxExtentX] + idx), absNormalX));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(data[BoundsArray::BoxExtentY] + idx), absNormalY));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps(data[BoundsArray::BoxExtentZ] + idx), absNormalZ));
+
+			visibleMask |= (UINT32)_mm_movemask_ps(_mm_cmpge_ps(dist, d)) << i;
+		}
+
+		return mask & visibleMask;
+#else
+		for (UINT32 i = 0; i < BoundsArray::GROUP_SIZE; i++)
+		{
+			if ((mask & (1 << i)) == 0)
+				continue;
+
+			UINT32 idx = offset + i;
+
+			float dist = data[BoundsArray::BoxCenterX][idx] * plane.normalX;
+			dist += data[BoundsArray::BoxCenterY][idx] * plane.normalY;
+			dist += data[BoundsArray::BoxCenterZ][idx] * plane.normalZ;
+			dist += data[BoundsArray::BoxExtentX][idx] * plane.absNormalX;
+			dist += data[BoundsArray::BoxExtentY][idx] * plane.absNormalY;
+			dist += data[BoundsArray::BoxExtentZ][idx] * plane.absNormalZ;
+
+			if (dist < plane.d)
+				mask &= ~(1 << i);
+		}
+
+		return mask;
+#endif
+	}
+
 	ConvexVolume::ConvexVolume(const Vector<Plane>& planes)
 		:mPlanes(planes)
 	{ }
@@ -48,4 +183,97 @@ namespace BansheeEngine
 
 		return true;
 	}
+
+	bool ConvexVolume::contains(const AABox& box) const
+	{
+		Vector3 center = box.getCenter();
+		Vector3 extents = box.getHalfSize();
+		Vector3 absExtents(Math::abs(extents.x), Math::abs(extents.y), Math::abs(extents.z));
+
+		for (auto& plane : mPlanes)
+		{
+			float dist = center.dot(plane.normal) - plane.d;
+
+			float effectiveRadius = absExtents.x * Math::abs(plane.normal.x);
+			effectiveRadius += absExtents.y * Math::abs(plane.normal.y);
+			effectiveRadius += absExtents.z * Math::abs(plane.normal.z);
+
+			if (dist < effectiveRadius)
+				return false;
+		}
+
+		return true;
+	}
+
+	void ConvexVolume::intersects(const BoundsArray& bounds, UINT32* visibility, UINT8* planeCache) const
+	{
+		static_assert(BoundsArray::GROUP_SIZE == 8, "Visibility mask packing assumes eight entries per group.");
+
+		UINT32 numPlanes = (UINT32)mPlanes.size();
+		UINT32 numGroups = bounds.getNumGroups();
+		if (numGroups == 0)
+			return;
+
+		Vector<CullPlane> planes(numPlanes);
+		for (UINT32 i = 0; i < numPlanes; i++)
+		{
+			const Plane& plane = mPlanes[i];
+
+			planes[i].normalX = plane.normal.x;
+			planes[i].normalY = plane.normal.y;
+			planes[i].normalZ = plane.normal.z;
+			planes[i].d = plane.d;
+			planes[i].absNormalX = Math::abs(plane.normal.x);
+			planes[i].absNormalY = Math::abs(plane.normal.y);
+			planes[i].absNormalZ = Math::abs(plane.normal.z);
+		}
+
+		const float* data[BoundsArray::NumComponents];
+		for (UINT32 i = 0; i < BoundsArray::NumComponents; i++)
+			data[i] = bounds.getData((BoundsArray::Component)i);
+
+		memset(visibility, 0, ((bounds.size() + 31) / 32) * sizeof(UINT32));
+		for (UINT32 group = 0; group < numGroups; group++)
+		{
+			UINT32 firstPlane = 0;
+			if (planeCache != nullptr && planeCache[group] < numPlanes)
+				firstPlane = planeCache[group];
+
+			// Padding entries in the last group start out rejected, so they don't prevent an early exit
+			UINT32 mask = 0xFF;
+			UINT32 numInGroup = bounds.size() - group * BoundsArray::GROUP_SIZE;
+			if (numInGroup < BoundsArray::GROUP_SIZE)
+				mask = (1 << numInGroup) - 1;
+
+			// Test the plane that rejected the group last time first, then the rest in order. Spheres are tested
+			// first as they're cheaper, and boxes only for entries whose spheres intersect the volume.
+			UINT32 offset = group * BoundsArray::GROUP_SIZE;
+			for (UINT32 pass = 0; pass < 2 && mask != 0; pass++)
+			{
+				for (UINT32 i = 0; i < numPlanes; i++)
+				{
+					UINT32 planeIdx;
+					if (i == 0)
+						planeIdx = firstPlane;
+					else
+						planeIdx = i <= firstPlane ? i - 1 : i;
+
+					if (pass == 0)
+						mask = testSpheres(planes[planeIdx], data, offset, mask);
+					else
+						mask = testBoxes(planes[planeIdx], data, offset, mask);
+
+					if (mask == 0)
+					{
+						if (planeCache != nullptr)
+							planeCache[group] = (UINT8)planeIdx;
+
+						break;
+					}
+				}
+			}
+
+			visibility[group / 4] |= mask << ((group % 4) * 8);
+		}
+	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "BsDataStream.h"
 #include "BsDebug.h"
 #include "BsException.h"
+#include "BsMemoryMappedFile.h"
 
 namespace BansheeEngine 
 {
@@ -56,8 +57,8 @@ namespace BansheeEngine
 		return result.str();
 	}
 
-    MemoryDataStream::MemoryDataStream(void* memory, size_t inSize)
-		: DataStream(READ | WRITE), mData(nullptr)
+    MemoryDataStream::MemoryDataStream(void* memory, size_t inSize, bool freeOnClose)
+		: DataStream(READ | WRITE), mData(nullptr), mFreeOnClose(freeOnClose)
     {
         mData = mPos = static_cast<UINT8*>(memory);
         mSize = inSize;
@@ -67,7 +68,7 @@ namespace BansheeEngine
     }
 
     MemoryDataStream::MemoryDataStream(DataStream& sourceStream)
-        : DataStream(READ | WRITE), mData(nullptr)
+        : DataStream(READ | WRITE), mData(nullptr), mFreeOnClose(true)
     {
         // Copy data from incoming stream
         mSize = sourceStream.size();
@@ -80,7 +81,7 @@ namespace BansheeEngine
     }
 
     MemoryDataStream::MemoryDataStream(const DataStreamPtr& sourceStream)
-        :DataStream(READ | WRITE), mData(nullptr)
+        :DataStream(READ | WRITE), mData(nullptr), mFreeOnClose(true)
     {
         // Copy data from incoming stream
         mSize = sourceStream->size();
@@ -161,11 +162,37 @@ namespace BansheeEngine
     {
         if (mData != nullptr)
         {
-            bs_free(mData);
+			if (mFreeOnClose)
+				bs_free(mData);
+
             mData = nullptr;
         }
     }
 
+	MemoryMappedDataStream::MemoryMappedDataStream(const MemoryMappedFilePtr& file, size_t offset, size_t size)
+		:MemoryDataStream(const_cast<UINT8*>(file->getData()) + offset, size, false), mFile(file)
+	{
+		assert((offset + size) <= file->getSize());
+
+		mAccess = READ;
+	}
+
+	MemoryMappedDataStream::~MemoryMappedDataStream()
+	{
+		close();
+	}
+
+	size_t MemoryMappedDataStream::write(const void* buf, size_t count)
+	{
+		return 0;
+	}
+
+	void MemoryMappedDataStream::close()
+	{
+		MemoryDataStream::close();
+		mFile = nullptr;
+	}
+
     FileDataStream::FileDataStream(std::shared_ptr<std::ifstream> s, bool freeOnClose)
         : DataStream(READ), mpInStream(s), mpFStreamRO(s), mpFStream(0), mFreeOnClose(freeOnClose)
     {
@@ -7,8 +7,8 @@
 #include "BsIReflectable.h"
 #include "BsBinarySerializer.h"
 #include "BsPath.h"
-
-#include <numeric>
+#include "BsFileSystem.h"
+#include "BsDataStream.h"
 
 using namespace std::placeholders;
 
@@ -38,27 +38,13 @@ namespace BansheeEngine
 
 	std::shared_ptr<IReflectable> FileSerializer::decode(const Path& fileLocation)
 	{
-		mInputStream.open(fileLocation.toString().c_str(), std::ios::in | std::ios::ate | std::ios::binary);
-		
-		std::streamoff fileSize = mInputStream.tellg();
-		if(fileSize > std::numeric_limits<UINT32>::max())
-		{
-			BS_EXCEPT(InternalErrorException, 
-				"File size is larger that UINT32 can hold. Ask a programmer to use a bigger data type.");
-		}
-
-		UINT8* readBuffer = (UINT8*)bs_alloc<ScratchAlloc>((UINT32)fileSize); // TODO - Low priority. Consider upgrading BinarySerializer so we don't have to read everything at once
-
-		mInputStream.seekg(0, std::ios::beg);
-		mInputStream.read((char*)readBuffer, fileSize);
+		DataStreamPtr stream = FileSystem::openFile(fileLocation, true);
 
+		// Data is streamed from the file in chunks, so the file is never fully loaded in memory
 		BinarySerializer bs;
-		std::shared_ptr<IReflectable> object = bs.decode(readBuffer, (UINT32)fileSize);
-
-		mInputStream.close();
-		mInputStream.clear();
+		std::shared_ptr<IReflectable> object = bs.decode(stream);
 
-		bs_free<ScratchAlloc>(readBuffer);
+		stream->close();
 
 		return object;
 	}
@@ -6,30 +6,49 @@
 
 namespace BansheeEngine
 {
-	FrameAlloc::MemBlock::MemBlock(UINT32 size)
-		:mData(nullptr), mFreePtr(0), mSize(size)
-	{ }
-
-	FrameAlloc::MemBlock::~MemBlock()
-	{ }
-
-	UINT8* FrameAlloc::MemBlock::alloc(UINT8 amount)
+	/**
+	 * @brief	Chunk of memory a thread reserved from a frame allocator, which it allocates from without synchronization.
+	 */
+	struct FrameAllocThreadChunk
 	{
-		UINT8* freePtr = &mData[mFreePtr];
-		mFreePtr += amount;
-
-		return freePtr;
+		UINT64 allocId; /**< Identifier of the frame allocator the chunk belongs to. Zero if chunk is not in use. */
+		UINT64 frameIdx; /**< Frame the chunk was reserved in. Chunk is invalid once the allocator is cleared. */
+		UINT8* freePtr;
+		UINT8* end;
+	};
+
+	/**
+	 * @brief	Number of frame allocators a single thread can hold chunks for at once. Allocators whose identifiers map
+	 *			to the same slot will keep replacing each other's chunks, which is correct but wastes memory.
+	 */
+	static const UINT32 NUM_THREAD_CHUNKS = 4;
+
+	static BS_THREADLOCAL FrameAllocThreadChunk ThreadChunks[NUM_THREAD_CHUNKS];
+	static std::atomic<UINT64> NextFrameAllocId(1);
+
+	/**
+	 * @brief	Rounds the size up to a multiple of 16.
+	 */
+	static UINT32 alignSize(UINT32 size)
+	{
+		return (size + 15) & ~15;
 	}
 
-	void FrameAlloc::MemBlock::clear()
+	/**
+	 * @brief	Rounds the address up to the specified alignment. Alignment must be a power of two.
+	 */
+	static UINT8* alignPtr(UINT8* ptr, UINT32 alignment)
 	{
-		mFreePtr = 0;
+		return (UINT8*)(((size_t)ptr + alignment - 1) & ~(size_t)(alignment - 1));
 	}
 
-	FrameAlloc::FrameAlloc(UINT32 blockSize)
-		:mTotalAllocBytes(0), mFreeBlock(nullptr), mBlockSize(blockSize)
+	FrameAlloc::FrameAlloc(UINT32 blockSize, UINT32 chunkSize)
+		:mId(NextFrameAllocId.fetch_add(1)), mFrameIdx(0), mBlockSize(alignSize(blockSize)), mChunkSize(alignSize(chunkSize)),
+		mCurrentBlockIdx(0), mNumBytesReserved(0), mLastFrameUsage(0), mPeakFrameUsage(0), mTotalFrameUsage(0), mNumFrames(0),
+		mTotalAllocBytes(0)
 	{
-		allocBlock(mBlockSize);
+		mBlocks.push_back(allocBlock(mBlockSize));
+		mCurrentBlock.store(mBlocks[0], std::memory_order_relaxed);
 	}
 
 	FrameAlloc::~FrameAlloc()
@@ -38,39 +57,63 @@ namespace BansheeEngine
 			deallocBlock(block);
 	}
 
-	UINT8* FrameAlloc::alloc(UINT32 amount)
+	UINT8* FrameAlloc::alloc(UINT32 amount, UINT32 alignment)
 	{
+		assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
 #if BS_DEBUG_MODE
-		amount += sizeof(UINT32);
+		UINT32 headerSize = sizeof(UINT32);
+#else
+		UINT32 headerSize = 0;
 #endif
 
-		UINT32 freeMem = mFreeBlock->mSize - mFreeBlock->mFreePtr;
-		if(amount > freeMem)
-			allocBlock(amount);
-
-		UINT8* data = mFreeBlock->alloc(amount);
+		UINT8* data = nullptr;
+		UINT32 maxSize = amount + headerSize + alignment - 1;
+		if (maxSize > (mChunkSize / 4))
+		{
+			UINT8* memory = allocFromBlocks(alignSize(maxSize));
+			data = alignPtr(memory + headerSize, alignment);
+		}
+		else
+		{
+			FrameAllocThreadChunk& chunk = ThreadChunks[mId % NUM_THREAD_CHUNKS];
+			if (chunk.allocId == mId && chunk.frameIdx == mFrameIdx)
+			{
+				data = alignPtr(chunk.freePtr + headerSize, alignment);
+				if ((data + amount) > chunk.end)
+					data = nullptr;
+			}
+
+			if (data == nullptr) // Reserve a new chunk. Any remaining space in the previous one is lost until next "clear"
+			{
+				chunk.allocId = mId;
+				chunk.frameIdx = mFrameIdx;
+				chunk.freePtr = allocFromBlocks(mChunkSize);
+				chunk.end = chunk.freePtr + mChunkSize;
+
+				data = alignPtr(chunk.freePtr + headerSize, alignment);
+			}
+
+			chunk.freePtr = data + amount;
+		}
 
 #if BS_DEBUG_MODE
 		mTotalAllocBytes += amount;
+		memcpy(data - sizeof(UINT32), &amount, sizeof(UINT32));
+#endif
 
-		UINT32* storedSize = reinterpret_cast<UINT32*>(data);
-		*storedSize = amount;
-
-		return data + sizeof(UINT32);
-#else
 		return data;
-#endif
 	}
 
 	void FrameAlloc::dealloc(UINT8* data)
 	{
 		// Dealloc is only used for debug and can be removed if needed. All the actual deallocation
 		// happens in "clear"
-			
+
 #if BS_DEBUG_MODE
-		data -= sizeof(UINT32);
-		UINT32* storedSize = reinterpret_cast<UINT32*>(data);
-		mTotalAllocBytes -= *storedSize;
+		UINT32 storedSize = 0;
+		memcpy(&storedSize, data - sizeof(UINT32), sizeof(UINT32));
+		mTotalAllocBytes -= storedSize;
 #endif
 	}
 
@@ -81,17 +124,64 @@ namespace BansheeEngine
 			BS_EXCEPT(InvalidStateException, "Not all frame allocated bytes were properly released.");
 #endif
 
-		// Merge all blocks into one
-		UINT32 totalBytes = 0;
-		for(auto& block : mBlocks)
+		// Blocks past the current one were never allocated from this frame
+		UINT32 frameUsage = 0;
+		for (UINT32 i = 0; i <= mCurrentBlockIdx; i++)
 		{
-			totalBytes += block->mSize;
-			deallocBlock(block);
+			MemBlock* block = mBlocks[i];
+
+			frameUsage += std::min(block->freePtr.load(std::memory_order_relaxed), block->size);
+			block->freePtr.store(0, std::memory_order_relaxed);
 		}
 
-		mBlocks.clear();
-			
-		allocBlock(totalBytes);			
+		mLastFrameUsage = frameUsage;
+		mPeakFrameUsage = std::max(mPeakFrameUsage, frameUsage);
+		mTotalFrameUsage += frameUsage;
+		mNumFrames++;
+
+		// Invalidates all per-thread chunks
+		mFrameIdx++;
+
+		mCurrentBlockIdx = 0;
+		mCurrentBlock.store(mBlocks[0], std::memory_order_release);
+	}
+
+	UINT32 FrameAlloc::getAverageFrameUsage() const
+	{
+		if (mNumFrames == 0)
+			return 0;
+
+		return (UINT32)(mTotalFrameUsage / mNumFrames);
+	}
+
+	UINT8* FrameAlloc::allocFromBlocks(UINT32 size)
+	{
+		while (true)
+		{
+			MemBlock* block = mCurrentBlock.load(std::memory_order_acquire);
+
+			UINT32 offset = block->freePtr.fetch_add(size, std::memory_order_relaxed);
+			if (offset <= block->size && size <= (block->size - offset))
+				return block->data + offset;
+
+			advanceBlock(block, size);
+		}
+	}
+
+	void FrameAlloc::advanceBlock(MemBlock* block, UINT32 size)
+	{
+		BS_LOCK_MUTEX(mBlockMutex);
+
+		if (mCurrentBlock.load(std::memory_order_relaxed) != block)
+			return;
+
+		// Reuse a block kept from previous frames if it's large enough, otherwise insert a new one in front of it
+		UINT32 nextBlockIdx = mCurrentBlockIdx + 1;
+		if (nextBlockIdx == (UINT32)mBlocks.size() || mBlocks[nextBlockIdx]->size < size)
+			mBlocks.insert(mBlocks.begin() + nextBlockIdx, allocBlock(size));
+
+		mCurrentBlockIdx = nextBlockIdx;
+		mCurrentBlock.store(mBlocks[nextBlockIdx], std::memory_order_release);
 	}
 
 	FrameAlloc::MemBlock* FrameAlloc::allocBlock(UINT32 wantedSize)
@@ -100,14 +190,16 @@ namespace BansheeEngine
 		if(wantedSize > blockSize)
 			blockSize = wantedSize;
 
-		UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(bs_alloc(blockSize + sizeof(MemBlock)));
-		MemBlock* newBlock = new (data) MemBlock(blockSize);
-		data += sizeof(MemBlock);
-		newBlock->mData = data;
+		// Allocating extra so block data can be 16 byte aligned regardless of what bs_alloc returns
+		UINT32 headerSize = alignSize(sizeof(MemBlock));
+		UINT8* memory = (UINT8*)bs_alloc(headerSize + blockSize + 15);
 
-		mBlocks.push_back(newBlock);
-		mFreeBlock = newBlock; // If previous block had some empty space it is lost until next "clear"
+		MemBlock* newBlock = new (memory) MemBlock();
+		newBlock->data = alignPtr(memory + headerSize, 16);
+		newBlock->size = blockSize;
+		newBlock->freePtr.store(0, std::memory_order_relaxed);
 
+		mNumBytesReserved += blockSize;
 		return newBlock;
 	}
 
@@ -116,4 +208,4 @@ namespace BansheeEngine
 		block->~MemBlock();
 		bs_free(block);
 	}
-}
\ No newline at end of file
+}
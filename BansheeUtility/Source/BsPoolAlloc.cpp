@@ -0,0 +1,388 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Sizes of blocks for each size class, including the block header.
+	 */
+	static const UINT32 SIZE_CLASSES[] = { 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 768, 1024 };
+	static const UINT32 NUM_SIZE_CLASSES = sizeof(SIZE_CLASSES) / sizeof(SIZE_CLASSES[0]);
+	static const UINT32 MAX_BLOCK_SIZE = 1024;
+
+	/**
+	 * @brief	Size class index assigned to allocations that were passed to malloc.
+	 */
+	static const UINT32 LARGE_ALLOC_CLASS = (UINT32)-1;
+
+	/**
+	 * @brief	Size of memory chunks blocks are carved out of.
+	 */
+	static const UINT32 SPAN_SIZE = 64 * 1024;
+
+	/**
+	 * @brief	Number of blocks moved between thread caches and the shared free list at once.
+	 */
+	static const UINT32 TRANSFER_BATCH_SIZE = 32;
+
+	/**
+	 * @brief	Maximum number of free blocks per size class a thread may keep before returning some.
+	 */
+	static const UINT32 MAX_CACHED_BLOCKS = TRANSFER_BATCH_SIZE * 2;
+
+	/**
+	 * @brief	Header stored in front of each allocation. Size is a multiple of 16 so user memory stays 16 byte aligned.
+	 */
+	struct PoolBlockHeader
+	{
+		UINT32 sizeClass;
+		UINT32 size; /**< Size of the entire block, including the header. */
+		UINT64 padding;
+	};
+
+	static const UINT32 HEADER_SIZE = sizeof(PoolBlockHeader);
+
+	/**
+	 * @brief	Free block, stored in the memory of the block itself.
+	 */
+	struct PoolFreeBlock
+	{
+		PoolFreeBlock* next;
+	};
+
+	/**
+	 * @brief	Spin lock that only contains types with constant initialization, so it's usable
+	 *			during static initialization.
+	 */
+	struct PoolLock
+	{
+		void lock()
+		{
+			while (locked.exchange(true, std::memory_order_acquire))
+			{ }
+		}
+
+		void unlock()
+		{
+			locked.store(false, std::memory_order_release);
+		}
+
+		std::atomic<bool> locked;
+	};
+
+	/**
+	 * @brief	Free blocks of a single size class shared between all threads.
+	 */
+	struct PoolCentralFreeList
+	{
+		PoolLock lock;
+		PoolFreeBlock* head;
+		UINT32 count;
+	};
+
+	/**
+	 * @brief	Free blocks cached by a single thread, and statistics for allocations made on that thread.
+	 *
+	 * @note	Statistics are only modified by the owning thread, but may be read by any thread.
+	 */
+	struct PoolThreadCache
+	{
+		PoolFreeBlock* heads[NUM_SIZE_CLASSES];
+		UINT32 counts[NUM_SIZE_CLASSES];
+
+		std::atomic<UINT64> numAllocs;
+		std::atomic<UINT64> numFrees;
+		std::atomic<INT64> numBytesInUse; /**< Might be negative if memory allocated on other threads was freed on this one. */
+
+		PoolThreadCache* prev;
+		PoolThreadCache* next;
+	};
+
+	/**
+	 * @brief	Statistics of threads that ended, and a list of caches of active threads.
+	 */
+	struct PoolStatsRegistry
+	{
+		PoolLock lock;
+		PoolThreadCache* caches;
+
+		UINT64 numAllocs;
+		UINT64 numFrees;
+		INT64 numBytesInUse;
+	};
+
+	static PoolCentralFreeList CentralFreeLists[NUM_SIZE_CLASSES];
+	static PoolStatsRegistry StatsRegistry;
+	static std::atomic<UINT64> NumBytesReserved;
+
+	static BS_THREADLOCAL PoolThreadCache* ThreadCache = nullptr;
+
+	/**
+	 * @brief	Maps block size (in 16 byte increments, rounded up) to the smallest size class that can hold it.
+	 */
+	static const UINT8 SIZE_CLASS_LOOKUP[MAX_BLOCK_SIZE / 16 + 1] =
+	{
+		0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 7, 8, 8, 9, 9, 10,
+		10, 11, 11, 11, 11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14,
+		14, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+		15, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16
+	};
+
+	/**
+	 * @brief	Finds the smallest size class that can hold a block of the specified size.
+	 */
+	static UINT32 getSizeClass(size_t blockSize)
+	{
+		return SIZE_CLASS_LOOKUP[(blockSize + 15) / 16];
+	}
+
+	/**
+	 * @brief	Increments a statistics counter that only the current thread is allowed to modify.
+	 */
+	template<class T>
+	static void addToThreadCounter(std::atomic<T>& counter, T amount)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief	Returns the current thread's block cache, creating it if needed.
+	 */
+	static PoolThreadCache* getThreadCache()
+	{
+		if (ThreadCache == nullptr)
+		{
+			// Not using our own allocators, as this might be called from within them
+			PoolThreadCache* cache = (PoolThreadCache*)malloc(sizeof(PoolThreadCache));
+			memset(cache, 0, sizeof(PoolThreadCache));
+
+			StatsRegistry.lock.lock();
+			cache->next = StatsRegistry.caches;
+			if (StatsRegistry.caches != nullptr)
+				StatsRegistry.caches->prev = cache;
+
+			StatsRegistry.caches = cache;
+			StatsRegistry.lock.unlock();
+
+			ThreadCache = cache;
+		}
+
+		return ThreadCache;
+	}
+
+	/**
+	 * @brief	Moves up to "count" blocks from the start of the provided list into a separate list.
+	 *			Returns the head of the separated list, and advances "head" past the moved blocks.
+	 */
+	static PoolFreeBlock* detachBlocks(PoolFreeBlock*& head, UINT32 count, UINT32& numDetached)
+	{
+		PoolFreeBlock* first = head;
+		PoolFreeBlock* last = nullptr;
+
+		numDetached = 0;
+		while (head != nullptr && numDetached < count)
+		{
+			last = head;
+			head = head->next;
+			numDetached++;
+		}
+
+		if (last != nullptr)
+			last->next = nullptr;
+
+		return numDetached > 0 ? first : nullptr;
+	}
+
+	/**
+	 * @brief	Fills the thread cache for the specified size class, either from the shared free list or
+	 *			from a newly allocated span.
+	 */
+	static void refillThreadCache(PoolThreadCache* cache, UINT32 sizeClass)
+	{
+		PoolCentralFreeList& central = CentralFreeLists[sizeClass];
+
+		UINT32 numDetached = 0;
+		central.lock.lock();
+		PoolFreeBlock* blocks = detachBlocks(central.head, TRANSFER_BATCH_SIZE, numDetached);
+		central.count -= numDetached;
+		central.lock.unlock();
+
+		if (blocks == nullptr)
+		{
+			UINT32 blockSize = SIZE_CLASSES[sizeClass];
+			UINT32 numBlocks = SPAN_SIZE / blockSize;
+
+			UINT8* span = (UINT8*)malloc(SPAN_SIZE);
+			NumBytesReserved.fetch_add(SPAN_SIZE, std::memory_order_relaxed);
+
+			for (UINT32 i = 0; i < numBlocks; i++)
+			{
+				PoolFreeBlock* block = (PoolFreeBlock*)(span + i * blockSize);
+				block->next = (i + 1) < numBlocks ? (PoolFreeBlock*)(span + (i + 1) * blockSize) : nullptr;
+			}
+
+			blocks = (PoolFreeBlock*)span;
+			numDetached = numBlocks;
+		}
+
+		// Cache is empty when refilling, so we can just take over the list
+		cache->heads[sizeClass] = blocks;
+		cache->counts[sizeClass] = numDetached;
+	}
+
+	/**
+	 * @brief	Moves the specified number of blocks from the thread cache to the shared free list.
+	 */
+	static void releaseToCentral(PoolThreadCache* cache, UINT32 sizeClass, UINT32 count)
+	{
+		UINT32 numDetached = 0;
+		PoolFreeBlock* first = detachBlocks(cache->heads[sizeClass], count, numDetached);
+		if (first == nullptr)
+			return;
+
+		cache->counts[sizeClass] -= numDetached;
+
+		PoolFreeBlock* last = first;
+		while (last->next != nullptr)
+			last = last->next;
+
+		PoolCentralFreeList& central = CentralFreeLists[sizeClass];
+
+		central.lock.lock();
+		last->next = central.head;
+		central.head = first;
+		central.count += numDetached;
+		central.lock.unlock();
+	}
+
+	void* MemoryAllocator<PoolAlloc>::allocate(size_t bytes)
+	{
+#if BS_PROFILING_ENABLED
+		incAllocCount();
+#endif
+
+		PoolThreadCache* cache = getThreadCache();
+		size_t blockSize = bytes + HEADER_SIZE;
+		PoolBlockHeader* header = nullptr;
+
+		if (blockSize > MAX_BLOCK_SIZE)
+		{
+			header = (PoolBlockHeader*)malloc(blockSize);
+			header->sizeClass = LARGE_ALLOC_CLASS;
+			header->size = (UINT32)blockSize;
+
+			NumBytesReserved.fetch_add(blockSize, std::memory_order_relaxed);
+		}
+		else
+		{
+			UINT32 sizeClass = getSizeClass(blockSize);
+			if (cache->heads[sizeClass] == nullptr)
+				refillThreadCache(cache, sizeClass);
+
+			PoolFreeBlock* block = cache->heads[sizeClass];
+			cache->heads[sizeClass] = block->next;
+			cache->counts[sizeClass]--;
+
+			header = (PoolBlockHeader*)block;
+			header->sizeClass = sizeClass;
+			header->size = SIZE_CLASSES[sizeClass];
+		}
+
+#if BS_PROFILING_ENABLED
+		addToThreadCounter<UINT64>(cache->numAllocs, 1);
+		addToThreadCounter<INT64>(cache->numBytesInUse, header->size);
+#endif
+
+		return (UINT8*)header + HEADER_SIZE;
+	}
+
+	void MemoryAllocator<PoolAlloc>::free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		PoolBlockHeader* header = (PoolBlockHeader*)((UINT8*)ptr - HEADER_SIZE);
+		PoolThreadCache* cache = getThreadCache();
+
+#if BS_PROFILING_ENABLED
+		incFreeCount();
+		addToThreadCounter<UINT64>(cache->numFrees, 1);
+		addToThreadCounter<INT64>(cache->numBytesInUse, -(INT64)header->size);
+#endif
+
+		if (header->sizeClass == LARGE_ALLOC_CLASS)
+		{
+			NumBytesReserved.fetch_sub(header->size, std::memory_order_relaxed);
+			::free(header);
+
+			return;
+		}
+
+		UINT32 sizeClass = header->sizeClass;
+
+		PoolFreeBlock* block = (PoolFreeBlock*)header;
+		block->next = cache->heads[sizeClass];
+		cache->heads[sizeClass] = block;
+		cache->counts[sizeClass]++;
+
+		if (cache->counts[sizeClass] > MAX_CACHED_BLOCKS)
+			releaseToCentral(cache, sizeClass, TRANSFER_BATCH_SIZE);
+	}
+
+	void MemoryAllocator<PoolAlloc>::endThread()
+	{
+		if (ThreadCache == nullptr)
+			return;
+
+		PoolThreadCache* cache = ThreadCache;
+		for (UINT32 i = 0; i < NUM_SIZE_CLASSES; i++)
+			releaseToCentral(cache, i, cache->counts[i]);
+
+		StatsRegistry.lock.lock();
+		{
+			StatsRegistry.numAllocs += cache->numAllocs.load(std::memory_order_relaxed);
+			StatsRegistry.numFrees += cache->numFrees.load(std::memory_order_relaxed);
+			StatsRegistry.numBytesInUse += cache->numBytesInUse.load(std::memory_order_relaxed);
+
+			if (cache->prev != nullptr)
+				cache->prev->next = cache->next;
+			else
+				StatsRegistry.caches = cache->next;
+
+			if (cache->next != nullptr)
+				cache->next->prev = cache->prev;
+		}
+		StatsRegistry.lock.unlock();
+
+		::free(cache);
+		ThreadCache = nullptr;
+	}
+
+	MemAllocStats MemAllocProfiler::getPoolAllocStats()
+	{
+		MemAllocStats stats;
+
+		StatsRegistry.lock.lock();
+		{
+			stats.numAllocs = StatsRegistry.numAllocs;
+			stats.numFrees = StatsRegistry.numFrees;
+			INT64 numBytesInUse = StatsRegistry.numBytesInUse;
+
+			for (PoolThreadCache* cache = StatsRegistry.caches; cache != nullptr; cache = cache->next)
+			{
+				stats.numAllocs += cache->numAllocs.load(std::memory_order_relaxed);
+				stats.numFrees += cache->numFrees.load(std::memory_order_relaxed);
+				numBytesInUse += cache->numBytesInUse.load(std::memory_order_relaxed);
+			}
+
+			stats.numBytesInUse = (UINT64)std::max(numBytesInUse, (INT64)0);
+		}
+		StatsRegistry.lock.unlock();
+
+		stats.numBytesReserved = NumBytesReserved.load(std::memory_order_relaxed);
+		return stats;
+	}
+}
@@ -0,0 +1,87 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsRTTISchema.h"
+#include "BsRTTIType.h"
+#include "BsBinarySerializer.h"
+
+namespace BansheeEngine
+{
+	RTTISchema::RTTISchema(RTTITypeBase* type)
+	{
+		static const UINT32 META_SIZE = 4; // Field header size
+		static const UINT32 MIN_RUN_FIELDS = 2;
+
+		UINT32 numFields = type->getNumFields();
+		UINT16 maxUniqueId = 0;
+
+		for(UINT32 i = 0; i < numFields; i++)
+		{
+			RTTIField* curField = type->getField(i);
+			bool isFixedPlain = curField->mType == SerializableFT_Plain && !curField->hasDynamicSize();
+
+			Field field;
+			field.field = curField;
+			field.header = BinarySerializer::encodeFieldMetaData(curField->mUniqueId, curField->getTypeSize(), 
+				curField->mIsVectorType, curField->mType, curField->hasDynamicSize());
+			field.typeSize = isFixedPlain ? curField->getTypeSize() : 0;
+			field.runIdx = -1;
+			field.isFixedPlainArray = isFixedPlain && curField->mIsVectorType;
+
+			mFields.push_back(field);
+			maxUniqueId = std::max(maxUniqueId, curField->mUniqueId);
+		}
+
+		mFieldLookup.resize(numFields > 0 ? maxUniqueId + 1 : 0, -1);
+		for(UINT32 i = 0; i < numFields; i++)
+			mFieldLookup[mFields[i].field->mUniqueId] = (INT32)i;
+
+		// Group consecutive fixed size plain fields into runs
+		UINT32 i = 0;
+		while(i < numFields)
+		{
+			UINT32 runEnd = i;
+			while(runEnd < numFields && mFields[runEnd].typeSize > 0 && !mFields[runEnd].isFixedPlainArray)
+				runEnd++;
+
+			UINT32 runLength = runEnd - i;
+			if(runLength < MIN_RUN_FIELDS)
+			{
+				i = std::max(runEnd, i + 1);
+				continue;
+			}
+
+			PlainRun run;
+			run.firstField = i;
+			run.numFields = runLength;
+			run.size = 0;
+
+			for(UINT32 j = i; j < runEnd; j++)
+				run.size += META_SIZE + mFields[j].typeSize;
+
+			run.layout = (UINT8*)bs_alloc(run.size);
+			memset(run.layout, 0, run.size);
+
+			UINT32 offset = 0;
+			for(UINT32 j = i; j < runEnd; j++)
+			{
+				memcpy(run.layout + offset, &mFields[j].header, META_SIZE);
+				offset += META_SIZE;
+
+				run.valueOffsets.push_back(offset);
+				offset += mFields[j].typeSize;
+			}
+
+			mFields[i].runIdx = (INT32)mRuns.size();
+			mRuns.push_back(run);
+
+			i = runEnd;
+		}
+	}
+
+	RTTISchema::~RTTISchema()
+	{
+		for(auto& run : mRuns)
+			bs_free(run.layout);
+	}
+}
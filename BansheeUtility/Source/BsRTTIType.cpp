@@ -6,7 +6,10 @@
 
 namespace BansheeEngine
 {
+	BS_STATIC_MUTEX_CLASS_INSTANCE(mSchemaMutex, RTTITypeBase)
+
 	RTTITypeBase::RTTITypeBase()
+		:mSchema(nullptr)
 	{ }
 
 	RTTITypeBase::~RTTITypeBase() 
@@ -15,6 +18,28 @@ namespace BansheeEngine
 			bs_delete(*iter);
 
 		mFields.clear();
+
+		RTTISchema* schema = mSchema.load();
+		if(schema != nullptr)
+			bs_delete(schema);
+	}
+
+	const RTTISchema& RTTITypeBase::_getSchema()
+	{
+		RTTISchema* schema = mSchema.load(std::memory_order_acquire);
+		if(schema == nullptr)
+		{
+			BS_LOCK_MUTEX(mSchemaMutex);
+
+			schema = mSchema.load(std::memory_order_relaxed);
+			if(schema == nullptr)
+			{
+				schema = bs_new<RTTISchema>(this);
+				mSchema.store(schema, std::memory_order_release);
+			}
+		}
+
+		return *schema;
 	}
 
 	RTTIField* RTTITypeBase::findField(const String& name)
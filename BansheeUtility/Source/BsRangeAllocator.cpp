@@ -0,0 +1,331 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsRangeAllocator.h"
+
+#if BS_COMPILER == BS_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Returns the index of the lowest set bit. Value must not be zero.
+	 */
+	inline UINT32 findLowestBit(UINT32 value)
+	{
+#if BS_COMPILER == BS_COMPILER_MSVC
+		unsigned long idx;
+		_BitScanForward(&idx, value);
+		return (UINT32)idx;
+#else
+		return (UINT32)__builtin_ctz(value);
+#endif
+	}
+
+	/**
+	 * @brief	Returns the index of the highest set bit. Value must not be zero.
+	 */
+	inline UINT32 findHighestBit(UINT32 value)
+	{
+#if BS_COMPILER == BS_COMPILER_MSVC
+		unsigned long idx;
+		_BitScanReverse(&idx, value);
+		return (UINT32)idx;
+#else
+		return (UINT32)(31 - __builtin_clz(value));
+#endif
+	}
+
+	const UINT32 RangeAllocator::INVALID_BLOCK = (UINT32)-1;
+
+	RangeAllocator::RangeAllocator(UINT32 capacity)
+		:mNextUnusedBlock(INVALID_BLOCK), mLastBlock(INVALID_BLOCK), mCapacity(0), mFLBitmap(0),
+		mUsedSize(0), mNumUsedBlocks(0), mNumFreeBlocks(0)
+	{
+		for (UINT32 i = 0; i < FL_COUNT; i++)
+		{
+			mSLBitmap[i] = 0;
+
+			for (UINT32 j = 0; j < SL_COUNT; j++)
+				mFreeLists[i][j] = INVALID_BLOCK;
+		}
+
+		grow(capacity);
+	}
+
+	UINT32 RangeAllocator::alloc(UINT32 size)
+	{
+		size = std::max(size, 1U);
+
+		UINT64 searchSize = getRequiredFreeSize(size);
+		if (searchSize > std::numeric_limits<UINT32>::max())
+			return INVALID_BLOCK;
+
+		UINT32 fl, sl;
+		mapSize((UINT32)searchSize, fl, sl);
+
+		UINT32 slMap = mSLBitmap[fl] & (~0U << sl);
+		if (slMap == 0)
+		{
+			UINT32 flMap = mFLBitmap & (~0U << (fl + 1));
+			if (flMap == 0)
+				return INVALID_BLOCK;
+
+			fl = findLowestBit(flMap);
+			slMap = mSLBitmap[fl];
+		}
+
+		sl = findLowestBit(slMap);
+		UINT32 blockId = mFreeLists[fl][sl];
+
+		removeFree(blockId);
+
+		// Return the remainder of the block to the free lists
+		if (mBlocks[blockId].size > size)
+		{
+			UINT32 remainderId = createBlock();
+
+			Block& block = mBlocks[blockId];
+			Block& remainder = mBlocks[remainderId];
+
+			remainder.start = block.start + size;
+			remainder.size = block.size - size;
+			remainder.prevPhysical = blockId;
+			remainder.nextPhysical = block.nextPhysical;
+
+			if (block.nextPhysical != INVALID_BLOCK)
+				mBlocks[block.nextPhysical].prevPhysical = remainderId;
+			else
+				mLastBlock = remainderId;
+
+			block.nextPhysical = remainderId;
+			block.size = size;
+
+			insertFree(remainderId);
+		}
+
+		mBlocks[blockId].isFree = false;
+
+		mUsedSize += size;
+		mNumUsedBlocks++;
+
+		return blockId;
+	}
+
+	UINT64 RangeAllocator::getRequiredFreeSize(UINT32 size)
+	{
+		size = std::max(size, 1U);
+
+		// Round up to the next size class so any block in the found list is large enough
+		UINT64 searchSize = size;
+		if (size >= SL_COUNT)
+			searchSize += (1ULL << (findHighestBit(size) - SL_COUNT_LOG2)) - 1;
+
+		return searchSize;
+	}
+
+	void RangeAllocator::free(UINT32 blockId)
+	{
+		assert(!mBlocks[blockId].isFree);
+
+		mUsedSize -= mBlocks[blockId].size;
+		mNumUsedBlocks--;
+
+		mBlocks[blockId].isFree = true;
+
+		UINT32 nextId = mBlocks[blockId].nextPhysical;
+		if (nextId != INVALID_BLOCK && mBlocks[nextId].isFree)
+		{
+			removeFree(nextId);
+			mergeWithNext(blockId);
+		}
+
+		UINT32 prevId = mBlocks[blockId].prevPhysical;
+		if (prevId != INVALID_BLOCK && mBlocks[prevId].isFree)
+		{
+			removeFree(prevId);
+			mergeWithNext(prevId);
+
+			blockId = prevId;
+		}
+
+		insertFree(blockId);
+	}
+
+	void RangeAllocator::grow(UINT32 newCapacity)
+	{
+		if (newCapacity <= mCapacity)
+			return;
+
+		UINT32 extraSize = newCapacity - mCapacity;
+		if (mLastBlock != INVALID_BLOCK && mBlocks[mLastBlock].isFree)
+		{
+			removeFree(mLastBlock);
+			mBlocks[mLastBlock].size += extraSize;
+			insertFree(mLastBlock);
+		}
+		else
+		{
+			UINT32 blockId = createBlock();
+
+			Block& block = mBlocks[blockId];
+			block.start = mCapacity;
+			block.size = extraSize;
+			block.prevPhysical = mLastBlock;
+			block.nextPhysical = INVALID_BLOCK;
+
+			if (mLastBlock != INVALID_BLOCK)
+				mBlocks[mLastBlock].nextPhysical = blockId;
+
+			mLastBlock = blockId;
+			insertFree(blockId);
+		}
+
+		mCapacity = newCapacity;
+	}
+
+	RangeAllocatorStats RangeAllocator::getStats() const
+	{
+		RangeAllocatorStats stats;
+		stats.capacity = mCapacity;
+		stats.usedSize = mUsedSize;
+		stats.freeSize = mCapacity - mUsedSize;
+		stats.numUsedBlocks = mNumUsedBlocks;
+		stats.numFreeBlocks = mNumFreeBlocks;
+
+		// Largest block is in the highest non-empty list, but blocks within a list aren't sorted
+		if (mFLBitmap != 0)
+		{
+			UINT32 fl = findHighestBit(mFLBitmap);
+			UINT32 sl = findHighestBit(mSLBitmap[fl]);
+
+			UINT32 blockId = mFreeLists[fl][sl];
+			while (blockId != INVALID_BLOCK)
+			{
+				stats.largestFreeBlock = std::max(stats.largestFreeBlock, mBlocks[blockId].size);
+				blockId = mBlocks[blockId].nextFree;
+			}
+		}
+
+		return stats;
+	}
+
+	void RangeAllocator::mapSize(UINT32 size, UINT32& fl, UINT32& sl)
+	{
+		// Sizes smaller than the number of second level lists each get their own list
+		if (size < SL_COUNT)
+		{
+			fl = 0;
+			sl = size;
+		}
+		else
+		{
+			UINT32 highestBit = findHighestBit(size);
+
+			fl = highestBit - SL_COUNT_LOG2 + 1;
+			sl = (size >> (highestBit - SL_COUNT_LOG2)) - SL_COUNT;
+		}
+	}
+
+	UINT32 RangeAllocator::createBlock()
+	{
+		UINT32 blockId;
+		if (mNextUnusedBlock != INVALID_BLOCK)
+		{
+			blockId = mNextUnusedBlock;
+			mNextUnusedBlock = mBlocks[blockId].nextFree;
+		}
+		else
+		{
+			blockId = (UINT32)mBlocks.size();
+			mBlocks.push_back(Block());
+		}
+
+		Block& block = mBlocks[blockId];
+		block.start = 0;
+		block.size = 0;
+		block.prevPhysical = INVALID_BLOCK;
+		block.nextPhysical = INVALID_BLOCK;
+		block.prevFree = INVALID_BLOCK;
+		block.nextFree = INVALID_BLOCK;
+		block.isFree = false;
+
+		return blockId;
+	}
+
+	void RangeAllocator::destroyBlock(UINT32 blockId)
+	{
+		mBlocks[blockId].nextFree = mNextUnusedBlock;
+		mNextUnusedBlock = blockId;
+	}
+
+	void RangeAllocator::insertFree(UINT32 blockId)
+	{
+		Block& block = mBlocks[blockId];
+
+		UINT32 fl, sl;
+		mapSize(block.size, fl, sl);
+
+		UINT32 headId = mFreeLists[fl][sl];
+
+		block.isFree = true;
+		block.prevFree = INVALID_BLOCK;
+		block.nextFree = headId;
+
+		if (headId != INVALID_BLOCK)
+			mBlocks[headId].prevFree = blockId;
+
+		mFreeLists[fl][sl] = blockId;
+		mFLBitmap |= 1U << fl;
+		mSLBitmap[fl] |= 1U << sl;
+
+		mNumFreeBlocks++;
+	}
+
+	void RangeAllocator::removeFree(UINT32 blockId)
+	{
+		Block& block = mBlocks[blockId];
+
+		if (block.prevFree != INVALID_BLOCK)
+			mBlocks[block.prevFree].nextFree = block.nextFree;
+		else
+		{
+			UINT32 fl, sl;
+			mapSize(block.size, fl, sl);
+
+			mFreeLists[fl][sl] = block.nextFree;
+			if (block.nextFree == INVALID_BLOCK)
+			{
+				mSLBitmap[fl] &= ~(1U << sl);
+				if (mSLBitmap[fl] == 0)
+					mFLBitmap &= ~(1U << fl);
+			}
+		}
+
+		if (block.nextFree != INVALID_BLOCK)
+			mBlocks[block.nextFree].prevFree = block.prevFree;
+
+		block.prevFree = INVALID_BLOCK;
+		block.nextFree = INVALID_BLOCK;
+
+		mNumFreeBlocks--;
+	}
+
+	void RangeAllocator::mergeWithNext(UINT32 blockId)
+	{
+		Block& block = mBlocks[blockId];
+		UINT32 nextId = block.nextPhysical;
+		Block& next = mBlocks[nextId];
+
+		block.size += next.size;
+		block.nextPhysical = next.nextPhysical;
+
+		if (next.nextPhysical != INVALID_BLOCK)
+			mBlocks[next.nextPhysical].prevPhysical = blockId;
+		else
+			mLastBlock = blockId;
+
+		destroyBlock(nextId);
+	}
+}
@@ -0,0 +1,310 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsPrerequisitesUtil.h"
+
+namespace BansheeEngine
+{
+	/**
+	 * @brief	Size of a single memory block allocations are made from, including the block header.
+	 */
+	static const UINT32 SCRATCH_BLOCK_SIZE = 64 * 1024;
+
+	/**
+	 * @brief	Allocations larger than this (including the allocation header) are passed to malloc.
+	 */
+	static const UINT32 MAX_SCRATCH_ALLOC_SIZE = SCRATCH_BLOCK_SIZE / 8;
+
+	/**
+	 * @brief	Flag set in ScratchBlock::numRemoteFrees once the owner thread stops allocating from the block.
+	 */
+	static const UINT32 BLOCK_RETIRED_FLAG = 0x80000000;
+
+	/**
+	 * @brief	Memory block allocations are made from.
+	 *
+	 * @note	Frees made by the owner thread while the block is active are counted without synchronization. Other
+	 *			frees are counted atomically. Once the owner retires the block it records how many allocations
+	 *			were still live, and whichever thread frees the last one frees the block.
+	 */
+	struct ScratchBlock
+	{
+		UINT32 freePtr;
+		UINT32 numAllocs; /**< Number of allocations made from the block. Owner thread only. */
+		UINT32 numLocalFrees; /**< Number of frees made by the owner thread while the block was active. Owner thread only. */
+		UINT32 numLiveOnRetire; /**< Number of allocations not freed locally, recorded when the block was retired. */
+		std::atomic<UINT32> numRemoteFrees;
+	};
+
+	/**
+	 * @brief	Header stored in front of each allocation. Size is a multiple of 16 so user memory stays 16 byte aligned.
+	 */
+	struct ScratchAllocHeader
+	{
+		ScratchBlock* block; /**< Block the allocation was made from, or null if it was passed to malloc. */
+		UINT32 size; /**< Size of the allocation, including the header. */
+		UINT32 padding;
+	};
+
+	/**
+	 * @brief	Per-thread allocator state, and statistics for allocations made on that thread.
+	 *
+	 * @note	Statistics are only modified by the owning thread, but may be read by any thread.
+	 */
+	struct ScratchThreadState
+	{
+		ScratchBlock* activeBlock;
+
+		std::atomic<UINT64> numAllocs;
+		std::atomic<UINT64> numFrees;
+		std::atomic<INT64> numBytesInUse; /**< Might be negative if memory allocated on other threads was freed on this one. */
+
+		ScratchThreadState* prev;
+		ScratchThreadState* next;
+	};
+
+	/**
+	 * @brief	Statistics of threads that ended, and a list of states of active threads.
+	 *
+	 * @note	Only contains types with constant initialization, so it's usable during static initialization.
+	 */
+	struct ScratchStatsRegistry
+	{
+		void lock()
+		{
+			while (locked.exchange(true, std::memory_order_acquire))
+			{ }
+		}
+
+		void unlock()
+		{
+			locked.store(false, std::memory_order_release);
+		}
+
+		std::atomic<bool> locked;
+		ScratchThreadState* states;
+
+		UINT64 numAllocs;
+		UINT64 numFrees;
+		INT64 numBytesInUse;
+	};
+
+	static const UINT32 BLOCK_HEADER_SIZE = (sizeof(ScratchBlock) + 15) & ~15;
+	static const UINT32 ALLOC_HEADER_SIZE = (sizeof(ScratchAllocHeader) + 15) & ~15;
+
+	static ScratchStatsRegistry StatsRegistry;
+	static std::atomic<UINT64> NumBytesReserved;
+
+	static BS_THREADLOCAL ScratchThreadState* ThreadState = nullptr;
+
+	/**
+	 * @brief	Increments a statistics counter that only the current thread is allowed to modify.
+	 */
+	template<class T>
+	static void addToThreadCounter(std::atomic<T>& counter, T amount)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief	Returns the current thread's allocator state, creating it if needed.
+	 */
+	static ScratchThreadState* getThreadState()
+	{
+		if (ThreadState == nullptr)
+		{
+			// Not using our own allocators, as this might be called from within them
+			ScratchThreadState* state = (ScratchThreadState*)malloc(sizeof(ScratchThreadState));
+			memset(state, 0, sizeof(ScratchThreadState));
+
+			StatsRegistry.lock();
+			state->next = StatsRegistry.states;
+			if (StatsRegistry.states != nullptr)
+				StatsRegistry.states->prev = state;
+
+			StatsRegistry.states = state;
+			StatsRegistry.unlock();
+
+			ThreadState = state;
+		}
+
+		return ThreadState;
+	}
+
+	/**
+	 * @brief	Frees the memory used by the block.
+	 */
+	static void freeBlock(ScratchBlock* block)
+	{
+		block->~ScratchBlock();
+		::free(block);
+
+		NumBytesReserved.fetch_sub(SCRATCH_BLOCK_SIZE, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief	Stops the owner thread from allocating from the block. Block is freed immediately if it
+	 *			has no live allocations, or otherwise once the last one is freed.
+	 */
+	static void retireBlock(ScratchBlock* block)
+	{
+		block->numLiveOnRetire = block->numAllocs - block->numLocalFrees;
+
+		UINT32 numRemoteFrees = block->numRemoteFrees.fetch_or(BLOCK_RETIRED_FLAG, std::memory_order_acq_rel);
+		if (numRemoteFrees == block->numLiveOnRetire)
+			freeBlock(block);
+	}
+
+	void* MemoryAllocator<ScratchAlloc>::allocate(size_t bytes)
+	{
+#if BS_PROFILING_ENABLED
+		incAllocCount();
+#endif
+
+		ScratchThreadState* state = getThreadState();
+		UINT32 allocSize = (UINT32)((bytes + ALLOC_HEADER_SIZE + 15) & ~(size_t)15);
+		ScratchAllocHeader* header = nullptr;
+
+		if (allocSize > MAX_SCRATCH_ALLOC_SIZE)
+		{
+			header = (ScratchAllocHeader*)malloc(allocSize);
+			header->block = nullptr;
+
+			NumBytesReserved.fetch_add(allocSize, std::memory_order_relaxed);
+		}
+		else
+		{
+			ScratchBlock* block = state->activeBlock;
+			if (block != nullptr)
+			{
+				// Reuse the block from the start if all allocations were freed. Other threads can't allocate from
+				// the block, so the count cannot increase until we allocate again.
+				UINT32 numFrees = block->numLocalFrees + block->numRemoteFrees.load(std::memory_order_acquire);
+				if (numFrees == block->numAllocs)
+				{
+					block->freePtr = BLOCK_HEADER_SIZE;
+					block->numAllocs = 0;
+					block->numLocalFrees = 0;
+					block->numRemoteFrees.store(0, std::memory_order_relaxed);
+				}
+				else if ((block->freePtr + allocSize) > SCRATCH_BLOCK_SIZE)
+				{
+					retireBlock(block);
+					block = nullptr;
+				}
+			}
+
+			if (block == nullptr)
+			{
+				block = new (malloc(SCRATCH_BLOCK_SIZE)) ScratchBlock();
+				block->freePtr = BLOCK_HEADER_SIZE;
+				block->numAllocs = 0;
+				block->numLocalFrees = 0;
+				block->numLiveOnRetire = 0;
+				block->numRemoteFrees.store(0, std::memory_order_relaxed);
+
+				NumBytesReserved.fetch_add(SCRATCH_BLOCK_SIZE, std::memory_order_relaxed);
+				state->activeBlock = block;
+			}
+
+			header = (ScratchAllocHeader*)((UINT8*)block + block->freePtr);
+			header->block = block;
+
+			block->freePtr += allocSize;
+			block->numAllocs++;
+		}
+
+		header->size = allocSize;
+
+#if BS_PROFILING_ENABLED
+		addToThreadCounter<UINT64>(state->numAllocs, 1);
+		addToThreadCounter<INT64>(state->numBytesInUse, allocSize);
+#endif
+
+		return (UINT8*)header + ALLOC_HEADER_SIZE;
+	}
+
+	void MemoryAllocator<ScratchAlloc>::free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		ScratchThreadState* state = getThreadState();
+		ScratchAllocHeader* header = (ScratchAllocHeader*)((UINT8*)ptr - ALLOC_HEADER_SIZE);
+
+#if BS_PROFILING_ENABLED
+		incFreeCount();
+		addToThreadCounter<UINT64>(state->numFrees, 1);
+		addToThreadCounter<INT64>(state->numBytesInUse, -(INT64)header->size);
+#endif
+
+		ScratchBlock* block = header->block;
+		if (block == nullptr)
+		{
+			NumBytesReserved.fetch_sub(header->size, std::memory_order_relaxed);
+			::free(header);
+		}
+		else if (block == state->activeBlock) // Block is owned by this thread and still active
+			block->numLocalFrees++;
+		else
+		{
+			UINT32 numRemoteFrees = block->numRemoteFrees.fetch_add(1, std::memory_order_acq_rel) + 1;
+			if (numRemoteFrees == (block->numLiveOnRetire | BLOCK_RETIRED_FLAG))
+				freeBlock(block);
+		}
+	}
+
+	void MemoryAllocator<ScratchAlloc>::endThread()
+	{
+		ScratchThreadState* state = ThreadState;
+		if (state == nullptr)
+			return;
+
+		if (state->activeBlock != nullptr)
+			retireBlock(state->activeBlock);
+
+		StatsRegistry.lock();
+		{
+			StatsRegistry.numAllocs += state->numAllocs.load(std::memory_order_relaxed);
+			StatsRegistry.numFrees += state->numFrees.load(std::memory_order_relaxed);
+			StatsRegistry.numBytesInUse += state->numBytesInUse.load(std::memory_order_relaxed);
+
+			if (state->prev != nullptr)
+				state->prev->next = state->next;
+			else
+				StatsRegistry.states = state->next;
+
+			if (state->next != nullptr)
+				state->next->prev = state->prev;
+		}
+		StatsRegistry.unlock();
+
+		::free(state);
+		ThreadState = nullptr;
+	}
+
+	MemAllocStats MemAllocProfiler::getScratchAllocStats()
+	{
+		MemAllocStats stats;
+
+		StatsRegistry.lock();
+		{
+			stats.numAllocs = StatsRegistry.numAllocs;
+			stats.numFrees = StatsRegistry.numFrees;
+			INT64 numBytesInUse = StatsRegistry.numBytesInUse;
+
+			for (ScratchThreadState* state = StatsRegistry.states; state != nullptr; state = state->next)
+			{
+				stats.numAllocs += state->numAllocs.load(std::memory_order_relaxed);
+				stats.numFrees += state->numFrees.load(std::memory_order_relaxed);
+				numBytesInUse += state->numBytesInUse.load(std::memory_order_relaxed);
+			}
+
+			stats.numBytesInUse = (UINT64)std::max(numBytesInUse, (INT64)0);
+		}
+		StatsRegistry.unlock();
+
+		stats.numBytesReserved = NumBytesReserved.load(std::memory_order_relaxed);
+		return stats;
+	}
+}
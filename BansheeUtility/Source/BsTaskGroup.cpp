@@ -0,0 +1,39 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsTaskGroup.h"
+
+namespace BansheeEngine
+{
+	TaskGroup::TaskGroup(TaskPriority priority)
+		:mPriority(priority)
+	{ }
+
+	TaskGroup::~TaskGroup()
+	{
+		wait();
+	}
+
+	void TaskGroup::spawn(std::function<void()> taskWorker)
+	{
+		if (!TaskScheduler::isStarted())
+		{
+			taskWorker();
+			return;
+		}
+
+		TaskPtr task = Task::create("TaskGroup", taskWorker, mPriority);
+		TaskScheduler::instance().addTask(task);
+
+		mTasks.push_back(task);
+	}
+
+	void TaskGroup::wait()
+	{
+		// Most recently spawned tasks are the most likely to still be in this threads queue
+		for (auto iter = mTasks.rbegin(); iter != mTasks.rend(); ++iter)
+			(*iter)->wait();
+
+		mTasks.clear();
+	}
+}
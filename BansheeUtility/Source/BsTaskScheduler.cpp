@@ -6,17 +6,32 @@
 
 namespace BansheeEngine
 {
-	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
-		TaskPriority priority, TaskPtr dependency)
-		:mName(name), mState(0), mPriority(priority), mTaskId(0), 
-		mTaskDependency(dependency), mTaskWorker(taskWorker), mParent(nullptr)
+	/**
+	 * @brief	Index of the scheduler worker running on the current thread, or -1 if the thread is not a worker.
+	 */
+	static BS_THREADLOCAL INT32 CurrentWorkerIdx = -1;
+
+	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
+		TaskPriority priority, const Vector<TaskPtr>& dependencies)
+		:mName(name), mState(0), mPriority(priority), mDependencies(dependencies), mTaskWorker(taskWorker),
+		mNumPendingDependencies(0), mDependentsReleased(false), mParent(nullptr)
 	{
 
 	}
 
 	TaskPtr Task::create(const String& name, std::function<void()> taskWorker, TaskPriority priority, TaskPtr dependency)
 	{
-		return bs_shared_ptr<Task>(PrivatelyConstruct(), name, taskWorker, priority, dependency);
+		Vector<TaskPtr> dependencies;
+		if (dependency != nullptr)
+			dependencies.push_back(dependency);
+
+		return bs_shared_ptr<Task>(PrivatelyConstruct(), name, taskWorker, priority, dependencies);
+	}
+
+	TaskPtr Task::create(const String& name, std::function<void()> taskWorker, TaskPriority priority,
+		const Vector<TaskPtr>& dependencies)
+	{
+		return bs_shared_ptr<Task>(PrivatelyConstruct(), name, taskWorker, priority, dependencies);
 	}
 
 	bool Task::isComplete() const
@@ -36,160 +51,341 @@ namespace BansheeEngine
 
 	void Task::cancel()
 	{
-		mState.store(3);
+		UINT32 expected = 0;
+		if (!mState.compare_exchange_strong(expected, 3))
+			return;
+
+		releaseDependents();
+
+		if (mParent != nullptr)
+			mParent->wakeSleepers();
+	}
+
+	void Task::releaseDependents()
+	{
+		Vector<Task*> dependents;
+
+		mDependentsLock.lock();
+		{
+			if (!mDependentsReleased)
+			{
+				mDependentsReleased = true;
+				std::swap(dependents, mDependents);
+			}
+		}
+		mDependentsLock.unlock();
+
+		for (auto& dependent : dependents)
+			dependent->mParent->dependencyResolved(dependent);
 	}
 
 	TaskScheduler::TaskScheduler()
-		:mMaxActiveTasks(0), mNumActiveTasks(0), mNextTaskId(0), mShutdown(false),
-		mTaskQueue(&TaskScheduler::taskCompare)
+		:mNumWorkers(0), mMaxActiveWorkers(0), mNumQueuedTasks(0), mNumRunningTasks(0),
+		mNumSleeping(0), mShutdown(false)
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		memset(mWorkers, 0, sizeof(mWorkers));
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+		mMaxActiveWorkers = BS_THREAD_HARDWARE_CONCURRENCY;
 	}
 
 	TaskScheduler::~TaskScheduler()
 	{
-		// Wait until all tasks complete
-		BS_LOCK_MUTEX_NAMED(mActiveTaskMutex, activeTaskLock);
-
-		while (mActiveTasks.size() > 0)
+		// Wait until all queued and active tasks complete
+		while (mNumQueuedTasks.load() > 0 || mNumRunningTasks.load() > 0)
 		{
-			TaskPtr task = mActiveTasks[0];
-			activeTaskLock.unlock();
+			if (tryRunTask(getCurrentWorker()))
+				continue;
+
+			BS_LOCK_MUTEX_NAMED(mSleepMutex, lock);
+			mNumSleeping++;
 
-			task->wait();
-			activeTaskLock.lock();
+			while (mNumQueuedTasks.load() == 0 && mNumRunningTasks.load() > 0)
+				BS_THREAD_WAIT(mSleepCond, mSleepMutex, lock);
+
+			mNumSleeping--;
 		}
 
-		// Start shutdown of the main queue worker and wait until it exits
+		// Shut down the workers and wait until they exit
 		{
-			BS_LOCK_MUTEX(mReadyMutex);
-
+			BS_LOCK_MUTEX(mWorkerMutex);
 			mShutdown = true;
 		}
 
-		BS_THREAD_NOTIFY_ONE(mTaskReadyCond);
+		{
+			BS_LOCK_MUTEX(mSleepMutex);
+			BS_THREAD_NOTIFY_ALL(mSleepCond);
+		}
 
-		mTaskSchedulerThread.blockUntilComplete();
+		UINT32 numWorkers = mNumWorkers.load();
+		for (UINT32 i = 0; i < numWorkers; i++)
+		{
+			mWorkers[i]->thread.blockUntilComplete();
+			bs_delete(mWorkers[i]);
+			mWorkers[i] = nullptr;
+		}
 	}
 
 	void TaskScheduler::addTask(const TaskPtr& task)
 	{
-		BS_LOCK_MUTEX(mReadyMutex);
-
 		task->mParent = this;
-		task->mTaskId = mNextTaskId++;
+		task->mSelf = task;
 
-		mTaskQueue.insert(task);
+		// Guard value ensures the task doesn't get queued while we're still registering its dependencies
+		task->mNumPendingDependencies.store(1);
 
-		// Wake main scheduler thread
-		BS_THREAD_NOTIFY_ONE(mTaskReadyCond);
+		for (auto& dependency : task->mDependencies)
+		{
+			dependency->mDependentsLock.lock();
+			{
+				if (!dependency->mDependentsReleased)
+				{
+					dependency->mDependents.push_back(task.get());
+					task->mNumPendingDependencies++;
+				}
+			}
+			dependency->mDependentsLock.unlock();
+		}
+
+		task->mDependencies.clear();
+		dependencyResolved(task.get());
 	}
 
 	void TaskScheduler::addWorker()
 	{
-		BS_LOCK_MUTEX(mReadyMutex);
+		{
+			BS_LOCK_MUTEX(mWorkerMutex);
+			mMaxActiveWorkers++;
+		}
 
-		mMaxActiveTasks++;
+		// A spot freed up, start executing queued tasks if they exist
+		if (mNumQueuedTasks.load() > 0)
+			spawnWorkerIfNeeded();
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		BS_THREAD_NOTIFY_ONE(mTaskReadyCond);
+		wakeSleepers();
 	}
 
 	void TaskScheduler::removeWorker()
 	{
-		BS_LOCK_MUTEX(mReadyMutex);
+		BS_LOCK_MUTEX(mWorkerMutex);
 
-		if(mMaxActiveTasks > 0)
-			mMaxActiveTasks--;
+		if (mMaxActiveWorkers > 0)
+			mMaxActiveWorkers--;
 	}
 
-	void TaskScheduler::runMain()
+	UINT32 TaskScheduler::getNumWorkers() const
 	{
-		while(true)
-		{
-			BS_LOCK_MUTEX_NAMED(mReadyMutex, lock);
+		return (UINT32)std::max(mMaxActiveWorkers.load(), 0);
+	}
 
-			while((mTaskQueue.size() == 0 || mNumActiveTasks == mMaxActiveTasks) && !mShutdown)
-				BS_THREAD_WAIT(mTaskReadyCond, mReadyMutex, lock);
+	void TaskScheduler::runWorker(UINT32 workerIdx)
+	{
+		CurrentWorkerIdx = (INT32)workerIdx;
+		Worker* worker = mWorkers[workerIdx];
 
-			if(mShutdown)
+		while (true)
+		{
+			if (mShutdown.load())
 				break;
 
-			for(UINT32 i = 0; (i < mTaskQueue.size()) && (mNumActiveTasks < mMaxActiveTasks); i++)
-			{
-				TaskPtr curTask = *mTaskQueue.begin();
-				mTaskQueue.erase(mTaskQueue.begin());
+			if ((INT32)workerIdx < mMaxActiveWorkers.load() && tryRunTask(worker))
+				continue;
 
-				if(curTask->isCanceled())
-					continue;
+			BS_LOCK_MUTEX_NAMED(mSleepMutex, lock);
+			mNumSleeping++;
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-					continue;
+			while (!mShutdown.load() && ((INT32)workerIdx >= mMaxActiveWorkers.load() || mNumQueuedTasks.load() == 0))
+				BS_THREAD_WAIT(mSleepCond, mSleepMutex, lock);
+
+			mNumSleeping--;
+		}
+
+		CurrentWorkerIdx = -1;
+	}
+
+	bool TaskScheduler::tryRunTask(Worker* worker)
+	{
+		Task* task = findTask(worker);
+		if (task == nullptr)
+			return false;
+
+		// Task must be counted as running before it stops being counted as queued, so the shutdown
+		// drain never sees both counts at zero while the task still exists
+		mNumRunningTasks++;
+		mNumQueuedTasks--;
+
+		executeTask(task);
+
+		return true;
+	}
+
+	Task* TaskScheduler::findTask(Worker* worker)
+	{
+		UINT32 numWorkers = mNumWorkers.load(std::memory_order_acquire);
+		UINT32 startIdx = 0;
+		if (worker != nullptr)
+			startIdx = (UINT32)CurrentWorkerIdx + 1;
 
-				BS_LOCK_MUTEX(mActiveTaskMutex);
+		for (UINT32 lane = 0; lane < NUM_PRIORITY_LANES; lane++)
+		{
+			if (worker != nullptr)
+			{
+				Task* task = worker->lanes[lane].pop();
+				if (task != nullptr)
+					return task;
+			}
+
+			InjectionLane& injectionLane = mInjectionLanes[lane];
+			if (injectionLane.numTasks.load() > 0)
+			{
+				Task* task = nullptr;
+
+				injectionLane.lock.lock();
+				if (!injectionLane.tasks.empty())
 				{
-					curTask->mState.store(1);
-					mActiveTasks.push_back(curTask);
-					mNumActiveTasks++;
+					task = injectionLane.tasks.front();
+					injectionLane.tasks.pop();
+					injectionLane.numTasks--;
 				}
+				injectionLane.lock.unlock();
+
+				if (task != nullptr)
+					return task;
+			}
+
+			for (UINT32 i = 0; i < numWorkers; i++)
+			{
+				Worker* victim = mWorkers[(startIdx + i) % numWorkers];
+				if (victim == worker)
+					continue;
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+				Task* task = victim->lanes[lane].steal();
+				if (task != nullptr)
+					return task;
 			}
 		}
+
+		return nullptr;
 	}
 
-	void TaskScheduler::runTask(TaskPtr task)
+	void TaskScheduler::executeTask(Task* task)
 	{
-		task->mTaskWorker();
+		UINT32 expected = 0;
+		if (task->mState.compare_exchange_strong(expected, 1))
+		{
+			task->mTaskWorker();
+			task->mState.store(2);
+		}
+
+		// Possibly this task was someones dependency
+		task->releaseDependents();
+
+		// Only stop counting the task as running once its dependents are queued
+		mNumRunningTasks--;
+
+		// Wake up anyone waiting on the task
+		wakeSleepers();
 
+		TaskPtr self = nullptr;
+		std::swap(self, task->mSelf);
+	}
+
+	void TaskScheduler::enqueue(Task* task)
+	{
+		UINT32 lane = getLaneIdx(task->mPriority);
+
+		Worker* worker = getCurrentWorker();
+		if (worker != nullptr)
+			worker->lanes[lane].push(task);
+		else
 		{
-			BS_LOCK_MUTEX(mActiveTaskMutex);
+			InjectionLane& injectionLane = mInjectionLanes[lane];
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+			injectionLane.lock.lock();
+			injectionLane.tasks.push(task);
+			injectionLane.numTasks++;
+			injectionLane.lock.unlock();
 		}
 
+		mNumQueuedTasks++;
+
+		spawnWorkerIfNeeded();
+		wakeSleepers();
+	}
+
+	void TaskScheduler::dependencyResolved(Task* task)
+	{
+		if (task->mNumPendingDependencies.fetch_sub(1) != 1)
+			return;
+
+		if (task->isCanceled())
 		{
-			BS_LOCK_MUTEX(mCompleteMutex);
-			task->mState.store(2);
+			TaskPtr self = nullptr;
+			std::swap(self, task->mSelf);
 
-			BS_THREAD_NOTIFY_ALL(mTaskCompleteCond);
+			return;
 		}
 
-		// Possibly this task was someones dependency, so wake the main scheduler thread
-		BS_THREAD_NOTIFY_ONE(mTaskReadyCond);
+		enqueue(task);
 	}
 
 	void TaskScheduler::waitUntilComplete(const Task* task)
 	{
-		if(task->isCanceled())
-			return;
+		Worker* worker = getCurrentWorker();
 
+		while (!task->isComplete() && !task->isCanceled())
 		{
-			BS_LOCK_MUTEX_NAMED(mCompleteMutex, lock);
-			
-			while(!task->isComplete())
-			{
-				addWorker();
-				BS_THREAD_WAIT(mTaskCompleteCond, mCompleteMutex, lock);
-				removeWorker();
-			}
+			if (tryRunTask(worker))
+				continue;
+
+			BS_LOCK_MUTEX_NAMED(mSleepMutex, lock);
+			mNumSleeping++;
+
+			while (!task->isComplete() && !task->isCanceled() && mNumQueuedTasks.load() == 0)
+				BS_THREAD_WAIT(mSleepCond, mSleepMutex, lock);
+
+			mNumSleeping--;
 		}
 	}
 
-	bool TaskScheduler::taskCompare(const TaskPtr& lhs, const TaskPtr& rhs)
+	void TaskScheduler::spawnWorkerIfNeeded()
+	{
+		if (mNumWorkers.load() >= (UINT32)mMaxActiveWorkers.load())
+			return;
+
+		BS_LOCK_MUTEX(mWorkerMutex);
+
+		UINT32 workerIdx = mNumWorkers.load();
+		if (mShutdown.load() || workerIdx >= MAX_WORKERS || workerIdx >= (UINT32)mMaxActiveWorkers.load())
+			return;
+
+		Worker* worker = bs_new<Worker>();
+		mWorkers[workerIdx] = worker;
+		mNumWorkers.store(workerIdx + 1, std::memory_order_release);
+
+		worker->thread = ThreadPool::instance().run("TaskWorker", std::bind(&TaskScheduler::runWorker, this, workerIdx));
+	}
+
+	void TaskScheduler::wakeSleepers()
 	{
-		// If one tasks priority is higher, that one goes first
-		if(lhs->mPriority > rhs->mPriority)
-			return true;
+		if (mNumSleeping.load() == 0)
+			return;
 
-		// Otherwise we go by smaller id, as that task was queued earlier than the other
-		if(lhs->mTaskId < rhs->mTaskId)
-			return true;
+		BS_LOCK_MUTEX(mSleepMutex);
+		BS_THREAD_NOTIFY_ALL(mSleepCond);
+	}
+
+	TaskScheduler::Worker* TaskScheduler::getCurrentWorker() const
+	{
+		if (CurrentWorkerIdx < 0)
+			return nullptr;
+
+		return mWorkers[CurrentWorkerIdx];
+	}
+
+	UINT32 TaskScheduler::getLaneIdx(TaskPriority priority)
+	{
+		INT32 laneIdx = (INT32)TaskPriority::VeryHigh - (INT32)priority;
 
-		BS_EXCEPT(InternalErrorException, "Found two identical tasks.");
+		return (UINT32)std::min(std::max(laneIdx, 0), (INT32)NUM_PRIORITY_LANES - 1);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+//__________________________ Banshee Project - A modern game development toolkit _________________________________//
+//_____________________________________ www.banshee-project.com __________________________________________________//
+//________________________ Copyright (c) 2014 Marko Pintera. All rights reserved. ________________________________//
+#include "BsMemoryMappedFile.h"
+#include "BsException.h"
+#include "BsPath.h"
+#include <windows.h>
+
+namespace BansheeEngine
+{
+	void win32_handleError(DWORD error, const WString& path);
+
+	MemoryMappedFile::MemoryMappedFile(const Path& fullPath)
+		:mData(nullptr), mSize(0), mFileHandle(INVALID_HANDLE_VALUE), mMappingHandle(nullptr)
+	{
+		WString pathStr = fullPath.toWString();
+
+		HANDLE fileHandle = CreateFileW(pathStr.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			win32_handleError(GetLastError(), pathStr);
+
+		mFileHandle = fileHandle;
+
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(fileHandle, &fileSize) == FALSE)
+		{
+			DWORD error = GetLastError();
+			CloseHandle(fileHandle);
+
+			win32_handleError(error, pathStr);
+		}
+
+		mSize = (UINT64)fileSize.QuadPart;
+
+		// Empty files cannot be mapped
+		if (mSize == 0)
+			return;
+
+		HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mappingHandle == nullptr)
+		{
+			DWORD error = GetLastError();
+			CloseHandle(fileHandle);
+
+			win32_handleError(error, pathStr);
+		}
+
+		mMappingHandle = mappingHandle;
+
+		void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr)
+		{
+			DWORD error = GetLastError();
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+
+			win32_handleError(error, pathStr);
+		}
+
+		mData = (const UINT8*)data;
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		if (mData != nullptr)
+			UnmapViewOfFile(mData);
+
+		if (mMappingHandle != nullptr)
+			CloseHandle((HANDLE)mMappingHandle);
+
+		if (mFileHandle != INVALID_HANDLE_VALUE)
+			CloseHandle((HANDLE)mFileHandle);
+	}
+
+	MemoryMappedFilePtr MemoryMappedFile::create(const Path& fullPath)
+	{
+		return bs_shared_ptr<MemoryMappedFile>(fullPath);
+	}
+}